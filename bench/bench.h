@@ -0,0 +1,94 @@
+/*
+ * Agentite Benchmark Suite
+ *
+ * Headless micro-benchmarks for the engine's CPU hot paths. No window or GPU
+ * device is created, so the suite runs on CI machines and build servers.
+ *
+ * Each case is a seeded scenario: setup() builds the same world for the same
+ * seed, run() performs one operation against it, teardown() frees it. The
+ * runner calibrates a batch size, times a number of batches and reports
+ * ns/op percentiles and heap allocations per op as JSON.
+ *
+ * Adding a case:
+ *   1. Write setup/run/teardown in the bench_<area>.cpp file for the module
+ *   2. Append it to that file's case table
+ *   New areas also need their table listed in bench_main.cpp.
+ */
+
+#ifndef AGENTITE_BENCH_H
+#define AGENTITE_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================================
+ * Cases
+ * ============================================================================ */
+
+/**
+ * Build scenario state for a seed. Returns NULL on failure.
+ * Must be deterministic: equal seeds produce equal scenarios.
+ */
+typedef void *(*Bench_SetupFunc)(uint64_t seed);
+
+/**
+ * Perform one operation. iteration counts up from 0 within each timed batch,
+ * so scenarios can cycle through precomputed inputs with iteration % N and
+ * every batch sees the same inputs. State changes carry over between batches.
+ * The return value is folded into a sink so the work cannot be optimized out.
+ */
+typedef uint64_t (*Bench_RunFunc)(void *state, uint64_t iteration);
+
+/** Free scenario state. Called with whatever setup returned. */
+typedef void (*Bench_TeardownFunc)(void *state);
+
+typedef struct Bench_Case {
+    const char *name;               /* "<area>/<scenario>", used by --filter */
+    Bench_SetupFunc setup;
+    Bench_RunFunc run;
+    Bench_TeardownFunc teardown;
+} Bench_Case;
+
+typedef struct Bench_Suite {
+    const Bench_Case *cases;
+    int count;
+} Bench_Suite;
+
+/* Case tables, one per bench_<area>.cpp */
+extern const Bench_Suite bench_ai_suite;
+extern const Bench_Suite bench_core_suite;
+extern const Bench_Suite bench_ecs_suite;
+extern const Bench_Suite bench_graphics_suite;
+extern const Bench_Suite bench_strategy_suite;
+extern const Bench_Suite bench_ui_suite;
+
+#define BENCH_SUITE(name, table) \
+    const Bench_Suite name = { table, (int)(sizeof(table) / sizeof(table[0])) }
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+/** Build "<work_dir>/<name>" into buf, for scenarios that write files */
+void bench_work_path(char *buf, size_t size, const char *name);
+
+/* ============================================================================
+ * Allocation Tracking (bench_alloc.c)
+ * ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** True when heap allocations can be counted on this platform */
+bool bench_alloc_tracking_supported(void);
+
+/** Allocations and requested bytes since process start (all threads) */
+void bench_alloc_totals(uint64_t *out_count, uint64_t *out_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGENTITE_BENCH_H */
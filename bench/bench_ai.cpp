@@ -0,0 +1,96 @@
+/*
+ * Agentite Benchmark Suite - AI
+ *
+ * Pathfinding over a seeded maze-like grid.
+ */
+
+#include "bench.h"
+#include "agentite/pathfinding.h"
+#include "agentite/containers.h"
+#include <stdlib.h>
+
+/* ============================================================================
+ * pathfinding/find_128
+ * ============================================================================ */
+
+#define PATH_GRID_SIZE 128
+#define PATH_QUERY_COUNT 64
+
+typedef struct PathBench {
+    Agentite_Pathfinder *pf;
+    int queries[PATH_QUERY_COUNT][4];   /* start x/y, end x/y */
+} PathBench;
+
+static void random_open_cell(Agentite_Pathfinder *pf, int *x, int *y) {
+    do {
+        *x = agentite_rand_int(0, PATH_GRID_SIZE - 1);
+        *y = agentite_rand_int(0, PATH_GRID_SIZE - 1);
+    } while (!agentite_pathfinder_is_walkable(pf, *x, *y));
+}
+
+static void *path_find_setup(uint64_t seed) {
+    PathBench *b = (PathBench *)calloc(1, sizeof(PathBench));
+    if (!b) return NULL;
+
+    b->pf = agentite_pathfinder_create(PATH_GRID_SIZE, PATH_GRID_SIZE);
+    if (!b->pf) {
+        free(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+
+    /* Wall segments with gaps, plus scattered rough terrain */
+    for (int i = 0; i < 160; i++) {
+        int x = agentite_rand_int(0, PATH_GRID_SIZE - 1);
+        int y = agentite_rand_int(0, PATH_GRID_SIZE - 1);
+        int len = agentite_rand_int(4, 24);
+        bool horizontal = agentite_rand_bool();
+        for (int j = 0; j < len; j++) {
+            int wx = horizontal ? x + j : x;
+            int wy = horizontal ? y : y + j;
+            if (wx < PATH_GRID_SIZE && wy < PATH_GRID_SIZE) {
+                agentite_pathfinder_set_walkable(b->pf, wx, wy, false);
+            }
+        }
+    }
+    for (int i = 0; i < 2000; i++) {
+        int x = agentite_rand_int(0, PATH_GRID_SIZE - 1);
+        int y = agentite_rand_int(0, PATH_GRID_SIZE - 1);
+        agentite_pathfinder_set_cost(b->pf, x, y, agentite_rand_float(1.0f, 4.0f));
+    }
+
+    for (int i = 0; i < PATH_QUERY_COUNT; i++) {
+        random_open_cell(b->pf, &b->queries[i][0], &b->queries[i][1]);
+        random_open_cell(b->pf, &b->queries[i][2], &b->queries[i][3]);
+    }
+
+    return b;
+}
+
+static uint64_t path_find_run(void *state, uint64_t iteration) {
+    PathBench *b = (PathBench *)state;
+    const int *q = b->queries[iteration % PATH_QUERY_COUNT];
+
+    Agentite_Path *path = agentite_pathfinder_find(b->pf, q[0], q[1], q[2], q[3]);
+    uint64_t length = path ? (uint64_t)path->length : 0;
+    agentite_path_destroy(path);
+    return length;
+}
+
+static void path_find_teardown(void *state) {
+    PathBench *b = (PathBench *)state;
+    if (!b) return;
+    agentite_pathfinder_destroy(b->pf);
+    free(b);
+}
+
+/* ============================================================================
+ * Suite
+ * ============================================================================ */
+
+static const Bench_Case s_cases[] = {
+    { "pathfinding/find_128", path_find_setup, path_find_run, path_find_teardown },
+};
+
+BENCH_SUITE(bench_ai_suite, s_cases);
@@ -0,0 +1,84 @@
+/*
+ * Agentite Benchmark Suite - Allocation Tracking
+ *
+ * Counts heap allocations by interposing malloc/calloc/realloc in the bench
+ * executable and forwarding to the C library. The engine allocates through
+ * the C allocator directly (and operator new ends up there too), so this
+ * sees every allocation without touching engine code.
+ *
+ * Only glibc exports the __libc_* entry points needed to forward safely.
+ * Elsewhere, and under sanitizers that replace the allocator themselves,
+ * tracking is reported as unsupported and the JSON carries null counts.
+ */
+
+#include "bench.h"
+#include <stdlib.h>
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define BENCH_ALLOC_SANITIZER 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define BENCH_ALLOC_SANITIZER 1
+#endif
+
+#if defined(__GLIBC__) && !defined(BENCH_ALLOC_SANITIZER)
+#define BENCH_ALLOC_HOOKS 1
+#endif
+
+#ifdef BENCH_ALLOC_HOOKS
+
+#include <stdatomic.h>
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static _Atomic uint64_t s_alloc_count;
+static _Atomic uint64_t s_alloc_bytes;
+
+static inline void count_alloc(size_t size) {
+    atomic_fetch_add_explicit(&s_alloc_count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&s_alloc_bytes, (uint64_t)size, memory_order_relaxed);
+}
+
+void *malloc(size_t size) {
+    count_alloc(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    count_alloc(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    /* realloc(ptr, 0) frees rather than allocates */
+    if (size > 0) {
+        count_alloc(size);
+    }
+    return __libc_realloc(ptr, size);
+}
+
+bool bench_alloc_tracking_supported(void) {
+    return true;
+}
+
+void bench_alloc_totals(uint64_t *out_count, uint64_t *out_bytes) {
+    if (out_count) *out_count = atomic_load_explicit(&s_alloc_count, memory_order_relaxed);
+    if (out_bytes) *out_bytes = atomic_load_explicit(&s_alloc_bytes, memory_order_relaxed);
+}
+
+#else
+
+bool bench_alloc_tracking_supported(void) {
+    return false;
+}
+
+void bench_alloc_totals(uint64_t *out_count, uint64_t *out_bytes) {
+    if (out_count) *out_count = 0;
+    if (out_bytes) *out_bytes = 0;
+}
+
+#endif /* BENCH_ALLOC_HOOKS */
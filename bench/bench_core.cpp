@@ -0,0 +1,574 @@
+/*
+ * Agentite Benchmark Suite - Core
+ *
+ * Collision raycasts, command submission, event dispatch, formula evaluation,
+ * noise sampling and cached queries.
+ */
+
+#include "bench.h"
+#include "agentite/collision.h"
+#include "agentite/command.h"
+#include "agentite/event.h"
+#include "agentite/formula.h"
+#include "agentite/noise.h"
+#include "agentite/query.h"
+#include "agentite/containers.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * collision/raycast
+ * ============================================================================ */
+
+#define RAY_WORLD_SIZE 4096.0f
+#define RAY_COLLIDER_COUNT 1000
+#define RAY_QUERY_COUNT 256
+
+typedef struct RayBench {
+    Agentite_CollisionWorld *world;
+    Agentite_CollisionShape *shapes[3];
+    float rays[RAY_QUERY_COUNT][4];     /* origin x/y, direction x/y */
+} RayBench;
+
+static void ray_teardown(void *state) {
+    RayBench *b = (RayBench *)state;
+    if (!b) return;
+    agentite_collision_world_destroy(b->world);
+    for (int i = 0; i < 3; i++) {
+        agentite_collision_shape_destroy(b->shapes[i]);
+    }
+    free(b);
+}
+
+static void *ray_setup(uint64_t seed) {
+    RayBench *b = (RayBench *)calloc(1, sizeof(RayBench));
+    if (!b) return NULL;
+
+    Agentite_CollisionWorldConfig config = AGENTITE_COLLISION_WORLD_DEFAULT;
+    config.max_colliders = RAY_COLLIDER_COUNT;
+    b->world = agentite_collision_world_create(&config);
+    b->shapes[0] = agentite_collision_shape_circle(12.0f);
+    b->shapes[1] = agentite_collision_shape_aabb(32.0f, 24.0f);
+    b->shapes[2] = agentite_collision_shape_obb(40.0f, 16.0f);
+    if (!b->world || !b->shapes[0] || !b->shapes[1] || !b->shapes[2]) {
+        ray_teardown(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+
+    for (int i = 0; i < RAY_COLLIDER_COUNT; i++) {
+        float x = agentite_rand_float(0.0f, RAY_WORLD_SIZE);
+        float y = agentite_rand_float(0.0f, RAY_WORLD_SIZE);
+        Agentite_ColliderId id = agentite_collision_add(b->world, b->shapes[i % 3], x, y);
+        if (i % 3 == 2) {
+            agentite_collision_set_rotation(b->world, id, agentite_rand_float(0.0f, 3.14159f));
+        }
+    }
+
+    for (int i = 0; i < RAY_QUERY_COUNT; i++) {
+        float angle = agentite_rand_float(0.0f, 6.28318f);
+        b->rays[i][0] = agentite_rand_float(0.0f, RAY_WORLD_SIZE);
+        b->rays[i][1] = agentite_rand_float(0.0f, RAY_WORLD_SIZE);
+        b->rays[i][2] = cosf(angle);
+        b->rays[i][3] = sinf(angle);
+    }
+
+    return b;
+}
+
+static uint64_t ray_run(void *state, uint64_t iteration) {
+    RayBench *b = (RayBench *)state;
+    const float *r = b->rays[iteration % RAY_QUERY_COUNT];
+
+    Agentite_RaycastHit hit;
+    if (agentite_collision_raycast(b->world, r[0], r[1], r[2], r[3], 1024.0f,
+                                   AGENTITE_COLLISION_LAYER_ALL, &hit)) {
+        return (uint64_t)hit.collider;
+    }
+    return 0;
+}
+
+/* ============================================================================
+ * formula/exec and formula/eval
+ * ============================================================================ */
+
+static const char *const FORMULA_EXPR =
+    "base_damage * (1 + strength * 0.05) - max(armor - pierce, 0) * 0.5 "
+    "+ floor(level * 1.5) * crit";
+
+typedef struct FormulaBench {
+    Agentite_FormulaContext *ctx;
+    Agentite_Formula *compiled;
+    double levels[64];
+} FormulaBench;
+
+static void *formula_setup(uint64_t seed) {
+    FormulaBench *b = (FormulaBench *)calloc(1, sizeof(FormulaBench));
+    if (!b) return NULL;
+
+    b->ctx = agentite_formula_create();
+    if (!b->ctx) {
+        free(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+    agentite_formula_set_var(b->ctx, "base_damage", 40.0);
+    agentite_formula_set_var(b->ctx, "strength", 12.0);
+    agentite_formula_set_var(b->ctx, "armor", 18.0);
+    agentite_formula_set_var(b->ctx, "pierce", 6.0);
+    agentite_formula_set_var(b->ctx, "crit", 1.0);
+    agentite_formula_set_var(b->ctx, "level", 1.0);
+    for (int i = 0; i < 64; i++) {
+        b->levels[i] = (double)agentite_rand_int(1, 50);
+    }
+
+    b->compiled = agentite_formula_compile(b->ctx, FORMULA_EXPR);
+    if (!b->compiled) {
+        agentite_formula_destroy(b->ctx);
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+static uint64_t formula_exec_run(void *state, uint64_t iteration) {
+    FormulaBench *b = (FormulaBench *)state;
+    agentite_formula_set_var(b->ctx, "level", b->levels[iteration % 64]);
+    return (uint64_t)agentite_formula_exec(b->compiled, b->ctx);
+}
+
+static uint64_t formula_eval_run(void *state, uint64_t iteration) {
+    FormulaBench *b = (FormulaBench *)state;
+    agentite_formula_set_var(b->ctx, "level", b->levels[iteration % 64]);
+    return (uint64_t)agentite_formula_eval(b->ctx, FORMULA_EXPR);
+}
+
+static void formula_teardown(void *state) {
+    FormulaBench *b = (FormulaBench *)state;
+    if (!b) return;
+    agentite_formula_free(b->compiled);
+    agentite_formula_destroy(b->ctx);
+    free(b);
+}
+
+/* ============================================================================
+ * command/queue_execute and command/submit_inline
+ * ============================================================================ */
+
+#define CMD_BENCH_MOVE 1
+#define CMD_BENCH_UNITS 64
+
+typedef struct CommandBench {
+    Agentite_CommandSystem *commands;
+    Agentite_CommandKey key_unit, key_x, key_y;
+    int32_t unit_x[CMD_BENCH_UNITS];
+    int32_t unit_y[CMD_BENCH_UNITS];
+} CommandBench;
+
+static bool cmd_bench_validate(const Agentite_Command *cmd, void *game_state,
+                               char *error_buf, size_t error_size) {
+    (void)game_state; (void)error_buf; (void)error_size;
+    return agentite_command_get_int(cmd, "x") >= 0;
+}
+
+static bool cmd_bench_execute(const Agentite_Command *cmd, void *game_state) {
+    CommandBench *b = (CommandBench *)game_state;
+    int unit = agentite_command_get_int_id(cmd, b->key_unit) & (CMD_BENCH_UNITS - 1);
+    b->unit_x[unit] = agentite_command_get_int_id(cmd, b->key_x);
+    b->unit_y[unit] = agentite_command_get_int_id(cmd, b->key_y);
+    return true;
+}
+
+static void *cmd_setup(uint64_t seed) {
+    (void)seed;
+    CommandBench *b = (CommandBench *)calloc(1, sizeof(CommandBench));
+    if (!b) return NULL;
+    b->commands = agentite_command_create();
+    if (!b->commands) {
+        free(b);
+        return NULL;
+    }
+    agentite_command_register(b->commands, CMD_BENCH_MOVE, cmd_bench_validate, cmd_bench_execute);
+    agentite_command_enable_history(b->commands, 64);
+    b->key_unit = agentite_command_key("unit");
+    b->key_x = agentite_command_key("x");
+    b->key_y = agentite_command_key("y");
+    return b;
+}
+
+/* The classic path: heap command with string keys, queued then executed */
+static uint64_t cmd_queue_execute_run(void *state, uint64_t iteration) {
+    CommandBench *b = (CommandBench *)state;
+    Agentite_Command *cmd = agentite_command_new(CMD_BENCH_MOVE);
+    agentite_command_set_int(cmd, "unit", (int32_t)iteration);
+    agentite_command_set_int(cmd, "x", (int32_t)(iteration & 255));
+    agentite_command_set_int(cmd, "y", (int32_t)(iteration >> 8));
+    agentite_command_queue(b->commands, cmd);
+    agentite_command_free(cmd);
+    agentite_command_execute_next(b->commands, b);
+    return (uint64_t)b->unit_x[iteration & (CMD_BENCH_UNITS - 1)];
+}
+
+/* Stack command with interned keys, executed in place */
+static uint64_t cmd_submit_inline_run(void *state, uint64_t iteration) {
+    CommandBench *b = (CommandBench *)state;
+    Agentite_Command cmd;
+    agentite_command_init(&cmd, CMD_BENCH_MOVE, -1);
+    agentite_command_set_int_id(&cmd, b->key_unit, (int32_t)iteration);
+    agentite_command_set_int_id(&cmd, b->key_x, (int32_t)(iteration & 255));
+    agentite_command_set_int_id(&cmd, b->key_y, (int32_t)(iteration >> 8));
+    agentite_command_submit_inline(b->commands, &cmd, b);
+    return (uint64_t)b->unit_x[iteration & (CMD_BENCH_UNITS - 1)];
+}
+
+static void cmd_teardown(void *state) {
+    CommandBench *b = (CommandBench *)state;
+    if (!b) return;
+    agentite_command_destroy(b->commands);
+    free(b);
+}
+
+/* ============================================================================
+ * command/execute_all_64 and command/execute_batched_64
+ *
+ * One op queues 64 moves for 64 different units and executes them. The
+ * validator walks the cost grid along the move, roughly what a
+ * reachability check costs, so the two cases compare serial validation
+ * with validation spread over the job pool.
+ * ============================================================================ */
+
+#define CMD_BATCH_GRID 256
+#define CMD_BATCH_RANGE 96
+
+typedef struct CommandBatchBench {
+    Agentite_CommandSystem *commands;
+    Agentite_JobPool *jobs;
+    Agentite_CommandKey key_unit, key_x, key_y;
+    uint8_t cost[CMD_BATCH_GRID * CMD_BATCH_GRID];
+    int32_t unit_x[CMD_BENCH_UNITS];
+    int32_t unit_y[CMD_BENCH_UNITS];
+    uint32_t rng;
+} CommandBatchBench;
+
+static bool cmd_batch_validate(const Agentite_Command *cmd, void *game_state,
+                               char *error_buf, size_t error_size) {
+    const CommandBatchBench *b = (const CommandBatchBench *)game_state;
+    int unit = agentite_command_get_int_id(cmd, b->key_unit);
+    int x0 = b->unit_x[unit], y0 = b->unit_y[unit];
+    int x1 = agentite_command_get_int_id(cmd, b->key_x);
+    int y1 = agentite_command_get_int_id(cmd, b->key_y);
+
+    /* Sample the path at quarter-cell steps and sum the terrain cost */
+    int steps = 4 * (abs(x1 - x0) > abs(y1 - y0) ? abs(x1 - x0) : abs(y1 - y0)) + 1;
+    uint32_t total = 0;
+    for (int i = 0; i <= steps; i++) {
+        int x = x0 + (x1 - x0) * i / steps;
+        int y = y0 + (y1 - y0) * i / steps;
+        total += b->cost[(y & (CMD_BATCH_GRID - 1)) * CMD_BATCH_GRID + (x & (CMD_BATCH_GRID - 1))];
+    }
+    if (total > (uint32_t)steps * 200u) {
+        snprintf(error_buf, error_size, "Path too expensive");
+        return false;
+    }
+    return true;
+}
+
+static bool cmd_batch_execute(const Agentite_Command *cmd, void *game_state) {
+    CommandBatchBench *b = (CommandBatchBench *)game_state;
+    int unit = agentite_command_get_int_id(cmd, b->key_unit);
+    b->unit_x[unit] = agentite_command_get_int_id(cmd, b->key_x);
+    b->unit_y[unit] = agentite_command_get_int_id(cmd, b->key_y);
+    return true;
+}
+
+static bool cmd_batch_access(const Agentite_Command *cmd, const void *game_state,
+                             Agentite_CommandAccess *access) {
+    const CommandBatchBench *b = (const CommandBatchBench *)game_state;
+    agentite_command_access_write(access, AGENTITE_CMD_RESOURCE_ENTITY(
+        agentite_command_get_int_id(cmd, b->key_unit)));
+    return true;
+}
+
+static uint32_t cmd_batch_rand(CommandBatchBench *b) {
+    b->rng = b->rng * 1664525u + 1013904223u;
+    return b->rng >> 8;
+}
+
+static void *cmd_batch_setup(uint64_t seed) {
+    CommandBatchBench *b = (CommandBatchBench *)calloc(1, sizeof(CommandBatchBench));
+    if (!b) return NULL;
+    b->commands = agentite_command_create();
+    b->jobs = agentite_job_pool_create(0);
+    if (!b->commands || !b->jobs) {
+        agentite_command_destroy(b->commands);
+        agentite_job_pool_destroy(b->jobs);
+        free(b);
+        return NULL;
+    }
+    agentite_command_register(b->commands, CMD_BENCH_MOVE, cmd_batch_validate, cmd_batch_execute);
+    agentite_command_set_access(b->commands, CMD_BENCH_MOVE, cmd_batch_access);
+    b->key_unit = agentite_command_key("unit");
+    b->key_x = agentite_command_key("x");
+    b->key_y = agentite_command_key("y");
+
+    b->rng = (uint32_t)seed | 1u;
+    for (int i = 0; i < CMD_BATCH_GRID * CMD_BATCH_GRID; i++) {
+        b->cost[i] = (uint8_t)(cmd_batch_rand(b) & 0xFF);
+    }
+    for (int u = 0; u < CMD_BENCH_UNITS; u++) {
+        b->unit_x[u] = (int32_t)(cmd_batch_rand(b) % CMD_BATCH_GRID);
+        b->unit_y[u] = (int32_t)(cmd_batch_rand(b) % CMD_BATCH_GRID);
+    }
+    return b;
+}
+
+static void cmd_batch_queue(CommandBatchBench *b) {
+    for (int u = 0; u < CMD_BENCH_UNITS; u++) {
+        Agentite_Command cmd;
+        agentite_command_init(&cmd, CMD_BENCH_MOVE, -1);
+        agentite_command_set_int_id(&cmd, b->key_unit, u);
+        agentite_command_set_int_id(&cmd, b->key_x,
+            b->unit_x[u] + (int32_t)(cmd_batch_rand(b) % (2 * CMD_BATCH_RANGE)) - CMD_BATCH_RANGE);
+        agentite_command_set_int_id(&cmd, b->key_y,
+            b->unit_y[u] + (int32_t)(cmd_batch_rand(b) % (2 * CMD_BATCH_RANGE)) - CMD_BATCH_RANGE);
+        agentite_command_queue(b->commands, &cmd);
+    }
+}
+
+static uint64_t cmd_execute_all_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    CommandBatchBench *b = (CommandBatchBench *)state;
+    cmd_batch_queue(b);
+    return (uint64_t)agentite_command_execute_all(b->commands, b, NULL, 0);
+}
+
+static uint64_t cmd_execute_batched_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    CommandBatchBench *b = (CommandBatchBench *)state;
+    cmd_batch_queue(b);
+    return (uint64_t)agentite_command_execute_batched(b->commands, b, b->jobs, NULL, 0);
+}
+
+static void cmd_batch_teardown(void *state) {
+    CommandBatchBench *b = (CommandBatchBench *)state;
+    if (!b) return;
+    agentite_command_destroy(b->commands);
+    agentite_job_pool_destroy(b->jobs);
+    free(b);
+}
+
+/* ============================================================================
+ * event/emit and event/flush_grouped
+ * ============================================================================ */
+
+#define EVENT_TYPE_COUNT 32
+#define EVENT_LISTENERS_PER_TYPE 8
+#define EVENT_WILDCARD_LISTENERS 4
+#define EVENT_BATCH 256
+
+typedef struct EventBench {
+    Agentite_EventDispatcher *events;
+    Agentite_Event batch[EVENT_BATCH];
+    uint64_t sink;
+} EventBench;
+
+static void event_sink(const Agentite_Event *event, void *userdata) {
+    ((EventBench *)userdata)->sink += (uint64_t)event->type;
+}
+
+/* Custom event types so the scenario doesn't depend on the built-in enum */
+static void *event_setup(uint64_t seed) {
+    EventBench *b = (EventBench *)calloc(1, sizeof(EventBench));
+    if (!b) return NULL;
+    b->events = agentite_event_dispatcher_create();
+    if (!b->events) {
+        free(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+    for (int t = 0; t < EVENT_TYPE_COUNT; t++) {
+        for (int l = 0; l < EVENT_LISTENERS_PER_TYPE; l++) {
+            agentite_event_subscribe(b->events, (Agentite_EventType)(AGENTITE_EVENT_CUSTOM + t),
+                                     event_sink, b);
+        }
+    }
+    for (int l = 0; l < EVENT_WILDCARD_LISTENERS; l++) {
+        agentite_event_subscribe_all(b->events, event_sink, b);
+    }
+    for (int i = 0; i < EVENT_BATCH; i++) {
+        b->batch[i].type = (Agentite_EventType)(AGENTITE_EVENT_CUSTOM +
+                                                agentite_rand_int(0, EVENT_TYPE_COUNT - 1));
+    }
+    return b;
+}
+
+/* One event to one type's listeners, out of 32 * 8 + 4 registered */
+static uint64_t event_emit_run(void *state, uint64_t iteration) {
+    EventBench *b = (EventBench *)state;
+    agentite_event_emit(b->events, &b->batch[iteration % EVENT_BATCH]);
+    return b->sink;
+}
+
+/* A turn's worth of mixed-type deferred events, flushed grouped by type */
+static uint64_t event_flush_grouped_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    EventBench *b = (EventBench *)state;
+    for (int i = 0; i < EVENT_BATCH; i++) {
+        agentite_event_emit_deferred(b->events, &b->batch[i]);
+    }
+    agentite_event_flush_deferred_grouped(b->events);
+    return b->sink;
+}
+
+static void event_teardown(void *state) {
+    EventBench *b = (EventBench *)state;
+    if (!b) return;
+    agentite_event_dispatcher_destroy(b->events);
+    free(b);
+}
+
+/* ============================================================================
+ * noise/fbm2d and noise/heightmap_64
+ * ============================================================================ */
+
+static void *noise_setup(uint64_t seed) {
+    return agentite_noise_create(seed);
+}
+
+/* One 6-octave sample; coordinates walk a 256x256 grid */
+static uint64_t noise_fbm_run(void *state, uint64_t iteration) {
+    const Agentite_Noise *noise = (const Agentite_Noise *)state;
+    Agentite_NoiseFractalConfig fbm = AGENTITE_NOISE_FRACTAL_DEFAULT;
+    fbm.octaves = 6;
+    fbm.frequency = 0.02f;
+
+    float x = (float)(iteration & 255);
+    float y = (float)((iteration >> 8) & 255);
+    float v = agentite_noise_fbm2d(noise, x, y, &fbm);
+    return (uint64_t)(v * 65536.0f);
+}
+
+/* A whole 64x64 heightmap per op, including its allocation */
+static uint64_t noise_heightmap_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    const Agentite_Noise *noise = (const Agentite_Noise *)state;
+    float *heightmap = agentite_noise_heightmap_create(noise, 64, 64, NULL);
+    uint64_t sum = heightmap ? (uint64_t)(heightmap[64 * 32 + 32] * 65536.0f) : 0;
+    agentite_noise_heightmap_destroy(heightmap);
+    return sum;
+}
+
+static void noise_teardown(void *state) {
+    agentite_noise_destroy((Agentite_Noise *)state);
+}
+
+/* ============================================================================
+ * Suite
+ * ============================================================================ */
+
+/* ============================================================================
+ * query/hit_copy, query/hit_ref and query/stale_recompute
+ *
+ * A 1 KB per-faction summary cached for 16 factions. The hit cases differ
+ * only in copying the result out versus reading it in place; the stale
+ * case bumps the dependency every op so each lookup recomputes.
+ * ============================================================================ */
+
+#define QUERY_BENCH_FACTIONS 16
+
+typedef struct QuerySummary {
+    int32_t faction;
+    int32_t totals[255];
+} QuerySummary;
+
+typedef struct QueryBench {
+    Agentite_QuerySystem *queries;
+    Agentite_QueryDep dep;
+    Agentite_QueryParams params[QUERY_BENCH_FACTIONS];
+    QuerySummary out;
+} QueryBench;
+
+static Agentite_QueryStatus query_bench_summary(void *game_state,
+                                                const Agentite_QueryParams *params,
+                                                void *result, size_t result_size,
+                                                void *userdata) {
+    (void)game_state; (void)result_size; (void)userdata;
+    QuerySummary *r = (QuerySummary *)result;
+    r->faction = agentite_query_params_get_int(params, 0);
+    for (int i = 0; i < 255; i++) {
+        r->totals[i] = r->faction * 31 + i;
+    }
+    return AGENTITE_QUERY_OK;
+}
+
+static void *query_setup(uint64_t seed) {
+    (void)seed;
+    QueryBench *b = (QueryBench *)calloc(1, sizeof(QueryBench));
+    if (!b) return NULL;
+    b->queries = agentite_query_create();
+    if (!b->queries) {
+        free(b);
+        return NULL;
+    }
+    agentite_query_register(b->queries, "summary", query_bench_summary, sizeof(QuerySummary));
+    agentite_query_enable_cache(b->queries, "summary", QUERY_BENCH_FACTIONS);
+    b->dep = agentite_query_dep(b->queries, "economy");
+    agentite_query_add_dep(b->queries, "summary", b->dep);
+    for (int f = 0; f < QUERY_BENCH_FACTIONS; f++) {
+        agentite_query_params_init(&b->params[f]);
+        agentite_query_params_add_int(&b->params[f], f);
+    }
+    return b;
+}
+
+static uint64_t query_hit_copy_run(void *state, uint64_t iteration) {
+    QueryBench *b = (QueryBench *)state;
+    const Agentite_QueryParams *params = &b->params[iteration % QUERY_BENCH_FACTIONS];
+    agentite_query_exec(b->queries, "summary", NULL, params, &b->out);
+    return (uint64_t)b->out.totals[iteration & 127];
+}
+
+static uint64_t query_hit_ref_run(void *state, uint64_t iteration) {
+    QueryBench *b = (QueryBench *)state;
+    const Agentite_QueryParams *params = &b->params[iteration % QUERY_BENCH_FACTIONS];
+    const QuerySummary *r = (const QuerySummary *)
+        agentite_query_exec_ref(b->queries, "summary", NULL, params, NULL);
+    return r ? (uint64_t)r->totals[iteration & 127] : 0;
+}
+
+static uint64_t query_stale_run(void *state, uint64_t iteration) {
+    QueryBench *b = (QueryBench *)state;
+    agentite_query_dep_bump(b->queries, b->dep);
+    return query_hit_ref_run(state, iteration);
+}
+
+static void query_teardown(void *state) {
+    QueryBench *b = (QueryBench *)state;
+    if (!b) return;
+    agentite_query_destroy(b->queries);
+    free(b);
+}
+
+static const Bench_Case s_cases[] = {
+    { "collision/raycast",    ray_setup,     ray_run,             ray_teardown },
+    { "command/queue_execute", cmd_setup, cmd_queue_execute_run, cmd_teardown },
+    { "command/submit_inline", cmd_setup, cmd_submit_inline_run, cmd_teardown },
+    { "command/execute_all_64", cmd_batch_setup, cmd_execute_all_run, cmd_batch_teardown },
+    { "command/execute_batched_64", cmd_batch_setup, cmd_execute_batched_run, cmd_batch_teardown },
+    { "event/emit",           event_setup,   event_emit_run,      event_teardown },
+    { "event/flush_grouped",  event_setup,   event_flush_grouped_run, event_teardown },
+    { "formula/exec",         formula_setup, formula_exec_run,    formula_teardown },
+    { "formula/eval",         formula_setup, formula_eval_run,    formula_teardown },
+    { "noise/fbm2d",          noise_setup,   noise_fbm_run,       noise_teardown },
+    { "noise/heightmap_64",   noise_setup,   noise_heightmap_run, noise_teardown },
+    { "query/hit_copy",       query_setup,   query_hit_copy_run,  query_teardown },
+    { "query/hit_ref",        query_setup,   query_hit_ref_run,   query_teardown },
+    { "query/stale_recompute", query_setup,  query_stale_run,     query_teardown },
+};
+
+BENCH_SUITE(bench_core_suite, s_cases);
@@ -0,0 +1,489 @@
+/*
+ * Agentite Benchmark Suite - ECS
+ *
+ * Transform hierarchy propagation through the Flecs pipeline, a
+ * per-entity system run on one thread and on four, prefab spawning
+ * through the per-entity path versus a compiled batch, scene loading from
+ * source versus the compiled scene cache, and one time-budgeted streaming
+ * update.
+ */
+
+#include "bench.h"
+#include "agentite/ecs.h"
+#include "agentite/transform.h"
+#include "agentite/containers.h"
+#include "agentite/prefab.h"
+#include "agentite/ecs_reflect.h"
+#include "agentite/scene.h"
+#include "flecs.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ============================================================================
+ * ecs/transform_propagate and ecs/transform_static
+ * ============================================================================ */
+
+/* 500 roots, each with 4 children that each have 2 children: 6500 entities */
+#define XFORM_ROOTS 500
+#define XFORM_CHILDREN 4
+#define XFORM_GRANDCHILDREN 2
+
+typedef struct TransformBench {
+    Agentite_World *aworld;
+    ecs_world_t *world;
+    ecs_entity_t roots[XFORM_ROOTS];
+} TransformBench;
+
+static ecs_entity_t create_transform_entity(ecs_world_t *world, float x, float y,
+                                            float rotation) {
+    ecs_entity_t e = ecs_new(world);
+    C_Transform tf = { x, y, rotation, 1.0f, 1.0f };
+    C_WorldTransform wtf = { x, y, rotation, 1.0f, 1.0f };
+    ecs_set_id(world, e, ecs_id(C_Transform), sizeof(C_Transform), &tf);
+    ecs_set_id(world, e, ecs_id(C_WorldTransform), sizeof(C_WorldTransform), &wtf);
+    return e;
+}
+
+static void *transform_setup(uint64_t seed) {
+    TransformBench *b = (TransformBench *)calloc(1, sizeof(TransformBench));
+    if (!b) return NULL;
+
+    b->aworld = agentite_ecs_init();
+    if (!b->aworld) {
+        free(b);
+        return NULL;
+    }
+    b->world = agentite_ecs_get_world(b->aworld);
+    agentite_transform_register(b->world);
+
+    agentite_random_seed(seed);
+
+    for (int r = 0; r < XFORM_ROOTS; r++) {
+        ecs_entity_t root = create_transform_entity(
+            b->world, agentite_rand_float(0.0f, 2048.0f), agentite_rand_float(0.0f, 2048.0f),
+            agentite_rand_float(0.0f, 6.28f));
+        b->roots[r] = root;
+
+        for (int c = 0; c < XFORM_CHILDREN; c++) {
+            ecs_entity_t child = create_transform_entity(
+                b->world, agentite_rand_float(-32.0f, 32.0f), agentite_rand_float(-32.0f, 32.0f),
+                agentite_rand_float(0.0f, 6.28f));
+            agentite_transform_set_parent(b->world, child, root);
+
+            for (int g = 0; g < XFORM_GRANDCHILDREN; g++) {
+                ecs_entity_t grandchild = create_transform_entity(
+                    b->world, agentite_rand_float(-8.0f, 8.0f), agentite_rand_float(-8.0f, 8.0f), 0.0f);
+                agentite_transform_set_parent(b->world, grandchild, child);
+            }
+        }
+    }
+
+    /* Settle the initial world transforms outside the timed region */
+    agentite_ecs_progress(b->aworld, 0.016f);
+    return b;
+}
+
+/* One frame: a tenth of the roots move, then the pipeline runs */
+static uint64_t transform_run(void *state, uint64_t iteration) {
+    TransformBench *b = (TransformBench *)state;
+
+    for (int r = (int)(iteration % 10); r < XFORM_ROOTS; r += 10) {
+        agentite_transform_translate(b->world, b->roots[r], 1.0f, -1.0f);
+    }
+    agentite_ecs_progress(b->aworld, 0.016f);
+
+    const C_WorldTransform *wt = (const C_WorldTransform *)ecs_get_id(
+        b->world, b->roots[iteration % XFORM_ROOTS], ecs_id(C_WorldTransform));
+    return wt ? (uint64_t)wt->world_x : 0;
+}
+
+/* One frame of a settled scene: nothing moved, so nothing needs propagating */
+static uint64_t transform_static_run(void *state, uint64_t iteration) {
+    TransformBench *b = (TransformBench *)state;
+    agentite_ecs_progress(b->aworld, 0.016f);
+
+    const C_WorldTransform *wt = (const C_WorldTransform *)ecs_get_id(
+        b->world, b->roots[iteration % XFORM_ROOTS], ecs_id(C_WorldTransform));
+    return wt ? (uint64_t)wt->world_x : 0;
+}
+
+static void transform_teardown(void *state) {
+    TransformBench *b = (TransformBench *)state;
+    if (!b) return;
+    agentite_ecs_shutdown(b->aworld);
+    free(b);
+}
+
+/* ============================================================================
+ * ecs/systems_1_thread and ecs/systems_4_threads
+ * ============================================================================ */
+
+#define SYSTEMS_ENTITIES 50000
+
+typedef struct SystemsBench {
+    Agentite_World *aworld;
+    ecs_world_t *world;
+    ecs_entity_t probe;
+} SystemsBench;
+
+/* Steer toward the origin: enough math per entity to be worth splitting */
+static void SteerSystem(ecs_iter_t *it) {
+    C_Position *pos = ecs_field(it, C_Position, 0);
+    C_Velocity *vel = ecs_field(it, C_Velocity, 1);
+    float dt = it->delta_time;
+    for (int i = 0; i < it->count; i++) {
+        float dist = sqrtf(pos[i].x * pos[i].x + pos[i].y * pos[i].y) + 1.0f;
+        float angle = atan2f(pos[i].y, pos[i].x);
+        vel[i].vx += -cosf(angle) * 50.0f / dist * dt;
+        vel[i].vy += -sinf(angle) * 50.0f / dist * dt;
+        pos[i].x += vel[i].vx * dt;
+        pos[i].y += vel[i].vy * dt;
+    }
+}
+
+static void *systems_setup(uint64_t seed, int threads) {
+    SystemsBench *b = (SystemsBench *)calloc(1, sizeof(SystemsBench));
+    if (!b) return NULL;
+
+    b->aworld = agentite_ecs_init();
+    if (!b->aworld) {
+        free(b);
+        return NULL;
+    }
+    b->world = agentite_ecs_get_world(b->aworld);
+    agentite_ecs_set_threads(b->aworld, threads);
+
+    ecs_id_t phases[] = { ecs_dependson(EcsOnUpdate), EcsOnUpdate, 0 };
+    ecs_entity_desc_t entity_desc = {};
+    entity_desc.name = "SteerSystem";
+    entity_desc.add = phases;
+
+    ecs_system_desc_t desc = {};
+    desc.entity = ecs_entity_init(b->world, &entity_desc);
+    desc.query.terms[0].id = ecs_id(C_Position);
+    desc.query.terms[0].inout = EcsInOut;
+    desc.query.terms[1].id = ecs_id(C_Velocity);
+    desc.query.terms[1].inout = EcsInOut;
+    desc.callback = SteerSystem;
+    desc.multi_threaded = true;
+    ecs_system_init(b->world, &desc);
+
+    agentite_random_seed(seed);
+    for (int i = 0; i < SYSTEMS_ENTITIES; i++) {
+        ecs_entity_t e = ecs_new(b->world);
+        C_Position pos = { agentite_rand_float(-1000.0f, 1000.0f), agentite_rand_float(-1000.0f, 1000.0f) };
+        C_Velocity vel = { 0.0f, 0.0f };
+        ecs_set_id(b->world, e, ecs_id(C_Position), sizeof(pos), &pos);
+        ecs_set_id(b->world, e, ecs_id(C_Velocity), sizeof(vel), &vel);
+        if (i == 0) b->probe = e;
+    }
+    return b;
+}
+
+static void *systems_1_setup(uint64_t seed) {
+    return systems_setup(seed, 1);
+}
+
+static void *systems_4_setup(uint64_t seed) {
+    return systems_setup(seed, 4);
+}
+
+static uint64_t systems_run(void *state, uint64_t iteration) {
+    SystemsBench *b = (SystemsBench *)state;
+    (void)iteration;
+    agentite_ecs_progress(b->aworld, 0.016f);
+
+    const C_Position *pos = (const C_Position *)ecs_get_id(b->world, b->probe, ecs_id(C_Position));
+    return pos ? (uint64_t)(int64_t)pos->x : 0;
+}
+
+static void systems_teardown(void *state) {
+    SystemsBench *b = (SystemsBench *)state;
+    if (!b) return;
+    agentite_ecs_shutdown(b->aworld);
+    free(b);
+}
+
+/* ============================================================================
+ * ecs/prefab_spawn_slow and ecs/prefab_spawn_batch
+ * ============================================================================ */
+
+#define PREFAB_SPAWNS 10000
+
+typedef struct BenchUnit {
+    int health;
+    int armor;
+    float speed;
+    float range;
+} BenchUnit;
+
+typedef struct PrefabBench {
+    Agentite_World *aworld;
+    ecs_world_t *world;
+    Agentite_ReflectRegistry *reflect;
+    Agentite_Prefab *prefab;
+    Agentite_CompiledPrefab *compiled;
+    ecs_entity_t c_unit;
+    float positions[PREFAB_SPAWNS * 2];
+    ecs_entity_t spawned[PREFAB_SPAWNS];
+} PrefabBench;
+
+static void prefab_teardown(void *state);
+
+/* BenchUnit, C_Position and C_Velocity, registered with flecs and reflection */
+static ecs_entity_t register_bench_components(ecs_world_t *world,
+                                              Agentite_ReflectRegistry *reflect) {
+    ecs_entity_desc_t entity_desc = {};
+    entity_desc.name = "BenchUnit";
+    ecs_component_desc_t comp_desc = {};
+    comp_desc.entity = ecs_entity_init(world, &entity_desc);
+    comp_desc.type.size = sizeof(BenchUnit);
+    comp_desc.type.alignment = alignof(BenchUnit);
+    ecs_entity_t c_unit = ecs_component_init(world, &comp_desc);
+
+    Agentite_FieldDesc unit_fields[] = {
+        { "health", AGENTITE_FIELD_INT, offsetof(BenchUnit, health), sizeof(int) },
+        { "armor", AGENTITE_FIELD_INT, offsetof(BenchUnit, armor), sizeof(int) },
+        { "speed", AGENTITE_FIELD_FLOAT, offsetof(BenchUnit, speed), sizeof(float) },
+        { "range", AGENTITE_FIELD_FLOAT, offsetof(BenchUnit, range), sizeof(float) },
+    };
+    agentite_reflect_register(reflect, c_unit, "BenchUnit", sizeof(BenchUnit),
+                              unit_fields, 4);
+    Agentite_FieldDesc pos_fields[] = {
+        { "x", AGENTITE_FIELD_FLOAT, offsetof(C_Position, x), sizeof(float) },
+        { "y", AGENTITE_FIELD_FLOAT, offsetof(C_Position, y), sizeof(float) },
+    };
+    agentite_reflect_register(reflect, ecs_id(C_Position), "C_Position",
+                              sizeof(C_Position), pos_fields, 2);
+    Agentite_FieldDesc vel_fields[] = {
+        { "vx", AGENTITE_FIELD_FLOAT, offsetof(C_Velocity, vx), sizeof(float) },
+        { "vy", AGENTITE_FIELD_FLOAT, offsetof(C_Velocity, vy), sizeof(float) },
+    };
+    agentite_reflect_register(reflect, ecs_id(C_Velocity), "C_Velocity",
+                              sizeof(C_Velocity), vel_fields, 2);
+    return c_unit;
+}
+
+static void *prefab_setup(uint64_t seed) {
+    PrefabBench *b = (PrefabBench *)calloc(1, sizeof(PrefabBench));
+    if (!b) return NULL;
+
+    b->aworld = agentite_ecs_init();
+    b->reflect = agentite_reflect_create();
+    if (!b->aworld || !b->reflect) {
+        prefab_teardown(b);
+        return NULL;
+    }
+    b->world = agentite_ecs_get_world(b->aworld);
+    agentite_ecs_register_components(b->aworld);
+    b->c_unit = register_bench_components(b->world, b->reflect);
+
+    b->prefab = agentite_prefab_load_string(
+        "Entity {\n"
+        "    BenchUnit: { health: 100, armor: 5, speed: 2.5, range: 64 }\n"
+        "    C_Velocity: { vx: 1, vy: 0 }\n"
+        "}\n", 0, "bench", b->reflect);
+
+    Agentite_SpawnContext ctx = {};
+    ctx.world = b->world;
+    ctx.reflect = b->reflect;
+    b->compiled = b->prefab ? agentite_prefab_compile(b->prefab, &ctx) : NULL;
+    if (!b->compiled) {
+        prefab_teardown(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+    for (int i = 0; i < PREFAB_SPAWNS * 2; i++) {
+        b->positions[i] = agentite_rand_float(0.0f, 4096.0f);
+    }
+    return b;
+}
+
+/* Both variants delete what they spawned, so the world stays the same size */
+static uint64_t prefab_clear(PrefabBench *b) {
+    uint64_t sum = 0;
+    for (int i = 0; i < PREFAB_SPAWNS; i++) {
+        sum += b->spawned[i];
+    }
+    ecs_delete_with(b->world, b->c_unit);
+    return sum;
+}
+
+static uint64_t prefab_slow_run(void *state, uint64_t iteration) {
+    PrefabBench *b = (PrefabBench *)state;
+    (void)iteration;
+    for (int i = 0; i < PREFAB_SPAWNS; i++) {
+        b->spawned[i] = agentite_prefab_spawn_at(b->prefab, b->world, b->reflect,
+                                                 b->positions[i * 2], b->positions[i * 2 + 1]);
+    }
+    return prefab_clear(b);
+}
+
+static uint64_t prefab_batch_run(void *state, uint64_t iteration) {
+    PrefabBench *b = (PrefabBench *)state;
+    (void)iteration;
+    agentite_prefab_spawn_batch(b->compiled, PREFAB_SPAWNS, b->positions, b->spawned);
+    return prefab_clear(b);
+}
+
+static void prefab_teardown(void *state) {
+    PrefabBench *b = (PrefabBench *)state;
+    if (!b) return;
+    agentite_prefab_compiled_destroy(b->compiled);
+    agentite_prefab_destroy(b->prefab);
+    agentite_reflect_destroy(b->reflect);
+    agentite_ecs_shutdown(b->aworld);
+    free(b);
+}
+
+/* ============================================================================
+ * ecs/scene_load_parse, ecs/scene_load_cached and ecs/scene_stream_update
+ * ============================================================================ */
+
+/* 2000 roots, every tenth named, each with two children: 6000 entities */
+#define SCENE_ROOTS 2000
+
+typedef struct SceneBench {
+    Agentite_World *aworld;
+    ecs_world_t *world;
+    Agentite_ReflectRegistry *reflect;
+    Agentite_SceneLoadContext ctx;
+    Agentite_SceneStreamConfig config;
+    Agentite_SceneManager *scenes;
+    char path[512];
+    char cache_dir[512];
+} SceneBench;
+
+static void scene_teardown(void *state);
+
+static void *scene_setup(uint64_t seed, bool cached) {
+    SceneBench *b = (SceneBench *)calloc(1, sizeof(SceneBench));
+    if (!b) return NULL;
+
+    b->aworld = agentite_ecs_init();
+    b->reflect = agentite_reflect_create();
+    if (!b->aworld || !b->reflect) {
+        scene_teardown(b);
+        return NULL;
+    }
+    b->world = agentite_ecs_get_world(b->aworld);
+    agentite_ecs_register_components(b->aworld);
+    register_bench_components(b->world, b->reflect);
+
+    bench_work_path(b->path, sizeof(b->path), "bench.scene");
+    bench_work_path(b->cache_dir, sizeof(b->cache_dir), ".");
+    FILE *file = fopen(b->path, "w");
+    if (!file) {
+        scene_teardown(b);
+        return NULL;
+    }
+    agentite_random_seed(seed);
+    for (int i = 0; i < SCENE_ROOTS; i++) {
+        if (i % 10 == 0) {
+            fprintf(file, "Squad%d", i);
+        } else {
+            fputs("Entity", file);
+        }
+        fprintf(file, " @(%.1f, %.1f) {\n"
+                      "    BenchUnit: { health: %d, armor: 5, speed: 2.5, range: 64 }\n"
+                      "    C_Velocity: { vx: %.2f, vy: 0 }\n"
+                      "    Entity @(8, 0) { BenchUnit: { health: 50 } }\n"
+                      "    Entity @(-8, 0) { BenchUnit: { health: 50 } }\n"
+                      "}\n",
+                agentite_rand_float(0.0f, 4096.0f), agentite_rand_float(0.0f, 4096.0f),
+                agentite_rand_int(50, 150), agentite_rand_float(-1.0f, 1.0f));
+    }
+    fclose(file);
+
+    b->ctx.reflect = b->reflect;
+    b->ctx.cache_dir = cached ? b->cache_dir : NULL;
+
+    /* Warm the cache so every timed load reads it */
+    if (cached) {
+        Agentite_SceneManager *scenes = agentite_scene_manager_create();
+        Agentite_Scene *scene = scenes ? agentite_scene_load(scenes, b->path, &b->ctx) : NULL;
+        agentite_scene_manager_destroy(scenes);
+        if (!scene) {
+            scene_teardown(b);
+            return NULL;
+        }
+    }
+    return b;
+}
+
+static void *scene_parse_setup(uint64_t seed) {
+    return scene_setup(seed, false);
+}
+
+static void *scene_cached_setup(uint64_t seed) {
+    return scene_setup(seed, true);
+}
+
+/* Load and instantiate; destroying the manager removes the entities again */
+static uint64_t scene_run(void *state, uint64_t iteration) {
+    SceneBench *b = (SceneBench *)state;
+    (void)iteration;
+    Agentite_SceneManager *scenes = agentite_scene_manager_create();
+    Agentite_Scene *scene = agentite_scene_load(scenes, b->path, &b->ctx);
+    uint64_t count = 0;
+    if (scene && agentite_scene_instantiate(scene, b->world, &b->ctx)) {
+        count = (uint64_t)agentite_scene_get_entity_count(scene);
+    }
+    agentite_scene_manager_destroy(scenes);
+    return count;
+}
+
+/* One streaming update under a 1 ms budget; a finished level restarts */
+static void *scene_stream_setup(uint64_t seed) {
+    SceneBench *b = (SceneBench *)scene_setup(seed, true);
+    if (!b) return NULL;
+    b->config.budget_us = 1000;
+    b->scenes = agentite_scene_manager_create();
+    if (!b->scenes ||
+        !agentite_scene_stream_begin(b->scenes, b->path, b->world, &b->ctx, &b->config)) {
+        scene_teardown(b);
+        return NULL;
+    }
+    return b;
+}
+
+static uint64_t scene_stream_run(void *state, uint64_t iteration) {
+    SceneBench *b = (SceneBench *)state;
+    (void)iteration;
+    Agentite_SceneStreamStatus status = agentite_scene_stream_update(b->scenes);
+    if (status == AGENTITE_SCENE_STREAM_COMPLETE) {
+        Agentite_Scene *scene = agentite_scene_manager_get_active(b->scenes);
+        agentite_scene_uninstantiate(scene, b->world);
+        agentite_scene_stream_begin(b->scenes, b->path, b->world, &b->ctx, &b->config);
+    }
+    return (uint64_t)status;
+}
+
+static void scene_teardown(void *state) {
+    SceneBench *b = (SceneBench *)state;
+    if (!b) return;
+    agentite_scene_manager_destroy(b->scenes);
+    agentite_reflect_destroy(b->reflect);
+    agentite_ecs_shutdown(b->aworld);
+    free(b);
+}
+
+/* ============================================================================
+ * Suite
+ * ============================================================================ */
+
+static const Bench_Case s_cases[] = {
+    { "ecs/transform_propagate", transform_setup,    transform_run,        transform_teardown },
+    { "ecs/transform_static",    transform_setup,    transform_static_run, transform_teardown },
+    { "ecs/systems_1_thread",    systems_1_setup,    systems_run,          systems_teardown },
+    { "ecs/systems_4_threads",   systems_4_setup,    systems_run,          systems_teardown },
+    { "ecs/prefab_spawn_slow",   prefab_setup,       prefab_slow_run,      prefab_teardown },
+    { "ecs/prefab_spawn_batch",  prefab_setup,       prefab_batch_run,     prefab_teardown },
+    { "ecs/scene_load_parse",    scene_parse_setup,  scene_run,            scene_teardown },
+    { "ecs/scene_load_cached",   scene_cached_setup, scene_run,            scene_teardown },
+    { "ecs/scene_stream_update", scene_stream_setup, scene_stream_run,     scene_teardown },
+};
+
+BENCH_SUITE(bench_ecs_suite, s_cases);
@@ -0,0 +1,170 @@
+/*
+ * Agentite Benchmark Suite - Graphics
+ *
+ * CPU-side vertex generation for sprite batches and tilemap chunk meshes.
+ * Only the pure builders are called; no renderer, texture or GPU buffer is
+ * created.
+ */
+
+#include "bench.h"
+#include "agentite/sprite.h"
+#include "agentite/tilemap.h"
+#include "agentite/containers.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * graphics/sprite_vertices
+ * ============================================================================ */
+
+/* One frame of sprites: positions, rotations, atlas cells and tints vary */
+#define SPRITE_BENCH_COUNT 10000
+#define SPRITE_BENCH_ATLAS_CELLS 16
+
+typedef struct SpriteInput {
+    float x, y, w, h;
+    float rotation;
+    float u0, v0, u1, v1;
+    float r, g, b, a;
+} SpriteInput;
+
+typedef struct SpriteBench {
+    SpriteInput *inputs;
+    Agentite_SpriteVertex *vertices;
+} SpriteBench;
+
+static void sprite_vertices_teardown(void *state);
+
+static void *sprite_vertices_setup(uint64_t seed) {
+    SpriteBench *b = (SpriteBench *)calloc(1, sizeof(SpriteBench));
+    if (!b) return NULL;
+
+    b->inputs = (SpriteInput *)malloc(SPRITE_BENCH_COUNT * sizeof(SpriteInput));
+    b->vertices = (Agentite_SpriteVertex *)malloc(
+        SPRITE_BENCH_COUNT * 4 * sizeof(Agentite_SpriteVertex));
+    if (!b->inputs || !b->vertices) {
+        sprite_vertices_teardown(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+
+    const float cell = 1.0f / SPRITE_BENCH_ATLAS_CELLS;
+    for (int i = 0; i < SPRITE_BENCH_COUNT; i++) {
+        SpriteInput *in = &b->inputs[i];
+        in->x = agentite_rand_float(0.0f, 1920.0f);
+        in->y = agentite_rand_float(0.0f, 1080.0f);
+        in->w = agentite_rand_float(8.0f, 64.0f);
+        in->h = agentite_rand_float(8.0f, 64.0f);
+
+        /* A quarter of the sprites are rotated, the rest take the fast path */
+        in->rotation = (i % 4 == 0) ? agentite_rand_float(0.0f, 360.0f) : 0.0f;
+
+        int cx = agentite_rand_int(0, SPRITE_BENCH_ATLAS_CELLS - 1);
+        int cy = agentite_rand_int(0, SPRITE_BENCH_ATLAS_CELLS - 1);
+        in->u0 = cx * cell;
+        in->v0 = cy * cell;
+        in->u1 = in->u0 + cell;
+        in->v1 = in->v0 + cell;
+
+        in->r = agentite_rand_float(0.5f, 1.0f);
+        in->g = agentite_rand_float(0.5f, 1.0f);
+        in->b = agentite_rand_float(0.5f, 1.0f);
+        in->a = agentite_rand_float(0.25f, 1.0f);
+    }
+
+    return b;
+}
+
+/* Build every quad of the frame into the batch array */
+static uint64_t sprite_vertices_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    SpriteBench *b = (SpriteBench *)state;
+    Agentite_SpriteVertex *v = b->vertices;
+
+    for (int i = 0; i < SPRITE_BENCH_COUNT; i++) {
+        const SpriteInput *in = &b->inputs[i];
+        agentite_sprite_build_quad(v, in->x, in->y, in->w, in->h, in->rotation,
+                                   0.5f, 0.5f, in->u0, in->v0, in->u1, in->v1,
+                                   in->r, in->g, in->b, in->a);
+        v += 4;
+    }
+
+    const Agentite_SpriteVertex *last = &b->vertices[SPRITE_BENCH_COUNT * 4 - 2];
+    return (uint64_t)last->pos[0] + last->color[3];
+}
+
+static void sprite_vertices_teardown(void *state) {
+    SpriteBench *b = (SpriteBench *)state;
+    if (!b) return;
+    free(b->inputs);
+    free(b->vertices);
+    free(b);
+}
+
+/* ============================================================================
+ * graphics/tile_mesh
+ * ============================================================================ */
+
+/* Rebuild a 32x32 chunk mesh, about one in ten tiles empty */
+#define TILE_BENCH_CHUNK 32
+#define TILE_BENCH_TYPES 64
+
+typedef struct TileBench {
+    Agentite_TileUV uvs[TILE_BENCH_TYPES];
+    Agentite_TileID tiles[TILE_BENCH_CHUNK * TILE_BENCH_CHUNK];
+    Agentite_SpriteVertex vertices[TILE_BENCH_CHUNK * TILE_BENCH_CHUNK * 4];
+} TileBench;
+
+static void *tile_mesh_setup(uint64_t seed) {
+    TileBench *b = (TileBench *)calloc(1, sizeof(TileBench));
+    if (!b) return NULL;
+
+    agentite_random_seed(seed);
+
+    const float cell = 1.0f / 8.0f;
+    for (int i = 0; i < TILE_BENCH_TYPES; i++) {
+        b->uvs[i].u0 = (i % 8) * cell;
+        b->uvs[i].v0 = (i / 8) * cell;
+        b->uvs[i].u1 = b->uvs[i].u0 + cell;
+        b->uvs[i].v1 = b->uvs[i].v0 + cell;
+    }
+    for (int i = 0; i < TILE_BENCH_CHUNK * TILE_BENCH_CHUNK; i++) {
+        b->tiles[i] = agentite_rand_int(0, 9) == 0 ?
+            AGENTITE_TILE_EMPTY : (Agentite_TileID)agentite_rand_int(1, TILE_BENCH_TYPES);
+    }
+
+    return b;
+}
+
+static uint64_t tile_mesh_run(void *state, uint64_t iteration) {
+    TileBench *b = (TileBench *)state;
+
+    Agentite_TileMeshDesc desc = {};
+    desc.uvs = b->uvs;
+    desc.uv_count = TILE_BENCH_TYPES;
+    desc.tile_width = 32.0f;
+    desc.tile_height = 32.0f;
+    desc.origin_x = (float)(iteration % 8) * TILE_BENCH_CHUNK * 32.0f;
+    desc.opacity = 1.0f;
+
+    int quads = agentite_tilemap_build_mesh(&desc, b->tiles, TILE_BENCH_CHUNK,
+                                            TILE_BENCH_CHUNK, TILE_BENCH_CHUNK,
+                                            b->vertices);
+    return (uint64_t)quads + (uint64_t)b->vertices[0].pos[0];
+}
+
+static void tile_mesh_teardown(void *state) {
+    free(state);
+}
+
+/* ============================================================================
+ * Suite
+ * ============================================================================ */
+
+static const Bench_Case s_cases[] = {
+    { "graphics/sprite_vertices", sprite_vertices_setup, sprite_vertices_run, sprite_vertices_teardown },
+    { "graphics/tile_mesh", tile_mesh_setup, tile_mesh_run, tile_mesh_teardown },
+};
+
+BENCH_SUITE(bench_graphics_suite, s_cases);
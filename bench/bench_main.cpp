@@ -0,0 +1,370 @@
+/*
+ * Agentite Benchmark Suite - Runner
+ *
+ * Usage:
+ *   agentite_bench [options] > results.json
+ *
+ * Options:
+ *   --filter TEXT      Only run cases whose name contains TEXT
+ *   --seed N           Scenario seed (default 12345)
+ *   --samples N        Timed batches per case (default 25)
+ *   --min-time-ms MS   Target duration of one batch (default 2)
+ *   --quick            Few short batches; for smoke-testing the suite
+ *   --out FILE         Write JSON to FILE instead of stdout
+ *   --work-dir DIR     Scratch directory for file scenarios (default bench_work)
+ *   --list             Print case names and exit
+ *
+ * Progress and a summary table go to stderr, JSON to stdout (or --out), so
+ * results can be redirected straight into a file and compared between
+ * commits with scripts/bench-compare.py.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#define bench_mkdir(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define bench_mkdir(path) mkdir(path, 0755)
+#endif
+
+#ifndef AGENTITE_BENCH_REVISION
+#define AGENTITE_BENCH_REVISION "unknown"
+#endif
+
+#define BENCH_MAX_BATCH (1u << 24)
+
+static const Bench_Suite *const s_suites[] = {
+    &bench_ai_suite,
+    &bench_core_suite,
+    &bench_ecs_suite,
+    &bench_graphics_suite,
+    &bench_strategy_suite,
+    &bench_ui_suite,
+};
+
+/* ============================================================================
+ * Options
+ * ============================================================================ */
+
+typedef struct BenchOptions {
+    const char *filter;
+    const char *out_path;
+    const char *work_dir;
+    uint64_t seed;
+    int samples;
+    double min_time_ms;
+    bool list;
+} BenchOptions;
+
+static BenchOptions s_options;
+
+/* Folded with every run() result so the work cannot be optimized away */
+static volatile uint64_t s_sink;
+
+void bench_work_path(char *buf, size_t size, const char *name) {
+    snprintf(buf, size, "%s/%s", s_options.work_dir, name);
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --filter TEXT      Only run cases whose name contains TEXT\n"
+            "  --seed N           Scenario seed (default 12345)\n"
+            "  --samples N        Timed batches per case (default 25)\n"
+            "  --min-time-ms MS   Target duration of one batch (default 2)\n"
+            "  --quick            Few short batches; for smoke-testing the suite\n"
+            "  --out FILE         Write JSON to FILE instead of stdout\n"
+            "  --work-dir DIR     Scratch directory for file scenarios\n"
+            "  --list             Print case names and exit\n",
+            program);
+}
+
+static bool parse_options(int argc, char **argv, BenchOptions *opts) {
+    opts->filter = NULL;
+    opts->out_path = NULL;
+    opts->work_dir = "bench_work";
+    opts->seed = 12345;
+    opts->samples = 25;
+    opts->min_time_ms = 2.0;
+    opts->list = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--quick") == 0) {
+            opts->samples = 3;
+            opts->min_time_ms = 0.2;
+        } else if (strcmp(arg, "--list") == 0) {
+            opts->list = true;
+        } else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            print_usage(argv[0]);
+            exit(0);
+        } else if (!value) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        } else if (strcmp(arg, "--filter") == 0) {
+            opts->filter = value; i++;
+        } else if (strcmp(arg, "--seed") == 0) {
+            opts->seed = strtoull(value, NULL, 0); i++;
+        } else if (strcmp(arg, "--samples") == 0) {
+            opts->samples = atoi(value); i++;
+        } else if (strcmp(arg, "--min-time-ms") == 0) {
+            opts->min_time_ms = atof(value); i++;
+        } else if (strcmp(arg, "--out") == 0) {
+            opts->out_path = value; i++;
+        } else if (strcmp(arg, "--work-dir") == 0) {
+            opts->work_dir = value; i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (opts->samples < 1) opts->samples = 1;
+    if (opts->min_time_ms < 0.0) opts->min_time_ms = 0.0;
+    return true;
+}
+
+/* ============================================================================
+ * Measurement
+ * ============================================================================ */
+
+typedef struct BenchResult {
+    const char *name;
+    bool ok;
+    uint64_t batch;             /* Operations per timed sample */
+    uint64_t ops;               /* Total timed operations */
+    double min_ns, p50_ns, p90_ns, p99_ns, max_ns, mean_ns;
+    double allocs_per_op;
+    double bytes_per_op;
+} BenchResult;
+
+static inline uint64_t now_ns(void) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Run count operations, returning elapsed ns. Iterations restart at 0 so every
+ * batch replays the same inputs and samples stay comparable.
+ */
+static uint64_t run_batch(const Bench_Case *bc, void *state, uint64_t count) {
+    uint64_t sink = 0;
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < count; i++) {
+        sink ^= bc->run(state, i);
+    }
+    uint64_t elapsed = now_ns() - start;
+    s_sink = s_sink ^ sink;
+    return elapsed;
+}
+
+/** Nearest-rank percentile of sorted values */
+static double percentile(const std::vector<double> &sorted, double pct) {
+    size_t rank = (size_t)(pct / 100.0 * (double)sorted.size() + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > sorted.size()) rank = sorted.size();
+    return sorted[rank - 1];
+}
+
+static BenchResult run_case(const Bench_Case *bc) {
+    BenchResult result;
+    memset(&result, 0, sizeof(result));
+    result.name = bc->name;
+
+    void *state = bc->setup(s_options.seed);
+    if (!state) {
+        fprintf(stderr, "  %-36s setup failed\n", bc->name);
+        return result;
+    }
+
+    /* Calibrate the batch size; this doubles as warmup */
+    uint64_t target_ns = (uint64_t)(s_options.min_time_ms * 1e6);
+    uint64_t batch = 1;
+    for (;;) {
+        uint64_t elapsed = run_batch(bc, state, batch);
+        if (elapsed >= target_ns || batch >= BENCH_MAX_BATCH) break;
+
+        uint64_t next = batch * 10;
+        if (elapsed > 0) {
+            double scaled = (double)batch * (double)target_ns * 1.2 / (double)elapsed;
+            if (scaled < (double)next) next = (uint64_t)scaled + 1;
+        }
+        batch = std::min<uint64_t>(std::max<uint64_t>(next, batch * 2), BENCH_MAX_BATCH);
+    }
+
+    std::vector<double> samples;
+    samples.reserve((size_t)s_options.samples);
+
+    uint64_t allocs_before = 0, bytes_before = 0;
+    uint64_t allocs_after = 0, bytes_after = 0;
+    bench_alloc_totals(&allocs_before, &bytes_before);
+
+    for (int s = 0; s < s_options.samples; s++) {
+        uint64_t elapsed = run_batch(bc, state, batch);
+        samples.push_back((double)elapsed / (double)batch);
+    }
+
+    bench_alloc_totals(&allocs_after, &bytes_after);
+    bc->teardown(state);
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+
+    result.ok = true;
+    result.batch = batch;
+    result.ops = batch * (uint64_t)s_options.samples;
+    result.min_ns = samples.front();
+    result.max_ns = samples.back();
+    result.p50_ns = percentile(samples, 50.0);
+    result.p90_ns = percentile(samples, 90.0);
+    result.p99_ns = percentile(samples, 99.0);
+    result.mean_ns = sum / (double)samples.size();
+    result.allocs_per_op = (double)(allocs_after - allocs_before) / (double)result.ops;
+    result.bytes_per_op = (double)(bytes_after - bytes_before) / (double)result.ops;
+
+    if (bench_alloc_tracking_supported()) {
+        fprintf(stderr, "  %-36s %12.1f ns/op  p90 %12.1f  allocs/op %8.2f\n",
+                bc->name, result.p50_ns, result.p90_ns, result.allocs_per_op);
+    } else {
+        fprintf(stderr, "  %-36s %12.1f ns/op  p90 %12.1f  allocs/op      n/a\n",
+                bc->name, result.p50_ns, result.p90_ns);
+    }
+    return result;
+}
+
+/* ============================================================================
+ * JSON Output
+ * ============================================================================ */
+
+static void write_json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fprintf(f, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(f, "\\u%04x", c);
+        } else {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+static void write_json(FILE *f, const std::vector<BenchResult> &results) {
+    bool tracking = bench_alloc_tracking_supported();
+
+    char timestamp[32];
+    time_t now = time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"suite\": \"agentite_bench\",\n");
+    fprintf(f, "  \"format_version\": 1,\n");
+    fprintf(f, "  \"revision\": ");
+    write_json_string(f, AGENTITE_BENCH_REVISION);
+    fprintf(f, ",\n  \"timestamp\": \"%s\",\n", timestamp);
+#if defined(__VERSION__)
+    fprintf(f, "  \"compiler\": ");
+    write_json_string(f, __VERSION__);
+    fprintf(f, ",\n");
+#endif
+#ifdef NDEBUG
+    fprintf(f, "  \"build\": \"release\",\n");
+#else
+    fprintf(f, "  \"build\": \"debug\",\n");
+#endif
+    fprintf(f, "  \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+    fprintf(f, "  \"seed\": %llu,\n", (unsigned long long)s_options.seed);
+    fprintf(f, "  \"samples\": %d,\n", s_options.samples);
+    fprintf(f, "  \"alloc_tracking\": %s,\n", tracking ? "true" : "false");
+    fprintf(f, "  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult *r = &results[i];
+        fprintf(f, "    {\"name\": ");
+        write_json_string(f, r->name);
+        if (!r->ok) {
+            fprintf(f, ", \"error\": \"setup failed\"}");
+        } else {
+            fprintf(f, ", \"batch\": %llu, \"ops\": %llu,\n",
+                    (unsigned long long)r->batch, (unsigned long long)r->ops);
+            fprintf(f, "     \"ns_per_op\": {\"min\": %.2f, \"p50\": %.2f, \"p90\": %.2f, "
+                       "\"p99\": %.2f, \"max\": %.2f, \"mean\": %.2f},\n",
+                    r->min_ns, r->p50_ns, r->p90_ns, r->p99_ns, r->max_ns, r->mean_ns);
+            if (tracking) {
+                fprintf(f, "     \"allocs_per_op\": %.4f, \"bytes_per_op\": %.1f}",
+                        r->allocs_per_op, r->bytes_per_op);
+            } else {
+                fprintf(f, "     \"allocs_per_op\": null, \"bytes_per_op\": null}");
+            }
+        }
+        fprintf(f, "%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+
+    fprintf(f, "  ]\n}\n");
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(int argc, char **argv) {
+    if (!parse_options(argc, argv, &s_options)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<const Bench_Case *> selected;
+    for (const Bench_Suite *suite : s_suites) {
+        for (int i = 0; i < suite->count; i++) {
+            const Bench_Case *bc = &suite->cases[i];
+            if (!s_options.filter || strstr(bc->name, s_options.filter)) {
+                selected.push_back(bc);
+            }
+        }
+    }
+
+    if (s_options.list) {
+        for (const Bench_Case *bc : selected) printf("%s\n", bc->name);
+        return 0;
+    }
+
+    bench_mkdir(s_options.work_dir);
+
+    fprintf(stderr, "agentite_bench: %zu cases, seed %llu, %d samples\n",
+            selected.size(), (unsigned long long)s_options.seed, s_options.samples);
+
+    std::vector<BenchResult> results;
+    bool all_ok = true;
+    for (const Bench_Case *bc : selected) {
+        results.push_back(run_case(bc));
+        all_ok = all_ok && results.back().ok;
+    }
+
+    FILE *out = stdout;
+    if (s_options.out_path) {
+        out = fopen(s_options.out_path, "w");
+        if (!out) {
+            fprintf(stderr, "Failed to open %s for writing\n", s_options.out_path);
+            return 1;
+        }
+    }
+    write_json(out, results);
+    if (out != stdout) fclose(out);
+
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,478 @@
+/*
+ * Agentite Benchmark Suite - Strategy
+ *
+ * Spatial index queries, fog of war updates, save/load and replay files.
+ */
+
+#include "bench.h"
+#include "agentite/spatial.h"
+#include "agentite/fog.h"
+#include "agentite/save.h"
+#include "agentite/replay.h"
+#include "agentite/command.h"
+#include "agentite/containers.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * spatial/query_radius, spatial/query_nearest, spatial/move and the _sparse variants
+ * ============================================================================ */
+
+#define SPATIAL_MAP_SIZE 512
+#define SPATIAL_ENTITY_COUNT 4096
+#define SPATIAL_QUERY_COUNT 256
+
+typedef struct SpatialBench {
+    Agentite_SpatialIndex *index;
+    int pos[SPATIAL_ENTITY_COUNT][2];
+    int queries[SPATIAL_QUERY_COUNT][2];
+    uint64_t moves;
+    Agentite_SpatialQueryResult results[1024];
+} SpatialBench;
+
+static void *spatial_setup(uint64_t seed) {
+    SpatialBench *b = (SpatialBench *)calloc(1, sizeof(SpatialBench));
+    if (!b) return NULL;
+
+    b->index = agentite_spatial_create(SPATIAL_ENTITY_COUNT * 2);
+    if (!b->index) {
+        free(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+
+    /* Half the units cluster around a few bases, the rest are spread out */
+    for (int i = 0; i < SPATIAL_ENTITY_COUNT; i++) {
+        int x, y;
+        if (i % 2 == 0) {
+            int base = i % 8;
+            x = 64 + base * 48 + agentite_rand_int(-12, 12);
+            y = 64 + base * 48 + agentite_rand_int(-12, 12);
+        } else {
+            x = agentite_rand_int(0, SPATIAL_MAP_SIZE - 1);
+            y = agentite_rand_int(0, SPATIAL_MAP_SIZE - 1);
+        }
+        b->pos[i][0] = x;
+        b->pos[i][1] = y;
+        agentite_spatial_add(b->index, x, y, (uint32_t)(i + 1));
+    }
+
+    for (int i = 0; i < SPATIAL_QUERY_COUNT; i++) {
+        b->queries[i][0] = agentite_rand_int(0, SPATIAL_MAP_SIZE - 1);
+        b->queries[i][1] = agentite_rand_int(0, SPATIAL_MAP_SIZE - 1);
+    }
+
+    return b;
+}
+
+static uint64_t spatial_query_run(void *state, uint64_t iteration) {
+    SpatialBench *b = (SpatialBench *)state;
+    const int *q = b->queries[iteration % SPATIAL_QUERY_COUNT];
+    return (uint64_t)agentite_spatial_query_radius(b->index, q[0], q[1], 8,
+                                                   b->results, 1024);
+}
+
+/* Units take turns stepping to a neighbouring cell and back */
+static uint64_t spatial_move_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    SpatialBench *b = (SpatialBench *)state;
+    uint64_t move = b->moves++;
+    int i = (int)(move % SPATIAL_ENTITY_COUNT);
+    int step = ((move / SPATIAL_ENTITY_COUNT) & 1) ? -1 : 1;
+
+    int old_x = b->pos[i][0];
+    int old_y = b->pos[i][1];
+    int new_x = old_x + step;
+    agentite_spatial_move(b->index, old_x, old_y, new_x, old_y, (uint32_t)(i + 1));
+    b->pos[i][0] = new_x;
+    return (uint64_t)new_x;
+}
+
+static void spatial_teardown(void *state) {
+    SpatialBench *b = (SpatialBench *)state;
+    if (!b) return;
+    agentite_spatial_destroy(b->index);
+    free(b);
+}
+
+/* Closest 8 units to a point, on the clustered map */
+static uint64_t spatial_nearest_run(void *state, uint64_t iteration) {
+    SpatialBench *b = (SpatialBench *)state;
+    const int *q = b->queries[iteration % SPATIAL_QUERY_COUNT];
+    return (uint64_t)agentite_spatial_query_nearest(b->index, q[0], q[1], 8, -1,
+                                                    NULL, NULL, b->results);
+}
+
+/* A few scouts on a large map; radius-40 searches mostly cover empty ground */
+#define SPATIAL_SPARSE_MAP_SIZE 4096
+#define SPATIAL_SPARSE_ENTITY_COUNT 64
+
+static void *spatial_sparse_setup(uint64_t seed) {
+    SpatialBench *b = (SpatialBench *)calloc(1, sizeof(SpatialBench));
+    if (!b) return NULL;
+
+    b->index = agentite_spatial_create(SPATIAL_SPARSE_ENTITY_COUNT * 2);
+    if (!b->index) {
+        free(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+    for (int i = 0; i < SPATIAL_SPARSE_ENTITY_COUNT; i++) {
+        agentite_spatial_add(b->index,
+                             agentite_rand_int(0, SPATIAL_SPARSE_MAP_SIZE - 1),
+                             agentite_rand_int(0, SPATIAL_SPARSE_MAP_SIZE - 1),
+                             (uint32_t)(i + 1));
+    }
+
+    for (int i = 0; i < SPATIAL_QUERY_COUNT; i++) {
+        b->queries[i][0] = agentite_rand_int(0, SPATIAL_SPARSE_MAP_SIZE - 1);
+        b->queries[i][1] = agentite_rand_int(0, SPATIAL_SPARSE_MAP_SIZE - 1);
+    }
+
+    return b;
+}
+
+/* Closest scout, usually several blocks away */
+static uint64_t spatial_sparse_nearest_run(void *state, uint64_t iteration) {
+    SpatialBench *b = (SpatialBench *)state;
+    const int *q = b->queries[iteration % SPATIAL_QUERY_COUNT];
+    return (uint64_t)agentite_spatial_query_nearest(b->index, q[0], q[1], 1, -1,
+                                                    NULL, NULL, b->results);
+}
+
+static uint64_t spatial_sparse_circle_run(void *state, uint64_t iteration) {
+    SpatialBench *b = (SpatialBench *)state;
+    const int *q = b->queries[iteration % SPATIAL_QUERY_COUNT];
+    return (uint64_t)agentite_spatial_query_circle(b->index, q[0], q[1], 40,
+                                                   b->results, 1024);
+}
+
+/* ============================================================================
+ * fog/update
+ * ============================================================================ */
+
+#define FOG_MAP_SIZE 256
+#define FOG_SOURCE_COUNT 128
+#define FOG_MOVES_PER_FRAME 16
+
+typedef struct FogBench {
+    Agentite_FogOfWar *fog;
+    Agentite_VisionSource sources[FOG_SOURCE_COUNT];
+    int pos[FOG_SOURCE_COUNT][2];
+} FogBench;
+
+static void *fog_setup(uint64_t seed) {
+    FogBench *b = (FogBench *)calloc(1, sizeof(FogBench));
+    if (!b) return NULL;
+
+    b->fog = agentite_fog_create(FOG_MAP_SIZE, FOG_MAP_SIZE);
+    if (!b->fog) {
+        free(b);
+        return NULL;
+    }
+
+    agentite_random_seed(seed);
+    for (int i = 0; i < FOG_SOURCE_COUNT; i++) {
+        b->pos[i][0] = agentite_rand_int(0, FOG_MAP_SIZE - 1);
+        b->pos[i][1] = agentite_rand_int(0, FOG_MAP_SIZE - 1);
+        b->sources[i] = agentite_fog_add_source(b->fog, b->pos[i][0], b->pos[i][1],
+                                                agentite_rand_int(4, 12));
+    }
+    agentite_fog_update(b->fog);
+    return b;
+}
+
+/* One turn: a handful of units move, then visibility is recomputed */
+static uint64_t fog_update_run(void *state, uint64_t iteration) {
+    FogBench *b = (FogBench *)state;
+
+    for (int m = 0; m < FOG_MOVES_PER_FRAME; m++) {
+        int i = (int)((iteration * FOG_MOVES_PER_FRAME + (uint64_t)m) % FOG_SOURCE_COUNT);
+        b->pos[i][0] = (b->pos[i][0] + 1) % FOG_MAP_SIZE;
+        agentite_fog_move_source(b->fog, b->sources[i], b->pos[i][0], b->pos[i][1]);
+    }
+    agentite_fog_update(b->fog);
+
+    return agentite_fog_is_visible(b->fog, b->pos[0][0], b->pos[0][1]) ? 1 : 0;
+}
+
+static void fog_teardown(void *state) {
+    FogBench *b = (FogBench *)state;
+    if (!b) return;
+    agentite_fog_destroy(b->fog);
+    free(b);
+}
+
+/* ============================================================================
+ * save/{binary,toml}_{write,read}
+ * ============================================================================ */
+
+#define SAVE_UNIT_COUNT 2000
+#define SAVE_NAME "bench_save"
+
+typedef struct SaveBenchState {
+    int turn;
+    int unit_ids[SAVE_UNIT_COUNT];
+    int unit_owner[SAVE_UNIT_COUNT];
+    float unit_hp[SAVE_UNIT_COUNT];
+    float unit_pos[SAVE_UNIT_COUNT * 2];
+    int loaded_units;
+} SaveBenchState;
+
+typedef struct SaveBench {
+    Agentite_SaveManager *sm;
+    SaveBenchState state;
+} SaveBench;
+
+static bool save_bench_serialize(void *game_state, Agentite_SaveWriter *writer) {
+    const SaveBenchState *gs = (const SaveBenchState *)game_state;
+
+    agentite_save_write_int(writer, "turn", gs->turn);
+    agentite_save_write_section(writer, "units");
+    agentite_save_write_int_array(writer, "ids", gs->unit_ids, SAVE_UNIT_COUNT);
+    agentite_save_write_int_array(writer, "owner", gs->unit_owner, SAVE_UNIT_COUNT);
+    agentite_save_write_float_array(writer, "hp", gs->unit_hp, SAVE_UNIT_COUNT);
+    agentite_save_write_float_array(writer, "pos", gs->unit_pos, SAVE_UNIT_COUNT * 2);
+
+    agentite_save_write_section(writer, "factions");
+    for (int i = 0; i < 8; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "gold_%d", i);
+        agentite_save_write_int(writer, key, 1000 + i * 37);
+        snprintf(key, sizeof(key), "name_%d", i);
+        agentite_save_write_string(writer, key, "Faction");
+    }
+    return true;
+}
+
+static bool save_bench_deserialize(void *game_state, Agentite_SaveReader *reader) {
+    SaveBenchState *gs = (SaveBenchState *)game_state;
+
+    if (!agentite_save_read_int(reader, "turn", &gs->turn)) return false;
+    if (!agentite_save_read_enter_section(reader, "units")) return false;
+
+    int *ids = NULL;
+    float *hp = NULL;
+    int id_count = 0, hp_count = 0;
+    bool ok = agentite_save_read_int_array(reader, "ids", &ids, &id_count) &&
+              agentite_save_read_float_array(reader, "hp", &hp, &hp_count);
+    gs->loaded_units = ok ? id_count : 0;
+    free(ids);
+    free(hp);
+    return ok;
+}
+
+static void *save_setup(uint64_t seed, Agentite_SaveFormat format) {
+    SaveBench *b = (SaveBench *)calloc(1, sizeof(SaveBench));
+    if (!b) return NULL;
+
+    char dir[512];
+    bench_work_path(dir, sizeof(dir), "saves");
+    b->sm = agentite_save_create(dir);
+    if (!b->sm) {
+        free(b);
+        return NULL;
+    }
+    agentite_save_set_format(b->sm, format);
+
+    agentite_random_seed(seed);
+    b->state.turn = 120;
+    for (int i = 0; i < SAVE_UNIT_COUNT; i++) {
+        b->state.unit_ids[i] = 1000 + i;
+        b->state.unit_owner[i] = agentite_rand_int(0, 7);
+        b->state.unit_hp[i] = agentite_rand_float(0.0f, 100.0f);
+        b->state.unit_pos[i * 2] = agentite_rand_float(0.0f, 512.0f);
+        b->state.unit_pos[i * 2 + 1] = agentite_rand_float(0.0f, 512.0f);
+    }
+
+    /* Read cases need a file to read */
+    Agentite_SaveResult result = agentite_save_game(b->sm, SAVE_NAME,
+                                                    save_bench_serialize, &b->state);
+    if (!result.success) {
+        fprintf(stderr, "    save failed: %s\n", result.error_message);
+        agentite_save_destroy(b->sm);
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+static void *save_binary_setup(uint64_t seed) {
+    return save_setup(seed, AGENTITE_SAVE_FORMAT_BINARY);
+}
+
+static void *save_toml_setup(uint64_t seed) {
+    return save_setup(seed, AGENTITE_SAVE_FORMAT_TOML);
+}
+
+static uint64_t save_write_run(void *state, uint64_t iteration) {
+    SaveBench *b = (SaveBench *)state;
+    b->state.turn = (int)iteration;
+    Agentite_SaveResult result = agentite_save_game(b->sm, SAVE_NAME,
+                                                    save_bench_serialize, &b->state);
+    return result.success ? 1 : 0;
+}
+
+static uint64_t save_read_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    SaveBench *b = (SaveBench *)state;
+    Agentite_SaveResult result = agentite_load_game(b->sm, SAVE_NAME,
+                                                    save_bench_deserialize, &b->state);
+    return result.success ? (uint64_t)b->state.loaded_units : 0;
+}
+
+static void save_teardown(void *state) {
+    SaveBench *b = (SaveBench *)state;
+    if (!b) return;
+    agentite_save_delete(b->sm, SAVE_NAME);
+    agentite_save_destroy(b->sm);
+    free(b);
+}
+
+/* ============================================================================
+ * replay/save and replay/load
+ * ============================================================================ */
+
+#define REPLAY_FRAMES 3000
+#define REPLAY_CMD_MOVE 1
+
+typedef struct ReplayGameState {
+    int unit_x[64];
+    int unit_y[64];
+} ReplayGameState;
+
+typedef struct ReplayBench {
+    Agentite_ReplaySystem *recorded;
+    Agentite_ReplaySystem *loaded;
+    Agentite_CommandSystem *commands;
+    ReplayGameState game;
+    char path[512];
+} ReplayBench;
+
+static bool replay_bench_serialize(void *game_state, void **out_data, size_t *out_size) {
+    void *copy = malloc(sizeof(ReplayGameState));
+    if (!copy) return false;
+    memcpy(copy, game_state, sizeof(ReplayGameState));
+    *out_data = copy;
+    *out_size = sizeof(ReplayGameState);
+    return true;
+}
+
+static bool replay_bench_deserialize(void *game_state, const void *data, size_t size) {
+    if (size != sizeof(ReplayGameState)) return false;
+    memcpy(game_state, data, size);
+    return true;
+}
+
+static bool replay_bench_reset(void *game_state, const Agentite_ReplayMetadata *metadata) {
+    (void)metadata;
+    memset(game_state, 0, sizeof(ReplayGameState));
+    return true;
+}
+
+static bool replay_bench_execute_move(const Agentite_Command *cmd, void *game_state) {
+    ReplayGameState *gs = (ReplayGameState *)game_state;
+    int unit = agentite_command_get_int(cmd, "unit") & 63;
+    gs->unit_x[unit] = agentite_command_get_int(cmd, "x");
+    gs->unit_y[unit] = agentite_command_get_int(cmd, "y");
+    return true;
+}
+
+static void replay_teardown(void *state) {
+    ReplayBench *b = (ReplayBench *)state;
+    if (!b) return;
+    agentite_replay_destroy(b->loaded);
+    agentite_replay_destroy(b->recorded);
+    agentite_command_destroy(b->commands);
+    remove(b->path);
+    free(b);
+}
+
+static void *replay_setup(uint64_t seed) {
+    ReplayBench *b = (ReplayBench *)calloc(1, sizeof(ReplayBench));
+    if (!b) return NULL;
+
+    Agentite_ReplayConfig config = AGENTITE_REPLAY_CONFIG_DEFAULT;
+    config.serialize = replay_bench_serialize;
+    config.deserialize = replay_bench_deserialize;
+    config.reset = replay_bench_reset;
+
+    bench_work_path(b->path, sizeof(b->path), "bench.replay");
+    b->recorded = agentite_replay_create(&config);
+    b->loaded = agentite_replay_create(&config);
+    b->commands = agentite_command_create();
+    if (!b->recorded || !b->loaded || !b->commands) {
+        replay_teardown(b);
+        return NULL;
+    }
+    agentite_command_register(b->commands, REPLAY_CMD_MOVE, NULL, replay_bench_execute_move);
+
+    Agentite_ReplayMetadata meta;
+    memset(&meta, 0, sizeof(meta));
+    strncpy(meta.map_name, "bench", sizeof(meta.map_name) - 1);
+    meta.random_seed = (uint32_t)seed;
+
+    if (!agentite_replay_start_recording(b->recorded, b->commands, &b->game, &meta)) {
+        replay_teardown(b);
+        return NULL;
+    }
+
+    /* A few commands most frames, like a busy multiplayer match */
+    agentite_random_seed(seed);
+    for (int frame = 0; frame < REPLAY_FRAMES; frame++) {
+        int count = agentite_rand_int(0, 4);
+        for (int c = 0; c < count; c++) {
+            Agentite_Command *cmd = agentite_command_new(REPLAY_CMD_MOVE);
+            agentite_command_set_int(cmd, "unit", agentite_rand_int(0, 63));
+            agentite_command_set_int(cmd, "x", agentite_rand_int(0, 255));
+            agentite_command_set_int(cmd, "y", agentite_rand_int(0, 255));
+            agentite_command_execute(b->commands, cmd, &b->game);
+            agentite_command_free(cmd);
+        }
+        agentite_replay_record_frame(b->recorded, 1.0f / 60.0f);
+    }
+    agentite_replay_stop_recording(b->recorded);
+
+    if (!agentite_replay_save(b->recorded, b->path)) {
+        replay_teardown(b);
+        return NULL;
+    }
+    return b;
+}
+
+static uint64_t replay_save_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    ReplayBench *b = (ReplayBench *)state;
+    return agentite_replay_save(b->recorded, b->path) ? 1 : 0;
+}
+
+static uint64_t replay_load_run(void *state, uint64_t iteration) {
+    (void)iteration;
+    ReplayBench *b = (ReplayBench *)state;
+    if (!agentite_replay_load(b->loaded, b->path)) return 0;
+    return agentite_replay_get_total_frames(b->loaded);
+}
+
+/* ============================================================================
+ * Suite
+ * ============================================================================ */
+
+static const Bench_Case s_cases[] = {
+    { "spatial/query_radius",         spatial_setup,        spatial_query_run,          spatial_teardown },
+    { "spatial/query_circle_sparse",  spatial_sparse_setup, spatial_sparse_circle_run,  spatial_teardown },
+    { "spatial/query_nearest",        spatial_setup,        spatial_nearest_run,        spatial_teardown },
+    { "spatial/query_nearest_sparse", spatial_sparse_setup, spatial_sparse_nearest_run, spatial_teardown },
+    { "spatial/move",                 spatial_setup,        spatial_move_run,           spatial_teardown },
+    { "fog/update",                   fog_setup,            fog_update_run,             fog_teardown },
+    { "save/binary_write",            save_binary_setup,    save_write_run,             save_teardown },
+    { "save/binary_read",             save_binary_setup,    save_read_run,              save_teardown },
+    { "save/toml_write",              save_toml_setup,      save_write_run,             save_teardown },
+    { "save/toml_read",               save_toml_setup,      save_read_run,              save_teardown },
+    { "replay/save",                  replay_setup,         replay_save_run,            replay_teardown },
+    { "replay/load",                  replay_setup,         replay_load_run,            replay_teardown },
+};
+
+BENCH_SUITE(bench_strategy_suite, s_cases);
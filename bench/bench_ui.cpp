@@ -0,0 +1,95 @@
+/*
+ * Agentite Benchmark Suite - UI
+ *
+ * Retained-mode node layout. The context is never initialized with a GPU
+ * device; layout only reads the screen size from it, and the tree uses no
+ * text nodes so no font is needed.
+ */
+
+#include "bench.h"
+#include "agentite/ui.h"
+#include "agentite/ui_node.h"
+#include "agentite/containers.h"
+#include <stdlib.h>
+
+/* ============================================================================
+ * ui/layout
+ * ============================================================================ */
+
+/* A list screen: 100 rows of 6 cells inside a vbox, about 700 nodes */
+#define UI_ROWS 100
+#define UI_CELLS_PER_ROW 6
+
+typedef struct UiBench {
+    AUI_Context *ctx;
+    AUI_Node *root;
+    AUI_Node *probe;
+} UiBench;
+
+static void *ui_layout_setup(uint64_t seed) {
+    UiBench *b = (UiBench *)calloc(1, sizeof(UiBench));
+    if (!b) return NULL;
+
+    b->ctx = (AUI_Context *)calloc(1, sizeof(AUI_Context));
+    if (!b->ctx) {
+        free(b);
+        return NULL;
+    }
+    b->ctx->width = 1920;
+    b->ctx->height = 1080;
+
+    agentite_random_seed(seed);
+
+    b->root = aui_node_create(b->ctx, AUI_NODE_CONTROL, "root");
+    aui_node_set_anchor_preset(b->root, AUI_ANCHOR_FULL_RECT);
+
+    AUI_Node *list = aui_vbox_create(b->ctx, "list");
+    aui_node_set_anchor_preset(list, AUI_ANCHOR_FULL_RECT);
+    aui_node_add_child(b->root, list);
+
+    for (int r = 0; r < UI_ROWS; r++) {
+        AUI_Node *row = aui_hbox_create(b->ctx, "row");
+        aui_node_set_h_size_flags(row, AUI_SIZE_FILL);
+        aui_node_add_child(list, row);
+
+        for (int c = 0; c < UI_CELLS_PER_ROW; c++) {
+            AUI_NodeType type = (c % 2 == 0) ? AUI_NODE_PANEL : AUI_NODE_PROGRESS_BAR;
+            AUI_Node *cell = aui_node_create(b->ctx, type, "cell");
+            aui_node_set_custom_min_size(cell, (float)agentite_rand_int(24, 96),
+                                         (float)agentite_rand_int(8, 20));
+            if (c == 1) {
+                aui_node_set_h_size_flags(cell, AUI_SIZE_FILL | AUI_SIZE_EXPAND);
+            }
+            aui_node_add_child(row, cell);
+            b->probe = cell;
+        }
+    }
+
+    return b;
+}
+
+/* Alternate between two window widths so every pass changes the result */
+static uint64_t ui_layout_run(void *state, uint64_t iteration) {
+    UiBench *b = (UiBench *)state;
+    b->ctx->width = (iteration & 1) ? 1600 : 1920;
+    aui_scene_layout(b->ctx, b->root);
+    return (uint64_t)b->probe->global_rect.x;
+}
+
+static void ui_layout_teardown(void *state) {
+    UiBench *b = (UiBench *)state;
+    if (!b) return;
+    aui_node_destroy(b->root);
+    free(b->ctx);
+    free(b);
+}
+
+/* ============================================================================
+ * Suite
+ * ============================================================================ */
+
+static const Bench_Case s_cases[] = {
+    { "ui/layout", ui_layout_setup, ui_layout_run, ui_layout_teardown },
+};
+
+BENCH_SUITE(bench_ui_suite, s_cases);
@@ -142,6 +142,12 @@ int main(int argc, char *argv[]) {
     /* Set decoration layer slightly transparent */
     agentite_tilemap_set_layer_opacity(tilemap, decor_layer, 0.9f);
 
+    /* Report compact tile storage against one tile ID per chunk slot */
+    Agentite_TilemapMemoryStats mem;
+    agentite_tilemap_get_memory_stats(tilemap, &mem);
+    SDL_Log("Tile storage: %zu bytes in %d chunks (%d uniform), %zu bytes uncompressed",
+            mem.tile_bytes, mem.chunk_count, mem.uniform_chunks, mem.uncompressed_bytes);
+
     /* Center camera on map */
     float world_width = map_width * tile_size;
     float world_height = map_height * tile_size;
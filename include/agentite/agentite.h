@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include "agentite/alloc.h"
 
 /*============================================================================
  * Safe Memory Allocation Macros
@@ -16,6 +17,10 @@
  *   AGENTITE_ALLOC_ARRAY(type, count) - Allocate array (overflow-safe, zero-init)
  *   AGENTITE_MALLOC_ARRAY(type, count) - Malloc array (overflow-safe)
  *   AGENTITE_REALLOC(ptr, type, count) - Realloc with overflow check
+ *   AGENTITE_FREE(ptr)                 - Free and count against the file's tag
+ *
+ * All of them go through the allocator in agentite/alloc.h and are counted
+ * against AGENTITE_ALLOC_TAG, which a file may define before its includes.
  *
  * Logging macros (log failures with file:line for debugging):
  *   AGENTITE_ALLOC_LOG(type)              - Allocate + log on failure
@@ -52,10 +57,10 @@ static inline void *agentite_safe_malloc(size_t count, size_t size)
  *============================================================================*/
 
 /* Logging calloc wrapper */
-static inline void *agentite_calloc_log(size_t count, size_t size,
+static inline void *agentite_calloc_log(size_t count, size_t size, Agentite_AllocTag tag,
                                         const char *file, int line)
 {
-    void *ptr = calloc(count, size);
+    void *ptr = agentite_mem_calloc(count, size, tag, file, line);
     if (!ptr && (count * size) > 0) {
         SDL_Log("ALLOC FAILED: calloc(%zu, %zu) = %zu bytes at %s:%d",
                 count, size, count * size, file, line);
@@ -64,7 +69,7 @@ static inline void *agentite_calloc_log(size_t count, size_t size,
 }
 
 /* Logging malloc wrapper with overflow check */
-static inline void *agentite_malloc_log(size_t count, size_t size,
+static inline void *agentite_malloc_log(size_t count, size_t size, Agentite_AllocTag tag,
                                         const char *file, int line)
 {
     if (size != 0 && count > SIZE_MAX / size) {
@@ -72,7 +77,7 @@ static inline void *agentite_malloc_log(size_t count, size_t size,
                 count, size, file, line);
         return NULL;
     }
-    void *ptr = malloc(count * size);
+    void *ptr = agentite_mem_malloc(count, size, tag, file, line);
     if (!ptr && (count * size) > 0) {
         SDL_Log("ALLOC FAILED: malloc(%zu) at %s:%d", count * size, file, line);
     }
@@ -81,51 +86,55 @@ static inline void *agentite_malloc_log(size_t count, size_t size,
 
 /* Logging realloc wrapper with overflow check */
 static inline void *agentite_realloc_log(void *old_ptr, size_t count, size_t size,
-                                         const char *file, int line)
+                                         Agentite_AllocTag tag, const char *file, int line)
 {
     if (size != 0 && count > SIZE_MAX / size) {
         SDL_Log("ALLOC FAILED: overflow in realloc(%zu * %zu) at %s:%d",
                 count, size, file, line);
         return NULL;
     }
-    void *ptr = realloc(old_ptr, count * size);
+    void *ptr = agentite_mem_realloc(old_ptr, count, size, tag, file, line);
     if (!ptr && (count * size) > 0) {
         SDL_Log("ALLOC FAILED: realloc(%zu) at %s:%d", count * size, file, line);
     }
     return ptr;
 }
 
+/* Subsystem charged for allocations in this file (see agentite/alloc.h) */
+#ifndef AGENTITE_ALLOC_TAG
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_GENERAL
+#endif
+
 /* Logging allocation macros - use these for automatic file/line info */
 #define AGENTITE_ALLOC_LOG(type) \
-    (type*)agentite_calloc_log(1, sizeof(type), __FILE__, __LINE__)
+    (type*)agentite_calloc_log(1, sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
 
 #define AGENTITE_ALLOC_ARRAY_LOG(type, count) \
-    (type*)agentite_calloc_log((count), sizeof(type), __FILE__, __LINE__)
+    (type*)agentite_calloc_log((count), sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
 
 #define AGENTITE_MALLOC_ARRAY_LOG(type, count) \
-    (type*)agentite_malloc_log((count), sizeof(type), __FILE__, __LINE__)
+    (type*)agentite_malloc_log((count), sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
 
 #define AGENTITE_REALLOC_LOG(ptr, type, count) \
-    (type*)agentite_realloc_log((ptr), (count), sizeof(type), __FILE__, __LINE__)
-
-// C++ compatibility for memory allocation
-#ifdef __cplusplus
-#define AGENTITE_ALLOC(type) (type*)calloc(1, sizeof(type))
-#define AGENTITE_ALLOC_ARRAY(type, count) (type*)calloc((count), sizeof(type))
-#define AGENTITE_REALLOC_SAFE(ptr, type, count) (type*)agentite_safe_realloc((ptr), (count), sizeof(type))
-#define AGENTITE_REALLOC(ptr, type, count) (type*)agentite_safe_realloc((ptr), (count), sizeof(type))
-#define AGENTITE_MALLOC(size) malloc(size)
-#define AGENTITE_MALLOC_ARRAY(type, count) (type*)agentite_safe_malloc((count), sizeof(type))
-#define AGENTITE_CALLOC(count, size) calloc((count), (size))
-#else
-#define AGENTITE_ALLOC(type) (type*)calloc(1, sizeof(type))
-#define AGENTITE_ALLOC_ARRAY(type, count) (type*)calloc((count), sizeof(type))
-#define AGENTITE_REALLOC_SAFE(ptr, type, count) (type*)agentite_safe_realloc((ptr), (count), sizeof(type))
-#define AGENTITE_REALLOC(ptr, type, count) (type*)agentite_safe_realloc((ptr), (count), sizeof(type))
-#define AGENTITE_MALLOC(size) malloc(size)
-#define AGENTITE_MALLOC_ARRAY(type, count) (type*)agentite_safe_malloc((count), sizeof(type))
-#define AGENTITE_CALLOC(count, size) calloc((count), (size))
-#endif
+    (type*)agentite_realloc_log((ptr), (count), sizeof(type), AGENTITE_ALLOC_TAG, \
+                                __FILE__, __LINE__)
+
+/* Tracked allocation macros - routed through the installed allocator */
+#define AGENTITE_ALLOC(type) \
+    (type*)agentite_mem_calloc(1, sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
+#define AGENTITE_ALLOC_ARRAY(type, count) \
+    (type*)agentite_mem_calloc((count), sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
+#define AGENTITE_REALLOC_SAFE(ptr, type, count) \
+    (type*)agentite_mem_realloc((ptr), (count), sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
+#define AGENTITE_REALLOC(ptr, type, count) \
+    (type*)agentite_mem_realloc((ptr), (count), sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
+#define AGENTITE_MALLOC(size) \
+    agentite_mem_malloc(1, (size), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
+#define AGENTITE_MALLOC_ARRAY(type, count) \
+    (type*)agentite_mem_malloc((count), sizeof(type), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
+#define AGENTITE_CALLOC(count, size) \
+    agentite_mem_calloc((count), (size), AGENTITE_ALLOC_TAG, __FILE__, __LINE__)
+#define AGENTITE_FREE(ptr) agentite_mem_free((ptr), AGENTITE_ALLOC_TAG)
 
 /*============================================================================
  * Thread Safety Assertions
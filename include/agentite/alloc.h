@@ -0,0 +1,240 @@
+/**
+ * @file alloc.h
+ * @brief Pluggable Allocator and Allocation Tracking
+ *
+ * Every AGENTITE_ALLOC / AGENTITE_REALLOC / AGENTITE_MALLOC style macro in
+ * agentite.h routes through this module. It forwards to a replaceable
+ * allocator (the C runtime by default) and counts allocations per subsystem
+ * tag, so the profiler can report "allocations during frame N by subsystem".
+ *
+ * Features:
+ * - Replaceable malloc/calloc/realloc/free functions
+ * - Per-tag allocation, free and byte counters (always on, lock-free)
+ * - Optional call-site histogram keyed by __FILE__/__LINE__
+ *
+ * Tagging:
+ *   A source file selects its subsystem by defining AGENTITE_ALLOC_TAG before
+ *   its first include. Files that do not are counted as GENERAL.
+ *
+ *   #define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_COMMAND
+ *   #include "agentite/agentite.h"
+ *
+ * Usage:
+ *   // Which call sites allocate the most?
+ *   agentite_alloc_set_callsite_tracking(true);
+ *   // ... run some frames ...
+ *   Agentite_AllocCallsite sites[16];
+ *   int n = agentite_alloc_get_callsites(sites, 16);
+ *   for (int i = 0; i < n; i++) {
+ *       printf("%s:%d %llu\n", sites[i].file, sites[i].line,
+ *              (unsigned long long)sites[i].allocations);
+ *   }
+ *
+ * Note: parts of the engine still release macro-allocated memory with plain
+ * free(), so a replacement allocator must hand out blocks that free() accepts
+ * (for example, a wrapper that does bookkeeping around malloc).
+ */
+
+#ifndef AGENTITE_ALLOC_H
+#define AGENTITE_ALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Types
+ * ============================================================================ */
+
+/** Subsystem an allocation is charged to */
+typedef enum Agentite_AllocTag {
+    AGENTITE_ALLOC_TAG_GENERAL = 0, /**< Untagged engine and game code */
+    AGENTITE_ALLOC_TAG_COMMAND,     /**< Command system */
+    AGENTITE_ALLOC_TAG_EVENT,       /**< Event dispatcher */
+    AGENTITE_ALLOC_TAG_UI,          /**< UI nodes, tweens, widget state */
+    AGENTITE_ALLOC_TAG_ECS,         /**< ECS wrapper */
+    AGENTITE_ALLOC_TAG_AI,          /**< AI, pathfinding, planners */
+    AGENTITE_ALLOC_TAG_GAME,        /**< Free for game code */
+    AGENTITE_ALLOC_TAG_COUNT
+} Agentite_AllocTag;
+
+/**
+ * Allocator functions. All four must be set. userdata is passed through.
+ */
+typedef struct Agentite_Allocator {
+    void *(*malloc_fn)(size_t size, void *userdata);
+    void *(*calloc_fn)(size_t count, size_t size, void *userdata);
+    void *(*realloc_fn)(void *ptr, size_t size, void *userdata);
+    void (*free_fn)(void *ptr, void *userdata);
+    void *userdata;
+} Agentite_Allocator;
+
+/** Counters for one tag */
+typedef struct Agentite_AllocTagStats {
+    uint64_t allocations;    /**< Successful malloc/calloc/realloc calls */
+    uint64_t frees;          /**< AGENTITE_FREE calls with a non-NULL pointer */
+    uint64_t bytes;          /**< Bytes requested by those allocations */
+} Agentite_AllocTagStats;
+
+/** Counters for every tag plus totals */
+typedef struct Agentite_AllocStats {
+    Agentite_AllocTagStats tags[AGENTITE_ALLOC_TAG_COUNT];
+    Agentite_AllocTagStats total;
+} Agentite_AllocStats;
+
+/** One call site in the histogram */
+typedef struct Agentite_AllocCallsite {
+    const char *file;        /**< __FILE__ of the call (static string) */
+    int line;                /**< __LINE__ of the call */
+    Agentite_AllocTag tag;   /**< Tag of the call */
+    uint64_t allocations;    /**< Allocations made here */
+    uint64_t bytes;          /**< Bytes requested here */
+} Agentite_AllocCallsite;
+
+/** Number of distinct call sites the histogram can hold */
+#define AGENTITE_ALLOC_MAX_CALLSITES 1024
+
+/* ============================================================================
+ * Allocator
+ * ============================================================================ */
+
+/**
+ * Replace the allocator behind the AGENTITE_* macros.
+ * Pass NULL to restore the C runtime allocator. Memory must be released
+ * with the allocator that provided it, so install before allocating.
+ *
+ * @param allocator Allocator functions (copied), or NULL
+ * @return false if a function pointer is missing
+ *
+ * Thread Safety: NOT thread-safe (call at startup)
+ */
+bool agentite_set_allocator(const Agentite_Allocator *allocator);
+
+/**
+ * Get the allocator currently in use.
+ *
+ * @param out Receives the allocator functions
+ *
+ * Thread Safety: Thread-safe
+ */
+void agentite_get_allocator(Agentite_Allocator *out);
+
+/* ============================================================================
+ * Tagged Allocation (used by the macros in agentite.h)
+ * ============================================================================ */
+
+/**
+ * Allocate count * size bytes. Returns NULL on overflow or failure.
+ *
+ * Thread Safety: Thread-safe
+ */
+void *agentite_mem_malloc(size_t count, size_t size, Agentite_AllocTag tag,
+                          const char *file, int line);
+
+/**
+ * Allocate count * size zeroed bytes. Returns NULL on overflow or failure.
+ *
+ * Thread Safety: Thread-safe
+ */
+void *agentite_mem_calloc(size_t count, size_t size, Agentite_AllocTag tag,
+                          const char *file, int line);
+
+/**
+ * Resize ptr to count * size bytes. Returns NULL on overflow or failure,
+ * leaving ptr untouched.
+ *
+ * Thread Safety: Thread-safe
+ */
+void *agentite_mem_realloc(void *ptr, size_t count, size_t size, Agentite_AllocTag tag,
+                           const char *file, int line);
+
+/**
+ * Release memory. NULL is ignored.
+ *
+ * Thread Safety: Thread-safe
+ */
+void agentite_mem_free(void *ptr, Agentite_AllocTag tag);
+
+/* ============================================================================
+ * Statistics
+ * ============================================================================ */
+
+/**
+ * Get cumulative counters since startup or the last reset.
+ * Subtract two snapshots to get the allocations between them.
+ *
+ * @param out Receives the counters
+ *
+ * Thread Safety: Thread-safe (counters of other threads may be mid-update)
+ */
+void agentite_alloc_get_stats(Agentite_AllocStats *out);
+
+/**
+ * Zero the cumulative counters.
+ *
+ * Thread Safety: Thread-safe
+ */
+void agentite_alloc_reset_stats(void);
+
+/**
+ * Compute end - begin for every counter.
+ *
+ * Thread Safety: Thread-safe
+ */
+void agentite_alloc_stats_delta(const Agentite_AllocStats *begin,
+                                const Agentite_AllocStats *end,
+                                Agentite_AllocStats *out);
+
+/**
+ * Get the lowercase name of a tag ("command", "ui", ...).
+ *
+ * Thread Safety: Thread-safe
+ */
+const char *agentite_alloc_tag_name(Agentite_AllocTag tag);
+
+/* ============================================================================
+ * Call-Site Histogram
+ * ============================================================================ */
+
+/**
+ * Enable or disable the call-site histogram. Off by default; while on,
+ * every allocation takes a lock. Counts are kept when it is disabled.
+ *
+ * Thread Safety: Thread-safe
+ */
+void agentite_alloc_set_callsite_tracking(bool enabled);
+
+/**
+ * Check if the call-site histogram is enabled.
+ *
+ * Thread Safety: Thread-safe
+ */
+bool agentite_alloc_is_tracking_callsites(void);
+
+/**
+ * Copy the busiest call sites, most allocations first.
+ *
+ * @param out Output array
+ * @param max Capacity of out
+ * @return Number of call sites written
+ *
+ * Thread Safety: Thread-safe
+ */
+int agentite_alloc_get_callsites(Agentite_AllocCallsite *out, int max);
+
+/**
+ * Forget all recorded call sites.
+ *
+ * Thread Safety: Thread-safe
+ */
+void agentite_alloc_reset_callsites(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGENTITE_ALLOC_H */
@@ -0,0 +1,153 @@
+/**
+ * @file arena.h
+ * @brief Linear Arena and Double-Buffered Frame Arena
+ *
+ * A linear (bump) allocator for transient data. Allocation is a pointer
+ * bump, individual frees do not exist, and reset() reclaims everything at
+ * once. When a cycle needs more than the capacity, the extra requests are
+ * served from overflow blocks, and the next reset() grows the arena so the
+ * following cycles fit without touching the heap again.
+ *
+ * The frame arena pairs two arenas. Data allocated during frame N stays
+ * valid through frame N + 1 and is reclaimed when that frame ends, so
+ * results computed in update can still be read by next frame's render.
+ * The game context owns one and swaps it in agentite_game_context_end_frame().
+ *
+ * Usage:
+ *   Agentite_Arena *frame = agentite_game_context_frame_arena(ctx);
+ *
+ *   Agentite_Path *path = agentite_pathfinder_find_frame(pf, 0, 0, 10, 10,
+ *                                                        NULL, frame);
+ *   Agentite_GraphData graph = agentite_history_get_graph_frame(history, 0, frame);
+ *   // No destroy/free calls: both are gone after the next frame ends
+ *
+ *   Scratch *tmp = AGENTITE_ARENA_ALLOC(frame, Scratch);
+ */
+
+#ifndef AGENTITE_ARENA_H
+#define AGENTITE_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Constants
+ * ============================================================================ */
+
+/** Default capacity of each frame arena half */
+#define AGENTITE_FRAME_ARENA_DEFAULT_SIZE (256 * 1024)
+
+/** Alignment used when none is given (suits any scalar type) */
+#define AGENTITE_ARENA_DEFAULT_ALIGN 16
+
+/* ============================================================================
+ * Types
+ * ============================================================================ */
+
+typedef struct Agentite_Arena Agentite_Arena;
+typedef struct Agentite_FrameArena Agentite_FrameArena;
+
+/** Arena usage statistics */
+typedef struct Agentite_ArenaStats {
+    size_t used;             /**< Bytes handed out since the last reset */
+    size_t capacity;         /**< Size of the main block */
+    size_t high_water;       /**< Most bytes used in any cycle */
+    uint32_t overflow_blocks;/**< Overflow blocks allocated since creation */
+    uint32_t grow_count;     /**< Times reset() enlarged the main block */
+} Agentite_ArenaStats;
+
+/* ============================================================================
+ * Arena
+ * ============================================================================ */
+
+/**
+ * Create an arena.
+ *
+ * @param capacity Main block size in bytes (0 = AGENTITE_FRAME_ARENA_DEFAULT_SIZE)
+ * @return New arena, or NULL on failure
+ */
+Agentite_Arena *agentite_arena_create(size_t capacity);
+
+/**
+ * Destroy an arena and everything allocated from it. Safe with NULL.
+ */
+void agentite_arena_destroy(Agentite_Arena *arena);
+
+/**
+ * Allocate uninitialized memory.
+ *
+ * @param arena Arena
+ * @param size  Bytes to allocate
+ * @param align Power-of-two alignment (0 = AGENTITE_ARENA_DEFAULT_ALIGN)
+ * @return Pointer valid until the next reset, or NULL on failure
+ */
+void *agentite_arena_alloc(Agentite_Arena *arena, size_t size, size_t align);
+
+/**
+ * Allocate count * size zeroed bytes with default alignment.
+ *
+ * @return Pointer valid until the next reset, or NULL on overflow or failure
+ */
+void *agentite_arena_calloc(Agentite_Arena *arena, size_t count, size_t size);
+
+/**
+ * Reclaim every allocation. Grows the main block if the cycle overflowed.
+ */
+void agentite_arena_reset(Agentite_Arena *arena);
+
+/**
+ * Get usage statistics.
+ */
+void agentite_arena_get_stats(const Agentite_Arena *arena, Agentite_ArenaStats *out);
+
+/** Allocate one zeroed instance of type */
+#define AGENTITE_ARENA_ALLOC(arena, type) \
+    ((type *)agentite_arena_calloc((arena), 1, sizeof(type)))
+
+/** Allocate a zeroed array of type */
+#define AGENTITE_ARENA_ARRAY(arena, type, count) \
+    ((type *)agentite_arena_calloc((arena), (count), sizeof(type)))
+
+/* ============================================================================
+ * Frame Arena
+ * ============================================================================ */
+
+/**
+ * Create a double-buffered frame arena.
+ *
+ * @param capacity Capacity of each half (0 = AGENTITE_FRAME_ARENA_DEFAULT_SIZE)
+ * @return New frame arena, or NULL on failure
+ */
+Agentite_FrameArena *agentite_frame_arena_create(size_t capacity);
+
+/**
+ * Destroy a frame arena. Safe with NULL.
+ */
+void agentite_frame_arena_destroy(Agentite_FrameArena *fa);
+
+/**
+ * Get the arena for allocations made this frame.
+ */
+Agentite_Arena *agentite_frame_arena_current(const Agentite_FrameArena *fa);
+
+/**
+ * Get the arena that holds last frame's allocations (read-only use).
+ */
+Agentite_Arena *agentite_frame_arena_previous(const Agentite_FrameArena *fa);
+
+/**
+ * End the frame: the current arena becomes the previous one, and the old
+ * previous arena is reset and becomes current.
+ */
+void agentite_frame_arena_swap(Agentite_FrameArena *fa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGENTITE_ARENA_H */
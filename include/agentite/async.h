@@ -84,6 +84,7 @@ typedef struct Agentite_AssetRegistry Agentite_AssetRegistry;
 typedef struct Agentite_AssetHandle Agentite_AssetHandle;
 typedef struct Agentite_SpriteRenderer Agentite_SpriteRenderer;
 typedef struct Agentite_Audio Agentite_Audio;
+typedef struct Agentite_Profiler Agentite_Profiler;
 
 /**
  * Async load completion callback.
@@ -152,6 +153,19 @@ void agentite_async_loader_destroy(Agentite_AsyncLoader *loader);
  */
 void agentite_async_loader_update(Agentite_AsyncLoader *loader);
 
+/**
+ * Set profiler for tracing worker threads.
+ *
+ * During a profiler trace capture, each worker thread appears as its own
+ * track ("async_worker") with one scope per load:
+ * - "async_load_texture", "async_load_sound", "async_load_music"
+ *
+ * @param loader   Async loader
+ * @param profiler Profiler instance, or NULL to disable tracing
+ */
+void agentite_async_loader_set_profiler(Agentite_AsyncLoader *loader,
+                                        Agentite_Profiler *profiler);
+
 /* ============================================================================
  * Texture Async Loading
  * ============================================================================ */
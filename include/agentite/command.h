@@ -30,6 +30,32 @@
  *
  *   // Cleanup
  *   agentite_command_destroy(sys);
+ *
+ * Hot paths (AI issuing thousands of commands per turn) can avoid the heap
+ * and string compares entirely:
+ *   static Agentite_CommandKey KEY_X, KEY_Y;   // agentite_command_key("x") once
+ *
+ *   Agentite_Command cmd;                      // Stack, pool or frame arena
+ *   agentite_command_init(&cmd, CMD_MOVE_UNIT, faction);
+ *   agentite_command_set_int_id(&cmd, KEY_X, 10);
+ *   agentite_command_set_int_id(&cmd, KEY_Y, 20);
+ *   agentite_command_submit_inline(sys, &cmd, game_state);   // No clone/free
+ *
+ * Large queues can validate on a job pool. Each type declares the
+ * resources its commands read and write; commands that do not depend on
+ * an earlier command's writes are validated together, and execution still
+ * runs one at a time in sequence order, so results match execute_all():
+ *   static bool move_access(const Agentite_Command *cmd, const void *game_state,
+ *                           Agentite_CommandAccess *access) {
+ *       agentite_command_access_write(access, AGENTITE_CMD_RESOURCE_ENTITY(
+ *           agentite_command_get_entity(cmd, "unit")));
+ *       agentite_command_access_write(access, AGENTITE_CMD_RESOURCE_TILE(
+ *           agentite_command_get_int(cmd, "dest_x"),
+ *           agentite_command_get_int(cmd, "dest_y")));
+ *       return true;
+ *   }
+ *   agentite_command_set_access(sys, CMD_MOVE_UNIT, move_access);
+ *   agentite_command_execute_batched(sys, game_state, jobs, results, 32);
  */
 
 #ifndef AGENTITE_COMMAND_H
@@ -38,6 +64,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include "agentite/arena.h"
+#include "agentite/job.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +81,9 @@ extern "C" {
 #define AGENTITE_COMMAND_MAX_QUEUE       64    /* Maximum queued commands */
 #define AGENTITE_COMMAND_MAX_TYPES       64    /* Maximum registered command types */
 #define AGENTITE_COMMAND_MAX_HISTORY     256   /* Maximum history entries */
+#define AGENTITE_COMMAND_MAX_KEYS        1024  /* Maximum distinct interned param keys */
+#define AGENTITE_COMMAND_POOL_CHUNK      64    /* Commands per pool allocation */
+#define AGENTITE_COMMAND_MAX_ACCESS      8     /* Maximum reads/writes declared per command */
 
 /*============================================================================
  * Parameter Types
@@ -73,11 +104,18 @@ typedef enum Agentite_CommandParamType {
     AGENTITE_CMD_PARAM_PTR,
 } Agentite_CommandParamType;
 
+/**
+ * Interned parameter key. Equal names always map to the same key, so
+ * parameters are matched with an integer compare. 0 is never a valid key.
+ */
+typedef uint32_t Agentite_CommandKey;
+
 /**
  * Command parameter value.
  */
 typedef struct Agentite_CommandParam {
     char key[AGENTITE_COMMAND_MAX_PARAM_KEY];
+    Agentite_CommandKey key_id;                     /* Interned key (0 = match by key string) */
     Agentite_CommandParamType type;
     union {
         int32_t i32;
@@ -122,6 +160,7 @@ typedef struct Agentite_CommandResult {
  *============================================================================*/
 
 typedef struct Agentite_CommandSystem Agentite_CommandSystem;
+typedef struct Agentite_CommandPool Agentite_CommandPool;
 
 /*============================================================================
  * Callback Types
@@ -167,6 +206,79 @@ typedef void (*Agentite_CommandCallback)(Agentite_CommandSystem *sys,
                                          const Agentite_CommandResult *result,
                                          void *userdata);
 
+/*============================================================================
+ * Resource Access
+ *============================================================================*/
+
+/**
+ * A piece of game state a command reads or writes, tagged with its kind.
+ * Distinct resources may share a key (e.g. far-apart tiles); that only
+ * costs parallelism, never correctness.
+ */
+typedef uint64_t Agentite_CommandResource;
+
+#define AGENTITE_CMD_RESOURCE_KIND_FACTION 1
+#define AGENTITE_CMD_RESOURCE_KIND_ENTITY  2
+#define AGENTITE_CMD_RESOURCE_KIND_TILE    3
+#define AGENTITE_CMD_RESOURCE_KIND_USER    16  /* First kind free for game use */
+
+/** Resource key from a kind (1-255) and a 56-bit id */
+#define AGENTITE_CMD_RESOURCE(kind, id) \
+    (((uint64_t)(uint8_t)(kind) << 56) | ((uint64_t)(id) & 0x00FFFFFFFFFFFFFFull))
+#define AGENTITE_CMD_RESOURCE_FACTION(faction) \
+    AGENTITE_CMD_RESOURCE(AGENTITE_CMD_RESOURCE_KIND_FACTION, (uint32_t)(faction))
+#define AGENTITE_CMD_RESOURCE_ENTITY(entity) \
+    AGENTITE_CMD_RESOURCE(AGENTITE_CMD_RESOURCE_KIND_ENTITY, (uint32_t)(entity))
+#define AGENTITE_CMD_RESOURCE_TILE(x, y) \
+    AGENTITE_CMD_RESOURCE(AGENTITE_CMD_RESOURCE_KIND_TILE, \
+        ((uint64_t)((uint32_t)(x) & 0xFFFFFFu) << 24) | ((uint32_t)(y) & 0xFFFFFFu))
+
+/**
+ * Resources touched by one command. Reads cover everything the validator
+ * looks at; writes cover everything the executor changes (a write implies
+ * a read). Filled with agentite_command_access_read/write().
+ */
+typedef struct Agentite_CommandAccess {
+    Agentite_CommandResource reads[AGENTITE_COMMAND_MAX_ACCESS];
+    Agentite_CommandResource writes[AGENTITE_COMMAND_MAX_ACCESS];
+    int read_count;
+    int write_count;
+    bool overflow;                                  /* Too many entries; runs serialized */
+} Agentite_CommandAccess;
+
+/**
+ * Access declaration callback.
+ * Should depend only on the command (and on state no command changes).
+ *
+ * @param cmd        Command to describe
+ * @param game_state Game state pointer
+ * @param access     Cleared access set to fill
+ * @return false if the access cannot be described (command runs serialized)
+ */
+typedef bool (*Agentite_CommandAccessFn)(const Agentite_Command *cmd,
+                                         const void *game_state,
+                                         Agentite_CommandAccess *access);
+
+/** Declare a read. Sets overflow when the set is full. */
+static inline void agentite_command_access_read(Agentite_CommandAccess *access,
+                                                Agentite_CommandResource resource) {
+    if (access->read_count < AGENTITE_COMMAND_MAX_ACCESS) {
+        access->reads[access->read_count++] = resource;
+    } else {
+        access->overflow = true;
+    }
+}
+
+/** Declare a write. Sets overflow when the set is full. */
+static inline void agentite_command_access_write(Agentite_CommandAccess *access,
+                                                 Agentite_CommandResource resource) {
+    if (access->write_count < AGENTITE_COMMAND_MAX_ACCESS) {
+        access->writes[access->write_count++] = resource;
+    } else {
+        access->overflow = true;
+    }
+}
+
 /*============================================================================
  * Lifecycle
  *============================================================================*/
@@ -237,6 +349,21 @@ bool agentite_command_is_registered(const Agentite_CommandSystem *sys, int type)
  */
 const char *agentite_command_get_type_name(const Agentite_CommandSystem *sys, int type);
 
+/**
+ * Declare how commands of a type access game state, which lets
+ * agentite_command_execute_batched() validate them in parallel. The type's
+ * validator must then be safe to call concurrently with other validators.
+ * Types without an access callback are always validated on their own.
+ *
+ * @param sys    Command system
+ * @param type   Registered command type ID
+ * @param access Access callback (NULL to clear)
+ * @return true if the type is registered
+ */
+bool agentite_command_set_access(Agentite_CommandSystem *sys,
+                                 int type,
+                                 Agentite_CommandAccessFn access);
+
 /*============================================================================
  * Command Creation
  *============================================================================*/
@@ -258,6 +385,37 @@ Agentite_Command *agentite_command_new(int type);
  */
 Agentite_Command *agentite_command_new_ex(int type, int32_t faction);
 
+/**
+ * Create a command in an arena (e.g. the frame arena).
+ * The command lives until the arena is reset; do NOT call agentite_command_free().
+ * Queueing it is fine, since the queue stores its own copy.
+ *
+ * @param type  Command type ID
+ * @param arena Arena to allocate from
+ * @return New command or NULL on failure
+ */
+Agentite_Command *agentite_command_new_frame(int type, Agentite_Arena *arena);
+
+/**
+ * Create an arena command with source faction.
+ *
+ * @param type    Command type ID
+ * @param faction Source faction ID
+ * @param arena   Arena to allocate from
+ * @return New command or NULL on failure
+ */
+Agentite_Command *agentite_command_new_frame_ex(int type, int32_t faction, Agentite_Arena *arena);
+
+/**
+ * Initialize a caller-owned command (stack, arena or embedded in a struct).
+ * Clears the parameters without touching the rest of the parameter storage.
+ *
+ * @param cmd     Command to initialize
+ * @param type    Command type ID
+ * @param faction Source faction ID (-1 = any)
+ */
+void agentite_command_init(Agentite_Command *cmd, int type, int32_t faction);
+
 /**
  * Clone a command.
  *
@@ -273,8 +431,81 @@ Agentite_Command *agentite_command_clone(const Agentite_Command *cmd);
  */
 void agentite_command_free(Agentite_Command *cmd);
 
+/*============================================================================
+ * Command Pool
+ *============================================================================*/
+
+/**
+ * Pool statistics.
+ */
+typedef struct Agentite_CommandPoolStats {
+    int live;                                       /* Commands currently acquired */
+    int capacity;                                   /* Commands allocated in total */
+    int chunk_count;                                /* Allocations made for them */
+} Agentite_CommandPoolStats;
+
+/**
+ * Create a command pool. Commands are allocated in chunks of
+ * AGENTITE_COMMAND_POOL_CHUNK and recycled, so a warmed-up pool does not
+ * touch the heap. Not thread-safe.
+ *
+ * @param initial_capacity Commands to preallocate (0 = none)
+ * @return New pool or NULL on failure
+ */
+Agentite_CommandPool *agentite_command_pool_create(int initial_capacity);
+
+/**
+ * Destroy a pool and every command acquired from it.
+ */
+void agentite_command_pool_destroy(Agentite_CommandPool *pool);
+
+/**
+ * Take an initialized command from the pool.
+ *
+ * @param pool    Command pool
+ * @param type    Command type ID
+ * @param faction Source faction ID (-1 = any)
+ * @return Command (release with agentite_command_pool_release) or NULL
+ */
+Agentite_Command *agentite_command_pool_acquire(Agentite_CommandPool *pool, int type,
+                                                int32_t faction);
+
+/**
+ * Return a command to the pool it came from. Safe with NULL cmd.
+ */
+void agentite_command_pool_release(Agentite_CommandPool *pool, Agentite_Command *cmd);
+
+/**
+ * Get pool statistics.
+ */
+void agentite_command_pool_get_stats(const Agentite_CommandPool *pool,
+                                     Agentite_CommandPoolStats *out);
+
+/*============================================================================
+ * Parameter Keys
+ *============================================================================*/
+
+/**
+ * Intern a parameter key name. Names longer than
+ * AGENTITE_COMMAND_MAX_PARAM_KEY - 1 are truncated. Thread-safe; lookups of
+ * existing keys do not lock. Intern hot keys once and use the _id functions.
+ *
+ * @param name Key name
+ * @return Key, or 0 if name is NULL/empty or AGENTITE_COMMAND_MAX_KEYS is reached
+ */
+Agentite_CommandKey agentite_command_key(const char *name);
+
+/**
+ * Get the name of an interned key.
+ *
+ * @return Name, or NULL for an unknown key
+ */
+const char *agentite_command_key_name(Agentite_CommandKey key);
+
 /*============================================================================
  * Command Parameters
+ *
+ * The string-keyed functions intern the key and forward to the _id ones.
  *============================================================================*/
 
 /**
@@ -317,6 +548,16 @@ void agentite_command_set_string(Agentite_Command *cmd, const char *key, const c
  */
 void agentite_command_set_ptr(Agentite_Command *cmd, const char *key, void *ptr);
 
+/* Setters by interned key */
+void agentite_command_set_int_id(Agentite_Command *cmd, Agentite_CommandKey key, int32_t value);
+void agentite_command_set_int64_id(Agentite_Command *cmd, Agentite_CommandKey key, int64_t value);
+void agentite_command_set_float_id(Agentite_Command *cmd, Agentite_CommandKey key, float value);
+void agentite_command_set_double_id(Agentite_Command *cmd, Agentite_CommandKey key, double value);
+void agentite_command_set_bool_id(Agentite_Command *cmd, Agentite_CommandKey key, bool value);
+void agentite_command_set_entity_id(Agentite_Command *cmd, Agentite_CommandKey key, uint32_t entity);
+void agentite_command_set_string_id(Agentite_Command *cmd, Agentite_CommandKey key, const char *value);
+void agentite_command_set_ptr_id(Agentite_Command *cmd, Agentite_CommandKey key, void *ptr);
+
 /*============================================================================
  * Parameter Retrieval
  *============================================================================*/
@@ -381,6 +622,17 @@ const char *agentite_command_get_string(const Agentite_Command *cmd, const char
  */
 void *agentite_command_get_ptr(const Agentite_Command *cmd, const char *key);
 
+/* Getters by interned key (same defaults as the string versions) */
+bool agentite_command_has_param_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+int32_t agentite_command_get_int_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+int64_t agentite_command_get_int64_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+float agentite_command_get_float_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+double agentite_command_get_double_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+bool agentite_command_get_bool_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+uint32_t agentite_command_get_entity_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+const char *agentite_command_get_string_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+void *agentite_command_get_ptr_id(const Agentite_Command *cmd, Agentite_CommandKey key);
+
 /*============================================================================
  * Validation
  *============================================================================*/
@@ -403,7 +655,7 @@ Agentite_CommandResult agentite_command_validate(Agentite_CommandSystem *sys,
 
 /**
  * Add a command to the queue.
- * Command is cloned; original can be freed.
+ * Command is copied into the system's pool; original can be freed.
  *
  * @param sys Command system
  * @param cmd Command to queue
@@ -463,6 +715,31 @@ int agentite_command_execute_all(Agentite_CommandSystem *sys,
                                 Agentite_CommandResult *results,
                                 int max);
 
+/**
+ * Execute queued commands, validating independent ones in parallel.
+ *
+ * The queue is cut into runs of commands where none reads or writes a
+ * resource written by an earlier command of the same run. Each run is
+ * validated on the job pool against the state left by the previous run,
+ * then the valid commands execute on this thread in sequence order.
+ * Results, history, statistics and callbacks therefore match
+ * agentite_command_execute_all() as long as the access declarations are
+ * complete, so recorded replays are identical. Commands of a run leave
+ * the queue together, before the first of them executes.
+ *
+ * @param sys        Command system
+ * @param game_state Game state pointer
+ * @param jobs       Job pool for validation (NULL = validate on this thread)
+ * @param results    Output array for results (NULL to skip)
+ * @param max        Maximum commands to execute (0 = all)
+ * @return Number of commands executed
+ */
+int agentite_command_execute_batched(Agentite_CommandSystem *sys,
+                                     void *game_state,
+                                     Agentite_JobPool *jobs,
+                                     Agentite_CommandResult *results,
+                                     int max);
+
 /**
  * Execute a single command immediately (not from queue).
  *
@@ -475,6 +752,22 @@ Agentite_CommandResult agentite_command_execute(Agentite_CommandSystem *sys,
                                               const Agentite_Command *cmd,
                                               void *game_state);
 
+/**
+ * Validate and execute a command in place, without queueing.
+ * Assigns the next sequence number to cmd, then behaves like
+ * agentite_command_execute(). No copy is made except the history entry,
+ * which reuses pooled storage, so a command built on the stack or in an
+ * arena runs without any heap allocation.
+ *
+ * @param sys        Command system
+ * @param cmd        Command to run (sequence is written)
+ * @param game_state Game state pointer
+ * @return Execution result
+ */
+Agentite_CommandResult agentite_command_submit_inline(Agentite_CommandSystem *sys,
+                                                    Agentite_Command *cmd,
+                                                    void *game_state);
+
 /**
  * Execute next queued command.
  *
@@ -0,0 +1,72 @@
+#ifndef AGENTITE_COMPRESS_H
+#define AGENTITE_COMPRESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Agentite Fast Block Compression
+ *
+ * Small LZ77 block codec using the LZ4 block format (byte-aligned tokens,
+ * 64 KB window, no entropy stage). Trades ratio for speed: compression and
+ * decompression run at memory-bandwidth-like rates, which makes it suitable
+ * for save games, replays and other data written on the frame path.
+ *
+ * Blocks carry no header: callers store the uncompressed size themselves
+ * and pass it back to agentite_lz_decompress().
+ *
+ * Usage:
+ *   size_t bound = agentite_lz_compress_bound(raw_size);
+ *   void *packed = malloc(bound);
+ *   size_t packed_size = agentite_lz_compress(raw, raw_size, packed, bound);
+ *
+ *   // Later...
+ *   if (!agentite_lz_decompress(packed, packed_size, out, raw_size)) {
+ *       // Corrupt or truncated block
+ *   }
+ *
+ * Thread Safety: All functions are reentrant.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Worst-case compressed size for an input of src_size bytes.
+ *
+ * @param src_size Uncompressed size in bytes
+ * @return Minimum destination capacity that is guaranteed to succeed
+ */
+size_t agentite_lz_compress_bound(size_t src_size);
+
+/**
+ * Compress a block.
+ *
+ * @param src          Input bytes
+ * @param src_size     Input size in bytes
+ * @param dst          Output buffer
+ * @param dst_capacity Output capacity (must be >= agentite_lz_compress_bound(src_size))
+ * @return Compressed size in bytes, or 0 if dst_capacity is too small
+ */
+size_t agentite_lz_compress(const void *src, size_t src_size,
+                            void *dst, size_t dst_capacity);
+
+/**
+ * Decompress a block produced by agentite_lz_compress().
+ * Input is fully bounds-checked; corrupt data fails instead of overrunning.
+ *
+ * @param src      Compressed bytes
+ * @param src_size Compressed size in bytes
+ * @param dst      Output buffer
+ * @param dst_size Exact uncompressed size
+ * @return true if the block decoded to exactly dst_size bytes
+ */
+bool agentite_lz_decompress(const void *src, size_t src_size,
+                            void *dst, size_t dst_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGENTITE_COMPRESS_H */
@@ -28,7 +28,11 @@
  *
  * @section ecs_thread_safety Thread Safety
  * - World creation/destruction: NOT thread-safe (main thread only)
- * - System execution: Managed by Flecs (see Flecs docs for multi-threading)
+ * - System execution: single-threaded by default. agentite_ecs_set_threads()
+ *   starts Flecs worker threads; only systems created with
+ *   `.multi_threaded = true` are split across them, the rest still run on
+ *   the main thread. Flecs places sync points from the systems' [in]/[out]
+ *   annotations.
  * - Entity creation during iteration: Deferred automatically
  * - Component pointers may invalidate after world modifications
  *
@@ -170,6 +174,24 @@ extern ECS_COMPONENT_DECLARE(C_RenderLayer);
 
 /** @} */ /* end of ecs_components */
 
+/** @brief Maximum threads (stages) for agentite_ecs_set_threads() */
+#define AGENTITE_ECS_MAX_THREADS 32
+
+/**
+ * @brief Time spent in one system during the last agentite_ecs_progress().
+ *
+ * For a multi-threaded system, time_ms is the slowest thread's share, which
+ * is the system's contribution to frame time. cpu_time_ms adds up all
+ * threads. Comparing the two shows how well the system parallelizes.
+ */
+typedef struct Agentite_EcsSystemTiming {
+    ecs_entity_t system;    /**< System entity */
+    const char *name;       /**< System name (owned by the world) */
+    double time_ms;         /**< Slowest thread's time in the system */
+    double cpu_time_ms;     /**< Time summed over all threads */
+    bool multi_threaded;    /**< System was created with multi_threaded */
+} Agentite_EcsSystemTiming;
+
 /** @defgroup ecs_lifecycle Lifecycle Functions
  *  @{ */
 
@@ -252,13 +274,74 @@ struct Agentite_Profiler;
  *
  * When a profiler is set, the ECS world will report:
  * - "ecs_progress" scope: Time spent in system iteration
- * - Entity count per frame
+ * - One scope per system, nested in "ecs_progress" and named after the
+ *   system (see Agentite_EcsSystemTiming for what is measured)
+ *
+ * Systems are timed by wrapping their run callback the first time
+ * agentite_ecs_progress() sees them with a profiler set. Systems that
+ * were created with a run_ctx are not wrapped and only count toward
+ * "ecs_progress".
  *
  * @param world    ECS world (must not be NULL)
  * @param profiler Profiler instance, or NULL to disable profiling
  */
 void agentite_ecs_set_profiler(Agentite_World *world, struct Agentite_Profiler *profiler);
 
+/**
+ * @brief Get per-system times from the last agentite_ecs_progress().
+ *
+ * Only available while a profiler is set. Systems that did not run are
+ * left out.
+ *
+ * @param world       ECS world
+ * @param out_timings Output array
+ * @param max_timings Capacity of out_timings
+ *
+ * @return Number of timings written
+ */
+int agentite_ecs_get_system_timings(const Agentite_World *world,
+                                    Agentite_EcsSystemTiming *out_timings, int max_timings);
+
+/**
+ * @brief Set the number of threads systems run on.
+ *
+ * Starts Flecs worker threads. Multi-threaded systems split their matched
+ * entities across all threads (the main thread included). Other systems
+ * keep running on the main thread. Only mark a system multi_threaded when
+ * each entity's update touches just that entity's own components. The
+ * system's terms must say which components it reads ([in]) and writes
+ * ([out]/[inout]).
+ *
+ * @param world   ECS world (must not be NULL)
+ * @param threads Total threads including the main thread (1 = single-threaded,
+ *                0 = one per logical core, capped at AGENTITE_ECS_MAX_THREADS)
+ *
+ * @return true on success, false while the world is progressing
+ *
+ * @note NOT thread-safe. Call between frames from the main thread.
+ *
+ * @code
+ * agentite_ecs_set_threads(world, 0);
+ *
+ * AGENTITE_ECS_SYSTEM(world, MovementSystem, EcsOnUpdate,
+ *     .query.terms = {
+ *         { .id = ecs_id(C_Position), .inout = EcsInOut },
+ *         { .id = ecs_id(C_Velocity), .inout = EcsIn }
+ *     },
+ *     .multi_threaded = true);
+ * @endcode
+ */
+bool agentite_ecs_set_threads(Agentite_World *world, int threads);
+
+/**
+ * @brief Get the number of threads systems run on (1 = single-threaded).
+ *
+ * @param world ECS world
+ *
+ * @return Thread count, or 0 for a NULL world
+ */
+int agentite_ecs_get_threads(const Agentite_World *world);
+
 /** @} */ /* end of ecs_lifecycle */
 
 /** @defgroup ecs_entity Entity Functions
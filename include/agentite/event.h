@@ -31,6 +31,25 @@
  *   // Cleanup
  *   agentite_event_unsubscribe(events, id);
  *   agentite_event_dispatcher_destroy(events);
+ *
+ * Threading:
+ *   The dispatcher belongs to the thread that created it (the "owner",
+ *   normally the main thread). Only the owner may subscribe, emit
+ *   immediately, flush or destroy. Any thread may call
+ *   agentite_event_emit_deferred(): other threads stage events in a
+ *   lock-free per-thread queue that the owner drains in
+ *   agentite_event_flush_deferred().
+ *
+ *   Ordering guarantees for deferred events:
+ *   - Events from one thread are delivered in the order that thread
+ *     deferred them.
+ *   - Within one flush, the owner's events come first, then worker
+ *     events thread by thread. There is no ordering between threads.
+ *   - A worker event is delivered by the first flush that starts after
+ *     its emit_deferred call returns; one deferred while a flush is
+ *     running may wait for the next flush.
+ *   - The grouped flush regroups all of the above by type, keeping the
+ *     relative order of events of the same type.
  */
 
 /* Forward declarations for ECS integration */
@@ -55,6 +74,8 @@ typedef enum Agentite_EventType {
     AGENTITE_EVENT_GAME_RESUMED,
     AGENTITE_EVENT_GAME_ENDED,
     AGENTITE_EVENT_STATE_CHANGED,
+    AGENTITE_EVENT_GAME_SAVED,
+    AGENTITE_EVENT_GAME_SAVE_FAILED,
 
     /* Turn-based events (200-299) */
     AGENTITE_EVENT_TURN_STARTED = 200,
@@ -196,6 +217,15 @@ typedef struct Agentite_Event {
             bool success;           /* True if reload succeeded */
         } reload;
 
+        /* Save events (valid only during the callback) */
+        struct {
+            const char *save_name;  /* Save name without extension */
+            const char *filepath;   /* Final save file path */
+            const char *error;      /* Error message, NULL on success */
+            bool success;
+            uint32_t duration_ms;   /* Worker time spent writing */
+        } save;
+
         /* Mod events */
         struct {
             const char *mod_id;     /* Mod identifier */
@@ -279,16 +309,34 @@ void agentite_event_unsubscribe(Agentite_EventDispatcher *d, Agentite_ListenerID
 
 /**
  * Emit an event immediately to all listeners.
+ * Only the listeners of event->type and the subscribe_all listeners are
+ * visited, in subscription order. Listeners subscribed from a callback
+ * receive the next event, not the one being emitted.
  *
  * @param d     Dispatcher
  * @param event Event to emit
  */
 void agentite_event_emit(Agentite_EventDispatcher *d, const Agentite_Event *event);
 
+/**
+ * Emit several events immediately, in array order.
+ * Equivalent to calling agentite_event_emit() for each event, but
+ * consecutive events of the same type share one listener lookup and
+ * unsubscribed listeners are compacted once at the end.
+ *
+ * @param d      Dispatcher
+ * @param events Events to emit
+ * @param count  Number of events
+ */
+void agentite_event_emit_many(Agentite_EventDispatcher *d, const Agentite_Event *events,
+                              size_t count);
+
 /**
  * Queue an event for deferred emission.
  * Use this when emitting events from within callbacks to avoid
  * modifying the listener list during iteration.
+ * Safe to call from any thread; see "Threading" above for ordering.
+ * The event is timestamped with the frame current at the time of the call.
  *
  * @param d     Dispatcher
  * @param event Event to queue
@@ -298,11 +346,23 @@ void agentite_event_emit_deferred(Agentite_EventDispatcher *d, const Agentite_Ev
 /**
  * Flush all deferred events.
  * Call this at a safe point (e.g., end of frame) to emit queued events.
+ * Also delivers events staged by worker threads. Owner thread only.
  *
  * @param d Dispatcher
  */
 void agentite_event_flush_deferred(Agentite_EventDispatcher *d);
 
+/**
+ * Flush all deferred events, grouped by event type.
+ * All queued events of one type are dispatched together (in queue order
+ * within the type), which keeps each type's listeners hot in cache. Use it
+ * when listeners do not depend on the relative order of different types;
+ * agentite_event_flush_deferred() keeps strict queue order.
+ *
+ * @param d Dispatcher
+ */
+void agentite_event_flush_deferred_grouped(Agentite_EventDispatcher *d);
+
 /**
  * Set the current frame number for event timestamps.
  *
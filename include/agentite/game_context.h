@@ -16,6 +16,7 @@
 #include "agentite/hotreload.h"
 #include "agentite/mod.h"
 #include "agentite/profiler.h"
+#include "agentite/arena.h"
 
 /**
  * Carbon Game Context
@@ -71,6 +72,10 @@ struct Agentite_GameContextConfig {
 
     /* Feature flags */
     bool enable_ecs;                /* Initialize ECS world */
+    int ecs_worker_threads;         /* ECS workers beyond the main thread (0 = single-threaded,
+                                       -1 = one thread per core). Counts extra threads so a
+                                       zeroed config stays single-threaded; see
+                                       agentite_game_context_apply_ecs_threads() */
     bool enable_audio;              /* Initialize audio system */
     bool enable_ui;                 /* Initialize UI system */
 
@@ -88,6 +93,9 @@ struct Agentite_GameContextConfig {
     /* Profiling settings */
     bool enable_profiler;           /* Initialize profiler (default: true in debug) */
     bool profiler_track_memory;     /* Track memory allocations */
+
+    /* Transient allocations */
+    size_t frame_arena_size;        /* Bytes per frame arena half (0 = 256 KB) */
 };
 
 /**
@@ -113,6 +121,7 @@ struct Agentite_GameContextConfig {
     .sdf_font_atlas = NULL, \
     .sdf_font_json = NULL, \
     .enable_ecs = true, \
+    .ecs_worker_threads = 0, \
     .enable_audio = true, \
     .enable_ui = true, \
     .enable_hot_reload = false, \
@@ -123,7 +132,8 @@ struct Agentite_GameContextConfig {
     .mod_path_count = 0, \
     .allow_mod_overrides = true, \
     .enable_profiler = AGENTITE_PROFILER_DEFAULT_ENABLED, \
-    .profiler_track_memory = false \
+    .profiler_track_memory = false, \
+    .frame_arena_size = 0 \
 }
 
 /**
@@ -162,6 +172,9 @@ struct Agentite_GameContext {
     /* Profiler (may be NULL if disabled) */
     Agentite_Profiler *profiler;      /* Performance profiler */
 
+    /* Transient per-frame memory (always valid) */
+    Agentite_FrameArena *frame_arena; /* Swapped in end_frame */
+
     /* Frame timing */
     float delta_time;               /* Time since last frame in seconds */
     uint64_t frame_count;           /* Total frames rendered */
@@ -203,6 +216,20 @@ Agentite_GameContext *agentite_game_context_create(const Agentite_GameContextCon
  */
 void agentite_game_context_destroy(Agentite_GameContext *ctx);
 
+/**
+ * Apply config->ecs_worker_threads to an ECS world.
+ *
+ * Called by agentite_game_context_create(). Converts the worker count to
+ * the total thread count agentite_ecs_set_threads() takes: 0 workers keeps
+ * one thread, -1 requests one per core, N requests N + 1.
+ *
+ * @param world  ECS world
+ * @param config Context configuration (NULL for defaults)
+ * @return Result of agentite_ecs_set_threads()
+ */
+bool agentite_game_context_apply_ecs_threads(Agentite_World *world,
+                                             const Agentite_GameContextConfig *config);
+
 /**
  * Begin a new frame.
  * Call this at the start of your game loop.
@@ -236,11 +263,23 @@ void agentite_game_context_poll_events(Agentite_GameContext *ctx);
  *
  * This function:
  * - Calls agentite_end_frame() to increment frame counter
+ * - Swaps the frame arena, reclaiming the allocations of the previous frame
  *
  * @param ctx Game context
  */
 void agentite_game_context_end_frame(Agentite_GameContext *ctx);
 
+/**
+ * Get the arena for transient allocations made this frame.
+ * Memory stays valid through the next frame and is reclaimed when that
+ * frame ends. Pass it to the _frame API variants, e.g.
+ * agentite_pathfinder_find_frame() or agentite_command_new_frame().
+ *
+ * @param ctx Game context
+ * @return Current frame arena, or NULL if ctx is NULL
+ */
+Agentite_Arena *agentite_game_context_frame_arena(Agentite_GameContext *ctx);
+
 /**
  * Begin rendering.
  * Call this before any render operations.
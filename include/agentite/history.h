@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "agentite/arena.h"
 
 #define AGENTITE_HISTORY_MAX_SNAPSHOTS 100
 #define AGENTITE_HISTORY_MAX_EVENTS 50
@@ -65,6 +66,9 @@ const Agentite_HistoryEvent *agentite_history_get_event(const Agentite_History *
 // Get graph data for a metric (for UI graphing)
 // Caller must free returned values array with agentite_graph_data_free
 Agentite_GraphData agentite_history_get_graph(const Agentite_History *h, int metric_index);
+// Same, with values allocated from arena (e.g. the frame arena); do not free
+Agentite_GraphData agentite_history_get_graph_frame(const Agentite_History *h, int metric_index,
+                                                    Agentite_Arena *arena);
 void agentite_graph_data_free(Agentite_GraphData *data);
 
 // Clear all history
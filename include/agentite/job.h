@@ -0,0 +1,95 @@
+/**
+ * @file job.h
+ * @brief Fork-Join Job Pool
+ *
+ * A small pool of worker threads for data-parallel CPU work. The caller
+ * splits an index range with agentite_job_parallel_for(); the range is cut
+ * into chunks, the workers and the calling thread take chunks until none
+ * are left, and the call returns once every chunk has run.
+ *
+ * Usage:
+ *   Agentite_JobPool *jobs = agentite_job_pool_create(0);   // cores - 1 workers
+ *
+ *   static void score_range(void *userdata, int begin, int end) {
+ *       Scores *s = (Scores *)userdata;
+ *       for (int i = begin; i < end; i++) s->out[i] = score(s->in[i]);
+ *   }
+ *   agentite_job_parallel_for(jobs, count, 0, score_range, &scores);
+ *
+ *   agentite_job_pool_destroy(jobs);
+ *
+ * Thread safety:
+ *   - create/destroy: NOT thread-safe, owner thread only
+ *   - parallel_for: any thread. Only one call uses the workers at a time;
+ *     a call made while another is running (including from inside a job)
+ *     runs its whole range on the calling thread instead of waiting.
+ *   - A NULL pool is valid everywhere and runs the range inline.
+ */
+
+#ifndef AGENTITE_JOB_H
+#define AGENTITE_JOB_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Types
+ * ============================================================================ */
+
+typedef struct Agentite_JobPool Agentite_JobPool;
+
+/**
+ * Job body: process indices [begin, end).
+ * Called concurrently for disjoint ranges; must not touch shared state
+ * without its own synchronization.
+ */
+typedef void (*Agentite_JobRangeFn)(void *userdata, int begin, int end);
+
+/* ============================================================================
+ * Lifecycle
+ * ============================================================================ */
+
+/**
+ * Create a job pool.
+ *
+ * @param num_threads Worker threads (0 = logical cores - 1). The calling
+ *                    thread runs chunks too, so a single-core machine
+ *                    gets no workers and every call runs inline.
+ * @return New pool, or NULL on failure
+ */
+Agentite_JobPool *agentite_job_pool_create(int num_threads);
+
+/**
+ * Destroy a job pool and join its workers. Safe with NULL.
+ */
+void agentite_job_pool_destroy(Agentite_JobPool *pool);
+
+/**
+ * Get the number of worker threads (not counting callers).
+ */
+int agentite_job_pool_thread_count(const Agentite_JobPool *pool);
+
+/* ============================================================================
+ * Execution
+ * ============================================================================ */
+
+/**
+ * Run fn over [0, count) split into chunks, and wait for all of them.
+ *
+ * @param pool     Job pool (NULL = run inline)
+ * @param count    Number of indices
+ * @param grain    Indices per chunk (0 = pick from count and thread count)
+ * @param fn       Range function
+ * @param userdata Passed to fn
+ */
+void agentite_job_parallel_for(Agentite_JobPool *pool, int count, int grain,
+                               Agentite_JobRangeFn fn, void *userdata);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGENTITE_JOB_H */
@@ -35,6 +35,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "agentite/arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -187,6 +188,17 @@ Agentite_Path *agentite_pathfinder_find_ex(Agentite_Pathfinder *pf,
                                         int end_x, int end_y,
                                         const Agentite_PathOptions *options);
 
+/**
+ * Find path, allocating the result from an arena (e.g. the frame arena).
+ * options may be NULL for defaults. Returns NULL if no path exists.
+ * The path lives until the arena is reset; do NOT call agentite_path_destroy().
+ */
+Agentite_Path *agentite_pathfinder_find_frame(Agentite_Pathfinder *pf,
+                                           int start_x, int start_y,
+                                           int end_x, int end_y,
+                                           const Agentite_PathOptions *options,
+                                           Agentite_Arena *arena);
+
 /* Check if a path exists (faster than full pathfinding) */
 bool agentite_pathfinder_has_path(Agentite_Pathfinder *pf,
                                  int start_x, int start_y,
@@ -210,6 +222,10 @@ const Agentite_PathPoint *agentite_path_get_point(const Agentite_Path *path, int
 /* Simplify path by removing redundant points on straight lines */
 Agentite_Path *agentite_path_simplify(Agentite_Path *path);
 
+/* Simplified copy allocated from arena; path is left untouched.
+ * Returns NULL on failure. Do NOT call agentite_path_destroy() on the copy. */
+Agentite_Path *agentite_path_simplify_frame(const Agentite_Path *path, Agentite_Arena *arena);
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
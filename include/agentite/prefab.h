@@ -31,6 +31,11 @@
  *   // Spawn entity from prefab
  *   ecs_entity_t e = agentite_prefab_spawn(prefabs, enemy, ecs_world, 100, 200);
  *
+ *   // Spawn a whole wave: compile once, then create the entities in bulk
+ *   Agentite_CompiledPrefab *wave = agentite_prefab_compile(enemy, &spawn_ctx);
+ *   agentite_prefab_spawn_batch(wave, 10000, positions, NULL);
+ *   agentite_prefab_compiled_destroy(wave);
+ *
  *   agentite_prefab_registry_destroy(prefabs);
  */
 
@@ -47,6 +52,7 @@ extern "C" {
 
 /* Forward declarations */
 typedef struct Agentite_Prefab Agentite_Prefab;
+typedef struct Agentite_CompiledPrefab Agentite_CompiledPrefab;
 typedef struct Agentite_PrefabRegistry Agentite_PrefabRegistry;
 typedef struct Agentite_ReflectRegistry Agentite_ReflectRegistry;
 typedef struct Agentite_AssetRegistry Agentite_AssetRegistry;
@@ -241,6 +247,66 @@ ecs_entity_t agentite_prefab_spawn_at(const Agentite_Prefab *prefab,
                                        const Agentite_ReflectRegistry *reflect,
                                        float x, float y);
 
+/* ============================================================================
+ * Compiled Prefabs
+ * ============================================================================ */
+
+/**
+ * Compile a prefab for repeated spawning.
+ *
+ * Resolves every component through the reflection registry once. The base
+ * prefab is merged in and the field values are baked into ready-to-copy
+ * component data. Spawning a compiled prefab copies that data and does no
+ * name lookups or value parsing. Children are compiled too.
+ *
+ * The result is bound to ctx->world. ctx->parent and the ctx offset are
+ * applied to every spawn. String fields still point into the source
+ * prefab, which must outlive the compiled prefab and its entities.
+ *
+ * @param prefab Prefab to compile
+ * @param ctx    Spawn context (world and reflect required)
+ * @return Compiled prefab, or NULL on error. Free with agentite_prefab_compiled_destroy().
+ */
+Agentite_CompiledPrefab *agentite_prefab_compile(const Agentite_Prefab *prefab,
+                                                 const Agentite_SpawnContext *ctx);
+
+/**
+ * Destroy a compiled prefab. Spawned entities are not affected.
+ * Safe to pass NULL.
+ */
+void agentite_prefab_compiled_destroy(Agentite_CompiledPrefab *compiled);
+
+/**
+ * Spawn one entity from a compiled prefab.
+ * Gives the same result as agentite_prefab_spawn() with the compile context.
+ *
+ * @param compiled Compiled prefab
+ * @param x, y     Spawn position (added to the context offset)
+ * @return Created entity, or 0 on failure
+ */
+ecs_entity_t agentite_prefab_spawn_compiled(const Agentite_CompiledPrefab *compiled,
+                                            float x, float y);
+
+/**
+ * Spawn many entities from a compiled prefab.
+ *
+ * All root entities go into their archetype with one ecs_bulk_init() call.
+ * Each entity gets its own copy of the baked component data. Children are
+ * then spawned under every root. The prefab's entity name is not applied,
+ * since names must be unique.
+ *
+ * Inside a system (deferred world) entities are created one at a time
+ * through the command queue instead.
+ *
+ * @param compiled     Compiled prefab
+ * @param count        Number of entities
+ * @param positions    count (x, y) pairs, or NULL to spawn all at the offset
+ * @param out_entities Receives the root entities (count, optional)
+ * @return Number of root entities spawned
+ */
+int agentite_prefab_spawn_batch(const Agentite_CompiledPrefab *compiled, int count,
+                                const float *positions, ecs_entity_t *out_entities);
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
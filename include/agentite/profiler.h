@@ -8,11 +8,13 @@
  * Features:
  * - Frame time tracking (update, render, present phases)
  * - Scope-based profiling with AGENTITE_PROFILE_SCOPE macro
+ * - Hierarchical scope tree with automatic capture of slow frames
  * - Draw call, batch, and vertex count tracking
  * - Entity count monitoring
- * - Memory allocation tracking
+ * - Memory allocation tracking, per frame and per subsystem
  * - Rolling frame time history for graphs
  * - CSV/JSON export for external analysis
+ * - Multi-threaded trace capture with Chrome/Perfetto trace export
  *
  * Usage:
  *   // Create profiler
@@ -39,6 +41,13 @@
  *   // Cleanup
  *   agentite_profiler_destroy(profiler);
  *
+ * Tracing (any thread, names must be string literals):
+ *   agentite_profiler_trace_start(profiler, 120);   // Next 120 frames
+ *   // ... frames run; workers call agentite_profiler_trace_begin/end ...
+ *   if (!agentite_profiler_is_tracing(profiler)) {
+ *       agentite_profiler_export_trace(profiler, "trace.json");
+ *   }
+ *
  * Scope-based profiling (C++ only):
  *   void MyFunction() {
  *       AGENTITE_PROFILE_SCOPE(profiler, "MyFunction");
@@ -52,6 +61,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include "agentite/alloc.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -73,6 +83,15 @@ extern "C" {
 /** Maximum named scopes that can be tracked */
 #define AGENTITE_PROFILER_MAX_NAMED_SCOPES 64
 
+/** Maximum nodes in the hierarchical scope tree */
+#define AGENTITE_PROFILER_MAX_TREE_NODES 128
+
+/** Number of most recent spike captures kept */
+#define AGENTITE_PROFILER_MAX_SPIKES 4
+
+/** Default trace ring size per thread, in events (24 bytes each) */
+#define AGENTITE_PROFILER_DEFAULT_TRACE_EVENTS 65536
+
 /* ============================================================================
  * Forward Declarations
  * ============================================================================ */
@@ -93,6 +112,33 @@ typedef struct Agentite_ScopeStats {
     uint32_t call_count;     /**< Number of times entered this frame */
 } Agentite_ScopeStats;
 
+/**
+ * Node of the hierarchical scope tree.
+ * The same name under different parents is a different node. Parents always
+ * come before their children in node arrays.
+ */
+typedef struct Agentite_ScopeNode {
+    char name[AGENTITE_PROFILER_MAX_SCOPE_NAME];  /**< Scope name */
+    int32_t parent;          /**< Index of the parent node (-1 = top level) */
+    uint32_t depth;          /**< Nesting depth (0 = top level) */
+    double time_ms;          /**< Time in this scope, children included (current frame) */
+    double avg_time_ms;      /**< Average per frame over frames it ran in */
+    double max_time_ms;      /**< Maximum per frame */
+    uint32_t call_count;     /**< Number of times entered this frame */
+} Agentite_ScopeNode;
+
+/** Scope tree of a frame that exceeded the spike threshold */
+typedef struct Agentite_ProfilerSpike {
+    uint64_t frame_number;   /**< Frame index (stats.frame_count after the frame) */
+    double frame_time_ms;    /**< Total frame time */
+    double update_time_ms;   /**< Update phase time */
+    double render_time_ms;   /**< Render phase time */
+    double present_time_ms;  /**< Present phase time */
+    uint32_t node_count;     /**< Scopes that ran during the frame */
+    Agentite_ScopeNode nodes[AGENTITE_PROFILER_MAX_TREE_NODES]; /**< Their tree */
+    Agentite_AllocStats allocs; /**< Allocations during the frame (track_memory) */
+} Agentite_ProfilerSpike;
+
 /** Memory allocation statistics */
 typedef struct Agentite_MemoryStats {
     size_t current_bytes;    /**< Currently allocated bytes (tracked) */
@@ -135,6 +181,7 @@ typedef struct Agentite_ProfilerStats {
 
     /* Memory stats */
     Agentite_MemoryStats memory; /**< Memory statistics */
+    Agentite_AllocStats frame_allocs; /**< Allocations during the last frame (track_memory) */
 
     /* Named scopes */
     Agentite_ScopeStats scopes[AGENTITE_PROFILER_MAX_NAMED_SCOPES];
@@ -151,6 +198,8 @@ typedef struct Agentite_ProfilerConfig {
     bool track_memory;       /**< Enable memory allocation tracking */
     bool track_scopes;       /**< Enable scope-based profiling */
     bool enabled;            /**< Master enable switch */
+    uint32_t trace_buffer_events; /**< Trace ring size per thread (0 = default) */
+    double spike_threshold_ms; /**< Capture the scope tree of slower frames (0 = off) */
 } Agentite_ProfilerConfig;
 
 /** Default profiler configuration */
@@ -158,7 +207,9 @@ typedef struct Agentite_ProfilerConfig {
     .history_size = AGENTITE_PROFILER_DEFAULT_HISTORY_SIZE, \
     .track_memory = false, \
     .track_scopes = true, \
-    .enabled = true \
+    .enabled = true, \
+    .trace_buffer_events = 0, \
+    .spike_threshold_ms = 0.0 \
 }
 
 /* ============================================================================
@@ -306,6 +357,8 @@ void agentite_profiler_end_present(Agentite_Profiler *profiler);
 /**
  * Begin a named profiling scope.
  * Scopes can be nested. Each scope tracks its own timing statistics.
+ * During a trace capture the scope is also traced, which keeps the name
+ * pointer: it must stay valid until the trace is exported.
  *
  * @param profiler Profiler instance
  * @param name Scope name (max AGENTITE_PROFILER_MAX_SCOPE_NAME chars)
@@ -324,6 +377,21 @@ void agentite_profiler_begin_scope(Agentite_Profiler *profiler, const char *name
  */
 void agentite_profiler_end_scope(Agentite_Profiler *profiler);
 
+/**
+ * Record a scope that was timed elsewhere.
+ * The time is added like a begin/end pair nested in the innermost open
+ * scope, for work measured by another system (for example ECS systems
+ * timed across worker threads). It is not traced.
+ *
+ * @param profiler Profiler instance
+ * @param name Scope name (max AGENTITE_PROFILER_MAX_SCOPE_NAME chars)
+ * @param time_ms Time spent in the scope
+ *
+ * Thread Safety: NOT thread-safe
+ */
+void agentite_profiler_record_scope(Agentite_Profiler *profiler, const char *name,
+                                    double time_ms);
+
 /**
  * Get statistics for a named scope.
  *
@@ -336,6 +404,155 @@ void agentite_profiler_end_scope(Agentite_Profiler *profiler);
 const Agentite_ScopeStats *agentite_profiler_get_scope(
     const Agentite_Profiler *profiler, const char *name);
 
+/* ============================================================================
+ * Scope Tree and Spikes
+ * ============================================================================ */
+
+/**
+ * Get the hierarchical scope tree.
+ * Nodes keep their index for the profiler's lifetime (until reset); per-frame
+ * values are for the last completed frame. Scopes beyond
+ * AGENTITE_PROFILER_MAX_TREE_NODES are only counted in the flat stats.
+ *
+ * @param profiler Profiler instance
+ * @param out_count Output: number of nodes
+ * @return Node array (do not free), valid until the next profiler call
+ *
+ * Thread Safety: NOT thread-safe
+ */
+const Agentite_ScopeNode *agentite_profiler_get_scope_tree(
+    const Agentite_Profiler *profiler, uint32_t *out_count);
+
+/**
+ * Change the spike threshold.
+ * Frames slower than threshold_ms have their scope tree captured.
+ *
+ * @param profiler Profiler instance
+ * @param threshold_ms Frame time threshold (0 = off)
+ *
+ * Thread Safety: NOT thread-safe
+ */
+void agentite_profiler_set_spike_threshold(Agentite_Profiler *profiler, double threshold_ms);
+
+/**
+ * Get the number of spike captures kept (at most AGENTITE_PROFILER_MAX_SPIKES).
+ *
+ * @param profiler Profiler instance
+ * @return Number of captures
+ *
+ * Thread Safety: NOT thread-safe
+ */
+uint32_t agentite_profiler_get_spike_count(const Agentite_Profiler *profiler);
+
+/**
+ * Get a spike capture.
+ *
+ * @param profiler Profiler instance
+ * @param index 0 for the most recent, up to get_spike_count() - 1
+ * @return Capture (do not free), or NULL if index is out of range
+ *
+ * Thread Safety: NOT thread-safe
+ */
+const Agentite_ProfilerSpike *agentite_profiler_get_spike(
+    const Agentite_Profiler *profiler, uint32_t index);
+
+/**
+ * Discard all spike captures.
+ *
+ * @param profiler Profiler instance
+ *
+ * Thread Safety: NOT thread-safe
+ */
+void agentite_profiler_clear_spikes(Agentite_Profiler *profiler);
+
+/* ============================================================================
+ * Tracing
+ *
+ * Records individual scope timings from any thread into per-thread rings
+ * without locks, for viewing in chrome://tracing or ui.perfetto.dev. Frames,
+ * phases and scopes from the functions above are traced automatically.
+ * Outside a capture a trace scope costs a thread-local lookup; inside one it
+ * adds two performance counter reads and one 24-byte ring write.
+ *
+ * Each thread keeps its most recent trace_buffer_events events, so size the
+ * buffer for the capture window. Trace names are stored as pointers and must
+ * outlive the export (string literals and __func__ do).
+ * ============================================================================ */
+
+/**
+ * Start a trace capture.
+ * With frame_count > 0 the capture starts at the next begin_frame and stops
+ * by itself after that many frames; with 0 it starts now and runs until
+ * agentite_profiler_trace_stop().
+ *
+ * @param profiler Profiler instance
+ * @param frame_count Frames to capture (0 = until stopped)
+ * @return false if a capture is already running
+ *
+ * Thread Safety: NOT thread-safe (call from the frame thread)
+ */
+bool agentite_profiler_trace_start(Agentite_Profiler *profiler, uint32_t frame_count);
+
+/**
+ * Stop the current trace capture early.
+ *
+ * @param profiler Profiler instance
+ *
+ * Thread Safety: NOT thread-safe (call from the frame thread)
+ */
+void agentite_profiler_trace_stop(Agentite_Profiler *profiler);
+
+/**
+ * Check whether a trace capture is pending or running.
+ *
+ * @param profiler Profiler instance
+ * @return true until the capture window has finished
+ *
+ * Thread Safety: NOT thread-safe (call from the frame thread)
+ */
+bool agentite_profiler_is_tracing(const Agentite_Profiler *profiler);
+
+/**
+ * Begin a traced scope on the calling thread.
+ * Trace scopes nest per thread and must end on the thread that began them.
+ *
+ * @param profiler Profiler instance
+ * @param name Static scope name (pointer is stored, not copied)
+ *
+ * Thread Safety: Thread-safe (lock-free)
+ */
+void agentite_profiler_trace_begin(Agentite_Profiler *profiler, const char *name);
+
+/**
+ * End the innermost traced scope on the calling thread.
+ *
+ * @param profiler Profiler instance
+ *
+ * Thread Safety: Thread-safe (lock-free)
+ */
+void agentite_profiler_trace_end(Agentite_Profiler *profiler);
+
+/**
+ * Name the calling thread in exported traces.
+ * The creating thread is "main" by default.
+ *
+ * @param profiler Profiler instance
+ * @param name Thread name (copied)
+ *
+ * Thread Safety: Thread-safe
+ */
+void agentite_profiler_trace_set_thread_name(Agentite_Profiler *profiler, const char *name);
+
+/**
+ * Count the events recorded in the last finished capture.
+ *
+ * @param profiler Profiler instance
+ * @return Events across all threads, or 0 while a capture is running
+ *
+ * Thread Safety: NOT thread-safe
+ */
+size_t agentite_profiler_get_trace_event_count(const Agentite_Profiler *profiler);
+
 /* ============================================================================
  * Statistics Reporting (call these to update counters)
  * ============================================================================ */
@@ -440,6 +657,23 @@ void agentite_profiler_report_free(Agentite_Profiler *profiler, size_t bytes);
 void agentite_profiler_get_memory_stats(
     const Agentite_Profiler *profiler, Agentite_MemoryStats *out_stats);
 
+/**
+ * Get the allocations made during a recent frame, by subsystem tag.
+ * With track_memory enabled, every frame samples the AGENTITE_ALLOC counters
+ * (agentite/alloc.h) at begin and end frame; allocations from other threads
+ * during the frame are included. The allocation and free counts are also
+ * added to the memory statistics.
+ *
+ * @param profiler Profiler instance
+ * @param frame_number Frame index (stats.frame_count after that frame ended)
+ * @param out Receives the per-tag counters
+ * @return false if memory tracking is off or the frame left the history
+ *
+ * Thread Safety: NOT thread-safe
+ */
+bool agentite_profiler_get_frame_allocs(
+    const Agentite_Profiler *profiler, uint64_t frame_number, Agentite_AllocStats *out);
+
 /* ============================================================================
  * Statistics Access
  * ============================================================================ */
@@ -501,6 +735,9 @@ bool agentite_profiler_export_csv(
 
 /**
  * Export current statistics to JSON format.
+ * Includes the flat scopes, the nested scope tree ("scope_tree"), the last
+ * frame's allocations by tag ("frame_allocs") and every kept spike capture
+ * with its tree and allocations ("spikes").
  *
  * @param profiler Profiler instance
  * @param path File path to write (will be overwritten)
@@ -511,6 +748,20 @@ bool agentite_profiler_export_csv(
 bool agentite_profiler_export_json(
     const Agentite_Profiler *profiler, const char *path);
 
+/**
+ * Export the last finished trace capture as Chrome trace-event JSON.
+ * The file opens in chrome://tracing and ui.perfetto.dev, with one track
+ * per thread.
+ *
+ * @param profiler Profiler instance
+ * @param path File path to write (will be overwritten)
+ * @return true on success, false on I/O error or while a capture is running
+ *
+ * Thread Safety: NOT thread-safe (other threads may keep tracing)
+ */
+bool agentite_profiler_export_trace(
+    const Agentite_Profiler *profiler, const char *path);
+
 /**
  * Export frame history to CSV (for graphing in external tools).
  *
@@ -623,6 +874,32 @@ private:
 #define AGENTITE_PROFILE_FUNCTION(profiler) \
     AGENTITE_PROFILE_SCOPE((profiler), __func__)
 
+/**
+ * RAII helper for trace-only scopes (any thread, no aggregate stats).
+ * Usage: AGENTITE_TRACE_SCOPE(profiler, "decode");
+ */
+class Agentite_TraceScope {
+public:
+    Agentite_TraceScope(Agentite_Profiler *profiler, const char *name)
+        : m_profiler(profiler) {
+        agentite_profiler_trace_begin(m_profiler, name);
+    }
+
+    ~Agentite_TraceScope() {
+        agentite_profiler_trace_end(m_profiler);
+    }
+
+    Agentite_TraceScope(const Agentite_TraceScope&) = delete;
+    Agentite_TraceScope& operator=(const Agentite_TraceScope&) = delete;
+
+private:
+    Agentite_Profiler *m_profiler;
+};
+
+/** Macro for automatic trace scopes (C++ only, name must be static) */
+#define AGENTITE_TRACE_SCOPE(profiler, name) \
+    Agentite_TraceScope _agentite_trace_scope_##__LINE__((profiler), (name))
+
 #endif /* __cplusplus */
 
 #endif /* AGENTITE_PROFILER_H */
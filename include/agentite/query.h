@@ -26,6 +26,16 @@
  *   agentite_query_invalidate(queries, "faction_resources");
  *   agentite_query_invalidate_all(queries);
  *
+ *   // Or let entries go stale on their own: declare what the query reads
+ *   // and bump that revision whenever it changes
+ *   Agentite_QueryDep dep_resources = agentite_query_dep(queries, "resources");
+ *   agentite_query_add_dep(queries, "faction_resources", dep_resources);
+ *   agentite_query_dep_bump(queries, dep_resources);    // On every resource change
+ *
+ *   // Read cached results in place instead of copying them out
+ *   const FactionResourcesResult *r = (const FactionResourcesResult *)
+ *       agentite_query_exec_ref(queries, "faction_resources", game_state, &params, NULL);
+ *
  *   // Cleanup
  *   agentite_query_destroy(queries);
  */
@@ -36,6 +46,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include "agentite/arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +61,8 @@ extern "C" {
 #define AGENTITE_QUERY_MAX_RESULT_SIZE 4096  /* Maximum result size in bytes */
 #define AGENTITE_QUERY_MAX_CACHE_SIZE  32    /* Maximum cache entries per query */
 #define AGENTITE_QUERY_CACHE_KEY_SIZE  64    /* Size of cache key buffer */
+#define AGENTITE_QUERY_MAX_DEPS        64    /* Maximum dependency sources */
+#define AGENTITE_QUERY_MAX_ENTRY_DEPS  16    /* Maximum dependencies per cached result */
 
 /*============================================================================
  * Query Result Status
@@ -146,6 +159,12 @@ typedef struct Agentite_QueryResult {
 
 typedef struct Agentite_QuerySystem Agentite_QuerySystem;
 
+/**
+ * Dependency source: a named revision counter for a piece of world state
+ * (a component, a resource table, the map). 0 is never a valid source.
+ */
+typedef uint16_t Agentite_QueryDep;
+
 /*============================================================================
  * Callback Types
  *============================================================================*/
@@ -299,6 +318,45 @@ Agentite_QueryStatus agentite_query_exec(Agentite_QuerySystem *sys,
                                        const Agentite_QueryParams *params,
                                        void *result);
 
+/**
+ * Execute a query into a result buffer allocated from an arena.
+ * Saves a caller-side buffer when results are only needed for a frame.
+ *
+ * @param sys        Query system
+ * @param name       Query name
+ * @param game_state Game state pointer
+ * @param params     Query parameters (NULL for parameterless queries)
+ * @param arena      Arena for the result (e.g. the frame arena)
+ * @param out_status Query status (may be NULL)
+ * @return Result valid until the arena is reset, or NULL unless status is
+ *         AGENTITE_QUERY_OK or AGENTITE_QUERY_CACHE_HIT
+ */
+void *agentite_query_exec_frame(Agentite_QuerySystem *sys,
+                                const char *name,
+                                void *game_state,
+                                const Agentite_QueryParams *params,
+                                Agentite_Arena *arena,
+                                Agentite_QueryStatus *out_status);
+
+/**
+ * Execute a cached query and return its result in place.
+ * A hit costs no copy; a miss runs the query directly into a cache slot.
+ *
+ * @param sys        Query system
+ * @param name       Query name (caching must be enabled)
+ * @param game_state Game state pointer
+ * @param params     Query parameters (NULL for parameterless queries)
+ * @param out_status Query status (may be NULL)
+ * @return Read-only result, or NULL unless status is AGENTITE_QUERY_OK or
+ *         AGENTITE_QUERY_CACHE_HIT. Valid until the next execution of the
+ *         same query, or until its cache is disabled or it is unregistered.
+ */
+const void *agentite_query_exec_ref(Agentite_QuerySystem *sys,
+                                    const char *name,
+                                    void *game_state,
+                                    const Agentite_QueryParams *params,
+                                    Agentite_QueryStatus *out_status);
+
 /**
  * Execute a query with integer parameter.
  * Convenience wrapper for single-parameter queries.
@@ -459,6 +517,62 @@ void agentite_query_get_cache_stats(const Agentite_QuerySystem *sys,
  */
 void agentite_query_clear_cache_stats(Agentite_QuerySystem *sys, const char *name);
 
+/*============================================================================
+ * Dependencies
+ *
+ * Each cached result remembers the revision of every source it read. A
+ * lookup compares them with the current revisions and recomputes if any
+ * moved, so callers bump sources as state changes instead of flushing
+ * caches. Queries without dependencies stay valid until invalidated.
+ *============================================================================*/
+
+/**
+ * Get a dependency source by name, creating it on first use.
+ *
+ * @param sys  Query system
+ * @param name Source name
+ * @return Source, or 0 if AGENTITE_QUERY_MAX_DEPS are already in use
+ */
+Agentite_QueryDep agentite_query_dep(Agentite_QuerySystem *sys, const char *name);
+
+/**
+ * Mark a source as changed. Cached results that read it become stale.
+ *
+ * @param sys Query system
+ * @param dep Source to bump
+ */
+void agentite_query_dep_bump(Agentite_QuerySystem *sys, Agentite_QueryDep dep);
+
+/**
+ * Get the current revision of a source.
+ *
+ * @param sys Query system
+ * @param dep Source
+ * @return Revision (0 for an invalid source)
+ */
+uint32_t agentite_query_dep_revision(const Agentite_QuerySystem *sys, Agentite_QueryDep dep);
+
+/**
+ * Declare that a query always reads a source.
+ *
+ * @param sys  Query system
+ * @param name Query name
+ * @param dep  Source
+ * @return true if added (or already present)
+ */
+bool agentite_query_add_dep(Agentite_QuerySystem *sys, const char *name, Agentite_QueryDep dep);
+
+/**
+ * Record a read from inside a running query function, for dependencies
+ * that depend on the parameters. Results of queries executed from inside
+ * another query are tracked for the outer one automatically.
+ * Does nothing when no query is running.
+ *
+ * @param sys Query system
+ * @param dep Source that was read
+ */
+void agentite_query_track(Agentite_QuerySystem *sys, Agentite_QueryDep dep);
+
 /*============================================================================
  * Query Tags
  *============================================================================*/
@@ -752,6 +866,7 @@ typedef struct Agentite_QueryStats {
     uint32_t total_cache_hits;    /* Total cache hits */
     uint32_t total_cache_misses;  /* Total cache misses */
     uint32_t total_failures;      /* Total query failures */
+    uint32_t total_cache_stale;   /* Cached results found stale (also counted as misses) */
 } Agentite_QueryStats;
 
 /**
@@ -8,9 +8,10 @@
  *
  * Features:
  * - Command-based recording (hooks into command system)
- * - Binary replay file format with optional compression
+ * - Compact block-based replay file format with optional compression
  * - Playback with variable speed control
  * - Seek/scrub via periodic state snapshots
+ * - Streaming record/playback for long sessions with bounded memory
  * - Replay metadata (timestamp, version, duration)
  * - UI widget for playback controls
  *
@@ -63,8 +64,27 @@ extern "C" {
  * Constants
  *============================================================================*/
 
-/** Replay file format version */
-#define AGENTITE_REPLAY_VERSION             1
+/**
+ * Replay file format version
+ *
+ * Version 2 files are a fixed header followed by self-contained blocks
+ * (initial state, frames, snapshots, string table) and a trailing index:
+ *
+ *   header   metadata fields (as in version 1), flags, index offset
+ *   block    kind, flags, raw size, stored size, payload (optionally
+ *            compressed with the agentite_lz block codec, see compress.h)
+ *   index    string table and initial state offsets, per frame block its
+ *            frame count, start time and offset, per snapshot its frame,
+ *            time, offset and size
+ *
+ * Frames are varint encoded: frame numbers are implicit, runs of empty
+ * frames with the same delta time collapse to one entry, and command fields
+ * and sequence numbers are zigzag deltas. Parameter keys and string values
+ * are interned in the string table. Frame blocks are split at every
+ * snapshot, so seeking reads one snapshot block and the frames after it.
+ * Version 1 files are still loaded.
+ */
+#define AGENTITE_REPLAY_VERSION             2
 
 /** Minimum compatible version for loading */
 #define AGENTITE_REPLAY_MIN_VERSION         1
@@ -75,6 +95,9 @@ extern "C" {
 /** Default snapshot interval (frames between snapshots, ~5 sec at 60fps) */
 #define AGENTITE_REPLAY_DEFAULT_SNAPSHOT_INTERVAL   300
 
+/** Default resident memory cap for streamed recording and playback (1 MB) */
+#define AGENTITE_REPLAY_DEFAULT_STREAM_MEMORY   (1024 * 1024)
+
 /** Maximum path length for replay files */
 #define AGENTITE_REPLAY_MAX_PATH            512
 
@@ -215,6 +238,7 @@ typedef struct Agentite_ReplayConfig {
     int snapshot_interval;              /**< Frames between snapshots (0 = auto) */
     int max_snapshots;                  /**< Max snapshots to keep (0 = unlimited) */
     bool compress;                      /**< Use compression for file I/O */
+    size_t stream_memory_limit;         /**< Streaming buffer cap in bytes (0 = default) */
     Agentite_ReplaySerializeFunc serialize;     /**< State serialization callback */
     Agentite_ReplayDeserializeFunc deserialize; /**< State deserialization callback */
     Agentite_ReplayResetFunc reset;             /**< State reset callback */
@@ -225,6 +249,7 @@ typedef struct Agentite_ReplayConfig {
     .snapshot_interval = AGENTITE_REPLAY_DEFAULT_SNAPSHOT_INTERVAL, \
     .max_snapshots = 0, \
     .compress = true, \
+    .stream_memory_limit = 0, \
     .serialize = NULL, \
     .deserialize = NULL, \
     .reset = NULL \
@@ -273,6 +298,31 @@ bool agentite_replay_start_recording(Agentite_ReplaySystem *replay,
                                       void *game_state,
                                       const Agentite_ReplayMetadata *metadata);
 
+/**
+ * @brief Start recording commands straight to a file
+ *
+ * Like agentite_replay_start_recording(), but frames and snapshots are
+ * encoded into a ring buffer of at most config.stream_memory_limit bytes and
+ * written to filepath by a background thread, so memory use does not grow
+ * with the length of the session. The frame path only blocks if the disk
+ * falls behind by more than the ring.
+ *
+ * Stopping the recording writes the index and reopens the file as with
+ * agentite_replay_open_stream().
+ *
+ * @param replay        Replay system
+ * @param cmd_sys       Command system to record from
+ * @param game_state    Current game state (for initial snapshot)
+ * @param metadata      Replay metadata (map name, version, etc.)
+ * @param filepath      Output file path
+ * @return true on success, false on failure
+ */
+bool agentite_replay_start_recording_stream(Agentite_ReplaySystem *replay,
+                                             Agentite_CommandSystem *cmd_sys,
+                                             void *game_state,
+                                             const Agentite_ReplayMetadata *metadata,
+                                             const char *filepath);
+
 /**
  * @brief Stop recording
  *
@@ -315,6 +365,9 @@ bool agentite_replay_create_snapshot(Agentite_ReplaySystem *replay,
 /**
  * @brief Save replay to file
  *
+ * Always writes the current format version. A loaded replay cannot be saved
+ * over the file it was loaded from.
+ *
  * @param replay    Replay system with recorded data
  * @param filepath  Output file path
  * @return true on success, false on failure
@@ -326,7 +379,8 @@ bool agentite_replay_save(const Agentite_ReplaySystem *replay,
  * @brief Load replay from file
  *
  * Loads replay data into the replay system. Call start_playback to begin
- * playing.
+ * playing. Snapshots in version 2 files stay on disk until a seek needs
+ * them, so the file must remain in place while the replay is loaded.
  *
  * @param replay    Replay system
  * @param filepath  Input file path
@@ -335,6 +389,21 @@ bool agentite_replay_save(const Agentite_ReplaySystem *replay,
 bool agentite_replay_load(Agentite_ReplaySystem *replay,
                            const char *filepath);
 
+/**
+ * @brief Open a replay file for streamed playback
+ *
+ * Reads only the header and index. Frame blocks are read ahead on a
+ * background thread, bounded by config.stream_memory_limit, and decoded one
+ * at a time as playback reaches them. Requires a version 2 file, which must
+ * stay in place while it is open.
+ *
+ * @param replay    Replay system
+ * @param filepath  Input file path
+ * @return true on success, false on failure
+ */
+bool agentite_replay_open_stream(Agentite_ReplaySystem *replay,
+                                  const char *filepath);
+
 /**
  * @brief Get replay file metadata without loading
  *
@@ -423,8 +492,10 @@ void agentite_replay_toggle_pause(Agentite_ReplaySystem *replay);
 /**
  * @brief Seek to a specific frame
  *
- * Uses snapshots to quickly seek to the nearest snapshot, then fast-forwards
- * to the target frame.
+ * Restores the nearest snapshot at or before the target, then fast-forwards
+ * to the target frame. Frames before the snapshot are never visited, and for
+ * loaded replays only that snapshot's block is read from the file. Seeking
+ * forward continues from the current frame when no closer snapshot exists.
  *
  * @param replay        Replay system
  * @param game_state    Game state to restore
@@ -589,6 +660,24 @@ bool agentite_replay_has_data(const Agentite_ReplaySystem *replay);
  */
 int agentite_replay_get_snapshot_count(const Agentite_ReplaySystem *replay);
 
+/**
+ * @brief Check if replay data is streamed to or from a file
+ *
+ * @param replay    Replay system
+ * @return true while streamed recording or a streamed replay is open
+ */
+bool agentite_replay_is_streaming(const Agentite_ReplaySystem *replay);
+
+/**
+ * @brief Get the memory held by recorded or loaded replay data
+ *
+ * Counts frame and command storage, in-memory snapshots and stream buffers.
+ *
+ * @param replay    Replay system
+ * @return Resident bytes
+ */
+size_t agentite_replay_get_resident_memory(const Agentite_ReplaySystem *replay);
+
 /*============================================================================
  * Callbacks
  *============================================================================*/
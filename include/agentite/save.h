@@ -8,8 +8,9 @@
 #define AGENTITE_SAVE_MAX_PATH 512
 #define AGENTITE_SAVE_MAX_NAME 128
 
-// Forward declaration
+// Forward declarations
 typedef struct toml_table_t toml_table_t;
+typedef struct Agentite_EventDispatcher Agentite_EventDispatcher;
 
 // Save file info (for save list UI)
 typedef struct Agentite_SaveInfo {
@@ -33,15 +34,39 @@ typedef struct Agentite_SaveResult {
     bool was_migrated;
 } Agentite_SaveResult;
 
+// On-disk save format
+//
+// TOML (.toml) is human-readable and the default; use it for debugging.
+// Binary (.sav) stores typed records in independently loadable sections:
+//
+//   header   "AGSV", format version, flags, game version, section count,
+//            index offset (32 bytes)
+//   sections 8-byte aligned record blocks, each optionally compressed with
+//            the agentite_lz block codec (see compress.h)
+//   index    one fixed-size entry per section (name, offset, sizes, flags)
+//
+// Records are {type, key length, payload size} followed by the NUL-terminated
+// key and payload, padded so payloads stay 8-byte aligned. Arrays are a
+// count followed by the raw little-endian values. Sections are only read and
+// decompressed when the reader first enters them.
+typedef enum Agentite_SaveFormat {
+    AGENTITE_SAVE_FORMAT_TOML = 0,
+    AGENTITE_SAVE_FORMAT_BINARY
+} Agentite_SaveFormat;
+
 // Writer for saving game state
-// Provides methods to write key-value pairs in TOML format
+// Provides methods to write key-value pairs in the manager's save format
 typedef struct Agentite_SaveWriter Agentite_SaveWriter;
 
+// Binary save file state (internal)
+typedef struct Agentite_SaveBinary Agentite_SaveBinary;
+
 // Reader for loading game state
-// Wraps a toml_table_t for convenient access
+// Wraps a toml_table_t (TOML saves) or a lazily loaded binary file
 typedef struct Agentite_SaveReader {
     toml_table_t *root;
-    toml_table_t *game_state;
+    toml_table_t *game_state;   // Current TOML section (NULL for binary saves)
+    Agentite_SaveBinary *binary; // Binary save state (NULL for TOML saves)
 } Agentite_SaveReader;
 
 // Callbacks for game-specific serialization
@@ -61,6 +86,14 @@ void agentite_save_destroy(Agentite_SaveManager *sm);
 // Set game version for compatibility checking
 void agentite_save_set_version(Agentite_SaveManager *sm, int version, int min_compatible);
 
+// Select the format used by subsequent saves (default: TOML)
+// Loading always accepts either format; the configured one is tried first.
+void agentite_save_set_format(Agentite_SaveManager *sm, Agentite_SaveFormat format);
+Agentite_SaveFormat agentite_save_get_format(const Agentite_SaveManager *sm);
+
+// Enable or disable section compression for binary saves (default: enabled)
+void agentite_save_set_compression(Agentite_SaveManager *sm, bool enabled);
+
 // Save game with custom name
 Agentite_SaveResult agentite_save_game(Agentite_SaveManager *sm,
                                     const char *save_name,
@@ -86,17 +119,68 @@ Agentite_SaveResult agentite_save_auto(Agentite_SaveManager *sm,
                                     Agentite_SerializeFunc serialize,
                                     void *game_state);
 
+// Async saves
+//
+// Only the snapshot callback runs on the calling thread. It should copy the
+// state the save needs into a self-contained buffer and return it (NULL on
+// failure). Serialization of that snapshot, compression and the write happen
+// on a background worker, so serialize must only touch the snapshot it is
+// given. Files are written to a temporary name, flushed, then renamed over
+// the previous save, so an interrupted save never corrupts the old one.
+//
+// Completion is reported as AGENTITE_EVENT_GAME_SAVED or
+// AGENTITE_EVENT_GAME_SAVE_FAILED on the dispatcher set below, emitted from
+// agentite_save_update() on the main thread. Saves queue in submission order.
+typedef void *(*Agentite_SnapshotFunc)(void *game_state);
+typedef void (*Agentite_SnapshotFreeFunc)(void *snapshot);
+
+// Dispatcher that receives async save completion events (may be NULL)
+void agentite_save_set_event_dispatcher(Agentite_SaveManager *sm,
+                                        Agentite_EventDispatcher *events);
+
+// Queue a save; returns false if parameters are invalid or the snapshot failed
+// (see agentite_get_last_error). free_snapshot may be NULL.
+bool agentite_save_game_async(Agentite_SaveManager *sm,
+                              const char *save_name,
+                              Agentite_SnapshotFunc snapshot,
+                              Agentite_SerializeFunc serialize,
+                              Agentite_SnapshotFreeFunc free_snapshot,
+                              void *game_state);
+
+// Async autosave (uses "autosave" as name)
+bool agentite_save_auto_async(Agentite_SaveManager *sm,
+                              Agentite_SnapshotFunc snapshot,
+                              Agentite_SerializeFunc serialize,
+                              Agentite_SnapshotFreeFunc free_snapshot,
+                              void *game_state);
+
+// Emit completion events for finished async saves; call once per frame
+// Returns the number of saves that completed since the last call
+int agentite_save_update(Agentite_SaveManager *sm);
+
+// True while any async save is queued or being written
+bool agentite_save_is_busy(const Agentite_SaveManager *sm);
+
+// Block until all queued async saves are on disk (events still need update())
+void agentite_save_wait(Agentite_SaveManager *sm);
+
 // List all saves for load screen
 // Returns array of save info, caller must free with agentite_save_list_free
 Agentite_SaveInfo *agentite_save_list(const Agentite_SaveManager *sm, int *out_count);
 void agentite_save_list_free(Agentite_SaveInfo *list);
 
-// Delete a save
+// Delete a save (removes both .toml and .sav files with that name)
 bool agentite_save_delete(Agentite_SaveManager *sm, const char *save_name);
 
-// Check if save exists
+// Check if save exists (in either format)
 bool agentite_save_exists(const Agentite_SaveManager *sm, const char *save_name);
 
+// Convert a save file between formats
+// The source format is detected from the file contents. Metadata is preserved.
+// compress only applies when writing AGENTITE_SAVE_FORMAT_BINARY.
+Agentite_SaveResult agentite_save_convert(const char *src_path, const char *dst_path,
+                                          Agentite_SaveFormat format, bool compress);
+
 // Writer API for serializing game state
 void agentite_save_write_section(Agentite_SaveWriter *w, const char *section_name);
 void agentite_save_write_int(Agentite_SaveWriter *w, const char *key, int value);
@@ -124,7 +208,13 @@ bool agentite_save_read_int_array(Agentite_SaveReader *r, const char *key,
 bool agentite_save_read_float_array(Agentite_SaveReader *r, const char *key,
                                    float **out_array, int *out_count);
 
+// Make a section current for subsequent read calls (works for both formats)
+// Pass "game_state" to return to the default section. Binary sections are
+// loaded and decompressed on first entry; sections never entered are not read.
+bool agentite_save_read_enter_section(Agentite_SaveReader *r, const char *section_name);
+
 // Access specific section in reader
+// TOML saves only; returns NULL for binary saves
 toml_table_t *agentite_save_read_section(Agentite_SaveReader *r, const char *section_name);
 
 #endif // AGENTITE_SAVE_H
@@ -41,6 +41,17 @@
  *   // Transition to next scene
  *   agentite_scene_transition(scenes, "levels/level2.scene", world, &load_ctx);
  *
+ *   // Skip parsing on later runs: compiled scenes are cached per source hash
+ *   load_ctx.cache_dir = "cache/scenes";
+ *
+ *   // Or spread a large level over frames, 2 ms of spawning per frame
+ *   agentite_scene_stream_begin(scenes, "levels/level3.scene", world,
+ *                               &load_ctx, &stream_config);
+ *   // each frame:
+ *   if (agentite_scene_stream_update(scenes) == AGENTITE_SCENE_STREAM_COMPLETE) {
+ *       // level3 is now the active scene
+ *   }
+ *
  *   // Cleanup
  *   agentite_scene_manager_destroy(scenes);
  */
@@ -63,6 +74,9 @@ typedef struct Agentite_ReflectRegistry Agentite_ReflectRegistry;
 typedef struct Agentite_AssetRegistry Agentite_AssetRegistry;
 typedef struct Agentite_PrefabRegistry Agentite_PrefabRegistry;
 typedef struct Agentite_Prefab Agentite_Prefab;
+typedef struct Agentite_AsyncLoader Agentite_AsyncLoader;
+typedef struct Agentite_SpriteRenderer Agentite_SpriteRenderer;
+typedef struct Agentite_Audio Agentite_Audio;
 typedef uint64_t ecs_entity_t;
 typedef struct ecs_world_t ecs_world_t;
 
@@ -85,10 +99,11 @@ typedef struct Agentite_SceneLoadContext {
     Agentite_AssetRegistry *assets;           /* Asset registry (optional) */
     Agentite_PrefabRegistry *prefabs;         /* Prefab registry for references (optional) */
     bool preload_assets;                      /* Preload referenced assets before instantiate */
+    const char *cache_dir;                    /* Compiled scene cache directory (optional) */
 } Agentite_SceneLoadContext;
 
 /* Default context initializer */
-#define AGENTITE_SCENE_LOAD_CONTEXT_DEFAULT { NULL, NULL, NULL, false }
+#define AGENTITE_SCENE_LOAD_CONTEXT_DEFAULT { NULL, NULL, NULL, false, NULL }
 
 /* ============================================================================
  * Scene State
@@ -98,7 +113,8 @@ typedef enum Agentite_SceneState {
     AGENTITE_SCENE_UNLOADED = 0,   /* Not loaded */
     AGENTITE_SCENE_PARSED,          /* Parsed but not instantiated */
     AGENTITE_SCENE_LOADED,          /* Entities instantiated in world */
-    AGENTITE_SCENE_UNLOADING        /* Being unloaded */
+    AGENTITE_SCENE_UNLOADING,       /* Being unloaded */
+    AGENTITE_SCENE_STREAMING        /* Being instantiated across frames */
 } Agentite_SceneState;
 
 /* ============================================================================
@@ -156,6 +172,16 @@ void agentite_scene_manager_set_active(Agentite_SceneManager *manager,
  * Load a scene from file (parse only, does not instantiate).
  * If already loaded, returns cached version.
  *
+ * With ctx->cache_dir (an existing directory) and ctx->reflect set, the
+ * scene is also compiled: a flat entity table with component data baked
+ * through reflection. The compiled form is written to the cache directory
+ * keyed by the source's content hash. Later loads of unchanged source read
+ * it back without lexing or parsing. Changing the source or any reflected
+ * component layout rebuilds it. Compiled scenes instantiate in bulk:
+ * unnamed sibling entities with the same components are created with one
+ * ecs_bulk_init() call. Base prefabs ("prefab:") are still resolved when
+ * instantiating, so editing one needs no rebuild.
+ *
  * @param manager Scene manager for caching
  * @param path    File path to load
  * @param ctx     Load context with registries
@@ -253,6 +279,95 @@ Agentite_Scene *agentite_scene_transition(Agentite_SceneManager *manager,
                                            ecs_world_t *world,
                                            const Agentite_SceneLoadContext *ctx);
 
+/* ============================================================================
+ * Streaming Instantiation
+ * ============================================================================ */
+
+typedef enum Agentite_SceneStreamStatus {
+    AGENTITE_SCENE_STREAM_IDLE = 0,         /* No stream in progress */
+    AGENTITE_SCENE_STREAM_INSTANTIATING,    /* Spawning entities in slices */
+    AGENTITE_SCENE_STREAM_PREFETCHING,      /* Entities done, waiting on asset loads */
+    AGENTITE_SCENE_STREAM_COMPLETE          /* Scene activated by this update */
+} Agentite_SceneStreamStatus;
+
+/**
+ * Streaming configuration.
+ * Textures are prefetched when loader, sprites and ctx->assets are set;
+ * sounds and music when loader, audio and ctx->assets are set.
+ */
+typedef struct Agentite_SceneStreamConfig {
+    uint32_t budget_us;                 /* Spawning time per update (0 = 2000) */
+    Agentite_AsyncLoader *loader;       /* Asset prefetch (optional) */
+    Agentite_SpriteRenderer *sprites;   /* Texture prefetch (optional) */
+    Agentite_Audio *audio;              /* Sound and music prefetch (optional) */
+} Agentite_SceneStreamConfig;
+
+#define AGENTITE_SCENE_STREAM_CONFIG_DEFAULT { 2000, NULL, NULL, NULL }
+
+typedef struct Agentite_SceneStreamProgress {
+    Agentite_SceneStreamStatus status;
+    size_t entities_created;            /* Entities spawned so far */
+    size_t entities_total;              /* Entities in the scene */
+    size_t assets_loaded;               /* Asset refs prefetched or skipped */
+    size_t assets_total;                /* Asset refs in the scene */
+    float fraction;                     /* Overall progress, 0 to 1 */
+} Agentite_SceneStreamProgress;
+
+/**
+ * Start instantiating a scene across frames.
+ * The scene is loaded (or taken from the manager) now; its entities are
+ * spawned by agentite_scene_stream_update(). Prefab refs are loaded before
+ * the first entity, other asset refs are queued on the async loader.
+ *
+ * Streamed entities carry EcsDisabled, so systems and queries skip them
+ * until the whole scene is ready. The update that finishes the scene
+ * enables every entity, uninstantiates the previous active scene and makes
+ * this one active, all in the same call.
+ *
+ * ctx and config are copied; the registries they point to must outlive
+ * the stream. One stream per manager at a time.
+ *
+ * @param manager Scene manager
+ * @param path    Scene file path
+ * @param world   ECS world
+ * @param ctx     Load context
+ * @param config  Stream configuration (NULL for defaults)
+ * @return true if the stream started
+ */
+bool agentite_scene_stream_begin(Agentite_SceneManager *manager,
+                                  const char *path,
+                                  ecs_world_t *world,
+                                  const Agentite_SceneLoadContext *ctx,
+                                  const Agentite_SceneStreamConfig *config);
+
+/**
+ * Advance the stream by about one budget of work. Call once per frame,
+ * after agentite_async_loader_update(). At least one slice runs per call,
+ * so a root with a large subtree may overrun the budget once.
+ *
+ * @param manager Scene manager
+ * @return Status after this update; COMPLETE is returned once, then IDLE
+ */
+Agentite_SceneStreamStatus agentite_scene_stream_update(Agentite_SceneManager *manager);
+
+/**
+ * Get progress of the current stream.
+ *
+ * @param manager  Scene manager
+ * @param out      Progress output (may be NULL)
+ * @return Current status
+ */
+Agentite_SceneStreamStatus agentite_scene_stream_get_progress(const Agentite_SceneManager *manager,
+                                                               Agentite_SceneStreamProgress *out);
+
+/**
+ * Abort the current stream and delete the entities spawned so far.
+ * Queued asset loads are cancelled. The active scene is unchanged.
+ *
+ * @param manager Scene manager
+ */
+void agentite_scene_stream_cancel(Agentite_SceneManager *manager);
+
 /* ============================================================================
  * Scene Entity Access
  * ============================================================================ */
@@ -364,6 +479,14 @@ const char *agentite_scene_get_name(const Agentite_Scene *scene);
  */
 Agentite_SceneState agentite_scene_get_state(const Agentite_Scene *scene);
 
+/**
+ * Check if a scene was loaded from its compiled cache without parsing.
+ *
+ * @param scene Scene to query
+ * @return true if the source was not parsed
+ */
+bool agentite_scene_is_from_cache(const Agentite_Scene *scene);
+
 /* ============================================================================
  * Scene Writing (Serialization)
  * ============================================================================ */
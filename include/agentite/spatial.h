@@ -8,10 +8,15 @@
  *
  * Features:
  * - O(1) add, remove, query, move operations
- * - Multiple entities per cell support
+ * - Multiple entities per cell support (no hard per-cell limit)
  * - Rectangular region queries
  * - Radius queries (circular area)
+ * - k-nearest queries with an optional filter, singly or batched on a job pool
  * - Iterator for cell contents
+ *
+ * Region queries walk 16x16 blocks of cells first. Each block keeps an
+ * occupancy bitmask and an entity count, so empty parts of the map cost one
+ * lookup per block instead of one per cell.
  */
 
 #ifndef AGENTITE_SPATIAL_H
@@ -21,11 +26,14 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "agentite/job.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Maximum entities per cell (can be overridden at compile time) */
+/* Entities stored inline per cell (can be overridden at compile time).
+ * Further entities spill into a shared overflow pool. */
 #ifndef AGENTITE_SPATIAL_MAX_PER_CELL
 #define AGENTITE_SPATIAL_MAX_PER_CELL 16
 #endif
@@ -52,6 +60,21 @@ typedef struct Agentite_SpatialQueryResult {
     int32_t y;              /**< Grid Y position */
 } Agentite_SpatialQueryResult;
 
+/**
+ * @brief Grid position for batched queries
+ */
+typedef struct Agentite_SpatialPoint {
+    int32_t x;
+    int32_t y;
+} Agentite_SpatialPoint;
+
+/**
+ * @brief Filter for nearest queries
+ *
+ * @return true to accept the entity as a candidate
+ */
+typedef bool (*Agentite_SpatialFilterFn)(uint32_t entity_id, int x, int y, void *userdata);
+
 /**
  * @brief Iterator for iterating cell contents
  */
@@ -102,7 +125,7 @@ void agentite_spatial_clear(Agentite_SpatialIndex *index);
  * @param x Grid X coordinate
  * @param y Grid Y coordinate
  * @param entity_id Entity ID (must be non-zero)
- * @return true if added successfully, false if cell is full or invalid params
+ * @return true if added successfully, false on invalid params or out of memory
  *
  * @note Entity IDs should be unique per cell. Adding the same entity twice
  *       to the same cell will store it twice.
@@ -250,6 +273,62 @@ int agentite_spatial_query_circle(const Agentite_SpatialIndex *index,
                                 int center_x, int center_y, int radius,
                                 Agentite_SpatialQueryResult *out_results, int max_results);
 
+/* ============================================================================
+ * Nearest-Neighbour Queries
+ * ========================================================================= */
+
+/**
+ * @brief Find the k entities closest to a point (Euclidean distance)
+ *
+ * Searches outward in rings of 16x16 blocks, skipping empty blocks and
+ * blocks farther than the current k-th candidate, and stops once no
+ * unsearched cell can be closer than the k-th candidate. Entities on
+ * the query cell itself have distance 0.
+ *
+ * @param index Spatial index
+ * @param x Query X coordinate
+ * @param y Query Y coordinate
+ * @param k Maximum number of results
+ * @param max_radius Ignore entities farther than this (negative = no limit)
+ * @param filter_fn Candidate filter (NULL = accept all)
+ * @param userdata Passed to filter_fn
+ * @param out_results Array of at least k results, filled closest first
+ *                    (equal distances ordered by entity ID)
+ * @return Number of results (less than k if fewer entities qualify)
+ */
+int agentite_spatial_query_nearest(const Agentite_SpatialIndex *index,
+                                   int x, int y, int k, int max_radius,
+                                   Agentite_SpatialFilterFn filter_fn, void *userdata,
+                                   Agentite_SpatialQueryResult *out_results);
+
+/**
+ * @brief Run agentite_spatial_query_nearest for many points in parallel
+ *
+ * Points are split across the job pool. filter_fn may be called from
+ * several threads at once, and the index must not be modified until
+ * the call returns.
+ *
+ * @param index Spatial index
+ * @param jobs Job pool (NULL = run on the calling thread)
+ * @param points Query points
+ * @param point_count Number of points
+ * @param k Maximum results per point
+ * @param max_radius Ignore entities farther than this (negative = no limit)
+ * @param filter_fn Candidate filter (NULL = accept all)
+ * @param userdata Passed to filter_fn
+ * @param out_results Array of point_count * k results; point i uses
+ *                    out_results[i * k] onward
+ * @param out_counts Array of point_count result counts
+ * @return Total number of results over all points
+ */
+int agentite_spatial_query_nearest_batch(const Agentite_SpatialIndex *index,
+                                         Agentite_JobPool *jobs,
+                                         const Agentite_SpatialPoint *points, int point_count,
+                                         int k, int max_radius,
+                                         Agentite_SpatialFilterFn filter_fn, void *userdata,
+                                         Agentite_SpatialQueryResult *out_results,
+                                         int *out_counts);
+
 /* ============================================================================
  * Iteration
  * ========================================================================= */
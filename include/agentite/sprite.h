@@ -122,12 +122,14 @@ typedef struct Agentite_SpriteRenderer Agentite_SpriteRenderer;
  * @brief Vertex format for sprite rendering.
  *
  * Internal vertex structure used by the sprite batch. Exposed for advanced
- * users who need custom vertex generation.
+ * users who need custom vertex generation. Color is packed RGBA8 (20 bytes
+ * per vertex); the GPU expands it back to 0-1 floats. Use
+ * agentite_sprite_pack_color() to fill it from float components.
  */
 typedef struct Agentite_SpriteVertex {
     float pos[2];       /**< Screen position (x, y) in pixels */
     float uv[2];        /**< Texture coordinates (0-1 normalized) */
-    float color[4];     /**< RGBA color for tinting (0-1 per component) */
+    uint8_t color[4];   /**< RGBA color for tinting (0-255 per component) */
 } Agentite_SpriteVertex;
 
 /** @} */ /* end of sprite_types */
@@ -522,6 +524,64 @@ void agentite_sprite_draw_full(Agentite_SpriteRenderer *sr, const Agentite_Sprit
                                float origin_x, float origin_y,
                                float r, float g, float b, float a);
 
+/**
+ * @brief Draw prebuilt quads.
+ *
+ * Appends vertices as-is, four per quad in top-left, top-right,
+ * bottom-right, bottom-left order, with positions in screen/world
+ * coordinates and normalized UVs. For geometry cached between frames,
+ * such as tilemap chunks, this skips all per-sprite math.
+ *
+ * @param sr         Sprite renderer (must not be NULL)
+ * @param texture    Texture sampled by every quad (must not be NULL)
+ * @param vertices   quad_count * 4 vertices
+ * @param quad_count Number of quads
+ *
+ * @note The batch grows to fit, as with single sprites.
+ */
+void agentite_sprite_draw_quads(Agentite_SpriteRenderer *sr, Agentite_Texture *texture,
+                                const Agentite_SpriteVertex *vertices, uint32_t quad_count);
+
+/**
+ * @brief Pack a float color into RGBA8 vertex color.
+ *
+ * Components are clamped to 0-1 and rounded to the nearest byte.
+ *
+ * @param out 4 bytes receiving R, G, B, A
+ */
+void agentite_sprite_pack_color(uint8_t out[4], float r, float g, float b, float a);
+
+/**
+ * @brief Build the four vertices of a sprite quad.
+ *
+ * The vertex generation behind agentite_sprite_draw_full(), usable without
+ * a renderer or GPU (custom batching, tools, benchmarks). Vertices are
+ * written top-left, top-right, bottom-right, bottom-left.
+ *
+ * @param out          4 vertices to fill (must not be NULL)
+ * @param x            X position in screen/world coordinates
+ * @param y            Y position in screen/world coordinates
+ * @param w            Quad width (source width times scale)
+ * @param h            Quad height (source height times scale)
+ * @param rotation_deg Rotation in degrees (clockwise)
+ * @param origin_x     X origin for rotation, normalized 0-1
+ * @param origin_y     Y origin for rotation, normalized 0-1
+ * @param u0           Left texture coordinate
+ * @param v0           Top texture coordinate
+ * @param u1           Right texture coordinate
+ * @param v1           Bottom texture coordinate
+ * @param r            Red tint (0-1)
+ * @param g            Green tint (0-1)
+ * @param b            Blue tint (0-1)
+ * @param a            Alpha (0-1)
+ */
+void agentite_sprite_build_quad(Agentite_SpriteVertex *out,
+                                float x, float y, float w, float h,
+                                float rotation_deg,
+                                float origin_x, float origin_y,
+                                float u0, float v0, float u1, float v1,
+                                float r, float g, float b, float a);
+
 /**
  * @brief Flush current batch during rendering.
  *
@@ -26,6 +26,14 @@
  *   // ... render pass ...
  *   agentite_sprite_render(sr, cmd, pass);
  *
+ *   // Chunk geometry is cached: static terrain is copied into the batch
+ *   // as-is, and only chunks touched by set_tile/fill are rebuilt
+ *
+ *   // Tiles are palette-compressed per chunk; a chunk of one tile type
+ *   // stores no tile array at all
+ *   Agentite_TilemapMemoryStats mem;
+ *   agentite_tilemap_get_memory_stats(tilemap, &mem);
+ *
  *   // Cleanup
  *   agentite_tilemap_destroy(tilemap);
  *   agentite_tileset_destroy(tileset);
@@ -35,6 +43,7 @@
 #define AGENTITE_TILEMAP_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -49,6 +58,7 @@ typedef struct Agentite_Texture Agentite_Texture;
 typedef struct Agentite_Sprite Agentite_Sprite;
 typedef struct Agentite_SpriteRenderer Agentite_SpriteRenderer;
 typedef struct Agentite_Camera Agentite_Camera;
+typedef struct Agentite_SpriteVertex Agentite_SpriteVertex;
 
 /* ============================================================================
  * Types
@@ -66,6 +76,33 @@ typedef struct Agentite_Tileset Agentite_Tileset;
 typedef struct Agentite_TileLayer Agentite_TileLayer;
 typedef struct Agentite_Tilemap Agentite_Tilemap;
 
+/* Normalized texture rectangle of one tileset tile */
+typedef struct Agentite_TileUV {
+    float u0, v0;   /* Top-left */
+    float u1, v1;   /* Bottom-right */
+} Agentite_TileUV;
+
+/* Inputs for agentite_tilemap_build_mesh() */
+typedef struct Agentite_TileMeshDesc {
+    const Agentite_TileUV *uvs;  /* UV per tileset index (tile ID - 1) */
+    int uv_count;                /* Entries in uvs; larger IDs are skipped */
+    float tile_width;            /* Tile size in world units */
+    float tile_height;
+    float origin_x;              /* World position of the block's top-left tile */
+    float origin_y;
+    float opacity;               /* Vertex alpha */
+} Agentite_TileMeshDesc;
+
+/* Tile storage usage, see agentite_tilemap_get_memory_stats() */
+typedef struct Agentite_TilemapMemoryStats {
+    int chunk_count;            /* Allocated chunks across all layers */
+    int uniform_chunks;         /* Chunks holding a single tile type, no tile array */
+    int packed_chunks[5];       /* Paletted chunks by index width: 1, 2, 4, 8, 16 bits */
+    size_t tile_bytes;          /* Chunk headers, palettes and packed indices */
+    size_t uncompressed_bytes;  /* Same chunks with one Agentite_TileID per tile */
+    size_t mesh_bytes;          /* Cached chunk geometry */
+} Agentite_TilemapMemoryStats;
+
 /* ============================================================================
  * Tileset Functions
  * ============================================================================ */
@@ -170,6 +207,28 @@ void agentite_tilemap_render_layer(Agentite_Tilemap *tilemap,
                                  Agentite_Camera *camera,
                                  int layer);
 
+/* Build quads for a block of tiles, as each chunk caches them: 4 vertices
+ * per non-empty tile in row order, tinted white with the given opacity.
+ * tiles is row-major with stride entries per row. out_vertices needs room
+ * for 4 vertices per non-empty tile. CPU only, needs no GPU or texture.
+ * Returns the number of quads written. */
+int agentite_tilemap_build_mesh(const Agentite_TileMeshDesc *desc,
+                              const Agentite_TileID *tiles,
+                              int width, int height, int stride,
+                              Agentite_SpriteVertex *out_vertices);
+
+/* Free all cached chunk geometry (rebuilt for chunks as they are rendered) */
+void agentite_tilemap_release_meshes(Agentite_Tilemap *tilemap);
+
+/* ============================================================================
+ * Memory
+ * ============================================================================ */
+
+/* Report how much memory tile storage uses, and what a plain array per
+ * chunk would have used. Clears *out for a NULL tilemap. */
+void agentite_tilemap_get_memory_stats(const Agentite_Tilemap *tilemap,
+                                       Agentite_TilemapMemoryStats *out);
+
 /* ============================================================================
  * Coordinate Conversion
  * ============================================================================ */
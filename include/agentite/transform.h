@@ -96,9 +96,16 @@ extern ECS_COMPONENT_DECLARE(C_WorldTransform);
  * Call once after agentite_ecs_init().
  *
  * This registers:
- * - C_Transform and C_WorldTransform components
+ * - C_Transform and C_WorldTransform components (adding C_Transform also
+ *   adds C_WorldTransform)
  * - Transform propagation system (runs on EcsPostUpdate)
  *
+ * The system visits the hierarchy breadth-first through a cascade query
+ * and writes C_WorldTransform in place. Flecs change detection limits each
+ * frame to tables whose local transforms, entities or parent world
+ * transforms changed. Changes written through ecs_get_mut() must be
+ * followed by ecs_modified() to be picked up.
+ *
  * @param world Flecs world pointer (use agentite_ecs_get_world())
  */
 void agentite_transform_register(ecs_world_t *world);
@@ -357,8 +364,9 @@ void agentite_transform_update(ecs_world_t *world, ecs_entity_t entity);
 
 /**
  * Update all world transforms.
- * Called automatically by the transform system, but can be called manually
- * if you need immediate updates.
+ * The transform system does this automatically each frame for changed
+ * tables only; call this for an immediate full pass that ignores change
+ * detection.
  *
  * @param world Flecs world
  */
@@ -27,9 +27,22 @@
  *   - agentite_watch_is_watching: Thread-safe
  *   - Callbacks are always invoked on the main thread during update()
  *
+ * Event Coalescing:
+ *   While debounce_ms > 0, a new event for a path that still has an
+ *   undelivered event is merged into it (and the debounce window restarts),
+ *   so an editor's save sequence produces a single event:
+ *     - CREATED  + MODIFIED            -> CREATED
+ *     - CREATED  + DELETED             -> (nothing, file was transient)
+ *     - MODIFIED + DELETED             -> DELETED
+ *     - DELETED  + CREATED/MODIFIED    -> MODIFIED (file replaced)
+ *     - CREATED(tmp) + RENAMED(tmp->p) -> CREATED(p), merged with p as above
+ *     - RENAMED(a->b) + RENAMED(b->c)  -> RENAMED(a->c)
+ *     - RENAMED(p->p~) + DELETED(p~)   -> DELETED(p), merged with p as above
+ *
  * Platform Support:
  *   - macOS: FSEvents API
- *   - Linux: inotify API
+ *   - Linux: inotify API (no watch count cap; recovers from kernel queue
+ *     overflow by diffing the tree against an in-memory snapshot)
  *   - Windows: ReadDirectoryChangesW API
  */
 
@@ -90,7 +103,8 @@ typedef void (*Agentite_WatchCallback)(const Agentite_WatchEvent *event, void *u
 typedef struct Agentite_FileWatcherConfig {
     bool recursive;             /* Watch subdirectories (default: true) */
     uint32_t debounce_ms;       /* Coalesce rapid changes, in milliseconds (default: 100) */
-    size_t max_events;          /* Maximum queued events (0 = unlimited, default: 1024) */
+    size_t max_events;          /* Maximum queued events, oldest dropped when full
+                                   (0 = unlimited, queue grows; default: 1024) */
 } Agentite_FileWatcherConfig;
 
 /** Default configuration */
@@ -236,7 +250,8 @@ bool agentite_watch_is_enabled(const Agentite_FileWatcher *watcher);
 
 /**
  * Set debounce time for coalescing rapid changes.
- * Changes to the same file within the debounce window are merged into one event.
+ * Changes to the same file within the debounce window are merged into one event
+ * (see "Event Coalescing" above). 0 delivers every raw event.
  *
  * @param watcher     File watcher
  * @param debounce_ms Debounce time in milliseconds (0 to disable)
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Compare two agentite_bench JSON result files.
+
+Usage:
+    scripts/bench-compare.py baseline.json current.json [--threshold PCT]
+
+Prints the median ns/op and allocations per op of every case in both files,
+and exits with status 1 when any case got slower than the threshold
+(default 10%) or started allocating more per op.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    results = {}
+    for entry in data.get("results", []):
+        if "ns_per_op" in entry:
+            results[entry["name"]] = entry
+    return data, results
+
+
+def format_ns(ns):
+    if ns >= 1e6:
+        return "%.2f ms" % (ns / 1e6)
+    if ns >= 1e3:
+        return "%.2f us" % (ns / 1e3)
+    return "%.1f ns" % ns
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="slowdown in percent that counts as a regression")
+    args = parser.parse_args()
+
+    base_meta, base = load_results(args.baseline)
+    cur_meta, cur = load_results(args.current)
+
+    print("baseline: %s (%s)" % (base_meta.get("revision"), args.baseline))
+    print("current:  %s (%s)" % (cur_meta.get("revision"), args.current))
+    if base_meta.get("seed") != cur_meta.get("seed"):
+        print("warning: runs used different seeds")
+    print()
+    print("%-32s %12s %12s %9s %16s" % ("case", "baseline", "current", "change", "allocs/op"))
+
+    regressions = []
+    for name in sorted(set(base) | set(cur)):
+        if name not in base or name not in cur:
+            where = "current" if name in cur else "baseline"
+            print("%-32s only in %s" % (name, where))
+            continue
+
+        b = base[name]["ns_per_op"]["p50"]
+        c = cur[name]["ns_per_op"]["p50"]
+        change = (c - b) / b * 100.0 if b > 0 else 0.0
+
+        ba = base[name].get("allocs_per_op")
+        ca = cur[name].get("allocs_per_op")
+        allocs = "n/a"
+        if ba is not None and ca is not None:
+            allocs = "%.2f -> %.2f" % (ba, ca)
+
+        flag = ""
+        if change > args.threshold:
+            flag = "  SLOWER"
+            regressions.append(name)
+        elif ba is not None and ca is not None and ca > ba + 0.01:
+            flag = "  MORE ALLOCS"
+            regressions.append(name)
+
+        print("%-32s %12s %12s %+8.1f%% %16s%s"
+              % (name, format_ns(b), format_ns(c), change, allocs, flag))
+
+    if regressions:
+        print()
+        print("%d regression(s): %s" % (len(regressions), ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
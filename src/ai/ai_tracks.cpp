@@ -6,6 +6,7 @@
  * evaluator, and decision set.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_AI
 #include "agentite/agentite.h"
 #include "agentite/ai_tracks.h"
 #include "agentite/blackboard.h"
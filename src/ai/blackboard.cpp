@@ -6,6 +6,7 @@
  * and decision history tracking.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_AI
 #include "agentite/agentite.h"
 #include "agentite/blackboard.h"
 #include "agentite/error.h"
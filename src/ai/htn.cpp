@@ -5,6 +5,7 @@
  * into executable primitive tasks.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_AI
 #include "agentite/agentite.h"
 #include "agentite/htn.h"
 #include "agentite/error.h"
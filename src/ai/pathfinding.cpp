@@ -4,8 +4,10 @@
  * A* algorithm with binary heap priority queue for efficient pathfinding.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_AI
 #include "agentite/agentite.h"
 #include "agentite/pathfinding.h"
+#include "agentite/arena.h"
 #include "agentite/profiler.h"
 #include "agentite/tilemap.h"
 #include <stdlib.h>
@@ -193,9 +195,31 @@ static float heuristic(int x1, int y1, int x2, int y2, bool allow_diagonal)
     }
 }
 
+/* Allocate a path of length points, from arena if given, else the heap */
+static Agentite_Path *alloc_path(int length, Agentite_Arena *arena)
+{
+    if (arena) {
+        Agentite_Path *path = AGENTITE_ARENA_ALLOC(arena, Agentite_Path);
+        if (!path) return NULL;
+        path->points = AGENTITE_ARENA_ARRAY(arena, Agentite_PathPoint, length);
+        return path->points ? path : NULL;
+    }
+
+    Agentite_Path *path = (Agentite_Path*)malloc(sizeof(Agentite_Path));
+    if (!path) return NULL;
+
+    path->points = (Agentite_PathPoint*)malloc(length * sizeof(Agentite_PathPoint));
+    if (!path->points) {
+        free(path);
+        return NULL;
+    }
+    return path;
+}
+
 static Agentite_Path *reconstruct_path(Agentite_Pathfinder *pf,
                                       int start_x, int start_y,
-                                      int end_x, int end_y)
+                                      int end_x, int end_y,
+                                      Agentite_Arena *arena)
 {
     /* Count path length */
     int length = 0;
@@ -213,15 +237,9 @@ static Agentite_Path *reconstruct_path(Agentite_Pathfinder *pf,
     length++;  /* Include start */
 
     /* Allocate path */
-    Agentite_Path *path = (Agentite_Path*)malloc(sizeof(Agentite_Path));
+    Agentite_Path *path = alloc_path(length, arena);
     if (!path) return NULL;
 
-    path->points = (Agentite_PathPoint*)malloc(length * sizeof(Agentite_PathPoint));
-    if (!path->points) {
-        free(path);
-        return NULL;
-    }
-
     path->length = length;
     path->total_cost = pf->nodes[grid_index(pf, end_x, end_y)].g_cost;
 
@@ -468,10 +486,11 @@ void agentite_pathfinder_sync_tilemap_ex(Agentite_Pathfinder *pf,
  * Pathfinding
  * ============================================================================ */
 
-Agentite_Path *agentite_pathfinder_find_ex(Agentite_Pathfinder *pf,
-                                        int start_x, int start_y,
-                                        int end_x, int end_y,
-                                        const Agentite_PathOptions *options)
+static Agentite_Path *find_path(Agentite_Pathfinder *pf,
+                                int start_x, int start_y,
+                                int end_x, int end_y,
+                                const Agentite_PathOptions *options,
+                                Agentite_Arena *arena)
 {
     if (!pf) return NULL;
 
@@ -495,14 +514,8 @@ Agentite_Path *agentite_pathfinder_find_ex(Agentite_Pathfinder *pf,
 
     /* Same tile - trivial path */
     if (start_x == end_x && start_y == end_y) {
-        result = (Agentite_Path*)malloc(sizeof(Agentite_Path));
+        result = alloc_path(1, arena);
         if (!result) goto cleanup;
-        result->points = (Agentite_PathPoint*)malloc(sizeof(Agentite_PathPoint));
-        if (!result->points) {
-            free(result);
-            result = NULL;
-            goto cleanup;
-        }
         result->points[0].x = start_x;
         result->points[0].y = start_y;
         result->length = 1;
@@ -556,7 +569,7 @@ Agentite_Path *agentite_pathfinder_find_ex(Agentite_Pathfinder *pf,
 
         /* Found goal? */
         if (curr_x == end_x && curr_y == end_y) {
-            result = reconstruct_path(pf, start_x, start_y, end_x, end_y);
+            result = reconstruct_path(pf, start_x, start_y, end_x, end_y, arena);
             goto cleanup;
         }
 
@@ -629,6 +642,24 @@ cleanup:
     return result;
 }
 
+Agentite_Path *agentite_pathfinder_find_ex(Agentite_Pathfinder *pf,
+                                        int start_x, int start_y,
+                                        int end_x, int end_y,
+                                        const Agentite_PathOptions *options)
+{
+    return find_path(pf, start_x, start_y, end_x, end_y, options, NULL);
+}
+
+Agentite_Path *agentite_pathfinder_find_frame(Agentite_Pathfinder *pf,
+                                           int start_x, int start_y,
+                                           int end_x, int end_y,
+                                           const Agentite_PathOptions *options,
+                                           Agentite_Arena *arena)
+{
+    if (!arena) return NULL;
+    return find_path(pf, start_x, start_y, end_x, end_y, options, arena);
+}
+
 Agentite_Path *agentite_pathfinder_find(Agentite_Pathfinder *pf,
                                      int start_x, int start_y,
                                      int end_x, int end_y)
@@ -702,11 +733,9 @@ const Agentite_PathPoint *agentite_path_get_point(const Agentite_Path *path, int
     return &path->points[index];
 }
 
-Agentite_Path *agentite_path_simplify(Agentite_Path *path)
+/* Points kept by simplification: start + direction changes (excluding last) + end */
+static int simplified_length(const Agentite_Path *path)
 {
-    if (!path || path->length <= 2) return path;
-
-    /* Count simplified points: start + direction changes (excluding last) + end */
     int count = 2;  /* Always include start and end */
     int prev_dx = 0, prev_dy = 0;
 
@@ -721,22 +750,16 @@ Agentite_Path *agentite_path_simplify(Agentite_Path *path)
         prev_dx = dx;
         prev_dy = dy;
     }
+    return count;
+}
 
-    /* Allocate simplified path */
-    Agentite_Path *simplified = (Agentite_Path*)malloc(sizeof(Agentite_Path));
-    if (!simplified) return path;
-
-    simplified->points = (Agentite_PathPoint*)malloc(count * sizeof(Agentite_PathPoint));
-    if (!simplified->points) {
-        free(simplified);
-        return path;
-    }
-
-    /* Build simplified path */
+/* Fill simplified (sized by simplified_length) from path */
+static void simplify_into(const Agentite_Path *path, Agentite_Path *simplified)
+{
     int out_idx = 0;
     simplified->points[out_idx++] = path->points[0];
-    prev_dx = 0;
-    prev_dy = 0;
+    int prev_dx = 0;
+    int prev_dy = 0;
 
     for (int i = 1; i < path->length; i++) {
         int dx = path->points[i].x - path->points[i-1].x;
@@ -756,12 +779,43 @@ Agentite_Path *agentite_path_simplify(Agentite_Path *path)
 
     simplified->length = out_idx;
     simplified->total_cost = path->total_cost;
+}
+
+Agentite_Path *agentite_path_simplify(Agentite_Path *path)
+{
+    if (!path || path->length <= 2) return path;
+
+    /* Allocate simplified path */
+    Agentite_Path *simplified = alloc_path(simplified_length(path), NULL);
+    if (!simplified) return path;
+
+    simplify_into(path, simplified);
 
     /* Free original and return simplified */
     agentite_path_destroy(path);
     return simplified;
 }
 
+Agentite_Path *agentite_path_simplify_frame(const Agentite_Path *path, Agentite_Arena *arena)
+{
+    if (!path || !arena || path->length <= 0) return NULL;
+
+    if (path->length <= 2) {
+        Agentite_Path *copy = alloc_path(path->length, arena);
+        if (!copy) return NULL;
+        memcpy(copy->points, path->points, path->length * sizeof(Agentite_PathPoint));
+        copy->length = path->length;
+        copy->total_cost = path->total_cost;
+        return copy;
+    }
+
+    Agentite_Path *simplified = alloc_path(simplified_length(path), arena);
+    if (!simplified) return NULL;
+
+    simplify_into(path, simplified);
+    return simplified;
+}
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
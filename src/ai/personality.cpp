@@ -5,6 +5,7 @@
  * threat assessment, goal management, and extensible action evaluation.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_AI
 #include "agentite/agentite.h"
 #include "agentite/ai.h"
 #include "agentite/error.h"
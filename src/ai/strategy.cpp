@@ -3,6 +3,7 @@
  * @brief Strategic Coordinator implementation
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_AI
 #include "agentite/agentite.h"
 #include "agentite/strategy.h"
 #include "agentite/error.h"
@@ -4,6 +4,7 @@
  * Sequential task execution for autonomous AI agents.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_AI
 #include "agentite/agentite.h"
 #include "agentite/task.h"
 #include "agentite/error.h"
@@ -0,0 +1,262 @@
+/**
+ * @file alloc.cpp
+ * @brief Pluggable Allocator and Allocation Tracking Implementation
+ */
+
+#include "agentite/alloc.h"
+#include "agentite/error.h"
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+/* ============================================================================
+ * Allocator
+ * ============================================================================ */
+
+static void *default_malloc(size_t size, void *userdata) {
+    (void)userdata;
+    return malloc(size);
+}
+
+static void *default_calloc(size_t count, size_t size, void *userdata) {
+    (void)userdata;
+    return calloc(count, size);
+}
+
+static void *default_realloc(void *ptr, size_t size, void *userdata) {
+    (void)userdata;
+    return realloc(ptr, size);
+}
+
+static void default_free(void *ptr, void *userdata) {
+    (void)userdata;
+    free(ptr);
+}
+
+static Agentite_Allocator s_allocator = {
+    default_malloc, default_calloc, default_realloc, default_free, nullptr
+};
+
+bool agentite_set_allocator(const Agentite_Allocator *allocator) {
+    if (!allocator) {
+        s_allocator = { default_malloc, default_calloc, default_realloc, default_free, nullptr };
+        return true;
+    }
+    if (!allocator->malloc_fn || !allocator->calloc_fn ||
+        !allocator->realloc_fn || !allocator->free_fn) {
+        agentite_set_error("Allocator is missing a function");
+        return false;
+    }
+    s_allocator = *allocator;
+    return true;
+}
+
+void agentite_get_allocator(Agentite_Allocator *out) {
+    if (out) {
+        *out = s_allocator;
+    }
+}
+
+/* ============================================================================
+ * Counters
+ * ============================================================================ */
+
+/* Relaxed atomics: the counters are statistics, not synchronization */
+struct TagCounters {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> frees;
+    std::atomic<uint64_t> bytes;
+};
+
+static TagCounters s_counters[AGENTITE_ALLOC_TAG_COUNT];
+
+static const char *s_tag_names[AGENTITE_ALLOC_TAG_COUNT] = {
+    "general", "command", "event", "ui", "ecs", "ai", "game"
+};
+
+static inline int clamp_tag(Agentite_AllocTag tag) {
+    return ((int)tag >= 0 && tag < AGENTITE_ALLOC_TAG_COUNT) ? (int)tag : 0;
+}
+
+/* ============================================================================
+ * Call-Site Histogram
+ * ============================================================================ */
+
+/* Open-addressed table keyed by the __FILE__ pointer and line */
+static Agentite_AllocCallsite s_callsites[AGENTITE_ALLOC_MAX_CALLSITES];
+static int s_callsite_count = 0;
+static std::mutex s_callsite_mutex;
+static std::atomic<bool> s_track_callsites{false};
+
+static void record_callsite(const char *file, int line, int tag, size_t bytes) {
+    uintptr_t h = (uintptr_t)file * 31u + (uintptr_t)line;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6dU;
+    h ^= h >> 12;
+
+    std::lock_guard<std::mutex> lock(s_callsite_mutex);
+    for (int probe = 0; probe < AGENTITE_ALLOC_MAX_CALLSITES; probe++) {
+        Agentite_AllocCallsite *site =
+            &s_callsites[(h + (uintptr_t)probe) & (AGENTITE_ALLOC_MAX_CALLSITES - 1)];
+        if (!site->file) {
+            site->file = file;
+            site->line = line;
+            site->tag = (Agentite_AllocTag)tag;
+            s_callsite_count++;
+        } else if (site->file != file || site->line != line) {
+            continue;
+        }
+        site->allocations++;
+        site->bytes += bytes;
+        return;
+    }
+    /* Table full: the site goes unrecorded, the tag counters still see it */
+}
+
+static inline void count_alloc(int tag, size_t bytes, const char *file, int line) {
+    s_counters[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+    s_counters[tag].bytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (s_track_callsites.load(std::memory_order_relaxed) && file) {
+        record_callsite(file, line, tag, bytes);
+    }
+}
+
+void agentite_alloc_set_callsite_tracking(bool enabled) {
+    s_track_callsites.store(enabled, std::memory_order_relaxed);
+}
+
+bool agentite_alloc_is_tracking_callsites(void) {
+    return s_track_callsites.load(std::memory_order_relaxed);
+}
+
+int agentite_alloc_get_callsites(Agentite_AllocCallsite *out, int max) {
+    if (!out || max <= 0) return 0;
+
+    std::lock_guard<std::mutex> lock(s_callsite_mutex);
+    int count = 0;
+    Agentite_AllocCallsite *sorted = s_callsite_count > 0
+        ? (Agentite_AllocCallsite *)malloc((size_t)s_callsite_count * sizeof(*sorted))
+        : nullptr;
+    if (!sorted) return 0;
+
+    for (int i = 0; i < AGENTITE_ALLOC_MAX_CALLSITES; i++) {
+        if (s_callsites[i].file) {
+            sorted[count++] = s_callsites[i];
+        }
+    }
+    std::sort(sorted, sorted + count,
+              [](const Agentite_AllocCallsite &a, const Agentite_AllocCallsite &b) {
+                  if (a.allocations != b.allocations) return a.allocations > b.allocations;
+                  return a.bytes > b.bytes;
+              });
+
+    int n = std::min(count, max);
+    memcpy(out, sorted, (size_t)n * sizeof(*out));
+    free(sorted);
+    return n;
+}
+
+void agentite_alloc_reset_callsites(void) {
+    std::lock_guard<std::mutex> lock(s_callsite_mutex);
+    memset(s_callsites, 0, sizeof(s_callsites));
+    s_callsite_count = 0;
+}
+
+/* ============================================================================
+ * Tagged Allocation
+ * ============================================================================ */
+
+void *agentite_mem_malloc(size_t count, size_t size, Agentite_AllocTag tag,
+                          const char *file, int line) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return nullptr;  /* Overflow would occur */
+    }
+    void *ptr = s_allocator.malloc_fn(count * size, s_allocator.userdata);
+    if (ptr) {
+        count_alloc(clamp_tag(tag), count * size, file, line);
+    }
+    return ptr;
+}
+
+void *agentite_mem_calloc(size_t count, size_t size, Agentite_AllocTag tag,
+                          const char *file, int line) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return nullptr;
+    }
+    void *ptr = s_allocator.calloc_fn(count, size, s_allocator.userdata);
+    if (ptr) {
+        count_alloc(clamp_tag(tag), count * size, file, line);
+    }
+    return ptr;
+}
+
+void *agentite_mem_realloc(void *ptr, size_t count, size_t size, Agentite_AllocTag tag,
+                           const char *file, int line) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return nullptr;
+    }
+    void *result = s_allocator.realloc_fn(ptr, count * size, s_allocator.userdata);
+    if (result) {
+        count_alloc(clamp_tag(tag), count * size, file, line);
+    }
+    return result;
+}
+
+void agentite_mem_free(void *ptr, Agentite_AllocTag tag) {
+    if (!ptr) return;
+    s_counters[clamp_tag(tag)].frees.fetch_add(1, std::memory_order_relaxed);
+    s_allocator.free_fn(ptr, s_allocator.userdata);
+}
+
+/* ============================================================================
+ * Statistics
+ * ============================================================================ */
+
+void agentite_alloc_get_stats(Agentite_AllocStats *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    for (int i = 0; i < AGENTITE_ALLOC_TAG_COUNT; i++) {
+        Agentite_AllocTagStats *t = &out->tags[i];
+        t->allocations = s_counters[i].allocations.load(std::memory_order_relaxed);
+        t->frees = s_counters[i].frees.load(std::memory_order_relaxed);
+        t->bytes = s_counters[i].bytes.load(std::memory_order_relaxed);
+        out->total.allocations += t->allocations;
+        out->total.frees += t->frees;
+        out->total.bytes += t->bytes;
+    }
+}
+
+void agentite_alloc_reset_stats(void) {
+    for (int i = 0; i < AGENTITE_ALLOC_TAG_COUNT; i++) {
+        s_counters[i].allocations.store(0, std::memory_order_relaxed);
+        s_counters[i].frees.store(0, std::memory_order_relaxed);
+        s_counters[i].bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+void agentite_alloc_stats_delta(const Agentite_AllocStats *begin,
+                                const Agentite_AllocStats *end,
+                                Agentite_AllocStats *out) {
+    if (!begin || !end || !out) return;
+
+    /* A reset between the snapshots leaves end below begin; report end as-is */
+    auto sub = [](uint64_t b, uint64_t e) { return e >= b ? e - b : e; };
+    memset(out, 0, sizeof(*out));
+    for (int i = 0; i < AGENTITE_ALLOC_TAG_COUNT; i++) {
+        Agentite_AllocTagStats *t = &out->tags[i];
+        t->allocations = sub(begin->tags[i].allocations, end->tags[i].allocations);
+        t->frees = sub(begin->tags[i].frees, end->tags[i].frees);
+        t->bytes = sub(begin->tags[i].bytes, end->tags[i].bytes);
+        out->total.allocations += t->allocations;
+        out->total.frees += t->frees;
+        out->total.bytes += t->bytes;
+    }
+}
+
+const char *agentite_alloc_tag_name(Agentite_AllocTag tag) {
+    if ((int)tag < 0 || tag >= AGENTITE_ALLOC_TAG_COUNT) return "unknown";
+    return s_tag_names[tag];
+}
@@ -0,0 +1,247 @@
+/**
+ * @file arena.cpp
+ * @brief Linear Arena and Double-Buffered Frame Arena Implementation
+ */
+
+#include "agentite/agentite.h"
+#include "agentite/arena.h"
+#include "agentite/error.h"
+#include <stdint.h>
+#include <string.h>
+
+/* ============================================================================
+ * Internal Types
+ * ============================================================================ */
+
+/** Extra block used when the main block is full (data follows the header) */
+struct ArenaOverflow {
+    ArenaOverflow *next;
+    size_t size;
+    size_t used;
+};
+
+struct Agentite_Arena {
+    unsigned char *base;
+    size_t capacity;
+    size_t offset;
+
+    ArenaOverflow *overflow;        /* Newest first; only the head takes new requests */
+    size_t overflow_used;           /* Bytes handed out from overflow blocks this cycle */
+
+    size_t high_water;
+    uint32_t overflow_blocks;
+    uint32_t grow_count;
+};
+
+struct Agentite_FrameArena {
+    Agentite_Arena *arenas[2];
+    int current;
+};
+
+/* Overflow data starts at a default-aligned offset after its header */
+#define OVERFLOW_HEADER_SIZE \
+    ((sizeof(ArenaOverflow) + AGENTITE_ARENA_DEFAULT_ALIGN - 1) & \
+     ~(size_t)(AGENTITE_ARENA_DEFAULT_ALIGN - 1))
+
+static inline unsigned char *overflow_data(ArenaOverflow *block) {
+    return (unsigned char *)block + OVERFLOW_HEADER_SIZE;
+}
+
+/** Padding needed to align ptr, or SIZE_MAX if align is not a power of two */
+static inline size_t align_padding(const void *ptr, size_t align) {
+    if (align & (align - 1)) return SIZE_MAX;
+    uintptr_t p = (uintptr_t)ptr;
+    return (size_t)((align - (p & (align - 1))) & (align - 1));
+}
+
+static void free_overflow(Agentite_Arena *arena) {
+    ArenaOverflow *block = arena->overflow;
+    while (block) {
+        ArenaOverflow *next = block->next;
+        AGENTITE_FREE(block);
+        block = next;
+    }
+    arena->overflow = NULL;
+    arena->overflow_used = 0;
+}
+
+/* ============================================================================
+ * Arena
+ * ============================================================================ */
+
+Agentite_Arena *agentite_arena_create(size_t capacity) {
+    if (capacity == 0) {
+        capacity = AGENTITE_FRAME_ARENA_DEFAULT_SIZE;
+    }
+
+    Agentite_Arena *arena = AGENTITE_ALLOC(Agentite_Arena);
+    if (!arena) {
+        agentite_set_error("Failed to allocate arena");
+        return NULL;
+    }
+
+    arena->base = (unsigned char *)AGENTITE_MALLOC(capacity);
+    if (!arena->base) {
+        agentite_set_error("Failed to allocate arena block (%zu bytes)", capacity);
+        AGENTITE_FREE(arena);
+        return NULL;
+    }
+    arena->capacity = capacity;
+    return arena;
+}
+
+void agentite_arena_destroy(Agentite_Arena *arena) {
+    if (!arena) return;
+    free_overflow(arena);
+    AGENTITE_FREE(arena->base);
+    AGENTITE_FREE(arena);
+}
+
+void *agentite_arena_alloc(Agentite_Arena *arena, size_t size, size_t align) {
+    if (!arena) return NULL;
+    if (align == 0) {
+        align = AGENTITE_ARENA_DEFAULT_ALIGN;
+    }
+
+    /* Main block */
+    size_t pad = align_padding(arena->base + arena->offset, align);
+    if (pad == SIZE_MAX) {
+        agentite_set_error("Arena alignment %zu is not a power of two", align);
+        return NULL;
+    }
+    if (pad <= arena->capacity - arena->offset &&
+        size <= arena->capacity - arena->offset - pad) {
+        void *ptr = arena->base + arena->offset + pad;
+        arena->offset += pad + size;
+        return ptr;
+    }
+
+    /* Newest overflow block */
+    ArenaOverflow *block = arena->overflow;
+    if (block) {
+        pad = align_padding(overflow_data(block) + block->used, align);
+        if (pad <= block->size - block->used && size <= block->size - block->used - pad) {
+            void *ptr = overflow_data(block) + block->used + pad;
+            block->used += pad + size;
+            arena->overflow_used += pad + size;
+            return ptr;
+        }
+    }
+
+    /* New overflow block, large enough for the request at any alignment */
+    if (size > SIZE_MAX - align - OVERFLOW_HEADER_SIZE) {
+        return NULL;
+    }
+    size_t block_size = size + align;
+    if (block_size < arena->capacity) {
+        block_size = arena->capacity;
+    }
+    block = (ArenaOverflow *)AGENTITE_MALLOC(OVERFLOW_HEADER_SIZE + block_size);
+    if (!block) {
+        agentite_set_error("Failed to allocate arena overflow block (%zu bytes)", block_size);
+        return NULL;
+    }
+    block->next = arena->overflow;
+    block->size = block_size;
+    block->used = 0;
+    arena->overflow = block;
+    arena->overflow_blocks++;
+
+    pad = align_padding(overflow_data(block), align);
+    void *ptr = overflow_data(block) + pad;
+    block->used = pad + size;
+    arena->overflow_used += pad + size;
+    return ptr;
+}
+
+void *agentite_arena_calloc(Agentite_Arena *arena, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *ptr = agentite_arena_alloc(arena, count * size, AGENTITE_ARENA_DEFAULT_ALIGN);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+void agentite_arena_reset(Agentite_Arena *arena) {
+    if (!arena) return;
+
+    size_t used = arena->offset + arena->overflow_used;
+    if (used > arena->high_water) {
+        arena->high_water = used;
+    }
+
+    /* The cycle did not fit: replace the main block with one that would have */
+    if (arena->overflow) {
+        free_overflow(arena);
+
+        size_t new_capacity = arena->capacity;
+        while (new_capacity < used && new_capacity <= SIZE_MAX / 2) {
+            new_capacity *= 2;
+        }
+        unsigned char *base = (unsigned char *)AGENTITE_MALLOC(new_capacity);
+        if (base) {
+            AGENTITE_FREE(arena->base);
+            arena->base = base;
+            arena->capacity = new_capacity;
+            arena->grow_count++;
+        }
+    }
+
+    arena->offset = 0;
+}
+
+void agentite_arena_get_stats(const Agentite_Arena *arena, Agentite_ArenaStats *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!arena) return;
+
+    out->used = arena->offset + arena->overflow_used;
+    out->capacity = arena->capacity;
+    out->high_water = arena->high_water > out->used ? arena->high_water : out->used;
+    out->overflow_blocks = arena->overflow_blocks;
+    out->grow_count = arena->grow_count;
+}
+
+/* ============================================================================
+ * Frame Arena
+ * ============================================================================ */
+
+Agentite_FrameArena *agentite_frame_arena_create(size_t capacity) {
+    Agentite_FrameArena *fa = AGENTITE_ALLOC(Agentite_FrameArena);
+    if (!fa) {
+        agentite_set_error("Failed to allocate frame arena");
+        return NULL;
+    }
+
+    fa->arenas[0] = agentite_arena_create(capacity);
+    fa->arenas[1] = fa->arenas[0] ? agentite_arena_create(capacity) : NULL;
+    if (!fa->arenas[1]) {
+        agentite_frame_arena_destroy(fa);
+        return NULL;
+    }
+    return fa;
+}
+
+void agentite_frame_arena_destroy(Agentite_FrameArena *fa) {
+    if (!fa) return;
+    agentite_arena_destroy(fa->arenas[0]);
+    agentite_arena_destroy(fa->arenas[1]);
+    AGENTITE_FREE(fa);
+}
+
+Agentite_Arena *agentite_frame_arena_current(const Agentite_FrameArena *fa) {
+    return fa ? fa->arenas[fa->current] : NULL;
+}
+
+Agentite_Arena *agentite_frame_arena_previous(const Agentite_FrameArena *fa) {
+    return fa ? fa->arenas[fa->current ^ 1] : NULL;
+}
+
+void agentite_frame_arena_swap(Agentite_FrameArena *fa) {
+    if (!fa) return;
+    fa->current ^= 1;
+    agentite_arena_reset(fa->arenas[fa->current]);
+}
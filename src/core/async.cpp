@@ -10,6 +10,7 @@
 #include "agentite/sprite.h"
 #include "agentite/audio.h"
 #include "agentite/error.h"
+#include "agentite/profiler.h"
 
 #include <SDL3/SDL.h>
 #include <stdlib.h>
@@ -151,6 +152,7 @@ struct Agentite_AsyncLoader {
     SDL_Thread **threads;
     int thread_count;
     std::atomic<bool> shutdown;
+    std::atomic<Agentite_Profiler *> profiler;  /* Optional worker tracing */
 
     /* Task pool (pre-allocated task slots) */
     LoadTask *task_pool;
@@ -501,6 +503,7 @@ static void load_music_background(LoadTask *task) {
 /* Worker thread main function */
 static int worker_thread_func(void *data) {
     Agentite_AsyncLoader *loader = (Agentite_AsyncLoader *)data;
+    Agentite_Profiler *named_for = NULL;
 
     while (!loader->shutdown.load()) {
         LoadTask *task = dequeue_work(loader);
@@ -513,18 +516,28 @@ static int worker_thread_func(void *data) {
             continue;
         }
 
+        Agentite_Profiler *profiler = loader->profiler.load(std::memory_order_acquire);
+        if (profiler && profiler != named_for) {
+            agentite_profiler_trace_set_thread_name(profiler, "async_worker");
+            named_for = profiler;
+        }
+
         /* Perform I/O based on task type */
         switch (task->type) {
             case LOAD_TASK_TEXTURE:
+                agentite_profiler_trace_begin(profiler, "async_load_texture");
                 load_texture_background(task);
                 break;
             case LOAD_TASK_SOUND:
+                agentite_profiler_trace_begin(profiler, "async_load_sound");
                 load_sound_background(task);
                 break;
             case LOAD_TASK_MUSIC:
+                agentite_profiler_trace_begin(profiler, "async_load_music");
                 load_music_background(task);
                 break;
         }
+        agentite_profiler_trace_end(profiler);
 
         /* Move to loaded queue for main thread processing */
         loader->pending_count.fetch_sub(1);
@@ -788,6 +801,13 @@ void agentite_async_loader_destroy(Agentite_AsyncLoader *loader) {
     free(loader);
 }
 
+void agentite_async_loader_set_profiler(Agentite_AsyncLoader *loader,
+                                        Agentite_Profiler *profiler) {
+    if (loader) {
+        loader->profiler.store(profiler, std::memory_order_release);
+    }
+}
+
 void agentite_async_loader_update(Agentite_AsyncLoader *loader) {
     if (!loader) return;
 
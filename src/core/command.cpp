@@ -4,6 +4,7 @@
  * Validated, atomic command execution for player actions.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_COMMAND
 #include "agentite/agentite.h"
 #include "agentite/command.h"
 #include "agentite/error.h"
@@ -12,6 +13,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <atomic>
+#include <mutex>
 
 /*============================================================================
  * Internal Structures
@@ -25,9 +28,43 @@ typedef struct CommandType {
     char name[AGENTITE_COMMAND_MAX_PARAM_KEY];
     Agentite_CommandValidator validator;
     Agentite_CommandExecutor executor;
+    Agentite_CommandAccessFn access;    /* NULL = always validated alone */
     bool registered;
 } CommandType;
 
+/* Resources written by the run being built; sized for a full queue at half load */
+#define COMMAND_WRITE_SET_SIZE (AGENTITE_COMMAND_MAX_QUEUE * AGENTITE_COMMAND_MAX_ACCESS * 2)
+
+/**
+ * Write-set slot. Valid only while run matches the system's run_id, so a
+ * new run starts without clearing the table.
+ */
+typedef struct WriteSetSlot {
+    Agentite_CommandResource key;
+    uint32_t run;
+} WriteSetSlot;
+
+/**
+ * Pool slot: a command while acquired, a free-list link otherwise.
+ */
+typedef union CommandSlot {
+    union CommandSlot *next_free;
+    Agentite_Command cmd;
+} CommandSlot;
+
+typedef struct CommandChunk {
+    struct CommandChunk *next;
+    CommandSlot slots[AGENTITE_COMMAND_POOL_CHUNK];
+} CommandChunk;
+
+struct Agentite_CommandPool {
+    CommandChunk *chunks;
+    CommandSlot *free_list;
+    int live;
+    int capacity;
+    int chunk_count;
+};
+
 /**
  * Command system.
  */
@@ -36,6 +73,9 @@ struct Agentite_CommandSystem {
     CommandType types[AGENTITE_COMMAND_MAX_TYPES];
     int type_count;
 
+    /* Storage for queued commands and history entries */
+    Agentite_CommandPool *pool;
+
     /* Command queue */
     Agentite_Command *queue[AGENTITE_COMMAND_MAX_QUEUE];
     int queue_count;
@@ -53,6 +93,10 @@ struct Agentite_CommandSystem {
 
     /* Statistics */
     Agentite_CommandStats stats;
+
+    /* Batched execution */
+    WriteSetSlot write_set[COMMAND_WRITE_SET_SIZE];
+    uint32_t run_id;
 };
 
 /*============================================================================
@@ -68,58 +112,176 @@ static CommandType *find_type(Agentite_CommandSystem *sys, int type) {
     return NULL;
 }
 
-static Agentite_CommandParam *find_param(Agentite_Command *cmd, const char *key) {
-    for (int i = 0; i < cmd->param_count; i++) {
-        if (strcmp(cmd->params[i].key, key) == 0) {
-            return &cmd->params[i];
+/*============================================================================
+ * Key Interning
+ *
+ * Process-wide table shared by every command. Names are written before
+ * their slot is published, so lookups of existing keys need no lock.
+ *============================================================================*/
+
+#define KEY_TABLE_SIZE (AGENTITE_COMMAND_MAX_KEYS * 2)   /* Power of two */
+
+static char s_key_names[AGENTITE_COMMAND_MAX_KEYS + 1][AGENTITE_COMMAND_MAX_PARAM_KEY];
+static std::atomic<uint32_t> s_key_slots[KEY_TABLE_SIZE];  /* Key per slot, 0 = empty */
+static uint32_t s_key_count = 0;
+static std::mutex s_key_mutex;
+
+static uint32_t hash_key(const char *name, size_t len) {
+    uint32_t h = 2166136261u;  /* FNV-1a */
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)name[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static size_t key_length(const char *name) {
+    size_t len = 0;
+    while (len < AGENTITE_COMMAND_MAX_PARAM_KEY - 1 && name[len]) len++;
+    return len;
+}
+
+/* Existing key for name, or 0; *slot receives the first empty slot probed */
+static Agentite_CommandKey probe_key(const char *name, size_t len, uint32_t *slot) {
+    uint32_t i = hash_key(name, len) & (KEY_TABLE_SIZE - 1);
+    for (;; i = (i + 1) & (KEY_TABLE_SIZE - 1)) {
+        uint32_t key = s_key_slots[i].load(std::memory_order_acquire);
+        if (key == 0) {
+            if (slot) *slot = i;
+            return 0;
+        }
+        if (strncmp(s_key_names[key], name, len) == 0 && s_key_names[key][len] == '\0') {
+            return key;
         }
     }
-    return NULL;
 }
 
-static const Agentite_CommandParam *find_param_const(const Agentite_Command *cmd, const char *key) {
+/* Key for name if already interned (never inserts) */
+static Agentite_CommandKey lookup_key(const char *name) {
+    return probe_key(name, key_length(name), NULL);
+}
+
+Agentite_CommandKey agentite_command_key(const char *name) {
+    if (!name || !name[0]) return 0;
+
+    size_t len = key_length(name);
+    Agentite_CommandKey key = probe_key(name, len, NULL);
+    if (key) return key;
+
+    std::lock_guard<std::mutex> lock(s_key_mutex);
+    uint32_t slot = 0;
+    key = probe_key(name, len, &slot);  /* Another thread may have added it */
+    if (key) return key;
+
+    if (s_key_count >= AGENTITE_COMMAND_MAX_KEYS) {
+        agentite_set_error("agentite_command_key: more than %d distinct keys",
+                           AGENTITE_COMMAND_MAX_KEYS);
+        return 0;
+    }
+    key = ++s_key_count;
+    memcpy(s_key_names[key], name, len);
+    s_key_names[key][len] = '\0';
+    s_key_slots[slot].store(key, std::memory_order_release);
+    return key;
+}
+
+const char *agentite_command_key_name(Agentite_CommandKey key) {
+    if (key == 0 || key > AGENTITE_COMMAND_MAX_KEYS || !s_key_names[key][0]) {
+        return NULL;
+    }
+    return s_key_names[key];
+}
+
+/*============================================================================
+ * Parameter Lookup
+ *============================================================================*/
+
+/*
+ * Params filled in by hand (or by older replay code) may carry only the key
+ * string; those are matched by name and adopt the key on their next write.
+ */
+static const Agentite_CommandParam *find_param_const(const Agentite_Command *cmd,
+                                                     Agentite_CommandKey key) {
+    if (key == 0 || key > AGENTITE_COMMAND_MAX_KEYS) return NULL;
     for (int i = 0; i < cmd->param_count; i++) {
-        if (strcmp(cmd->params[i].key, key) == 0) {
-            return &cmd->params[i];
+        const Agentite_CommandParam *param = &cmd->params[i];
+        if (param->key_id == key) {
+            return param;
+        }
+        if (param->key_id == 0 && param->key[0] &&
+            strcmp(param->key, s_key_names[key]) == 0) {
+            return param;
         }
     }
     return NULL;
 }
 
-static Agentite_CommandParam *get_or_create_param(Agentite_Command *cmd, const char *key) {
-    Agentite_CommandParam *param = find_param(cmd, key);
-    if (param) return param;
+static Agentite_CommandParam *get_or_create_param(Agentite_Command *cmd, Agentite_CommandKey key) {
+    if (key == 0 || key > AGENTITE_COMMAND_MAX_KEYS) return NULL;
+
+    Agentite_CommandParam *param = (Agentite_CommandParam *)find_param_const(cmd, key);
+    if (param) {
+        param->key_id = key;
+        return param;
+    }
 
     if (cmd->param_count >= AGENTITE_COMMAND_MAX_PARAMS) {
         return NULL;
     }
 
     param = &cmd->params[cmd->param_count];
-    memset(param, 0, sizeof(*param));
-    strncpy(param->key, key, AGENTITE_COMMAND_MAX_PARAM_KEY - 1);
+    memcpy(param->key, s_key_names[key], AGENTITE_COMMAND_MAX_PARAM_KEY);
+    param->key_id = key;
     cmd->param_count++;
     return param;
 }
 
+/*============================================================================
+ * Pool Helpers
+ *============================================================================*/
+
+static bool pool_grow(Agentite_CommandPool *pool) {
+    CommandChunk *chunk = AGENTITE_MALLOC_ARRAY(CommandChunk, 1);
+    if (!chunk) {
+        agentite_set_error("agentite_command_pool: allocation failed");
+        return false;
+    }
+
+    /* Thread the new slots onto the free list in address order */
+    for (int i = AGENTITE_COMMAND_POOL_CHUNK - 1; i >= 0; i--) {
+        chunk->slots[i].next_free = pool->free_list;
+        pool->free_list = &chunk->slots[i];
+    }
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->capacity += AGENTITE_COMMAND_POOL_CHUNK;
+    pool->chunk_count++;
+    return true;
+}
+
+/* Pooled copy of cmd, for the queue and history */
+static Agentite_Command *pool_copy(Agentite_CommandPool *pool, const Agentite_Command *cmd) {
+    Agentite_Command *copy = agentite_command_pool_acquire(pool, cmd->type, cmd->source_faction);
+    if (copy) {
+        memcpy(copy, cmd, sizeof(Agentite_Command));
+    }
+    return copy;
+}
+
 static void add_to_history(Agentite_CommandSystem *sys, const Agentite_Command *cmd) {
     if (sys->history_max <= 0) return;
 
-    /* Clone command */
-    Agentite_Command *clone = agentite_command_clone(cmd);
-    if (!clone) return;
-
     /* Circular buffer insertion */
     if (sys->history_count < sys->history_max) {
         /* Not full yet, append */
-        sys->history[sys->history_count] = clone;
+        Agentite_Command *copy = pool_copy(sys->pool, cmd);
+        if (!copy) return;
+        sys->history[sys->history_count] = copy;
         sys->history_count++;
     } else {
-        /* Full, overwrite oldest */
+        /* Full, overwrite oldest in place */
         int oldest = (sys->history_head + sys->history_count) % sys->history_max;
-        if (sys->history[oldest]) {
-            agentite_command_free(sys->history[oldest]);
-        }
-        sys->history[oldest] = clone;
+        memcpy(sys->history[oldest], cmd, sizeof(Agentite_Command));
         sys->history_head = (sys->history_head + 1) % sys->history_max;
     }
 }
@@ -131,6 +293,41 @@ static void notify_callback(Agentite_CommandSystem *sys, const Agentite_Command
     }
 }
 
+/**
+ * Second half of execution, once the validator has run: a rejected
+ * command is reported, a valid one executes and updates stats and history.
+ */
+static void finish_command(Agentite_CommandSystem *sys, CommandType *ct,
+                           const Agentite_Command *cmd, void *game_state,
+                           bool valid, Agentite_CommandResult *result) {
+    if (!valid) {
+        result->success = false;
+        sys->stats.total_invalid++;
+        notify_callback(sys, cmd, result);
+        return;
+    }
+
+    result->success = ct->executor(cmd, game_state);
+    sys->stats.total_executed++;
+
+    if (result->success) {
+        sys->stats.total_succeeded++;
+        /* Track per-type stats */
+        if (cmd->type >= 0 && cmd->type < AGENTITE_COMMAND_MAX_TYPES) {
+            sys->stats.commands_by_type[cmd->type]++;
+        }
+        /* Add to history */
+        add_to_history(sys, cmd);
+    } else {
+        sys->stats.total_failed++;
+        if (result->error[0] == '\0') {
+            snprintf(result->error, sizeof(result->error), "Execution failed");
+        }
+    }
+
+    notify_callback(sys, cmd, result);
+}
+
 /*============================================================================
  * Lifecycle
  *============================================================================*/
@@ -142,6 +339,12 @@ Agentite_CommandSystem *agentite_command_create(void) {
         return NULL;
     }
 
+    sys->pool = agentite_command_pool_create(AGENTITE_COMMAND_POOL_CHUNK);
+    if (!sys->pool) {
+        AGENTITE_FREE(sys);
+        return NULL;
+    }
+
     sys->type_count = 0;
     sys->queue_count = 0;
     sys->next_sequence = 1;
@@ -158,20 +361,9 @@ Agentite_CommandSystem *agentite_command_create(void) {
 void agentite_command_destroy(Agentite_CommandSystem *sys) {
     if (!sys) return;
 
-    /* Free queued commands */
-    for (int i = 0; i < sys->queue_count; i++) {
-        agentite_command_free(sys->queue[i]);
-    }
-
-    /* Free history */
-    for (int i = 0; i < sys->history_count; i++) {
-        int idx = (sys->history_head + i) % sys->history_max;
-        if (sys->history[idx]) {
-            agentite_command_free(sys->history[idx]);
-        }
-    }
-
-    free(sys);
+    /* Queued commands and history live in the pool */
+    agentite_command_pool_destroy(sys->pool);
+    AGENTITE_FREE(sys);
 }
 
 /*============================================================================
@@ -232,6 +424,20 @@ const char *agentite_command_get_type_name(const Agentite_CommandSystem *sys, in
     return ct ? ct->name : NULL;
 }
 
+bool agentite_command_set_access(Agentite_CommandSystem *sys,
+                                 int type,
+                                 Agentite_CommandAccessFn access) {
+    AGENTITE_VALIDATE_PTR_RET(sys, false);
+
+    CommandType *ct = find_type(sys, type);
+    if (!ct) {
+        agentite_set_error("agentite_command_set_access: type %d not registered", type);
+        return false;
+    }
+    ct->access = access;
+    return true;
+}
+
 /*============================================================================
  * Command Creation
  *============================================================================*/
@@ -247,11 +453,35 @@ Agentite_Command *agentite_command_new_ex(int type, int32_t faction) {
         return NULL;
     }
 
+    agentite_command_init(cmd, type, faction);
+    return cmd;
+}
+
+void agentite_command_init(Agentite_Command *cmd, int type, int32_t faction) {
+    AGENTITE_VALIDATE_PTR(cmd);
+
     cmd->type = type;
     cmd->param_count = 0;
     cmd->sequence = 0;  /* Set when queued */
     cmd->source_faction = faction;
     cmd->userdata = NULL;
+}
+
+Agentite_Command *agentite_command_new_frame(int type, Agentite_Arena *arena) {
+    return agentite_command_new_frame_ex(type, -1, arena);
+}
+
+Agentite_Command *agentite_command_new_frame_ex(int type, int32_t faction, Agentite_Arena *arena) {
+    AGENTITE_VALIDATE_PTR_RET(arena, NULL);
+
+    Agentite_Command *cmd = AGENTITE_ARENA_ALLOC(arena, Agentite_Command);
+    if (!cmd) {
+        agentite_set_error("agentite_command_new_frame: arena allocation failed");
+        return NULL;
+    }
+
+    cmd->type = type;
+    cmd->source_faction = faction;
 
     return cmd;
 }
@@ -271,16 +501,84 @@ Agentite_Command *agentite_command_clone(const Agentite_Command *cmd) {
 }
 
 void agentite_command_free(Agentite_Command *cmd) {
-    free(cmd);
+    AGENTITE_FREE(cmd);
+}
+
+/*============================================================================
+ * Command Pool
+ *============================================================================*/
+
+Agentite_CommandPool *agentite_command_pool_create(int initial_capacity) {
+    Agentite_CommandPool *pool = AGENTITE_ALLOC(Agentite_CommandPool);
+    if (!pool) {
+        agentite_set_error("agentite_command_pool_create: allocation failed");
+        return NULL;
+    }
+
+    while (pool->capacity < initial_capacity) {
+        if (!pool_grow(pool)) {
+            agentite_command_pool_destroy(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void agentite_command_pool_destroy(Agentite_CommandPool *pool) {
+    if (!pool) return;
+
+    CommandChunk *chunk = pool->chunks;
+    while (chunk) {
+        CommandChunk *next = chunk->next;
+        AGENTITE_FREE(chunk);
+        chunk = next;
+    }
+    AGENTITE_FREE(pool);
+}
+
+Agentite_Command *agentite_command_pool_acquire(Agentite_CommandPool *pool, int type,
+                                                int32_t faction) {
+    AGENTITE_VALIDATE_PTR_RET(pool, NULL);
+
+    if (!pool->free_list && !pool_grow(pool)) {
+        return NULL;
+    }
+
+    CommandSlot *slot = pool->free_list;
+    pool->free_list = slot->next_free;
+    pool->live++;
+
+    agentite_command_init(&slot->cmd, type, faction);
+    return &slot->cmd;
+}
+
+void agentite_command_pool_release(Agentite_CommandPool *pool, Agentite_Command *cmd) {
+    AGENTITE_VALIDATE_PTR(pool);
+    if (!cmd) return;
+
+    CommandSlot *slot = (CommandSlot *)cmd;
+    slot->next_free = pool->free_list;
+    pool->free_list = slot;
+    pool->live--;
+}
+
+void agentite_command_pool_get_stats(const Agentite_CommandPool *pool,
+                                     Agentite_CommandPoolStats *out) {
+    AGENTITE_VALIDATE_PTR(out);
+    memset(out, 0, sizeof(*out));
+    AGENTITE_VALIDATE_PTR(pool);
+
+    out->live = pool->live;
+    out->capacity = pool->capacity;
+    out->chunk_count = pool->chunk_count;
 }
 
 /*============================================================================
  * Command Parameters - Setters
  *============================================================================*/
 
-void agentite_command_set_int(Agentite_Command *cmd, const char *key, int32_t value) {
+void agentite_command_set_int_id(Agentite_Command *cmd, Agentite_CommandKey key, int32_t value) {
     AGENTITE_VALIDATE_PTR(cmd);
-    AGENTITE_VALIDATE_PTR(key);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
@@ -289,9 +587,14 @@ void agentite_command_set_int(Agentite_Command *cmd, const char *key, int32_t va
     }
 }
 
-void agentite_command_set_int64(Agentite_Command *cmd, const char *key, int64_t value) {
+void agentite_command_set_int(Agentite_Command *cmd, const char *key, int32_t value) {
     AGENTITE_VALIDATE_PTR(cmd);
     AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_int_id(cmd, agentite_command_key(key), value);
+}
+
+void agentite_command_set_int64_id(Agentite_Command *cmd, Agentite_CommandKey key, int64_t value) {
+    AGENTITE_VALIDATE_PTR(cmd);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
@@ -300,9 +603,14 @@ void agentite_command_set_int64(Agentite_Command *cmd, const char *key, int64_t
     }
 }
 
-void agentite_command_set_float(Agentite_Command *cmd, const char *key, float value) {
+void agentite_command_set_int64(Agentite_Command *cmd, const char *key, int64_t value) {
     AGENTITE_VALIDATE_PTR(cmd);
     AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_int64_id(cmd, agentite_command_key(key), value);
+}
+
+void agentite_command_set_float_id(Agentite_Command *cmd, Agentite_CommandKey key, float value) {
+    AGENTITE_VALIDATE_PTR(cmd);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
@@ -311,9 +619,14 @@ void agentite_command_set_float(Agentite_Command *cmd, const char *key, float va
     }
 }
 
-void agentite_command_set_double(Agentite_Command *cmd, const char *key, double value) {
+void agentite_command_set_float(Agentite_Command *cmd, const char *key, float value) {
     AGENTITE_VALIDATE_PTR(cmd);
     AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_float_id(cmd, agentite_command_key(key), value);
+}
+
+void agentite_command_set_double_id(Agentite_Command *cmd, Agentite_CommandKey key, double value) {
+    AGENTITE_VALIDATE_PTR(cmd);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
@@ -322,9 +635,14 @@ void agentite_command_set_double(Agentite_Command *cmd, const char *key, double
     }
 }
 
-void agentite_command_set_bool(Agentite_Command *cmd, const char *key, bool value) {
+void agentite_command_set_double(Agentite_Command *cmd, const char *key, double value) {
     AGENTITE_VALIDATE_PTR(cmd);
     AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_double_id(cmd, agentite_command_key(key), value);
+}
+
+void agentite_command_set_bool_id(Agentite_Command *cmd, Agentite_CommandKey key, bool value) {
+    AGENTITE_VALIDATE_PTR(cmd);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
@@ -333,9 +651,14 @@ void agentite_command_set_bool(Agentite_Command *cmd, const char *key, bool valu
     }
 }
 
-void agentite_command_set_entity(Agentite_Command *cmd, const char *key, uint32_t entity) {
+void agentite_command_set_bool(Agentite_Command *cmd, const char *key, bool value) {
     AGENTITE_VALIDATE_PTR(cmd);
     AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_bool_id(cmd, agentite_command_key(key), value);
+}
+
+void agentite_command_set_entity_id(Agentite_Command *cmd, Agentite_CommandKey key, uint32_t entity) {
+    AGENTITE_VALIDATE_PTR(cmd);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
@@ -344,24 +667,35 @@ void agentite_command_set_entity(Agentite_Command *cmd, const char *key, uint32_
     }
 }
 
-void agentite_command_set_string(Agentite_Command *cmd, const char *key, const char *value) {
+void agentite_command_set_entity(Agentite_Command *cmd, const char *key, uint32_t entity) {
     AGENTITE_VALIDATE_PTR(cmd);
     AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_entity_id(cmd, agentite_command_key(key), entity);
+}
+
+void agentite_command_set_string_id(Agentite_Command *cmd, Agentite_CommandKey key, const char *value) {
+    AGENTITE_VALIDATE_PTR(cmd);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
         param->type = AGENTITE_CMD_PARAM_STRING;
         if (value) {
             strncpy(param->str, value, AGENTITE_COMMAND_MAX_PARAM_KEY - 1);
+            param->str[AGENTITE_COMMAND_MAX_PARAM_KEY - 1] = '\0';
         } else {
             param->str[0] = '\0';
         }
     }
 }
 
-void agentite_command_set_ptr(Agentite_Command *cmd, const char *key, void *ptr) {
+void agentite_command_set_string(Agentite_Command *cmd, const char *key, const char *value) {
     AGENTITE_VALIDATE_PTR(cmd);
     AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_string_id(cmd, agentite_command_key(key), value);
+}
+
+void agentite_command_set_ptr_id(Agentite_Command *cmd, Agentite_CommandKey key, void *ptr) {
+    AGENTITE_VALIDATE_PTR(cmd);
 
     Agentite_CommandParam *param = get_or_create_param(cmd, key);
     if (param) {
@@ -370,21 +704,32 @@ void agentite_command_set_ptr(Agentite_Command *cmd, const char *key, void *ptr)
     }
 }
 
+void agentite_command_set_ptr(Agentite_Command *cmd, const char *key, void *ptr) {
+    AGENTITE_VALIDATE_PTR(cmd);
+    AGENTITE_VALIDATE_PTR(key);
+    agentite_command_set_ptr_id(cmd, agentite_command_key(key), ptr);
+}
+
 /*============================================================================
  * Command Parameters - Getters
  *============================================================================*/
 
+bool agentite_command_has_param_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
+    AGENTITE_VALIDATE_PTR_RET(cmd, false);
+    return find_param_const(cmd, key) != NULL;
+}
+
 bool agentite_command_has_param(const Agentite_Command *cmd, const char *key) {
     AGENTITE_VALIDATE_PTR_RET(cmd, false);
     AGENTITE_VALIDATE_PTR_RET(key, false);
-    return find_param_const(cmd, key) != NULL;
+    return find_param_const(cmd, lookup_key(key)) != NULL;
 }
 
 Agentite_CommandParamType agentite_command_get_param_type(const Agentite_Command *cmd, const char *key) {
     AGENTITE_VALIDATE_PTR_RET(cmd, AGENTITE_CMD_PARAM_NONE);
     AGENTITE_VALIDATE_PTR_RET(key, AGENTITE_CMD_PARAM_NONE);
 
-    const Agentite_CommandParam *param = find_param_const(cmd, key);
+    const Agentite_CommandParam *param = find_param_const(cmd, lookup_key(key));
     return param ? param->type : AGENTITE_CMD_PARAM_NONE;
 }
 
@@ -396,16 +741,40 @@ int32_t agentite_command_get_int_or(const Agentite_Command *cmd, const char *key
     AGENTITE_VALIDATE_PTR_RET(cmd, def);
     AGENTITE_VALIDATE_PTR_RET(key, def);
 
-    const Agentite_CommandParam *param = find_param_const(cmd, key);
+    const Agentite_CommandParam *param = find_param_const(cmd, lookup_key(key));
     if (param && param->type == AGENTITE_CMD_PARAM_INT) {
         return param->i32;
     }
     return def;
 }
 
-int64_t agentite_command_get_int64(const Agentite_Command *cmd, const char *key) {
+float agentite_command_get_float(const Agentite_Command *cmd, const char *key) {
+    return agentite_command_get_float_or(cmd, key, 0.0f);
+}
+
+float agentite_command_get_float_or(const Agentite_Command *cmd, const char *key, float def) {
+    AGENTITE_VALIDATE_PTR_RET(cmd, def);
+    AGENTITE_VALIDATE_PTR_RET(key, def);
+
+    const Agentite_CommandParam *param = find_param_const(cmd, lookup_key(key));
+    if (param && param->type == AGENTITE_CMD_PARAM_FLOAT) {
+        return param->f32;
+    }
+    return def;
+}
+
+int32_t agentite_command_get_int_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
+    AGENTITE_VALIDATE_PTR_RET(cmd, 0);
+
+    const Agentite_CommandParam *param = find_param_const(cmd, key);
+    if (param && param->type == AGENTITE_CMD_PARAM_INT) {
+        return param->i32;
+    }
+    return 0;
+}
+
+int64_t agentite_command_get_int64_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
     AGENTITE_VALIDATE_PTR_RET(cmd, 0);
-    AGENTITE_VALIDATE_PTR_RET(key, 0);
 
     const Agentite_CommandParam *param = find_param_const(cmd, key);
     if (param && param->type == AGENTITE_CMD_PARAM_INT64) {
@@ -414,24 +783,23 @@ int64_t agentite_command_get_int64(const Agentite_Command *cmd, const char *key)
     return 0;
 }
 
-float agentite_command_get_float(const Agentite_Command *cmd, const char *key) {
-    return agentite_command_get_float_or(cmd, key, 0.0f);
+int64_t agentite_command_get_int64(const Agentite_Command *cmd, const char *key) {
+    AGENTITE_VALIDATE_PTR_RET(key, 0);
+    return agentite_command_get_int64_id(cmd, lookup_key(key));
 }
 
-float agentite_command_get_float_or(const Agentite_Command *cmd, const char *key, float def) {
-    AGENTITE_VALIDATE_PTR_RET(cmd, def);
-    AGENTITE_VALIDATE_PTR_RET(key, def);
+float agentite_command_get_float_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
+    AGENTITE_VALIDATE_PTR_RET(cmd, 0.0f);
 
     const Agentite_CommandParam *param = find_param_const(cmd, key);
     if (param && param->type == AGENTITE_CMD_PARAM_FLOAT) {
         return param->f32;
     }
-    return def;
+    return 0.0f;
 }
 
-double agentite_command_get_double(const Agentite_Command *cmd, const char *key) {
+double agentite_command_get_double_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
     AGENTITE_VALIDATE_PTR_RET(cmd, 0.0);
-    AGENTITE_VALIDATE_PTR_RET(key, 0.0);
 
     const Agentite_CommandParam *param = find_param_const(cmd, key);
     if (param && param->type == AGENTITE_CMD_PARAM_DOUBLE) {
@@ -440,9 +808,13 @@ double agentite_command_get_double(const Agentite_Command *cmd, const char *key)
     return 0.0;
 }
 
-bool agentite_command_get_bool(const Agentite_Command *cmd, const char *key) {
+double agentite_command_get_double(const Agentite_Command *cmd, const char *key) {
+    AGENTITE_VALIDATE_PTR_RET(key, 0.0);
+    return agentite_command_get_double_id(cmd, lookup_key(key));
+}
+
+bool agentite_command_get_bool_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
     AGENTITE_VALIDATE_PTR_RET(cmd, false);
-    AGENTITE_VALIDATE_PTR_RET(key, false);
 
     const Agentite_CommandParam *param = find_param_const(cmd, key);
     if (param && param->type == AGENTITE_CMD_PARAM_BOOL) {
@@ -451,9 +823,13 @@ bool agentite_command_get_bool(const Agentite_Command *cmd, const char *key) {
     return false;
 }
 
-uint32_t agentite_command_get_entity(const Agentite_Command *cmd, const char *key) {
+bool agentite_command_get_bool(const Agentite_Command *cmd, const char *key) {
+    AGENTITE_VALIDATE_PTR_RET(key, false);
+    return agentite_command_get_bool_id(cmd, lookup_key(key));
+}
+
+uint32_t agentite_command_get_entity_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
     AGENTITE_VALIDATE_PTR_RET(cmd, 0);
-    AGENTITE_VALIDATE_PTR_RET(key, 0);
 
     const Agentite_CommandParam *param = find_param_const(cmd, key);
     if (param && param->type == AGENTITE_CMD_PARAM_ENTITY) {
@@ -462,9 +838,13 @@ uint32_t agentite_command_get_entity(const Agentite_Command *cmd, const char *ke
     return 0;
 }
 
-const char *agentite_command_get_string(const Agentite_Command *cmd, const char *key) {
+uint32_t agentite_command_get_entity(const Agentite_Command *cmd, const char *key) {
+    AGENTITE_VALIDATE_PTR_RET(key, 0);
+    return agentite_command_get_entity_id(cmd, lookup_key(key));
+}
+
+const char *agentite_command_get_string_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
     AGENTITE_VALIDATE_PTR_RET(cmd, NULL);
-    AGENTITE_VALIDATE_PTR_RET(key, NULL);
 
     const Agentite_CommandParam *param = find_param_const(cmd, key);
     if (param && param->type == AGENTITE_CMD_PARAM_STRING) {
@@ -473,9 +853,13 @@ const char *agentite_command_get_string(const Agentite_Command *cmd, const char
     return NULL;
 }
 
-void *agentite_command_get_ptr(const Agentite_Command *cmd, const char *key) {
-    AGENTITE_VALIDATE_PTR_RET(cmd, NULL);
+const char *agentite_command_get_string(const Agentite_Command *cmd, const char *key) {
     AGENTITE_VALIDATE_PTR_RET(key, NULL);
+    return agentite_command_get_string_id(cmd, lookup_key(key));
+}
+
+void *agentite_command_get_ptr_id(const Agentite_Command *cmd, Agentite_CommandKey key) {
+    AGENTITE_VALIDATE_PTR_RET(cmd, NULL);
 
     const Agentite_CommandParam *param = find_param_const(cmd, key);
     if (param && param->type == AGENTITE_CMD_PARAM_PTR) {
@@ -484,6 +868,11 @@ void *agentite_command_get_ptr(const Agentite_Command *cmd, const char *key) {
     return NULL;
 }
 
+void *agentite_command_get_ptr(const Agentite_Command *cmd, const char *key) {
+    AGENTITE_VALIDATE_PTR_RET(key, NULL);
+    return agentite_command_get_ptr_id(cmd, lookup_key(key));
+}
+
 /*============================================================================
  * Validation
  *============================================================================*/
@@ -535,14 +924,13 @@ bool agentite_command_queue(Agentite_CommandSystem *sys, Agentite_Command *cmd)
         return false;
     }
 
-    /* Clone command */
-    Agentite_Command *clone = agentite_command_clone(cmd);
-    if (!clone) {
+    Agentite_Command *copy = pool_copy(sys->pool, cmd);
+    if (!copy) {
         return false;
     }
 
-    clone->sequence = sys->next_sequence++;
-    sys->queue[sys->queue_count] = clone;
+    copy->sequence = sys->next_sequence++;
+    sys->queue[sys->queue_count] = copy;
     sys->queue_count++;
 
     return true;
@@ -570,7 +958,7 @@ void agentite_command_queue_clear(Agentite_CommandSystem *sys) {
     AGENTITE_VALIDATE_PTR(sys);
 
     for (int i = 0; i < sys->queue_count; i++) {
-        agentite_command_free(sys->queue[i]);
+        agentite_command_pool_release(sys->pool, sys->queue[i]);
         sys->queue[i] = NULL;
     }
     sys->queue_count = 0;
@@ -592,7 +980,7 @@ bool agentite_command_queue_remove(Agentite_CommandSystem *sys, int index) {
         return false;
     }
 
-    agentite_command_free(sys->queue[index]);
+    agentite_command_pool_release(sys->pool, sys->queue[index]);
 
     /* Shift remaining */
     for (int i = index; i < sys->queue_count - 1; i++) {
@@ -647,36 +1035,10 @@ Agentite_CommandResult agentite_command_execute(Agentite_CommandSystem *sys,
         return result;
     }
 
-    /* Validate first */
-    if (ct->validator) {
-        if (!ct->validator(cmd, game_state, result.error, sizeof(result.error))) {
-            result.success = false;
-            sys->stats.total_invalid++;
-            notify_callback(sys, cmd, &result);
-            return result;
-        }
-    }
-
-    /* Execute */
-    result.success = ct->executor(cmd, game_state);
-    sys->stats.total_executed++;
-
-    if (result.success) {
-        sys->stats.total_succeeded++;
-        /* Track per-type stats */
-        if (cmd->type >= 0 && cmd->type < AGENTITE_COMMAND_MAX_TYPES) {
-            sys->stats.commands_by_type[cmd->type]++;
-        }
-        /* Add to history */
-        add_to_history(sys, cmd);
-    } else {
-        sys->stats.total_failed++;
-        if (result.error[0] == '\0') {
-            snprintf(result.error, sizeof(result.error), "Execution failed");
-        }
-    }
-
-    notify_callback(sys, cmd, &result);
+    /* Validate first, then execute */
+    bool valid = !ct->validator ||
+                 ct->validator(cmd, game_state, result.error, sizeof(result.error));
+    finish_command(sys, ct, cmd, game_state, valid, &result);
 
     return result;
 }
@@ -703,12 +1065,169 @@ Agentite_CommandResult agentite_command_execute_next(Agentite_CommandSystem *sys
     /* Execute */
     result = agentite_command_execute(sys, cmd, game_state);
 
-    /* Free command */
-    agentite_command_free(cmd);
+    /* Return command to the pool */
+    agentite_command_pool_release(sys->pool, cmd);
 
     return result;
 }
 
+Agentite_CommandResult agentite_command_submit_inline(Agentite_CommandSystem *sys,
+                                                    Agentite_Command *cmd,
+                                                    void *game_state) {
+    Agentite_CommandResult result = {0};
+
+    AGENTITE_VALIDATE_PTR_RET(sys, result);
+    AGENTITE_VALIDATE_PTR_RET(cmd, result);
+
+    cmd->sequence = sys->next_sequence++;
+    return agentite_command_execute(sys, cmd, game_state);
+}
+
+/*============================================================================
+ * Batched Execution
+ *============================================================================*/
+
+static inline uint32_t write_set_hash(Agentite_CommandResource key) {
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (COMMAND_WRITE_SET_SIZE - 1);
+}
+
+static bool write_set_contains(const Agentite_CommandSystem *sys, Agentite_CommandResource key) {
+    for (uint32_t i = write_set_hash(key);; i = (i + 1) & (COMMAND_WRITE_SET_SIZE - 1)) {
+        const WriteSetSlot *slot = &sys->write_set[i];
+        if (slot->run != sys->run_id) return false;
+        if (slot->key == key) return true;
+    }
+}
+
+/* At most MAX_QUEUE * MAX_ACCESS keys per run, so the table never fills */
+static void write_set_insert(Agentite_CommandSystem *sys, Agentite_CommandResource key) {
+    for (uint32_t i = write_set_hash(key);; i = (i + 1) & (COMMAND_WRITE_SET_SIZE - 1)) {
+        WriteSetSlot *slot = &sys->write_set[i];
+        if (slot->run != sys->run_id) {
+            slot->key = key;
+            slot->run = sys->run_id;
+            return;
+        }
+        if (slot->key == key) return;
+    }
+}
+
+static void write_set_begin_run(Agentite_CommandSystem *sys) {
+    if (++sys->run_id == 0) {
+        memset(sys->write_set, 0, sizeof(sys->write_set));
+        sys->run_id = 1;
+    }
+}
+
+/**
+ * Count how many commands from the front of the queue can be validated
+ * together: stops before a command that touches a resource written earlier
+ * in the run, or that cannot describe its access. Always at least 1.
+ */
+static int build_run(Agentite_CommandSystem *sys, void *game_state, int limit) {
+    write_set_begin_run(sys);
+
+    for (int i = 0; i < limit; i++) {
+        const Agentite_Command *cmd = sys->queue[i];
+        CommandType *ct = find_type(sys, cmd->type);
+
+        Agentite_CommandAccess access;
+        memset(&access, 0, sizeof(access));
+        if (!ct || !ct->access || !ct->access(cmd, game_state, &access) || access.overflow) {
+            return i > 0 ? i : 1;
+        }
+
+        for (int r = 0; r < access.read_count; r++) {
+            if (write_set_contains(sys, access.reads[r])) return i;
+        }
+        for (int w = 0; w < access.write_count; w++) {
+            if (write_set_contains(sys, access.writes[w])) return i;
+        }
+        for (int w = 0; w < access.write_count; w++) {
+            write_set_insert(sys, access.writes[w]);
+        }
+    }
+    return limit;
+}
+
+typedef struct ValidateJob {
+    Agentite_Command **cmds;
+    CommandType **types;
+    Agentite_CommandResult *results;
+    bool *valid;
+    void *game_state;
+} ValidateJob;
+
+static void validate_range(void *userdata, int begin, int end) {
+    ValidateJob *job = (ValidateJob *)userdata;
+    for (int i = begin; i < end; i++) {
+        CommandType *ct = job->types[i];
+        Agentite_CommandResult *result = &job->results[i];
+        job->valid[i] = !ct->validator ||
+                        ct->validator(job->cmds[i], job->game_state,
+                                      result->error, sizeof(result->error));
+    }
+}
+
+int agentite_command_execute_batched(Agentite_CommandSystem *sys,
+                                     void *game_state,
+                                     Agentite_JobPool *jobs,
+                                     Agentite_CommandResult *results,
+                                     int max) {
+    AGENTITE_VALIDATE_PTR_RET(sys, 0);
+
+    Agentite_Command *run[AGENTITE_COMMAND_MAX_QUEUE];
+    CommandType *types[AGENTITE_COMMAND_MAX_QUEUE];
+    Agentite_CommandResult run_results[AGENTITE_COMMAND_MAX_QUEUE];
+    bool valid[AGENTITE_COMMAND_MAX_QUEUE];
+    int executed = 0;
+
+    /* Executors may queue more commands; they are picked up by later runs */
+    while (sys->queue_count > 0 && (max <= 0 || executed < max)) {
+        int limit = sys->queue_count;
+        if (max > 0 && max - executed < limit) {
+            limit = max - executed;
+        }
+
+        int n = build_run(sys, game_state, limit);
+        if (n == 1) {
+            Agentite_CommandResult result = agentite_command_execute_next(sys, game_state);
+            if (results && executed < max) {
+                results[executed] = result;
+            }
+            executed++;
+            continue;
+        }
+
+        /* Take the run out of the queue before anything executes */
+        memcpy(run, sys->queue, (size_t)n * sizeof(run[0]));
+        memmove(sys->queue, sys->queue + n, (size_t)(sys->queue_count - n) * sizeof(sys->queue[0]));
+        sys->queue_count -= n;
+
+        for (int i = 0; i < n; i++) {
+            types[i] = find_type(sys, run[i]->type);
+            memset(&run_results[i], 0, sizeof(run_results[i]));
+            run_results[i].command_type = run[i]->type;
+            run_results[i].sequence = run[i]->sequence;
+        }
+
+        ValidateJob job = { run, types, run_results, valid, game_state };
+        agentite_job_parallel_for(jobs, n, 1, validate_range, &job);
+
+        /* Apply in sequence order */
+        for (int i = 0; i < n; i++) {
+            finish_command(sys, types[i], run[i], game_state, valid[i], &run_results[i]);
+            agentite_command_pool_release(sys->pool, run[i]);
+            if (results && executed < max) {
+                results[executed] = run_results[i];
+            }
+            executed++;
+        }
+    }
+
+    return executed;
+}
+
 /*============================================================================
  * Callbacks
  *============================================================================*/
@@ -773,7 +1292,7 @@ void agentite_command_clear_history(Agentite_CommandSystem *sys) {
     for (int i = 0; i < sys->history_count; i++) {
         int idx = (sys->history_head + i) % sys->history_max;
         if (sys->history[idx]) {
-            agentite_command_free(sys->history[idx]);
+            agentite_command_pool_release(sys->pool, sys->history[idx]);
             sys->history[idx] = NULL;
         }
     }
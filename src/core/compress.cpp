@@ -0,0 +1,237 @@
+/**
+ * Agentite Engine - Fast Block Compression
+ *
+ * LZ77 compressor emitting the LZ4 block format:
+ *
+ *   sequence := token [literal-length-ext] literals offset [match-length-ext]
+ *   token    := (literal_length:4 << 4) | (match_length - 4):4
+ *
+ * Lengths of 15 continue in extension bytes (255 = keep reading).
+ * The final sequence carries literals only; the last 5 bytes of a block are
+ * always literals and no match starts within the last 12 bytes.
+ */
+
+#include "agentite/compress.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* ============================================================================
+ * Constants
+ * ============================================================================ */
+
+#define LZ_HASH_BITS 12
+#define LZ_MIN_MATCH 4
+#define LZ_LAST_LITERALS 5
+#define LZ_MFLIMIT 12
+#define LZ_MAX_OFFSET 65535
+#define LZ_RUN_MASK 15
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+static inline uint32_t read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t hash_sequence(uint32_t seq)
+{
+    return (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+/**
+ * Write a length that overflowed its 4-bit token field.
+ */
+static inline uint8_t *write_length_ext(uint8_t *op, size_t len)
+{
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+/**
+ * Emit one sequence. match_len == 0 emits the final literal-only sequence.
+ */
+static uint8_t *emit_sequence(uint8_t *op, const uint8_t *literals, size_t literal_len,
+                              size_t offset, size_t match_len)
+{
+    uint8_t *token = op++;
+    size_t ml = match_len ? match_len - LZ_MIN_MATCH : 0;
+
+    *token = (uint8_t)((literal_len >= LZ_RUN_MASK ? LZ_RUN_MASK : literal_len) << 4);
+    if (literal_len >= LZ_RUN_MASK) {
+        op = write_length_ext(op, literal_len - LZ_RUN_MASK);
+    }
+    memcpy(op, literals, literal_len);
+    op += literal_len;
+
+    if (match_len == 0) {
+        return op;
+    }
+
+    *op++ = (uint8_t)(offset & 0xFF);
+    *op++ = (uint8_t)(offset >> 8);
+
+    *token |= (uint8_t)(ml >= LZ_RUN_MASK ? LZ_RUN_MASK : ml);
+    if (ml >= LZ_RUN_MASK) {
+        op = write_length_ext(op, ml - LZ_RUN_MASK);
+    }
+    return op;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+size_t agentite_lz_compress_bound(size_t src_size)
+{
+    return src_size + src_size / 255 + 16;
+}
+
+size_t agentite_lz_compress(const void *src_ptr, size_t src_size,
+                            void *dst_ptr, size_t dst_capacity)
+{
+    if (!dst_ptr || dst_capacity < agentite_lz_compress_bound(src_size)) {
+        return 0;
+    }
+    if (!src_ptr || src_size == 0) {
+        *(uint8_t *)dst_ptr = 0;  /* Empty literal-only sequence */
+        return 1;
+    }
+
+    const uint8_t *src = (const uint8_t *)src_ptr;
+    const uint8_t *end = src + src_size;
+    const uint8_t *anchor = src;
+    const uint8_t *ip = src;
+    uint8_t *op = (uint8_t *)dst_ptr;
+
+    if (src_size > LZ_MFLIMIT) {
+        const uint8_t *mflimit = end - LZ_MFLIMIT;
+        const uint8_t *match_limit = end - LZ_LAST_LITERALS;
+        uint32_t table[1 << LZ_HASH_BITS];
+        memset(table, 0, sizeof(table));
+
+        while (ip < mflimit) {
+            uint32_t seq = read32(ip);
+            uint32_t h = hash_sequence(seq);
+            const uint8_t *ref = src + table[h];
+            table[h] = (uint32_t)(ip - src);
+
+            if (ref >= ip || (size_t)(ip - ref) > LZ_MAX_OFFSET || read32(ref) != seq) {
+                /* Skip faster through incompressible runs */
+                ip += 1 + ((size_t)(ip - anchor) >> 6);
+                continue;
+            }
+
+            /* Extend the match forwards */
+            const uint8_t *mp = ip + LZ_MIN_MATCH;
+            const uint8_t *rp = ref + LZ_MIN_MATCH;
+            while (mp < match_limit && *mp == *rp) {
+                mp++;
+                rp++;
+            }
+
+            /* And backwards into pending literals */
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+
+            op = emit_sequence(op, anchor, (size_t)(ip - anchor),
+                               (size_t)(ip - ref), (size_t)(mp - ip));
+            ip = mp;
+            anchor = ip;
+
+            /* Seed the table inside the match for better chaining */
+            if (ip - 2 > src && ip < mflimit) {
+                table[hash_sequence(read32(ip - 2))] = (uint32_t)(ip - 2 - src);
+            }
+        }
+    }
+
+    /* Final literals */
+    op = emit_sequence(op, anchor, (size_t)(end - anchor), 0, 0);
+    return (size_t)(op - (uint8_t *)dst_ptr);
+}
+
+bool agentite_lz_decompress(const void *src_ptr, size_t src_size,
+                            void *dst_ptr, size_t dst_size)
+{
+    if (!src_ptr || src_size == 0 || (!dst_ptr && dst_size > 0)) {
+        return false;
+    }
+
+    const uint8_t *ip = (const uint8_t *)src_ptr;
+    const uint8_t *iend = ip + src_size;
+    uint8_t *dst = (uint8_t *)dst_ptr;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_size;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        /* Literals */
+        size_t literal_len = token >> 4;
+        if (literal_len == LZ_RUN_MASK) {
+            uint8_t b;
+            do {
+                if (ip >= iend) return false;
+                b = *ip++;
+                literal_len += b;
+            } while (b == 255);
+        }
+        if (literal_len > (size_t)(iend - ip) || literal_len > (size_t)(oend - op)) {
+            return false;
+        }
+        memcpy(op, ip, literal_len);
+        op += literal_len;
+        ip += literal_len;
+
+        /* Last sequence has no match */
+        if (ip >= iend) {
+            break;
+        }
+
+        /* Match */
+        if (iend - ip < 2) return false;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) {
+            return false;
+        }
+
+        size_t match_len = token & LZ_RUN_MASK;
+        if (match_len == LZ_RUN_MASK) {
+            uint8_t b;
+            do {
+                if (ip >= iend) return false;
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += LZ_MIN_MATCH;
+        if (match_len > (size_t)(oend - op)) {
+            return false;
+        }
+
+        const uint8_t *ref = op - offset;
+        if (offset >= match_len) {
+            memcpy(op, ref, match_len);
+            op += match_len;
+        } else {
+            /* Overlapping copy replicates the pattern */
+            for (size_t i = 0; i < match_len; i++) {
+                *op++ = ref[i];
+            }
+        }
+    }
+
+    return op == oend;
+}
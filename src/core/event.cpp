@@ -1,64 +1,165 @@
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_EVENT
 #include "agentite/agentite.h"
 #include "agentite/event.h"
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 /*============================================================================
  * Internal Structures
  *============================================================================*/
 
 #define AGENTITE_EVENT_INITIAL_LISTENERS 8
+#define AGENTITE_EVENT_INITIAL_CHANNELS 16
 #define AGENTITE_EVENT_DEFERRED_QUEUE_SIZE 64
 #define AGENTITE_EVENT_TYPE_BUCKETS 128  /* Hash buckets for event types */
+#define AGENTITE_EVENT_STAGE_BLOCK 128   /* Events per worker staging block */
 
 typedef struct Agentite_Listener {
     Agentite_ListenerID id;
-    Agentite_EventType type;          /* AGENTITE_EVENT_NONE for "all" listeners */
     Agentite_EventCallback callback;
     void *userdata;
-    bool active;
+    bool active;                      /* false = tombstone awaiting compaction */
 } Agentite_Listener;
 
-struct Agentite_EventDispatcher {
-    /* All listeners in a single array */
+/* Listeners of one event type, in subscription (= ID) order */
+typedef struct EventChannel {
+    Agentite_EventType type;
     Agentite_Listener *listeners;
-    size_t listener_count;
-    size_t listener_capacity;
+    size_t count;
+    size_t capacity;
+    size_t dead;                      /* Tombstones in listeners */
+    int next;                         /* Next channel in bucket + 1 (0 = end) */
+} EventChannel;
+
+/*
+ * Worker threads stage deferred events in their own single-producer queue:
+ * a chain of fixed blocks that the owning thread appends to and the main
+ * thread drains. count is published with release ordering, so the drain
+ * sees every event before it without locks.
+ */
+typedef struct EventBlock {
+    std::atomic<EventBlock *> next;
+    std::atomic<uint32_t> count;      /* Events written (producer) */
+    uint32_t read;                    /* Events drained (consumer) */
+    Agentite_Event events[AGENTITE_EVENT_STAGE_BLOCK];
+} EventBlock;
+
+typedef struct EventStage {
+    EventStage *next;                 /* Dispatcher's stage list */
+    std::thread::id thread_id;
+    EventBlock *head;                 /* Oldest block, consumer only */
+    EventBlock *tail;                 /* Newest block, producer only */
+    std::atomic<EventBlock *> spare;  /* Drained block handed back for reuse */
+} EventStage;
+
+struct Agentite_EventDispatcher {
+    /* Per-type channels, found through a small hash of the type */
+    EventChannel *channels;
+    size_t channel_count;
+    size_t channel_capacity;
+    int buckets[AGENTITE_EVENT_TYPE_BUCKETS];   /* First channel + 1 (0 = empty) */
+
+    /* Listeners registered with subscribe_all */
+    EventChannel wildcard;
 
     /* Next listener ID (monotonically increasing) */
     Agentite_ListenerID next_id;
 
-    /* Current frame for timestamps */
-    uint32_t current_frame;
+    /* Current frame for timestamps (read by worker threads) */
+    std::atomic<uint32_t> current_frame;
 
-    /* Deferred event queue */
+    /* Worker staging queues, pushed lock-free on a thread's first emit */
+    std::thread::id owner_thread;
+    uint64_t stage_id;                /* Unique per dispatcher, keys thread caches */
+    std::atomic<EventStage *> stages;
+
+    /* Deferred event queue, and the queue being flushed (swapped on flush) */
     Agentite_Event *deferred_queue;
     size_t deferred_count;
     size_t deferred_capacity;
+    Agentite_Event *flush_queue;
+    size_t flush_capacity;
+    uint64_t *flush_order;            /* Grouped flush scratch: type << 32 | index */
+    size_t flush_order_capacity;
+    bool is_flushing;
+
+    /* Nesting depth of emit calls; tombstones are only compacted at depth 0 */
+    int emit_depth;
+    bool needs_compaction;
+};
 
-    /* Flag to prevent nested emission issues */
-    bool is_emitting;
+/* Source of stage_id values; never reused so stale thread caches cannot match */
+static std::atomic<uint64_t> s_next_stage_id{1};
+
+/* Calling thread's staging queue for the dispatcher it last emitted to */
+struct EventStageCache {
+    uint64_t stage_id;
+    EventStage *stage;
 };
+static thread_local EventStageCache t_stage_cache = { 0, nullptr };
 
 /*============================================================================
  * Internal Helpers
  *============================================================================*/
 
-static bool ensure_listener_capacity(Agentite_EventDispatcher *d) {
-    if (d->listener_count < d->listener_capacity) {
+static inline int type_bucket(Agentite_EventType type) {
+    return (int)((uint32_t)type & (AGENTITE_EVENT_TYPE_BUCKETS - 1));
+}
+
+/* Channel index for type, or -1 if nobody ever subscribed to it */
+static int find_channel(const Agentite_EventDispatcher *d, Agentite_EventType type) {
+    for (int c = d->buckets[type_bucket(type)]; c != 0; c = d->channels[c - 1].next) {
+        if (d->channels[c - 1].type == type) {
+            return c - 1;
+        }
+    }
+    return -1;
+}
+
+static int get_or_create_channel(Agentite_EventDispatcher *d, Agentite_EventType type) {
+    int index = find_channel(d, type);
+    if (index >= 0) {
+        return index;
+    }
+
+    if (d->channel_count == d->channel_capacity) {
+        size_t new_capacity = d->channel_capacity == 0 ? AGENTITE_EVENT_INITIAL_CHANNELS
+                                                       : d->channel_capacity * 2;
+        EventChannel *new_channels = AGENTITE_REALLOC(d->channels, EventChannel, new_capacity);
+        if (!new_channels) {
+            return -1;
+        }
+        d->channels = new_channels;
+        d->channel_capacity = new_capacity;
+    }
+
+    index = (int)d->channel_count++;
+    EventChannel *ch = &d->channels[index];
+    memset(ch, 0, sizeof(*ch));
+    ch->type = type;
+    ch->next = d->buckets[type_bucket(type)];
+    d->buckets[type_bucket(type)] = index + 1;
+    return index;
+}
+
+static bool ensure_listener_capacity(EventChannel *ch) {
+    if (ch->count < ch->capacity) {
         return true;
     }
 
-    size_t new_capacity = d->listener_capacity == 0 ? AGENTITE_EVENT_INITIAL_LISTENERS
-                                                     : d->listener_capacity * 2;
-    Agentite_Listener *new_listeners = (Agentite_Listener*)realloc(d->listeners,
-                                              new_capacity * sizeof(Agentite_Listener));
+    size_t new_capacity = ch->capacity == 0 ? AGENTITE_EVENT_INITIAL_LISTENERS
+                                            : ch->capacity * 2;
+    Agentite_Listener *new_listeners = AGENTITE_REALLOC(ch->listeners, Agentite_Listener,
+                                                         new_capacity);
     if (!new_listeners) {
         return false;
     }
 
-    d->listeners = new_listeners;
-    d->listener_capacity = new_capacity;
+    ch->listeners = new_listeners;
+    ch->capacity = new_capacity;
     return true;
 }
 
@@ -69,8 +170,8 @@ static bool ensure_deferred_capacity(Agentite_EventDispatcher *d) {
 
     size_t new_capacity = d->deferred_capacity == 0 ? AGENTITE_EVENT_DEFERRED_QUEUE_SIZE
                                                      : d->deferred_capacity * 2;
-    Agentite_Event *new_queue = (Agentite_Event*)realloc(d->deferred_queue,
-                                       new_capacity * sizeof(Agentite_Event));
+    Agentite_Event *new_queue = AGENTITE_REALLOC(d->deferred_queue, Agentite_Event,
+                                                 new_capacity);
     if (!new_queue) {
         return false;
     }
@@ -80,6 +181,244 @@ static bool ensure_deferred_capacity(Agentite_EventDispatcher *d) {
     return true;
 }
 
+/* Drop tombstones, keeping subscription order */
+static void compact_channel(EventChannel *ch) {
+    size_t write_idx = 0;
+    for (size_t read_idx = 0; read_idx < ch->count; read_idx++) {
+        if (ch->listeners[read_idx].active) {
+            if (write_idx != read_idx) {
+                ch->listeners[write_idx] = ch->listeners[read_idx];
+            }
+            write_idx++;
+        }
+    }
+    ch->count = write_idx;
+    ch->dead = 0;
+}
+
+/* Compact once tombstones make up half the channel */
+static void maybe_compact_channel(EventChannel *ch) {
+    if (ch->dead > 0 && ch->dead * 2 >= ch->count) {
+        compact_channel(ch);
+    }
+}
+
+static void compact_all(Agentite_EventDispatcher *d) {
+    maybe_compact_channel(&d->wildcard);
+    for (size_t i = 0; i < d->channel_count; i++) {
+        maybe_compact_channel(&d->channels[i]);
+    }
+    d->needs_compaction = false;
+}
+
+/* Tombstone listener id in ch; channels are sorted by ID, so binary search */
+static bool remove_from_channel(Agentite_EventDispatcher *d, EventChannel *ch,
+                                Agentite_ListenerID id) {
+    size_t lo = 0, hi = ch->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ch->listeners[mid].id < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == ch->count || ch->listeners[lo].id != id || !ch->listeners[lo].active) {
+        return false;
+    }
+
+    ch->listeners[lo].active = false;
+    ch->dead++;
+    if (d->emit_depth == 0) {
+        maybe_compact_channel(ch);
+    } else {
+        d->needs_compaction = true;
+    }
+    return true;
+}
+
+static inline void begin_emit(Agentite_EventDispatcher *d) {
+    d->emit_depth++;
+}
+
+static inline void end_emit(Agentite_EventDispatcher *d) {
+    if (--d->emit_depth == 0 && d->needs_compaction) {
+        compact_all(d);
+    }
+}
+
+/*
+ * Call the listeners of one typed channel (-1 = none) and the wildcard
+ * listeners, merged by ID so the overall order is subscription order.
+ * Listeners added by a callback are not called for the event in flight.
+ * Arrays may be reallocated by callbacks, so they are re-read every step.
+ */
+static void dispatch(Agentite_EventDispatcher *d, int channel, const Agentite_Event *e) {
+    size_t typed_end = channel >= 0 ? d->channels[channel].count : 0;
+    size_t wild_end = d->wildcard.count;
+    size_t ti = 0, wi = 0;
+
+    while (ti < typed_end || wi < wild_end) {
+        const Agentite_Listener *listener;
+        if (wi >= wild_end ||
+            (ti < typed_end &&
+             d->channels[channel].listeners[ti].id < d->wildcard.listeners[wi].id)) {
+            listener = &d->channels[channel].listeners[ti++];
+        } else {
+            listener = &d->wildcard.listeners[wi++];
+        }
+
+        if (listener->active) {
+            Agentite_EventCallback callback = listener->callback;
+            void *userdata = listener->userdata;
+            callback(e, userdata);
+        }
+    }
+}
+
+static EventBlock *new_stage_block(EventStage *stage) {
+    EventBlock *block = stage->spare.exchange(nullptr, std::memory_order_acquire);
+    if (!block) {
+        block = AGENTITE_ALLOC(EventBlock);
+        if (!block) return nullptr;
+    }
+    block->next.store(nullptr, std::memory_order_relaxed);
+    block->count.store(0, std::memory_order_relaxed);
+    block->read = 0;
+    return block;
+}
+
+/* Find or create the calling thread's staging queue */
+static EventStage *get_stage(Agentite_EventDispatcher *d) {
+    EventStageCache *cache = &t_stage_cache;
+    if (cache->stage_id == d->stage_id) {
+        return cache->stage;
+    }
+
+    std::thread::id self = std::this_thread::get_id();
+    EventStage *stage = d->stages.load(std::memory_order_acquire);
+    while (stage && stage->thread_id != self) {
+        stage = stage->next;
+    }
+
+    if (!stage) {
+        stage = AGENTITE_ALLOC(EventStage);
+        if (!stage) return nullptr;
+        stage->thread_id = self;
+        stage->head = stage->tail = new_stage_block(stage);
+        if (!stage->head) {
+            AGENTITE_FREE(stage);
+            return nullptr;
+        }
+
+        EventStage *head = d->stages.load(std::memory_order_relaxed);
+        do {
+            stage->next = head;
+        } while (!d->stages.compare_exchange_weak(
+                     head, stage, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    cache->stage_id = d->stage_id;
+    cache->stage = stage;
+    return stage;
+}
+
+/* Producer side: append to the thread's tail block, linking a new one when full */
+static bool stage_push(EventStage *stage, const Agentite_Event *event) {
+    EventBlock *block = stage->tail;
+    uint32_t count = block->count.load(std::memory_order_relaxed);
+    if (count == AGENTITE_EVENT_STAGE_BLOCK) {
+        EventBlock *next = new_stage_block(stage);
+        if (!next) return false;
+        block->next.store(next, std::memory_order_release);
+        stage->tail = block = next;
+        count = 0;
+    }
+    block->events[count] = *event;
+    block->count.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+/* Consumer side: move every published worker event into the main queue */
+static void drain_stages(Agentite_EventDispatcher *d, bool discard) {
+    for (EventStage *stage = d->stages.load(std::memory_order_acquire); stage;
+         stage = stage->next) {
+        EventBlock *block = stage->head;
+        for (;;) {
+            uint32_t count = block->count.load(std::memory_order_acquire);
+            for (; block->read < count; block->read++) {
+                if (!discard && ensure_deferred_capacity(d)) {
+                    d->deferred_queue[d->deferred_count++] = block->events[block->read];
+                }
+            }
+            if (count < AGENTITE_EVENT_STAGE_BLOCK) break;
+
+            /* Full and drained: once the producer has moved on it is ours */
+            EventBlock *next = block->next.load(std::memory_order_acquire);
+            if (!next) break;
+            stage->head = next;
+            AGENTITE_FREE(stage->spare.exchange(block, std::memory_order_release));
+            block = next;
+        }
+    }
+}
+
+/* Emit the queued events; events deferred meanwhile go to the other queue */
+static void flush_deferred(Agentite_EventDispatcher *d, bool grouped) {
+    if (!d || d->is_flushing) return;
+
+    /* Worker events published so far follow the main thread's */
+    drain_stages(d, false);
+    if (d->deferred_count == 0) return;
+
+    d->is_flushing = true;
+    begin_emit(d);
+
+    while (d->deferred_count > 0) {
+        Agentite_Event *queue = d->deferred_queue;
+        size_t capacity = d->deferred_capacity;
+        size_t count = d->deferred_count;
+        d->deferred_queue = d->flush_queue;
+        d->deferred_capacity = d->flush_capacity;
+        d->deferred_count = 0;
+        d->flush_queue = queue;
+        d->flush_capacity = capacity;
+
+        if (grouped && count > 1 && d->flush_order_capacity < count) {
+            uint64_t *order = AGENTITE_REALLOC(d->flush_order, uint64_t, capacity);
+            if (order) {
+                d->flush_order = order;
+                d->flush_order_capacity = capacity;
+            }
+        }
+
+        if (!grouped || count <= 1 || d->flush_order_capacity < count) {
+            for (size_t i = 0; i < count; i++) {
+                dispatch(d, find_channel(d, queue[i].type), &queue[i]);
+            }
+            continue;
+        }
+
+        /* Sort by type, then queue position: same-type events stay in order */
+        uint64_t *order = d->flush_order;
+        for (size_t i = 0; i < count; i++) {
+            order[i] = ((uint64_t)(uint32_t)queue[i].type << 32) | (uint64_t)i;
+        }
+        std::sort(order, order + count);
+
+        for (size_t i = 0; i < count; ) {
+            Agentite_EventType type = queue[(uint32_t)order[i]].type;
+            int channel = find_channel(d, type);
+            for (; i < count && queue[(uint32_t)order[i]].type == type; i++) {
+                dispatch(d, channel, &queue[(uint32_t)order[i]]);
+            }
+        }
+    }
+
+    end_emit(d);
+    d->is_flushing = false;
+}
+
 /*============================================================================
  * Public API Implementation
  *============================================================================*/
@@ -89,15 +428,38 @@ Agentite_EventDispatcher *agentite_event_dispatcher_create(void) {
     if (!d) return NULL;
 
     d->next_id = 1;  /* ID 0 is reserved for "invalid" */
+    d->owner_thread = std::this_thread::get_id();
+    d->stage_id = s_next_stage_id.fetch_add(1, std::memory_order_relaxed);
     return d;
 }
 
 void agentite_event_dispatcher_destroy(Agentite_EventDispatcher *d) {
     if (!d) return;
 
-    free(d->listeners);
-    free(d->deferred_queue);
-    free(d);
+    for (size_t i = 0; i < d->channel_count; i++) {
+        AGENTITE_FREE(d->channels[i].listeners);
+    }
+    AGENTITE_FREE(d->channels);
+    AGENTITE_FREE(d->wildcard.listeners);
+    AGENTITE_FREE(d->deferred_queue);
+    AGENTITE_FREE(d->flush_queue);
+    AGENTITE_FREE(d->flush_order);
+
+    EventStage *stage = d->stages.load(std::memory_order_acquire);
+    while (stage) {
+        EventStage *next = stage->next;
+        EventBlock *block = stage->head;
+        while (block) {
+            EventBlock *next_block = block->next.load(std::memory_order_acquire);
+            AGENTITE_FREE(block);
+            block = next_block;
+        }
+        AGENTITE_FREE(stage->spare.load(std::memory_order_acquire));
+        AGENTITE_FREE(stage);
+        stage = next;
+    }
+
+    AGENTITE_FREE(d);
 }
 
 Agentite_ListenerID agentite_event_subscribe(Agentite_EventDispatcher *d,
@@ -106,13 +468,21 @@ Agentite_ListenerID agentite_event_subscribe(Agentite_EventDispatcher *d,
                                           void *userdata) {
     if (!d || !callback) return 0;
 
-    if (!ensure_listener_capacity(d)) {
+    EventChannel *ch;
+    if (type == AGENTITE_EVENT_NONE) {
+        ch = &d->wildcard;
+    } else {
+        int index = get_or_create_channel(d, type);
+        if (index < 0) return 0;
+        ch = &d->channels[index];
+    }
+
+    if (!ensure_listener_capacity(ch)) {
         return 0;
     }
 
-    Agentite_Listener *listener = &d->listeners[d->listener_count++];
+    Agentite_Listener *listener = &ch->listeners[ch->count++];
     listener->id = d->next_id++;
-    listener->type = type;
     listener->callback = callback;
     listener->userdata = userdata;
     listener->active = true;
@@ -129,19 +499,11 @@ Agentite_ListenerID agentite_event_subscribe_all(Agentite_EventDispatcher *d,
 void agentite_event_unsubscribe(Agentite_EventDispatcher *d, Agentite_ListenerID id) {
     if (!d || id == 0) return;
 
-    for (size_t i = 0; i < d->listener_count; i++) {
-        if (d->listeners[i].id == id) {
-            /* Mark as inactive (will be cleaned up later) */
-            d->listeners[i].active = false;
-
-            /* If not currently emitting, compact immediately */
-            if (!d->is_emitting) {
-                /* Swap with last and decrement count */
-                if (i < d->listener_count - 1) {
-                    d->listeners[i] = d->listeners[d->listener_count - 1];
-                }
-                d->listener_count--;
-            }
+    if (remove_from_channel(d, &d->wildcard, id)) {
+        return;
+    }
+    for (size_t i = 0; i < d->channel_count; i++) {
+        if (remove_from_channel(d, &d->channels[i], id)) {
             return;
         }
     }
@@ -152,94 +514,105 @@ void agentite_event_emit(Agentite_EventDispatcher *d, const Agentite_Event *even
 
     /* Create mutable copy with timestamp */
     Agentite_Event e = *event;
-    e.timestamp = d->current_frame;
+    e.timestamp = d->current_frame.load(std::memory_order_relaxed);
 
-    bool was_emitting = d->is_emitting;
-    d->is_emitting = true;
+    begin_emit(d);
+    dispatch(d, find_channel(d, e.type), &e);
+    end_emit(d);
+}
 
-    /* Iterate through all listeners */
-    for (size_t i = 0; i < d->listener_count; i++) {
-        Agentite_Listener *listener = &d->listeners[i];
+void agentite_event_emit_many(Agentite_EventDispatcher *d, const Agentite_Event *events,
+                              size_t count) {
+    if (!d || !events || count == 0) return;
 
-        if (!listener->active) continue;
+    begin_emit(d);
 
-        /* Check if listener wants this event type (or wants all events) */
-        if (listener->type == AGENTITE_EVENT_NONE || listener->type == e.type) {
-            listener->callback(&e, listener->userdata);
-        }
-    }
-
-    d->is_emitting = was_emitting;
+    Agentite_EventType last_type = AGENTITE_EVENT_NONE;
+    int channel = -1;
+    for (size_t i = 0; i < count; i++) {
+        Agentite_Event e = events[i];
+        e.timestamp = d->current_frame.load(std::memory_order_relaxed);
 
-    /* Compact inactive listeners if we're done emitting */
-    if (!d->is_emitting) {
-        size_t write_idx = 0;
-        for (size_t read_idx = 0; read_idx < d->listener_count; read_idx++) {
-            if (d->listeners[read_idx].active) {
-                if (write_idx != read_idx) {
-                    d->listeners[write_idx] = d->listeners[read_idx];
-                }
-                write_idx++;
-            }
+        /* Runs of one type reuse the lookup (channels are never removed) */
+        if (e.type != last_type || channel < 0) {
+            channel = find_channel(d, e.type);
+            last_type = e.type;
         }
-        d->listener_count = write_idx;
+        dispatch(d, channel, &e);
     }
+
+    end_emit(d);
 }
 
 void agentite_event_emit_deferred(Agentite_EventDispatcher *d, const Agentite_Event *event) {
     if (!d || !event) return;
 
-    if (!ensure_deferred_capacity(d)) {
+    Agentite_Event e = *event;
+    e.timestamp = d->current_frame.load(std::memory_order_relaxed);
+
+    /* Other threads go through their staging queue, drained by the next flush */
+    if (std::this_thread::get_id() != d->owner_thread) {
+        EventStage *stage = get_stage(d);
+        if (stage) {
+            stage_push(stage, &e);
+        }
         return;
     }
 
-    Agentite_Event *queued = &d->deferred_queue[d->deferred_count++];
-    *queued = *event;
-    queued->timestamp = d->current_frame;
+    if (!ensure_deferred_capacity(d)) {
+        return;
+    }
+    d->deferred_queue[d->deferred_count++] = e;
 }
 
 void agentite_event_flush_deferred(Agentite_EventDispatcher *d) {
-    if (!d || d->deferred_count == 0) return;
-
-    /* Process all deferred events */
-    /* Note: New deferred events during flush are processed immediately */
-    size_t count = d->deferred_count;
-    d->deferred_count = 0;
-
-    for (size_t i = 0; i < count; i++) {
-        agentite_event_emit(d, &d->deferred_queue[i]);
-    }
+    flush_deferred(d, false);
+}
 
-    /* Handle any events that were deferred during flush */
-    if (d->deferred_count > 0) {
-        agentite_event_flush_deferred(d);
-    }
+void agentite_event_flush_deferred_grouped(Agentite_EventDispatcher *d) {
+    flush_deferred(d, true);
 }
 
 void agentite_event_set_frame(Agentite_EventDispatcher *d, uint32_t frame) {
     if (d) {
-        d->current_frame = frame;
+        d->current_frame.store(frame, std::memory_order_relaxed);
     }
 }
 
 int agentite_event_listener_count(const Agentite_EventDispatcher *d, Agentite_EventType type) {
     if (!d) return 0;
 
-    int count = 0;
-    for (size_t i = 0; i < d->listener_count; i++) {
-        if (d->listeners[i].active &&
-            (d->listeners[i].type == type || d->listeners[i].type == AGENTITE_EVENT_NONE)) {
-            count++;
+    size_t count = d->wildcard.count - d->wildcard.dead;
+    if (type != AGENTITE_EVENT_NONE) {
+        int index = find_channel(d, type);
+        if (index >= 0) {
+            count += d->channels[index].count - d->channels[index].dead;
         }
     }
-    return count;
+    return (int)count;
 }
 
 void agentite_event_clear_all(Agentite_EventDispatcher *d) {
     if (!d) return;
 
-    d->listener_count = 0;
     d->deferred_count = 0;
+    drain_stages(d, true);
+
+    /* Mid-emission the arrays are being walked: tombstone instead */
+    EventChannel *wild = &d->wildcard;
+    for (size_t i = 0; i <= d->channel_count; i++) {
+        EventChannel *ch = i < d->channel_count ? &d->channels[i] : wild;
+        if (d->emit_depth > 0) {
+            for (size_t j = 0; j < ch->count; j++) {
+                ch->listeners[j].active = false;
+            }
+            ch->dead = ch->count;
+            d->needs_compaction = true;
+        } else {
+            ch->count = 0;
+            ch->dead = 0;
+        }
+    }
 }
 
 /*============================================================================
@@ -410,6 +783,8 @@ const char *agentite_event_type_name(Agentite_EventType type) {
         case AGENTITE_EVENT_GAME_RESUMED:     return "GAME_RESUMED";
         case AGENTITE_EVENT_GAME_ENDED:       return "GAME_ENDED";
         case AGENTITE_EVENT_STATE_CHANGED:    return "STATE_CHANGED";
+        case AGENTITE_EVENT_GAME_SAVED:       return "GAME_SAVED";
+        case AGENTITE_EVENT_GAME_SAVE_FAILED: return "GAME_SAVE_FAILED";
 
         /* Turn-based */
         case AGENTITE_EVENT_TURN_STARTED:     return "TURN_STARTED";
@@ -85,6 +85,13 @@ Agentite_GameContext *agentite_game_context_create(const Agentite_GameContextCon
     ctx->window_width = config->window_width;
     ctx->window_height = config->window_height;
 
+    /* Transient per-frame memory (no dependencies, created first) */
+    ctx->frame_arena = agentite_frame_arena_create(config->frame_arena_size);
+    if (!ctx->frame_arena) {
+        free(ctx);
+        return NULL;
+    }
+
     /* 1. Initialize core engine */
     Agentite_Config engine_config = {
         .window_title = config->window_title,
@@ -156,6 +163,9 @@ Agentite_GameContext *agentite_game_context_create(const Agentite_GameContextCon
             agentite_set_error("Failed to initialize ECS world");
             goto error;
         }
+        if (config->ecs_worker_threads != 0) {
+            agentite_game_context_apply_ecs_threads(ctx->ecs, config);
+        }
     }
 
     /* 8. Initialize UI system (optional) */
@@ -247,6 +257,13 @@ error:
     return NULL;
 }
 
+bool agentite_game_context_apply_ecs_threads(Agentite_World *world,
+                                             const Agentite_GameContextConfig *config) {
+    int workers = config ? config->ecs_worker_threads : 0;
+    /* agentite_ecs_set_threads() counts the main thread and uses 0 for "per core" */
+    return agentite_ecs_set_threads(world, workers < 0 ? 0 : workers + 1);
+}
+
 void agentite_game_context_destroy(Agentite_GameContext *ctx) {
     if (!ctx) return;
 
@@ -318,6 +335,9 @@ void agentite_game_context_destroy(Agentite_GameContext *ctx) {
         agentite_shutdown(ctx->engine);
     }
 
+    /* Frame arena */
+    agentite_frame_arena_destroy(ctx->frame_arena);
+
     free(ctx);
 }
 
@@ -410,12 +430,19 @@ void agentite_game_context_end_frame(Agentite_GameContext *ctx) {
 
     agentite_end_frame(ctx->engine);
 
+    /* Last frame's transient allocations are no longer referenced */
+    agentite_frame_arena_swap(ctx->frame_arena);
+
     /* End profiler frame */
     if (ctx->profiler) {
         agentite_profiler_end_frame(ctx->profiler);
     }
 }
 
+Agentite_Arena *agentite_game_context_frame_arena(Agentite_GameContext *ctx) {
+    return ctx ? agentite_frame_arena_current(ctx->frame_arena) : NULL;
+}
+
 SDL_GPUCommandBuffer *agentite_game_context_begin_render(Agentite_GameContext *ctx) {
     if (!ctx || !ctx->engine) return NULL;
 
@@ -0,0 +1,234 @@
+/**
+ * @file job.cpp
+ * @brief Fork-Join Job Pool Implementation
+ */
+
+#include "agentite/agentite.h"
+#include "agentite/job.h"
+#include "agentite/error.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <atomic>
+
+/* Upper bound for the auto-detected worker count */
+#define JOB_MAX_AUTO_THREADS 16
+
+/* Chunks per participant when the grain is picked automatically */
+#define JOB_CHUNKS_PER_THREAD 4
+
+/* ============================================================================
+ * Internal Types
+ * ============================================================================ */
+
+struct Agentite_JobPool {
+    SDL_Thread **threads;
+    int thread_count;
+
+    SDL_Mutex *mutex;
+    SDL_Condition *work_cond;       /* Workers: a new job was published */
+    SDL_Condition *done_cond;       /* Caller: last chunk finished or a worker left */
+
+    /* Guarded by mutex */
+    uint64_t generation;            /* Bumped for every published job */
+    int active;                     /* Workers still inside the current job */
+    bool shutdown;
+
+    /* Current job; only rewritten under mutex while active == 0 */
+    Agentite_JobRangeFn fn;
+    void *userdata;
+    int count;
+    int grain;
+    int chunk_count;
+
+    std::atomic<int> next_chunk;
+    std::atomic<int> chunks_done;
+    std::atomic<bool> busy;         /* A parallel_for owns the workers */
+};
+
+/* ============================================================================
+ * Internal Helpers
+ * ============================================================================ */
+
+static void run_chunks(Agentite_JobPool *pool, Agentite_JobRangeFn fn, void *userdata,
+                       int count, int grain, int chunk_count) {
+    for (;;) {
+        int chunk = pool->next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= chunk_count) {
+            return;
+        }
+
+        int begin = chunk * grain;
+        int end = (count - begin > grain) ? begin + grain : count;
+        fn(userdata, begin, end);
+
+        int done = pool->chunks_done.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (done == chunk_count) {
+            SDL_LockMutex(pool->mutex);
+            SDL_BroadcastCondition(pool->done_cond);
+            SDL_UnlockMutex(pool->mutex);
+        }
+    }
+}
+
+static int worker_thread_func(void *data) {
+    Agentite_JobPool *pool = (Agentite_JobPool *)data;
+    uint64_t seen = 0;
+
+    for (;;) {
+        SDL_LockMutex(pool->mutex);
+        while (!pool->shutdown && pool->generation == seen) {
+            SDL_WaitCondition(pool->work_cond, pool->mutex);
+        }
+        if (pool->shutdown) {
+            SDL_UnlockMutex(pool->mutex);
+            return 0;
+        }
+        seen = pool->generation;
+        pool->active++;
+        Agentite_JobRangeFn fn = pool->fn;
+        void *userdata = pool->userdata;
+        int count = pool->count;
+        int grain = pool->grain;
+        int chunk_count = pool->chunk_count;
+        SDL_UnlockMutex(pool->mutex);
+
+        run_chunks(pool, fn, userdata, count, grain, chunk_count);
+
+        SDL_LockMutex(pool->mutex);
+        pool->active--;
+        if (pool->active == 0) {
+            SDL_BroadcastCondition(pool->done_cond);
+        }
+        SDL_UnlockMutex(pool->mutex);
+    }
+}
+
+/* ============================================================================
+ * Lifecycle
+ * ============================================================================ */
+
+Agentite_JobPool *agentite_job_pool_create(int num_threads) {
+    Agentite_JobPool *pool = AGENTITE_ALLOC(Agentite_JobPool);
+    if (!pool) {
+        agentite_set_error("job: failed to allocate pool");
+        return NULL;
+    }
+
+    if (num_threads <= 0) {
+        num_threads = SDL_GetNumLogicalCPUCores() - 1;
+        if (num_threads < 0) num_threads = 0;
+        if (num_threads > JOB_MAX_AUTO_THREADS) num_threads = JOB_MAX_AUTO_THREADS;
+    }
+
+    pool->mutex = SDL_CreateMutex();
+    pool->work_cond = SDL_CreateCondition();
+    pool->done_cond = SDL_CreateCondition();
+    if (!pool->mutex || !pool->work_cond || !pool->done_cond) {
+        agentite_set_error("job: failed to create synchronization primitives");
+        agentite_job_pool_destroy(pool);
+        return NULL;
+    }
+
+    if (num_threads > 0) {
+        pool->threads = AGENTITE_ALLOC_ARRAY(SDL_Thread *, num_threads);
+        if (!pool->threads) {
+            agentite_set_error("job: failed to allocate thread array");
+            agentite_job_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "job_worker_%d", i);
+        pool->threads[i] = SDL_CreateThread(worker_thread_func, name, pool);
+        if (!pool->threads[i]) {
+            agentite_set_error("job: failed to create worker thread %d", i);
+            agentite_job_pool_destroy(pool);
+            return NULL;
+        }
+        pool->thread_count++;
+    }
+
+    return pool;
+}
+
+void agentite_job_pool_destroy(Agentite_JobPool *pool) {
+    if (!pool) return;
+
+    if (pool->mutex) {
+        SDL_LockMutex(pool->mutex);
+        pool->shutdown = true;
+        if (pool->work_cond) {
+            SDL_BroadcastCondition(pool->work_cond);
+        }
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    for (int i = 0; i < pool->thread_count; i++) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+    AGENTITE_FREE(pool->threads);
+
+    if (pool->done_cond) SDL_DestroyCondition(pool->done_cond);
+    if (pool->work_cond) SDL_DestroyCondition(pool->work_cond);
+    if (pool->mutex) SDL_DestroyMutex(pool->mutex);
+    AGENTITE_FREE(pool);
+}
+
+int agentite_job_pool_thread_count(const Agentite_JobPool *pool) {
+    return pool ? pool->thread_count : 0;
+}
+
+/* ============================================================================
+ * Execution
+ * ============================================================================ */
+
+void agentite_job_parallel_for(Agentite_JobPool *pool, int count, int grain,
+                               Agentite_JobRangeFn fn, void *userdata) {
+    if (!fn || count <= 0) return;
+
+    /* No workers, or they already belong to another call: run inline */
+    if (!pool || pool->thread_count == 0 ||
+        pool->busy.exchange(true, std::memory_order_acquire)) {
+        fn(userdata, 0, count);
+        return;
+    }
+
+    if (grain <= 0) {
+        grain = count / ((pool->thread_count + 1) * JOB_CHUNKS_PER_THREAD);
+        if (grain < 1) grain = 1;
+    }
+    int chunk_count = (int)(((int64_t)count + grain - 1) / grain);
+    if (chunk_count == 1) {
+        fn(userdata, 0, count);
+        pool->busy.store(false, std::memory_order_release);
+        return;
+    }
+
+    /* Workers that joined the previous job may still be leaving it */
+    SDL_LockMutex(pool->mutex);
+    while (pool->active > 0) {
+        SDL_WaitCondition(pool->done_cond, pool->mutex);
+    }
+    pool->fn = fn;
+    pool->userdata = userdata;
+    pool->count = count;
+    pool->grain = grain;
+    pool->chunk_count = chunk_count;
+    pool->next_chunk.store(0, std::memory_order_relaxed);
+    pool->chunks_done.store(0, std::memory_order_relaxed);
+    pool->generation++;
+    SDL_BroadcastCondition(pool->work_cond);
+    SDL_UnlockMutex(pool->mutex);
+
+    run_chunks(pool, fn, userdata, count, grain, chunk_count);
+
+    SDL_LockMutex(pool->mutex);
+    while (pool->chunks_done.load(std::memory_order_acquire) < chunk_count) {
+        SDL_WaitCondition(pool->done_cond, pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+
+    pool->busy.store(false, std::memory_order_release);
+}
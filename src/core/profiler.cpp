@@ -10,6 +10,13 @@
 #include <cstdio>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 /* ============================================================================
  * Internal Types
@@ -19,6 +26,16 @@
 struct ScopeEntry {
     char name[AGENTITE_PROFILER_MAX_SCOPE_NAME];
     uint64_t start_time;
+    int32_t node;               /* Scope tree node (-1 if the tree was full) */
+    int32_t parent_node;        /* Tree position to restore on end */
+};
+
+/** Scope tree links and averaging state, parallel to the public nodes */
+struct TreeLink {
+    int32_t first_child;
+    int32_t next_sibling;
+    double accumulated_ms;
+    uint32_t sample_count;
 };
 
 /** Named scope tracking data */
@@ -33,6 +50,38 @@ struct NamedScope {
     bool active;
 };
 
+/** Completed scope in a trace ring (name is the caller's pointer, not a copy) */
+struct TraceEvent {
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+/** Scope opened on a trace thread; begin is 0 if it opened outside a capture */
+struct TraceOpenScope {
+    const char *name;
+    uint64_t begin;
+};
+
+/**
+ * Per-thread trace ring. Only the owning thread writes events and its scope
+ * stack; head is published with release ordering so the exporter can read
+ * everything before it without locks.
+ */
+struct TraceThread {
+    TraceThread *next;
+    SDL_ThreadID thread_id;
+    uint32_t index;                 /* Stable small id used as the exported tid */
+    char name[AGENTITE_PROFILER_MAX_SCOPE_NAME];
+
+    TraceEvent *events;
+    uint64_t mask;                  /* Ring capacity - 1 (power of two) */
+    std::atomic<uint64_t> head;     /* Total events written */
+
+    TraceOpenScope stack[AGENTITE_PROFILER_MAX_SCOPE_DEPTH];
+    uint32_t depth;                 /* May exceed the stack; extra levels are not timed */
+};
+
 /** Profiler internal state */
 struct Agentite_Profiler {
     /* Configuration */
@@ -69,12 +118,29 @@ struct Agentite_Profiler {
     NamedScope named_scopes[AGENTITE_PROFILER_MAX_NAMED_SCOPES];
     uint32_t named_scope_count;
 
+    /* Scope tree */
+    Agentite_ScopeNode tree[AGENTITE_PROFILER_MAX_TREE_NODES];
+    TreeLink tree_links[AGENTITE_PROFILER_MAX_TREE_NODES];
+    uint32_t tree_count;
+    int32_t tree_first_root;
+    int32_t tree_current;       /* Node of the innermost open scope (-1 = none) */
+
+    /* Spike captures (ring, newest at spike_next - 1) */
+    Agentite_ProfilerSpike spikes[AGENTITE_PROFILER_MAX_SPIKES];
+    uint32_t spike_next;
+    uint32_t spike_count;
+
     /* Render statistics (reset each frame) */
     Agentite_RenderStats render_stats;
 
     /* Memory statistics (cumulative) */
     Agentite_MemoryStats memory_stats;
 
+    /* Allocation counters per frame (track_memory only) */
+    Agentite_AllocStats alloc_frame_start;  /* Counters at begin_frame */
+    Agentite_AllocStats last_frame_allocs;
+    Agentite_AllocStats *alloc_history;     /* Ring indexed by (frame - 1) % history_size */
+
     /* Entity count */
     uint32_t entity_count;
 
@@ -83,8 +149,32 @@ struct Agentite_Profiler {
 
     /* Performance counter frequency */
     uint64_t perf_freq;
+
+    /* Tracing (timestamps are trace_clock() ticks) */
+    uint64_t clock_base_trace;              /* trace_clock() at creation */
+    uint64_t clock_base_perf;               /* SDL_GetPerformanceCounter() at creation */
+    uint64_t trace_id;                      /* Unique per profiler, keys thread caches */
+    SDL_ThreadID owner_thread;              /* Creating thread, named "main" */
+    uint32_t trace_capacity;                /* Events per thread ring */
+    std::atomic<TraceThread *> trace_threads;
+    std::atomic<uint32_t> trace_thread_count;
+    std::atomic<bool> tracing;
+    uint32_t trace_armed_frames;            /* Capture waiting for the next begin_frame */
+    uint32_t trace_frames_left;             /* Frames until the capture stops (0 = manual) */
+    uint64_t trace_start;
+    uint64_t trace_stop;
 };
 
+/* Source of trace_id values; never reused so stale thread caches cannot match */
+static std::atomic<uint64_t> s_next_trace_id{1};
+
+/** Calling thread's trace ring for the profiler it last traced with */
+struct TraceThreadCache {
+    uint64_t trace_id;
+    TraceThread *thread;
+};
+static thread_local TraceThreadCache t_trace_cache = { 0, nullptr };
+
 /* ============================================================================
  * Helper Functions
  * ============================================================================ */
@@ -93,6 +183,36 @@ static double ticks_to_ms(uint64_t ticks, uint64_t freq) {
     return (double)ticks * 1000.0 / (double)freq;
 }
 
+/**
+ * Timestamp for trace events. Reads the CPU's constant-rate counter where
+ * one is available, which costs a few nanoseconds instead of a clock
+ * syscall; exports convert it using a rate measured against the
+ * performance counter.
+ */
+static inline uint64_t trace_clock(void) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return SDL_GetPerformanceCounter();
+#endif
+}
+
+/** Trace clock ticks per second, measured since the profiler was created */
+static double trace_clock_frequency(const Agentite_Profiler *profiler) {
+    uint64_t perf = SDL_GetPerformanceCounter() - profiler->clock_base_perf;
+    uint64_t trace = trace_clock() - profiler->clock_base_trace;
+    if (perf == 0 || trace == 0) {
+        return (double)profiler->perf_freq;
+    }
+    return (double)trace * (double)profiler->perf_freq / (double)perf;
+}
+
 static NamedScope *find_named_scope(Agentite_Profiler *profiler, const char *name) {
     for (uint32_t i = 0; i < profiler->named_scope_count; i++) {
         if (profiler->named_scopes[i].active &&
@@ -126,6 +246,166 @@ static NamedScope *get_or_create_named_scope(Agentite_Profiler *profiler, const
     return scope;
 }
 
+static void reset_scope_tree(Agentite_Profiler *profiler) {
+    profiler->tree_count = 0;
+    profiler->tree_first_root = -1;
+    profiler->tree_current = -1;
+}
+
+/** Find the child of parent (-1 = top level) called name, adding it if missing */
+static int32_t get_or_create_tree_node(Agentite_Profiler *profiler, int32_t parent,
+                                       const char *name) {
+    int32_t *link = parent >= 0 ? &profiler->tree_links[parent].first_child
+                                : &profiler->tree_first_root;
+    for (int32_t i = *link; i >= 0; i = profiler->tree_links[i].next_sibling) {
+        if (strncmp(profiler->tree[i].name, name, AGENTITE_PROFILER_MAX_SCOPE_NAME - 1) == 0) {
+            return i;
+        }
+        link = &profiler->tree_links[i].next_sibling;
+    }
+
+    if (profiler->tree_count >= AGENTITE_PROFILER_MAX_TREE_NODES) {
+        return -1;
+    }
+
+    int32_t index = (int32_t)profiler->tree_count++;
+    Agentite_ScopeNode *node = &profiler->tree[index];
+    memset(node, 0, sizeof(*node));
+    strncpy(node->name, name, AGENTITE_PROFILER_MAX_SCOPE_NAME - 1);
+    node->parent = parent;
+    node->depth = parent >= 0 ? profiler->tree[parent].depth + 1 : 0;
+
+    TreeLink *tl = &profiler->tree_links[index];
+    memset(tl, 0, sizeof(*tl));
+    tl->first_child = -1;
+    tl->next_sibling = -1;
+
+    *link = index;
+    return index;
+}
+
+/** Copy the scope tree of the frame that just ended into the spike ring */
+static void capture_spike(Agentite_Profiler *profiler, double frame_time_ms) {
+    Agentite_ProfilerSpike *spike = &profiler->spikes[profiler->spike_next];
+    profiler->spike_next = (profiler->spike_next + 1) % AGENTITE_PROFILER_MAX_SPIKES;
+    if (profiler->spike_count < AGENTITE_PROFILER_MAX_SPIKES) {
+        profiler->spike_count++;
+    }
+
+    spike->frame_number = profiler->frame_count;
+    spike->frame_time_ms = frame_time_ms;
+    spike->update_time_ms = profiler->update_time_ms;
+    spike->render_time_ms = profiler->render_time_ms;
+    spike->present_time_ms = profiler->present_time_ms;
+    spike->allocs = profiler->last_frame_allocs;
+
+    /* Keep only scopes that ran; parents precede children, so remap in one pass */
+    int32_t remap[AGENTITE_PROFILER_MAX_TREE_NODES];
+    spike->node_count = 0;
+    for (uint32_t i = 0; i < profiler->tree_count; i++) {
+        const Agentite_ScopeNode *src = &profiler->tree[i];
+        if (src->call_count == 0) {
+            remap[i] = -1;
+            continue;
+        }
+        remap[i] = (int32_t)spike->node_count;
+        Agentite_ScopeNode *dst = &spike->nodes[spike->node_count++];
+        *dst = *src;
+        dst->parent = src->parent >= 0 ? remap[src->parent] : -1;
+    }
+}
+
+static uint32_t round_up_pow2(uint32_t v) {
+    uint32_t p = 1;
+    while (p < v && p < 0x80000000u) p <<= 1;
+    return p;
+}
+
+/**
+ * Find the calling thread's trace ring, creating it if create is set.
+ * Creation happens once per thread and pushes onto a lock-free list.
+ */
+static TraceThread *get_trace_thread(Agentite_Profiler *profiler, bool create) {
+    TraceThreadCache *cache = &t_trace_cache;
+    if (cache->trace_id == profiler->trace_id) {
+        return cache->thread;
+    }
+
+    SDL_ThreadID self = SDL_GetCurrentThreadID();
+    TraceThread *t = profiler->trace_threads.load(std::memory_order_acquire);
+    while (t && t->thread_id != self) {
+        t = t->next;
+    }
+
+    if (!t) {
+        if (!create) return nullptr;
+
+        t = (TraceThread *)calloc(1, sizeof(TraceThread));
+        TraceEvent *events = t
+            ? (TraceEvent *)malloc(sizeof(TraceEvent) * profiler->trace_capacity)
+            : nullptr;
+        if (!events) {
+            free(t);
+            return nullptr;
+        }
+        t->thread_id = self;
+        t->index = profiler->trace_thread_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        snprintf(t->name, sizeof(t->name), "%s",
+                 self == profiler->owner_thread ? "main" : "thread");
+        t->events = events;
+        t->mask = profiler->trace_capacity - 1;
+
+        TraceThread *head = profiler->trace_threads.load(std::memory_order_relaxed);
+        do {
+            t->next = head;
+        } while (!profiler->trace_threads.compare_exchange_weak(
+                     head, t, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    cache->trace_id = profiler->trace_id;
+    cache->thread = t;
+    return t;
+}
+
+static void trace_stop_capture(Agentite_Profiler *profiler) {
+    profiler->trace_stop = trace_clock();
+    profiler->tracing.store(false, std::memory_order_release);
+}
+
+/**
+ * Visit each event of the last capture on every thread, oldest first.
+ * The oldest ring slot is skipped: a thread that saw the capture still
+ * running may be finishing a write into it.
+ */
+template <typename Fn>
+static void for_each_trace_event(const Agentite_Profiler *profiler, Fn fn) {
+    const TraceThread *t = profiler->trace_threads.load(std::memory_order_acquire);
+    for (; t; t = t->next) {
+        uint64_t head = t->head.load(std::memory_order_acquire);
+        uint64_t first = head > t->mask ? head - t->mask : 0;
+        for (uint64_t i = first; i < head; i++) {
+            const TraceEvent *event = &t->events[i & t->mask];
+            if (event->begin >= profiler->trace_start && event->end <= profiler->trace_stop) {
+                fn(t, event);
+            }
+        }
+    }
+}
+
+static void write_json_string(FILE *f, const char *str) {
+    fputc('"', f);
+    for (const unsigned char *c = (const unsigned char *)str; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(f, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(f, "\\u%04x", *c);
+        } else {
+            fputc(*c, f);
+        }
+    }
+    fputc('"', f);
+}
+
 /* ============================================================================
  * Profiler Lifecycle
  * ============================================================================ */
@@ -145,6 +425,14 @@ Agentite_Profiler *agentite_profiler_create(const Agentite_ProfilerConfig *confi
     profiler->config = *config;
     profiler->perf_freq = SDL_GetPerformanceFrequency();
 
+    profiler->clock_base_trace = trace_clock();
+    profiler->clock_base_perf = SDL_GetPerformanceCounter();
+    profiler->trace_id = s_next_trace_id.fetch_add(1);
+    profiler->owner_thread = SDL_GetCurrentThreadID();
+    profiler->trace_capacity = round_up_pow2(config->trace_buffer_events > 0
+        ? config->trace_buffer_events
+        : AGENTITE_PROFILER_DEFAULT_TRACE_EVENTS);
+
     /* Allocate frame history buffer */
     profiler->frame_history = (float *)calloc(config->history_size, sizeof(float));
     if (!profiler->frame_history) {
@@ -153,9 +441,21 @@ Agentite_Profiler *agentite_profiler_create(const Agentite_ProfilerConfig *confi
         return nullptr;
     }
 
+    if (config->track_memory) {
+        profiler->alloc_history = (Agentite_AllocStats *)calloc(
+            config->history_size, sizeof(Agentite_AllocStats));
+        if (!profiler->alloc_history) {
+            agentite_set_error("Failed to allocate allocation history buffer");
+            free(profiler->frame_history);
+            free(profiler);
+            return nullptr;
+        }
+    }
+
     /* Initialize rolling stats */
     profiler->min_frame_time_ms = 1e9;
     profiler->max_frame_time_ms = 0.0;
+    reset_scope_tree(profiler);
 
     SDL_Log("Profiler created (history_size=%u, scopes=%s, memory=%s)",
             config->history_size,
@@ -168,6 +468,15 @@ Agentite_Profiler *agentite_profiler_create(const Agentite_ProfilerConfig *confi
 void agentite_profiler_destroy(Agentite_Profiler *profiler) {
     if (!profiler) return;
 
+    TraceThread *t = profiler->trace_threads.load(std::memory_order_acquire);
+    while (t) {
+        TraceThread *next = t->next;
+        free(t->events);
+        free(t);
+        t = next;
+    }
+
+    free(profiler->alloc_history);
     free(profiler->frame_history);
     free(profiler);
 }
@@ -193,10 +502,18 @@ void agentite_profiler_reset(Agentite_Profiler *profiler) {
     profiler->max_frame_time_ms = 0.0;
     profiler->scope_depth = 0;
     profiler->named_scope_count = 0;
+    reset_scope_tree(profiler);
+    profiler->spike_next = 0;
+    profiler->spike_count = 0;
 
     memset(profiler->frame_history, 0, profiler->config.history_size * sizeof(float));
     memset(&profiler->render_stats, 0, sizeof(profiler->render_stats));
     memset(&profiler->memory_stats, 0, sizeof(profiler->memory_stats));
+    memset(&profiler->last_frame_allocs, 0, sizeof(profiler->last_frame_allocs));
+    if (profiler->alloc_history) {
+        memset(profiler->alloc_history, 0,
+               profiler->config.history_size * sizeof(Agentite_AllocStats));
+    }
 }
 
 /* ============================================================================
@@ -206,7 +523,19 @@ void agentite_profiler_reset(Agentite_Profiler *profiler) {
 void agentite_profiler_begin_frame(Agentite_Profiler *profiler) {
     if (!profiler || !profiler->config.enabled) return;
 
+    /* An armed capture starts on a frame boundary */
+    if (profiler->trace_armed_frames > 0) {
+        profiler->trace_frames_left = profiler->trace_armed_frames;
+        profiler->trace_armed_frames = 0;
+        profiler->trace_start = trace_clock();
+        profiler->tracing.store(true, std::memory_order_release);
+    }
+    agentite_profiler_trace_begin(profiler, "frame");
+
     profiler->frame_start_time = SDL_GetPerformanceCounter();
+    if (profiler->alloc_history) {
+        agentite_alloc_get_stats(&profiler->alloc_frame_start);
+    }
 
     /* Reset per-frame counters */
     memset(&profiler->render_stats, 0, sizeof(profiler->render_stats));
@@ -219,6 +548,10 @@ void agentite_profiler_begin_frame(Agentite_Profiler *profiler) {
         profiler->named_scopes[i].total_time_ms = 0.0;
         profiler->named_scopes[i].call_count = 0;
     }
+    for (uint32_t i = 0; i < profiler->tree_count; i++) {
+        profiler->tree[i].time_ms = 0.0;
+        profiler->tree[i].call_count = 0;
+    }
 }
 
 void agentite_profiler_end_frame(Agentite_Profiler *profiler) {
@@ -228,9 +561,27 @@ void agentite_profiler_end_frame(Agentite_Profiler *profiler) {
     uint64_t elapsed = end_time - profiler->frame_start_time;
     double frame_time_ms = ticks_to_ms(elapsed, profiler->perf_freq);
 
+    agentite_profiler_trace_end(profiler);
+    if (profiler->tracing.load(std::memory_order_relaxed) &&
+        profiler->trace_frames_left > 0 && --profiler->trace_frames_left == 0) {
+        trace_stop_capture(profiler);
+    }
+
     profiler->last_frame_time_ms = frame_time_ms;
     profiler->frame_count++;
 
+    /* Allocations made since begin_frame, on any thread */
+    if (profiler->alloc_history) {
+        Agentite_AllocStats now;
+        agentite_alloc_get_stats(&now);
+        agentite_alloc_stats_delta(&profiler->alloc_frame_start, &now,
+                                   &profiler->last_frame_allocs);
+        profiler->alloc_history[(profiler->frame_count - 1) % profiler->config.history_size] =
+            profiler->last_frame_allocs;
+        profiler->memory_stats.total_allocations += profiler->last_frame_allocs.total.allocations;
+        profiler->memory_stats.total_frees += profiler->last_frame_allocs.total.frees;
+    }
+
     /* Add to history ring buffer */
     profiler->frame_history[profiler->history_index] = (float)frame_time_ms;
     profiler->history_index = (profiler->history_index + 1) % profiler->config.history_size;
@@ -266,6 +617,25 @@ void agentite_profiler_end_frame(Agentite_Profiler *profiler) {
             }
         }
     }
+
+    /* Update scope tree averages */
+    for (uint32_t i = 0; i < profiler->tree_count; i++) {
+        Agentite_ScopeNode *node = &profiler->tree[i];
+        TreeLink *tl = &profiler->tree_links[i];
+        if (node->call_count > 0) {
+            tl->accumulated_ms += node->time_ms;
+            tl->sample_count++;
+            node->avg_time_ms = tl->accumulated_ms / tl->sample_count;
+            if (node->time_ms > node->max_time_ms) {
+                node->max_time_ms = node->time_ms;
+            }
+        }
+    }
+
+    if (profiler->config.spike_threshold_ms > 0.0 &&
+        frame_time_ms > profiler->config.spike_threshold_ms) {
+        capture_spike(profiler, frame_time_ms);
+    }
 }
 
 /* ============================================================================
@@ -274,33 +644,39 @@ void agentite_profiler_end_frame(Agentite_Profiler *profiler) {
 
 void agentite_profiler_begin_update(Agentite_Profiler *profiler) {
     if (!profiler || !profiler->config.enabled) return;
+    agentite_profiler_trace_begin(profiler, "update");
     profiler->update_start = SDL_GetPerformanceCounter();
 }
 
 void agentite_profiler_end_update(Agentite_Profiler *profiler) {
     if (!profiler || !profiler->config.enabled) return;
+    agentite_profiler_trace_end(profiler);
     uint64_t elapsed = SDL_GetPerformanceCounter() - profiler->update_start;
     profiler->update_time_ms = ticks_to_ms(elapsed, profiler->perf_freq);
 }
 
 void agentite_profiler_begin_render(Agentite_Profiler *profiler) {
     if (!profiler || !profiler->config.enabled) return;
+    agentite_profiler_trace_begin(profiler, "render");
     profiler->render_start = SDL_GetPerformanceCounter();
 }
 
 void agentite_profiler_end_render(Agentite_Profiler *profiler) {
     if (!profiler || !profiler->config.enabled) return;
+    agentite_profiler_trace_end(profiler);
     uint64_t elapsed = SDL_GetPerformanceCounter() - profiler->render_start;
     profiler->render_time_ms = ticks_to_ms(elapsed, profiler->perf_freq);
 }
 
 void agentite_profiler_begin_present(Agentite_Profiler *profiler) {
     if (!profiler || !profiler->config.enabled) return;
+    agentite_profiler_trace_begin(profiler, "present");
     profiler->present_start = SDL_GetPerformanceCounter();
 }
 
 void agentite_profiler_end_present(Agentite_Profiler *profiler) {
     if (!profiler || !profiler->config.enabled) return;
+    agentite_profiler_trace_end(profiler);
     uint64_t elapsed = SDL_GetPerformanceCounter() - profiler->present_start;
     profiler->present_time_ms = ticks_to_ms(elapsed, profiler->perf_freq);
 }
@@ -323,6 +699,12 @@ void agentite_profiler_begin_scope(Agentite_Profiler *profiler, const char *name
     ScopeEntry *entry = &profiler->scope_stack[profiler->scope_depth++];
     strncpy(entry->name, name, AGENTITE_PROFILER_MAX_SCOPE_NAME - 1);
     entry->name[AGENTITE_PROFILER_MAX_SCOPE_NAME - 1] = '\0';
+    entry->parent_node = profiler->tree_current;
+    entry->node = get_or_create_tree_node(profiler, profiler->tree_current, name);
+    if (entry->node >= 0) {
+        profiler->tree_current = entry->node;
+    }
+    agentite_profiler_trace_begin(profiler, name);
     entry->start_time = SDL_GetPerformanceCounter();
 }
 
@@ -340,6 +722,7 @@ void agentite_profiler_end_scope(Agentite_Profiler *profiler) {
 
     uint64_t elapsed = SDL_GetPerformanceCounter() - entry->start_time;
     double elapsed_ms = ticks_to_ms(elapsed, profiler->perf_freq);
+    agentite_profiler_trace_end(profiler);
 
     /* Update named scope stats */
     NamedScope *scope = get_or_create_named_scope(profiler, entry->name);
@@ -347,6 +730,31 @@ void agentite_profiler_end_scope(Agentite_Profiler *profiler) {
         scope->total_time_ms += elapsed_ms;
         scope->call_count++;
     }
+
+    /* Update the scope tree */
+    if (entry->node >= 0) {
+        profiler->tree[entry->node].time_ms += elapsed_ms;
+        profiler->tree[entry->node].call_count++;
+    }
+    profiler->tree_current = entry->parent_node;
+}
+
+void agentite_profiler_record_scope(Agentite_Profiler *profiler, const char *name,
+                                    double time_ms) {
+    if (!profiler || !profiler->config.enabled || !profiler->config.track_scopes) return;
+    if (!name) return;
+
+    NamedScope *scope = get_or_create_named_scope(profiler, name);
+    if (scope) {
+        scope->total_time_ms += time_ms;
+        scope->call_count++;
+    }
+
+    int32_t node = get_or_create_tree_node(profiler, profiler->tree_current, name);
+    if (node >= 0) {
+        profiler->tree[node].time_ms += time_ms;
+        profiler->tree[node].call_count++;
+    }
 }
 
 const Agentite_ScopeStats *agentite_profiler_get_scope(
@@ -369,6 +777,125 @@ const Agentite_ScopeStats *agentite_profiler_get_scope(
     return nullptr;
 }
 
+/* ============================================================================
+ * Scope Tree and Spikes
+ * ============================================================================ */
+
+const Agentite_ScopeNode *agentite_profiler_get_scope_tree(
+    const Agentite_Profiler *profiler, uint32_t *out_count) {
+    if (out_count) *out_count = profiler ? profiler->tree_count : 0;
+    return profiler ? profiler->tree : nullptr;
+}
+
+void agentite_profiler_set_spike_threshold(Agentite_Profiler *profiler, double threshold_ms) {
+    if (profiler) {
+        profiler->config.spike_threshold_ms = threshold_ms;
+    }
+}
+
+uint32_t agentite_profiler_get_spike_count(const Agentite_Profiler *profiler) {
+    return profiler ? profiler->spike_count : 0;
+}
+
+const Agentite_ProfilerSpike *agentite_profiler_get_spike(
+    const Agentite_Profiler *profiler, uint32_t index) {
+    if (!profiler || index >= profiler->spike_count) return nullptr;
+
+    uint32_t slot = (profiler->spike_next + AGENTITE_PROFILER_MAX_SPIKES - 1 - index) %
+                    AGENTITE_PROFILER_MAX_SPIKES;
+    return &profiler->spikes[slot];
+}
+
+void agentite_profiler_clear_spikes(Agentite_Profiler *profiler) {
+    if (profiler) {
+        profiler->spike_next = 0;
+        profiler->spike_count = 0;
+    }
+}
+
+/* ============================================================================
+ * Tracing
+ * ============================================================================ */
+
+bool agentite_profiler_trace_start(Agentite_Profiler *profiler, uint32_t frame_count) {
+    if (!profiler) {
+        agentite_set_error("Invalid profiler");
+        return false;
+    }
+    if (agentite_profiler_is_tracing(profiler)) {
+        agentite_set_error("Profiler trace capture already running");
+        return false;
+    }
+
+    if (frame_count > 0) {
+        profiler->trace_armed_frames = frame_count;
+    } else {
+        profiler->trace_frames_left = 0;
+        profiler->trace_start = trace_clock();
+        profiler->tracing.store(true, std::memory_order_release);
+    }
+    return true;
+}
+
+void agentite_profiler_trace_stop(Agentite_Profiler *profiler) {
+    if (!profiler) return;
+
+    profiler->trace_armed_frames = 0;
+    if (profiler->tracing.load(std::memory_order_relaxed)) {
+        trace_stop_capture(profiler);
+    }
+}
+
+bool agentite_profiler_is_tracing(const Agentite_Profiler *profiler) {
+    return profiler && (profiler->trace_armed_frames > 0 ||
+                        profiler->tracing.load(std::memory_order_relaxed));
+}
+
+void agentite_profiler_trace_begin(Agentite_Profiler *profiler, const char *name) {
+    if (!profiler || !name) return;
+
+    bool tracing = profiler->tracing.load(std::memory_order_relaxed);
+    TraceThread *t = get_trace_thread(profiler, tracing);
+    if (!t) return;
+
+    if (t->depth < AGENTITE_PROFILER_MAX_SCOPE_DEPTH) {
+        TraceOpenScope *scope = &t->stack[t->depth];
+        scope->name = name;
+        scope->begin = tracing ? trace_clock() : 0;
+    }
+    t->depth++;
+}
+
+void agentite_profiler_trace_end(Agentite_Profiler *profiler) {
+    if (!profiler) return;
+
+    TraceThread *t = get_trace_thread(profiler, false);
+    if (!t || t->depth == 0) return;
+
+    t->depth--;
+    if (t->depth >= AGENTITE_PROFILER_MAX_SCOPE_DEPTH) return;
+
+    const TraceOpenScope *scope = &t->stack[t->depth];
+    if (scope->begin == 0 || !profiler->tracing.load(std::memory_order_relaxed)) return;
+
+    uint64_t head = t->head.load(std::memory_order_relaxed);
+    TraceEvent *event = &t->events[head & t->mask];
+    event->name = scope->name;
+    event->begin = scope->begin;
+    event->end = trace_clock();
+    t->head.store(head + 1, std::memory_order_release);
+}
+
+void agentite_profiler_trace_set_thread_name(Agentite_Profiler *profiler, const char *name) {
+    if (!profiler || !name) return;
+
+    TraceThread *t = get_trace_thread(profiler, true);
+    if (t) {
+        strncpy(t->name, name, sizeof(t->name) - 1);
+        t->name[sizeof(t->name) - 1] = '\0';
+    }
+}
+
 /* ============================================================================
  * Statistics Reporting
  * ============================================================================ */
@@ -448,6 +975,19 @@ void agentite_profiler_get_memory_stats(
     *out_stats = profiler->memory_stats;
 }
 
+bool agentite_profiler_get_frame_allocs(
+    const Agentite_Profiler *profiler, uint64_t frame_number, Agentite_AllocStats *out) {
+    if (!profiler || !out || !profiler->alloc_history) return false;
+
+    /* Frames 1..frame_count, of which the last history_count are kept */
+    if (frame_number == 0 || frame_number > profiler->frame_count ||
+        profiler->frame_count - frame_number >= profiler->history_count) {
+        return false;
+    }
+    *out = profiler->alloc_history[(frame_number - 1) % profiler->config.history_size];
+    return true;
+}
+
 /* ============================================================================
  * Statistics Access
  * ============================================================================ */
@@ -483,6 +1023,7 @@ const Agentite_ProfilerStats *agentite_profiler_get_stats(
 
     /* Memory stats */
     stats->memory = profiler->memory_stats;
+    stats->frame_allocs = profiler->last_frame_allocs;
 
     /* Named scopes */
     stats->scope_count = 0;
@@ -529,6 +1070,46 @@ uint32_t agentite_profiler_get_history_size(const Agentite_Profiler *profiler) {
  * Export Functions
  * ============================================================================ */
 
+/** Write the children of parent as a nested JSON array */
+static void write_scope_tree_json(FILE *f, const Agentite_ScopeNode *nodes, uint32_t count,
+                                  int32_t parent, int level) {
+    bool first = true;
+    fprintf(f, "[");
+    for (uint32_t i = 0; i < count; i++) {
+        const Agentite_ScopeNode *node = &nodes[i];
+        if (node->parent != parent) continue;
+
+        fprintf(f, "%s\n%*s{\"name\": ", first ? "" : ",", (level + 1) * 2, "");
+        write_json_string(f, node->name);
+        fprintf(f, ", \"time_ms\": %.4f, \"avg_ms\": %.4f, \"max_ms\": %.4f, "
+                "\"call_count\": %u, \"children\": ",
+                node->time_ms, node->avg_time_ms, node->max_time_ms, node->call_count);
+        write_scope_tree_json(f, nodes, count, (int32_t)i, level + 1);
+        fprintf(f, "}");
+        first = false;
+    }
+    if (!first) {
+        fprintf(f, "\n%*s", level * 2, "");
+    }
+    fprintf(f, "]");
+}
+
+/** Write per-tag allocation counters as a JSON object keyed by tag name */
+static void write_alloc_stats_json(FILE *f, const Agentite_AllocStats *allocs, int level) {
+    fprintf(f, "{\n");
+    for (int i = 0; i < AGENTITE_ALLOC_TAG_COUNT; i++) {
+        const Agentite_AllocTagStats *t = &allocs->tags[i];
+        fprintf(f, "%*s\"%s\": {\"allocations\": %llu, \"frees\": %llu, \"bytes\": %llu},\n",
+                (level + 1) * 2, "", agentite_alloc_tag_name((Agentite_AllocTag)i),
+                (unsigned long long)t->allocations, (unsigned long long)t->frees,
+                (unsigned long long)t->bytes);
+    }
+    fprintf(f, "%*s\"total\": {\"allocations\": %llu, \"frees\": %llu, \"bytes\": %llu}\n",
+            (level + 1) * 2, "", (unsigned long long)allocs->total.allocations,
+            (unsigned long long)allocs->total.frees, (unsigned long long)allocs->total.bytes);
+    fprintf(f, "%*s}", level * 2, "");
+}
+
 bool agentite_profiler_export_csv(
     const Agentite_Profiler *profiler, const char *path) {
     if (!profiler || !path) {
@@ -575,6 +1156,12 @@ bool agentite_profiler_export_csv(
     fprintf(f, "memory_total_allocations,%zu\n", stats->memory.total_allocations);
     fprintf(f, "memory_allocation_count,%zu\n", stats->memory.allocation_count);
 
+    /* Allocations during the last frame, by tag */
+    for (int i = 0; i < AGENTITE_ALLOC_TAG_COUNT; i++) {
+        fprintf(f, "frame_allocs_%s,%llu\n", agentite_alloc_tag_name((Agentite_AllocTag)i),
+                (unsigned long long)stats->frame_allocs.tags[i].allocations);
+    }
+
     fclose(f);
     return true;
 }
@@ -626,6 +1213,10 @@ bool agentite_profiler_export_json(
     fprintf(f, "    \"allocation_count\": %zu\n", stats->memory.allocation_count);
     fprintf(f, "  },\n");
 
+    fprintf(f, "  \"frame_allocs\": ");
+    write_alloc_stats_json(f, &stats->frame_allocs, 1);
+    fprintf(f, ",\n");
+
     fprintf(f, "  \"entity_count\": %u,\n", stats->entity_count);
 
     fprintf(f, "  \"scopes\": [\n");
@@ -640,6 +1231,28 @@ bool agentite_profiler_export_json(
         fprintf(f, "      \"call_count\": %u\n", scope->call_count);
         fprintf(f, "    }%s\n", (i < stats->scope_count - 1) ? "," : "");
     }
+    fprintf(f, "  ],\n");
+
+    fprintf(f, "  \"scope_tree\": ");
+    write_scope_tree_json(f, profiler->tree, profiler->tree_count, -1, 1);
+    fprintf(f, ",\n");
+
+    fprintf(f, "  \"spikes\": [\n");
+    for (uint32_t i = 0; i < profiler->spike_count; i++) {
+        const Agentite_ProfilerSpike *spike = agentite_profiler_get_spike(profiler, i);
+        fprintf(f, "    {\n");
+        fprintf(f, "      \"frame\": %llu,\n", (unsigned long long)spike->frame_number);
+        fprintf(f, "      \"time_ms\": %.4f,\n", spike->frame_time_ms);
+        fprintf(f, "      \"update_ms\": %.4f,\n", spike->update_time_ms);
+        fprintf(f, "      \"render_ms\": %.4f,\n", spike->render_time_ms);
+        fprintf(f, "      \"present_ms\": %.4f,\n", spike->present_time_ms);
+        fprintf(f, "      \"allocations\": ");
+        write_alloc_stats_json(f, &spike->allocs, 3);
+        fprintf(f, ",\n");
+        fprintf(f, "      \"tree\": ");
+        write_scope_tree_json(f, spike->nodes, spike->node_count, -1, 3);
+        fprintf(f, "\n    }%s\n", (i < profiler->spike_count - 1) ? "," : "");
+    }
     fprintf(f, "  ]\n");
 
     fprintf(f, "}\n");
@@ -648,6 +1261,68 @@ bool agentite_profiler_export_json(
     return true;
 }
 
+size_t agentite_profiler_get_trace_event_count(const Agentite_Profiler *profiler) {
+    if (!profiler || agentite_profiler_is_tracing(profiler)) return 0;
+
+    size_t count = 0;
+    for_each_trace_event(profiler, [&count](const TraceThread *, const TraceEvent *) {
+        count++;
+    });
+    return count;
+}
+
+bool agentite_profiler_export_trace(
+    const Agentite_Profiler *profiler, const char *path) {
+    if (!profiler || !path) {
+        agentite_set_error("Invalid profiler or path");
+        return false;
+    }
+    if (agentite_profiler_is_tracing(profiler)) {
+        agentite_set_error("Profiler trace capture still running");
+        return false;
+    }
+
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        agentite_set_error("Failed to open file for writing: %s", path);
+        return false;
+    }
+
+    /* Chrome trace-event format: complete ("X") events in microseconds */
+    const double us_per_tick = 1000000.0 / trace_clock_frequency(profiler);
+    bool first = true;
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    const TraceThread *t = profiler->trace_threads.load(std::memory_order_acquire);
+    for (; t; t = t->next) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                "\"args\":{\"name\":", first ? "" : ",\n", t->index);
+        write_json_string(f, t->name);
+        fprintf(f, "}}");
+        first = false;
+    }
+
+    for_each_trace_event(profiler, [&](const TraceThread *thread, const TraceEvent *event) {
+        fprintf(f, "%s{\"name\":", first ? "" : ",\n");
+        write_json_string(f, event->name);
+        fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                thread->index,
+                (double)(event->begin - profiler->trace_start) * us_per_tick,
+                (double)(event->end - event->begin) * us_per_tick);
+        first = false;
+    });
+
+    fprintf(f, "\n]}\n");
+
+    bool ok = !ferror(f);
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) {
+        agentite_set_error("Failed to write trace: %s", path);
+    }
+    return ok;
+}
+
 bool agentite_profiler_export_frame_history_csv(
     const Agentite_Profiler *profiler, const char *path) {
     if (!profiler || !path) {
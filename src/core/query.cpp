@@ -6,6 +6,7 @@
 
 #include "agentite/agentite.h"
 #include "agentite/query.h"
+#include "agentite/arena.h"
 #include "agentite/error.h"
 #include "agentite/validate.h"
 
@@ -32,6 +33,14 @@ typedef struct QueryCacheEntry {
     uint64_t cache_key;             /* Parameter hash */
     uint32_t timestamp;             /* When cached */
     bool valid;                     /* Entry is valid */
+    bool computing;                 /* Query is running into this slot */
+
+    /* Revision vector: sources read and their revisions at the time */
+    uint32_t epoch;                 /* System dep epoch when last verified */
+    int dep_count;
+    Agentite_QueryDep deps[AGENTITE_QUERY_MAX_ENTRY_DEPS];
+    uint32_t revisions[AGENTITE_QUERY_MAX_ENTRY_DEPS];
+
     uint8_t data[AGENTITE_QUERY_MAX_RESULT_SIZE];  /* Cached result */
 } QueryCacheEntry;
 
@@ -66,8 +75,23 @@ typedef struct RegisteredQuery {
     /* Tags */
     char tags[MAX_TAGS_PER_QUERY][TAG_MAX_LEN];
     int tag_count;
+
+    /* Sources read on every execution */
+    Agentite_QueryDep static_deps[AGENTITE_QUERY_MAX_ENTRY_DEPS];
+    int static_dep_count;
 } RegisteredQuery;
 
+/**
+ * Sources read by the query currently running. Lives on the stack of the
+ * executing call; nested queries merge theirs into the outer tracker.
+ */
+typedef struct DepTracker {
+    Agentite_QueryDep deps[AGENTITE_QUERY_MAX_ENTRY_DEPS];
+    uint32_t revisions[AGENTITE_QUERY_MAX_ENTRY_DEPS];
+    int count;
+    bool overflow;                  /* Too many sources; result is not cached */
+} DepTracker;
+
 /**
  * Query system.
  */
@@ -82,6 +106,13 @@ struct Agentite_QuerySystem {
     Agentite_QueryInvalidateCallback invalidate_callback;
     void *invalidate_userdata;
 
+    /* Dependency sources (index = dep - 1) */
+    char dep_names[AGENTITE_QUERY_MAX_DEPS][AGENTITE_QUERY_MAX_NAME_LEN];
+    uint32_t dep_revisions[AGENTITE_QUERY_MAX_DEPS];
+    int dep_count;
+    uint32_t dep_epoch;             /* Bumped with any source */
+    DepTracker *tracker;            /* Innermost running query */
+
     /* Statistics */
     Agentite_QueryStats stats;
 };
@@ -122,7 +153,7 @@ static RegisteredQuery *find_query_const(const Agentite_QuerySystem *sys, const
 
 static void free_cache(QueryCache *cache) {
     if (cache->entries) {
-        free(cache->entries);
+        AGENTITE_FREE(cache->entries);
         cache->entries = NULL;
     }
     cache->max_entries = 0;
@@ -168,27 +199,38 @@ static QueryCacheEntry *cache_lookup(QueryCache *cache, uint64_t key) {
     return NULL;
 }
 
-static QueryCacheEntry *cache_get_slot(QueryCache *cache) {
+/**
+ * Find a slot for a new entry. When every slot holds a valid result the
+ * oldest is returned with *evict set; it stays valid until the caller
+ * commits a replacement, so a failed compute loses nothing.
+ */
+static QueryCacheEntry *cache_get_slot(QueryCache *cache, bool *evict) {
+    *evict = false;
     if (!cache->entries) return NULL;
 
-    /* Find empty slot or oldest entry */
+    /* Reuse a stale or failed slot before growing */
+    for (int i = 0; i < cache->count; i++) {
+        if (!cache->entries[i].valid && !cache->entries[i].computing) {
+            return &cache->entries[i];
+        }
+    }
     if (cache->count < cache->max_entries) {
         return &cache->entries[cache->count++];
     }
 
     /* Evict oldest (simple FIFO for now) */
-    QueryCacheEntry *oldest = &cache->entries[0];
-    uint32_t oldest_time = oldest->timestamp;
-
-    for (int i = 1; i < cache->count; i++) {
-        if (cache->entries[i].timestamp < oldest_time) {
-            oldest = &cache->entries[i];
-            oldest_time = oldest->timestamp;
+    QueryCacheEntry *oldest = NULL;
+    for (int i = 0; i < cache->count; i++) {
+        QueryCacheEntry *e = &cache->entries[i];
+        if (!e->computing && (!oldest || e->timestamp < oldest->timestamp)) {
+            oldest = e;
         }
     }
+    if (!oldest) {
+        return NULL;  /* Every slot belongs to a running (recursive) query */
+    }
 
-    cache->evictions++;
-    oldest->valid = false;
+    *evict = oldest->valid;
     return oldest;
 }
 
@@ -208,6 +250,53 @@ static uint64_t default_hash_params(const Agentite_QueryParams *params) {
     return fnv1a_hash(params->params, params->count * sizeof(Agentite_QueryParam));
 }
 
+static inline bool dep_valid(const Agentite_QuerySystem *sys, Agentite_QueryDep dep) {
+    return dep > 0 && dep <= sys->dep_count;
+}
+
+static void tracker_add(DepTracker *t, Agentite_QueryDep dep, uint32_t revision) {
+    for (int i = 0; i < t->count; i++) {
+        if (t->deps[i] == dep) return;  /* First read wins */
+    }
+    if (t->count >= AGENTITE_QUERY_MAX_ENTRY_DEPS) {
+        t->overflow = true;
+        return;
+    }
+    t->deps[t->count] = dep;
+    t->revisions[t->count] = revision;
+    t->count++;
+}
+
+/* A result read from the cache counts as reading everything it read */
+static void tracker_merge_entry(DepTracker *t, const QueryCacheEntry *entry) {
+    for (int i = 0; i < entry->dep_count; i++) {
+        tracker_add(t, entry->deps[i], entry->revisions[i]);
+    }
+}
+
+static void tracker_merge(DepTracker *t, const DepTracker *from) {
+    for (int i = 0; i < from->count; i++) {
+        tracker_add(t, from->deps[i], from->revisions[i]);
+    }
+    if (from->overflow) {
+        t->overflow = true;
+    }
+}
+
+/* Compare the entry's revision vector, skipping it when nothing was bumped */
+static bool entry_is_fresh(const Agentite_QuerySystem *sys, QueryCacheEntry *entry) {
+    if (entry->epoch == sys->dep_epoch) {
+        return true;
+    }
+    for (int i = 0; i < entry->dep_count; i++) {
+        if (sys->dep_revisions[entry->deps[i] - 1] != entry->revisions[i]) {
+            return false;
+        }
+    }
+    entry->epoch = sys->dep_epoch;
+    return true;
+}
+
 /*============================================================================
  * Lifecycle
  *============================================================================*/
@@ -238,7 +327,7 @@ void agentite_query_destroy(Agentite_QuerySystem *sys) {
         }
     }
 
-    free(sys);
+    AGENTITE_FREE(sys);
 }
 
 /*============================================================================
@@ -341,66 +430,213 @@ int agentite_query_get_names(const Agentite_QuerySystem *sys, const char **names
  * Query Execution
  *============================================================================*/
 
-Agentite_QueryStatus agentite_query_exec(Agentite_QuerySystem *sys,
-                                       const char *name,
+/**
+ * Shared execution path. Copies the result to out_copy and/or points
+ * out_ref at it; a hit reads the cache slot, a miss runs the query straight
+ * into the slot it will be cached in.
+ */
+static Agentite_QueryStatus exec_query(Agentite_QuerySystem *sys,
+                                       RegisteredQuery *q,
                                        void *game_state,
                                        const Agentite_QueryParams *params,
-                                       void *result) {
-    AGENTITE_VALIDATE_PTR_RET(sys, AGENTITE_QUERY_INVALID_PARAMS);
-    AGENTITE_VALIDATE_PTR_RET(name, AGENTITE_QUERY_INVALID_PARAMS);
-    AGENTITE_VALIDATE_PTR_RET(result, AGENTITE_QUERY_INVALID_PARAMS);
-
-    RegisteredQuery *q = find_query(sys, name);
-    if (!q) {
-        return AGENTITE_QUERY_NOT_FOUND;
-    }
-
+                                       void *out_copy,
+                                       const void **out_ref) {
     sys->stats.total_executions++;
 
+    QueryCacheEntry *slot = NULL;
+    uint64_t cache_key = 0;
+    bool evict = false;
+
     /* Check cache */
     if (q->cache_enabled && q->cache.entries) {
-        uint64_t cache_key = q->key_fn ?
+        cache_key = q->key_fn ?
             q->key_fn(params, q->key_userdata) :
             default_hash_params(params);
 
         QueryCacheEntry *entry = cache_lookup(&q->cache, cache_key);
-        if (entry && entry->valid) {
+        if (entry && entry_is_fresh(sys, entry)) {
             /* Cache hit */
             q->cache.hits++;
             sys->stats.total_cache_hits++;
-            memcpy(result, entry->data, q->result_size);
+            if (sys->tracker) {
+                tracker_merge_entry(sys->tracker, entry);
+            }
+            if (out_copy) {
+                memcpy(out_copy, entry->data, q->result_size);
+            }
+            if (out_ref) {
+                *out_ref = entry->data;
+            }
             return AGENTITE_QUERY_CACHE_HIT;
         }
 
+        if (entry) {
+            /* Stale: recompute in the same slot */
+            entry->valid = false;
+            sys->stats.total_cache_stale++;
+            slot = entry;
+        } else {
+            slot = cache_get_slot(&q->cache, &evict);
+        }
+
         q->cache.misses++;
         sys->stats.total_cache_misses++;
     }
 
+    void *target = slot ? slot->data : out_copy;
+    if (!target) {
+        agentite_set_error("agentite_query_exec_ref: query '%s' has no free cache slot", q->name);
+        sys->stats.total_failures++;
+        return AGENTITE_QUERY_FAILED;
+    }
+
+    /* Compute beside an eviction victim; it is replaced only on success */
+    void *scratch = NULL;
+    if (evict) {
+        if (out_copy) {
+            target = out_copy;
+        } else if ((scratch = AGENTITE_MALLOC(q->result_size)) != NULL) {
+            target = scratch;
+        } else {
+            /* No scratch space: give the victim up front */
+            q->cache.evictions++;
+            slot->valid = false;
+            evict = false;
+        }
+    }
+
+    /* Static dependencies are read at their current revision */
+    DepTracker tracker;
+    tracker.count = 0;
+    tracker.overflow = false;
+    for (int i = 0; i < q->static_dep_count; i++) {
+        tracker_add(&tracker, q->static_deps[i], sys->dep_revisions[q->static_deps[i] - 1]);
+    }
+
     /* Execute query */
-    Agentite_QueryStatus status = q->query_fn(game_state, params, result,
+    DepTracker *outer = sys->tracker;
+    sys->tracker = &tracker;
+    if (slot) {
+        slot->computing = true;
+    }
+    Agentite_QueryStatus status = q->query_fn(game_state, params, target,
                                              q->result_size, q->userdata);
+    if (slot) {
+        slot->computing = false;
+    }
+    sys->tracker = outer;
+    if (outer) {
+        tracker_merge(outer, &tracker);
+    }
 
     if (status != AGENTITE_QUERY_OK) {
+        AGENTITE_FREE(scratch);
         sys->stats.total_failures++;
         return status;
     }
 
-    /* Cache result */
-    if (q->cache_enabled && q->cache.entries) {
-        uint64_t cache_key = q->key_fn ?
-            q->key_fn(params, q->key_userdata) :
-            default_hash_params(params);
+    /* A reference needs the result in the cache, cacheable or not */
+    bool cacheable = !tracker.overflow;
+    if (evict && (cacheable || out_ref)) {
+        q->cache.evictions++;
+        memcpy(slot->data, target, q->result_size);
+        target = slot->data;
+    } else if (evict) {
+        slot = NULL;    /* Result stays in out_copy, victim kept */
+    }
+    AGENTITE_FREE(scratch);
+
+    /* Cache result (unless its dependencies could not all be recorded) */
+    if (slot && !cacheable) {
+        slot->valid = false;
+    } else if (slot) {
+        slot->cache_key = cache_key;
+        slot->timestamp = sys->timestamp++;
+        slot->valid = true;
+        slot->epoch = sys->dep_epoch;
+        slot->dep_count = tracker.count;
+        memcpy(slot->deps, tracker.deps, (size_t)tracker.count * sizeof(tracker.deps[0]));
+        memcpy(slot->revisions, tracker.revisions, (size_t)tracker.count * sizeof(tracker.revisions[0]));
+    }
+
+    if (out_copy && target != out_copy) {
+        memcpy(out_copy, target, q->result_size);
+    }
+    if (out_ref) {
+        *out_ref = target;
+    }
+    return AGENTITE_QUERY_OK;
+}
+
+Agentite_QueryStatus agentite_query_exec(Agentite_QuerySystem *sys,
+                                       const char *name,
+                                       void *game_state,
+                                       const Agentite_QueryParams *params,
+                                       void *result) {
+    AGENTITE_VALIDATE_PTR_RET(sys, AGENTITE_QUERY_INVALID_PARAMS);
+    AGENTITE_VALIDATE_PTR_RET(name, AGENTITE_QUERY_INVALID_PARAMS);
+    AGENTITE_VALIDATE_PTR_RET(result, AGENTITE_QUERY_INVALID_PARAMS);
+
+    RegisteredQuery *q = find_query(sys, name);
+    if (!q) {
+        return AGENTITE_QUERY_NOT_FOUND;
+    }
 
-        QueryCacheEntry *slot = cache_get_slot(&q->cache);
-        if (slot) {
-            slot->cache_key = cache_key;
-            slot->timestamp = sys->timestamp++;
-            slot->valid = true;
-            memcpy(slot->data, result, q->result_size);
+    return exec_query(sys, q, game_state, params, result, NULL);
+}
+
+const void *agentite_query_exec_ref(Agentite_QuerySystem *sys,
+                                    const char *name,
+                                    void *game_state,
+                                    const Agentite_QueryParams *params,
+                                    Agentite_QueryStatus *out_status) {
+    Agentite_QueryStatus status = AGENTITE_QUERY_INVALID_PARAMS;
+    const void *result = NULL;
+
+    RegisteredQuery *q = (sys && name) ? find_query(sys, name) : NULL;
+    if (sys && name && !q) {
+        status = AGENTITE_QUERY_NOT_FOUND;
+    } else if (q && !(q->cache_enabled && q->cache.entries)) {
+        agentite_set_error("agentite_query_exec_ref: query '%s' is not cached", name);
+    } else if (q) {
+        status = exec_query(sys, q, game_state, params, NULL, &result);
+        if (status != AGENTITE_QUERY_OK && status != AGENTITE_QUERY_CACHE_HIT) {
+            result = NULL;
         }
     }
 
-    return AGENTITE_QUERY_OK;
+    if (out_status) {
+        *out_status = status;
+    }
+    return result;
+}
+
+void *agentite_query_exec_frame(Agentite_QuerySystem *sys,
+                                const char *name,
+                                void *game_state,
+                                const Agentite_QueryParams *params,
+                                Agentite_Arena *arena,
+                                Agentite_QueryStatus *out_status) {
+    Agentite_QueryStatus status = AGENTITE_QUERY_INVALID_PARAMS;
+    void *result = NULL;
+
+    RegisteredQuery *q = (sys && name && arena) ? find_query(sys, name) : NULL;
+    if (sys && name && arena && !q) {
+        status = AGENTITE_QUERY_NOT_FOUND;
+    }
+    if (q) {
+        result = agentite_arena_calloc(arena, 1, q->result_size);
+        status = result ? agentite_query_exec(sys, name, game_state, params, result)
+                        : AGENTITE_QUERY_FAILED;
+        if (status != AGENTITE_QUERY_OK && status != AGENTITE_QUERY_CACHE_HIT) {
+            result = NULL;
+        }
+    }
+
+    if (out_status) {
+        *out_status = status;
+    }
+    return result;
 }
 
 Agentite_QueryStatus agentite_query_exec_int(Agentite_QuerySystem *sys,
@@ -607,6 +843,74 @@ void agentite_query_clear_cache_stats(Agentite_QuerySystem *sys, const char *nam
     }
 }
 
+/*============================================================================
+ * Dependencies
+ *============================================================================*/
+
+Agentite_QueryDep agentite_query_dep(Agentite_QuerySystem *sys, const char *name) {
+    AGENTITE_VALIDATE_PTR_RET(sys, 0);
+    AGENTITE_VALIDATE_PTR_RET(name, 0);
+
+    for (int i = 0; i < sys->dep_count; i++) {
+        if (strncmp(sys->dep_names[i], name, AGENTITE_QUERY_MAX_NAME_LEN - 1) == 0) {
+            return (Agentite_QueryDep)(i + 1);
+        }
+    }
+
+    if (sys->dep_count >= AGENTITE_QUERY_MAX_DEPS) {
+        agentite_set_error("Query: Maximum dependency sources reached (%d) when adding '%s'",
+                           AGENTITE_QUERY_MAX_DEPS, name);
+        return 0;
+    }
+
+    strncpy(sys->dep_names[sys->dep_count], name, AGENTITE_QUERY_MAX_NAME_LEN - 1);
+    sys->dep_revisions[sys->dep_count] = 1;
+    sys->dep_count++;
+    return (Agentite_QueryDep)sys->dep_count;
+}
+
+void agentite_query_dep_bump(Agentite_QuerySystem *sys, Agentite_QueryDep dep) {
+    AGENTITE_VALIDATE_PTR(sys);
+    if (!dep_valid(sys, dep)) return;
+
+    sys->dep_revisions[dep - 1]++;
+    sys->dep_epoch++;
+}
+
+uint32_t agentite_query_dep_revision(const Agentite_QuerySystem *sys, Agentite_QueryDep dep) {
+    AGENTITE_VALIDATE_PTR_RET(sys, 0);
+    return dep_valid(sys, dep) ? sys->dep_revisions[dep - 1] : 0;
+}
+
+bool agentite_query_add_dep(Agentite_QuerySystem *sys, const char *name, Agentite_QueryDep dep) {
+    AGENTITE_VALIDATE_PTR_RET(sys, false);
+    AGENTITE_VALIDATE_PTR_RET(name, false);
+
+    RegisteredQuery *q = find_query(sys, name);
+    if (!q || !dep_valid(sys, dep)) return false;
+
+    for (int i = 0; i < q->static_dep_count; i++) {
+        if (q->static_deps[i] == dep) return true;
+    }
+    if (q->static_dep_count >= AGENTITE_QUERY_MAX_ENTRY_DEPS) {
+        return false;
+    }
+    q->static_deps[q->static_dep_count++] = dep;
+
+    /* Entries computed without this dependency cannot be trusted */
+    if (q->cache_enabled) {
+        cache_invalidate_all(&q->cache);
+    }
+    return true;
+}
+
+void agentite_query_track(Agentite_QuerySystem *sys, Agentite_QueryDep dep) {
+    AGENTITE_VALIDATE_PTR(sys);
+    if (!sys->tracker || !dep_valid(sys, dep)) return;
+
+    tracker_add(sys->tracker, dep, sys->dep_revisions[dep - 1]);
+}
+
 /*============================================================================
  * Query Tags
  *============================================================================*/
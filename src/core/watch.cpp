@@ -9,6 +9,8 @@
  * Architecture:
  * - Background thread monitors filesystem using platform APIs
  * - Events are queued thread-safely with debouncing
+ * - Pending events are indexed by path so bursts on the same file
+ *   (editor save sequences, temp-file renames) coalesce in O(1)
  * - Main thread polls events via agentite_watch_update()
  * - Callbacks invoked on main thread only
  */
@@ -29,6 +31,10 @@
 #define DEFAULT_EVENT_QUEUE_CAPACITY 256
 #define PATH_BUFFER_SIZE 512
 
+/* Path index slot markers */
+#define PATH_INDEX_EMPTY     (-1)
+#define PATH_INDEX_TOMBSTONE (-2)
+
 /* ============================================================================
  * Internal Types
  * ============================================================================ */
@@ -49,6 +55,7 @@ typedef struct QueuedEvent {
     Agentite_WatchEvent event;
     uint64_t debounce_deadline;  /* When debounce period ends */
     bool pending;                /* True if waiting for debounce */
+    bool cancelled;              /* Coalesced away, skipped on delivery */
 } QueuedEvent;
 
 /**
@@ -68,14 +75,20 @@ struct Agentite_FileWatcher {
     std::atomic<bool> shutdown;
     std::atomic<bool> enabled;
 
-    /* Event queue */
+    /* Event queue (ring buffer, may contain cancelled slots) */
     QueuedEvent *event_queue;
     size_t event_queue_capacity;
     size_t event_queue_head;
     size_t event_queue_tail;
-    std::atomic<size_t> pending_count;
+    size_t event_queue_count;           /* Occupied slots, including cancelled */
+    std::atomic<size_t> pending_count;  /* Live (deliverable) events */
     SDL_Mutex *event_mutex;
 
+    /* Path -> queue slot index for pending events (open addressing) */
+    int32_t *path_index;
+    size_t path_index_capacity;         /* Power of two */
+    size_t path_index_used;             /* Live entries + tombstones */
+
     /* Callback */
     Agentite_WatchCallback callback;
     void *callback_userdata;
@@ -174,57 +187,359 @@ static WatchedPath *find_empty_path_slot(Agentite_FileWatcher *watcher)
     return NULL;
 }
 
+/* ============================================================================
+ * Pending Event Index
+ * ============================================================================ */
+
 /**
- * Queue an event with debouncing.
- * Thread-safe - called from background thread.
+ * FNV-1a hash of a path string.
  */
-static void queue_event(Agentite_FileWatcher *watcher, const Agentite_WatchEvent *event)
+static uint32_t hash_path(const char *path)
 {
-    if (!watcher->enabled.load()) {
-        return;
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)path; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
     }
+    return hash;
+}
 
-    SDL_LockMutex(watcher->event_mutex);
+/**
+ * Insert a queue slot into the path index.
+ * Caller must hold event_mutex and guarantee free space.
+ */
+static void path_index_insert(Agentite_FileWatcher *watcher, const char *path, int32_t slot)
+{
+    size_t mask = watcher->path_index_capacity - 1;
+    size_t i = hash_path(path) & mask;
 
-    /* Check if we should debounce (merge with existing event for same path) */
-    if (watcher->config.debounce_ms > 0) {
-        size_t idx = watcher->event_queue_tail;
-        size_t count = 0;
-        size_t capacity = watcher->event_queue_capacity;
-
-        /* Search backwards for recent events on same path */
-        while (count < watcher->pending_count.load() && count < capacity) {
-            idx = (idx + capacity - 1) % capacity;
-            QueuedEvent *queued = &watcher->event_queue[idx];
-
-            if (queued->pending && strcmp(queued->event.path, event->path) == 0) {
-                /* Update existing event instead of adding new one */
-                queued->event.type = event->type;
-                queued->event.timestamp = event->timestamp;
-                queued->debounce_deadline = get_time_ms() + watcher->config.debounce_ms;
-                SDL_UnlockMutex(watcher->event_mutex);
-                return;
-            }
-            count++;
+    while (watcher->path_index[i] >= 0) {
+        i = (i + 1) & mask;
+    }
+    if (watcher->path_index[i] == PATH_INDEX_EMPTY) {
+        watcher->path_index_used++;
+    }
+    watcher->path_index[i] = slot;
+}
+
+/**
+ * Rebuild the path index from the live queue slots.
+ * Clears tombstones and sizes the table to at least twice the queue capacity.
+ * Caller must hold event_mutex.
+ */
+static bool path_index_rebuild(Agentite_FileWatcher *watcher)
+{
+    size_t capacity = 16;
+    while (capacity < watcher->event_queue_capacity * 2) {
+        capacity *= 2;
+    }
+
+    if (capacity != watcher->path_index_capacity) {
+        int32_t *index = (int32_t *)malloc(capacity * sizeof(int32_t));
+        if (!index) {
+            return false;
+        }
+        free(watcher->path_index);
+        watcher->path_index = index;
+        watcher->path_index_capacity = capacity;
+    }
+
+    memset(watcher->path_index, 0xFF, capacity * sizeof(int32_t));  /* PATH_INDEX_EMPTY */
+    watcher->path_index_used = 0;
+
+    size_t idx = watcher->event_queue_head;
+    for (size_t n = 0; n < watcher->event_queue_count; n++) {
+        QueuedEvent *queued = &watcher->event_queue[idx];
+        if (queued->pending && !queued->cancelled) {
+            path_index_insert(watcher, queued->event.path, (int32_t)idx);
+        }
+        idx = (idx + 1) % watcher->event_queue_capacity;
+    }
+    return true;
+}
+
+/**
+ * Find the pending (undelivered) event for a path.
+ * Caller must hold event_mutex.
+ */
+static QueuedEvent *path_index_find(Agentite_FileWatcher *watcher, const char *path)
+{
+    size_t mask = watcher->path_index_capacity - 1;
+    size_t i = hash_path(path) & mask;
+
+    while (watcher->path_index[i] != PATH_INDEX_EMPTY) {
+        int32_t slot = watcher->path_index[i];
+        if (slot >= 0 && strcmp(watcher->event_queue[slot].event.path, path) == 0) {
+            return &watcher->event_queue[slot];
         }
+        i = (i + 1) & mask;
     }
+    return NULL;
+}
+
+/**
+ * Remove a queue slot from the path index.
+ * Caller must hold event_mutex.
+ */
+static void path_index_remove(Agentite_FileWatcher *watcher, const QueuedEvent *queued)
+{
+    int32_t slot = (int32_t)(queued - watcher->event_queue);
+    size_t mask = watcher->path_index_capacity - 1;
+    size_t i = hash_path(queued->event.path) & mask;
+
+    while (watcher->path_index[i] != PATH_INDEX_EMPTY) {
+        if (watcher->path_index[i] == slot) {
+            watcher->path_index[i] = PATH_INDEX_TOMBSTONE;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+}
 
-    /* Check capacity */
-    size_t max_events = watcher->config.max_events;
-    if (max_events > 0 && watcher->pending_count.load() >= max_events) {
-        /* Queue full, drop oldest event */
-        watcher->event_queue_head = (watcher->event_queue_head + 1) % watcher->event_queue_capacity;
+/* ============================================================================
+ * Event Queue
+ * ============================================================================ */
+
+/**
+ * Pop the slot at the head of the queue.
+ * Caller must hold event_mutex.
+ */
+static void pop_head(Agentite_FileWatcher *watcher)
+{
+    QueuedEvent *queued = &watcher->event_queue[watcher->event_queue_head];
+    if (queued->pending && !queued->cancelled) {
+        path_index_remove(watcher, queued);
         watcher->pending_count.fetch_sub(1);
     }
+    queued->pending = false;
+    queued->cancelled = false;
+
+    watcher->event_queue_head = (watcher->event_queue_head + 1) % watcher->event_queue_capacity;
+    watcher->event_queue_count--;
+
+    /* Drained: reset the index so tombstones never accumulate */
+    if (watcher->event_queue_count == 0 && watcher->path_index_used > 0) {
+        memset(watcher->path_index, 0xFF, watcher->path_index_capacity * sizeof(int32_t));
+        watcher->path_index_used = 0;
+    }
+}
+
+/**
+ * Double the ring buffer, preserving event order.
+ * Caller must hold event_mutex.
+ */
+static bool grow_queue(Agentite_FileWatcher *watcher)
+{
+    size_t old_capacity = watcher->event_queue_capacity;
+    size_t new_capacity = old_capacity * 2;
+    QueuedEvent *queue = (QueuedEvent *)calloc(new_capacity, sizeof(QueuedEvent));
+    if (!queue) {
+        return false;
+    }
+
+    for (size_t n = 0; n < watcher->event_queue_count; n++) {
+        queue[n] = watcher->event_queue[(watcher->event_queue_head + n) % old_capacity];
+    }
 
-    /* Add new event */
-    QueuedEvent *queued = &watcher->event_queue[watcher->event_queue_tail];
+    free(watcher->event_queue);
+    watcher->event_queue = queue;
+    watcher->event_queue_capacity = new_capacity;
+    watcher->event_queue_head = 0;
+    watcher->event_queue_tail = watcher->event_queue_count;
+
+    return path_index_rebuild(watcher);
+}
+
+/**
+ * Mark a pending event as coalesced away.
+ * The slot stays in the ring and is skipped on delivery.
+ * Caller must hold event_mutex.
+ */
+static void cancel_event(Agentite_FileWatcher *watcher, QueuedEvent *queued)
+{
+    path_index_remove(watcher, queued);
+    queued->cancelled = true;
+    watcher->pending_count.fetch_sub(1);
+}
+
+/**
+ * Append a new event at the tail of the queue.
+ * Caller must hold event_mutex.
+ */
+static void append_event(Agentite_FileWatcher *watcher, const Agentite_WatchEvent *event,
+                         uint64_t deadline)
+{
+    if (watcher->event_queue_count >= watcher->event_queue_capacity) {
+        /* Unlimited queues grow; bounded queues drop the oldest slot */
+        if (watcher->config.max_events > 0 || !grow_queue(watcher)) {
+            pop_head(watcher);
+        }
+    }
+
+    /* Keep the index at most half full (tombstones included) */
+    if ((watcher->path_index_used + 1) * 2 > watcher->path_index_capacity) {
+        path_index_rebuild(watcher);
+    }
+
+    size_t slot = watcher->event_queue_tail;
+    QueuedEvent *queued = &watcher->event_queue[slot];
     queued->event = *event;
-    queued->debounce_deadline = get_time_ms() + watcher->config.debounce_ms;
+    queued->debounce_deadline = deadline;
     queued->pending = true;
+    queued->cancelled = false;
+    path_index_insert(watcher, event->path, (int32_t)slot);
 
-    watcher->event_queue_tail = (watcher->event_queue_tail + 1) % watcher->event_queue_capacity;
+    watcher->event_queue_tail = (slot + 1) % watcher->event_queue_capacity;
+    watcher->event_queue_count++;
     watcher->pending_count.fetch_add(1);
+}
+
+/**
+ * Refresh a surviving event after a merge and restart its debounce window.
+ */
+static void touch_event(QueuedEvent *queued, Agentite_WatchEventType type,
+                        uint64_t timestamp, uint64_t deadline)
+{
+    queued->event.type = type;
+    queued->event.timestamp = timestamp;
+    queued->debounce_deadline = deadline;
+}
+
+/**
+ * Merge a deletion that happened *before* whatever is pending on the path
+ * (a renamed-away file that was later deleted).
+ * Caller must hold event_mutex.
+ */
+static void merge_earlier_delete(Agentite_FileWatcher *watcher, const Agentite_WatchEvent *event,
+                                 uint64_t deadline)
+{
+    QueuedEvent *existing = path_index_find(watcher, event->path);
+    if (!existing) {
+        append_event(watcher, event, deadline);
+        return;
+    }
+
+    /* Old content deleted, then recreated: the file was replaced */
+    Agentite_WatchEventType type = existing->event.type;
+    if (type == AGENTITE_WATCH_CREATED) {
+        type = AGENTITE_WATCH_MODIFIED;
+    }
+    touch_event(existing, type, event->timestamp, deadline);
+}
+
+/**
+ * Merge a CREATED/MODIFIED/DELETED event into the pending event for the
+ * same path, or append it if nothing is pending.
+ * Caller must hold event_mutex.
+ */
+static void merge_event(Agentite_FileWatcher *watcher, const Agentite_WatchEvent *event,
+                        uint64_t deadline)
+{
+    QueuedEvent *existing = path_index_find(watcher, event->path);
+    if (!existing) {
+        append_event(watcher, event, deadline);
+        return;
+    }
+
+    Agentite_WatchEventType prev = existing->event.type;
+    Agentite_WatchEventType type = prev;
+
+    switch (event->type) {
+        case AGENTITE_WATCH_CREATED:
+        case AGENTITE_WATCH_MODIFIED:
+            /* Deleted then written again: the file was replaced */
+            if (prev == AGENTITE_WATCH_DELETED) {
+                type = AGENTITE_WATCH_MODIFIED;
+            }
+            break;
+
+        case AGENTITE_WATCH_DELETED:
+            if (prev == AGENTITE_WATCH_CREATED) {
+                /* Transient file: never report it */
+                cancel_event(watcher, existing);
+                return;
+            }
+            if (prev == AGENTITE_WATCH_RENAMED) {
+                /* Renamed away then deleted: the original path was deleted */
+                Agentite_WatchEvent deleted = *event;
+                strncpy(deleted.path, existing->event.old_path, sizeof(deleted.path) - 1);
+                deleted.path[sizeof(deleted.path) - 1] = '\0';
+                cancel_event(watcher, existing);
+                if (deleted.path[0] != '\0') {
+                    merge_earlier_delete(watcher, &deleted, deadline);
+                }
+                return;
+            }
+            type = AGENTITE_WATCH_DELETED;
+            break;
+
+        default:
+            break;
+    }
+
+    touch_event(existing, type, event->timestamp, deadline);
+}
+
+/**
+ * Merge a RENAMED event (old_path -> path).
+ * Caller must hold event_mutex.
+ */
+static void merge_rename(Agentite_FileWatcher *watcher, const Agentite_WatchEvent *event,
+                         uint64_t deadline)
+{
+    Agentite_WatchEvent merged = *event;
+
+    QueuedEvent *source = event->old_path[0] ? path_index_find(watcher, event->old_path) : NULL;
+    if (source) {
+        if (source->event.type == AGENTITE_WATCH_CREATED) {
+            /* Temp file written then renamed into place: a write to the target */
+            merged.type = AGENTITE_WATCH_CREATED;
+            merged.old_path[0] = '\0';
+        } else if (source->event.type == AGENTITE_WATCH_RENAMED) {
+            /* Chained renames collapse to one */
+            memcpy(merged.old_path, source->event.old_path, sizeof(merged.old_path));
+        }
+        cancel_event(watcher, source);
+    }
+
+    if (merged.type == AGENTITE_WATCH_CREATED) {
+        merge_event(watcher, &merged, deadline);
+        return;
+    }
+
+    /* A rename onto the path supersedes anything pending for its old content */
+    QueuedEvent *existing = path_index_find(watcher, merged.path);
+    if (existing) {
+        cancel_event(watcher, existing);
+    }
+    append_event(watcher, &merged, deadline);
+}
+
+/**
+ * Queue an event, coalescing with any undelivered event for the same path.
+ * Thread-safe - called from background thread.
+ *
+ * Pending events are found through the path index, so coalescing is O(1)
+ * regardless of queue depth. Each merge restarts the debounce window.
+ */
+static void queue_event(Agentite_FileWatcher *watcher, const Agentite_WatchEvent *event)
+{
+    if (!watcher->enabled.load()) {
+        return;
+    }
+
+    SDL_LockMutex(watcher->event_mutex);
+
+    uint64_t deadline = get_time_ms() + watcher->config.debounce_ms;
+
+    if (watcher->config.debounce_ms == 0) {
+        /* Coalescing disabled: deliver every raw event */
+        append_event(watcher, event, deadline);
+    } else if (event->type == AGENTITE_WATCH_RENAMED) {
+        merge_rename(watcher, event, deadline);
+    } else {
+        merge_event(watcher, event, deadline);
+    }
 
     SDL_UnlockMutex(watcher->event_mutex);
 }
@@ -307,13 +622,13 @@ Agentite_FileWatcher *agentite_watch_create(const Agentite_FileWatcherConfig *co
         goto cleanup;
     }
 
-    /* Allocate event queue */
+    /* Allocate event queue (bounded queues are sized to max_events up front) */
     watcher->event_queue_capacity = DEFAULT_EVENT_QUEUE_CAPACITY;
-    if (watcher->config.max_events > 0 && watcher->config.max_events < DEFAULT_EVENT_QUEUE_CAPACITY) {
+    if (watcher->config.max_events > 0) {
         watcher->event_queue_capacity = watcher->config.max_events;
     }
     watcher->event_queue = (QueuedEvent *)calloc(watcher->event_queue_capacity, sizeof(QueuedEvent));
-    if (!watcher->event_queue) {
+    if (!watcher->event_queue || !path_index_rebuild(watcher)) {
         agentite_set_error("watch: failed to allocate event queue");
         goto cleanup;
     }
@@ -334,6 +649,7 @@ Agentite_FileWatcher *agentite_watch_create(const Agentite_FileWatcherConfig *co
     return watcher;
 
 cleanup:
+    free(watcher->path_index);
     if (watcher->event_queue) free(watcher->event_queue);
     if (watcher->event_mutex) SDL_DestroyMutex(watcher->event_mutex);
     if (watcher->paths_mutex) SDL_DestroyMutex(watcher->paths_mutex);
@@ -366,6 +682,7 @@ void agentite_watch_destroy(Agentite_FileWatcher *watcher)
     SDL_UnlockMutex(watcher->paths_mutex);
 
     /* Free resources */
+    free(watcher->path_index);
     free(watcher->event_queue);
     SDL_DestroyMutex(watcher->event_mutex);
     SDL_DestroyMutex(watcher->paths_mutex);
@@ -475,22 +792,24 @@ void agentite_watch_update(Agentite_FileWatcher *watcher)
     SDL_LockMutex(watcher->event_mutex);
 
     /* Process events whose debounce period has expired */
-    while (watcher->pending_count.load() > 0) {
+    while (watcher->event_queue_count > 0) {
         QueuedEvent *queued = &watcher->event_queue[watcher->event_queue_head];
 
+        /* Coalesced-away slots are dropped silently */
+        if (queued->cancelled) {
+            pop_head(watcher);
+            continue;
+        }
+
         /* Check if debounce period has expired */
         if (queued->pending && now < queued->debounce_deadline) {
             /* Still waiting for debounce, stop processing */
             break;
         }
 
-        /* Remove from queue */
-        queued->pending = false;
-        watcher->event_queue_head = (watcher->event_queue_head + 1) % watcher->event_queue_capacity;
-        watcher->pending_count.fetch_sub(1);
-
-        /* Copy event data before releasing lock */
+        /* Copy event data, then remove from queue */
         Agentite_WatchEvent event = queued->event;
+        pop_head(watcher);
 
         /* Release lock during callback */
         SDL_UnlockMutex(watcher->event_mutex);
@@ -528,10 +847,13 @@ void agentite_watch_clear_pending(Agentite_FileWatcher *watcher)
     SDL_LockMutex(watcher->event_mutex);
     watcher->event_queue_head = 0;
     watcher->event_queue_tail = 0;
+    watcher->event_queue_count = 0;
     watcher->pending_count.store(0);
     for (size_t i = 0; i < watcher->event_queue_capacity; i++) {
         watcher->event_queue[i].pending = false;
+        watcher->event_queue[i].cancelled = false;
     }
+    path_index_rebuild(watcher);
     SDL_UnlockMutex(watcher->event_mutex);
 }
 
@@ -5,12 +5,23 @@
  * inotify is the standard Linux kernel interface for monitoring
  * file system events.
  *
+ * Scalability:
+ * - Watch descriptors are mapped to directories through a growable hash
+ *   table, so there is no fixed watch limit and lookups are O(1).
+ * - Each watched root keeps a compact snapshot of its files (path hash,
+ *   mtime, size). When the kernel queue overflows (IN_Q_OVERFLOW) the tree
+ *   is rescanned and diffed against the snapshot, so no change is dropped.
+ * - Directories created or moved into a recursive watch are watched
+ *   immediately and scanned for files that appeared before the watch.
+ *
  * This file is included directly into watch.cpp and should not be compiled separately.
  */
 
 #include <sys/inotify.h>
+#include <sys/select.h>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
 #include <errno.h>
@@ -24,73 +35,418 @@
  */
 #define INOTIFY_BUFFER_SIZE (sizeof(struct inotify_event) + NAME_MAX + 1) * 64
 
+/* Initial sizes for the growable tables */
+#define INITIAL_WATCH_MAP_CAPACITY 256
+#define INITIAL_SNAPSHOT_CAPACITY 1024
+
+/* Watch map slot markers */
+#define WD_EMPTY     (-1)
+#define WD_TOMBSTONE (-2)
+
+/* Snapshot slot markers (real hashes are forced above these) */
+#define SNAPSHOT_EMPTY     0
+#define SNAPSHOT_TOMBSTONE 1
+
+typedef struct LinuxPathHandle LinuxPathHandle;
+
 /**
  * inotify watch descriptor entry.
  */
 typedef struct InotifyWatch {
-    int wd;                         /* Watch descriptor */
-    char path[PATH_BUFFER_SIZE];    /* Full path being watched */
-    bool active;
+    int wd;                         /* Watch descriptor (WD_EMPTY / WD_TOMBSTONE) */
+    char *path;                     /* Full path being watched (heap) */
+    LinuxPathHandle *owner;         /* Root this directory belongs to */
 } InotifyWatch;
 
-#define MAX_INOTIFY_WATCHES 1024
+/**
+ * Snapshot entry for one file below a watched root.
+ */
+typedef struct SnapshotEntry {
+    uint64_t hash;                  /* Hash of relative path (SNAPSHOT_EMPTY / SNAPSHOT_TOMBSTONE) */
+    uint32_t name_offset;           /* Relative path in the name pool */
+    uint32_t generation;            /* Scan generation that last saw the file */
+    int64_t mtime_ns;
+    int64_t size;
+} SnapshotEntry;
+
+/**
+ * Open-addressing set of files keyed by relative path.
+ * Names live in an append-only pool that is compacted on each full rescan.
+ */
+typedef struct FileSnapshot {
+    SnapshotEntry *entries;
+    size_t capacity;                /* Power of two */
+    size_t count;                   /* Live entries */
+    size_t used;                    /* Live entries + tombstones */
+    char *names;
+    size_t names_len;
+    size_t names_capacity;
+    uint32_t generation;
+} FileSnapshot;
 
 /**
  * Linux-specific watch data.
  */
 typedef struct LinuxWatchData {
-    int inotify_fd;                             /* inotify file descriptor */
-    InotifyWatch watches[MAX_INOTIFY_WATCHES];  /* Watch descriptor mappings */
-    size_t watch_count;
-    SDL_Mutex *watches_mutex;
+    int inotify_fd;                 /* inotify file descriptor */
+    InotifyWatch *watches;          /* wd -> directory hash map */
+    size_t watch_capacity;          /* Power of two */
+    size_t watch_count;             /* Live entries */
+    size_t watch_used;              /* Live entries + tombstones */
+    LinuxPathHandle *handles[MAX_WATCHED_PATHS];  /* Active roots */
+    SDL_Mutex *watches_mutex;       /* Recursive; guards everything above */
 } LinuxWatchData;
 
 /**
  * Per-path watch handle for Linux.
  */
-typedef struct LinuxPathHandle {
+struct LinuxPathHandle {
     char root_path[PATH_BUFFER_SIZE];
+    size_t root_len;
     int *watch_descriptors;     /* Array of watch descriptors for this path tree */
     size_t wd_count;
     size_t wd_capacity;
-} LinuxPathHandle;
+    FileSnapshot snapshot;      /* Files below root, for overflow recovery */
+};
 
 /* ============================================================================
- * Helper Functions
+ * Watch Descriptor Map
  * ============================================================================ */
 
+/**
+ * Hash a watch descriptor (Fibonacci hashing).
+ */
+static inline size_t hash_wd(int wd, size_t mask)
+{
+    return (size_t)(((uint32_t)wd * 2654435769u) >> 7) & mask;
+}
+
 /**
  * Find watch entry by descriptor.
+ * Caller must hold watches_mutex.
  */
 static InotifyWatch *find_watch_by_wd(LinuxWatchData *data, int wd)
 {
-    for (size_t i = 0; i < MAX_INOTIFY_WATCHES; i++) {
-        if (data->watches[i].active && data->watches[i].wd == wd) {
+    if (!data->watches || wd < 0) return NULL;
+
+    size_t mask = data->watch_capacity - 1;
+    size_t i = hash_wd(wd, mask);
+
+    while (data->watches[i].wd != WD_EMPTY) {
+        if (data->watches[i].wd == wd) {
             return &data->watches[i];
         }
+        i = (i + 1) & mask;
     }
     return NULL;
 }
 
 /**
- * Find empty watch slot.
+ * Resize the watch map, dropping tombstones.
+ * Caller must hold watches_mutex.
  */
-static InotifyWatch *find_empty_watch_slot(LinuxWatchData *data)
+static bool resize_watch_map(LinuxWatchData *data, size_t new_capacity)
 {
-    for (size_t i = 0; i < MAX_INOTIFY_WATCHES; i++) {
-        if (!data->watches[i].active) {
-            return &data->watches[i];
+    InotifyWatch *slots = (InotifyWatch *)malloc(new_capacity * sizeof(InotifyWatch));
+    if (!slots) {
+        return false;
+    }
+    for (size_t i = 0; i < new_capacity; i++) {
+        slots[i].wd = WD_EMPTY;
+        slots[i].path = NULL;
+        slots[i].owner = NULL;
+    }
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < data->watch_capacity; i++) {
+        InotifyWatch *old = &data->watches[i];
+        if (old->wd < 0) continue;
+
+        size_t j = hash_wd(old->wd, mask);
+        while (slots[j].wd != WD_EMPTY) {
+            j = (j + 1) & mask;
+        }
+        slots[j] = *old;
+    }
+
+    free(data->watches);
+    data->watches = slots;
+    data->watch_capacity = new_capacity;
+    data->watch_used = data->watch_count;
+    return true;
+}
+
+/**
+ * Record (or update) the directory for a watch descriptor.
+ * inotify returns the existing descriptor when a directory is re-added,
+ * so this is idempotent.
+ * Caller must hold watches_mutex.
+ */
+static bool map_watch(LinuxWatchData *data, int wd, const char *path, LinuxPathHandle *owner)
+{
+    InotifyWatch *watch = find_watch_by_wd(data, wd);
+    if (watch) {
+        if (strcmp(watch->path, path) != 0) {
+            char *copy = strdup(path);
+            if (!copy) return false;
+            free(watch->path);
+            watch->path = copy;
         }
+        watch->owner = owner;
+        return true;
+    }
+
+    /* Keep load factor (tombstones included) under 1/2 */
+    if ((data->watch_used + 1) * 2 > data->watch_capacity) {
+        size_t new_capacity = data->watch_capacity ? data->watch_capacity : INITIAL_WATCH_MAP_CAPACITY;
+        while ((data->watch_count + 1) * 2 > new_capacity / 2) {
+            new_capacity *= 2;
+        }
+        if (!resize_watch_map(data, new_capacity)) {
+            return false;
+        }
+    }
+
+    char *copy = strdup(path);
+    if (!copy) return false;
+
+    size_t mask = data->watch_capacity - 1;
+    size_t i = hash_wd(wd, mask);
+    while (data->watches[i].wd >= 0) {
+        i = (i + 1) & mask;
+    }
+    if (data->watches[i].wd == WD_EMPTY) {
+        data->watch_used++;
+    }
+    data->watches[i].wd = wd;
+    data->watches[i].path = copy;
+    data->watches[i].owner = owner;
+    data->watch_count++;
+    return true;
+}
+
+/**
+ * Forget a watch descriptor.
+ * Caller must hold watches_mutex.
+ */
+static void unmap_watch(LinuxWatchData *data, InotifyWatch *watch)
+{
+    free(watch->path);
+    watch->path = NULL;
+    watch->owner = NULL;
+    watch->wd = WD_TOMBSTONE;
+    data->watch_count--;
+}
+
+/* ============================================================================
+ * File Snapshot
+ * ============================================================================ */
+
+/**
+ * 64-bit FNV-1a hash of a relative path, never colliding with slot markers.
+ */
+static uint64_t hash_snapshot_path(const char *path)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)path; *p; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ULL;
+    }
+    return hash > SNAPSHOT_TOMBSTONE ? hash : hash + 2;
+}
+
+static void snapshot_free(FileSnapshot *snap)
+{
+    free(snap->entries);
+    free(snap->names);
+    memset(snap, 0, sizeof(*snap));
+}
+
+/**
+ * Find the live entry for a relative path.
+ */
+static SnapshotEntry *snapshot_find(FileSnapshot *snap, const char *rel, uint64_t hash)
+{
+    if (!snap->entries) return NULL;
+
+    size_t mask = snap->capacity - 1;
+    size_t i = (size_t)hash & mask;
+
+    while (snap->entries[i].hash != SNAPSHOT_EMPTY) {
+        SnapshotEntry *entry = &snap->entries[i];
+        if (entry->hash == hash && strcmp(snap->names + entry->name_offset, rel) == 0) {
+            return entry;
+        }
+        i = (i + 1) & mask;
     }
     return NULL;
 }
 
+/**
+ * Rehash into a table of the given capacity.
+ * Optionally compacts the name pool, dropping names of removed entries.
+ */
+static bool snapshot_rehash(FileSnapshot *snap, size_t new_capacity, bool compact_names)
+{
+    SnapshotEntry *entries = (SnapshotEntry *)calloc(new_capacity, sizeof(SnapshotEntry));
+    if (!entries) return false;
+
+    char *names = snap->names;
+    size_t names_len = snap->names_len;
+    size_t names_capacity = snap->names_capacity;
+    if (compact_names && snap->names) {
+        names_capacity = snap->names_capacity;
+        names = (char *)malloc(names_capacity);
+        if (!names) {
+            free(entries);
+            return false;
+        }
+        names_len = 0;
+    }
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < snap->capacity; i++) {
+        SnapshotEntry *old = &snap->entries[i];
+        if (old->hash <= SNAPSHOT_TOMBSTONE) continue;
+
+        size_t j = (size_t)old->hash & mask;
+        while (entries[j].hash != SNAPSHOT_EMPTY) {
+            j = (j + 1) & mask;
+        }
+        entries[j] = *old;
+
+        if (compact_names) {
+            const char *name = snap->names + old->name_offset;
+            size_t len = strlen(name) + 1;
+            memcpy(names + names_len, name, len);
+            entries[j].name_offset = (uint32_t)names_len;
+            names_len += len;
+        }
+    }
+
+    if (compact_names && snap->names) {
+        free(snap->names);
+    }
+    free(snap->entries);
+    snap->entries = entries;
+    snap->capacity = new_capacity;
+    snap->used = snap->count;
+    snap->names = names;
+    snap->names_len = names_len;
+    snap->names_capacity = names_capacity;
+    return true;
+}
+
+/**
+ * Insert or refresh a file in the snapshot.
+ * Returns the previous entry state through *existed / *changed.
+ */
+static void snapshot_upsert(FileSnapshot *snap, const char *rel, const struct stat *st,
+                            bool *existed, bool *changed)
+{
+    int64_t mtime_ns = (int64_t)st->st_mtim.tv_sec * 1000000000LL + st->st_mtim.tv_nsec;
+    int64_t size = (int64_t)st->st_size;
+    uint64_t hash = hash_snapshot_path(rel);
+
+    SnapshotEntry *entry = snapshot_find(snap, rel, hash);
+    if (entry) {
+        if (existed) *existed = true;
+        if (changed) *changed = entry->mtime_ns != mtime_ns || entry->size != size;
+        entry->mtime_ns = mtime_ns;
+        entry->size = size;
+        entry->generation = snap->generation;
+        return;
+    }
+    if (existed) *existed = false;
+    if (changed) *changed = true;
+
+    if ((snap->used + 1) * 2 > snap->capacity) {
+        size_t new_capacity = snap->capacity ? snap->capacity : INITIAL_SNAPSHOT_CAPACITY;
+        while ((snap->count + 1) * 2 > new_capacity / 2) {
+            new_capacity *= 2;
+        }
+        if (!snapshot_rehash(snap, new_capacity, false)) return;
+    }
+
+    size_t len = strlen(rel) + 1;
+    if (snap->names_len + len > snap->names_capacity) {
+        size_t new_capacity = snap->names_capacity ? snap->names_capacity * 2 : 16384;
+        while (snap->names_len + len > new_capacity) {
+            new_capacity *= 2;
+        }
+        char *names = (char *)realloc(snap->names, new_capacity);
+        if (!names) return;
+        snap->names = names;
+        snap->names_capacity = new_capacity;
+    }
+    memcpy(snap->names + snap->names_len, rel, len);
+
+    size_t mask = snap->capacity - 1;
+    size_t i = (size_t)hash & mask;
+    while (snap->entries[i].hash > SNAPSHOT_TOMBSTONE) {
+        i = (i + 1) & mask;
+    }
+    if (snap->entries[i].hash == SNAPSHOT_EMPTY) {
+        snap->used++;
+    }
+    entry = &snap->entries[i];
+    entry->hash = hash;
+    entry->name_offset = (uint32_t)snap->names_len;
+    entry->generation = snap->generation;
+    entry->mtime_ns = mtime_ns;
+    entry->size = size;
+    snap->names_len += len;
+    snap->count++;
+}
+
+/**
+ * Remove a file from the snapshot.
+ */
+static void snapshot_remove(FileSnapshot *snap, const char *rel)
+{
+    SnapshotEntry *entry = snapshot_find(snap, rel, hash_snapshot_path(rel));
+    if (entry) {
+        entry->hash = SNAPSHOT_TOMBSTONE;
+        snap->count--;
+    }
+}
+
+/**
+ * Remove every file below a relative directory prefix.
+ */
+static void snapshot_remove_prefix(FileSnapshot *snap, const char *prefix)
+{
+    size_t len = strlen(prefix);
+    for (size_t i = 0; i < snap->capacity; i++) {
+        SnapshotEntry *entry = &snap->entries[i];
+        if (entry->hash <= SNAPSHOT_TOMBSTONE) continue;
+
+        const char *name = snap->names + entry->name_offset;
+        if (strncmp(name, prefix, len) == 0 && name[len] == '/') {
+            entry->hash = SNAPSHOT_TOMBSTONE;
+            snap->count--;
+        }
+    }
+}
+
+/* ============================================================================
+ * Helper Functions
+ * ============================================================================ */
+
+/**
+ * Path of a file relative to its watched root.
+ */
+static const char *relative_to_root(const LinuxPathHandle *handle, const char *full_path)
+{
+    const char *rel = full_path + handle->root_len;
+    if (rel[0] == '/') rel++;
+    return rel;
+}
+
 /**
  * Add a single directory to inotify.
  */
-static int add_inotify_watch(Agentite_FileWatcher *watcher,
-                              LinuxWatchData *data,
-                              const char *path)
+static int add_inotify_watch(LinuxWatchData *data, LinuxPathHandle *handle, const char *path)
 {
     uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY |
                     IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE;
@@ -98,7 +454,8 @@ static int add_inotify_watch(Agentite_FileWatcher *watcher,
     int wd = inotify_add_watch(data->inotify_fd, path, mask);
     if (wd < 0) {
         if (errno == ENOSPC) {
-            agentite_set_error("watch: inotify watch limit reached");
+            agentite_set_error("watch: inotify watch limit reached "
+                              "(raise fs.inotify.max_user_watches)");
         } else {
             agentite_set_error("watch: inotify_add_watch failed for %s: %s",
                               path, strerror(errno));
@@ -108,56 +465,60 @@ static int add_inotify_watch(Agentite_FileWatcher *watcher,
 
     /* Record watch mapping */
     SDL_LockMutex(data->watches_mutex);
-    InotifyWatch *watch = find_empty_watch_slot(data);
-    if (watch) {
-        watch->wd = wd;
-        strncpy(watch->path, path, sizeof(watch->path) - 1);
-        watch->active = true;
-        data->watch_count++;
-    }
+    bool mapped = map_watch(data, wd, path, handle);
     SDL_UnlockMutex(data->watches_mutex);
 
+    if (!mapped) {
+        inotify_rm_watch(data->inotify_fd, wd);
+        agentite_set_error("watch: failed to record watch for %s", path);
+        return -1;
+    }
+
     return wd;
 }
 
 /**
- * Recursively add watches for a directory tree.
+ * Scan a directory tree, watching every directory and recording every file.
+ *
+ * With report_changes set the scan is a diff: files missing from the
+ * snapshot are reported as CREATED and files whose mtime or size changed as
+ * MODIFIED. Callers handle deletions afterwards via the generation counter.
  */
 static bool add_watches_recursive(Agentite_FileWatcher *watcher,
                                    LinuxWatchData *data,
                                    LinuxPathHandle *handle,
-                                   const char *path)
+                                   const char *path,
+                                   bool report_changes)
 {
     /* Add watch for this directory */
-    int wd = add_inotify_watch(watcher, data, path);
+    int wd = add_inotify_watch(data, handle, path);
     if (wd < 0) {
         return false;
     }
 
     /* Record in handle */
+    SDL_LockMutex(data->watches_mutex);
     if (handle->wd_count >= handle->wd_capacity) {
         size_t new_capacity = handle->wd_capacity * 2;
         if (new_capacity < 64) new_capacity = 64;
         int *new_wds = (int *)realloc(handle->watch_descriptors,
                                        new_capacity * sizeof(int));
         if (!new_wds) {
+            SDL_UnlockMutex(data->watches_mutex);
             return false;
         }
         handle->watch_descriptors = new_wds;
         handle->wd_capacity = new_capacity;
     }
     handle->watch_descriptors[handle->wd_count++] = wd;
+    SDL_UnlockMutex(data->watches_mutex);
 
-    /* If not recursive, we're done */
-    if (!watcher->config.recursive) {
-        return true;
-    }
-
-    /* Scan subdirectories */
+    /* Scan entries */
     DIR *dir = opendir(path);
     if (!dir) {
         return true;  /* Can't open, but main dir is watched */
     }
+    int dfd = dirfd(dir);
 
     struct dirent *entry;
     while ((entry = readdir(dir)) != NULL) {
@@ -166,13 +527,45 @@ static bool add_watches_recursive(Agentite_FileWatcher *watcher,
             continue;
         }
 
+        /* d_type avoids a stat for directories on most filesystems */
+        bool is_dir = entry->d_type == DT_DIR;
+        struct stat st;
+        bool have_stat = false;
+        if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) {
+            if (fstatat(dfd, entry->d_name, &st, 0) != 0) continue;
+            is_dir = S_ISDIR(st.st_mode);
+            have_stat = true;
+        }
+
         char subpath[PATH_BUFFER_SIZE];
-        snprintf(subpath, sizeof(subpath), "%s/%s", path, entry->d_name);
+        int n = snprintf(subpath, sizeof(subpath), "%s/%s", path, entry->d_name);
+        if (n < 0 || (size_t)n >= sizeof(subpath)) {
+            continue;  /* Path too long to report */
+        }
 
-        struct stat st;
-        if (stat(subpath, &st) == 0 && S_ISDIR(st.st_mode)) {
+        if (is_dir) {
             /* Recursively add watches for subdirectory */
-            add_watches_recursive(watcher, data, handle, subpath);
+            if (watcher->config.recursive) {
+                add_watches_recursive(watcher, data, handle, subpath, report_changes);
+            }
+            continue;
+        }
+
+        if (!have_stat && fstatat(dfd, entry->d_name, &st, 0) != 0) {
+            continue;
+        }
+
+        const char *rel = relative_to_root(handle, subpath);
+        bool existed = false;
+        bool changed = false;
+        SDL_LockMutex(data->watches_mutex);
+        snapshot_upsert(&handle->snapshot, rel, &st, &existed, &changed);
+        SDL_UnlockMutex(data->watches_mutex);
+
+        if (report_changes && changed) {
+            agentite_watch_notify(watcher,
+                                  existed ? AGENTITE_WATCH_MODIFIED : AGENTITE_WATCH_CREATED,
+                                  rel, NULL);
         }
     }
 
@@ -180,6 +573,76 @@ static bool add_watches_recursive(Agentite_FileWatcher *watcher,
     return true;
 }
 
+/**
+ * Rescan a whole root and diff it against its snapshot.
+ * Used to recover from IN_Q_OVERFLOW, where the kernel dropped events.
+ * Caller must hold watches_mutex.
+ */
+static void rescan_root(Agentite_FileWatcher *watcher, LinuxWatchData *data,
+                        LinuxPathHandle *handle)
+{
+    FileSnapshot *snap = &handle->snapshot;
+    snap->generation++;
+
+    /* Watch descriptors are re-collected by the scan */
+    handle->wd_count = 0;
+    add_watches_recursive(watcher, data, handle, handle->root_path, true);
+
+    /* Anything not seen this generation is gone */
+    for (size_t i = 0; i < snap->capacity; i++) {
+        SnapshotEntry *entry = &snap->entries[i];
+        if (entry->hash <= SNAPSHOT_TOMBSTONE || entry->generation == snap->generation) {
+            continue;
+        }
+        agentite_watch_notify(watcher, AGENTITE_WATCH_DELETED,
+                              snap->names + entry->name_offset, NULL);
+        entry->hash = SNAPSHOT_TOMBSTONE;
+        snap->count--;
+    }
+
+    /* Drop tombstones and names of deleted files */
+    if (snap->capacity > 0) {
+        snapshot_rehash(snap, snap->capacity, true);
+    }
+}
+
+/**
+ * Stop watching every directory at or below a full path
+ * (used when a directory is moved out of its old location).
+ * Caller must hold watches_mutex.
+ */
+static void unwatch_subtree(LinuxWatchData *data, const char *full_path)
+{
+    size_t len = strlen(full_path);
+    for (size_t i = 0; i < data->watch_capacity; i++) {
+        InotifyWatch *watch = &data->watches[i];
+        if (watch->wd < 0) continue;
+        if (strncmp(watch->path, full_path, len) == 0 &&
+            (watch->path[len] == '\0' || watch->path[len] == '/')) {
+            inotify_rm_watch(data->inotify_fd, watch->wd);
+            unmap_watch(data, watch);
+        }
+    }
+}
+
+/**
+ * Keep the snapshot in sync with a single file event.
+ * Caller must hold watches_mutex.
+ */
+static void update_snapshot(LinuxPathHandle *handle, const char *full_path, bool exists)
+{
+    const char *rel = relative_to_root(handle, full_path);
+    if (!exists) {
+        snapshot_remove(&handle->snapshot, rel);
+        return;
+    }
+
+    struct stat st;
+    if (stat(full_path, &st) == 0 && !S_ISDIR(st.st_mode)) {
+        snapshot_upsert(&handle->snapshot, rel, &st, NULL, NULL);
+    }
+}
+
 /* ============================================================================
  * Platform Implementation
  * ============================================================================ */
@@ -228,6 +691,11 @@ static void platform_shutdown(Agentite_FileWatcher *watcher)
         close(data->inotify_fd);
     }
 
+    for (size_t i = 0; i < data->watch_capacity; i++) {
+        free(data->watches[i].path);
+    }
+    free(data->watches);
+
     if (data->watches_mutex) {
         SDL_DestroyMutex(data->watches_mutex);
     }
@@ -265,17 +733,38 @@ static void *platform_watch_path(Agentite_FileWatcher *watcher, const char *path
         return NULL;
     }
     strncpy(handle->root_path, path, sizeof(handle->root_path) - 1);
+    handle->root_len = strlen(handle->root_path);
 
-    /* Add watches recursively */
-    if (!add_watches_recursive(watcher, data, handle, path)) {
+    /* Add watches recursively and take the initial snapshot */
+    SDL_LockMutex(data->watches_mutex);
+    bool ok = add_watches_recursive(watcher, data, handle, path, false);
+    if (ok) {
+        ok = false;
+        for (size_t i = 0; i < MAX_WATCHED_PATHS; i++) {
+            if (!data->handles[i]) {
+                data->handles[i] = handle;
+                ok = true;
+                break;
+            }
+        }
+    }
+    if (!ok) {
         /* Cleanup any watches we did add */
         for (size_t i = 0; i < handle->wd_count; i++) {
-            inotify_rm_watch(data->inotify_fd, handle->watch_descriptors[i]);
+            int wd = handle->watch_descriptors[i];
+            inotify_rm_watch(data->inotify_fd, wd);
+            InotifyWatch *watch = find_watch_by_wd(data, wd);
+            if (watch && watch->owner == handle) {
+                unmap_watch(data, watch);
+            }
         }
+        SDL_UnlockMutex(data->watches_mutex);
+        snapshot_free(&handle->snapshot);
         free(handle->watch_descriptors);
         free(handle);
         return NULL;
     }
+    SDL_UnlockMutex(data->watches_mutex);
 
     return handle;
 }
@@ -287,27 +776,63 @@ static void platform_unwatch_path(Agentite_FileWatcher *watcher, void *handle_pt
 {
     LinuxWatchData *data = (LinuxWatchData *)watcher->platform_data;
     LinuxPathHandle *handle = (LinuxPathHandle *)handle_ptr;
-    if (!data || !handle) return;
+    if (!handle) return;
+    if (!data) {
+        /* Platform already shut down; the kernel dropped the watches */
+        snapshot_free(&handle->snapshot);
+        free(handle->watch_descriptors);
+        free(handle);
+        return;
+    }
 
     /* Remove all watch descriptors */
     SDL_LockMutex(data->watches_mutex);
     for (size_t i = 0; i < handle->wd_count; i++) {
         int wd = handle->watch_descriptors[i];
-        inotify_rm_watch(data->inotify_fd, wd);
 
-        /* Clear from mapping */
+        /* Clear from mapping (a nested root may own it now) */
         InotifyWatch *watch = find_watch_by_wd(data, wd);
-        if (watch) {
-            watch->active = false;
-            data->watch_count--;
+        if (watch && watch->owner == handle) {
+            inotify_rm_watch(data->inotify_fd, wd);
+            unmap_watch(data, watch);
+        }
+    }
+    for (size_t i = 0; i < MAX_WATCHED_PATHS; i++) {
+        if (data->handles[i] == handle) {
+            data->handles[i] = NULL;
         }
     }
     SDL_UnlockMutex(data->watches_mutex);
 
+    snapshot_free(&handle->snapshot);
     free(handle->watch_descriptors);
     free(handle);
 }
 
+/**
+ * Report a MOVED_FROM whose MOVED_TO never arrived (moved out of the tree).
+ */
+static void flush_unpaired_move(Agentite_FileWatcher *watcher, LinuxWatchData *data,
+                                char *rename_old_path, uint32_t *rename_cookie)
+{
+    if (rename_old_path[0] == '\0') return;
+
+    SDL_LockMutex(data->watches_mutex);
+    for (size_t i = 0; i < MAX_WATCHED_PATHS; i++) {
+        LinuxPathHandle *handle = data->handles[i];
+        if (handle && strncmp(rename_old_path, handle->root_path, handle->root_len) == 0 &&
+            rename_old_path[handle->root_len] == '/') {
+            agentite_watch_notify(watcher, AGENTITE_WATCH_DELETED,
+                                  relative_to_root(handle, rename_old_path), NULL);
+            break;
+        }
+    }
+    SDL_UnlockMutex(data->watches_mutex);
+
+    rename_old_path[0] = '\0';
+    *rename_cookie = 0;
+}
+
 /**
  * Background thread function for Linux.
  * Reads inotify events and queues them for main thread processing.
@@ -317,7 +842,7 @@ static int watch_thread_func(void *userdata)
     Agentite_FileWatcher *watcher = (Agentite_FileWatcher *)userdata;
     LinuxWatchData *data = (LinuxWatchData *)watcher->platform_data;
 
-    char buffer[INOTIFY_BUFFER_SIZE];
+    char buffer[INOTIFY_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
     char rename_old_path[PATH_BUFFER_SIZE] = {0};
     uint32_t rename_cookie = 0;
 
@@ -331,7 +856,9 @@ static int watch_thread_func(void *userdata)
         int ret = select(data->inotify_fd + 1, &fds, NULL, NULL, &timeout);
 
         if (ret <= 0) {
-            continue;  /* Timeout or error */
+            /* Quiet period: a pending MOVED_FROM will not be paired */
+            flush_unpaired_move(watcher, data, rename_old_path, &rename_cookie);
+            continue;
         }
 
         ssize_t len = read(data->inotify_fd, buffer, sizeof(buffer));
@@ -344,98 +871,133 @@ static int watch_thread_func(void *userdata)
             struct inotify_event *event = (struct inotify_event *)ptr;
             ptr += sizeof(struct inotify_event) + event->len;
 
+            /* Kernel queue overflowed: events were lost, diff every root */
+            if (event->mask & IN_Q_OVERFLOW) {
+                rename_old_path[0] = '\0';
+                rename_cookie = 0;
+                SDL_LockMutex(data->watches_mutex);
+                for (size_t i = 0; i < MAX_WATCHED_PATHS; i++) {
+                    if (data->handles[i]) {
+                        rescan_root(watcher, data, data->handles[i]);
+                    }
+                }
+                SDL_UnlockMutex(data->watches_mutex);
+                continue;
+            }
+
+            /* Watch removed by the kernel (directory deleted or unwatched) */
+            if (event->mask & IN_IGNORED) {
+                SDL_LockMutex(data->watches_mutex);
+                InotifyWatch *watch = find_watch_by_wd(data, event->wd);
+                if (watch) {
+                    unmap_watch(data, watch);
+                }
+                SDL_UnlockMutex(data->watches_mutex);
+                continue;
+            }
+
             /* Skip events without a name (shouldn't happen with file events) */
             if (event->len == 0) {
                 continue;
             }
 
+            /* A MOVED_FROM must be followed directly by its MOVED_TO */
+            if (rename_old_path[0] != '\0' &&
+                !((event->mask & IN_MOVED_TO) && event->cookie == rename_cookie)) {
+                flush_unpaired_move(watcher, data, rename_old_path, &rename_cookie);
+            }
+
             /* Find the watch path */
             SDL_LockMutex(data->watches_mutex);
             InotifyWatch *watch = find_watch_by_wd(data, event->wd);
+            LinuxPathHandle *handle = watch ? watch->owner : NULL;
             char full_path[PATH_BUFFER_SIZE] = {0};
             if (watch) {
                 snprintf(full_path, sizeof(full_path), "%s/%s",
                         watch->path, event->name);
             }
-            SDL_UnlockMutex(data->watches_mutex);
 
-            if (full_path[0] == '\0') {
+            if (full_path[0] == '\0' || !handle) {
+                SDL_UnlockMutex(data->watches_mutex);
                 continue;
             }
 
             /* Determine event type */
             Agentite_WatchEventType type;
             const char *old_path = NULL;
+            bool is_dir = (event->mask & IN_ISDIR) != 0;
 
             if (event->mask & IN_CREATE) {
                 type = AGENTITE_WATCH_CREATED;
-
-                /* If a directory was created, add watch for it */
-                if ((event->mask & IN_ISDIR) && watcher->config.recursive) {
-                    /* Add watch for new directory */
-                    /* Note: This is a simplified approach; a production implementation
-                     * might need to handle this more carefully */
+                if (!is_dir) {
+                    update_snapshot(handle, full_path, true);
                 }
             } else if (event->mask & IN_DELETE) {
                 type = AGENTITE_WATCH_DELETED;
+                if (!is_dir) {
+                    update_snapshot(handle, full_path, false);
+                }
             } else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
                 type = AGENTITE_WATCH_MODIFIED;
+                if (event->mask & IN_CLOSE_WRITE) {
+                    update_snapshot(handle, full_path, true);
+                }
             } else if (event->mask & IN_MOVED_FROM) {
                 /* First part of rename - save for pairing */
+                if (is_dir) {
+                    unwatch_subtree(data, full_path);
+                    snapshot_remove_prefix(&handle->snapshot, relative_to_root(handle, full_path));
+                } else {
+                    update_snapshot(handle, full_path, false);
+                }
+                SDL_UnlockMutex(data->watches_mutex);
                 rename_cookie = event->cookie;
                 strncpy(rename_old_path, full_path, sizeof(rename_old_path) - 1);
                 continue;
             } else if (event->mask & IN_MOVED_TO) {
+                if (!is_dir) {
+                    update_snapshot(handle, full_path, true);
+                }
                 if (event->cookie == rename_cookie && rename_old_path[0] != '\0') {
                     /* Paired with MOVED_FROM - this is a rename */
                     type = AGENTITE_WATCH_RENAMED;
                     old_path = rename_old_path;
-                    rename_cookie = 0;
-                    rename_old_path[0] = '\0';
                 } else {
                     /* Moved from outside watched area - treat as create */
                     type = AGENTITE_WATCH_CREATED;
                 }
             } else {
+                SDL_UnlockMutex(data->watches_mutex);
                 continue;
             }
 
-            /* Find relative path */
-            const char *relative_path = full_path;
-            SDL_LockMutex(watcher->paths_mutex);
-            for (size_t j = 0; j < MAX_WATCHED_PATHS; j++) {
-                if (!watcher->paths[j].active) continue;
-                const char *root = watcher->paths[j].path;
-                size_t root_len = strlen(root);
-                if (strncmp(full_path, root, root_len) == 0) {
-                    relative_path = full_path + root_len;
-                    if (relative_path[0] == '/') relative_path++;
-                    break;
-                }
-            }
-            SDL_UnlockMutex(watcher->paths_mutex);
+            /* Relative paths come straight from the owning root */
+            char relative_path[PATH_BUFFER_SIZE];
+            strncpy(relative_path, relative_to_root(handle, full_path), sizeof(relative_path) - 1);
+            relative_path[sizeof(relative_path) - 1] = '\0';
 
-            /* Handle relative old_path for renames */
             char relative_old[PATH_BUFFER_SIZE] = {0};
             if (old_path) {
-                SDL_LockMutex(watcher->paths_mutex);
-                for (size_t j = 0; j < MAX_WATCHED_PATHS; j++) {
-                    if (!watcher->paths[j].active) continue;
-                    const char *root = watcher->paths[j].path;
-                    size_t root_len = strlen(root);
-                    if (strncmp(old_path, root, root_len) == 0) {
-                        const char *rel = old_path + root_len;
-                        if (rel[0] == '/') rel++;
-                        strncpy(relative_old, rel, sizeof(relative_old) - 1);
-                        break;
-                    }
+                if (strncmp(old_path, handle->root_path, handle->root_len) == 0) {
+                    strncpy(relative_old, relative_to_root(handle, old_path),
+                            sizeof(relative_old) - 1);
                 }
-                SDL_UnlockMutex(watcher->paths_mutex);
                 old_path = relative_old[0] ? relative_old : NULL;
+                rename_cookie = 0;
+                rename_old_path[0] = '\0';
             }
 
             /* Notify watcher */
             agentite_watch_notify(watcher, type, relative_path, old_path);
+
+            /* New directories are watched and scanned for files created
+             * before the watch existed */
+            if (is_dir && watcher->config.recursive &&
+                (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+                add_watches_recursive(watcher, data, handle, full_path, true);
+            }
+
+            SDL_UnlockMutex(data->watches_mutex);
         }
     }
 
@@ -1,12 +1,41 @@
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_ECS
 #include "agentite/agentite.h"
 #include "agentite/ecs.h"
+#include "agentite/error.h"
 #include "agentite/profiler.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+/**
+ * Timing wrapper for one system. The system's run callback is replaced by
+ * timed_system_run(), which finds the timer in run_ctx. Every stage adds to
+ * its own slot, so multi-threaded systems are timed without locks.
+ */
+struct EcsSystemTimer {
+    ecs_entity_t system;
+    ecs_run_action_t run;               /* Original run callback (NULL = iterate) */
+    bool has_terms;                     /* Query has terms to iterate */
+    bool multi_threaded;
+    char name[AGENTITE_PROFILER_MAX_SCOPE_NAME];
+    uint64_t stage_ticks[AGENTITE_ECS_MAX_THREADS];
+
+    /* Last progress */
+    double time_ms;
+    double cpu_time_ms;
+    bool ran;
+};
 
 struct Agentite_World {
     ecs_world_t *world;
     Agentite_Profiler *profiler;  /* Optional profiler for performance tracking */
+
+    /* Per-system timing, active while a profiler is set */
+    ecs_query_t *system_query;
+    EcsSystemTimer **timers;
+    int timer_count;
+    int timer_capacity;
+    uint64_t perf_freq;
 };
 
 // Component IDs (populated during registration)
@@ -27,7 +56,7 @@ Agentite_World *agentite_ecs_init(void) {
 
     cworld->world = ecs_init();
     if (!cworld->world) {
-        free(cworld);
+        AGENTITE_FREE(cworld);
         return NULL;
     }
 
@@ -49,10 +78,18 @@ void agentite_ecs_shutdown(Agentite_World *world) {
             ecs_defer_end(world->world);
         }
 
+        if (world->system_query) {
+            ecs_query_fini(world->system_query);
+        }
         ecs_fini(world->world);
     }
 
-    free(world);
+    /* Systems are gone with the world; their timers can go too */
+    for (int i = 0; i < world->timer_count; i++) {
+        AGENTITE_FREE(world->timers[i]);
+    }
+    AGENTITE_FREE(world->timers);
+    AGENTITE_FREE(world);
     ecs_log(1, "Carbon ECS shutdown complete");
 }
 
@@ -60,24 +97,183 @@ ecs_world_t *agentite_ecs_get_world(Agentite_World *world) {
     return world ? world->world : NULL;
 }
 
+/* ============================================================================
+ * System Timing
+ * ============================================================================ */
+
+static void timed_system_run(ecs_iter_t *it) {
+    EcsSystemTimer *timer = (EcsSystemTimer *)it->run_ctx;
+    int32_t stage = ecs_stage_get_id(it->world);
+    uint64_t start = SDL_GetPerformanceCounter();
+
+    /* The wrapped system never had a run_ctx of its own */
+    it->run_ctx = NULL;
+    if (timer->run) {
+        timer->run(it);
+    } else if (timer->has_terms) {
+        while (ecs_iter_next(it)) {
+            it->callback(it);
+        }
+    } else {
+        it->callback(it);
+    }
+
+    if (stage >= 0 && stage < AGENTITE_ECS_MAX_THREADS) {
+        timer->stage_ticks[stage] += SDL_GetPerformanceCounter() - start;
+    }
+}
+
+static EcsSystemTimer *add_system_timer(Agentite_World *world, ecs_entity_t system,
+                                        const ecs_system_t *sys) {
+    if (world->timer_count == world->timer_capacity) {
+        int capacity = world->timer_capacity ? world->timer_capacity * 2 : 16;
+        EcsSystemTimer **timers = AGENTITE_REALLOC(world->timers, EcsSystemTimer *, capacity);
+        if (!timers) return NULL;
+        world->timers = timers;
+        world->timer_capacity = capacity;
+    }
+
+    EcsSystemTimer *timer = AGENTITE_ALLOC(EcsSystemTimer);
+    if (!timer) return NULL;
+    timer->system = system;
+    timer->run = sys->run;
+    timer->has_terms = sys->query && sys->query->term_count > 0;
+    timer->multi_threaded = sys->multi_threaded;
+
+    const char *name = ecs_get_name(world->world, system);
+    if (name) {
+        snprintf(timer->name, sizeof(timer->name), "%s", name);
+    } else {
+        snprintf(timer->name, sizeof(timer->name), "system_%u", (unsigned)(uint32_t)system);
+    }
+
+    world->timers[world->timer_count++] = timer;
+    return timer;
+}
+
+/**
+ * Wrap systems created since the last call. Systems with their own run_ctx
+ * are left alone; they are only counted in the ecs_progress scope.
+ */
+static void wrap_new_systems(Agentite_World *world) {
+    if (!world->system_query) {
+        ecs_query_desc_t desc = {};
+        desc.terms[0].id = ecs_pair(ecs_id(EcsPoly), EcsSystem);
+        desc.terms[0].inout = EcsInOutNone;
+        desc.cache_kind = EcsQueryCacheAuto;
+        world->system_query = ecs_query_init(world->world, &desc);
+        if (!world->system_query) return;
+    }
+
+    ecs_iter_t it = ecs_query_iter(world->world, world->system_query);
+    while (ecs_query_next(&it)) {
+        for (int i = 0; i < it.count; i++) {
+            ecs_entity_t e = it.entities[i];
+            const ecs_system_t *sys = ecs_system_get(world->world, e);
+            if (!sys || sys->run == timed_system_run || sys->run_ctx) {
+                continue;
+            }
+
+            EcsSystemTimer *timer = add_system_timer(world, e, sys);
+            if (!timer) continue;
+
+            /* Updating an existing system only replaces the fields we set */
+            ecs_system_desc_t desc = {};
+            desc.entity = e;
+            desc.run = timed_system_run;
+            desc.run_ctx = timer;
+            ecs_system_init(world->world, &desc);
+        }
+    }
+}
+
+static void collect_system_timings(Agentite_World *world) {
+    double ms_per_tick = world->perf_freq ? 1000.0 / (double)world->perf_freq : 0.0;
+
+    for (int i = 0; i < world->timer_count; i++) {
+        EcsSystemTimer *timer = world->timers[i];
+        uint64_t total = 0, slowest = 0;
+        for (int s = 0; s < AGENTITE_ECS_MAX_THREADS; s++) {
+            uint64_t ticks = timer->stage_ticks[s];
+            total += ticks;
+            if (ticks > slowest) slowest = ticks;
+        }
+        memset(timer->stage_ticks, 0, sizeof(timer->stage_ticks));
+
+        timer->ran = total > 0;
+        timer->time_ms = (double)slowest * ms_per_tick;
+        timer->cpu_time_ms = (double)total * ms_per_tick;
+        if (timer->ran) {
+            agentite_profiler_record_scope(world->profiler, timer->name, timer->time_ms);
+        }
+    }
+}
+
 bool agentite_ecs_progress(Agentite_World *world, float delta_time) {
     if (!world || !world->world) return false;
 
     /* Profile ECS system iteration if profiler is set */
     if (world->profiler) {
+        wrap_new_systems(world);
         agentite_profiler_begin_scope(world->profiler, "ecs_progress");
     }
 
     bool result = ecs_progress(world->world, delta_time);
 
-    /* End profiling scope */
+    /* Per-system times nest under the ecs_progress scope */
     if (world->profiler) {
+        collect_system_timings(world);
         agentite_profiler_end_scope(world->profiler);
     }
 
     return result;
 }
 
+int agentite_ecs_get_system_timings(const Agentite_World *world,
+                                    Agentite_EcsSystemTiming *out_timings, int max_timings) {
+    if (!world || !out_timings || max_timings <= 0) return 0;
+
+    int count = 0;
+    for (int i = 0; i < world->timer_count && count < max_timings; i++) {
+        const EcsSystemTimer *timer = world->timers[i];
+        if (!timer->ran) continue;
+
+        Agentite_EcsSystemTiming *t = &out_timings[count++];
+        t->system = timer->system;
+        t->name = timer->name;
+        t->time_ms = timer->time_ms;
+        t->cpu_time_ms = timer->cpu_time_ms;
+        t->multi_threaded = timer->multi_threaded;
+    }
+    return count;
+}
+
+/* ============================================================================
+ * Threading
+ * ============================================================================ */
+
+bool agentite_ecs_set_threads(Agentite_World *world, int threads) {
+    if (!world || !world->world) return false;
+    if (ecs_stage_is_readonly(world->world)) {
+        agentite_set_error("ecs: cannot change threads while the world is progressing");
+        return false;
+    }
+
+    if (threads <= 0) {
+        threads = SDL_GetNumLogicalCPUCores();
+    }
+    if (threads < 1) threads = 1;
+    if (threads > AGENTITE_ECS_MAX_THREADS) threads = AGENTITE_ECS_MAX_THREADS;
+
+    ecs_set_threads(world->world, threads);
+    return true;
+}
+
+int agentite_ecs_get_threads(const Agentite_World *world) {
+    if (!world || !world->world) return 0;
+    return ecs_get_stage_count(world->world);
+}
+
 ecs_entity_t agentite_ecs_entity_new(Agentite_World *world) {
     if (!world || !world->world) return 0;
     return ecs_new(world->world);
@@ -118,5 +314,6 @@ void agentite_ecs_register_components(Agentite_World *world) {
 void agentite_ecs_set_profiler(Agentite_World *world, Agentite_Profiler *profiler) {
     if (world) {
         world->profiler = profiler;
+        world->perf_freq = SDL_GetPerformanceFrequency();
     }
 }
@@ -22,6 +22,10 @@ extern "C" {
                                                   const char *name,
                                                   const Agentite_ReflectRegistry *reflect);
     void agentite_prefab_destroy(Agentite_Prefab *prefab);
+
+    /* Defined below, also used by scene_cache.cpp */
+    void agentite_prefab_fill_component(void *data, const Agentite_ComponentMeta *meta,
+                                        const Agentite_ComponentConfig *config);
 }
 
 /* ============================================================================
@@ -311,6 +315,31 @@ static bool apply_field_value(void *component_data,
     return false;
 }
 
+/**
+ * Write a component config's field values into zeroed component data.
+ * A single "value" field maps to the component's first field.
+ * Shared with the compiled scene cache.
+ */
+void agentite_prefab_fill_component(void *data, const Agentite_ComponentMeta *meta,
+                                    const Agentite_ComponentConfig *config) {
+    for (int j = 0; j < config->field_count; j++) {
+        const Agentite_FieldAssign *assign = &config->fields[j];
+
+        if (strcmp(assign->field_name, "value") == 0 && meta->field_count > 0) {
+            apply_field_value(data, &meta->fields[0], &assign->value);
+            continue;
+        }
+
+        /* Find matching field by name */
+        for (int k = 0; k < meta->field_count; k++) {
+            if (strcmp(meta->fields[k].name, assign->field_name) == 0) {
+                apply_field_value(data, &meta->fields[k], &assign->value);
+                break;
+            }
+        }
+    }
+}
+
 /* ============================================================================
  * Prefab Spawning
  * ============================================================================ */
@@ -361,19 +390,7 @@ static ecs_entity_t spawn_prefab_internal(const Agentite_Prefab *prefab,
                 /* Allocate temp buffer for component data */
                 void *data = calloc(1, meta->size);
                 if (!data) continue;
-
-                /* Apply field values */
-                for (int j = 0; j < config->field_count; j++) {
-                    const Agentite_FieldAssign *assign = &config->fields[j];
-
-                    /* Find matching field */
-                    for (int k = 0; k < meta->field_count; k++) {
-                        if (strcmp(meta->fields[k].name, assign->field_name) == 0) {
-                            apply_field_value(data, &meta->fields[k], &assign->value);
-                            break;
-                        }
-                    }
-                }
+                agentite_prefab_fill_component(data, meta, config);
 
                 /* Set component on entity */
                 ecs_set_id(world, entity, meta->component_id, meta->size, data);
@@ -398,25 +415,7 @@ static ecs_entity_t spawn_prefab_internal(const Agentite_Prefab *prefab,
         /* Allocate temp buffer for component data */
         void *data = calloc(1, meta->size);
         if (!data) continue;
-
-        /* Apply field values */
-        for (int j = 0; j < config->field_count; j++) {
-            const Agentite_FieldAssign *assign = &config->fields[j];
-
-            /* Special case: single "value" field maps to first component field */
-            if (strcmp(assign->field_name, "value") == 0 && meta->field_count > 0) {
-                apply_field_value(data, &meta->fields[0], &assign->value);
-                continue;
-            }
-
-            /* Find matching field by name */
-            for (int k = 0; k < meta->field_count; k++) {
-                if (strcmp(meta->fields[k].name, assign->field_name) == 0) {
-                    apply_field_value(data, &meta->fields[k], &assign->value);
-                    break;
-                }
-            }
-        }
+        agentite_prefab_fill_component(data, meta, config);
 
         /* Set component on entity */
         ecs_set_id(world, entity, meta->component_id, meta->size, data);
@@ -437,16 +436,14 @@ static ecs_entity_t spawn_prefab_internal(const Agentite_Prefab *prefab,
         }
     }
 
-    /* Spawn child entities */
+    /* Spawn child entities at their local position (added by the child) */
     for (int i = 0; i < prefab->child_count; i++) {
         Agentite_SpawnContext child_ctx = *ctx;
         child_ctx.parent = entity;
         child_ctx.offset_x = 0;
         child_ctx.offset_y = 0;
 
-        spawn_prefab_internal(prefab->children[i], &child_ctx,
-                              prefab->children[i]->position[0],
-                              prefab->children[i]->position[1]);
+        spawn_prefab_internal(prefab->children[i], &child_ctx, 0.0f, 0.0f);
     }
 
     return entity;
@@ -476,3 +473,354 @@ ecs_entity_t agentite_prefab_spawn_at(const Agentite_Prefab *prefab,
 
     return agentite_prefab_spawn(prefab, &ctx);
 }
+
+/* ============================================================================
+ * Compiled Prefabs
+ * ============================================================================ */
+
+/* Base and own components, plus the position component */
+#define COMPILED_MAX_COMPONENTS (AGENTITE_PREFAB_MAX_COMPONENTS * 2 + 1)
+
+/* Component data offsets in the baked blob are aligned to this */
+#define COMPILED_DATA_ALIGN 8
+
+typedef struct CompiledComponent {
+    ecs_id_t id;
+    size_t size;                    /* 0 = tag */
+    size_t offset;                  /* Into the data blob */
+} CompiledComponent;
+
+struct Agentite_CompiledPrefab {
+    ecs_world_t *world;
+    char *name;                     /* Applied by single spawns only */
+    ecs_entity_t parent;            /* ChildOf target for roots (0 = none) */
+    float offset[2];                /* Added to every spawn position */
+
+    /* Entity type and baked values, in the order components were set */
+    CompiledComponent components[COMPILED_MAX_COMPONENTS];
+    int component_count;
+    int position_index;             /* Component taking the spawn position (-1 = none) */
+    uint8_t *data;
+    size_t data_size;
+
+    Agentite_CompiledPrefab *children[AGENTITE_PREFAB_MAX_CHILDREN];
+    int child_count;
+};
+
+/**
+ * Get zeroed data for a component. A component set twice (base and own
+ * prefab) starts over, as ecs_set_id() would overwrite it.
+ */
+static uint8_t *compiled_component_data(Agentite_CompiledPrefab *c,
+                                        const Agentite_ComponentMeta *meta, int *out_index) {
+    for (int i = 0; i < c->component_count; i++) {
+        if (c->components[i].id == meta->component_id) {
+            memset(c->data + c->components[i].offset, 0, c->components[i].size);
+            *out_index = i;
+            return c->data + c->components[i].offset;
+        }
+    }
+
+    if (c->component_count >= COMPILED_MAX_COMPONENTS) {
+        return NULL;
+    }
+
+    size_t offset = (c->data_size + COMPILED_DATA_ALIGN - 1) & ~(size_t)(COMPILED_DATA_ALIGN - 1);
+    size_t size = meta->size;
+    if (size > 0) {
+        uint8_t *data = (uint8_t *)realloc(c->data, offset + size);
+        if (!data) return NULL;
+        c->data = data;
+        memset(c->data + c->data_size, 0, offset + size - c->data_size);
+        c->data_size = offset + size;
+    }
+
+    CompiledComponent *comp = &c->components[c->component_count];
+    comp->id = meta->component_id;
+    comp->size = size;
+    comp->offset = offset;
+    *out_index = c->component_count++;
+    return c->data + offset;
+}
+
+static bool compile_components(Agentite_CompiledPrefab *c, const Agentite_Prefab *prefab,
+                               const Agentite_ReflectRegistry *reflect) {
+    for (int i = 0; i < prefab->component_count; i++) {
+        const Agentite_ComponentConfig *config = &prefab->components[i];
+        const Agentite_ComponentMeta *meta =
+            agentite_reflect_get_by_name(reflect, config->component_name);
+        if (!meta) {
+            /* Not in the reflection registry: skipped, as when spawning */
+            continue;
+        }
+
+        int index;
+        uint8_t *data = compiled_component_data(c, meta, &index);
+        if (!data) {
+            agentite_set_error("prefab: Too many components to compile '%s'",
+                               prefab->name ? prefab->name : "(unnamed)");
+            return false;
+        }
+        if (meta->size > 0) {
+            agentite_prefab_fill_component(data, meta, config);
+        }
+    }
+    return true;
+}
+
+static Agentite_CompiledPrefab *compile_prefab_internal(const Agentite_Prefab *prefab,
+                                                        const Agentite_SpawnContext *ctx,
+                                                        ecs_entity_t parent,
+                                                        float offset_x, float offset_y) {
+    Agentite_CompiledPrefab *c = (Agentite_CompiledPrefab *)calloc(1, sizeof(Agentite_CompiledPrefab));
+    if (!c) {
+        agentite_set_error("prefab: Failed to allocate compiled prefab");
+        return NULL;
+    }
+    c->world = ctx->world;
+    c->parent = parent;
+    c->offset[0] = offset_x + prefab->position[0];
+    c->offset[1] = offset_y + prefab->position[1];
+    c->position_index = -1;
+
+    if (prefab->name && prefab->name[0]) {
+        c->name = strdup(prefab->name);
+    }
+
+    /* Base prefab first, so the prefab's own components override it */
+    if (prefab->base_prefab_name && ctx->prefabs) {
+        const Agentite_Prefab *base = agentite_prefab_lookup(ctx->prefabs,
+                                                             prefab->base_prefab_name);
+        if (base && !compile_components(c, base, ctx->reflect)) {
+            agentite_prefab_compiled_destroy(c);
+            return NULL;
+        }
+    }
+    if (!compile_components(c, prefab, ctx->reflect)) {
+        agentite_prefab_compiled_destroy(c);
+        return NULL;
+    }
+
+    /* Position goes last and replaces any configured C_Position */
+    const Agentite_ComponentMeta *pos_meta =
+        agentite_reflect_get_by_name(ctx->reflect, "C_Position");
+    if (pos_meta && pos_meta->size >= sizeof(float) * 2) {
+        if (!compiled_component_data(c, pos_meta, &c->position_index)) {
+            agentite_set_error("prefab: Too many components to compile '%s'",
+                               prefab->name ? prefab->name : "(unnamed)");
+            agentite_prefab_compiled_destroy(c);
+            return NULL;
+        }
+    }
+
+    /* Children are parented at spawn time and placed at their local position */
+    for (int i = 0; i < prefab->child_count; i++) {
+        Agentite_CompiledPrefab *child = compile_prefab_internal(prefab->children[i], ctx,
+                                                                 0, 0.0f, 0.0f);
+        if (!child) {
+            agentite_prefab_compiled_destroy(c);
+            return NULL;
+        }
+        c->children[c->child_count++] = child;
+    }
+
+    return c;
+}
+
+Agentite_CompiledPrefab *agentite_prefab_compile(const Agentite_Prefab *prefab,
+                                                 const Agentite_SpawnContext *ctx) {
+    if (!prefab || !ctx || !ctx->world || !ctx->reflect) {
+        agentite_set_error("prefab: Invalid parameters");
+        return NULL;
+    }
+    return compile_prefab_internal(prefab, ctx, ctx->parent, ctx->offset_x, ctx->offset_y);
+}
+
+void agentite_prefab_compiled_destroy(Agentite_CompiledPrefab *compiled) {
+    if (!compiled) return;
+
+    for (int i = 0; i < compiled->child_count; i++) {
+        agentite_prefab_compiled_destroy(compiled->children[i]);
+    }
+    free(compiled->name);
+    free(compiled->data);
+    free(compiled);
+}
+
+static void write_spawn_position(const Agentite_CompiledPrefab *c, void *dst, float x, float y) {
+    float pos[2] = { c->offset[0] + x, c->offset[1] + y };
+    memcpy(dst, pos, sizeof(pos));
+}
+
+static int spawn_compiled_bulk(const Agentite_CompiledPrefab *c, ecs_entity_t parent,
+                               int count, const float *positions, ecs_entity_t *out_entities);
+static ecs_entity_t spawn_compiled_one(const Agentite_CompiledPrefab *c, ecs_entity_t parent,
+                                       float x, float y, bool use_name);
+
+/* Child names are scoped to their parent, so named children keep them */
+static void spawn_compiled_children(const Agentite_CompiledPrefab *c, ecs_entity_t entity) {
+    for (int i = 0; i < c->child_count; i++) {
+        const Agentite_CompiledPrefab *child = c->children[i];
+        if (child->name) {
+            spawn_compiled_one(child, entity, 0.0f, 0.0f, true);
+        } else {
+            spawn_compiled_bulk(child, entity, 1, NULL, NULL);
+        }
+    }
+}
+
+/** One entity through the regular (possibly deferred) set path */
+static ecs_entity_t spawn_compiled_one(const Agentite_CompiledPrefab *c, ecs_entity_t parent,
+                                       float x, float y, bool use_name) {
+    ecs_world_t *world = c->world;
+
+    ecs_entity_t entity;
+    if (use_name && c->name) {
+        ecs_entity_desc_t desc = {};
+        desc.name = c->name;
+        desc.parent = parent;   /* Look the name up in the parent's scope */
+        entity = ecs_entity_init(world, &desc);
+    } else {
+        entity = ecs_new(world);
+    }
+    if (!entity) return 0;
+
+    if (parent) {
+        ecs_add_pair(world, entity, EcsChildOf, parent);
+    }
+
+    for (int i = 0; i < c->component_count; i++) {
+        const CompiledComponent *comp = &c->components[i];
+        if (comp->size == 0) {
+            ecs_add_id(world, entity, comp->id);
+            continue;
+        }
+
+        void *dst = ecs_ensure_id(world, entity, comp->id);
+        memcpy(dst, c->data + comp->offset, comp->size);
+        if (i == c->position_index) {
+            write_spawn_position(c, dst, x, y);
+        }
+        ecs_modified_id(world, entity, comp->id);
+    }
+
+    spawn_compiled_children(c, entity);
+    return entity;
+}
+
+/** Fill count copies of size bytes, doubling the copied run each pass */
+static void fill_repeated(uint8_t *dst, const uint8_t *src, size_t size, int count) {
+    memcpy(dst, src, size);
+    size_t done = 1;
+    while (done < (size_t)count) {
+        size_t n = done <= (size_t)count - done ? done : (size_t)count - done;
+        memcpy(dst + done * size, dst, n * size);
+        done += n;
+    }
+}
+
+static int spawn_compiled_bulk(const Agentite_CompiledPrefab *c, ecs_entity_t parent,
+                               int count, const float *positions, ecs_entity_t *out_entities) {
+    ecs_world_t *world = c->world;
+    int id_count = c->component_count + (parent ? 1 : 0);
+
+    /* Commands cannot bulk insert; fall back to one entity at a time */
+    if (ecs_is_deferred(world) || id_count > FLECS_ID_DESC_MAX || id_count == 0) {
+        int spawned = 0;
+        for (int i = 0; i < count; i++) {
+            float x = positions ? positions[i * 2] : 0.0f;
+            float y = positions ? positions[i * 2 + 1] : 0.0f;
+            ecs_entity_t e = spawn_compiled_one(c, parent, x, y, false);
+            if (out_entities) out_entities[i] = e;
+            if (e) spawned++;
+        }
+        return spawned;
+    }
+
+    /* One column per component: count copies of its baked value */
+    uint8_t *columns = NULL;
+    if (c->data_size > 0) {
+        columns = (uint8_t *)malloc(c->data_size * (size_t)count);
+        if (!columns) {
+            agentite_set_error("prefab: Failed to allocate batch of %d", count);
+            return 0;
+        }
+    }
+
+    ecs_bulk_desc_t desc = {};
+    void *data[FLECS_ID_DESC_MAX] = {};
+    for (int i = 0; i < c->component_count; i++) {
+        const CompiledComponent *comp = &c->components[i];
+        desc.ids[i] = comp->id;
+        if (comp->size == 0) continue;
+
+        uint8_t *column = columns + comp->offset * (size_t)count;
+        fill_repeated(column, c->data + comp->offset, comp->size, count);
+        if (i == c->position_index) {
+            for (int n = 0; n < count; n++) {
+                write_spawn_position(c, column + (size_t)n * comp->size,
+                                     positions ? positions[n * 2] : 0.0f,
+                                     positions ? positions[n * 2 + 1] : 0.0f);
+            }
+        }
+        data[i] = column;
+    }
+    if (parent) {
+        desc.ids[c->component_count] = ecs_pair(EcsChildOf, parent);
+    }
+    desc.count = count;
+    desc.data = data;
+
+    const ecs_entity_t *entities = ecs_bulk_init(world, &desc);
+    free(columns);
+    if (!entities) {
+        agentite_set_error("prefab: Bulk spawn failed");
+        return 0;
+    }
+
+    if (c->child_count == 0) {
+        if (out_entities) {
+            memcpy(out_entities, entities, sizeof(ecs_entity_t) * (size_t)count);
+        }
+        return count;
+    }
+
+    /* Spawning children invalidates the returned id array; keep a copy */
+    ecs_entity_t *roots = out_entities;
+    if (!roots) {
+        roots = (ecs_entity_t *)malloc(sizeof(ecs_entity_t) * (size_t)count);
+        if (!roots) {
+            agentite_set_error("prefab: Failed to allocate batch of %d", count);
+            return count;
+        }
+    }
+    memcpy(roots, entities, sizeof(ecs_entity_t) * (size_t)count);
+    for (int i = 0; i < count; i++) {
+        spawn_compiled_children(c, roots[i]);
+    }
+    if (roots != out_entities) {
+        free(roots);
+    }
+    return count;
+}
+
+ecs_entity_t agentite_prefab_spawn_compiled(const Agentite_CompiledPrefab *compiled,
+                                            float x, float y) {
+    if (!compiled) return 0;
+
+    /* Names are unique per scope, so a named prefab takes the set path */
+    if (compiled->name) {
+        return spawn_compiled_one(compiled, compiled->parent, x, y, true);
+    }
+
+    float position[2] = { x, y };
+    ecs_entity_t entity = 0;
+    spawn_compiled_bulk(compiled, compiled->parent, 1, position, &entity);
+    return entity;
+}
+
+int agentite_prefab_spawn_batch(const Agentite_CompiledPrefab *compiled, int count,
+                                const float *positions, ecs_entity_t *out_entities) {
+    if (!compiled || count <= 0) return 0;
+    return spawn_compiled_bulk(compiled, compiled->parent, count, positions, out_entities);
+}
@@ -105,42 +105,90 @@ static void update_entity_transform(ecs_world_t *world,
 }
 
 /**
- * System callback for updating transforms.
- * Processes all root entities (entities with C_Transform but no parent).
+ * Describe the propagation query:
+ *   [in] C_Transform, [out] C_WorldTransform, [in] ?C_WorldTransform(cascade ChildOf)
+ *
+ * Cascade orders matched tables by hierarchy depth, so every parent's world
+ * transform is written before its children's table is visited. Instancing
+ * hands over whole tables, with the parent's transform as a single shared
+ * field (children of one parent share a table through their ChildOf pair).
  */
-static void TransformPropagationSystem(ecs_iter_t *it) {
-    C_Transform *transforms = ecs_field(it, C_Transform, 0);
-
-    for (int i = 0; i < it->count; i++) {
-        ecs_entity_t entity = it->entities[i];
-        C_Transform *local = &transforms[i];
-
-        /* Only process root entities (no parent) */
-        ecs_entity_t parent = ecs_get_parent(it->world, entity);
-        if (parent != 0) continue;
-
-        /* Compute world transform for root */
-        C_WorldTransform world_tf = {
-            local->local_x,
-            local->local_y,
-            local->rotation,
-            local->scale_x,
-            local->scale_y
-        };
-
-        ecs_set_id(it->world, entity, ecs_id(C_WorldTransform),
-                   sizeof(C_WorldTransform), &world_tf);
-
-        /* Update children recursively */
-        ecs_iter_t child_it = ecs_children(it->world, entity);
-        while (ecs_children_next(&child_it)) {
-            for (int j = 0; j < child_it.count; j++) {
-                update_entity_transform(it->world, child_it.entities[j], &world_tf);
+static void init_propagation_query(ecs_query_desc_t *desc) {
+    desc->terms[0].id = ecs_id(C_Transform);
+    desc->terms[0].inout = EcsIn;
+
+    desc->terms[1].id = ecs_id(C_WorldTransform);
+    desc->terms[1].inout = EcsOut;
+
+    desc->terms[2].id = ecs_id(C_WorldTransform);
+    desc->terms[2].inout = EcsIn;
+    desc->terms[2].src.id = EcsCascade | EcsUp;
+    desc->terms[2].trav = EcsChildOf;
+    desc->terms[2].oper = EcsOptional;
+
+    desc->cache_kind = EcsQueryCacheAuto;
+    desc->flags = EcsQueryIsInstanced;
+}
+
+/**
+ * Write world transforms in place for every table in the iteration.
+ *
+ * With only_changed set, tables are skipped unless Flecs change detection
+ * reports that their local transforms, their entity set, or their parent's
+ * world transform changed since the last pass. Skipped tables do not mark
+ * their world transforms dirty, so unchanged subtrees are never revisited.
+ */
+static void propagate_transforms(ecs_iter_t *it, bool only_changed) {
+    while (ecs_query_next(it)) {
+        if (only_changed && !ecs_iter_changed(it)) {
+            ecs_iter_skip(it);
+            continue;
+        }
+
+        const C_Transform *local = ecs_field(it, C_Transform, 0);
+        C_WorldTransform *world = ecs_field(it, C_WorldTransform, 1);
+
+        /* Roots: local is world */
+        if (!ecs_field_is_set(it, 2)) {
+            for (int i = 0; i < it->count; i++) {
+                world[i].world_x = local[i].local_x;
+                world[i].world_y = local[i].local_y;
+                world[i].world_rotation = local[i].rotation;
+                world[i].world_scale_x = local[i].scale_x;
+                world[i].world_scale_y = local[i].scale_y;
             }
+            continue;
+        }
+
+        /* Children: one parent for the whole table, so its rotation is
+         * evaluated once */
+        const C_WorldTransform *parent = ecs_field(it, C_WorldTransform, 2);
+        float cos_r = cosf(parent->world_rotation);
+        float sin_r = sinf(parent->world_rotation);
+
+        for (int i = 0; i < it->count; i++) {
+            float sx = local[i].local_x * parent->world_scale_x;
+            float sy = local[i].local_y * parent->world_scale_y;
+            world[i].world_x = sx * cos_r - sy * sin_r + parent->world_x;
+            world[i].world_y = sx * sin_r + sy * cos_r + parent->world_y;
+            world[i].world_rotation = parent->world_rotation + local[i].rotation;
+            world[i].world_scale_x = parent->world_scale_x * local[i].scale_x;
+            world[i].world_scale_y = parent->world_scale_y * local[i].scale_y;
         }
     }
 }
 
+/**
+ * System run callback: propagate only the subtrees that changed.
+ */
+static void TransformPropagationSystem(ecs_iter_t *it) {
+    if (!ecs_query_changed((ecs_query_t *)it->query)) {
+        ecs_iter_fini(it);
+        return;
+    }
+    propagate_transforms(it, true);
+}
+
 /* ============================================================================
  * Registration
  * ============================================================================ */
@@ -152,14 +200,21 @@ void agentite_transform_register(ecs_world_t *world) {
     ECS_COMPONENT_DEFINE(world, C_Transform);
     ECS_COMPONENT_DEFINE(world, C_WorldTransform);
 
+    /* Every local transform gets a world transform for the system to fill */
+    ecs_add_pair(world, ecs_id(C_Transform), EcsWith, ecs_id(C_WorldTransform));
+
     /* Register transform propagation system */
     ecs_entity_desc_t entity_desc = {};
     entity_desc.name = "TransformPropagationSystem";
 
     ecs_system_desc_t sys_desc = {};
     sys_desc.entity = ecs_entity_init(world, &entity_desc);
-    sys_desc.query.terms[0].id = ecs_id(C_Transform);
-    sys_desc.callback = TransformPropagationSystem;
+    init_propagation_query(&sys_desc.query);
+    sys_desc.run = TransformPropagationSystem;
+
+    /* Not multi_threaded: workers split every table, so a child slice could
+     * run before another worker has written the parent it reads */
+    sys_desc.multi_threaded = false;
 
     ecs_entity_t system = ecs_system_init(world, &sys_desc);
 
@@ -473,24 +528,15 @@ void agentite_transform_update(ecs_world_t *world, ecs_entity_t entity) {
 void agentite_transform_update_all(ecs_world_t *world) {
     if (!world) return;
 
-    /* Query all root transforms (transforms with no parent) */
+    /* Same pass as the system, without skipping unchanged tables */
     ecs_query_desc_t query_desc = {};
-    query_desc.terms[0].id = ecs_id(C_Transform);
+    init_propagation_query(&query_desc);
 
     ecs_query_t *q = ecs_query_init(world, &query_desc);
     if (!q) return;
 
     ecs_iter_t it = ecs_query_iter(world, q);
-    while (ecs_query_next(&it)) {
-        for (int i = 0; i < it.count; i++) {
-            ecs_entity_t entity = it.entities[i];
-
-            /* Only process roots */
-            if (ecs_get_parent(world, entity) != 0) continue;
-
-            update_entity_transform(world, entity, NULL);
-        }
-    }
+    propagate_transforms(&it, false);
 
     ecs_query_fini(q);
 }
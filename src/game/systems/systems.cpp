@@ -1,20 +1,51 @@
 #include "systems.h"
 #include "../components.h"
 
+/**
+ * Register a system in the OnUpdate phase.
+ * The terms mark what the system reads ([in]) and writes ([inout]/[out]);
+ * Flecs uses them to place sync points between systems.
+ * multi_threaded systems are split across the ECS threads and must only
+ * touch the components of the entity being updated.
+ */
+static void register_system(ecs_world_t *world, const char *name, ecs_iter_action_t fn,
+                            const char *terms, bool multi_threaded) {
+    ecs_id_t phases[] = { ecs_dependson(EcsOnUpdate), EcsOnUpdate, 0 };
+
+    ecs_entity_desc_t entity_desc = {};
+    entity_desc.name = name;
+    entity_desc.add = phases;
+
+    ecs_system_desc_t desc = {};
+    desc.entity = ecs_entity_init(world, &entity_desc);
+    desc.query.expr = terms;
+    desc.callback = fn;
+    desc.multi_threaded = multi_threaded;
+    ecs_system_init(world, &desc);
+}
+
 void game_systems_register(ecs_world_t *world) {
     if (!world) return;
 
-    /* Movement systems */
-    ECS_SYSTEM(world, MovementSystem, EcsOnUpdate, C_Position, C_Velocity);
-    ECS_SYSTEM(world, PlayerInputSystem, EcsOnUpdate, C_PlayerInput, C_Velocity, C_Speed);
-    ECS_SYSTEM(world, FrictionSystem, EcsOnUpdate, C_Velocity, C_Speed);
+    /* Movement systems (per entity, safe to split across threads) */
+    register_system(world, "MovementSystem", MovementSystem,
+                    "[inout] C_Position, [in] C_Velocity", true);
+    register_system(world, "PlayerInputSystem", PlayerInputSystem,
+                    "[in] C_PlayerInput, [inout] C_Velocity, [in] C_Speed", true);
+    register_system(world, "FrictionSystem", FrictionSystem,
+                    "[inout] C_Velocity, [in] C_Speed", true);
 
-    /* Collision systems */
-    ECS_SYSTEM(world, CollisionSystem, EcsOnUpdate, C_Position, C_Collider);
-    ECS_SYSTEM(world, ProjectileSystem, EcsOnUpdate, C_Projectile);
-    ECS_SYSTEM(world, DamageSystem, EcsOnUpdate, C_Damage, C_Position, C_Collider);
+    /* Collision systems (compare entities with each other) */
+    register_system(world, "CollisionSystem", CollisionSystem,
+                    "[inout] C_Position, [in] C_Collider", false);
+    register_system(world, "ProjectileSystem", ProjectileSystem,
+                    "[inout] C_Projectile", true);
+    register_system(world, "DamageSystem", DamageSystem,
+                    "[in] C_Damage, [in] C_Position, [in] C_Collider", false);
 
-    /* AI systems */
-    ECS_SYSTEM(world, AIBehaviorSystem, EcsOnUpdate, C_AIState, C_Position, C_Enemy);
-    ECS_SYSTEM(world, PathFollowSystem, EcsOnUpdate, C_PathFollow, C_Position, C_Velocity);
+    /* AI systems (behavior reads its target's position) */
+    register_system(world, "AIBehaviorSystem", AIBehaviorSystem,
+                    "[inout] C_AIState, [in] C_Position, [in] C_Enemy", false);
+    register_system(world, "PathFollowSystem", PathFollowSystem,
+                    "[inout] C_PathFollow, [in] C_Position, [out] C_Velocity", true);
 }
@@ -28,12 +28,11 @@
  * Constants
  * ============================================================================ */
 
-#define SPRITE_MAX_BATCH 4096           /* Max sprites per batch */
+#define SPRITE_INITIAL_BATCH 4096       /* Sprites per batch before growing */
+#define SPRITE_MAX_BATCH (1u << 22)     /* Growth limit (4M sprites, 320 MB of vertices) */
 #define SPRITE_VERTS_PER_SPRITE 4
 #define SPRITE_INDICES_PER_SPRITE 6
-#define SPRITE_VERTEX_CAPACITY (SPRITE_MAX_BATCH * SPRITE_VERTS_PER_SPRITE)
-#define SPRITE_INDEX_CAPACITY (SPRITE_MAX_BATCH * SPRITE_INDICES_PER_SPRITE)
-#define SPRITE_MAX_SUB_BATCHES 64       /* Max texture switches per batch */
+#define SPRITE_INITIAL_SUB_BATCHES 64   /* Texture switches per batch before growing */
 
 /* Sub-batch for tracking texture switches within a single batch */
 typedef struct SpriteBatchSegment {
@@ -178,20 +177,26 @@ struct Agentite_SpriteRenderer {
     SDL_GPUSampler *linear_repeat;        /* Linear filter, repeat/tile */
     SDL_GPUSampler *linear_mirror;        /* Linear filter, mirror */
 
-    /* CPU-side batch buffers */
+    /* CPU-side batch buffers, grown by doubling when a frame needs more */
     Agentite_SpriteVertex *vertices;
-    uint16_t *indices;
+    uint32_t *indices;          /* Prebuilt quad pattern for every slot */
+    uint32_t sprite_capacity;   /* Quads the CPU buffers hold */
     uint32_t vertex_count;
     uint32_t index_count;
     uint32_t sprite_count;
 
+    /* GPU buffer sizes; recreated at upload when the CPU side outgrows them */
+    uint32_t gpu_capacity;      /* Quads the GPU buffers hold */
+    bool gpu_indices_uploaded;  /* Index pattern is static, uploaded once per buffer */
+
     /* Current batch state */
     Agentite_Texture *current_texture;
     bool batch_started;
     SDL_GPUCommandBuffer *current_cmd;  /* Command buffer for auto-flush */
 
     /* Sub-batch tracking for texture switches */
-    SpriteBatchSegment segments[SPRITE_MAX_SUB_BATCHES];
+    SpriteBatchSegment *segments;
+    uint32_t segment_capacity;
     uint32_t segment_count;
     uint32_t current_segment_start;  /* Starting index for current segment */
 
@@ -302,7 +307,7 @@ static bool sprite_create_pipeline(Agentite_SpriteRenderer *sr)
     attributes[1].offset = offsetof(Agentite_SpriteVertex, uv);
     attributes[2].location = 2;
     attributes[2].buffer_slot = 0;
-    attributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
+    attributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM;
     attributes[2].offset = offsetof(Agentite_SpriteVertex, color);
 
     SDL_GPUVertexBufferDescription vb_desc = {};
@@ -457,7 +462,7 @@ static bool sprite_create_vignette_pipeline(Agentite_SpriteRenderer *sr)
     attributes[1].offset = offsetof(Agentite_SpriteVertex, uv);
     attributes[2].location = 2;
     attributes[2].buffer_slot = 0;
-    attributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
+    attributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM;
     attributes[2].offset = offsetof(Agentite_SpriteVertex, color);
 
     SDL_GPUVertexBufferDescription vb_desc = {};
@@ -555,6 +560,81 @@ static SDL_GPUSampler *get_sampler_for_texture(Agentite_SpriteRenderer *sr,
     }
 }
 
+/* ============================================================================
+ * Internal: Batch Buffers
+ * ============================================================================ */
+
+/* Grow the CPU vertex and index arrays to hold at least quads sprites */
+static bool sprite_reserve(Agentite_SpriteRenderer *sr, uint32_t quads)
+{
+    if (quads <= sr->sprite_capacity) return true;
+    if (quads > SPRITE_MAX_BATCH) return false;
+
+    uint32_t capacity = sr->sprite_capacity ? sr->sprite_capacity : SPRITE_INITIAL_BATCH;
+    while (capacity < quads) capacity *= 2;
+    if (capacity > SPRITE_MAX_BATCH) capacity = SPRITE_MAX_BATCH;
+
+    Agentite_SpriteVertex *vertices = (Agentite_SpriteVertex*)realloc(
+        sr->vertices, (size_t)capacity * SPRITE_VERTS_PER_SPRITE * sizeof(Agentite_SpriteVertex));
+    if (!vertices) return false;
+    sr->vertices = vertices;
+
+    uint32_t *indices = (uint32_t*)realloc(
+        sr->indices, (size_t)capacity * SPRITE_INDICES_PER_SPRITE * sizeof(uint32_t));
+    if (!indices) return false;
+    sr->indices = indices;
+
+    /* Pre-generate indices for the new slots (quads always have same pattern) */
+    for (uint32_t i = sr->sprite_capacity; i < capacity; i++) {
+        uint32_t base_vertex = i * 4;
+        uint32_t base_index = i * 6;
+        sr->indices[base_index + 0] = base_vertex + 0;
+        sr->indices[base_index + 1] = base_vertex + 1;
+        sr->indices[base_index + 2] = base_vertex + 2;
+        sr->indices[base_index + 3] = base_vertex + 0;
+        sr->indices[base_index + 4] = base_vertex + 2;
+        sr->indices[base_index + 5] = base_vertex + 3;
+    }
+
+    sr->sprite_capacity = capacity;
+    return true;
+}
+
+/* (Re)create the GPU vertex and index buffers for quads sprites.
+ * The old buffers are kept if creation fails. */
+static bool sprite_create_gpu_buffers(Agentite_SpriteRenderer *sr, uint32_t quads)
+{
+    SDL_GPUBufferCreateInfo vb_info = {};
+    vb_info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
+    vb_info.size = (Uint32)(quads * SPRITE_VERTS_PER_SPRITE * sizeof(Agentite_SpriteVertex));
+    vb_info.props = 0;
+    SDL_GPUBuffer *vertex_buffer = SDL_CreateGPUBuffer(sr->gpu, &vb_info);
+    if (!vertex_buffer) {
+        agentite_set_error_from_sdl("Sprite: Failed to create vertex buffer");
+        return false;
+    }
+
+    SDL_GPUBufferCreateInfo ib_info = {};
+    ib_info.usage = SDL_GPU_BUFFERUSAGE_INDEX;
+    ib_info.size = (Uint32)(quads * SPRITE_INDICES_PER_SPRITE * sizeof(uint32_t));
+    ib_info.props = 0;
+    SDL_GPUBuffer *index_buffer = SDL_CreateGPUBuffer(sr->gpu, &ib_info);
+    if (!index_buffer) {
+        agentite_set_error_from_sdl("Sprite: Failed to create index buffer");
+        SDL_ReleaseGPUBuffer(sr->gpu, vertex_buffer);
+        return false;
+    }
+
+    /* Release is deferred by SDL until in-flight command buffers finish */
+    if (sr->vertex_buffer) SDL_ReleaseGPUBuffer(sr->gpu, sr->vertex_buffer);
+    if (sr->index_buffer) SDL_ReleaseGPUBuffer(sr->gpu, sr->index_buffer);
+    sr->vertex_buffer = vertex_buffer;
+    sr->index_buffer = index_buffer;
+    sr->gpu_capacity = quads;
+    sr->gpu_indices_uploaded = false;
+    return true;
+}
+
 /* ============================================================================
  * Lifecycle Functions
  * ============================================================================ */
@@ -576,46 +656,17 @@ Agentite_SpriteRenderer *agentite_sprite_init(SDL_GPUDevice *gpu, SDL_Window *wi
     /* Get window size in logical coordinates (matches camera and text renderer) */
     SDL_GetWindowSize(window, &sr->screen_width, &sr->screen_height);
 
-    /* Allocate CPU-side buffers */
-    sr->vertices = (Agentite_SpriteVertex*)malloc(SPRITE_VERTEX_CAPACITY * sizeof(Agentite_SpriteVertex));
-    sr->indices = (uint16_t*)malloc(SPRITE_INDEX_CAPACITY * sizeof(uint16_t));
-    if (!sr->vertices || !sr->indices) {
+    /* Allocate CPU-side buffers (indices are pre-generated per slot) */
+    sr->segments = (SpriteBatchSegment*)malloc(SPRITE_INITIAL_SUB_BATCHES * sizeof(SpriteBatchSegment));
+    sr->segment_capacity = SPRITE_INITIAL_SUB_BATCHES;
+    if (!sr->segments || !sprite_reserve(sr, SPRITE_INITIAL_BATCH)) {
         agentite_set_error("Sprite: Failed to allocate batch buffers");
         agentite_sprite_shutdown(sr);
         return NULL;
     }
 
-    /* Pre-generate index buffer (quads always have same index pattern) */
-    for (uint32_t i = 0; i < SPRITE_MAX_BATCH; i++) {
-        uint32_t base_vertex = i * 4;
-        uint32_t base_index = i * 6;
-        sr->indices[base_index + 0] = (uint16_t)(base_vertex + 0);
-        sr->indices[base_index + 1] = (uint16_t)(base_vertex + 1);
-        sr->indices[base_index + 2] = (uint16_t)(base_vertex + 2);
-        sr->indices[base_index + 3] = (uint16_t)(base_vertex + 0);
-        sr->indices[base_index + 4] = (uint16_t)(base_vertex + 2);
-        sr->indices[base_index + 5] = (uint16_t)(base_vertex + 3);
-    }
-
     /* Create GPU buffers */
-    SDL_GPUBufferCreateInfo vb_info = {};
-    vb_info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
-    vb_info.size = (Uint32)(SPRITE_VERTEX_CAPACITY * sizeof(Agentite_SpriteVertex));
-    vb_info.props = 0;
-    sr->vertex_buffer = SDL_CreateGPUBuffer(gpu, &vb_info);
-    if (!sr->vertex_buffer) {
-        agentite_set_error_from_sdl("Sprite: Failed to create vertex buffer");
-        agentite_sprite_shutdown(sr);
-        return NULL;
-    }
-
-    SDL_GPUBufferCreateInfo ib_info = {};
-    ib_info.usage = SDL_GPU_BUFFERUSAGE_INDEX;
-    ib_info.size = (Uint32)(SPRITE_INDEX_CAPACITY * sizeof(uint16_t));
-    ib_info.props = 0;
-    sr->index_buffer = SDL_CreateGPUBuffer(gpu, &ib_info);
-    if (!sr->index_buffer) {
-        agentite_set_error_from_sdl("Sprite: Failed to create index buffer");
+    if (!sprite_create_gpu_buffers(sr, SPRITE_INITIAL_BATCH)) {
         agentite_sprite_shutdown(sr);
         return NULL;
     }
@@ -701,6 +752,7 @@ void agentite_sprite_shutdown(Agentite_SpriteRenderer *sr)
 
     free(sr->vertices);
     free(sr->indices);
+    free(sr->segments);
     free(sr);
 
     SDL_Log("Sprite: Renderer shutdown complete");
@@ -1047,44 +1099,143 @@ void agentite_sprite_begin(Agentite_SpriteRenderer *sr, SDL_GPUCommandBuffer *cm
     sr->batch_started = true;
 }
 
-/* Internal: Add a sprite quad to the batch */
-static void sprite_add_quad(Agentite_SpriteRenderer *sr,
-                            float x0, float y0, float x1, float y1,
-                            float x2, float y2, float x3, float y3,
-                            float u0, float v0, float u1, float v1,
-                            float r, float g, float b, float a)
+/* Internal: Clamp a 0-1 component and round it to a byte (NaN -> 0) */
+static inline uint8_t sprite_unorm8(float v)
 {
-    if (sr->sprite_count >= SPRITE_MAX_BATCH) {
-        SDL_Log("Sprite: Batch overflow, sprite dropped");
-        return;
-    }
+    v = v > 0.0f ? v : 0.0f;
+    v = v < 1.0f ? v : 1.0f;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
 
-    uint32_t base = sr->sprite_count * 4;
-    Agentite_SpriteVertex *v = &sr->vertices[base];
+void agentite_sprite_pack_color(uint8_t out[4], float r, float g, float b, float a)
+{
+    out[0] = sprite_unorm8(r);
+    out[1] = sprite_unorm8(g);
+    out[2] = sprite_unorm8(b);
+    out[3] = sprite_unorm8(a);
+}
 
-    /* Top-left */
-    v[0].pos[0] = x0; v[0].pos[1] = y0;
-    v[0].uv[0] = u0; v[0].uv[1] = v0;
-    v[0].color[0] = r; v[0].color[1] = g; v[0].color[2] = b; v[0].color[3] = a;
+void agentite_sprite_build_quad(Agentite_SpriteVertex *out,
+                                float x, float y, float w, float h,
+                                float rotation_deg,
+                                float origin_x, float origin_y,
+                                float u0, float v0, float u1, float v1,
+                                float r, float g, float b, float a)
+{
+    /* Calculate origin offset */
+    float ox = w * origin_x;
+    float oy = h * origin_y;
 
-    /* Top-right */
-    v[1].pos[0] = x1; v[1].pos[1] = y1;
-    v[1].uv[0] = u1; v[1].uv[1] = v0;
-    v[1].color[0] = r; v[1].color[1] = g; v[1].color[2] = b; v[1].color[3] = a;
+    /* Calculate corner positions relative to origin */
+    float x0 = -ox;
+    float y0 = -oy;
+    float x1 = w - ox;
+    float y1 = h - oy;
 
-    /* Bottom-right */
-    v[2].pos[0] = x2; v[2].pos[1] = y2;
-    v[2].uv[0] = u1; v[2].uv[1] = v1;
-    v[2].color[0] = r; v[2].color[1] = g; v[2].color[2] = b; v[2].color[3] = a;
+    Agentite_SpriteVertex *v = out;
+    if (rotation_deg != 0.0f) {
+        float rad = rotation_deg * (3.14159265358979323846f / 180.0f);
+        float cos_r = cosf(rad);
+        float sin_r = sinf(rad);
 
-    /* Bottom-left */
-    v[3].pos[0] = x3; v[3].pos[1] = y3;
+        /* Rotate corners around origin */
+        v[0].pos[0] = x + x0 * cos_r - y0 * sin_r;
+        v[0].pos[1] = y + x0 * sin_r + y0 * cos_r;
+        v[1].pos[0] = x + x1 * cos_r - y0 * sin_r;
+        v[1].pos[1] = y + x1 * sin_r + y0 * cos_r;
+        v[2].pos[0] = x + x1 * cos_r - y1 * sin_r;
+        v[2].pos[1] = y + x1 * sin_r + y1 * cos_r;
+        v[3].pos[0] = x + x0 * cos_r - y1 * sin_r;
+        v[3].pos[1] = y + x0 * sin_r + y1 * cos_r;
+    } else {
+        /* No rotation - just translate */
+        v[0].pos[0] = x + x0; v[0].pos[1] = y + y0;
+        v[1].pos[0] = x + x1; v[1].pos[1] = y + y0;
+        v[2].pos[0] = x + x1; v[2].pos[1] = y + y1;
+        v[3].pos[0] = x + x0; v[3].pos[1] = y + y1;
+    }
+
+    /* Top-left, top-right, bottom-right, bottom-left */
+    v[0].uv[0] = u0; v[0].uv[1] = v0;
+    v[1].uv[0] = u1; v[1].uv[1] = v0;
+    v[2].uv[0] = u1; v[2].uv[1] = v1;
     v[3].uv[0] = u0; v[3].uv[1] = v1;
-    v[3].color[0] = r; v[3].color[1] = g; v[3].color[2] = b; v[3].color[3] = a;
 
-    sr->sprite_count++;
-    sr->vertex_count = sr->sprite_count * 4;
-    sr->index_count = sr->sprite_count * 6;
+    /* Pack the tint once and share it across the four corners */
+    const uint8_t color[4] = {
+        sprite_unorm8(r), sprite_unorm8(g), sprite_unorm8(b), sprite_unorm8(a)
+    };
+    memcpy(v[0].color, color, 4);
+    memcpy(v[1].color, color, 4);
+    memcpy(v[2].color, color, 4);
+    memcpy(v[3].color, color, 4);
+}
+
+/* Internal: Make room for quads more sprites, growing the batch if needed.
+ * Returns how many fit (fewer only when growth fails). */
+static uint32_t sprite_make_room(Agentite_SpriteRenderer *sr, uint32_t quads)
+{
+    uint32_t needed = sr->sprite_count + quads;
+    if (needed > sr->sprite_capacity && !sprite_reserve(sr, needed)) {
+        uint32_t space = sr->sprite_capacity - sr->sprite_count;
+        SDL_Log("Sprite: Batch cannot grow past %u sprites, %u dropped",
+                sr->sprite_capacity, quads - space);
+        return space;
+    }
+    return quads;
+}
+
+/* Internal: Cut the batch back to quads sprites, clipping segments to match */
+static void sprite_truncate(Agentite_SpriteRenderer *sr, uint32_t quads)
+{
+    if (quads >= sr->sprite_count) return;
+    sr->sprite_count = quads;
+    sr->vertex_count = quads * 4;
+    sr->index_count = quads * 6;
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < sr->segment_count; i++) {
+        SpriteBatchSegment *seg = &sr->segments[i];
+        if (seg->start_index >= sr->index_count) break;
+        if (seg->start_index + seg->index_count > sr->index_count) {
+            seg->index_count = sr->index_count - seg->start_index;
+        }
+        kept++;
+    }
+    sr->segment_count = kept;
+    if (sr->current_segment_start > sr->index_count) {
+        sr->current_segment_start = sr->index_count;
+    }
+}
+
+/* Internal: Switch texture, closing the current segment if it has content */
+static void sprite_set_texture(Agentite_SpriteRenderer *sr, Agentite_Texture *texture)
+{
+    /* Handle texture changes by creating new batch segments */
+    if (sr->current_texture && sr->current_texture != texture) {
+        /* Save current segment if it has content */
+        uint32_t current_indices = sr->index_count - sr->current_segment_start;
+        if (current_indices > 0 && sr->segment_count >= sr->segment_capacity) {
+            uint32_t capacity = sr->segment_capacity * 2;
+            SpriteBatchSegment *segments = (SpriteBatchSegment*)realloc(
+                sr->segments, capacity * sizeof(SpriteBatchSegment));
+            if (!segments) {
+                /* Keep drawing into the open segment with the old texture */
+                SDL_Log("Sprite: Warning - out of memory for texture switch");
+                return;
+            }
+            sr->segments = segments;
+            sr->segment_capacity = capacity;
+        }
+        if (current_indices > 0) {
+            sr->segments[sr->segment_count].texture = sr->current_texture;
+            sr->segments[sr->segment_count].start_index = sr->current_segment_start;
+            sr->segments[sr->segment_count].index_count = current_indices;
+            sr->segment_count++;
+            sr->current_segment_start = sr->index_count;
+        }
+    }
+    sr->current_texture = texture;
 }
 
 void agentite_sprite_draw(Agentite_SpriteRenderer *sr, const Agentite_Sprite *sprite,
@@ -1133,22 +1284,9 @@ void agentite_sprite_draw_full(Agentite_SpriteRenderer *sr, const Agentite_Sprit
                              float r, float g, float b, float a)
 {
     if (!sr || !sprite || !sprite->texture || !sr->batch_started) return;
+    if (sprite_make_room(sr, 1) == 0) return;
 
-    /* Handle texture changes by creating new batch segments */
-    if (sr->current_texture && sr->current_texture != sprite->texture) {
-        /* Save current segment if it has content */
-        uint32_t current_indices = sr->index_count - sr->current_segment_start;
-        if (current_indices > 0 && sr->segment_count < SPRITE_MAX_SUB_BATCHES) {
-            sr->segments[sr->segment_count].texture = sr->current_texture;
-            sr->segments[sr->segment_count].start_index = sr->current_segment_start;
-            sr->segments[sr->segment_count].index_count = current_indices;
-            sr->segment_count++;
-            sr->current_segment_start = sr->index_count;
-        } else if (sr->segment_count >= SPRITE_MAX_SUB_BATCHES) {
-            SDL_Log("Sprite: Warning - too many texture switches, segment dropped");
-        }
-    }
-    sr->current_texture = sprite->texture;
+    sprite_set_texture(sr, sprite->texture);
 
     Agentite_Texture *tex = sprite->texture;
     float tex_w = (float)tex->width;
@@ -1160,50 +1298,32 @@ void agentite_sprite_draw_full(Agentite_SpriteRenderer *sr, const Agentite_Sprit
     float u1 = (sprite->src_x + sprite->src_w) / tex_w;
     float v1 = (sprite->src_y + sprite->src_h) / tex_h;
 
-    /* Calculate sprite dimensions */
-    float w = sprite->src_w * scale_x;
-    float h = sprite->src_h * scale_y;
-
-    /* Calculate origin offset */
-    float ox = w * origin_x;
-    float oy = h * origin_y;
-
-    /* Calculate corner positions relative to origin */
-    float x0 = -ox;
-    float y0 = -oy;
-    float x1 = w - ox;
-    float y1 = h - oy;
-
-    /* Apply rotation if needed */
-    float px0, py0, px1, py1, px2, py2, px3, py3;
-
-    if (rotation_deg != 0.0f) {
-        float rad = rotation_deg * (3.14159265358979323846f / 180.0f);
-        float cos_r = cosf(rad);
-        float sin_r = sinf(rad);
+    agentite_sprite_build_quad(&sr->vertices[sr->sprite_count * 4],
+                               x, y, sprite->src_w * scale_x, sprite->src_h * scale_y,
+                               rotation_deg, origin_x, origin_y,
+                               u0, v0, u1, v1, r, g, b, a);
 
-        /* Rotate corners around origin */
-        px0 = x + x0 * cos_r - y0 * sin_r;
-        py0 = y + x0 * sin_r + y0 * cos_r;
+    sr->sprite_count++;
+    sr->vertex_count = sr->sprite_count * 4;
+    sr->index_count = sr->sprite_count * 6;
+}
 
-        px1 = x + x1 * cos_r - y0 * sin_r;
-        py1 = y + x1 * sin_r + y0 * cos_r;
+void agentite_sprite_draw_quads(Agentite_SpriteRenderer *sr, Agentite_Texture *texture,
+                                const Agentite_SpriteVertex *vertices, uint32_t quad_count)
+{
+    if (!sr || !texture || !vertices || quad_count == 0 || !sr->batch_started) return;
 
-        px2 = x + x1 * cos_r - y1 * sin_r;
-        py2 = y + x1 * sin_r + y1 * cos_r;
+    quad_count = sprite_make_room(sr, quad_count);
+    if (quad_count == 0) return;
 
-        px3 = x + x0 * cos_r - y1 * sin_r;
-        py3 = y + x0 * sin_r + y1 * cos_r;
-    } else {
-        /* No rotation - just translate */
-        px0 = x + x0; py0 = y + y0;
-        px1 = x + x1; py1 = y + y0;
-        px2 = x + x1; py2 = y + y1;
-        px3 = x + x0; py3 = y + y1;
-    }
+    sprite_set_texture(sr, texture);
 
-    sprite_add_quad(sr, px0, py0, px1, py1, px2, py2, px3, py3,
-                    u0, v0, u1, v1, r, g, b, a);
+    /* Indices are prebuilt for every quad slot, so only vertices are copied */
+    memcpy(&sr->vertices[sr->sprite_count * 4], vertices,
+           quad_count * 4 * sizeof(Agentite_SpriteVertex));
+    sr->sprite_count += quad_count;
+    sr->vertex_count = sr->sprite_count * 4;
+    sr->index_count = sr->sprite_count * 6;
 }
 
 void agentite_sprite_flush(Agentite_SpriteRenderer *sr, SDL_GPUCommandBuffer *cmd,
@@ -1242,7 +1362,7 @@ void agentite_sprite_flush(Agentite_SpriteRenderer *sr, SDL_GPUCommandBuffer *cm
     SDL_GPUBufferBinding ib_binding = {};
     ib_binding.buffer = sr->index_buffer;
     ib_binding.offset = 0;
-    SDL_BindGPUIndexBuffer(pass, &ib_binding, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    SDL_BindGPUIndexBuffer(pass, &ib_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
 
     /* Push uniforms */
     float uniforms[4] = {(float)sr->screen_width, (float)sr->screen_height, 0, 0};
@@ -1274,25 +1394,37 @@ void agentite_sprite_upload(Agentite_SpriteRenderer *sr, SDL_GPUCommandBuffer *c
         agentite_profiler_begin_scope(sr->profiler, "sprite_upload");
     }
 
-    /* Upload vertex and index data */
+    /* Grow the GPU buffers when this frame's batch outgrew them */
+    if (sr->sprite_count > sr->gpu_capacity &&
+        !sprite_create_gpu_buffers(sr, sr->sprite_capacity)) {
+        SDL_Log("Sprite: Failed to grow GPU buffers, %u sprites not drawn",
+                sr->sprite_count - sr->gpu_capacity);
+        sprite_truncate(sr, sr->gpu_capacity);
+    }
+
+    /* Upload vertex data, plus the static index pattern once per buffer */
+    uint32_t vertex_bytes = (uint32_t)(sr->vertex_count * sizeof(Agentite_SpriteVertex));
+    uint32_t index_bytes = sr->gpu_indices_uploaded ? 0 :
+        (uint32_t)(sr->gpu_capacity * SPRITE_INDICES_PER_SPRITE * sizeof(uint32_t));
+
     SDL_GPUTransferBufferCreateInfo transfer_info = {};
     transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-    transfer_info.size = (Uint32)(sr->vertex_count * sizeof(Agentite_SpriteVertex) +
-            sr->index_count * sizeof(uint16_t));
+    transfer_info.size = vertex_bytes + index_bytes;
     transfer_info.props = 0;
     SDL_GPUTransferBuffer *transfer = SDL_CreateGPUTransferBuffer(sr->gpu, &transfer_info);
     if (!transfer) return;
 
     void *mapped = SDL_MapGPUTransferBuffer(sr->gpu, transfer, false);
     if (mapped) {
-        memcpy(mapped, sr->vertices,
-               sr->vertex_count * sizeof(Agentite_SpriteVertex));
-        memcpy((uint8_t *)mapped + sr->vertex_count * sizeof(Agentite_SpriteVertex),
-               sr->indices, sr->index_count * sizeof(uint16_t));
+        memcpy(mapped, sr->vertices, vertex_bytes);
+        if (index_bytes > 0) {
+            memcpy((uint8_t *)mapped + vertex_bytes, sr->indices, index_bytes);
+        }
         SDL_UnmapGPUTransferBuffer(sr->gpu, transfer);
     }
 
-    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(cmd);
+    /* Nothing to copy if mapping failed; indices stay pending */
+    SDL_GPUCopyPass *copy_pass = mapped ? SDL_BeginGPUCopyPass(cmd) : NULL;
     if (copy_pass) {
         /* Upload vertices */
         SDL_GPUTransferBufferLocation src_vert = {};
@@ -1301,18 +1433,21 @@ void agentite_sprite_upload(Agentite_SpriteRenderer *sr, SDL_GPUCommandBuffer *c
         SDL_GPUBufferRegion dst_vert = {};
         dst_vert.buffer = sr->vertex_buffer;
         dst_vert.offset = 0;
-        dst_vert.size = (Uint32)(sr->vertex_count * sizeof(Agentite_SpriteVertex));
+        dst_vert.size = vertex_bytes;
         SDL_UploadToGPUBuffer(copy_pass, &src_vert, &dst_vert, false);
 
         /* Upload indices */
-        SDL_GPUTransferBufferLocation src_idx = {};
-        src_idx.transfer_buffer = transfer;
-        src_idx.offset = (Uint32)(sr->vertex_count * sizeof(Agentite_SpriteVertex));
-        SDL_GPUBufferRegion dst_idx = {};
-        dst_idx.buffer = sr->index_buffer;
-        dst_idx.offset = 0;
-        dst_idx.size = (Uint32)(sr->index_count * sizeof(uint16_t));
-        SDL_UploadToGPUBuffer(copy_pass, &src_idx, &dst_idx, false);
+        if (index_bytes > 0) {
+            SDL_GPUTransferBufferLocation src_idx = {};
+            src_idx.transfer_buffer = transfer;
+            src_idx.offset = vertex_bytes;
+            SDL_GPUBufferRegion dst_idx = {};
+            dst_idx.buffer = sr->index_buffer;
+            dst_idx.offset = 0;
+            dst_idx.size = index_bytes;
+            SDL_UploadToGPUBuffer(copy_pass, &src_idx, &dst_idx, false);
+            sr->gpu_indices_uploaded = true;
+        }
 
         SDL_EndGPUCopyPass(copy_pass);
     }
@@ -1372,7 +1507,7 @@ void agentite_sprite_render(Agentite_SpriteRenderer *sr, SDL_GPUCommandBuffer *c
     SDL_GPUBufferBinding ib_binding = {};
     ib_binding.buffer = sr->index_buffer;
     ib_binding.offset = 0;
-    SDL_BindGPUIndexBuffer(pass, &ib_binding, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    SDL_BindGPUIndexBuffer(pass, &ib_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
 
     /* Build uniforms: mat4 view_projection + vec2 screen_size + vec2 padding */
     struct {
@@ -1580,7 +1715,7 @@ void agentite_sprite_render_vignette(Agentite_SpriteRenderer *sr,
     SDL_GPUBufferBinding ib_binding = {};
     ib_binding.buffer = sr->index_buffer;
     ib_binding.offset = 0;
-    SDL_BindGPUIndexBuffer(pass, &ib_binding, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    SDL_BindGPUIndexBuffer(pass, &ib_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
 
     /* Build uniforms: ortho projection for screen-space quad */
     struct {
@@ -1627,22 +1762,22 @@ void agentite_sprite_prepare_fullscreen_quad(Agentite_SpriteRenderer *sr)
     /* Top-left */
     v[0].pos[0] = 0.0f; v[0].pos[1] = 0.0f;
     v[0].uv[0] = 0.0f; v[0].uv[1] = 0.0f;
-    v[0].color[0] = 1.0f; v[0].color[1] = 1.0f; v[0].color[2] = 1.0f; v[0].color[3] = 1.0f;
+    v[0].color[0] = 255; v[0].color[1] = 255; v[0].color[2] = 255; v[0].color[3] = 255;
 
     /* Top-right */
     v[1].pos[0] = w; v[1].pos[1] = 0.0f;
     v[1].uv[0] = 1.0f; v[1].uv[1] = 0.0f;
-    v[1].color[0] = 1.0f; v[1].color[1] = 1.0f; v[1].color[2] = 1.0f; v[1].color[3] = 1.0f;
+    v[1].color[0] = 255; v[1].color[1] = 255; v[1].color[2] = 255; v[1].color[3] = 255;
 
     /* Bottom-right */
     v[2].pos[0] = w; v[2].pos[1] = h;
     v[2].uv[0] = 1.0f; v[2].uv[1] = 1.0f;
-    v[2].color[0] = 1.0f; v[2].color[1] = 1.0f; v[2].color[2] = 1.0f; v[2].color[3] = 1.0f;
+    v[2].color[0] = 255; v[2].color[1] = 255; v[2].color[2] = 255; v[2].color[3] = 255;
 
     /* Bottom-left */
     v[3].pos[0] = 0.0f; v[3].pos[1] = h;
     v[3].uv[0] = 0.0f; v[3].uv[1] = 1.0f;
-    v[3].color[0] = 1.0f; v[3].color[1] = 1.0f; v[3].color[2] = 1.0f; v[3].color[3] = 1.0f;
+    v[3].color[0] = 255; v[3].color[1] = 255; v[3].color[2] = 255; v[3].color[3] = 255;
 }
 
 void agentite_sprite_upload_fullscreen_quad(Agentite_SpriteRenderer *sr, SDL_GPUCommandBuffer *cmd)
@@ -1653,7 +1788,7 @@ void agentite_sprite_upload_fullscreen_quad(Agentite_SpriteRenderer *sr, SDL_GPU
     /* Upload vertex data for fullscreen quad */
     SDL_GPUTransferBufferCreateInfo transfer_info = {};
     transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-    transfer_info.size = (Uint32)(4 * sizeof(Agentite_SpriteVertex) + 6 * sizeof(uint16_t));
+    transfer_info.size = (Uint32)(4 * sizeof(Agentite_SpriteVertex) + 6 * sizeof(uint32_t));
     transfer_info.props = 0;
     SDL_GPUTransferBuffer *transfer = SDL_CreateGPUTransferBuffer(sr->gpu, &transfer_info);
     if (!transfer) return;
@@ -1662,7 +1797,7 @@ void agentite_sprite_upload_fullscreen_quad(Agentite_SpriteRenderer *sr, SDL_GPU
     if (mapped) {
         memcpy(mapped, sr->vertices, 4 * sizeof(Agentite_SpriteVertex));
         memcpy((uint8_t *)mapped + 4 * sizeof(Agentite_SpriteVertex),
-               sr->indices, 6 * sizeof(uint16_t));
+               sr->indices, 6 * sizeof(uint32_t));
         SDL_UnmapGPUTransferBuffer(sr->gpu, transfer);
     }
 
@@ -1685,7 +1820,7 @@ void agentite_sprite_upload_fullscreen_quad(Agentite_SpriteRenderer *sr, SDL_GPU
         SDL_GPUBufferRegion dst_idx = {};
         dst_idx.buffer = sr->index_buffer;
         dst_idx.offset = 0;
-        dst_idx.size = (Uint32)(6 * sizeof(uint16_t));
+        dst_idx.size = (Uint32)(6 * sizeof(uint32_t));
         SDL_UploadToGPUBuffer(copy_pass, &src_idx, &dst_idx, false);
 
         SDL_EndGPUCopyPass(copy_pass);
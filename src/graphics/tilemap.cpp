@@ -1,13 +1,16 @@
 /*
  * Carbon Tilemap System Implementation
  *
- * Chunk-based tile storage for efficient large map rendering.
+ * Chunk-based tile storage for efficient large map rendering. Each chunk
+ * caches its quads; rendering copies them into the sprite batch and only
+ * chunks whose tiles changed are rebuilt.
  */
 
 #include "agentite/agentite.h"
 #include "agentite/tilemap.h"
 #include "agentite/sprite.h"
 #include "agentite/camera.h"
+#include "tilemap_internal.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -16,10 +19,15 @@
  * Internal Types
  * ============================================================================ */
 
-/* Chunk: 32x32 tiles */
+/* Chunk: 32x32 tiles, palette-compressed (see tilemap_internal.h) */
 typedef struct Agentite_TileChunk {
-    Agentite_TileID tiles[AGENTITE_TILEMAP_CHUNK_SIZE * AGENTITE_TILEMAP_CHUNK_SIZE];
-    uint32_t tile_count;  /* Non-empty tile count (skip chunk if 0) */
+    TileChunkStorage storage;
+
+    /* Cached geometry, rebuilt at render time when dirty */
+    Agentite_SpriteVertex *mesh;  /* 4 vertices per quad */
+    uint32_t mesh_quads;
+    uint32_t mesh_capacity;       /* Quads */
+    bool mesh_dirty;
 } Agentite_TileChunk;
 
 /* Layer: sparse 2D array of chunks */
@@ -35,7 +43,7 @@ struct Agentite_TileLayer {
 /* Tileset: texture divided into tiles */
 struct Agentite_Tileset {
     Agentite_Texture *texture;
-    Agentite_Sprite *sprites;     /* Pre-computed sprite per tile */
+    Agentite_TileUV *uvs;       /* Pre-computed texture rectangle per tile */
     int tile_width;
     int tile_height;
     int columns;                /* Tiles per row in texture */
@@ -99,9 +107,9 @@ Agentite_Tileset *agentite_tileset_create_ex(Agentite_Texture *texture,
         return NULL;
     }
 
-    /* Pre-compute sprites for each tile */
-    ts->sprites = (Agentite_Sprite*)malloc(ts->tile_count * sizeof(Agentite_Sprite));
-    if (!ts->sprites) {
+    /* Pre-compute texture coordinates for each tile */
+    ts->uvs = (Agentite_TileUV*)malloc(ts->tile_count * sizeof(Agentite_TileUV));
+    if (!ts->uvs) {
         free(ts);
         return NULL;
     }
@@ -113,10 +121,10 @@ Agentite_Tileset *agentite_tileset_create_ex(Agentite_Texture *texture,
         float src_x = (float)(margin + tx * (tile_width + spacing));
         float src_y = (float)(margin + ty * (tile_height + spacing));
 
-        ts->sprites[i] = agentite_sprite_create(texture, src_x, src_y,
-                                              (float)tile_width, (float)tile_height);
-        /* Set origin to top-left for tilemap rendering */
-        agentite_sprite_set_origin(&ts->sprites[i], 0.0f, 0.0f);
+        ts->uvs[i].u0 = src_x / (float)tex_w;
+        ts->uvs[i].v0 = src_y / (float)tex_h;
+        ts->uvs[i].u1 = (src_x + (float)tile_width) / (float)tex_w;
+        ts->uvs[i].v1 = (src_y + (float)tile_height) / (float)tex_h;
     }
 
     return ts;
@@ -125,7 +133,7 @@ Agentite_Tileset *agentite_tileset_create_ex(Agentite_Texture *texture,
 void agentite_tileset_destroy(Agentite_Tileset *tileset)
 {
     if (!tileset) return;
-    free(tileset->sprites);
+    free(tileset->uvs);
     free(tileset);
 }
 
@@ -141,6 +149,18 @@ int agentite_tileset_get_tile_count(const Agentite_Tileset *tileset)
     return tileset ? tileset->tile_count : 0;
 }
 
+/* ============================================================================
+ * Internal Chunk Storage
+ * ============================================================================ */
+
+static void chunk_destroy(Agentite_TileChunk *chunk)
+{
+    if (!chunk) return;
+    tile_chunk_release(&chunk->storage);
+    free(chunk->mesh);
+    free(chunk);
+}
+
 /* ============================================================================
  * Internal Layer Functions
  * ============================================================================ */
@@ -175,7 +195,7 @@ static void layer_destroy(Agentite_TileLayer *layer)
     /* Free all allocated chunks */
     int total_chunks = layer->chunks_x * layer->chunks_y;
     for (int i = 0; i < total_chunks; i++) {
-        free(layer->chunks[i]);
+        chunk_destroy(layer->chunks[i]);
     }
     free(layer->chunks);
     free(layer->name);
@@ -335,7 +355,14 @@ void agentite_tilemap_set_layer_opacity(Agentite_Tilemap *tilemap, int layer, fl
     if (l) {
         if (opacity < 0.0f) opacity = 0.0f;
         if (opacity > 1.0f) opacity = 1.0f;
+        if (opacity == l->opacity) return;
         l->opacity = opacity;
+
+        /* Opacity is baked into the cached vertices */
+        int total_chunks = l->chunks_x * l->chunks_y;
+        for (int i = 0; i < total_chunks; i++) {
+            if (l->chunks[i]) l->chunks[i]->mesh_dirty = true;
+        }
     }
 }
 
@@ -369,16 +396,12 @@ void agentite_tilemap_set_tile(Agentite_Tilemap *tilemap, int layer,
     if (!chunk) return;
 
     int idx = ly * AGENTITE_TILEMAP_CHUNK_SIZE + lx;
-    Agentite_TileID old_tile = chunk->tiles[idx];
-
-    /* Update tile count */
-    if (old_tile == AGENTITE_TILE_EMPTY && tile != AGENTITE_TILE_EMPTY) {
-        chunk->tile_count++;
-    } else if (old_tile != AGENTITE_TILE_EMPTY && tile == AGENTITE_TILE_EMPTY) {
-        chunk->tile_count--;
+    bool changed = false;
+    if (!tile_chunk_set(&chunk->storage, idx, tile, &changed)) {
+        agentite_set_error("Tilemap: out of memory growing chunk palette");
+        return;
     }
-
-    chunk->tiles[idx] = tile;
+    if (changed) chunk->mesh_dirty = true;
 }
 
 Agentite_TileID agentite_tilemap_get_tile(const Agentite_Tilemap *tilemap, int layer,
@@ -399,7 +422,7 @@ Agentite_TileID agentite_tilemap_get_tile(const Agentite_Tilemap *tilemap, int l
     const Agentite_TileChunk *chunk = layer_get_chunk_const(l, cx, cy);
     if (!chunk) return AGENTITE_TILE_EMPTY;
 
-    return chunk->tiles[ly * AGENTITE_TILEMAP_CHUNK_SIZE + lx];
+    return tile_chunk_get(&chunk->storage, ly * AGENTITE_TILEMAP_CHUNK_SIZE + lx);
 }
 
 void agentite_tilemap_fill(Agentite_Tilemap *tilemap, int layer,
@@ -415,9 +438,25 @@ void agentite_tilemap_fill(Agentite_Tilemap *tilemap, int layer,
     if (y + height > tilemap->height) height = tilemap->height - y;
     if (width <= 0 || height <= 0) return;
 
-    for (int ty = y; ty < y + height; ty++) {
-        for (int tx = x; tx < x + width; tx++) {
-            agentite_tilemap_set_tile(tilemap, layer, tx, ty, tile);
+    Agentite_TileLayer *l = agentite_tilemap_get_layer(tilemap, layer);
+    if (!l) return;
+
+    /* Chunks covered completely become uniform without touching each tile */
+    const int cs = AGENTITE_TILEMAP_CHUNK_SIZE;
+    for (int cy = y / cs; cy <= (y + height - 1) / cs; cy++) {
+        for (int cx = x / cs; cx <= (x + width - 1) / cs; cx++) {
+            Agentite_TileChunk *chunk = layer_ensure_chunk(l, cx, cy);
+            if (!chunk) continue;
+
+            int x0 = cx * cs, y0 = cy * cs;
+            bool changed = false;
+            bool ok = tile_chunk_fill(&chunk->storage, x - x0, y - y0,
+                                      x + width - x0, y + height - y0, tile, &changed);
+            if (changed) chunk->mesh_dirty = true;
+            if (!ok) {
+                agentite_set_error("Tilemap: out of memory growing chunk palette");
+                return;
+            }
         }
     }
 }
@@ -430,8 +469,8 @@ void agentite_tilemap_clear_layer(Agentite_Tilemap *tilemap, int layer)
     int total_chunks = l->chunks_x * l->chunks_y;
     for (int i = 0; i < total_chunks; i++) {
         if (l->chunks[i]) {
-            memset(l->chunks[i]->tiles, 0, sizeof(l->chunks[i]->tiles));
-            l->chunks[i]->tile_count = 0;
+            tile_chunk_set_uniform(&l->chunks[i]->storage, AGENTITE_TILE_EMPTY);
+            l->chunks[i]->mesh_dirty = true;
         }
     }
 }
@@ -440,6 +479,81 @@ void agentite_tilemap_clear_layer(Agentite_Tilemap *tilemap, int layer)
  * Rendering Functions
  * ============================================================================ */
 
+int agentite_tilemap_build_mesh(const Agentite_TileMeshDesc *desc,
+                              const Agentite_TileID *tiles,
+                              int width, int height, int stride,
+                              Agentite_SpriteVertex *out_vertices)
+{
+    if (!desc || !desc->uvs || !tiles || !out_vertices) return 0;
+
+    float tw = desc->tile_width;
+    float th = desc->tile_height;
+    uint8_t color[4];
+    agentite_sprite_pack_color(color, 1.0f, 1.0f, 1.0f, desc->opacity);
+    Agentite_SpriteVertex *v = out_vertices;
+    int quads = 0;
+
+    for (int ty = 0; ty < height; ty++) {
+        const Agentite_TileID *row = tiles + ty * stride;
+        float y0 = desc->origin_y + (float)ty * th;
+        float y1 = y0 + th;
+
+        for (int tx = 0; tx < width; tx++) {
+            Agentite_TileID tile_id = row[tx];
+            if (tile_id == AGENTITE_TILE_EMPTY) continue;
+
+            /* Tile ID is 1-based, UV array is 0-based */
+            int uv_idx = tile_id - 1;
+            if (uv_idx >= desc->uv_count) continue;
+            const Agentite_TileUV *uv = &desc->uvs[uv_idx];
+
+            float x0 = desc->origin_x + (float)tx * tw;
+            float x1 = x0 + tw;
+
+            /* Same corner order as the sprite batch: TL, TR, BR, BL */
+            v[0] = { { x0, y0 }, { uv->u0, uv->v0 }, { color[0], color[1], color[2], color[3] } };
+            v[1] = { { x1, y0 }, { uv->u1, uv->v0 }, { color[0], color[1], color[2], color[3] } };
+            v[2] = { { x1, y1 }, { uv->u1, uv->v1 }, { color[0], color[1], color[2], color[3] } };
+            v[3] = { { x0, y1 }, { uv->u0, uv->v1 }, { color[0], color[1], color[2], color[3] } };
+            v += 4;
+            quads++;
+        }
+    }
+    return quads;
+}
+
+/* Rebuild a chunk's cached quads from its tiles */
+static bool chunk_build_mesh(const Agentite_Tilemap *tilemap, const Agentite_TileLayer *layer,
+                             Agentite_TileChunk *chunk, int cx, int cy)
+{
+    if (chunk->storage.tile_count > chunk->mesh_capacity) {
+        Agentite_SpriteVertex *mesh = (Agentite_SpriteVertex*)realloc(
+            chunk->mesh, chunk->storage.tile_count * 4 * sizeof(Agentite_SpriteVertex));
+        if (!mesh) return false;
+        chunk->mesh = mesh;
+        chunk->mesh_capacity = chunk->storage.tile_count;
+    }
+
+    const Agentite_Tileset *ts = tilemap->tileset;
+    Agentite_TileMeshDesc desc;
+    desc.uvs = ts->uvs;
+    desc.uv_count = ts->tile_count;
+    desc.tile_width = (float)tilemap->tile_width;
+    desc.tile_height = (float)tilemap->tile_height;
+    desc.origin_x = (float)(cx * AGENTITE_TILEMAP_CHUNK_SIZE * tilemap->tile_width);
+    desc.origin_y = (float)(cy * AGENTITE_TILEMAP_CHUNK_SIZE * tilemap->tile_height);
+    desc.opacity = layer->opacity;
+
+    /* Tiles past the map edge are never set, so whole chunks can be walked */
+    Agentite_TileID tiles[TILE_CHUNK_TILES];
+    tile_chunk_decode(&chunk->storage, tiles);
+    chunk->mesh_quads = (uint32_t)agentite_tilemap_build_mesh(
+        &desc, tiles, AGENTITE_TILEMAP_CHUNK_SIZE, AGENTITE_TILEMAP_CHUNK_SIZE,
+        AGENTITE_TILEMAP_CHUNK_SIZE, chunk->mesh);
+    chunk->mesh_dirty = false;
+    return true;
+}
+
 void agentite_tilemap_render_layer(Agentite_Tilemap *tilemap,
                                  Agentite_SpriteRenderer *sr,
                                  Agentite_Camera *camera,
@@ -477,43 +591,18 @@ void agentite_tilemap_render_layer(Agentite_Tilemap *tilemap,
     if (chunk_max_x > tilemap->chunks_x) chunk_max_x = tilemap->chunks_x;
     if (chunk_max_y > tilemap->chunks_y) chunk_max_y = tilemap->chunks_y;
 
-    float opacity = layer->opacity;
     Agentite_Tileset *ts = tilemap->tileset;
 
-    /* Render visible chunks */
+    /* Submit visible chunks, rebuilding only those whose tiles changed */
     for (int cy = chunk_min_y; cy < chunk_max_y; cy++) {
         for (int cx = chunk_min_x; cx < chunk_max_x; cx++) {
             Agentite_TileChunk *chunk = layer_get_chunk(layer, cx, cy);
-            if (!chunk || chunk->tile_count == 0) continue;
+            if (!chunk || chunk->storage.tile_count == 0) continue;
 
-            /* Base world position of this chunk */
-            int base_tile_x = cx * AGENTITE_TILEMAP_CHUNK_SIZE;
-            int base_tile_y = cy * AGENTITE_TILEMAP_CHUNK_SIZE;
-
-            /* Render tiles in this chunk */
-            for (int ly = 0; ly < AGENTITE_TILEMAP_CHUNK_SIZE; ly++) {
-                int tile_y = base_tile_y + ly;
-                if (tile_y >= tilemap->height) break;
-
-                for (int lx = 0; lx < AGENTITE_TILEMAP_CHUNK_SIZE; lx++) {
-                    int tile_x = base_tile_x + lx;
-                    if (tile_x >= tilemap->width) break;
-
-                    Agentite_TileID tile_id = chunk->tiles[ly * AGENTITE_TILEMAP_CHUNK_SIZE + lx];
-                    if (tile_id == AGENTITE_TILE_EMPTY) continue;
-
-                    /* Tile ID is 1-based, sprite array is 0-based */
-                    int sprite_idx = tile_id - 1;
-                    if (sprite_idx < 0 || sprite_idx >= ts->tile_count) continue;
-
-                    Agentite_Sprite *sprite = &ts->sprites[sprite_idx];
-                    float world_x = (float)(tile_x * tilemap->tile_width);
-                    float world_y = (float)(tile_y * tilemap->tile_height);
-
-                    agentite_sprite_draw_tinted(sr, sprite, world_x, world_y,
-                                              1.0f, 1.0f, 1.0f, opacity);
-                }
+            if (chunk->mesh_dirty || !chunk->mesh) {
+                if (!chunk_build_mesh(tilemap, layer, chunk, cx, cy)) continue;
             }
+            agentite_sprite_draw_quads(sr, ts->texture, chunk->mesh, chunk->mesh_quads);
         }
     }
 }
@@ -530,6 +619,53 @@ void agentite_tilemap_render(Agentite_Tilemap *tilemap,
     }
 }
 
+void agentite_tilemap_release_meshes(Agentite_Tilemap *tilemap)
+{
+    if (!tilemap) return;
+
+    for (int i = 0; i < tilemap->layer_count; i++) {
+        Agentite_TileLayer *layer = tilemap->layers[i];
+        int total_chunks = layer->chunks_x * layer->chunks_y;
+        for (int c = 0; c < total_chunks; c++) {
+            Agentite_TileChunk *chunk = layer->chunks[c];
+            if (!chunk) continue;
+            free(chunk->mesh);
+            chunk->mesh = NULL;
+            chunk->mesh_quads = 0;
+            chunk->mesh_capacity = 0;
+        }
+    }
+}
+
+/* ============================================================================
+ * Memory
+ * ============================================================================ */
+
+void agentite_tilemap_get_memory_stats(const Agentite_Tilemap *tilemap,
+                                       Agentite_TilemapMemoryStats *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!tilemap) return;
+
+    for (int i = 0; i < tilemap->layer_count; i++) {
+        const Agentite_TileLayer *layer = tilemap->layers[i];
+        int total_chunks = layer->chunks_x * layer->chunks_y;
+        for (int c = 0; c < total_chunks; c++) {
+            const Agentite_TileChunk *chunk = layer->chunks[c];
+            if (!chunk) continue;
+
+            tile_chunk_add_stats(&chunk->storage, out);
+            out->tile_bytes += sizeof(Agentite_TileChunk);
+            out->mesh_bytes += (size_t)chunk->mesh_capacity * 4 * sizeof(Agentite_SpriteVertex);
+        }
+    }
+
+    /* The previous layout: a fixed array plus a tile count per chunk */
+    out->uncompressed_bytes = (size_t)out->chunk_count *
+        (TILE_CHUNK_TILES * sizeof(Agentite_TileID) + sizeof(uint32_t));
+}
+
 /* ============================================================================
  * Coordinate Conversion
  * ============================================================================ */
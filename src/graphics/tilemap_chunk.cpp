@@ -0,0 +1,275 @@
+/*
+ * Carbon Tilemap System - Chunk Storage
+ *
+ * Palette-compressed tiles for one chunk: a uniform tile, or bit-packed
+ * indices into a refcounted palette whose width follows the number of
+ * distinct tiles.
+ */
+
+#include "tilemap_internal.h"
+#include <stdlib.h>
+
+/* ============================================================================
+ * Index Packing
+ * ============================================================================ */
+
+static inline uint32_t chunk_read_index(const TileChunkStorage *chunk, int idx)
+{
+    uint32_t bit = (uint32_t)idx * chunk->bits;
+    uint32_t mask = (1u << chunk->bits) - 1u;
+    return (chunk->indices[bit >> 5] >> (bit & 31)) & mask;
+}
+
+static inline void chunk_write_index(TileChunkStorage *chunk, int idx, uint32_t value)
+{
+    uint32_t bit = (uint32_t)idx * chunk->bits;
+    uint32_t mask = (1u << chunk->bits) - 1u;
+    uint32_t *word = &chunk->indices[bit >> 5];
+    *word = (*word & ~(mask << (bit & 31))) | (value << (bit & 31));
+}
+
+/* Repack indices at a new width (wide enough for every current index) */
+static bool chunk_repack(TileChunkStorage *chunk, uint8_t bits)
+{
+    size_t words = (size_t)TILE_CHUNK_TILES * bits / 32;
+    uint32_t *indices = (uint32_t*)calloc(words, sizeof(uint32_t));
+    if (!indices) return false;
+
+    TileChunkStorage packed = *chunk;
+    packed.indices = indices;
+    packed.bits = bits;
+    if (chunk->indices) {
+        for (int i = 0; i < TILE_CHUNK_TILES; i++) {
+            chunk_write_index(&packed, i, chunk_read_index(chunk, i));
+        }
+    }
+
+    free(chunk->indices);
+    chunk->indices = indices;
+    chunk->bits = bits;
+    return true;
+}
+
+/* ============================================================================
+ * Palette
+ * ============================================================================ */
+
+/* Turn a uniform chunk into a one-entry palette with all indices 0 */
+static bool chunk_make_paletted(TileChunkStorage *chunk)
+{
+    TileChunkPaletteEntry *palette =
+        (TileChunkPaletteEntry*)malloc(2 * sizeof(TileChunkPaletteEntry));
+    if (!palette) return false;
+    chunk->palette = palette;
+    chunk->palette_capacity = 2;
+    if (!chunk_repack(chunk, 1)) {
+        free(palette);
+        chunk->palette = NULL;
+        chunk->palette_capacity = 0;
+        return false;
+    }
+
+    palette[0].tile = chunk->uniform;
+    palette[0].refs = TILE_CHUNK_TILES;
+    chunk->palette_count = 1;
+    chunk->palette_used = 1;
+    return true;
+}
+
+/* Find the palette slot for a tile, adding it (and widening) if needed */
+static int chunk_palette_slot(TileChunkStorage *chunk, Agentite_TileID tile)
+{
+    int free_slot = -1;
+    for (int i = 0; i < chunk->palette_count; i++) {
+        if (chunk->palette[i].tile == tile && chunk->palette[i].refs > 0) return i;
+        if (chunk->palette[i].refs == 0 && free_slot < 0) free_slot = i;
+    }
+    if (free_slot >= 0) {
+        chunk->palette[free_slot].tile = tile;
+        return free_slot;
+    }
+
+    int slot = chunk->palette_count;
+    if (slot >= (1 << chunk->bits)) {
+        uint8_t bits = (uint8_t)(chunk->bits * 2);
+        if (!chunk_repack(chunk, bits)) return -1;
+    }
+    if (slot >= chunk->palette_capacity) {
+        int capacity = chunk->palette_capacity * 2;
+        TileChunkPaletteEntry *palette = (TileChunkPaletteEntry*)realloc(
+            chunk->palette, capacity * sizeof(TileChunkPaletteEntry));
+        if (!palette) return -1;
+        chunk->palette = palette;
+        chunk->palette_capacity = (uint16_t)capacity;
+    }
+
+    chunk->palette[slot].tile = tile;
+    chunk->palette[slot].refs = 0;
+    chunk->palette_count++;
+    return slot;
+}
+
+/* Drop free palette slots and narrow the indices to the tightest width,
+ * once that is at least two steps down so widths don't flip-flop */
+static void chunk_shrink(TileChunkStorage *chunk)
+{
+    uint8_t bits = 1;
+    while ((1 << bits) < chunk->palette_used) bits *= 2;
+    if (bits * 4 > chunk->bits) return;
+
+    uint32_t *indices = (uint32_t*)calloc((size_t)TILE_CHUNK_TILES * bits / 32, sizeof(uint32_t));
+    if (!indices) return;  /* Keep the wider layout */
+
+    uint16_t remap[TILE_CHUNK_TILES + 1];
+    uint16_t live = 0;
+    for (int i = 0; i < chunk->palette_count; i++) {
+        if (chunk->palette[i].refs == 0) continue;
+        remap[i] = live;
+        chunk->palette[live++] = chunk->palette[i];
+    }
+
+    TileChunkStorage packed = *chunk;
+    packed.indices = indices;
+    packed.bits = bits;
+    for (int i = 0; i < TILE_CHUNK_TILES; i++) {
+        chunk_write_index(&packed, i, remap[chunk_read_index(chunk, i)]);
+    }
+
+    free(chunk->indices);
+    chunk->indices = indices;
+    chunk->bits = bits;
+    chunk->palette_count = live;
+
+    int capacity = 2;
+    while (capacity < live) capacity *= 2;
+    TileChunkPaletteEntry *palette = (TileChunkPaletteEntry*)realloc(
+        chunk->palette, capacity * sizeof(TileChunkPaletteEntry));
+    if (palette) {
+        chunk->palette = palette;
+        chunk->palette_capacity = (uint16_t)capacity;
+    }
+}
+
+/* ============================================================================
+ * Access
+ * ============================================================================ */
+
+Agentite_TileID tile_chunk_get(const TileChunkStorage *chunk, int idx)
+{
+    if (chunk->bits == 0) return chunk->uniform;
+    return chunk->palette[chunk_read_index(chunk, idx)].tile;
+}
+
+void tile_chunk_decode(const TileChunkStorage *chunk, Agentite_TileID *out)
+{
+    if (chunk->bits == 0) {
+        for (int i = 0; i < TILE_CHUNK_TILES; i++) out[i] = chunk->uniform;
+        return;
+    }
+    for (int i = 0; i < TILE_CHUNK_TILES; i++) {
+        out[i] = chunk->palette[chunk_read_index(chunk, i)].tile;
+    }
+}
+
+void tile_chunk_set_uniform(TileChunkStorage *chunk, Agentite_TileID tile)
+{
+    free(chunk->indices);
+    free(chunk->palette);
+    chunk->indices = NULL;
+    chunk->palette = NULL;
+    chunk->palette_count = 0;
+    chunk->palette_capacity = 0;
+    chunk->palette_used = 0;
+    chunk->bits = 0;
+    chunk->uniform = tile;
+    chunk->tile_count = (tile == AGENTITE_TILE_EMPTY) ? 0 : TILE_CHUNK_TILES;
+}
+
+bool tile_chunk_set(TileChunkStorage *chunk, int idx, Agentite_TileID tile, bool *changed)
+{
+    Agentite_TileID old_tile = tile_chunk_get(chunk, idx);
+    if (old_tile == tile) return true;
+
+    if (chunk->bits == 0 && !chunk_make_paletted(chunk)) return false;
+
+    int slot = chunk_palette_slot(chunk, tile);
+    if (slot < 0) return false;
+
+    if (chunk->palette[slot].refs++ == 0) {
+        chunk->palette_used++;
+    }
+
+    uint32_t old_slot = chunk_read_index(chunk, idx);
+    chunk_write_index(chunk, idx, (uint32_t)slot);
+    if (old_tile == AGENTITE_TILE_EMPTY) {
+        chunk->tile_count++;
+    } else if (tile == AGENTITE_TILE_EMPTY) {
+        chunk->tile_count--;
+    }
+
+    if (--chunk->palette[old_slot].refs == 0) {
+        chunk->palette_used--;
+        if (chunk->palette_used == 1) {
+            tile_chunk_set_uniform(chunk, tile);
+        } else {
+            chunk_shrink(chunk);
+        }
+    }
+
+    if (changed) *changed = true;
+    return true;
+}
+
+bool tile_chunk_fill(TileChunkStorage *chunk, int x0, int y0, int x1, int y1,
+                     Agentite_TileID tile, bool *changed)
+{
+    const int cs = AGENTITE_TILEMAP_CHUNK_SIZE;
+    if (x0 <= 0 && y0 <= 0 && x1 >= cs && y1 >= cs) {
+        if (chunk->bits != 0 || chunk->uniform != tile) {
+            tile_chunk_set_uniform(chunk, tile);
+            if (changed) *changed = true;
+        }
+        return true;
+    }
+
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > cs) x1 = cs;
+    if (y1 > cs) y1 = cs;
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            if (!tile_chunk_set(chunk, y * cs + x, tile, changed)) return false;
+        }
+    }
+    return true;
+}
+
+/* ============================================================================
+ * Memory
+ * ============================================================================ */
+
+size_t tile_chunk_storage_bytes(const TileChunkStorage *chunk)
+{
+    if (chunk->bits == 0) return 0;
+    return (size_t)chunk->palette_capacity * sizeof(TileChunkPaletteEntry) +
+           (size_t)TILE_CHUNK_TILES * chunk->bits / 8;
+}
+
+void tile_chunk_add_stats(const TileChunkStorage *chunk, Agentite_TilemapMemoryStats *out)
+{
+    out->chunk_count++;
+    if (chunk->bits == 0) {
+        out->uniform_chunks++;
+    } else {
+        /* 1, 2, 4, 8, 16 -> 0..4 */
+        int slot = 0;
+        while ((1 << slot) < chunk->bits) slot++;
+        out->packed_chunks[slot]++;
+    }
+    out->tile_bytes += tile_chunk_storage_bytes(chunk);
+}
+
+void tile_chunk_release(TileChunkStorage *chunk)
+{
+    tile_chunk_set_uniform(chunk, AGENTITE_TILE_EMPTY);
+}
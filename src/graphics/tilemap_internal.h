@@ -0,0 +1,88 @@
+/*
+ * Carbon Tilemap System - Internal Header
+ *
+ * Palette-compressed tile storage for one chunk, shared by tilemap.cpp and
+ * tilemap_chunk.cpp. Needs no tileset, texture or GPU.
+ * This header is NOT part of the public API.
+ */
+
+#ifndef AGENTITE_TILEMAP_INTERNAL_H
+#define AGENTITE_TILEMAP_INTERNAL_H
+
+#include "agentite/tilemap.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Types
+ * ============================================================================ */
+
+#define TILE_CHUNK_TILES (AGENTITE_TILEMAP_CHUNK_SIZE * AGENTITE_TILEMAP_CHUNK_SIZE)
+
+/* Palette slot: a tile ID and how many of the chunk's tiles use it */
+typedef struct TileChunkPaletteEntry {
+    Agentite_TileID tile;
+    uint16_t refs;              /* 0 = free slot */
+} TileChunkPaletteEntry;
+
+/* Tiles of one 32x32 chunk, row-major.
+ * A uniform chunk (bits == 0) stores its single tile and no index data.
+ * Otherwise each tile is a bits-wide index into the palette, packed into
+ * 32-bit words (1, 2, 4, 8 or 16 bits, so indices never straddle words).
+ * The width grows as distinct tiles are added; a chunk that is back to one
+ * distinct tile drops its palette and becomes uniform again.
+ * A zeroed struct is a uniform empty chunk. */
+typedef struct TileChunkStorage {
+    uint32_t *indices;              /* TILE_CHUNK_TILES * bits / 32 words, NULL when uniform */
+    TileChunkPaletteEntry *palette; /* NULL when uniform */
+    uint16_t palette_count;         /* Slots in use, including free ones */
+    uint16_t palette_capacity;
+    uint16_t palette_used;          /* Slots with refs > 0 */
+    uint8_t bits;                   /* Index width, 0 = uniform */
+    Agentite_TileID uniform;        /* The tile when uniform */
+    uint32_t tile_count;            /* Non-empty tiles */
+} TileChunkStorage;
+
+/* ============================================================================
+ * Functions
+ * ============================================================================ */
+
+/* Tile at a row-major index (0 to TILE_CHUNK_TILES - 1) */
+Agentite_TileID tile_chunk_get(const TileChunkStorage *chunk, int idx);
+
+/* Expand all tiles into a TILE_CHUNK_TILES array */
+void tile_chunk_decode(const TileChunkStorage *chunk, Agentite_TileID *out);
+
+/* Drop index data and palette, making every tile the given one */
+void tile_chunk_set_uniform(TileChunkStorage *chunk, Agentite_TileID tile);
+
+/* Set one tile, keeping tile_count. Sets *changed when the tile differed.
+ * Returns false (chunk unchanged) when the palette cannot grow. */
+bool tile_chunk_set(TileChunkStorage *chunk, int idx, Agentite_TileID tile, bool *changed);
+
+/* Fill the local rectangle [x0, x1) x [y0, y1). A rectangle covering the
+ * whole chunk makes it uniform; anything smaller is set tile by tile.
+ * Returns false if the palette could not grow (tiles set so far stay). */
+bool tile_chunk_fill(TileChunkStorage *chunk, int x0, int y0, int x1, int y1,
+                     Agentite_TileID tile, bool *changed);
+
+/* Bytes of palette plus index data (0 when uniform) */
+size_t tile_chunk_storage_bytes(const TileChunkStorage *chunk);
+
+/* Count the chunk into chunk_count, uniform_chunks / packed_chunks and
+ * tile_bytes (storage only; callers add their own per-chunk overhead) */
+void tile_chunk_add_stats(const TileChunkStorage *chunk, Agentite_TilemapMemoryStats *out);
+
+/* Free index data and palette; the chunk becomes uniform empty */
+void tile_chunk_release(TileChunkStorage *chunk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGENTITE_TILEMAP_INTERNAL_H */
@@ -9,9 +9,11 @@
 #include "agentite/prefab.h"
 #include "agentite/ecs_reflect.h"
 #include "agentite/asset.h"
+#include "agentite/async.h"
 #include "agentite/error.h"
 #include "scene_internal.h"
 
+#include <SDL3/SDL.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -38,6 +40,10 @@ extern "C" {
 
 #define SCENE_MANAGER_CAPACITY 64
 
+/* Streaming: default budget, and compiled rows spawned between clock checks */
+#define SCENE_STREAM_DEFAULT_BUDGET_US 2000
+#define SCENE_STREAM_SLICE_ROWS 64
+
 /* Thread-local error storage */
 static thread_local char s_last_error[512] = {0};
 
@@ -67,9 +73,14 @@ struct Agentite_Scene {
 
     ecs_entity_t *root_entities; /* Root entity IDs only */
     size_t root_entity_count;
+    size_t root_entity_capacity;
 
     /* World reference (valid while instantiated) */
     ecs_world_t *world;
+
+    /* Compiled form, when loaded with a cache directory */
+    Agentite_SceneCompiled *compiled;
+    bool from_cache;            /* Loaded from the cache without parsing */
 };
 
 /* ============================================================================
@@ -81,10 +92,32 @@ typedef struct SceneEntry {
     Agentite_Scene *scene;
 } SceneEntry;
 
+/* Scene being instantiated across frames */
+typedef struct SceneStream {
+    Agentite_Scene *scene;          /* NULL when idle */
+    ecs_world_t *world;
+    Agentite_SceneLoadContext ctx;
+    Agentite_SceneStreamConfig config;
+
+    /* Compiled scenes go by table row, parsed scenes by root */
+    ecs_entity_t *rows;             /* Entity per compiled row */
+    size_t next;                    /* Next row or root */
+    size_t total;                   /* Rows or roots */
+    size_t entities_total;
+
+    /* Asset prefetch */
+    size_t asset_total;
+    size_t next_prefab;             /* Next asset ref checked for prefab loading */
+    Agentite_LoadRequest *requests; /* Outstanding async loads (0 once resolved) */
+    size_t request_count;
+    size_t requests_done;
+} SceneStream;
+
 struct Agentite_SceneManager {
     SceneEntry entries[SCENE_MANAGER_CAPACITY];
     size_t count;
     Agentite_Scene *active_scene;
+    SceneStream stream;
 };
 
 /* ============================================================================
@@ -168,6 +201,8 @@ Agentite_SceneManager *agentite_scene_manager_create(void) {
 void agentite_scene_manager_destroy(Agentite_SceneManager *manager) {
     if (!manager) return;
 
+    agentite_scene_stream_cancel(manager);
+
     for (size_t i = 0; i < manager->count; i++) {
         free(manager->entries[i].path);
         agentite_scene_destroy(manager->entries[i].scene);
@@ -205,7 +240,8 @@ static Agentite_Scene *scene_create(void) {
     scene->entity_capacity = 64;
     scene->entities = (ecs_entity_t *)calloc(scene->entity_capacity,
                                               sizeof(ecs_entity_t));
-    scene->root_entities = (ecs_entity_t *)calloc(scene->root_capacity,
+    scene->root_entity_capacity = scene->root_capacity;
+    scene->root_entities = (ecs_entity_t *)calloc(scene->root_entity_capacity,
                                                    sizeof(ecs_entity_t));
 
     scene->asset_ref_capacity = 32;
@@ -221,12 +257,28 @@ static Agentite_Scene *scene_create(void) {
     return scene;
 }
 
+/* Delete tracked entities in reverse order, children before parents */
+static void delete_tracked_entities(Agentite_Scene *scene, ecs_world_t *world) {
+    for (size_t i = scene->entity_count; i > 0; i--) {
+        ecs_entity_t entity = scene->entities[i - 1];
+        if (ecs_is_alive(world, entity)) {
+            ecs_delete(world, entity);
+        }
+    }
+    scene->entity_count = 0;
+    scene->root_entity_count = 0;
+    scene->world = NULL;
+    scene->state = AGENTITE_SCENE_PARSED;
+}
+
 void agentite_scene_destroy(Agentite_Scene *scene) {
     if (!scene) return;
 
     /* Uninstantiate if needed */
     if (scene->state == AGENTITE_SCENE_LOADED && scene->world) {
         agentite_scene_uninstantiate(scene, scene->world);
+    } else if (scene->state == AGENTITE_SCENE_STREAMING && scene->world) {
+        delete_tracked_entities(scene, scene->world);
     }
 
     /* Free parsed data */
@@ -234,6 +286,7 @@ void agentite_scene_destroy(Agentite_Scene *scene) {
         agentite_prefab_destroy(scene->roots[i]);
     }
     free(scene->roots);
+    agentite_scene_compiled_destroy(scene->compiled);
 
     /* Free asset refs */
     for (size_t i = 0; i < scene->asset_ref_count; i++) {
@@ -301,17 +354,25 @@ static bool parse_scene_source(Agentite_Scene *scene,
             return false;
         }
 
-        /* Add to roots array */
+        /* Add to roots array (root entity tracking grows with it) */
         if (scene->root_count >= scene->root_capacity) {
             size_t new_capacity = scene->root_capacity * 2;
             Agentite_Prefab **new_roots = (Agentite_Prefab **)realloc(
                 scene->roots, new_capacity * sizeof(Agentite_Prefab *));
-            if (!new_roots) {
+            if (new_roots) {
+                scene->roots = new_roots;
+            }
+            ecs_entity_t *new_root_entities = (ecs_entity_t *)realloc(
+                scene->root_entities, new_capacity * sizeof(ecs_entity_t));
+            if (new_root_entities) {
+                scene->root_entities = new_root_entities;
+                scene->root_entity_capacity = new_capacity;
+            }
+            if (!new_roots || !new_root_entities) {
                 agentite_prefab_destroy(prefab);
                 set_scene_error("scene: Out of memory");
                 return false;
             }
-            scene->roots = new_roots;
             scene->root_capacity = new_capacity;
         }
 
@@ -440,6 +501,57 @@ static void extract_all_asset_refs(Agentite_Scene *scene) {
     }
 }
 
+/* ============================================================================
+ * Compiled Scene Cache
+ * ============================================================================ */
+
+/* <cache_dir>/<name>-<path hash>.scenebin, so equal file names don't collide */
+static void build_cache_path(const char *cache_dir, const char *path,
+                              char *out, size_t out_size) {
+    char *name = derive_scene_name(path);
+    snprintf(out, out_size, "%s/%s-%016llx.scenebin", cache_dir, name ? name : "scene",
+             (unsigned long long)agentite_scene_source_hash(path, strlen(path)));
+    free(name);
+}
+
+static Agentite_Scene *load_cached_scene(const char *cache_path, uint64_t source_hash,
+                                          const Agentite_ReflectRegistry *reflect) {
+    Agentite_SceneCompiled *compiled =
+        agentite_scene_compiled_read(cache_path, source_hash, reflect);
+    if (!compiled) {
+        return NULL;
+    }
+
+    Agentite_Scene *scene = scene_create();
+    if (!scene) {
+        agentite_scene_compiled_destroy(compiled);
+        return NULL;
+    }
+    scene->compiled = compiled;
+    scene->from_cache = true;
+    scene->state = AGENTITE_SCENE_PARSED;
+
+    Agentite_AssetRef ref;
+    for (size_t i = 0; agentite_scene_compiled_get_asset(compiled, i, &ref); i++) {
+        add_asset_ref(scene, ref.path, ref.type);
+    }
+    return scene;
+}
+
+/**
+ * Compile a freshly parsed scene and refresh its cache file. Failures only
+ * cost the fast path: the scene still instantiates from its parsed roots.
+ */
+static void compile_scene(Agentite_Scene *scene, const Agentite_ReflectRegistry *reflect,
+                           uint64_t source_hash, const char *cache_path) {
+    scene->compiled = agentite_scene_compile(scene->roots, scene->root_count,
+                                             scene->asset_refs, scene->asset_ref_count,
+                                             reflect, source_hash);
+    if (scene->compiled) {
+        agentite_scene_compiled_write(scene->compiled, cache_path);
+    }
+}
+
 /* ============================================================================
  * Scene Loading
  * ============================================================================ */
@@ -514,8 +626,22 @@ Agentite_Scene *agentite_scene_load(Agentite_SceneManager *manager,
         return NULL;
     }
 
-    /* Parse */
-    Agentite_Scene *scene = agentite_scene_load_string(source, size, path, ctx);
+    /* Use the compiled cache while the source is unchanged, else parse */
+    Agentite_Scene *scene = NULL;
+    bool use_cache = ctx && ctx->cache_dir && ctx->reflect;
+    char cache_path[1024];
+    uint64_t source_hash = 0;
+    if (use_cache) {
+        source_hash = agentite_scene_source_hash(source, size);
+        build_cache_path(ctx->cache_dir, path, cache_path, sizeof(cache_path));
+        scene = load_cached_scene(cache_path, source_hash, ctx->reflect);
+    }
+    if (!scene) {
+        scene = agentite_scene_load_string(source, size, path, ctx);
+        if (scene && use_cache) {
+            compile_scene(scene, ctx->reflect, source_hash, cache_path);
+        }
+    }
     free(source);
 
     if (!scene) {
@@ -565,6 +691,86 @@ static void track_spawned_entities(Agentite_Scene *scene,
     }
 }
 
+/* Size the tracking arrays for every row of the compiled scene */
+static bool reserve_compiled_tracking(Agentite_Scene *scene) {
+    size_t entity_count = agentite_scene_compiled_entity_count(scene->compiled);
+    size_t root_count = agentite_scene_compiled_root_count(scene->compiled);
+
+    if (entity_count > scene->entity_capacity) {
+        ecs_entity_t *entities = (ecs_entity_t *)realloc(
+            scene->entities, entity_count * sizeof(ecs_entity_t));
+        if (!entities) {
+            set_scene_error("scene: Out of memory");
+            return false;
+        }
+        scene->entities = entities;
+        scene->entity_capacity = entity_count;
+    }
+    if (root_count > scene->root_entity_capacity) {
+        ecs_entity_t *root_entities = (ecs_entity_t *)realloc(
+            scene->root_entities, root_count * sizeof(ecs_entity_t));
+        if (!root_entities) {
+            set_scene_error("scene: Out of memory");
+            return false;
+        }
+        scene->root_entities = root_entities;
+        scene->root_entity_capacity = root_count;
+    }
+    return true;
+}
+
+/* Track rows [first, end); rows that failed to spawn are left out */
+static void track_compiled_rows(Agentite_Scene *scene, const ecs_entity_t *rows,
+                                size_t first, size_t end) {
+    size_t root_count = agentite_scene_compiled_root_count(scene->compiled);
+    for (size_t i = first; i < end; i++) {
+        ecs_entity_t entity = rows[i];
+        if (!entity) continue;
+        if (i < root_count) {
+            scene->root_entities[scene->root_entity_count++] = entity;
+        }
+        scene->entities[scene->entity_count++] = entity;
+    }
+}
+
+static bool instantiate_compiled(Agentite_Scene *scene, ecs_world_t *world,
+                                  const Agentite_SceneLoadContext *ctx) {
+    if (!reserve_compiled_tracking(scene)) {
+        return false;
+    }
+
+    /* Rows land in the entity array itself and are compacted in place */
+    size_t entity_count = agentite_scene_compiled_entity_count(scene->compiled);
+    agentite_scene_compiled_instantiate(scene->compiled, world,
+                                        ctx ? ctx->prefabs : NULL,
+                                        ctx ? ctx->reflect : NULL,
+                                        scene->entities);
+    track_compiled_rows(scene, scene->entities, 0, entity_count);
+    return true;
+}
+
+/* Spawn one parsed root with its children and track them */
+static void instantiate_root(Agentite_Scene *scene, Agentite_Prefab *prefab,
+                             ecs_world_t *world, const Agentite_SceneLoadContext *ctx) {
+    Agentite_SpawnContext spawn_ctx = {};
+    spawn_ctx.world = world;
+    spawn_ctx.reflect = ctx ? ctx->reflect : NULL;
+    spawn_ctx.assets = ctx ? ctx->assets : NULL;
+    spawn_ctx.prefabs = ctx ? ctx->prefabs : NULL;
+    /* Spawning adds the prefab's own position */
+
+    ecs_entity_t entity = agentite_prefab_spawn(prefab, &spawn_ctx);
+    if (!entity) return;
+
+    /* Track root entity */
+    if (scene->root_entity_count < scene->root_entity_capacity) {
+        scene->root_entities[scene->root_entity_count++] = entity;
+    }
+
+    /* Track all entities including children */
+    track_spawned_entities(scene, world, entity);
+}
+
 bool agentite_scene_instantiate(Agentite_Scene *scene,
                                  ecs_world_t *world,
                                  const Agentite_SceneLoadContext *ctx) {
@@ -592,29 +798,18 @@ bool agentite_scene_instantiate(Agentite_Scene *scene,
         agentite_scene_preload_assets(scene, ctx);
     }
 
+    if (scene->compiled) {
+        if (!instantiate_compiled(scene, world, ctx)) {
+            return false;
+        }
+        scene->world = world;
+        scene->state = AGENTITE_SCENE_LOADED;
+        return true;
+    }
+
     /* Spawn each root entity */
     for (size_t i = 0; i < scene->root_count; i++) {
-        Agentite_Prefab *prefab = scene->roots[i];
-
-        Agentite_SpawnContext spawn_ctx = {};
-        spawn_ctx.world = world;
-        spawn_ctx.reflect = ctx ? ctx->reflect : NULL;
-        spawn_ctx.assets = ctx ? ctx->assets : NULL;
-        spawn_ctx.prefabs = ctx ? ctx->prefabs : NULL;
-        spawn_ctx.offset_x = prefab->position[0];
-        spawn_ctx.offset_y = prefab->position[1];
-
-        ecs_entity_t entity = agentite_prefab_spawn(prefab, &spawn_ctx);
-
-        if (entity) {
-            /* Track root entity */
-            if (scene->root_entity_count < scene->root_capacity) {
-                scene->root_entities[scene->root_entity_count++] = entity;
-            }
-
-            /* Track all entities including children */
-            track_spawned_entities(scene, world, entity);
-        }
+        instantiate_root(scene, scene->roots[i], world, ctx);
     }
 
     scene->world = world;
@@ -629,19 +824,7 @@ void agentite_scene_uninstantiate(Agentite_Scene *scene, ecs_world_t *world) {
     if (scene->state != AGENTITE_SCENE_LOADED) return;
 
     scene->state = AGENTITE_SCENE_UNLOADING;
-
-    /* Delete all tracked entities in reverse order */
-    for (size_t i = scene->entity_count; i > 0; i--) {
-        ecs_entity_t entity = scene->entities[i - 1];
-        if (ecs_is_alive(world, entity)) {
-            ecs_delete(world, entity);
-        }
-    }
-
-    scene->entity_count = 0;
-    scene->root_entity_count = 0;
-    scene->world = NULL;
-    scene->state = AGENTITE_SCENE_PARSED;
+    delete_tracked_entities(scene, world);
 }
 
 bool agentite_scene_is_instantiated(const Agentite_Scene *scene) {
@@ -685,12 +868,282 @@ Agentite_Scene *agentite_scene_transition(Agentite_SceneManager *manager,
     return new_scene;
 }
 
+/* ============================================================================
+ * Streaming Instantiation
+ * ============================================================================ */
+
+static size_t count_prefab_entities(const Agentite_Prefab *prefab) {
+    size_t count = 1;
+    for (int i = 0; i < prefab->child_count; i++) {
+        count += count_prefab_entities(prefab->children[i]);
+    }
+    return count;
+}
+
+static void stream_reset(SceneStream *stream) {
+    free(stream->rows);
+    free(stream->requests);
+    *stream = SceneStream{};
+}
+
+/* Queue async loads for asset refs the registry does not hold yet */
+static void stream_queue_prefetch(SceneStream *stream) {
+    const Agentite_SceneStreamConfig *config = &stream->config;
+    Agentite_AssetRegistry *assets = stream->ctx.assets;
+    Agentite_Scene *scene = stream->scene;
+    if (!config->loader || !assets || scene->asset_ref_count == 0) return;
+
+    stream->requests = (Agentite_LoadRequest *)calloc(scene->asset_ref_count,
+                                                      sizeof(Agentite_LoadRequest));
+    if (!stream->requests) return;
+
+    for (size_t i = 0; i < scene->asset_ref_count; i++) {
+        const Agentite_AssetRef *ref = &scene->asset_refs[i];
+        if (agentite_asset_is_valid(agentite_asset_lookup(assets, ref->path))) continue;
+
+        Agentite_LoadRequest request = AGENTITE_INVALID_LOAD_REQUEST;
+        switch (ref->type) {
+            case AGENTITE_ASSET_TEXTURE:
+                if (config->sprites) {
+                    request = agentite_texture_load_async(config->loader, config->sprites,
+                                                          assets, ref->path, NULL, NULL);
+                }
+                break;
+            case AGENTITE_ASSET_SOUND:
+                if (config->audio) {
+                    request = agentite_sound_load_async(config->loader, config->audio,
+                                                        assets, ref->path, NULL, NULL);
+                }
+                break;
+            case AGENTITE_ASSET_MUSIC:
+                if (config->audio) {
+                    request = agentite_music_load_async(config->loader, config->audio,
+                                                        assets, ref->path, NULL, NULL);
+                }
+                break;
+            default:
+                break;
+        }
+        if (agentite_load_request_is_valid(request)) {
+            stream->requests[stream->request_count++] = request;
+        }
+    }
+}
+
+/* A request is resolved once its callback has run or it was cancelled */
+static void stream_poll_prefetch(SceneStream *stream) {
+    for (size_t i = 0; i < stream->request_count; i++) {
+        if (!agentite_load_request_is_valid(stream->requests[i])) continue;
+
+        Agentite_LoadStatus status = agentite_async_get_status(stream->config.loader,
+                                                               stream->requests[i]);
+        if (status == AGENTITE_LOAD_PENDING || status == AGENTITE_LOAD_LOADING ||
+            status == AGENTITE_LOAD_COMPLETE) {
+            continue;
+        }
+        stream->requests[i] = AGENTITE_INVALID_LOAD_REQUEST;
+        stream->requests_done++;
+    }
+}
+
+/* Prefab refs load synchronously before any entity, one per step */
+static void stream_load_prefab(SceneStream *stream) {
+    const Agentite_AssetRef *ref = &stream->scene->asset_refs[stream->next_prefab++];
+    if (ref->type == AGENTITE_ASSET_PREFAB && stream->ctx.prefabs) {
+        agentite_prefab_load(stream->ctx.prefabs, ref->path, stream->ctx.reflect);
+    }
+}
+
+/* Spawn the next slice: a run of compiled rows, or one parsed root */
+static void stream_spawn_slice(SceneStream *stream) {
+    Agentite_Scene *scene = stream->scene;
+
+    if (scene->compiled) {
+        size_t count = stream->total - stream->next;
+        if (count > SCENE_STREAM_SLICE_ROWS) count = SCENE_STREAM_SLICE_ROWS;
+        agentite_scene_compiled_instantiate_range(scene->compiled, stream->world,
+                                                  stream->ctx.prefabs, stream->ctx.reflect,
+                                                  stream->next, count, true, stream->rows);
+        track_compiled_rows(scene, stream->rows, stream->next, stream->next + count);
+        stream->next += count;
+        return;
+    }
+
+    size_t first = scene->entity_count;
+    instantiate_root(scene, scene->roots[stream->next++], stream->world, &stream->ctx);
+    for (size_t i = first; i < scene->entity_count; i++) {
+        ecs_add_id(stream->world, scene->entities[i], EcsDisabled);
+    }
+}
+
+static Agentite_SceneStreamStatus stream_status(const SceneStream *stream) {
+    if (!stream->scene) return AGENTITE_SCENE_STREAM_IDLE;
+    if (stream->next_prefab < stream->scene->asset_ref_count || stream->next < stream->total) {
+        return AGENTITE_SCENE_STREAM_INSTANTIATING;
+    }
+    return AGENTITE_SCENE_STREAM_PREFETCHING;
+}
+
+/* Swap the finished scene in: nothing observes a half-built level */
+static void stream_activate(Agentite_SceneManager *manager) {
+    SceneStream *stream = &manager->stream;
+    Agentite_Scene *scene = stream->scene;
+
+    Agentite_Scene *previous = manager->active_scene;
+    if (previous && previous != scene && previous->world) {
+        agentite_scene_uninstantiate(previous, previous->world);
+    }
+
+    for (size_t i = 0; i < scene->entity_count; i++) {
+        ecs_remove_id(stream->world, scene->entities[i], EcsDisabled);
+    }
+    scene->state = AGENTITE_SCENE_LOADED;
+    manager->active_scene = scene;
+    stream_reset(stream);
+}
+
+bool agentite_scene_stream_begin(Agentite_SceneManager *manager,
+                                  const char *path,
+                                  ecs_world_t *world,
+                                  const Agentite_SceneLoadContext *ctx,
+                                  const Agentite_SceneStreamConfig *config) {
+    if (!manager || !path || !world) {
+        set_scene_error("scene: Invalid parameters");
+        return false;
+    }
+    if (manager->stream.scene) {
+        set_scene_error("scene: A stream is already in progress");
+        return false;
+    }
+
+    Agentite_Scene *scene = agentite_scene_load(manager, path, ctx);
+    if (!scene) {
+        return false;
+    }
+    if (scene->state != AGENTITE_SCENE_PARSED) {
+        set_scene_error("scene: Already instantiated");
+        return false;
+    }
+
+    SceneStream *stream = &manager->stream;
+    if (ctx) {
+        stream->ctx = *ctx;
+    }
+    if (config) {
+        stream->config = *config;
+    }
+    if (stream->config.budget_us == 0) {
+        stream->config.budget_us = SCENE_STREAM_DEFAULT_BUDGET_US;
+    }
+
+    if (scene->compiled) {
+        stream->total = agentite_scene_compiled_entity_count(scene->compiled);
+        stream->entities_total = stream->total;
+        stream->rows = (ecs_entity_t *)calloc(stream->total ? stream->total : 1,
+                                              sizeof(ecs_entity_t));
+        if (!stream->rows || !reserve_compiled_tracking(scene)) {
+            set_scene_error("scene: Out of memory");
+            stream_reset(stream);
+            return false;
+        }
+    } else {
+        stream->total = scene->root_count;
+        for (size_t i = 0; i < scene->root_count; i++) {
+            stream->entities_total += count_prefab_entities(scene->roots[i]);
+        }
+    }
+
+    stream->scene = scene;
+    stream->world = world;
+    stream_queue_prefetch(stream);
+
+    scene->entity_count = 0;
+    scene->root_entity_count = 0;
+    scene->world = world;
+    scene->state = AGENTITE_SCENE_STREAMING;
+    return true;
+}
+
+Agentite_SceneStreamStatus agentite_scene_stream_update(Agentite_SceneManager *manager) {
+    if (!manager || !manager->stream.scene) return AGENTITE_SCENE_STREAM_IDLE;
+
+    SceneStream *stream = &manager->stream;
+    uint64_t start = SDL_GetPerformanceCounter();
+    uint64_t budget = (uint64_t)stream->config.budget_us *
+                      SDL_GetPerformanceFrequency() / 1000000;
+
+    stream_poll_prefetch(stream);
+
+    /* One step always runs, so a tiny budget still makes progress */
+    do {
+        if (stream->next_prefab < stream->scene->asset_ref_count) {
+            stream_load_prefab(stream);
+        } else if (stream->next < stream->total) {
+            stream_spawn_slice(stream);
+        } else {
+            break;
+        }
+    } while (SDL_GetPerformanceCounter() - start < budget);
+
+    Agentite_SceneStreamStatus status = stream_status(stream);
+    if (status == AGENTITE_SCENE_STREAM_PREFETCHING &&
+        stream->requests_done == stream->request_count) {
+        stream_activate(manager);
+        return AGENTITE_SCENE_STREAM_COMPLETE;
+    }
+    return status;
+}
+
+Agentite_SceneStreamStatus agentite_scene_stream_get_progress(const Agentite_SceneManager *manager,
+                                                               Agentite_SceneStreamProgress *out) {
+    if (!manager) return AGENTITE_SCENE_STREAM_IDLE;
+
+    const SceneStream *stream = &manager->stream;
+    Agentite_SceneStreamStatus status = stream_status(stream);
+    if (!out) return status;
+
+    *out = Agentite_SceneStreamProgress{};
+    out->status = status;
+    if (!stream->scene) return status;
+
+    /* Prefab refs count once checked; other refs once resolved or skipped */
+    const Agentite_Scene *scene = stream->scene;
+    out->entities_created = scene->entity_count;
+    out->entities_total = stream->entities_total;
+    out->assets_total = scene->asset_ref_count;
+    out->assets_loaded = scene->asset_ref_count - (stream->request_count - stream->requests_done);
+    for (size_t i = stream->next_prefab; i < scene->asset_ref_count; i++) {
+        if (scene->asset_refs[i].type == AGENTITE_ASSET_PREFAB) out->assets_loaded--;
+    }
+
+    size_t total = out->entities_total + out->assets_total;
+    size_t done = out->entities_created + out->assets_loaded;
+    out->fraction = total > 0 ? (float)done / (float)total : 1.0f;
+    if (out->fraction > 1.0f) out->fraction = 1.0f;
+    return status;
+}
+
+void agentite_scene_stream_cancel(Agentite_SceneManager *manager) {
+    if (!manager || !manager->stream.scene) return;
+
+    SceneStream *stream = &manager->stream;
+    for (size_t i = 0; i < stream->request_count; i++) {
+        if (agentite_load_request_is_valid(stream->requests[i])) {
+            agentite_async_cancel(stream->config.loader, stream->requests[i]);
+        }
+    }
+    delete_tracked_entities(stream->scene, stream->world);
+    stream_reset(stream);
+}
+
 /* ============================================================================
  * Entity Access
  * ============================================================================ */
 
 size_t agentite_scene_get_root_count(const Agentite_Scene *scene) {
-    return scene ? scene->root_count : 0;
+    if (!scene) return 0;
+    if (scene->from_cache) return agentite_scene_compiled_root_count(scene->compiled);
+    return scene->root_count;
 }
 
 size_t agentite_scene_get_entity_count(const Agentite_Scene *scene) {
@@ -804,6 +1257,10 @@ Agentite_SceneState agentite_scene_get_state(const Agentite_Scene *scene) {
     return scene ? scene->state : AGENTITE_SCENE_UNLOADED;
 }
 
+bool agentite_scene_is_from_cache(const Agentite_Scene *scene) {
+    return scene && scene->from_cache;
+}
+
 /* ============================================================================
  * Scene Writing
  * ============================================================================ */
@@ -814,6 +1271,19 @@ char *agentite_scene_write_string(const Agentite_Scene *scene) {
         return NULL;
     }
 
+    /* Cached scenes keep no prefab trees; write from the source instead */
+    if (scene->from_cache && scene->path) {
+        size_t size;
+        char *source = read_file(scene->path, &size);
+        if (!source) return NULL;
+        Agentite_Scene *parsed = agentite_scene_load_string(source, size, scene->path, NULL);
+        free(source);
+        if (!parsed) return NULL;
+        char *result = agentite_scene_write_string(parsed);
+        agentite_scene_destroy(parsed);
+        return result;
+    }
+
     if (scene->root_count == 0) {
         set_scene_error("scene: No entities to write");
         return NULL;
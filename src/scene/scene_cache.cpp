@@ -0,0 +1,937 @@
+/**
+ * Agentite Engine - Compiled Scene Cache
+ *
+ * Flattens parsed scenes into a binary image that loads without lexing or
+ * parsing, and instantiates it with bulk entity creation where it can.
+ */
+
+#include "agentite/scene.h"
+#include "agentite/prefab.h"
+#include "agentite/ecs_reflect.h"
+#include "agentite/error.h"
+#include "scene_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "flecs.h"
+
+/* Forward declarations from prefab.cpp */
+extern "C" {
+    void agentite_prefab_fill_component(void *data, const Agentite_ComponentMeta *meta,
+                                        const Agentite_ComponentConfig *config);
+}
+
+/* ============================================================================
+ * File Format
+ * ============================================================================ */
+
+#define SCENE_BIN_MAGIC "AGSC"
+#define SCENE_BIN_FORMAT_VERSION 1
+#define SCENE_BIN_NONE 0xFFFFFFFFu      /* No name / base / string */
+
+#define FNV64_OFFSET_BASIS 14695981039346656037ull
+#define FNV64_PRIME        1099511628211ull
+
+/*
+ * Layout (little-endian): header, then the entity, component, type, fixup
+ * and asset tables, the component data blob and the string pool, each
+ * section padded to 8 bytes. String references are offsets into the pool.
+ */
+typedef struct SceneBinHeader {
+    char magic[4];
+    uint16_t format_version;
+    uint16_t reserved;
+    uint64_t source_hash;
+    uint64_t reflect_hash;          /* Layout of every reflected component */
+    uint32_t entity_count;
+    uint32_t root_count;            /* Roots are the first entities */
+    uint32_t component_count;
+    uint32_t type_count;
+    uint32_t fixup_count;
+    uint32_t asset_count;
+    uint32_t data_size;
+    uint32_t string_size;
+} SceneBinHeader;
+
+typedef struct SceneBinEntity {
+    int32_t parent;                 /* Entity index (always lower), -1 for roots */
+    uint32_t name;
+    uint32_t base;                  /* Base prefab path */
+    uint32_t signature;             /* Equal for entities with the same component types */
+    uint32_t first_component;
+    uint32_t component_count;
+} SceneBinEntity;
+
+typedef struct SceneBinComponent {
+    uint32_t type;
+    uint32_t offset;                /* Into the data blob */
+} SceneBinComponent;
+
+typedef struct SceneBinType {
+    uint32_t name;
+    uint32_t size;
+} SceneBinType;
+
+/* A string field: the pointer slot is zero on disk and patched on load */
+typedef struct SceneBinFixup {
+    uint32_t offset;                /* Into the data blob */
+    uint32_t string;
+} SceneBinFixup;
+
+typedef struct SceneBinAsset {
+    uint32_t path;
+    uint32_t type;                  /* Agentite_AssetType */
+} SceneBinAsset;
+
+struct Agentite_SceneCompiled {
+    uint8_t *image;                 /* File image; sections point into it */
+    size_t image_size;
+
+    const SceneBinHeader *header;
+    const SceneBinEntity *entities;
+    const SceneBinComponent *components;
+    const SceneBinType *types;
+    const SceneBinFixup *fixups;
+    const SceneBinAsset *assets;
+    uint8_t *data;                  /* String slots patched to point into strings */
+    const char *strings;
+
+    ecs_id_t *type_ids;             /* Resolved through reflection */
+};
+
+static inline size_t align8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+/* ============================================================================
+ * Hashing
+ * ============================================================================ */
+
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV64_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t hash_u64(uint64_t hash, uint64_t value) {
+    return hash_bytes(hash, &value, sizeof(value));
+}
+
+uint64_t agentite_scene_source_hash(const char *source, size_t length) {
+    return hash_bytes(FNV64_OFFSET_BASIS, source, length);
+}
+
+/* A cache baked against one component layout is stale under any other */
+static uint64_t reflect_layout_hash(const Agentite_ReflectRegistry *reflect) {
+    uint64_t hash = FNV64_OFFSET_BASIS;
+    size_t count = agentite_reflect_count(reflect);
+    for (size_t i = 0; i < count; i++) {
+        const Agentite_ComponentMeta *meta = agentite_reflect_get_by_index(reflect, i);
+        if (!meta) continue;
+
+        hash = hash_bytes(hash, meta->name, strlen(meta->name) + 1);
+        hash = hash_u64(hash, meta->size);
+        for (int f = 0; f < meta->field_count; f++) {
+            const Agentite_FieldDesc *field = &meta->fields[f];
+            hash = hash_bytes(hash, field->name, strlen(field->name) + 1);
+            hash = hash_u64(hash, (uint64_t)field->type);
+            hash = hash_u64(hash, field->offset);
+            hash = hash_u64(hash, field->size);
+        }
+    }
+    return hash;
+}
+
+/* ============================================================================
+ * Image Layout
+ * ============================================================================ */
+
+typedef struct SceneBinLayout {
+    size_t entities;
+    size_t components;
+    size_t types;
+    size_t fixups;
+    size_t assets;
+    size_t data;
+    size_t strings;
+    size_t total;
+} SceneBinLayout;
+
+static SceneBinLayout compute_layout(const SceneBinHeader *h) {
+    SceneBinLayout l;
+    size_t offset = align8(sizeof(SceneBinHeader));
+    l.entities = offset;
+    offset += align8((size_t)h->entity_count * sizeof(SceneBinEntity));
+    l.components = offset;
+    offset += align8((size_t)h->component_count * sizeof(SceneBinComponent));
+    l.types = offset;
+    offset += align8((size_t)h->type_count * sizeof(SceneBinType));
+    l.fixups = offset;
+    offset += align8((size_t)h->fixup_count * sizeof(SceneBinFixup));
+    l.assets = offset;
+    offset += align8((size_t)h->asset_count * sizeof(SceneBinAsset));
+    l.data = offset;
+    offset += align8(h->data_size);
+    l.strings = offset;
+    offset += align8(h->string_size);
+    l.total = offset;
+    return l;
+}
+
+static bool valid_string(const SceneBinHeader *h, uint32_t string, bool optional) {
+    return (optional && string == SCENE_BIN_NONE) || string < h->string_size;
+}
+
+/**
+ * Validate an image, point the section tables into it, resolve component
+ * types and patch string fields. Takes ownership of image on success.
+ */
+static Agentite_SceneCompiled *open_image(uint8_t *image, size_t image_size,
+                                          uint64_t source_hash,
+                                          const Agentite_ReflectRegistry *reflect) {
+    if (image_size < sizeof(SceneBinHeader)) return NULL;
+
+    const SceneBinHeader *h = (const SceneBinHeader *)image;
+    if (memcmp(h->magic, SCENE_BIN_MAGIC, 4) != 0 ||
+        h->format_version != SCENE_BIN_FORMAT_VERSION ||
+        h->source_hash != source_hash ||
+        h->reflect_hash != reflect_layout_hash(reflect) ||
+        h->root_count > h->entity_count) {
+        return NULL;
+    }
+
+    SceneBinLayout l = compute_layout(h);
+    if (l.total != image_size) return NULL;
+
+    const SceneBinEntity *entities = (const SceneBinEntity *)(image + l.entities);
+    const SceneBinComponent *components = (const SceneBinComponent *)(image + l.components);
+    const SceneBinType *types = (const SceneBinType *)(image + l.types);
+    const SceneBinFixup *fixups = (const SceneBinFixup *)(image + l.fixups);
+    const SceneBinAsset *assets = (const SceneBinAsset *)(image + l.assets);
+    const char *strings = (const char *)(image + l.strings);
+
+    /* Every string offset must land before a terminator */
+    if (h->string_size > 0 && strings[h->string_size - 1] != '\0') return NULL;
+
+    for (uint32_t i = 0; i < h->entity_count; i++) {
+        const SceneBinEntity *e = &entities[i];
+        bool root = i < h->root_count;
+        if (root != (e->parent < 0) || (!root && (uint32_t)e->parent >= i) ||
+            !valid_string(h, e->name, true) || !valid_string(h, e->base, true) ||
+            (uint64_t)e->first_component + e->component_count > h->component_count) {
+            return NULL;
+        }
+    }
+    for (uint32_t i = 0; i < h->type_count; i++) {
+        if (!valid_string(h, types[i].name, false)) return NULL;
+    }
+    for (uint32_t i = 0; i < h->component_count; i++) {
+        if (components[i].type >= h->type_count ||
+            (uint64_t)components[i].offset + types[components[i].type].size > h->data_size) {
+            return NULL;
+        }
+    }
+    for (uint32_t i = 0; i < h->fixup_count; i++) {
+        if ((uint64_t)fixups[i].offset + sizeof(const char *) > h->data_size ||
+            !valid_string(h, fixups[i].string, false)) {
+            return NULL;
+        }
+    }
+    for (uint32_t i = 0; i < h->asset_count; i++) {
+        if (!valid_string(h, assets[i].path, false)) return NULL;
+    }
+
+    Agentite_SceneCompiled *c = (Agentite_SceneCompiled *)
+        calloc(1, sizeof(Agentite_SceneCompiled));
+    ecs_id_t *type_ids = (ecs_id_t *)calloc(h->type_count ? h->type_count : 1,
+                                            sizeof(ecs_id_t));
+    if (!c || !type_ids) {
+        free(c);
+        free(type_ids);
+        return NULL;
+    }
+
+    /* The reflect hash matched, so only a renamed registry can miss here */
+    for (uint32_t i = 0; i < h->type_count; i++) {
+        const Agentite_ComponentMeta *meta =
+            agentite_reflect_get_by_name(reflect, strings + types[i].name);
+        if (!meta || meta->size != types[i].size) {
+            free(c);
+            free(type_ids);
+            return NULL;
+        }
+        type_ids[i] = meta->component_id;
+    }
+
+    c->image = image;
+    c->image_size = image_size;
+    c->header = h;
+    c->entities = entities;
+    c->components = components;
+    c->types = types;
+    c->fixups = fixups;
+    c->assets = assets;
+    c->data = image + l.data;
+    c->strings = strings;
+    c->type_ids = type_ids;
+
+    for (uint32_t i = 0; i < h->fixup_count; i++) {
+        const char *str = strings + fixups[i].string;
+        memcpy(c->data + fixups[i].offset, &str, sizeof(str));
+    }
+
+    return c;
+}
+
+/* ============================================================================
+ * Compilation
+ * ============================================================================ */
+
+typedef struct SceneSignature {
+    uint32_t first;                 /* Into sig_types */
+    uint32_t count;
+} SceneSignature;
+
+typedef struct SceneBuilder {
+    const Agentite_ReflectRegistry *reflect;
+    const Agentite_ComponentMeta *position_meta;
+    bool failed;
+
+    SceneBinEntity *entities;
+    uint32_t entity_count, entity_capacity;
+    const Agentite_Prefab **sources;    /* Prefab of each entity */
+    uint32_t source_capacity;
+
+    SceneBinComponent *components;
+    uint32_t component_count, component_capacity;
+
+    SceneBinType *types;
+    uint32_t type_count, type_capacity;
+    const Agentite_ComponentMeta **type_metas;
+    uint32_t type_meta_capacity;
+
+    SceneBinFixup *fixups;
+    uint32_t fixup_count, fixup_capacity;
+
+    SceneBinAsset *assets;
+    uint32_t asset_count, asset_capacity;
+
+    SceneSignature *signatures;
+    uint32_t signature_count, signature_capacity;
+    uint32_t *sig_types;
+    uint32_t sig_type_count, sig_type_capacity;
+
+    uint8_t *data;
+    uint32_t data_size, data_capacity;
+
+    char *strings;
+    uint32_t string_size, string_capacity;
+    uint32_t *string_slots;             /* Open addressing: string offset + 1, 0 = empty */
+    uint32_t string_slot_capacity, string_slot_count;
+} SceneBuilder;
+
+/* Grow an array to hold needed elements; marks the builder failed on error */
+static bool builder_grow(SceneBuilder *b, void **array, uint32_t *capacity,
+                         uint64_t needed, size_t elem_size) {
+    if (b->failed) return false;
+    if (needed <= *capacity) return true;
+    if (needed > SCENE_BIN_NONE / 2) {
+        b->failed = true;
+        return false;
+    }
+
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+
+    void *grown = realloc(*array, (size_t)new_capacity * elem_size);
+    if (!grown) {
+        b->failed = true;
+        return false;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+#define BUILDER_GROW(b, arr, cap, needed) \
+    builder_grow((b), (void **)&(b)->arr, &(b)->cap, (needed), sizeof(*(b)->arr))
+
+static uint32_t intern_string(SceneBuilder *b, const char *str) {
+    /* Keep the slot table at most half full */
+    if ((b->string_slot_count + 1) * 2 > b->string_slot_capacity) {
+        uint32_t capacity = b->string_slot_capacity ? b->string_slot_capacity * 2 : 64;
+        uint32_t *slots = (uint32_t *)calloc(capacity, sizeof(uint32_t));
+        if (!slots) {
+            b->failed = true;
+            return SCENE_BIN_NONE;
+        }
+        for (uint32_t i = 0; i < b->string_slot_capacity; i++) {
+            uint32_t entry = b->string_slots[i];
+            if (!entry) continue;
+            const char *s = b->strings + entry - 1;
+            uint32_t slot = (uint32_t)hash_bytes(FNV64_OFFSET_BASIS, s, strlen(s)) & (capacity - 1);
+            while (slots[slot]) slot = (slot + 1) & (capacity - 1);
+            slots[slot] = entry;
+        }
+        free(b->string_slots);
+        b->string_slots = slots;
+        b->string_slot_capacity = capacity;
+    }
+
+    size_t length = strlen(str);
+    uint32_t mask = b->string_slot_capacity - 1;
+    uint32_t slot = (uint32_t)hash_bytes(FNV64_OFFSET_BASIS, str, length) & mask;
+    while (b->string_slots[slot]) {
+        uint32_t offset = b->string_slots[slot] - 1;
+        if (strcmp(b->strings + offset, str) == 0) {
+            return offset;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    uint32_t offset = b->string_size;
+    if (!BUILDER_GROW(b, strings, string_capacity, (uint64_t)offset + length + 1)) {
+        return SCENE_BIN_NONE;
+    }
+    memcpy(b->strings + offset, str, length + 1);
+    b->string_size = offset + (uint32_t)length + 1;
+    b->string_slots[slot] = offset + 1;
+    b->string_slot_count++;
+    return offset;
+}
+
+static uint32_t type_index(SceneBuilder *b, const Agentite_ComponentMeta *meta) {
+    for (uint32_t i = 0; i < b->type_count; i++) {
+        if (b->type_metas[i] == meta) return i;
+    }
+    if (!BUILDER_GROW(b, types, type_capacity, b->type_count + 1) ||
+        !BUILDER_GROW(b, type_metas, type_meta_capacity, b->type_count + 1)) {
+        return SCENE_BIN_NONE;
+    }
+    b->types[b->type_count].name = intern_string(b, meta->name);
+    b->types[b->type_count].size = (uint32_t)meta->size;
+    b->type_metas[b->type_count] = meta;
+    return b->type_count++;
+}
+
+/**
+ * Bake one component of the entity whose components start at first. A
+ * component set twice starts over, as ecs_set_id() would overwrite it.
+ * Returns its data, or NULL on failure.
+ */
+static uint8_t *bake_component(SceneBuilder *b, uint32_t first, uint32_t first_fixup,
+                               const Agentite_ComponentMeta *meta,
+                               const Agentite_ComponentConfig *config) {
+    uint32_t type = type_index(b, meta);
+    if (type == SCENE_BIN_NONE) return NULL;
+
+    uint32_t offset = SCENE_BIN_NONE;
+    for (uint32_t i = first; i < b->component_count; i++) {
+        if (b->components[i].type == type) {
+            offset = b->components[i].offset;
+            break;
+        }
+    }
+
+    if (offset != SCENE_BIN_NONE) {
+        /* Drop the string fields of the overwritten value */
+        uint32_t kept = first_fixup;
+        for (uint32_t i = first_fixup; i < b->fixup_count; i++) {
+            if (b->fixups[i].offset < offset || b->fixups[i].offset >= offset + meta->size) {
+                b->fixups[kept++] = b->fixups[i];
+            }
+        }
+        b->fixup_count = kept;
+    } else {
+        offset = (uint32_t)align8(b->data_size);
+        if (!BUILDER_GROW(b, components, component_capacity, b->component_count + 1) ||
+            !BUILDER_GROW(b, data, data_capacity, (uint64_t)offset + meta->size)) {
+            return NULL;
+        }
+        memset(b->data + b->data_size, 0, offset + meta->size - b->data_size);
+        b->data_size = offset + (uint32_t)meta->size;
+        b->components[b->component_count].type = type;
+        b->components[b->component_count].offset = offset;
+        b->component_count++;
+    }
+
+    uint8_t *data = b->data + offset;
+    memset(data, 0, meta->size);
+    if (!config) return data;
+
+    agentite_prefab_fill_component(data, meta, config);
+
+    /* String fields point into the prefab; store them as string references */
+    for (int f = 0; f < meta->field_count; f++) {
+        const Agentite_FieldDesc *field = &meta->fields[f];
+        if (field->type != AGENTITE_FIELD_STRING) continue;
+
+        const char *str;
+        memcpy(&str, data + field->offset, sizeof(str));
+        if (!str) continue;
+
+        uint32_t string = intern_string(b, str);
+        if (!BUILDER_GROW(b, fixups, fixup_capacity, b->fixup_count + 1)) return NULL;
+        data = b->data + offset;
+        memset(data + field->offset, 0, sizeof(str));
+        b->fixups[b->fixup_count].offset = offset + (uint32_t)field->offset;
+        b->fixups[b->fixup_count].string = string;
+        b->fixup_count++;
+    }
+    return data;
+}
+
+static uint32_t find_signature(SceneBuilder *b, uint32_t first, uint32_t count) {
+    for (uint32_t s = b->signature_count; s > 0; s--) {
+        const SceneSignature *sig = &b->signatures[s - 1];
+        if (sig->count != count) continue;
+
+        bool same = true;
+        for (uint32_t i = 0; i < count && same; i++) {
+            same = b->sig_types[sig->first + i] == b->components[first + i].type;
+        }
+        if (same) return s - 1;
+    }
+
+    if (!BUILDER_GROW(b, signatures, signature_capacity, b->signature_count + 1) ||
+        !BUILDER_GROW(b, sig_types, sig_type_capacity, (uint64_t)b->sig_type_count + count)) {
+        return 0;
+    }
+    SceneSignature *sig = &b->signatures[b->signature_count];
+    sig->first = b->sig_type_count;
+    sig->count = count;
+    for (uint32_t i = 0; i < count; i++) {
+        b->sig_types[b->sig_type_count++] = b->components[first + i].type;
+    }
+    return b->signature_count++;
+}
+
+static void add_entity(SceneBuilder *b, const Agentite_Prefab *prefab, int32_t parent) {
+    if (!BUILDER_GROW(b, entities, entity_capacity, b->entity_count + 1) ||
+        !BUILDER_GROW(b, sources, source_capacity, b->entity_count + 1)) {
+        return;
+    }
+
+    uint32_t first = b->component_count;
+    uint32_t first_fixup = b->fixup_count;
+
+    for (int i = 0; i < prefab->component_count && !b->failed; i++) {
+        const Agentite_ComponentConfig *config = &prefab->components[i];
+        const Agentite_ComponentMeta *meta =
+            agentite_reflect_get_by_name(b->reflect, config->component_name);
+        if (!meta || meta->size == 0) {
+            /* Component not found in reflection registry - skip */
+            continue;
+        }
+        bake_component(b, first, first_fixup, meta, config);
+    }
+
+    /* Position goes last and replaces any configured C_Position */
+    if (b->position_meta && !b->failed) {
+        uint8_t *data = bake_component(b, first, first_fixup, b->position_meta, NULL);
+        if (data) {
+            memcpy(data, prefab->position, sizeof(float) * 2);
+        }
+    }
+    if (b->failed) return;
+
+    SceneBinEntity *e = &b->entities[b->entity_count];
+    e->parent = parent;
+    e->name = (prefab->name && prefab->name[0]) ? intern_string(b, prefab->name) : SCENE_BIN_NONE;
+    e->base = prefab->base_prefab_name ? intern_string(b, prefab->base_prefab_name)
+                                       : SCENE_BIN_NONE;
+    e->first_component = first;
+    e->component_count = b->component_count - first;
+    e->signature = find_signature(b, first, e->component_count);
+    b->sources[b->entity_count++] = prefab;
+}
+
+static void builder_free(SceneBuilder *b) {
+    free(b->entities);
+    free(b->sources);
+    free(b->components);
+    free(b->types);
+    free(b->type_metas);
+    free(b->fixups);
+    free(b->assets);
+    free(b->signatures);
+    free(b->sig_types);
+    free(b->data);
+    free(b->strings);
+    free(b->string_slots);
+}
+
+Agentite_SceneCompiled *agentite_scene_compile(Agentite_Prefab *const *roots,
+                                                size_t root_count,
+                                                const Agentite_AssetRef *asset_refs,
+                                                size_t asset_ref_count,
+                                                const Agentite_ReflectRegistry *reflect,
+                                                uint64_t source_hash) {
+    if (!roots || !reflect) {
+        agentite_set_error("scene: Invalid parameters");
+        return NULL;
+    }
+
+    SceneBuilder b = {};
+    b.reflect = reflect;
+    b.position_meta = agentite_reflect_get_by_name(reflect, "C_Position");
+    if (b.position_meta && b.position_meta->size < sizeof(float) * 2) {
+        b.position_meta = NULL;
+    }
+
+    /* Breadth-first: roots first, then each entity's children side by side */
+    for (size_t i = 0; i < root_count && !b.failed; i++) {
+        add_entity(&b, roots[i], -1);
+    }
+    for (uint32_t i = 0; i < b.entity_count && !b.failed; i++) {
+        const Agentite_Prefab *prefab = b.sources[i];
+        for (int c = 0; c < prefab->child_count && !b.failed; c++) {
+            add_entity(&b, prefab->children[c], (int32_t)i);
+        }
+    }
+
+    for (size_t i = 0; i < asset_ref_count && !b.failed; i++) {
+        if (!BUILDER_GROW(&b, assets, asset_capacity, b.asset_count + 1)) break;
+        b.assets[b.asset_count].path = intern_string(&b, asset_refs[i].path);
+        b.assets[b.asset_count].type = (uint32_t)asset_refs[i].type;
+        b.asset_count++;
+    }
+
+    if (b.failed) {
+        builder_free(&b);
+        agentite_set_error("scene: Scene too large or out of memory while compiling");
+        return NULL;
+    }
+
+    SceneBinHeader header = {};
+    memcpy(header.magic, SCENE_BIN_MAGIC, 4);
+    header.format_version = SCENE_BIN_FORMAT_VERSION;
+    header.source_hash = source_hash;
+    header.reflect_hash = reflect_layout_hash(reflect);
+    header.entity_count = b.entity_count;
+    header.root_count = (uint32_t)root_count;
+    header.component_count = b.component_count;
+    header.type_count = b.type_count;
+    header.fixup_count = b.fixup_count;
+    header.asset_count = b.asset_count;
+    header.data_size = b.data_size;
+    header.string_size = b.string_size;
+
+    SceneBinLayout l = compute_layout(&header);
+    uint8_t *image = (uint8_t *)calloc(1, l.total);
+    if (!image) {
+        builder_free(&b);
+        agentite_set_error("scene: Out of memory");
+        return NULL;
+    }
+    memcpy(image, &header, sizeof(header));
+    if (b.entity_count) memcpy(image + l.entities, b.entities, b.entity_count * sizeof(SceneBinEntity));
+    if (b.component_count) memcpy(image + l.components, b.components, b.component_count * sizeof(SceneBinComponent));
+    if (b.type_count) memcpy(image + l.types, b.types, b.type_count * sizeof(SceneBinType));
+    if (b.fixup_count) memcpy(image + l.fixups, b.fixups, b.fixup_count * sizeof(SceneBinFixup));
+    if (b.asset_count) memcpy(image + l.assets, b.assets, b.asset_count * sizeof(SceneBinAsset));
+    if (b.data_size) memcpy(image + l.data, b.data, b.data_size);
+    if (b.string_size) memcpy(image + l.strings, b.strings, b.string_size);
+    builder_free(&b);
+
+    Agentite_SceneCompiled *compiled = open_image(image, l.total, source_hash, reflect);
+    if (!compiled) {
+        free(image);
+        agentite_set_error("scene: Compiled scene failed validation");
+    }
+    return compiled;
+}
+
+/* ============================================================================
+ * Cache Files
+ * ============================================================================ */
+
+Agentite_SceneCompiled *agentite_scene_compiled_read(const char *path,
+                                                      uint64_t source_hash,
+                                                      const Agentite_ReflectRegistry *reflect) {
+    if (!path || !reflect) return NULL;
+
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    SceneBinHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, SCENE_BIN_MAGIC, 4) != 0 ||
+        header.source_hash != source_hash) {
+        fclose(file);
+        return NULL;
+    }
+
+    /* The header must describe exactly this file; the rest is checked in open_image */
+    size_t size = compute_layout(&header).total;
+    long file_size = (fseek(file, 0, SEEK_END) == 0) ? ftell(file) : -1;
+    if (file_size < 0 || (size_t)file_size != size ||
+        fseek(file, (long)sizeof(header), SEEK_SET) != 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    uint8_t *image = (uint8_t *)malloc(size);
+    if (!image) {
+        fclose(file);
+        return NULL;
+    }
+    memcpy(image, &header, sizeof(header));
+    size_t rest = size - sizeof(header);
+    bool ok = fread(image + sizeof(header), 1, rest, file) == rest;
+    fclose(file);
+
+    Agentite_SceneCompiled *compiled = ok ? open_image(image, size, source_hash, reflect) : NULL;
+    if (!compiled) {
+        free(image);
+    }
+    return compiled;
+}
+
+bool agentite_scene_compiled_write(const Agentite_SceneCompiled *compiled, const char *path) {
+    if (!compiled || !path) {
+        agentite_set_error("scene: Invalid parameters");
+        return false;
+    }
+
+    /* Strip the patched string pointers */
+    uint8_t *image = (uint8_t *)malloc(compiled->image_size);
+    if (!image) {
+        agentite_set_error("scene: Out of memory");
+        return false;
+    }
+    memcpy(image, compiled->image, compiled->image_size);
+    size_t data_offset = (size_t)(compiled->data - compiled->image);
+    for (uint32_t i = 0; i < compiled->header->fixup_count; i++) {
+        memset(image + data_offset + compiled->fixups[i].offset, 0, sizeof(const char *));
+    }
+
+    char temp_path[1024];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE *file = fopen(temp_path, "wb");
+    if (!file) {
+        free(image);
+        agentite_set_error("scene: Failed to open '%s' for writing", temp_path);
+        return false;
+    }
+    bool ok = fwrite(image, 1, compiled->image_size, file) == compiled->image_size;
+    ok = (fclose(file) == 0) && ok;
+    free(image);
+
+#ifdef _WIN32
+    if (ok) remove(path);  /* rename() does not overwrite on Windows */
+#endif
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        agentite_set_error("scene: Failed to write '%s'", path);
+        return false;
+    }
+    return true;
+}
+
+void agentite_scene_compiled_destroy(Agentite_SceneCompiled *compiled) {
+    if (!compiled) return;
+    free(compiled->type_ids);
+    free(compiled->image);
+    free(compiled);
+}
+
+size_t agentite_scene_compiled_root_count(const Agentite_SceneCompiled *compiled) {
+    return compiled ? compiled->header->root_count : 0;
+}
+
+size_t agentite_scene_compiled_entity_count(const Agentite_SceneCompiled *compiled) {
+    return compiled ? compiled->header->entity_count : 0;
+}
+
+bool agentite_scene_compiled_get_asset(const Agentite_SceneCompiled *compiled,
+                                        size_t index, Agentite_AssetRef *out_ref) {
+    if (!compiled || !out_ref || index >= compiled->header->asset_count) return false;
+    out_ref->path = (char *)(compiled->strings + compiled->assets[index].path);
+    out_ref->type = (Agentite_AssetType)compiled->assets[index].type;
+    return true;
+}
+
+/* ============================================================================
+ * Instantiation
+ * ============================================================================ */
+
+static void apply_base_prefab(ecs_world_t *world, ecs_entity_t entity,
+                              const Agentite_Prefab *base,
+                              const Agentite_ReflectRegistry *reflect) {
+    for (int i = 0; i < base->component_count; i++) {
+        const Agentite_ComponentMeta *meta =
+            agentite_reflect_get_by_name(reflect, base->components[i].component_name);
+        if (!meta) continue;
+
+        void *data = calloc(1, meta->size);
+        if (!data) continue;
+        agentite_prefab_fill_component(data, meta, &base->components[i]);
+        ecs_set_id(world, entity, meta->component_id, meta->size, data);
+        free(data);
+    }
+}
+
+static ecs_entity_t instantiate_one(const Agentite_SceneCompiled *c, uint32_t index,
+                                    ecs_world_t *world, ecs_entity_t parent, bool disabled,
+                                    Agentite_PrefabRegistry *prefabs,
+                                    const Agentite_ReflectRegistry *reflect) {
+    const SceneBinEntity *e = &c->entities[index];
+
+    ecs_entity_t entity;
+    if (e->name != SCENE_BIN_NONE) {
+        ecs_entity_desc_t desc = {};
+        desc.name = c->strings + e->name;
+        entity = ecs_entity_init(world, &desc);
+    } else {
+        entity = ecs_new(world);
+    }
+    if (!entity) return 0;
+
+    if (disabled) {
+        ecs_add_id(world, entity, EcsDisabled);
+    }
+    if (parent) {
+        ecs_add_pair(world, entity, EcsChildOf, parent);
+    }
+
+    /* Base prefabs are resolved now, so editing one needs no scene rebuild */
+    if (e->base != SCENE_BIN_NONE && prefabs && reflect) {
+        const Agentite_Prefab *base = agentite_prefab_lookup(prefabs, c->strings + e->base);
+        if (base) {
+            apply_base_prefab(world, entity, base, reflect);
+        }
+    }
+
+    for (uint32_t i = 0; i < e->component_count; i++) {
+        const SceneBinComponent *comp = &c->components[e->first_component + i];
+        ecs_set_id(world, entity, c->type_ids[comp->type], c->types[comp->type].size,
+                   c->data + comp->offset);
+    }
+    return entity;
+}
+
+/* Unnamed siblings without a base prefab and with equal types share a bulk insert */
+static bool same_batch(const Agentite_SceneCompiled *c, const SceneBinEntity *a,
+                       const SceneBinEntity *b) {
+    if (b->name != SCENE_BIN_NONE || b->base != SCENE_BIN_NONE ||
+        b->parent != a->parent || b->signature != a->signature ||
+        b->component_count != a->component_count) {
+        return false;
+    }
+    /* The signature is only a hint in a file; the gather relies on the types */
+    for (uint32_t k = 0; k < a->component_count; k++) {
+        if (c->components[a->first_component + k].type !=
+            c->components[b->first_component + k].type) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool instantiate_run(const Agentite_SceneCompiled *c, uint32_t first, uint32_t count,
+                            ecs_world_t *world, ecs_entity_t parent, bool disabled,
+                            ecs_entity_t *out_entities) {
+    const SceneBinEntity *lead = &c->entities[first];
+    uint32_t type_count = lead->component_count;
+
+    /* One column per component, gathered from each entity's baked value */
+    size_t row_size = 0;
+    for (uint32_t k = 0; k < type_count; k++) {
+        row_size += c->types[c->components[lead->first_component + k].type].size;
+    }
+    uint8_t *columns = NULL;
+    if (row_size > 0) {
+        columns = (uint8_t *)malloc(row_size * count);
+        if (!columns) return false;
+    }
+
+    ecs_bulk_desc_t desc = {};
+    void *data[FLECS_ID_DESC_MAX] = {};
+    uint8_t *column = columns;
+    for (uint32_t k = 0; k < type_count; k++) {
+        uint32_t type = c->components[lead->first_component + k].type;
+        size_t size = c->types[type].size;
+        for (uint32_t j = 0; j < count; j++) {
+            const SceneBinEntity *e = &c->entities[first + j];
+            memcpy(column + j * size, c->data + c->components[e->first_component + k].offset, size);
+        }
+        desc.ids[k] = c->type_ids[type];
+        data[k] = column;
+        column += size * count;
+    }
+    uint32_t id_count = type_count;
+    if (parent) {
+        desc.ids[id_count++] = ecs_pair(EcsChildOf, parent);
+    }
+    if (disabled) {
+        desc.ids[id_count++] = EcsDisabled;
+    }
+    desc.count = (int32_t)count;
+    desc.data = data;
+
+    const ecs_entity_t *entities = ecs_bulk_init(world, &desc);
+    free(columns);
+    if (!entities) return false;
+
+    memcpy(out_entities + first, entities, sizeof(ecs_entity_t) * count);
+    return true;
+}
+
+size_t agentite_scene_compiled_instantiate(const Agentite_SceneCompiled *compiled,
+                                            ecs_world_t *world,
+                                            Agentite_PrefabRegistry *prefabs,
+                                            const Agentite_ReflectRegistry *reflect,
+                                            ecs_entity_t *out_entities) {
+    return agentite_scene_compiled_instantiate_range(compiled, world, prefabs, reflect,
+                                                     0, agentite_scene_compiled_entity_count(compiled),
+                                                     false, out_entities);
+}
+
+size_t agentite_scene_compiled_instantiate_range(const Agentite_SceneCompiled *compiled,
+                                                  ecs_world_t *world,
+                                                  Agentite_PrefabRegistry *prefabs,
+                                                  const Agentite_ReflectRegistry *reflect,
+                                                  size_t first, size_t count, bool disabled,
+                                                  ecs_entity_t *out_entities) {
+    if (!compiled || !world || !out_entities) return 0;
+
+    const Agentite_SceneCompiled *c = compiled;
+    uint32_t end = c->header->entity_count;
+    if (first >= end) return 0;
+    if (count < end - first) end = (uint32_t)(first + count);
+
+    bool can_bulk = !ecs_is_deferred(world);
+    uint32_t extra_ids = disabled ? 1 : 0;
+    size_t created = 0;
+
+    uint32_t i = (uint32_t)first;
+    while (i < end) {
+        const SceneBinEntity *e = &c->entities[i];
+        ecs_entity_t parent = e->parent >= 0 ? out_entities[e->parent] : 0;
+
+        uint32_t run = 1;
+        if (can_bulk && e->name == SCENE_BIN_NONE && e->base == SCENE_BIN_NONE &&
+            e->component_count + (parent ? 1 : 0) + extra_ids <= FLECS_ID_DESC_MAX &&
+            e->component_count > 0) {
+            while (i + run < end && same_batch(c, e, &c->entities[i + run])) {
+                run++;
+            }
+        }
+
+        if (run > 1 && instantiate_run(c, i, run, world, parent, disabled, out_entities)) {
+            created += run;
+        } else {
+            run = 1;
+            out_entities[i] = instantiate_one(c, i, world, parent, disabled, prefabs, reflect);
+            if (out_entities[i]) created++;
+        }
+        i += run;
+    }
+    return created;
+}
@@ -1,7 +1,8 @@
 /**
  * Agentite Engine - Scene Lexer/Parser Internal Types
  *
- * Internal header shared between scene_lexer.cpp and scene_parser.cpp.
+ * Internal header shared between scene_lexer.cpp and scene_parser.cpp,
+ * and between scene.cpp and the compiled scene cache (scene_cache.cpp).
  */
 
 #ifndef AGENTITE_SCENE_INTERNAL_H
@@ -10,6 +11,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include "agentite/scene.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -104,6 +106,88 @@ const char *agentite_token_type_name(Agentite_TokenType type);
  */
 char *agentite_token_to_string(const Agentite_Token *token);
 
+/* ============================================================================
+ * Compiled Scene Cache
+ * ============================================================================ */
+
+/**
+ * Flat, pre-resolved form of a parsed scene: an entity table in breadth-first
+ * order (roots first, siblings adjacent), baked component data, the asset
+ * list and the hash of the source it came from. The same image is written
+ * to and read from cache files.
+ */
+typedef struct Agentite_SceneCompiled Agentite_SceneCompiled;
+
+/**
+ * Hash scene source text (64-bit FNV-1a).
+ */
+uint64_t agentite_scene_source_hash(const char *source, size_t length);
+
+/**
+ * Compile parsed root prefabs. Components missing from reflect are skipped,
+ * as when spawning. Returns NULL and sets the scene error on failure.
+ */
+Agentite_SceneCompiled *agentite_scene_compile(Agentite_Prefab *const *roots,
+                                                size_t root_count,
+                                                const Agentite_AssetRef *asset_refs,
+                                                size_t asset_ref_count,
+                                                const Agentite_ReflectRegistry *reflect,
+                                                uint64_t source_hash);
+
+/**
+ * Read a cache file. Returns NULL without an error when the file is missing,
+ * corrupt, or was built from other source or another reflection layout.
+ */
+Agentite_SceneCompiled *agentite_scene_compiled_read(const char *path,
+                                                      uint64_t source_hash,
+                                                      const Agentite_ReflectRegistry *reflect);
+
+/**
+ * Write a cache file (through a temp file, replaced on success).
+ */
+bool agentite_scene_compiled_write(const Agentite_SceneCompiled *compiled,
+                                    const char *path);
+
+void agentite_scene_compiled_destroy(Agentite_SceneCompiled *compiled);
+
+size_t agentite_scene_compiled_root_count(const Agentite_SceneCompiled *compiled);
+size_t agentite_scene_compiled_entity_count(const Agentite_SceneCompiled *compiled);
+
+/**
+ * Get asset reference i. The path is owned by the compiled scene.
+ */
+bool agentite_scene_compiled_get_asset(const Agentite_SceneCompiled *compiled,
+                                        size_t index, Agentite_AssetRef *out_ref);
+
+/**
+ * Create every entity of a compiled scene.
+ *
+ * @param out_entities Receives one entity per table row (entity_count);
+ *                     the first root_count are the roots
+ * @return Number of entities created
+ */
+size_t agentite_scene_compiled_instantiate(const Agentite_SceneCompiled *compiled,
+                                            ecs_world_t *world,
+                                            Agentite_PrefabRegistry *prefabs,
+                                            const Agentite_ReflectRegistry *reflect,
+                                            ecs_entity_t *out_entities);
+
+/**
+ * Instantiate rows [first, first + count) of a compiled scene.
+ * Parents come before their children, so ranges taken in order always
+ * find their parents in out_entities.
+ *
+ * @param disabled     Add EcsDisabled to every created entity
+ * @param out_entities Entity per row for the whole scene, as above
+ * @return Number of entities created
+ */
+size_t agentite_scene_compiled_instantiate_range(const Agentite_SceneCompiled *compiled,
+                                                  ecs_world_t *world,
+                                                  Agentite_PrefabRegistry *prefabs,
+                                                  const Agentite_ReflectRegistry *reflect,
+                                                  size_t first, size_t count, bool disabled,
+                                                  ecs_entity_t *out_entities);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,6 @@
 #include "agentite/agentite.h"
 #include "agentite/history.h"
+#include "agentite/arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -129,7 +130,9 @@ const Agentite_HistoryEvent *agentite_history_get_event(const Agentite_History *
     return &h->events[physical];
 }
 
-Agentite_GraphData agentite_history_get_graph(const Agentite_History *h, int metric_index) {
+// Shared by the heap and arena variants; arena == NULL means malloc
+static Agentite_GraphData get_graph(const Agentite_History *h, int metric_index,
+                                    Agentite_Arena *arena) {
     Agentite_GraphData data = {0};
 
     if (!h || metric_index < 0 || metric_index >= AGENTITE_HISTORY_MAX_METRICS) {
@@ -141,7 +144,9 @@ Agentite_GraphData agentite_history_get_graph(const Agentite_History *h, int met
     }
 
     // Allocate values array
-    data.values = (float*)malloc(sizeof(float) * h->snapshot_count);
+    data.values = arena
+        ? (float*)agentite_arena_alloc(arena, sizeof(float) * h->snapshot_count, 0)
+        : (float*)malloc(sizeof(float) * h->snapshot_count);
     if (!data.values) return data;
 
     data.count = h->snapshot_count;
@@ -161,6 +166,19 @@ Agentite_GraphData agentite_history_get_graph(const Agentite_History *h, int met
     return data;
 }
 
+Agentite_GraphData agentite_history_get_graph(const Agentite_History *h, int metric_index) {
+    return get_graph(h, metric_index, NULL);
+}
+
+Agentite_GraphData agentite_history_get_graph_frame(const Agentite_History *h, int metric_index,
+                                                    Agentite_Arena *arena) {
+    if (!arena) {
+        Agentite_GraphData empty = {0};
+        return empty;
+    }
+    return get_graph(h, metric_index, arena);
+}
+
 void agentite_graph_data_free(Agentite_GraphData *data) {
     if (!data) return;
     free(data->values);
@@ -8,13 +8,19 @@
 
 #include "agentite/replay.h"
 #include "agentite/command.h"
+#include "agentite/compress.h"
 #include "agentite/error.h"
 #include "agentite/validate.h"
 
+#include <SDL3/SDL.h>
+
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
 #include <ctime>
+#include <deque>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 
@@ -24,31 +30,87 @@
 
 static const int k_initial_frame_capacity = 1024;
 
+/* v2 file layout: fixed header, then typed blocks, then an index block */
+static const size_t k_header_size_v1 = 160;        /* Metadata fields only */
+static const size_t k_header_size = 172;           /* + u32 flags, u64 index offset */
+static const size_t k_block_header_size = 12;      /* kind, flags, pad, raw size, stored size */
+static const size_t k_frame_block_target = 64 * 1024;
+static const uint64_t k_frame_block_max_frames = 4096;
+static const size_t k_min_compress_size = 64;
+static const uint32_t k_max_block_size = 1u << 30;
+
+/* Header field offsets patched when a streamed recording finishes */
+static const long k_header_total_frames_offset = 140;
+static const long k_header_index_offset = 164;
+
+/* Streamed recordings flush the resident frames once either pool fills */
+static const size_t k_stream_max_commands = 4096;
+static const size_t k_stream_max_params = 4 * 4096;
+static const size_t k_stream_min_memory = 64 * 1024;
+
+#define REPLAY_BLOCK_COMPRESSED 0x01
+
+enum ReplayBlockKind {
+    REPLAY_BLOCK_STRINGS = 1,
+    REPLAY_BLOCK_INITIAL_STATE,
+    REPLAY_BLOCK_FRAMES,
+    REPLAY_BLOCK_SNAPSHOT,
+    REPLAY_BLOCK_INDEX
+};
+
 /*============================================================================
  * Internal Structures
  *============================================================================*/
 
-/** Recorded command with frame info */
+/** Recorded parameter; key and string values index the string table */
+struct ReplayParam {
+    uint32_t key;
+    uint8_t type;
+    union {
+        int32_t i32;
+        int64_t i64;
+        float f32;
+        double f64;
+        bool b;
+        uint32_t entity;
+        uint32_t str;
+    };
+};
+
+/** Recorded command; its params are a range of the shared param pool */
 struct ReplayCommand {
-    int type;
-    Agentite_CommandParam params[AGENTITE_COMMAND_MAX_PARAMS];
-    int param_count;
+    int32_t type;
     uint32_t sequence;
     int32_t source_faction;
+    uint32_t first_param;
+    uint32_t param_count;
 };
 
-/** Single frame of recorded data */
+/** Single frame of recorded data (frame number is its index) */
 struct ReplayFrame {
-    uint64_t frame_number;
     float delta_time;
-    std::vector<ReplayCommand> commands;
+    uint32_t first_command;
+    uint32_t command_count;
+};
+
+/** Frame block location from the file index */
+struct ReplayBlockRef {
+    uint64_t first_frame;
+    uint64_t frame_count;
+    float start_time;
+    uint64_t offset;
 };
 
+/** Background file I/O for streamed recording and playback */
+struct ReplayStream;
+
 /** State snapshot for seeking */
 struct ReplaySnapshot {
     uint64_t frame_number;
-    void *data;
+    float time;             /* Playback time at frame_number */
+    void *data;             /* NULL while the snapshot is still on disk */
     size_t size;
+    uint64_t file_offset;   /* Snapshot block in source_path (0 = in memory) */
 };
 
 /** Main replay system structure */
@@ -60,13 +122,22 @@ struct Agentite_ReplaySystem {
     Agentite_ReplayState state;
     Agentite_ReplayMetadata metadata;
 
-    /* Frame data */
+    /* Frame data. When streaming, frames holds only the resident window
+     * starting at frame_base; commands and params are reused per window. */
     std::vector<ReplayFrame> frames;
+    std::vector<ReplayCommand> commands;
+    std::vector<ReplayParam> params;
+    uint64_t frame_base;
+    uint64_t total_frames;
     uint64_t current_frame;
     float current_time;
     float accumulated_time;
 
-    /* Snapshots */
+    /* Interned parameter keys and string values */
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> string_ids;
+
+    /* Snapshots (in frame order) */
     std::vector<ReplaySnapshot> snapshots;
     uint64_t frames_since_snapshot;
 
@@ -74,11 +145,21 @@ struct Agentite_ReplaySystem {
     void *initial_state_data;
     size_t initial_state_size;
 
+    /* File that on-disk snapshots (and streamed frames) are read from */
+    char source_path[AGENTITE_REPLAY_MAX_PATH];
+
+    /* Streaming */
+    ReplayStream *stream;
+    std::vector<ReplayBlockRef> blocks;
+    float window_start_time;        /* Playback time at frame_base while recording */
+    uint64_t stream_initial_offset; /* Initial state block of a streamed recording */
+    std::vector<uint8_t> block_buffer;
+
     /* Recording */
     Agentite_CommandSystem *recording_cmd_sys;
     Agentite_CommandCallback original_callback;
     void *original_callback_userdata;
-    std::vector<ReplayCommand> pending_commands;
+    size_t pending_first_command;   /* Commands from here belong to the next frame */
 
     /* Playback */
     Agentite_CommandSystem *playback_cmd_sys;
@@ -95,34 +176,112 @@ struct Agentite_ReplaySystem {
  * Internal Helper Functions
  *============================================================================*/
 
-static void copy_command_to_replay(ReplayCommand *dst, const Agentite_Command *src) {
-    dst->type = src->type;
-    dst->param_count = src->param_count;
-    dst->sequence = src->sequence;
-    dst->source_faction = src->source_faction;
+static uint32_t intern_string(Agentite_ReplaySystem *replay, const char *str) {
+    auto it = replay->string_ids.find(str);
+    if (it != replay->string_ids.end()) {
+        return it->second;
+    }
+    uint32_t id = (uint32_t)replay->strings.size();
+    replay->strings.emplace_back(str);
+    replay->string_ids.emplace(replay->strings.back(), id);
+    return id;
+}
+
+static void copy_command_to_replay(Agentite_ReplaySystem *replay, const Agentite_Command *src) {
+    ReplayCommand rc;
+    rc.type = src->type;
+    rc.sequence = src->sequence;
+    rc.source_faction = src->source_faction;
+    rc.first_param = (uint32_t)replay->params.size();
+    rc.param_count = 0;
 
     for (int i = 0; i < src->param_count && i < AGENTITE_COMMAND_MAX_PARAMS; i++) {
-        /* Skip pointer parameters - not serializable */
-        if (src->params[i].type == AGENTITE_CMD_PARAM_PTR) {
-            dst->params[i].type = AGENTITE_CMD_PARAM_NONE;
-            continue;
+        const Agentite_CommandParam *sp = &src->params[i];
+        ReplayParam p;
+        p.i64 = 0;
+        p.key = intern_string(replay, sp->key);
+        p.type = (uint8_t)sp->type;
+
+        switch (sp->type) {
+            case AGENTITE_CMD_PARAM_INT:    p.i32 = sp->i32; break;
+            case AGENTITE_CMD_PARAM_INT64:  p.i64 = sp->i64; break;
+            case AGENTITE_CMD_PARAM_FLOAT:  p.f32 = sp->f32; break;
+            case AGENTITE_CMD_PARAM_DOUBLE: p.f64 = sp->f64; break;
+            case AGENTITE_CMD_PARAM_BOOL:   p.b = sp->b; break;
+            case AGENTITE_CMD_PARAM_ENTITY: p.entity = sp->entity; break;
+            case AGENTITE_CMD_PARAM_STRING: p.str = intern_string(replay, sp->str); break;
+            default:
+                /* Pointer parameters are not serializable */
+                p.type = AGENTITE_CMD_PARAM_NONE;
+                break;
         }
-        dst->params[i] = src->params[i];
+
+        replay->params.push_back(p);
+        rc.param_count++;
     }
+
+    replay->commands.push_back(rc);
 }
 
-static void copy_replay_to_command(Agentite_Command *dst, const ReplayCommand *src) {
+static void copy_replay_to_command(const Agentite_ReplaySystem *replay,
+                                   Agentite_Command *dst, const ReplayCommand *src) {
     dst->type = src->type;
-    dst->param_count = src->param_count;
+    dst->param_count = (int)src->param_count;
     dst->sequence = src->sequence;
     dst->source_faction = src->source_faction;
     dst->userdata = nullptr;
 
-    for (int i = 0; i < src->param_count && i < AGENTITE_COMMAND_MAX_PARAMS; i++) {
-        dst->params[i] = src->params[i];
+    for (uint32_t i = 0; i < src->param_count; i++) {
+        const ReplayParam *sp = &replay->params[src->first_param + i];
+        Agentite_CommandParam *p = &dst->params[i];
+        memset(p, 0, sizeof(*p));
+        strncpy(p->key, replay->strings[sp->key].c_str(), sizeof(p->key) - 1);
+        p->key_id = agentite_command_key(p->key);
+        p->type = (Agentite_CommandParamType)sp->type;
+
+        switch (sp->type) {
+            case AGENTITE_CMD_PARAM_INT:    p->i32 = sp->i32; break;
+            case AGENTITE_CMD_PARAM_INT64:  p->i64 = sp->i64; break;
+            case AGENTITE_CMD_PARAM_FLOAT:  p->f32 = sp->f32; break;
+            case AGENTITE_CMD_PARAM_DOUBLE: p->f64 = sp->f64; break;
+            case AGENTITE_CMD_PARAM_BOOL:   p->b = sp->b; break;
+            case AGENTITE_CMD_PARAM_ENTITY: p->entity = sp->entity; break;
+            case AGENTITE_CMD_PARAM_STRING:
+                strncpy(p->str, replay->strings[sp->str].c_str(), sizeof(p->str) - 1);
+                break;
+            default:
+                break;
+        }
     }
 }
 
+/** Execute every command of a frame, returning how many succeeded */
+static int execute_frame(Agentite_ReplaySystem *replay, const ReplayFrame &frame,
+                         void *game_state) {
+    int commands_executed = 0;
+
+    for (uint32_t i = 0; i < frame.command_count; i++) {
+        Agentite_Command cmd;
+        copy_replay_to_command(replay, &cmd, &replay->commands[frame.first_command + i]);
+
+        Agentite_CommandResult result = agentite_command_execute(
+            replay->playback_cmd_sys, &cmd, game_state);
+
+        if (result.success) {
+            commands_executed++;
+        }
+    }
+
+    return commands_executed;
+}
+
+/* Streaming (defined with the file I/O below) */
+static void stream_destroy(ReplayStream *s);
+static bool stream_begin_recording(Agentite_ReplaySystem *replay, const char *filepath);
+static bool stream_flush_frames(Agentite_ReplaySystem *replay);
+static bool stream_write_snapshot(Agentite_ReplaySystem *replay, ReplaySnapshot *snapshot);
+static bool stream_finish_recording(Agentite_ReplaySystem *replay);
+
 static void free_snapshot(ReplaySnapshot *snapshot) {
     if (snapshot && snapshot->data) {
         free(snapshot->data);
@@ -153,9 +312,7 @@ static void replay_command_callback(Agentite_CommandSystem *sys,
 
     /* Only record successful commands */
     if (result->success) {
-        ReplayCommand rc;
-        copy_command_to_replay(&rc, cmd);
-        replay->pending_commands.push_back(rc);
+        copy_command_to_replay(replay, cmd);
     }
 
     /* Chain to original callback if set */
@@ -195,6 +352,8 @@ Agentite_ReplaySystem *agentite_replay_create(const Agentite_ReplayConfig *confi
     replay->metadata.version = AGENTITE_REPLAY_VERSION;
     replay->metadata.min_compatible_version = AGENTITE_REPLAY_MIN_VERSION;
 
+    replay->frame_base = 0;
+    replay->total_frames = 0;
     replay->current_frame = 0;
     replay->current_time = 0.0f;
     replay->accumulated_time = 0.0f;
@@ -202,10 +361,16 @@ Agentite_ReplaySystem *agentite_replay_create(const Agentite_ReplayConfig *confi
 
     replay->initial_state_data = nullptr;
     replay->initial_state_size = 0;
+    replay->source_path[0] = '\0';
+
+    replay->stream = nullptr;
+    replay->window_start_time = 0.0f;
+    replay->stream_initial_offset = 0;
 
     replay->recording_cmd_sys = nullptr;
     replay->original_callback = nullptr;
     replay->original_callback_userdata = nullptr;
+    replay->pending_first_command = 0;
 
     replay->playback_cmd_sys = nullptr;
     replay->playback_speed = 1.0f;
@@ -233,6 +398,8 @@ void agentite_replay_destroy(Agentite_ReplaySystem *replay) {
         agentite_replay_stop_playback(replay);
     }
 
+    stream_destroy(replay->stream);
+
     /* Free initial state */
     if (replay->initial_state_data) {
         free(replay->initial_state_data);
@@ -250,13 +417,11 @@ void agentite_replay_destroy(Agentite_ReplaySystem *replay) {
  * Recording
  *============================================================================*/
 
-bool agentite_replay_start_recording(Agentite_ReplaySystem *replay,
-                                      Agentite_CommandSystem *cmd_sys,
-                                      void *game_state,
-                                      const Agentite_ReplayMetadata *metadata) {
-    AGENTITE_VALIDATE_PTR_RET(replay, false);
-    AGENTITE_VALIDATE_PTR_RET(cmd_sys, false);
-
+static bool begin_recording(Agentite_ReplaySystem *replay,
+                            Agentite_CommandSystem *cmd_sys,
+                            void *game_state,
+                            const Agentite_ReplayMetadata *metadata,
+                            const char *stream_path) {
     if (replay->state != AGENTITE_REPLAY_IDLE) {
         agentite_set_error("replay: cannot start recording, not in idle state");
         return false;
@@ -290,6 +455,11 @@ bool agentite_replay_start_recording(Agentite_ReplaySystem *replay,
         replay->initial_state_size = size;
     }
 
+    if (stream_path && !stream_begin_recording(replay, stream_path)) {
+        agentite_replay_clear(replay);
+        return false;
+    }
+
     /* Hook into command system */
     replay->recording_cmd_sys = cmd_sys;
     /* Note: In a full implementation, we'd need to get the current callback
@@ -304,6 +474,26 @@ bool agentite_replay_start_recording(Agentite_ReplaySystem *replay,
     return true;
 }
 
+bool agentite_replay_start_recording(Agentite_ReplaySystem *replay,
+                                      Agentite_CommandSystem *cmd_sys,
+                                      void *game_state,
+                                      const Agentite_ReplayMetadata *metadata) {
+    AGENTITE_VALIDATE_PTR_RET(replay, false);
+    AGENTITE_VALIDATE_PTR_RET(cmd_sys, false);
+    return begin_recording(replay, cmd_sys, game_state, metadata, nullptr);
+}
+
+bool agentite_replay_start_recording_stream(Agentite_ReplaySystem *replay,
+                                             Agentite_CommandSystem *cmd_sys,
+                                             void *game_state,
+                                             const Agentite_ReplayMetadata *metadata,
+                                             const char *filepath) {
+    AGENTITE_VALIDATE_PTR_RET(replay, false);
+    AGENTITE_VALIDATE_PTR_RET(cmd_sys, false);
+    AGENTITE_VALIDATE_PTR_RET(filepath, false);
+    return begin_recording(replay, cmd_sys, game_state, metadata, filepath);
+}
+
 void agentite_replay_stop_recording(Agentite_ReplaySystem *replay) {
     if (!replay || replay->state != AGENTITE_REPLAY_RECORDING) {
         return;
@@ -317,11 +507,21 @@ void agentite_replay_stop_recording(Agentite_ReplaySystem *replay) {
         replay->recording_cmd_sys = nullptr;
     }
 
+    /* Drop commands recorded after the last frame */
+    if (replay->commands.size() > replay->pending_first_command) {
+        replay->params.resize(replay->commands[replay->pending_first_command].first_param);
+        replay->commands.resize(replay->pending_first_command);
+    }
+
     /* Finalize metadata */
-    replay->metadata.total_frames = replay->frames.size();
+    replay->metadata.total_frames = replay->total_frames;
     replay->metadata.total_duration = replay->current_time;
 
     replay->state = AGENTITE_REPLAY_IDLE;
+
+    if (replay->stream) {
+        stream_finish_recording(replay);
+    }
 }
 
 void agentite_replay_record_frame(Agentite_ReplaySystem *replay, float delta_time) {
@@ -329,14 +529,22 @@ void agentite_replay_record_frame(Agentite_ReplaySystem *replay, float delta_tim
         return;
     }
 
-    /* Create frame with pending commands */
+    /* Close the frame over the commands recorded since the last one */
     ReplayFrame frame;
-    frame.frame_number = replay->current_frame;
     frame.delta_time = delta_time;
-    frame.commands = std::move(replay->pending_commands);
-    replay->pending_commands.clear();
+    frame.first_command = (uint32_t)replay->pending_first_command;
+    frame.command_count = (uint32_t)(replay->commands.size() - replay->pending_first_command);
+    replay->frames.push_back(frame);
+    replay->pending_first_command = replay->commands.size();
+    replay->total_frames++;
 
-    replay->frames.push_back(std::move(frame));
+    /* Streamed recordings keep only a bounded window resident */
+    if (replay->stream &&
+        (replay->frames.size() >= k_frame_block_max_frames ||
+         replay->commands.size() >= k_stream_max_commands ||
+         replay->params.size() >= k_stream_max_params)) {
+        stream_flush_frames(replay);
+    }
 
     replay->current_frame++;
     replay->current_time += delta_time;
@@ -370,8 +578,17 @@ bool agentite_replay_create_snapshot(Agentite_ReplaySystem *replay,
 
     ReplaySnapshot snapshot;
     snapshot.frame_number = replay->current_frame;
+    snapshot.time = replay->current_time;
     snapshot.data = data;
     snapshot.size = size;
+    snapshot.file_offset = 0;
+
+    if (replay->stream && replay->state == AGENTITE_REPLAY_RECORDING &&
+        !stream_write_snapshot(replay, &snapshot)) {
+        free_snapshot(&snapshot);
+        agentite_set_error("replay: failed to write snapshot to stream");
+        return false;
+    }
 
     replay->snapshots.push_back(snapshot);
     replay->frames_since_snapshot = 0;
@@ -383,40 +600,107 @@ bool agentite_replay_create_snapshot(Agentite_ReplaySystem *replay,
  * File I/O
  *============================================================================*/
 
-/* Binary format helpers */
-
-static bool write_uint8(FILE *fp, uint8_t val) {
-    return fwrite(&val, 1, 1, fp) == 1;
-}
+/* Byte buffer encoding */
 
-static bool write_uint16(FILE *fp, uint16_t val) {
-    return fwrite(&val, sizeof(val), 1, fp) == 1;
+static void put_bytes(std::vector<uint8_t> &out, const void *data, size_t size) {
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    out.insert(out.end(), p, p + size);
 }
 
-static bool write_uint32(FILE *fp, uint32_t val) {
-    return fwrite(&val, sizeof(val), 1, fp) == 1;
+static void put_u8(std::vector<uint8_t> &out, uint8_t val) {
+    out.push_back(val);
 }
 
-static bool write_uint64(FILE *fp, uint64_t val) {
-    return fwrite(&val, sizeof(val), 1, fp) == 1;
+static void put_u32(std::vector<uint8_t> &out, uint32_t val) {
+    put_bytes(out, &val, sizeof(val));
 }
 
-static bool write_int32(FILE *fp, int32_t val) {
-    return fwrite(&val, sizeof(val), 1, fp) == 1;
+static void put_u64(std::vector<uint8_t> &out, uint64_t val) {
+    put_bytes(out, &val, sizeof(val));
 }
 
-static bool write_float(FILE *fp, float val) {
-    return fwrite(&val, sizeof(val), 1, fp) == 1;
+static void put_f32(std::vector<uint8_t> &out, float val) {
+    put_bytes(out, &val, sizeof(val));
 }
 
-static bool write_string(FILE *fp, const char *str, size_t max_len) {
+static void put_string(std::vector<uint8_t> &out, const char *str, size_t max_len) {
     char buf[256] = {0};
     if (str) {
         strncpy(buf, str, max_len - 1);
     }
-    return fwrite(buf, 1, max_len, fp) == max_len;
+    put_bytes(out, buf, max_len);
+}
+
+/** LEB128 varint: 7 bits per byte, high bit set on all but the last */
+static void put_varint(std::vector<uint8_t> &out, uint64_t val) {
+    while (val >= 0x80) {
+        out.push_back((uint8_t)(val | 0x80));
+        val >>= 7;
+    }
+    out.push_back((uint8_t)val);
+}
+
+/** Zigzag maps small negative values to small varints */
+static void put_svarint(std::vector<uint8_t> &out, int64_t val) {
+    put_varint(out, ((uint64_t)val << 1) ^ (uint64_t)(val >> 63));
+}
+
+/* Bounds-checked byte buffer decoding; any overrun clears ok */
+
+struct ByteReader {
+    const uint8_t *p;
+    const uint8_t *end;
+    bool ok;
+};
+
+static bool get_bytes(ByteReader *r, void *out, size_t size) {
+    if (!r->ok || (size_t)(r->end - r->p) < size) {
+        r->ok = false;
+        return false;
+    }
+    memcpy(out, r->p, size);
+    r->p += size;
+    return true;
+}
+
+static uint8_t get_u8(ByteReader *r) {
+    uint8_t val = 0;
+    get_bytes(r, &val, sizeof(val));
+    return val;
+}
+
+static float get_f32(ByteReader *r) {
+    float val = 0.0f;
+    get_bytes(r, &val, sizeof(val));
+    return val;
+}
+
+static double get_f64(ByteReader *r) {
+    double val = 0.0;
+    get_bytes(r, &val, sizeof(val));
+    return val;
+}
+
+static uint64_t get_varint(ByteReader *r) {
+    uint64_t val = 0;
+    for (int shift = 0; shift < 64 && r->ok && r->p < r->end; shift += 7) {
+        uint8_t byte = *r->p++;
+        val |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return val;
+        }
+    }
+    r->ok = false;
+    return 0;
+}
+
+static int64_t get_svarint(ByteReader *r) {
+    uint64_t val = get_varint(r);
+    return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
 }
 
+/* FILE helpers for fixed-width header fields */
+
 static bool read_uint8(FILE *fp, uint8_t *val) {
     return fread(val, 1, 1, fp) == 1;
 }
@@ -442,46 +726,960 @@ static bool read_float(FILE *fp, float *val) {
 }
 
 static bool read_string(FILE *fp, char *str, size_t max_len) {
-    return fread(str, 1, max_len, fp) == max_len;
+    if (fread(str, 1, max_len, fp) != max_len) {
+        return false;
+    }
+    str[max_len - 1] = '\0';
+    return true;
 }
 
-static bool write_param(FILE *fp, const Agentite_CommandParam *param) {
-    /* Key length + key */
-    uint8_t key_len = (uint8_t)strlen(param->key);
-    if (!write_uint8(fp, key_len)) return false;
-    if (key_len > 0 && fwrite(param->key, 1, key_len, fp) != key_len) return false;
+/**
+ * Read the metadata header shared by all versions. For v2+ files also
+ * returns the index offset.
+ */
+static bool read_header(FILE *fp, Agentite_ReplayMetadata *meta, uint64_t *out_index_offset) {
+    memset(meta, 0, sizeof(*meta));
+    *out_index_offset = 0;
 
-    /* Type */
-    if (!write_uint8(fp, (uint8_t)param->type)) return false;
+    if (!read_uint32(fp, &meta->magic)) {
+        agentite_set_error("replay: failed to read file header");
+        return false;
+    }
+    if (meta->magic != AGENTITE_REPLAY_MAGIC) {
+        agentite_set_error("replay: invalid file format (bad magic)");
+        return false;
+    }
+
+    bool success = true;
+    success = success && read_int32(fp, &meta->version);
+    success = success && read_int32(fp, &meta->min_compatible_version);
+    success = success && read_string(fp, meta->timestamp, AGENTITE_REPLAY_MAX_TIMESTAMP);
+    success = success && read_string(fp, meta->game_version,
+                                     AGENTITE_REPLAY_MAX_VERSION_STRING);
+    success = success && read_string(fp, meta->map_name, AGENTITE_REPLAY_MAX_MAP_NAME);
+    success = success && read_uint64(fp, &meta->total_frames);
+    success = success && read_float(fp, &meta->total_duration);
+    success = success && read_uint32(fp, &meta->random_seed);
+    success = success && read_int32(fp, &meta->player_count);
+
+    if (success && meta->version >= 2) {
+        uint32_t flags;
+        success = read_uint32(fp, &flags) && read_uint64(fp, out_index_offset);
+    }
+
+    if (!success) {
+        agentite_set_error("replay: failed to read file header");
+        return false;
+    }
+
+    if (meta->version < AGENTITE_REPLAY_MIN_VERSION) {
+        agentite_set_error("replay: file version %d too old (min %d)",
+                           meta->version, AGENTITE_REPLAY_MIN_VERSION);
+        return false;
+    }
+    if (meta->min_compatible_version > AGENTITE_REPLAY_VERSION) {
+        agentite_set_error("replay: file requires replay version %d (have %d)",
+                           meta->min_compatible_version, AGENTITE_REPLAY_VERSION);
+        return false;
+    }
+
+    return true;
+}
+
+/* Blocks */
+
+/** Read and decompress the block at offset, which must be of the given kind */
+static bool read_block(FILE *fp, uint64_t offset, uint8_t kind, std::vector<uint8_t> &out) {
+    uint8_t header[k_block_header_size];
+    if (fseek(fp, (long)offset, SEEK_SET) != 0 ||
+        fread(header, 1, sizeof(header), fp) != sizeof(header)) {
+        return false;
+    }
+
+    uint32_t raw_size, stored_size;
+    memcpy(&raw_size, header + 4, sizeof(raw_size));
+    memcpy(&stored_size, header + 8, sizeof(stored_size));
+    bool compressed = (header[1] & REPLAY_BLOCK_COMPRESSED) != 0;
+
+    if (header[0] != kind || raw_size > k_max_block_size || stored_size > k_max_block_size ||
+        (!compressed && stored_size != raw_size)) {
+        return false;
+    }
+
+    out.resize(raw_size);
+    if (!compressed) {
+        return raw_size == 0 || fread(out.data(), 1, raw_size, fp) == raw_size;
+    }
+
+    std::vector<uint8_t> packed(stored_size);
+    return fread(packed.data(), 1, stored_size, fp) == stored_size &&
+           agentite_lz_decompress(packed.data(), stored_size, out.data(), raw_size);
+}
+
+/** Block output, either straight to a file or through a recording stream */
+struct ReplayFileWriter {
+    FILE *fp;
+    ReplayStream *stream;
+    uint64_t offset;
+    bool compress;
+    bool ok;
+    std::vector<uint8_t> packed;
+};
+
+/* Streaming
+ *
+ * Recording: finished blocks are appended to a fixed-size byte ring that a
+ * worker thread drains to the file in order. The main thread only waits
+ * when the ring is full.
+ *
+ * Playback: the worker reads and decompresses frame blocks ahead of the one
+ * being played until the read-ahead budget is used. Fetching a block that
+ * was not read ahead (a seek) restarts the read-ahead from there.
+ */
+
+struct ReplayReadAhead {
+    size_t block;
+    bool ok;
+    std::vector<uint8_t> data;
+};
+
+struct ReplayStream {
+    FILE *fp;
+    bool writing;
+    SDL_Thread *worker;
+    SDL_Mutex *mutex;
+    SDL_Condition *work_cond;       /* Worker: bytes to write, blocks to read, or shutdown */
+    SDL_Condition *done_cond;       /* Main thread: ring space freed or block ready */
+    bool shutdown;
+    bool failed;
+
+    /* Recording */
+    ReplayFileWriter writer;
+    uint8_t *ring;
+    size_t ring_capacity;
+    uint64_t ring_head;             /* Total bytes pushed */
+    uint64_t ring_tail;             /* Total bytes written */
+
+    /* Playback */
+    std::vector<uint64_t> block_offsets;
+    size_t next_read;               /* Next block the worker reads */
+    size_t next_expected;           /* Next block the main thread is expected to take */
+    uint32_t generation;
+    std::deque<ReplayReadAhead> ready;
+    size_t ready_bytes;
+    size_t budget;
+};
+
+static void stream_write_loop(ReplayStream *s) {
+    SDL_LockMutex(s->mutex);
+    for (;;) {
+        while (s->ring_head == s->ring_tail && !s->shutdown) {
+            SDL_WaitCondition(s->work_cond, s->mutex);
+        }
+        if (s->ring_head == s->ring_tail) {
+            break;  /* Shut down and fully drained */
+        }
+
+        size_t start = (size_t)(s->ring_tail % s->ring_capacity);
+        size_t count = (size_t)std::min<uint64_t>(s->ring_head - s->ring_tail,
+                                                  s->ring_capacity - start);
+        bool failed = s->failed;
+        SDL_UnlockMutex(s->mutex);
+
+        /* The main thread never writes between tail and head */
+        bool ok = failed || fwrite(s->ring + start, 1, count, s->fp) == count;
+
+        SDL_LockMutex(s->mutex);
+        s->ring_tail += count;
+        if (!ok) {
+            s->failed = true;
+        }
+        SDL_SignalCondition(s->done_cond);
+    }
+    SDL_UnlockMutex(s->mutex);
+}
+
+static void stream_read_loop(ReplayStream *s) {
+    SDL_LockMutex(s->mutex);
+    for (;;) {
+        while (!s->shutdown && (s->next_read >= s->block_offsets.size() ||
+                                s->ready_bytes >= s->budget)) {
+            SDL_WaitCondition(s->work_cond, s->mutex);
+        }
+        if (s->shutdown) {
+            break;
+        }
+
+        ReplayReadAhead entry;
+        entry.block = s->next_read++;
+        uint32_t generation = s->generation;
+        uint64_t offset = s->block_offsets[entry.block];
+        SDL_UnlockMutex(s->mutex);
+
+        entry.ok = read_block(s->fp, offset, REPLAY_BLOCK_FRAMES, entry.data);
+
+        SDL_LockMutex(s->mutex);
+        if (generation == s->generation) {
+            s->ready_bytes += entry.data.size();
+            s->ready.push_back(std::move(entry));
+            SDL_SignalCondition(s->done_cond);
+        }
+    }
+    SDL_UnlockMutex(s->mutex);
+}
+
+static int stream_worker_func(void *data) {
+    ReplayStream *s = static_cast<ReplayStream *>(data);
+    if (s->writing) {
+        stream_write_loop(s);
+    } else {
+        stream_read_loop(s);
+    }
+    return 0;
+}
+
+/** Stop the worker; a recording worker first drains the ring to disk */
+static bool stream_stop(ReplayStream *s) {
+    if (s->worker) {
+        SDL_LockMutex(s->mutex);
+        s->shutdown = true;
+        SDL_BroadcastCondition(s->work_cond);
+        SDL_UnlockMutex(s->mutex);
+        SDL_WaitThread(s->worker, nullptr);
+        s->worker = nullptr;
+    }
+    return !s->failed;
+}
+
+static void stream_destroy(ReplayStream *s) {
+    if (!s) {
+        return;
+    }
+    stream_stop(s);
+    if (s->fp) fclose(s->fp);
+    free(s->ring);
+    if (s->done_cond) SDL_DestroyCondition(s->done_cond);
+    if (s->work_cond) SDL_DestroyCondition(s->work_cond);
+    if (s->mutex) SDL_DestroyMutex(s->mutex);
+    delete s;
+}
+
+/**
+ * Open a stream on filepath. Recording streams own a ring of memory_limit
+ * bytes; playback streams read ahead up to memory_limit bytes of blocks.
+ */
+static ReplayStream *stream_create(const char *filepath, bool writing, size_t memory_limit,
+                                   bool compress) {
+    ReplayStream *s = new (std::nothrow) ReplayStream();
+    if (!s) {
+        agentite_set_error("replay: failed to allocate stream");
+        return nullptr;
+    }
+
+    s->writing = writing;
+    s->fp = fopen(filepath, writing ? "wb" : "rb");
+    if (!s->fp) {
+        agentite_set_error("replay: failed to open file: %s", filepath);
+        stream_destroy(s);
+        return nullptr;
+    }
+
+    if (writing) {
+        s->ring_capacity = memory_limit;
+        s->ring = static_cast<uint8_t *>(malloc(memory_limit));
+        s->writer.fp = nullptr;
+        s->writer.stream = s;
+        s->writer.offset = 0;
+        s->writer.compress = compress;
+        s->writer.ok = true;
+    } else {
+        s->budget = memory_limit;
+    }
+
+    s->mutex = SDL_CreateMutex();
+    s->work_cond = SDL_CreateCondition();
+    s->done_cond = SDL_CreateCondition();
+    if ((writing && !s->ring) || !s->mutex || !s->work_cond || !s->done_cond) {
+        agentite_set_error("replay: failed to create stream");
+        stream_destroy(s);
+        return nullptr;
+    }
+    return s;
+}
+
+static bool stream_start(ReplayStream *s) {
+    s->worker = SDL_CreateThread(stream_worker_func, "AgentiteReplay", s);
+    if (!s->worker) {
+        agentite_set_error("replay: failed to start stream thread: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+/** Append bytes to the recording ring, waiting for the worker when it is full */
+static bool stream_push(ReplayStream *s, const void *data, size_t size) {
+    const uint8_t *src = static_cast<const uint8_t *>(data);
+
+    SDL_LockMutex(s->mutex);
+    while (size > 0 && !s->failed) {
+        size_t used = (size_t)(s->ring_head - s->ring_tail);
+        if (used == s->ring_capacity) {
+            SDL_WaitCondition(s->done_cond, s->mutex);
+            continue;
+        }
+
+        size_t start = (size_t)(s->ring_head % s->ring_capacity);
+        size_t count = std::min(size, std::min(s->ring_capacity - used,
+                                               s->ring_capacity - start));
+        SDL_UnlockMutex(s->mutex);
+        memcpy(s->ring + start, src, count);
+        SDL_LockMutex(s->mutex);
+
+        s->ring_head += count;
+        src += count;
+        size -= count;
+        SDL_SignalCondition(s->work_cond);
+    }
+    bool ok = !s->failed;
+    SDL_UnlockMutex(s->mutex);
+    return ok;
+}
+
+/** Take a decompressed frame block, from the read-ahead queue if possible */
+static bool stream_fetch_block(ReplayStream *s, size_t block, std::vector<uint8_t> &out) {
+    if (block >= s->block_offsets.size()) {
+        return false;
+    }
+
+    SDL_LockMutex(s->mutex);
+
+    if (block < s->next_expected || block > s->next_read) {
+        /* Not part of the current read-ahead; restart it at this block */
+        s->generation++;
+        s->ready.clear();
+        s->ready_bytes = 0;
+        s->next_read = block;
+        SDL_SignalCondition(s->work_cond);
+    }
+
+    bool ok = false;
+    for (;;) {
+        /* Drop blocks the playback skipped */
+        while (!s->ready.empty() && s->ready.front().block < block) {
+            s->ready_bytes -= s->ready.front().data.size();
+            s->ready.pop_front();
+            SDL_SignalCondition(s->work_cond);
+        }
+        if (!s->ready.empty() && s->ready.front().block == block) {
+            ReplayReadAhead &entry = s->ready.front();
+            ok = entry.ok;
+            out.swap(entry.data);
+            s->ready_bytes -= out.size();
+            s->ready.pop_front();
+            s->next_expected = block + 1;
+            SDL_SignalCondition(s->work_cond);
+            break;
+        }
+        if (s->shutdown) {
+            break;
+        }
+        SDL_WaitCondition(s->done_cond, s->mutex);
+    }
+
+    SDL_UnlockMutex(s->mutex);
+    return ok;
+}
+
+static bool write_bytes(ReplayFileWriter *w, const void *data, size_t size) {
+    if (size == 0) {
+        return true;
+    }
+    if (w->stream) {
+        return stream_push(w->stream, data, size);
+    }
+    return fwrite(data, 1, size, w->fp) == size;
+}
+
+/**
+ * Write one block with a single header + payload write pair.
+ * Returns the block's file offset.
+ */
+static uint64_t write_block(ReplayFileWriter *w, uint8_t kind,
+                            const void *data, size_t size) {
+    uint64_t offset = w->offset;
+    if (!w->ok) {
+        return offset;
+    }
+    if (size > k_max_block_size) {
+        agentite_set_error("replay: block of %zu bytes exceeds format limit", size);
+        w->ok = false;
+        return offset;
+    }
+
+    const void *payload = data;
+    size_t stored = size;
+    uint8_t flags = 0;
+
+    if (w->compress && size >= k_min_compress_size) {
+        w->packed.resize(agentite_lz_compress_bound(size));
+        size_t n = agentite_lz_compress(data, size, w->packed.data(), w->packed.size());
+        if (n > 0 && n < size) {
+            payload = w->packed.data();
+            stored = n;
+            flags |= REPLAY_BLOCK_COMPRESSED;
+        }
+    }
+
+    uint8_t header[k_block_header_size] = {0};
+    uint32_t raw_size = (uint32_t)size;
+    uint32_t stored_size = (uint32_t)stored;
+    header[0] = kind;
+    header[1] = flags;
+    memcpy(header + 4, &raw_size, sizeof(raw_size));
+    memcpy(header + 8, &stored_size, sizeof(stored_size));
+
+    w->ok = write_bytes(w, header, sizeof(header)) && write_bytes(w, payload, stored);
+    w->offset += sizeof(header) + stored;
+    return offset;
+}
+
+/* Frame blocks */
+
+static uint32_t float_bits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static void encode_command(const Agentite_ReplaySystem *replay, const ReplayCommand &cmd,
+                           uint32_t *prev_sequence, std::vector<uint8_t> &out) {
+    put_svarint(out, cmd.type);
+    put_svarint(out, (int64_t)cmd.sequence - (int64_t)*prev_sequence);
+    put_svarint(out, cmd.source_faction);
+    put_varint(out, cmd.param_count);
+    *prev_sequence = cmd.sequence;
+
+    for (uint32_t i = 0; i < cmd.param_count; i++) {
+        const ReplayParam &p = replay->params[cmd.first_param + i];
+        put_varint(out, p.key);
+        put_u8(out, p.type);
+
+        switch (p.type) {
+            case AGENTITE_CMD_PARAM_INT:    put_svarint(out, p.i32); break;
+            case AGENTITE_CMD_PARAM_INT64:  put_svarint(out, p.i64); break;
+            case AGENTITE_CMD_PARAM_FLOAT:  put_f32(out, p.f32); break;
+            case AGENTITE_CMD_PARAM_DOUBLE: put_bytes(out, &p.f64, sizeof(p.f64)); break;
+            case AGENTITE_CMD_PARAM_BOOL:   put_u8(out, p.b ? 1 : 0); break;
+            case AGENTITE_CMD_PARAM_ENTITY: put_varint(out, p.entity); break;
+            case AGENTITE_CMD_PARAM_STRING: put_varint(out, p.str); break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * Encode frames [begin, limit) of the resident window into out, stopping
+ * early once the block reaches k_frame_block_target bytes or
+ * k_frame_block_max_frames frames. Each entry starts with a varint
+ * (count << 2 | dt_changed << 1 | is_run):
+ *   run:   count consecutive empty frames sharing one delta time
+ *   frame: one frame with count commands
+ * followed by the f32 delta time when it differs from the previous entry.
+ * Delta time and sequence state reset per block so blocks decode alone.
+ *
+ * @return End of the encoded range
+ */
+static uint64_t encode_frames(const Agentite_ReplaySystem *replay, uint64_t begin,
+                              uint64_t limit, std::vector<uint8_t> &out) {
+    uint32_t prev_dt_bits = 0;
+    uint32_t prev_sequence = 0;
+    uint64_t i = begin;
+
+    if (limit - begin > k_frame_block_max_frames) {
+        limit = begin + k_frame_block_max_frames;
+    }
+
+    while (i < limit && out.size() < k_frame_block_target) {
+        const ReplayFrame &frame = replay->frames[i];
+        uint32_t dt_bits = float_bits(frame.delta_time);
+        uint64_t dt_changed = dt_bits != prev_dt_bits ? 1 : 0;
+
+        if (frame.command_count == 0) {
+            uint64_t run = 1;
+            while (i + run < limit && run < UINT32_MAX &&
+                   replay->frames[i + run].command_count == 0 &&
+                   float_bits(replay->frames[i + run].delta_time) == dt_bits) {
+                run++;
+            }
+            put_varint(out, (run << 2) | (dt_changed << 1) | 1);
+            if (dt_changed) put_f32(out, frame.delta_time);
+            i += run;
+        } else {
+            put_varint(out, ((uint64_t)frame.command_count << 2) | (dt_changed << 1));
+            if (dt_changed) put_f32(out, frame.delta_time);
+            for (uint32_t c = 0; c < frame.command_count; c++) {
+                encode_command(replay, replay->commands[frame.first_command + c],
+                               &prev_sequence, out);
+            }
+            i++;
+        }
+
+        prev_dt_bits = dt_bits;
+    }
+
+    return i;
+}
+
+static bool decode_command(Agentite_ReplaySystem *replay, ByteReader *r,
+                           uint32_t *prev_sequence) {
+    ReplayCommand cmd;
+    cmd.type = (int32_t)get_svarint(r);
+    cmd.sequence = (uint32_t)((int64_t)*prev_sequence + get_svarint(r));
+    cmd.source_faction = (int32_t)get_svarint(r);
+    uint64_t param_count = get_varint(r);
+    *prev_sequence = cmd.sequence;
+
+    if (!r->ok || param_count > AGENTITE_COMMAND_MAX_PARAMS) {
+        return false;
+    }
+    cmd.first_param = (uint32_t)replay->params.size();
+    cmd.param_count = (uint32_t)param_count;
+
+    for (uint64_t i = 0; i < param_count; i++) {
+        ReplayParam p;
+        p.i64 = 0;
+        uint64_t key = get_varint(r);
+        p.key = (uint32_t)key;
+        p.type = get_u8(r);
+
+        switch (p.type) {
+            case AGENTITE_CMD_PARAM_NONE:   break;
+            case AGENTITE_CMD_PARAM_INT:    p.i32 = (int32_t)get_svarint(r); break;
+            case AGENTITE_CMD_PARAM_INT64:  p.i64 = get_svarint(r); break;
+            case AGENTITE_CMD_PARAM_FLOAT:  p.f32 = get_f32(r); break;
+            case AGENTITE_CMD_PARAM_DOUBLE: p.f64 = get_f64(r); break;
+            case AGENTITE_CMD_PARAM_BOOL:   p.b = get_u8(r) != 0; break;
+            case AGENTITE_CMD_PARAM_ENTITY: p.entity = (uint32_t)get_varint(r); break;
+            case AGENTITE_CMD_PARAM_STRING: {
+                uint64_t str = get_varint(r);
+                if (str >= replay->strings.size()) return false;
+                p.str = (uint32_t)str;
+                break;
+            }
+            default:
+                return false;
+        }
+
+        if (!r->ok || key >= replay->strings.size()) {
+            return false;
+        }
+        replay->params.push_back(p);
+    }
+
+    replay->commands.push_back(cmd);
+    return true;
+}
+
+/** Decode a frame block that must hold exactly frame_count frames */
+static bool decode_frames(Agentite_ReplaySystem *replay, const std::vector<uint8_t> &data,
+                          uint64_t frame_count) {
+    ByteReader r = { data.data(), data.data() + data.size(), true };
+    uint64_t decoded = 0;
+    float delta_time = 0.0f;
+    uint32_t prev_sequence = 0;
+
+    while (r.ok && r.p < r.end) {
+        uint64_t entry = get_varint(&r);
+        uint64_t count = entry >> 2;
+        if (entry & 2) {
+            delta_time = get_f32(&r);
+        }
+        if (!r.ok || count == 0) {
+            return false;
+        }
+
+        if (entry & 1) {
+            if (count > frame_count - decoded) {
+                return false;
+            }
+            ReplayFrame frame = { delta_time, (uint32_t)replay->commands.size(), 0 };
+            replay->frames.insert(replay->frames.end(), (size_t)count, frame);
+            decoded += count;
+        } else {
+            if (decoded >= frame_count || count > UINT32_MAX) {
+                return false;
+            }
+            ReplayFrame frame = { delta_time, (uint32_t)replay->commands.size(),
+                                  (uint32_t)count };
+            for (uint64_t c = 0; c < count; c++) {
+                if (!decode_command(replay, &r, &prev_sequence)) {
+                    return false;
+                }
+            }
+            replay->frames.push_back(frame);
+            decoded++;
+        }
+    }
+
+    return r.ok && decoded == frame_count;
+}
+
+/* Snapshots */
+
+static bool snapshot_available(const ReplaySnapshot &snapshot) {
+    return snapshot.size > 0 && (snapshot.data || snapshot.file_offset > 0);
+}
+
+/** Read an on-disk snapshot's block from the file the replay was loaded from */
+static bool read_snapshot(const Agentite_ReplaySystem *replay,
+                          const ReplaySnapshot &snapshot,
+                          std::vector<uint8_t> &out) {
+    FILE *fp = fopen(replay->source_path, "rb");
+    if (!fp) {
+        agentite_set_error("replay: failed to open file: %s", replay->source_path);
+        return false;
+    }
+    bool success = read_block(fp, snapshot.file_offset, REPLAY_BLOCK_SNAPSHOT, out) &&
+                   out.size() == snapshot.size;
+    fclose(fp);
+
+    if (!success) {
+        agentite_set_error("replay: failed to read snapshot at frame %llu",
+                           (unsigned long long)snapshot.frame_number);
+    }
+    return success;
+}
+
+/* File sections shared by saving and streamed recording */
+
+static void encode_header(const Agentite_ReplaySystem *replay, std::vector<uint8_t> &out) {
+    put_u32(out, AGENTITE_REPLAY_MAGIC);
+    put_u32(out, (uint32_t)AGENTITE_REPLAY_VERSION);
+    put_u32(out, (uint32_t)AGENTITE_REPLAY_VERSION);
+    put_string(out, replay->metadata.timestamp, AGENTITE_REPLAY_MAX_TIMESTAMP);
+    put_string(out, replay->metadata.game_version, AGENTITE_REPLAY_MAX_VERSION_STRING);
+    put_string(out, replay->metadata.map_name, AGENTITE_REPLAY_MAX_MAP_NAME);
+    put_u64(out, replay->metadata.total_frames);
+    put_f32(out, replay->metadata.total_duration);
+    put_u32(out, replay->metadata.random_seed);
+    put_u32(out, (uint32_t)replay->metadata.player_count);
+    put_u32(out, replay->config.compress ? REPLAY_BLOCK_COMPRESSED : 0);
+    put_u64(out, 0);  /* Index offset, patched once the index is written */
+}
+
+/**
+ * Write frames [begin, limit) of the resident window as one or more frame
+ * blocks, appending their index entries. time is the playback time at begin
+ * and is advanced past the written frames.
+ */
+static void write_frame_blocks(const Agentite_ReplaySystem *replay, ReplayFileWriter *w,
+                               uint64_t begin, uint64_t limit, float *time,
+                               std::vector<ReplayBlockRef> &blocks,
+                               std::vector<uint8_t> &buf) {
+    uint64_t frame = begin;
+    while (frame < limit && w->ok) {
+        buf.clear();
+        uint64_t end = encode_frames(replay, frame, limit, buf);
+
+        ReplayBlockRef ref;
+        ref.first_frame = replay->frame_base + frame;
+        ref.frame_count = end - frame;
+        ref.start_time = *time;
+        ref.offset = write_block(w, REPLAY_BLOCK_FRAMES, buf.data(), buf.size());
+        blocks.push_back(ref);
+
+        for (; frame < end; frame++) {
+            *time += replay->frames[frame].delta_time;
+        }
+    }
+}
+
+/** Write the string table and the trailing index; returns the index offset */
+static uint64_t write_index(const Agentite_ReplaySystem *replay, ReplayFileWriter *w,
+                            uint64_t initial_offset,
+                            const std::vector<ReplayBlockRef> &blocks,
+                            const std::vector<ReplaySnapshot> &snapshots) {
+    std::vector<uint8_t> buf;
+    put_varint(buf, replay->strings.size());
+    for (const auto &str : replay->strings) {
+        put_varint(buf, str.size());
+        put_bytes(buf, str.data(), str.size());
+    }
+    uint64_t strings_offset = write_block(w, REPLAY_BLOCK_STRINGS, buf.data(), buf.size());
+
+    buf.clear();
+    put_varint(buf, strings_offset);
+    put_varint(buf, initial_offset);
+
+    put_varint(buf, blocks.size());
+    for (const auto &block : blocks) {
+        put_varint(buf, block.frame_count);
+        put_f32(buf, block.start_time);
+        put_varint(buf, block.offset);
+    }
+
+    /* Snapshot frame numbers are delta-encoded */
+    put_varint(buf, snapshots.size());
+    uint64_t prev_frame = 0;
+    for (const auto &snapshot : snapshots) {
+        put_varint(buf, snapshot.frame_number - prev_frame);
+        put_f32(buf, snapshot.time);
+        put_varint(buf, snapshot.file_offset);
+        put_varint(buf, snapshot.size);
+        prev_frame = snapshot.frame_number;
+    }
+
+    return write_block(w, REPLAY_BLOCK_INDEX, buf.data(), buf.size());
+}
+
+static bool patch_header(FILE *fp, const Agentite_ReplayMetadata *meta, uint64_t index_offset) {
+    return fseek(fp, k_header_total_frames_offset, SEEK_SET) == 0 &&
+           fwrite(&meta->total_frames, sizeof(meta->total_frames), 1, fp) == 1 &&
+           fwrite(&meta->total_duration, sizeof(meta->total_duration), 1, fp) == 1 &&
+           fseek(fp, k_header_index_offset, SEEK_SET) == 0 &&
+           fwrite(&index_offset, sizeof(index_offset), 1, fp) == 1;
+}
+
+/** Byte copy of a streamed replay's source file */
+static bool copy_file(const char *src_path, const char *dst_path) {
+    FILE *src = fopen(src_path, "rb");
+    if (!src) {
+        return false;
+    }
+    FILE *dst = fopen(dst_path, "wb");
+    if (!dst) {
+        fclose(src);
+        return false;
+    }
+
+    std::vector<uint8_t> buf(64 * 1024);
+    bool ok = true;
+    size_t n;
+    while (ok && (n = fread(buf.data(), 1, buf.size(), src)) > 0) {
+        ok = fwrite(buf.data(), 1, n, dst) == n;
+    }
+    ok = ok && !ferror(src);
+
+    fclose(src);
+    return (fclose(dst) == 0) && ok;
+}
+
+bool agentite_replay_save(const Agentite_ReplaySystem *replay,
+                           const char *filepath) {
+    AGENTITE_VALIDATE_PTR_RET(replay, false);
+    AGENTITE_VALIDATE_PTR_RET(filepath, false);
+
+    if (replay->total_frames == 0) {
+        agentite_set_error("replay: no frames to save");
+        return false;
+    }
+    if (replay->source_path[0] && strcmp(filepath, replay->source_path) == 0) {
+        agentite_set_error("replay: cannot overwrite the file snapshots are read from");
+        return false;
+    }
+
+    if (replay->stream) {
+        if (replay->stream->writing) {
+            agentite_set_error("replay: cannot save while a streamed recording is running");
+            return false;
+        }
+        /* Streamed replays are already complete on disk */
+        if (!copy_file(replay->source_path, filepath)) {
+            agentite_set_error("replay: failed to write replay file");
+            remove(filepath);
+            return false;
+        }
+        return true;
+    }
+
+    FILE *fp = fopen(filepath, "wb");
+    if (!fp) {
+        agentite_set_error("replay: failed to open file for writing: %s", filepath);
+        return false;
+    }
+
+    ReplayFileWriter w;
+    w.fp = fp;
+    w.stream = nullptr;
+    w.offset = 0;
+    w.compress = replay->config.compress;
+    w.ok = true;
+
+    std::vector<uint8_t> buf;
+    encode_header(replay, buf);
+    w.ok = write_bytes(&w, buf.data(), buf.size());
+    w.offset = buf.size();
+
+    uint64_t initial_offset = 0;
+    if (replay->initial_state_size > 0 && replay->initial_state_data) {
+        initial_offset = write_block(&w, REPLAY_BLOCK_INITIAL_STATE,
+                                     replay->initial_state_data, replay->initial_state_size);
+    }
+
+    /* Frame blocks, split at every snapshot so seeks start on a block */
+    std::vector<ReplayBlockRef> blocks;
+    uint64_t frame = 0;
+    size_t next_snapshot = 0;
+    float time = 0.0f;
+    while (frame < replay->frames.size() && w.ok) {
+        while (next_snapshot < replay->snapshots.size() &&
+               replay->snapshots[next_snapshot].frame_number <= frame) {
+            next_snapshot++;
+        }
+        uint64_t limit = next_snapshot < replay->snapshots.size()
+            ? std::min<uint64_t>(replay->snapshots[next_snapshot].frame_number,
+                                 replay->frames.size())
+            : replay->frames.size();
+
+        write_frame_blocks(replay, &w, frame, limit, &time, blocks, buf);
+        frame = limit;
+    }
+
+    /* Snapshot blocks */
+    std::vector<ReplaySnapshot> written;
+    for (const auto &snapshot : replay->snapshots) {
+        if (!w.ok) break;
+        if (!snapshot_available(snapshot)) continue;
+
+        ReplaySnapshot entry = snapshot;
+        entry.data = nullptr;
+        if (snapshot.data) {
+            entry.file_offset = write_block(&w, REPLAY_BLOCK_SNAPSHOT,
+                                            snapshot.data, snapshot.size);
+        } else if (read_snapshot(replay, snapshot, buf)) {
+            entry.file_offset = write_block(&w, REPLAY_BLOCK_SNAPSHOT, buf.data(), buf.size());
+        } else {
+            w.ok = false;
+            break;
+        }
+        written.push_back(entry);
+    }
+
+    uint64_t index_offset = write_index(replay, &w, initial_offset, blocks, written);
+
+    if (w.ok) {
+        w.ok = fseek(fp, k_header_index_offset, SEEK_SET) == 0 &&
+               fwrite(&index_offset, sizeof(index_offset), 1, fp) == 1;
+    }
+
+    bool success = (fclose(fp) == 0) && w.ok;
+
+    if (!success) {
+        agentite_set_error("replay: failed to write replay file");
+        remove(filepath);
+    }
+
+    return success;
+}
+
+/* Streamed recording */
+
+/** Move the resident frames to disk, keeping commands for the next frame */
+static bool stream_flush_frames(Agentite_ReplaySystem *replay) {
+    ReplayStream *s = replay->stream;
+    if (!replay->frames.empty()) {
+        write_frame_blocks(replay, &s->writer, 0, replay->frames.size(),
+                           &replay->window_start_time, replay->blocks, replay->block_buffer);
+        replay->frame_base += replay->frames.size();
+        replay->frames.clear();
+    }
+
+    /* Rebase commands recorded since the last frame to the start of the pools */
+    size_t keep = replay->pending_first_command;
+    uint32_t first_param = keep < replay->commands.size()
+        ? replay->commands[keep].first_param : (uint32_t)replay->params.size();
+    replay->commands.erase(replay->commands.begin(), replay->commands.begin() + keep);
+    replay->params.erase(replay->params.begin(), replay->params.begin() + first_param);
+    for (auto &cmd : replay->commands) {
+        cmd.first_param -= first_param;
+    }
+    replay->pending_first_command = 0;
+
+    return s->writer.ok;
+}
+
+static bool stream_begin_recording(Agentite_ReplaySystem *replay, const char *filepath) {
+    size_t limit = replay->config.stream_memory_limit;
+    if (limit == 0) limit = AGENTITE_REPLAY_DEFAULT_STREAM_MEMORY;
+    if (limit < k_stream_min_memory) limit = k_stream_min_memory;
+
+    ReplayStream *s = stream_create(filepath, true, limit, replay->config.compress);
+    if (!s) {
+        return false;
+    }
+
+    std::vector<uint8_t> buf;
+    encode_header(replay, buf);
+    write_bytes(&s->writer, buf.data(), buf.size());
+    s->writer.offset = buf.size();
+
+    if (!stream_start(s)) {
+        stream_destroy(s);
+        remove(filepath);
+        return false;
+    }
+    replay->stream = s;
+
+    /* The initial state goes straight to disk */
+    if (replay->initial_state_data) {
+        replay->stream_initial_offset = write_block(&s->writer, REPLAY_BLOCK_INITIAL_STATE,
+                                                    replay->initial_state_data,
+                                                    replay->initial_state_size);
+        free(replay->initial_state_data);
+        replay->initial_state_data = nullptr;
+        replay->initial_state_size = 0;
+    }
+
+    strncpy(replay->source_path, filepath, sizeof(replay->source_path) - 1);
+    replay->source_path[sizeof(replay->source_path) - 1] = '\0';
+    return true;
+}
+
+/** Flush the resident frames and write a snapshot block in their place */
+static bool stream_write_snapshot(Agentite_ReplaySystem *replay, ReplaySnapshot *snapshot) {
+    if (!stream_flush_frames(replay)) {
+        return false;
+    }
+    snapshot->file_offset = write_block(&replay->stream->writer, REPLAY_BLOCK_SNAPSHOT,
+                                        snapshot->data, snapshot->size);
+    free(snapshot->data);
+    snapshot->data = nullptr;
+    return replay->stream->writer.ok;
+}
+
+static bool open_replay_file(Agentite_ReplaySystem *replay, const char *filepath, bool streamed);
 
-    /* Value based on type */
-    switch (param->type) {
-        case AGENTITE_CMD_PARAM_INT:
-            return write_int32(fp, param->i32);
-        case AGENTITE_CMD_PARAM_INT64:
-            return fwrite(&param->i64, sizeof(param->i64), 1, fp) == 1;
-        case AGENTITE_CMD_PARAM_FLOAT:
-            return write_float(fp, param->f32);
-        case AGENTITE_CMD_PARAM_DOUBLE:
-            return fwrite(&param->f64, sizeof(param->f64), 1, fp) == 1;
-        case AGENTITE_CMD_PARAM_BOOL:
-            return write_uint8(fp, param->b ? 1 : 0);
-        case AGENTITE_CMD_PARAM_ENTITY:
-            return write_uint32(fp, param->entity);
-        case AGENTITE_CMD_PARAM_STRING: {
-            uint8_t str_len = (uint8_t)strlen(param->str);
-            if (!write_uint8(fp, str_len)) return false;
-            if (str_len > 0 && fwrite(param->str, 1, str_len, fp) != str_len) return false;
-            return true;
-        }
-        case AGENTITE_CMD_PARAM_PTR:
-        case AGENTITE_CMD_PARAM_NONE:
-        default:
-            return true;
+/**
+ * Write the remaining frames and the index, wait for the worker to drain,
+ * then reopen the finished file as a streamed replay.
+ */
+static bool stream_finish_recording(Agentite_ReplaySystem *replay) {
+    ReplayStream *s = replay->stream;
+    char path[AGENTITE_REPLAY_MAX_PATH];
+    memcpy(path, replay->source_path, sizeof(path));
+
+    bool ok = stream_flush_frames(replay);
+    uint64_t index_offset = write_index(replay, &s->writer, replay->stream_initial_offset,
+                                        replay->blocks, replay->snapshots);
+    ok = stream_stop(s) && s->writer.ok && ok &&
+         patch_header(s->fp, &replay->metadata, index_offset);
+    ok = (fclose(s->fp) == 0) && ok;
+    s->fp = nullptr;
+    stream_destroy(s);
+    replay->stream = nullptr;
+
+    if (!ok) {
+        agentite_set_error("replay: failed to write streamed replay: %s", path);
+        agentite_replay_clear(replay);
+        return false;
     }
+
+    return open_replay_file(replay, path, true);
 }
 
-static bool read_param(FILE *fp, Agentite_CommandParam *param) {
+/* Version 1 loading (fixed-width fields, one fwrite per value) */
+
+static bool read_param_v1(FILE *fp, Agentite_CommandParam *param) {
     memset(param, 0, sizeof(*param));
 
     /* Key length + key */
@@ -494,6 +1692,7 @@ static bool read_param(FILE *fp, Agentite_CommandParam *param) {
         if (fread(param->key, 1, key_len, fp) != key_len) return false;
     }
     param->key[key_len] = '\0';
+    param->key_id = agentite_command_key(param->key);
 
     /* Type */
     uint8_t type;
@@ -537,22 +1736,7 @@ static bool read_param(FILE *fp, Agentite_CommandParam *param) {
     }
 }
 
-static bool write_command(FILE *fp, const ReplayCommand *cmd) {
-    if (!write_uint16(fp, (uint16_t)cmd->type)) return false;
-    if (!write_uint8(fp, (uint8_t)cmd->param_count)) return false;
-    if (!write_uint32(fp, cmd->sequence)) return false;
-    if (!write_int32(fp, cmd->source_faction)) return false;
-
-    for (int i = 0; i < cmd->param_count; i++) {
-        if (!write_param(fp, &cmd->params[i])) return false;
-    }
-
-    return true;
-}
-
-static bool read_command(FILE *fp, ReplayCommand *cmd) {
-    memset(cmd, 0, sizeof(*cmd));
-
+static bool read_command_v1(FILE *fp, Agentite_Command *cmd) {
     uint16_t type;
     if (!read_uint16(fp, &type)) return false;
     cmd->type = (int)type;
@@ -569,235 +1753,278 @@ static bool read_command(FILE *fp, ReplayCommand *cmd) {
     }
 
     for (int i = 0; i < cmd->param_count; i++) {
-        if (!read_param(fp, &cmd->params[i])) return false;
+        if (!read_param_v1(fp, &cmd->params[i])) return false;
     }
 
     return true;
 }
 
-bool agentite_replay_save(const Agentite_ReplaySystem *replay,
-                           const char *filepath) {
-    AGENTITE_VALIDATE_PTR_RET(replay, false);
-    AGENTITE_VALIDATE_PTR_RET(filepath, false);
+static bool load_v1(Agentite_ReplaySystem *replay, FILE *fp) {
+    bool success = fseek(fp, (long)k_header_size_v1, SEEK_SET) == 0;
 
-    if (replay->frames.empty()) {
-        agentite_set_error("replay: no frames to save");
-        return false;
+    /* Read initial state */
+    uint64_t initial_state_size = 0;
+    success = success && read_uint64(fp, &initial_state_size);
+    if (success && initial_state_size > 0) {
+        replay->initial_state_data = malloc((size_t)initial_state_size);
+        if (!replay->initial_state_data) {
+            return false;
+        }
+        replay->initial_state_size = (size_t)initial_state_size;
+        success = (fread(replay->initial_state_data, 1,
+                         replay->initial_state_size, fp) == replay->initial_state_size);
     }
 
-    FILE *fp = fopen(filepath, "wb");
-    if (!fp) {
-        agentite_set_error("replay: failed to open file for writing: %s", filepath);
-        return false;
-    }
+    /* Read frames */
+    uint64_t frame_count = 0;
+    success = success && read_uint64(fp, &frame_count);
 
-    bool success = true;
+    for (uint64_t i = 0; i < frame_count && success; i++) {
+        uint64_t frame_number;
+        ReplayFrame frame;
+        uint32_t cmd_count = 0;
 
-    /* Write header/metadata */
-    success = success && write_uint32(fp, replay->metadata.magic);
-    success = success && write_int32(fp, replay->metadata.version);
-    success = success && write_int32(fp, replay->metadata.min_compatible_version);
-    success = success && write_string(fp, replay->metadata.timestamp,
-                                      AGENTITE_REPLAY_MAX_TIMESTAMP);
-    success = success && write_string(fp, replay->metadata.game_version,
-                                      AGENTITE_REPLAY_MAX_VERSION_STRING);
-    success = success && write_string(fp, replay->metadata.map_name,
-                                      AGENTITE_REPLAY_MAX_MAP_NAME);
-    success = success && write_uint64(fp, replay->metadata.total_frames);
-    success = success && write_float(fp, replay->metadata.total_duration);
-    success = success && write_uint32(fp, replay->metadata.random_seed);
-    success = success && write_int32(fp, replay->metadata.player_count);
-
-    /* Write initial state size and data */
-    success = success && write_uint64(fp, replay->initial_state_size);
-    if (success && replay->initial_state_size > 0 && replay->initial_state_data) {
-        success = (fwrite(replay->initial_state_data, 1,
-                          replay->initial_state_size, fp) == replay->initial_state_size);
-    }
-
-    /* Write frame count */
-    success = success && write_uint64(fp, replay->frames.size());
-
-    /* Write each frame */
-    for (const auto &frame : replay->frames) {
-        if (!success) break;
-
-        success = success && write_uint64(fp, frame.frame_number);
-        success = success && write_float(fp, frame.delta_time);
-        success = success && write_uint32(fp, (uint32_t)frame.commands.size());
-
-        for (const auto &cmd : frame.commands) {
-            if (!success) break;
-            success = write_command(fp, &cmd);
-        }
-    }
+        success = read_uint64(fp, &frame_number) &&
+                  read_float(fp, &frame.delta_time) &&
+                  read_uint32(fp, &cmd_count);
 
-    /* Write snapshot count */
-    success = success && write_uint32(fp, (uint32_t)replay->snapshots.size());
+        frame.first_command = (uint32_t)replay->commands.size();
+        frame.command_count = cmd_count;
 
-    /* Write snapshots */
-    for (const auto &snapshot : replay->snapshots) {
-        if (!success) break;
+        for (uint32_t j = 0; j < cmd_count && success; j++) {
+            Agentite_Command cmd;
+            success = read_command_v1(fp, &cmd);
+            if (success) {
+                copy_command_to_replay(replay, &cmd);
+            }
+        }
 
-        success = success && write_uint64(fp, snapshot.frame_number);
-        success = success && write_uint64(fp, snapshot.size);
-        if (success && snapshot.size > 0 && snapshot.data) {
-            success = (fwrite(snapshot.data, 1, snapshot.size, fp) == snapshot.size);
+        if (success) {
+            replay->frames.push_back(frame);
         }
     }
 
-    fclose(fp);
+    /* Read snapshots */
+    uint32_t snapshot_count = 0;
+    success = success && read_uint32(fp, &snapshot_count);
 
-    if (!success) {
-        agentite_set_error("replay: failed to write replay file");
-        remove(filepath);
-    }
+    for (uint32_t i = 0; i < snapshot_count && success; i++) {
+        ReplaySnapshot snapshot = {};
+        uint64_t snapshot_size = 0;
 
-    return success;
-}
+        success = read_uint64(fp, &snapshot.frame_number) &&
+                  read_uint64(fp, &snapshot_size);
+        snapshot.size = static_cast<size_t>(snapshot_size);
 
-bool agentite_replay_load(Agentite_ReplaySystem *replay,
-                           const char *filepath) {
-    AGENTITE_VALIDATE_PTR_RET(replay, false);
-    AGENTITE_VALIDATE_PTR_RET(filepath, false);
+        if (success && snapshot.size > 0) {
+            snapshot.data = malloc(snapshot.size);
+            success = snapshot.data &&
+                      fread(snapshot.data, 1, snapshot.size, fp) == snapshot.size;
+        }
 
-    if (replay->state != AGENTITE_REPLAY_IDLE) {
-        agentite_set_error("replay: cannot load while recording or playing");
-        return false;
+        if (success) {
+            replay->snapshots.push_back(snapshot);
+        } else {
+            free(snapshot.data);
+        }
     }
 
-    FILE *fp = fopen(filepath, "rb");
-    if (!fp) {
-        agentite_set_error("replay: failed to open file: %s", filepath);
+    if (!success) {
         return false;
     }
 
-    /* Clear existing data */
-    agentite_replay_clear(replay);
+    /* v1 files carry no snapshot times; derive them in one pass */
+    std::stable_sort(replay->snapshots.begin(), replay->snapshots.end(),
+                     [](const ReplaySnapshot &a, const ReplaySnapshot &b) {
+                         return a.frame_number < b.frame_number;
+                     });
+    float time = 0.0f;
+    replay->total_frames = replay->frames.size();
 
-    bool success = true;
+    uint64_t frame = 0;
+    for (auto &snapshot : replay->snapshots) {
+        for (; frame < snapshot.frame_number && frame < replay->frames.size(); frame++) {
+            time += replay->frames[frame].delta_time;
+        }
+        snapshot.time = time;
+    }
 
-    /* Read header/metadata */
-    success = success && read_uint32(fp, &replay->metadata.magic);
-    if (success && replay->metadata.magic != AGENTITE_REPLAY_MAGIC) {
-        agentite_set_error("replay: invalid file format (bad magic)");
-        fclose(fp);
+    return true;
+}
+
+/**
+ * Version 2 loading: read the trailing index, then the string table and
+ * initial state. Frame blocks are decoded now unless the replay is
+ * streamed. Snapshot blocks stay on disk until a seek needs one.
+ */
+static bool load_v2(Agentite_ReplaySystem *replay, FILE *fp, uint64_t index_offset,
+                    bool decode) {
+    std::vector<uint8_t> index;
+    std::vector<uint8_t> block;
+
+    if (index_offset < k_header_size || !read_block(fp, index_offset, REPLAY_BLOCK_INDEX, index)) {
         return false;
     }
 
-    success = success && read_int32(fp, &replay->metadata.version);
-    success = success && read_int32(fp, &replay->metadata.min_compatible_version);
+    ByteReader r = { index.data(), index.data() + index.size(), true };
+    uint64_t strings_offset = get_varint(&r);
+    uint64_t initial_offset = get_varint(&r);
 
-    if (success && replay->metadata.version < AGENTITE_REPLAY_MIN_VERSION) {
-        agentite_set_error("replay: file version %d too old (min %d)",
-                          replay->metadata.version, AGENTITE_REPLAY_MIN_VERSION);
-        fclose(fp);
+    /* String table */
+    if (!r.ok || !read_block(fp, strings_offset, REPLAY_BLOCK_STRINGS, block)) {
+        return false;
+    }
+    ByteReader sr = { block.data(), block.data() + block.size(), true };
+    uint64_t string_count = get_varint(&sr);
+    for (uint64_t i = 0; i < string_count && sr.ok; i++) {
+        uint64_t len = get_varint(&sr);
+        char str[AGENTITE_COMMAND_MAX_PARAM_KEY];
+        if (len >= sizeof(str) || !get_bytes(&sr, str, (size_t)len)) {
+            return false;
+        }
+        str[len] = '\0';
+        if (intern_string(replay, str) != i) {
+            return false;  /* Duplicate entry */
+        }
+    }
+    if (!sr.ok) {
         return false;
     }
 
-    success = success && read_string(fp, replay->metadata.timestamp,
-                                     AGENTITE_REPLAY_MAX_TIMESTAMP);
-    success = success && read_string(fp, replay->metadata.game_version,
-                                     AGENTITE_REPLAY_MAX_VERSION_STRING);
-    success = success && read_string(fp, replay->metadata.map_name,
-                                     AGENTITE_REPLAY_MAX_MAP_NAME);
-    success = success && read_uint64(fp, &replay->metadata.total_frames);
-    success = success && read_float(fp, &replay->metadata.total_duration);
-    success = success && read_uint32(fp, &replay->metadata.random_seed);
-    success = success && read_int32(fp, &replay->metadata.player_count);
-
-    /* Read initial state */
-    uint64_t initial_state_size;
-    success = success && read_uint64(fp, &initial_state_size);
-    if (success && initial_state_size > 0) {
-        replay->initial_state_data = malloc(initial_state_size);
+    /* Initial state */
+    if (initial_offset > 0) {
+        if (!read_block(fp, initial_offset, REPLAY_BLOCK_INITIAL_STATE, block) ||
+            block.empty()) {
+            return false;
+        }
+        replay->initial_state_data = malloc(block.size());
         if (!replay->initial_state_data) {
-            agentite_set_error("replay: failed to allocate initial state");
-            fclose(fp);
             return false;
         }
-        success = (fread(replay->initial_state_data, 1,
-                         initial_state_size, fp) == initial_state_size);
-        replay->initial_state_size = initial_state_size;
+        memcpy(replay->initial_state_data, block.data(), block.size());
+        replay->initial_state_size = block.size();
     }
 
-    /* Read frame count */
-    uint64_t frame_count;
-    success = success && read_uint64(fp, &frame_count);
-
-    /* Read frames */
-    if (success) {
-        replay->frames.reserve((size_t)frame_count);
+    /* Frame blocks */
+    uint64_t block_count = get_varint(&r);
+    for (uint64_t i = 0; i < block_count && r.ok; i++) {
+        ReplayBlockRef ref;
+        ref.first_frame = replay->total_frames;
+        ref.frame_count = get_varint(&r);
+        ref.start_time = get_f32(&r);
+        ref.offset = get_varint(&r);
 
-        for (uint64_t i = 0; i < frame_count && success; i++) {
-            ReplayFrame frame;
+        if (!r.ok || ref.frame_count == 0 || ref.offset < k_header_size) {
+            return false;
+        }
+        if (decode) {
+            if (!read_block(fp, ref.offset, REPLAY_BLOCK_FRAMES, block) ||
+                !decode_frames(replay, block, ref.frame_count)) {
+                return false;
+            }
+        } else {
+            replay->blocks.push_back(ref);
+        }
+        replay->total_frames += ref.frame_count;
+    }
 
-            success = success && read_uint64(fp, &frame.frame_number);
-            success = success && read_float(fp, &frame.delta_time);
+    /* Snapshot index; data is read lazily by seeks */
+    uint64_t snapshot_count = get_varint(&r);
+    uint64_t frame = 0;
+    for (uint64_t i = 0; i < snapshot_count && r.ok; i++) {
+        ReplaySnapshot snapshot = {};
+        frame += get_varint(&r);
+        snapshot.frame_number = frame;
+        snapshot.time = get_f32(&r);
+        snapshot.file_offset = get_varint(&r);
+        snapshot.size = (size_t)get_varint(&r);
 
-            uint32_t cmd_count;
-            success = success && read_uint32(fp, &cmd_count);
+        if (!r.ok || snapshot.file_offset < k_header_size) {
+            return false;
+        }
+        replay->snapshots.push_back(snapshot);
+    }
 
-            if (success) {
-                frame.commands.reserve(cmd_count);
-                for (uint32_t j = 0; j < cmd_count && success; j++) {
-                    ReplayCommand cmd;
-                    success = read_command(fp, &cmd);
-                    if (success) {
-                        frame.commands.push_back(cmd);
-                    }
-                }
-            }
+    return r.ok;
+}
 
-            if (success) {
-                replay->frames.push_back(std::move(frame));
-            }
-        }
+static bool open_replay_file(Agentite_ReplaySystem *replay, const char *filepath, bool streamed) {
+    if (replay->state != AGENTITE_REPLAY_IDLE) {
+        agentite_set_error("replay: cannot load while recording or playing");
+        return false;
     }
 
-    /* Read snapshot count */
-    uint32_t snapshot_count;
-    success = success && read_uint32(fp, &snapshot_count);
+    FILE *fp = fopen(filepath, "rb");
+    if (!fp) {
+        agentite_set_error("replay: failed to open file: %s", filepath);
+        return false;
+    }
 
-    /* Read snapshots */
-    if (success) {
-        for (uint32_t i = 0; i < snapshot_count && success; i++) {
-            ReplaySnapshot snapshot;
-            snapshot.data = nullptr;
-
-            success = success && read_uint64(fp, &snapshot.frame_number);
-            uint64_t snapshot_size = 0;
-            success = success && read_uint64(fp, &snapshot_size);
-            snapshot.size = static_cast<size_t>(snapshot_size);
-
-            if (success && snapshot.size > 0) {
-                snapshot.data = malloc(snapshot.size);
-                if (!snapshot.data) {
-                    success = false;
-                } else {
-                    success = (fread(snapshot.data, 1, snapshot.size, fp) == snapshot.size);
-                }
-            }
+    /* Clear existing data */
+    agentite_replay_clear(replay);
 
-            if (success) {
-                replay->snapshots.push_back(snapshot);
-            } else if (snapshot.data) {
-                free(snapshot.data);
-            }
-        }
+    uint64_t index_offset = 0;
+    if (!read_header(fp, &replay->metadata, &index_offset)) {
+        fclose(fp);
+        agentite_replay_clear(replay);
+        return false;
+    }
+    if (streamed && replay->metadata.version < 2) {
+        fclose(fp);
+        agentite_replay_clear(replay);
+        agentite_set_error("replay: streaming needs a version 2 file: %s", filepath);
+        return false;
     }
 
+    bool success = replay->metadata.version >= 2
+        ? load_v2(replay, fp, index_offset, !streamed)
+        : load_v1(replay, fp);
+
     fclose(fp);
 
     if (!success) {
-        agentite_set_error("replay: failed to read replay file");
         agentite_replay_clear(replay);
+        agentite_set_error("replay: failed to read replay file");
         return false;
     }
 
+    if (streamed) {
+        size_t limit = replay->config.stream_memory_limit;
+        if (limit == 0) limit = AGENTITE_REPLAY_DEFAULT_STREAM_MEMORY;
+
+        ReplayStream *s = stream_create(filepath, false, limit, false);
+        if (s) {
+            for (const auto &block : replay->blocks) {
+                s->block_offsets.push_back(block.offset);
+            }
+        }
+        if (!s || !stream_start(s)) {
+            stream_destroy(s);
+            agentite_replay_clear(replay);
+            return false;
+        }
+        replay->stream = s;
+    }
+
+    strncpy(replay->source_path, filepath, sizeof(replay->source_path) - 1);
+    replay->source_path[sizeof(replay->source_path) - 1] = '\0';
     return true;
 }
 
+bool agentite_replay_load(Agentite_ReplaySystem *replay,
+                           const char *filepath) {
+    AGENTITE_VALIDATE_PTR_RET(replay, false);
+    AGENTITE_VALIDATE_PTR_RET(filepath, false);
+    return open_replay_file(replay, filepath, false);
+}
+
+bool agentite_replay_open_stream(Agentite_ReplaySystem *replay,
+                                  const char *filepath) {
+    AGENTITE_VALIDATE_PTR_RET(replay, false);
+    AGENTITE_VALIDATE_PTR_RET(filepath, false);
+    return open_replay_file(replay, filepath, true);
+}
+
 bool agentite_replay_get_file_info(const char *filepath,
                                     Agentite_ReplayMetadata *out_meta) {
     AGENTITE_VALIDATE_PTR_RET(filepath, false);
@@ -809,36 +2036,9 @@ bool agentite_replay_get_file_info(const char *filepath,
         return false;
     }
 
-    bool success = true;
-
-    memset(out_meta, 0, sizeof(*out_meta));
-
-    success = success && read_uint32(fp, &out_meta->magic);
-    if (success && out_meta->magic != AGENTITE_REPLAY_MAGIC) {
-        agentite_set_error("replay: invalid file format (bad magic)");
-        fclose(fp);
-        return false;
-    }
-
-    success = success && read_int32(fp, &out_meta->version);
-    success = success && read_int32(fp, &out_meta->min_compatible_version);
-    success = success && read_string(fp, out_meta->timestamp,
-                                     AGENTITE_REPLAY_MAX_TIMESTAMP);
-    success = success && read_string(fp, out_meta->game_version,
-                                     AGENTITE_REPLAY_MAX_VERSION_STRING);
-    success = success && read_string(fp, out_meta->map_name,
-                                     AGENTITE_REPLAY_MAX_MAP_NAME);
-    success = success && read_uint64(fp, &out_meta->total_frames);
-    success = success && read_float(fp, &out_meta->total_duration);
-    success = success && read_uint32(fp, &out_meta->random_seed);
-    success = success && read_int32(fp, &out_meta->player_count);
-
+    uint64_t index_offset;
+    bool success = read_header(fp, out_meta, &index_offset);
     fclose(fp);
-
-    if (!success) {
-        agentite_set_error("replay: failed to read file header");
-    }
-
     return success;
 }
 
@@ -851,6 +2051,39 @@ bool agentite_replay_is_valid_file(const char *filepath) {
  * Playback
  *============================================================================*/
 
+/**
+ * Resident frame for a replay-wide frame index. Streamed replays decode the
+ * block holding it in place of the current window. Returns NULL on failure;
+ * the pointer is valid until the next call.
+ */
+static const ReplayFrame *frame_at(Agentite_ReplaySystem *replay, uint64_t frame) {
+    if (frame >= replay->frame_base && frame - replay->frame_base < replay->frames.size()) {
+        return &replay->frames[(size_t)(frame - replay->frame_base)];
+    }
+    if (!replay->stream || replay->stream->writing || frame >= replay->total_frames) {
+        return nullptr;
+    }
+
+    auto it = std::upper_bound(replay->blocks.begin(), replay->blocks.end(), frame,
+                               [](uint64_t f, const ReplayBlockRef &block) {
+                                   return f < block.first_frame;
+                               });
+    size_t block = (size_t)(it - replay->blocks.begin()) - 1;
+    const ReplayBlockRef &ref = replay->blocks[block];
+
+    replay->frames.clear();
+    replay->commands.clear();
+    replay->params.clear();
+    replay->frame_base = ref.first_frame;
+    if (!stream_fetch_block(replay->stream, block, replay->block_buffer) ||
+        !decode_frames(replay, replay->block_buffer, ref.frame_count)) {
+        replay->frames.clear();
+        agentite_set_error("replay: failed to read frame block %zu", block);
+        return nullptr;
+    }
+    return &replay->frames[(size_t)(frame - ref.first_frame)];
+}
+
 bool agentite_replay_start_playback(Agentite_ReplaySystem *replay,
                                      Agentite_CommandSystem *cmd_sys,
                                      void *game_state) {
@@ -862,7 +2095,7 @@ bool agentite_replay_start_playback(Agentite_ReplaySystem *replay,
         return false;
     }
 
-    if (replay->frames.empty()) {
+    if (replay->total_frames == 0) {
         agentite_set_error("replay: no replay data loaded");
         return false;
     }
@@ -915,7 +2148,7 @@ int agentite_replay_playback_frame(Agentite_ReplaySystem *replay,
         return 0;
     }
 
-    if (replay->current_frame >= replay->frames.size()) {
+    if (replay->current_frame >= replay->total_frames) {
         /* End of replay */
         replay->state = AGENTITE_REPLAY_IDLE;
         if (replay->on_end_callback) {
@@ -924,12 +2157,16 @@ int agentite_replay_playback_frame(Agentite_ReplaySystem *replay,
         return 0;
     }
 
+    /* Get current frame */
+    const ReplayFrame *next = frame_at(replay, replay->current_frame);
+    if (!next) {
+        return -1;
+    }
+    const ReplayFrame &frame = *next;
+
     /* Accumulate time */
     replay->accumulated_time += delta_time * replay->playback_speed;
 
-    /* Get current frame */
-    const ReplayFrame &frame = replay->frames[replay->current_frame];
-
     /* Check if we should advance to this frame based on timing */
     if (replay->accumulated_time < frame.delta_time && replay->current_frame > 0) {
         /* Not time for this frame yet */
@@ -942,19 +2179,7 @@ int agentite_replay_playback_frame(Agentite_ReplaySystem *replay,
     }
 
     /* Execute commands for this frame */
-    int commands_executed = 0;
-
-    for (const auto &rc : frame.commands) {
-        Agentite_Command cmd;
-        copy_replay_to_command(&cmd, &rc);
-
-        Agentite_CommandResult result = agentite_command_execute(
-            replay->playback_cmd_sys, &cmd, game_state);
-
-        if (result.success) {
-            commands_executed++;
-        }
-    }
+    int commands_executed = execute_frame(replay, frame, game_state);
 
     replay->current_time += frame.delta_time;
     replay->current_frame++;
@@ -999,33 +2224,36 @@ bool agentite_replay_seek(Agentite_ReplaySystem *replay,
         return false;
     }
 
-    if (target_frame >= replay->frames.size()) {
-        target_frame = replay->frames.size() > 0 ? replay->frames.size() - 1 : 0;
+    if (target_frame >= replay->total_frames) {
+        target_frame = replay->total_frames > 0 ? replay->total_frames - 1 : 0;
     }
 
-    /* Find nearest snapshot before target frame */
-    ReplaySnapshot *best_snapshot = nullptr;
-
-    for (size_t i = 0; i < replay->snapshots.size(); i++) {
-        if (replay->snapshots[i].frame_number <= target_frame) {
-            if (!best_snapshot ||
-                replay->snapshots[i].frame_number > best_snapshot->frame_number) {
-                best_snapshot = &replay->snapshots[i];
-            }
-        }
-    }
+    /* Nearest snapshot at or before the target (snapshots are in frame order) */
+    auto it = std::upper_bound(replay->snapshots.begin(), replay->snapshots.end(), target_frame,
+                               [](uint64_t frame, const ReplaySnapshot &snapshot) {
+                                   return frame < snapshot.frame_number;
+                               });
+    const ReplaySnapshot *best_snapshot =
+        it != replay->snapshots.begin() ? &*(it - 1) : nullptr;
 
+    bool seeking_forward = target_frame >= replay->current_frame;
     uint64_t start_frame = 0;
 
-    if (best_snapshot && best_snapshot->data && replay->config.deserialize) {
-        /* Restore from snapshot */
-        if (!replay->config.deserialize(game_state, best_snapshot->data,
-                                        best_snapshot->size)) {
+    if (best_snapshot && snapshot_available(*best_snapshot) && replay->config.deserialize &&
+        (!seeking_forward || best_snapshot->frame_number > replay->current_frame)) {
+        /* Restore from snapshot, reading only its block if it is still on disk */
+        std::vector<uint8_t> disk;
+        const void *data = best_snapshot->data;
+        if (!data && read_snapshot(replay, *best_snapshot, disk)) {
+            data = disk.data();
+        }
+        if (!data || !replay->config.deserialize(game_state, data, best_snapshot->size)) {
             agentite_set_error("replay: failed to restore snapshot");
             return false;
         }
         start_frame = best_snapshot->frame_number;
-    } else if (target_frame < replay->current_frame) {
+        replay->current_time = best_snapshot->time;
+    } else if (!seeking_forward) {
         /* No snapshot, need to restart from beginning */
         if (replay->config.reset && game_state) {
             if (!replay->config.reset(game_state, &replay->metadata)) {
@@ -1043,28 +2271,20 @@ bool agentite_replay_seek(Agentite_ReplaySystem *replay,
             }
         }
         start_frame = 0;
+        replay->current_time = 0.0f;
     } else {
-        /* Seeking forward, can continue from current position */
+        /* Seeking forward past every closer snapshot, continue from here */
         start_frame = replay->current_frame;
     }
 
     /* Fast-forward from start_frame to target_frame */
-    replay->current_time = 0.0f;
-    for (uint64_t i = 0; i < start_frame && i < replay->frames.size(); i++) {
-        replay->current_time += replay->frames[i].delta_time;
-    }
-
-    for (uint64_t i = start_frame; i < target_frame && i < replay->frames.size(); i++) {
-        const ReplayFrame &frame = replay->frames[i];
-
-        /* Execute commands */
-        for (const auto &rc : frame.commands) {
-            Agentite_Command cmd;
-            copy_replay_to_command(&cmd, &rc);
-            agentite_command_execute(replay->playback_cmd_sys, &cmd, game_state);
+    for (uint64_t i = start_frame; i < target_frame; i++) {
+        const ReplayFrame *frame = frame_at(replay, i);
+        if (!frame) {
+            return false;
         }
-
-        replay->current_time += frame.delta_time;
+        execute_frame(replay, *frame, game_state);
+        replay->current_time += frame->delta_time;
     }
 
     replay->current_frame = target_frame;
@@ -1085,7 +2305,7 @@ bool agentite_replay_seek_percent(Agentite_ReplaySystem *replay,
     if (percent < 0.0f) percent = 0.0f;
     if (percent > 1.0f) percent = 1.0f;
 
-    uint64_t target_frame = (uint64_t)(percent * (float)replay->frames.size());
+    uint64_t target_frame = (uint64_t)(percent * (float)replay->total_frames);
     return agentite_replay_seek(replay, game_state, target_frame);
 }
 
@@ -1097,26 +2317,17 @@ int agentite_replay_step_forward(Agentite_ReplaySystem *replay,
         return -1;
     }
 
-    if (replay->current_frame >= replay->frames.size()) {
+    if (replay->current_frame >= replay->total_frames) {
         return 0;
     }
 
-    const ReplayFrame &frame = replay->frames[replay->current_frame];
-    int commands_executed = 0;
-
-    for (const auto &rc : frame.commands) {
-        Agentite_Command cmd;
-        copy_replay_to_command(&cmd, &rc);
-
-        Agentite_CommandResult result = agentite_command_execute(
-            replay->playback_cmd_sys, &cmd, game_state);
-
-        if (result.success) {
-            commands_executed++;
-        }
+    const ReplayFrame *frame = frame_at(replay, replay->current_frame);
+    if (!frame) {
+        return -1;
     }
+    int commands_executed = execute_frame(replay, *frame, game_state);
 
-    replay->current_time += frame.delta_time;
+    replay->current_time += frame->delta_time;
     replay->current_frame++;
 
     return commands_executed;
@@ -1180,7 +2391,7 @@ uint64_t agentite_replay_get_current_frame(const Agentite_ReplaySystem *replay)
 }
 
 uint64_t agentite_replay_get_total_frames(const Agentite_ReplaySystem *replay) {
-    return replay ? replay->frames.size() : 0;
+    return replay ? replay->total_frames : 0;
 }
 
 float agentite_replay_get_current_time(const Agentite_ReplaySystem *replay) {
@@ -1192,10 +2403,10 @@ float agentite_replay_get_total_duration(const Agentite_ReplaySystem *replay) {
 }
 
 float agentite_replay_get_progress(const Agentite_ReplaySystem *replay) {
-    if (!replay || replay->frames.empty()) {
+    if (!replay || replay->total_frames == 0) {
         return 0.0f;
     }
-    return (float)replay->current_frame / (float)replay->frames.size();
+    return (float)replay->current_frame / (float)replay->total_frames;
 }
 
 const Agentite_ReplayMetadata *agentite_replay_get_metadata(const Agentite_ReplaySystem *replay) {
@@ -1203,13 +2414,49 @@ const Agentite_ReplayMetadata *agentite_replay_get_metadata(const Agentite_Repla
 }
 
 bool agentite_replay_has_data(const Agentite_ReplaySystem *replay) {
-    return replay && !replay->frames.empty();
+    return replay && replay->total_frames > 0;
 }
 
 int agentite_replay_get_snapshot_count(const Agentite_ReplaySystem *replay) {
     return replay ? (int)replay->snapshots.size() : 0;
 }
 
+bool agentite_replay_is_streaming(const Agentite_ReplaySystem *replay) {
+    return replay && replay->stream;
+}
+
+size_t agentite_replay_get_resident_memory(const Agentite_ReplaySystem *replay) {
+    if (!replay) {
+        return 0;
+    }
+
+    size_t total = replay->frames.capacity() * sizeof(ReplayFrame) +
+                   replay->commands.capacity() * sizeof(ReplayCommand) +
+                   replay->params.capacity() * sizeof(ReplayParam) +
+                   replay->blocks.capacity() * sizeof(ReplayBlockRef) +
+                   replay->snapshots.capacity() * sizeof(ReplaySnapshot) +
+                   replay->block_buffer.capacity() +
+                   replay->initial_state_size;
+    for (const auto &snapshot : replay->snapshots) {
+        if (snapshot.data) {
+            total += snapshot.size;
+        }
+    }
+
+    ReplayStream *s = replay->stream;
+    if (s) {
+        total += s->writer.packed.capacity();
+        if (s->writing) {
+            total += s->ring_capacity;
+        } else {
+            SDL_LockMutex(s->mutex);
+            total += s->ready_bytes;
+            SDL_UnlockMutex(s->mutex);
+        }
+    }
+    return total;
+}
+
 /*============================================================================
  * Callbacks
  *============================================================================*/
@@ -1298,7 +2545,22 @@ void agentite_replay_clear(Agentite_ReplaySystem *replay) {
     }
 
     replay->frames.clear();
-    replay->pending_commands.clear();
+    replay->commands.clear();
+    replay->params.clear();
+    replay->strings.clear();
+    replay->string_ids.clear();
+    replay->pending_first_command = 0;
+    replay->source_path[0] = '\0';
+
+    /* Close any stream; an unfinished recording is left truncated on disk */
+    stream_destroy(replay->stream);
+    replay->stream = nullptr;
+    replay->blocks.clear();
+    replay->block_buffer.clear();
+    replay->frame_base = 0;
+    replay->total_frames = 0;
+    replay->window_start_time = 0.0f;
+    replay->stream_initial_offset = 0;
 
     /* Free snapshots */
     for (auto &snapshot : replay->snapshots) {
@@ -1,6 +1,8 @@
 #include "agentite/agentite.h"
 #include "agentite/save.h"
+#include "agentite/compress.h"
 #include "toml.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -9,19 +11,151 @@
 
 #ifdef _WIN32
 #include <direct.h>
+#include <io.h>
 #define mkdir(path, mode) _mkdir(path)
+#define fsync(fd) _commit(fd)
+#define fileno _fileno
+#else
+#include <unistd.h>
 #endif
 
+// Binary format constants
+#define SAVE_BIN_MAGIC "AGSV"
+#define SAVE_BIN_FORMAT_VERSION 1
+#define SAVE_BIN_FLAG_COMPRESSED 0x1
+#define SAVE_BIN_SECTION_NAME_MAX 64
+#define SAVE_BIN_MAX_SECTIONS 65536
+#define SAVE_BIN_MIN_COMPRESS 64        // Smaller sections are always stored raw
+#define SAVE_BIN_ARRAY_PREFIX 8         // u32 count + u32 reserved
+
+// Record types
+enum {
+    SAVE_REC_INT = 1,
+    SAVE_REC_INT64,
+    SAVE_REC_FLOAT,
+    SAVE_REC_DOUBLE,
+    SAVE_REC_BOOL,
+    SAVE_REC_STRING,
+    SAVE_REC_INT_ARRAY,
+    SAVE_REC_FLOAT_ARRAY
+};
+
+// File header (32 bytes, little-endian)
+typedef struct SaveBinHeader {
+    char magic[4];
+    uint16_t format_version;
+    uint16_t flags;
+    int32_t game_version;
+    uint32_t section_count;
+    uint64_t index_offset;
+    uint64_t reserved;
+} SaveBinHeader;
+
+// Section index entry (96 bytes)
+typedef struct SaveBinIndexEntry {
+    char name[SAVE_BIN_SECTION_NAME_MAX];
+    uint64_t offset;
+    uint64_t stored_size;
+    uint64_t raw_size;
+    uint32_t flags;
+    uint32_t record_count;
+} SaveBinIndexEntry;
+
+// Record header (8 bytes), followed by key + NUL padded to 8, then payload padded to 8
+typedef struct SaveBinRecordHeader {
+    uint8_t type;
+    uint8_t key_len;
+    uint16_t reserved;
+    uint32_t payload_size;
+} SaveBinRecordHeader;
+
+// Decoded view of a record inside a loaded section
+typedef struct SaveBinRecord {
+    uint8_t type;
+    const char *key;
+    const unsigned char *payload;
+    uint32_t payload_size;
+} SaveBinRecord;
+
+typedef struct SaveBinSection {
+    SaveBinIndexEntry entry;
+    unsigned char *data;    // Raw records, NULL until first entered
+    uint32_t *slots;        // Open-addressing table of record offset + 1
+    uint32_t slot_mask;
+} SaveBinSection;
+
+struct Agentite_SaveBinary {
+    FILE *fp;
+    int game_version;
+    SaveBinSection *sections;
+    uint32_t section_count;
+    SaveBinSection *current;
+};
+
 struct Agentite_SaveWriter {
     FILE *fp;
     char current_section[64];
     bool in_section;
+
+    // Binary backend
+    Agentite_SaveFormat format;
+    bool compress;
+    bool failed;
+    unsigned char *buf;             // Records of the section being written
+    size_t buf_size;
+    size_t buf_capacity;
+    uint32_t record_count;
+    unsigned char *scratch;         // Compression output
+    size_t scratch_capacity;
+    SaveBinIndexEntry *index;
+    uint32_t index_count;
+    uint32_t index_capacity;
+    uint64_t file_offset;
+
+    // Metadata (binary saves write it last, once preview data is known)
+    int meta_version;
+    char meta_timestamp[32];
+    char meta_save_name[AGENTITE_SAVE_MAX_NAME];
+    int preview_turn;
+    bool has_preview_turn;
 };
 
+// Describes one save to write; filled on the main thread so workers never touch the manager
+typedef struct SaveJob {
+    struct SaveJob *next;
+    char save_name[AGENTITE_SAVE_MAX_NAME];
+    char timestamp[32];
+    Agentite_SaveFormat format;
+    bool compress;
+    int version;
+    uint32_t serial;
+    Agentite_SerializeFunc serialize;
+    Agentite_SnapshotFreeFunc free_snapshot;
+    void *snapshot;
+    Agentite_SaveResult result;
+    uint32_t duration_ms;
+} SaveJob;
+
 struct Agentite_SaveManager {
     char saves_dir[AGENTITE_SAVE_MAX_PATH];
     int version;
     int min_compatible;
+    Agentite_SaveFormat format;
+    bool compress;
+    uint32_t temp_serial;               // Keeps temp file names unique per save
+
+    // Async saves (worker created on first use)
+    Agentite_EventDispatcher *events;
+    SDL_Thread *worker;
+    SDL_Mutex *mutex;
+    SDL_Condition *work_cond;           // Signaled when a job is queued or on shutdown
+    SDL_Condition *idle_cond;           // Signaled when a job finishes
+    SaveJob *queue_head;
+    SaveJob *queue_tail;
+    SaveJob *done_head;                 // Finished, awaiting agentite_save_update()
+    SaveJob *done_tail;
+    int in_flight;                      // Queued + currently writing
+    bool shutdown;
 };
 
 // Validate save name to prevent path traversal attacks
@@ -50,10 +184,583 @@ static void get_timestamp(char *buf, size_t size) {
     strftime(buf, size, "%Y-%m-%dT%H:%M:%S", tm_info);
 }
 
+static const char *format_extension(Agentite_SaveFormat format) {
+    return format == AGENTITE_SAVE_FORMAT_BINARY ? ".sav" : ".toml";
+}
+
 // Build save file path
 static void build_save_path(const Agentite_SaveManager *sm, const char *save_name,
-                            char *out_path, size_t path_size) {
-    snprintf(out_path, path_size, "%s/%s.toml", sm->saves_dir, save_name);
+                            Agentite_SaveFormat format, char *out_path, size_t path_size) {
+    snprintf(out_path, path_size, "%s/%s%s", sm->saves_dir, save_name,
+             format_extension(format));
+}
+
+// Locate an existing save, preferring the manager's current format
+static bool find_save_path(const Agentite_SaveManager *sm, const char *save_name,
+                           char *out_path, size_t path_size,
+                           Agentite_SaveFormat *out_format) {
+    Agentite_SaveFormat other = sm->format == AGENTITE_SAVE_FORMAT_BINARY
+        ? AGENTITE_SAVE_FORMAT_TOML : AGENTITE_SAVE_FORMAT_BINARY;
+    struct stat st;
+
+    build_save_path(sm, save_name, other, out_path, path_size);
+    if (stat(out_path, &st) == 0) {
+        // Only fall back if the preferred file is missing
+        char preferred[AGENTITE_SAVE_MAX_PATH];
+        build_save_path(sm, save_name, sm->format, preferred, sizeof(preferred));
+        if (stat(preferred, &st) != 0) {
+            *out_format = other;
+            return true;
+        }
+    }
+
+    build_save_path(sm, save_name, sm->format, out_path, path_size);
+    *out_format = sm->format;
+    return stat(out_path, &st) == 0;
+}
+
+// Detect the format of a save file from its first bytes
+static bool detect_save_format(const char *path, Agentite_SaveFormat *out_format) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return false;
+
+    char magic[4] = {0};
+    size_t n = fread(magic, 1, sizeof(magic), fp);
+    fclose(fp);
+
+    *out_format = (n == sizeof(magic) && memcmp(magic, SAVE_BIN_MAGIC, 4) == 0)
+        ? AGENTITE_SAVE_FORMAT_BINARY : AGENTITE_SAVE_FORMAT_TOML;
+    return true;
+}
+
+// Move a fully written temp file over the destination
+static bool replace_file(const char *temp_path, const char *path) {
+#ifdef _WIN32
+    remove(path);  // rename() does not overwrite on Windows
+#endif
+    return rename(temp_path, path) == 0;
+}
+
+static inline size_t align8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+// FNV-1a hash for record keys
+static uint32_t hash_key(const char *key) {
+    uint32_t hash = 2166136261u;
+    while (*key) {
+        hash ^= (uint8_t)*key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Binary writer
+
+static bool bin_reserve(Agentite_SaveWriter *w, size_t extra) {
+    if (w->buf_size + extra <= w->buf_capacity) return true;
+
+    size_t capacity = w->buf_capacity ? w->buf_capacity : 4096;
+    while (capacity < w->buf_size + extra) capacity *= 2;
+
+    unsigned char *buf = AGENTITE_REALLOC(w->buf, unsigned char, capacity);
+    if (!buf) {
+        w->failed = true;
+        return false;
+    }
+    w->buf = buf;
+    w->buf_capacity = capacity;
+    return true;
+}
+
+static bool bin_write_raw(Agentite_SaveWriter *w, const void *data, size_t size) {
+    if (size == 0) return true;
+    if (fwrite(data, 1, size, w->fp) != size) {
+        w->failed = true;
+        return false;
+    }
+    w->file_offset += size;
+    return true;
+}
+
+// Append one record; prefix is written before data (used for array counts)
+static void bin_write_record(Agentite_SaveWriter *w, uint8_t type, const char *key,
+                             const void *prefix, size_t prefix_size,
+                             const void *data, size_t data_size) {
+    if (w->failed) return;
+    if (!w->in_section) {
+        w->failed = true;
+        return;
+    }
+
+    size_t key_len = strlen(key);
+    size_t payload_size = prefix_size + data_size;
+    if (key_len > UINT8_MAX || payload_size > UINT32_MAX) {
+        w->failed = true;
+        return;
+    }
+
+    size_t header_size = align8(sizeof(SaveBinRecordHeader) + key_len + 1);
+    size_t total = header_size + align8(payload_size);
+    if (!bin_reserve(w, total)) return;
+
+    unsigned char *p = w->buf + w->buf_size;
+    memset(p, 0, total);
+
+    SaveBinRecordHeader rh = {0};
+    rh.type = type;
+    rh.key_len = (uint8_t)key_len;
+    rh.payload_size = (uint32_t)payload_size;
+    memcpy(p, &rh, sizeof(rh));
+    memcpy(p + sizeof(rh), key, key_len);
+
+    if (prefix_size) memcpy(p + header_size, prefix, prefix_size);
+    if (data_size) memcpy(p + header_size + prefix_size, data, data_size);
+
+    w->buf_size += total;
+    w->record_count++;
+}
+
+static void bin_write_array(Agentite_SaveWriter *w, uint8_t type, const char *key,
+                            const void *values, int count, size_t elem_size) {
+    uint32_t prefix[2] = { (uint32_t)count, 0 };
+    bin_write_record(w, type, key, prefix, sizeof(prefix), values,
+                     (size_t)count * elem_size);
+}
+
+// Compress (if worthwhile) and write the pending section, then index it
+static bool bin_flush_section(Agentite_SaveWriter *w) {
+    if (!w->in_section) return !w->failed;
+    w->in_section = false;
+    if (w->failed) return false;
+
+    if (w->index_count == w->index_capacity) {
+        uint32_t capacity = w->index_capacity ? w->index_capacity * 2 : 8;
+        SaveBinIndexEntry *index = AGENTITE_REALLOC(w->index, SaveBinIndexEntry, capacity);
+        if (!index) {
+            w->failed = true;
+            return false;
+        }
+        w->index = index;
+        w->index_capacity = capacity;
+    }
+
+    SaveBinIndexEntry *entry = &w->index[w->index_count];
+    memset(entry, 0, sizeof(*entry));
+    strncpy(entry->name, w->current_section, sizeof(entry->name) - 1);
+    entry->offset = w->file_offset;
+    entry->raw_size = w->buf_size;
+    entry->record_count = w->record_count;
+
+    const unsigned char *stored = w->buf;
+    size_t stored_size = w->buf_size;
+
+    if (w->compress && w->buf_size >= SAVE_BIN_MIN_COMPRESS) {
+        size_t bound = agentite_lz_compress_bound(w->buf_size);
+        if (bound > w->scratch_capacity) {
+            unsigned char *scratch = AGENTITE_REALLOC(w->scratch, unsigned char, bound);
+            if (scratch) {
+                w->scratch = scratch;
+                w->scratch_capacity = bound;
+            }
+        }
+        if (bound <= w->scratch_capacity) {
+            size_t packed = agentite_lz_compress(w->buf, w->buf_size,
+                                                 w->scratch, w->scratch_capacity);
+            if (packed > 0 && packed < w->buf_size) {
+                stored = w->scratch;
+                stored_size = packed;
+                entry->flags |= SAVE_BIN_FLAG_COMPRESSED;
+            }
+        }
+    }
+    entry->stored_size = stored_size;
+
+    // One write per section, then pad so the next section starts aligned
+    static const unsigned char zeros[8] = {0};
+    if (!bin_write_raw(w, stored, stored_size)) return false;
+    if (!bin_write_raw(w, zeros, align8(stored_size) - stored_size)) return false;
+
+    w->index_count++;
+    w->buf_size = 0;
+    w->record_count = 0;
+    return true;
+}
+
+static bool bin_begin(Agentite_SaveWriter *w) {
+    SaveBinHeader header = {0};
+    return bin_write_raw(w, &header, sizeof(header));
+}
+
+static bool bin_finish(Agentite_SaveWriter *w) {
+    bin_flush_section(w);
+
+    // Metadata goes last so preview data gathered while serializing is available
+    agentite_save_write_section(w, "metadata");
+    agentite_save_write_string(w, "timestamp", w->meta_timestamp);
+    agentite_save_write_string(w, "save_name", w->meta_save_name);
+    if (w->has_preview_turn) {
+        agentite_save_write_int(w, "preview_turn", w->preview_turn);
+    }
+    if (!bin_flush_section(w)) return false;
+
+    SaveBinHeader header = {0};
+    memcpy(header.magic, SAVE_BIN_MAGIC, 4);
+    header.format_version = SAVE_BIN_FORMAT_VERSION;
+    header.game_version = w->meta_version;
+    header.section_count = w->index_count;
+    header.index_offset = w->file_offset;
+    for (uint32_t i = 0; i < w->index_count; i++) {
+        if (w->index[i].flags & SAVE_BIN_FLAG_COMPRESSED) {
+            header.flags |= SAVE_BIN_FLAG_COMPRESSED;
+        }
+    }
+
+    if (!bin_write_raw(w, w->index, sizeof(SaveBinIndexEntry) * w->index_count)) {
+        return false;
+    }
+    if (fseek(w->fp, 0, SEEK_SET) != 0 ||
+        fwrite(&header, sizeof(header), 1, w->fp) != 1) {
+        w->failed = true;
+        return false;
+    }
+    return true;
+}
+
+// Start a save file: TOML writes metadata up front, binary reserves the header
+static bool writer_begin(Agentite_SaveWriter *w, FILE *fp, Agentite_SaveFormat format,
+                         bool compress, int version, const char *timestamp,
+                         const char *save_name) {
+    memset(w, 0, sizeof(*w));
+    w->fp = fp;
+    w->format = format;
+    w->compress = compress;
+    w->meta_version = version;
+    strncpy(w->meta_timestamp, timestamp ? timestamp : "", sizeof(w->meta_timestamp) - 1);
+    strncpy(w->meta_save_name, save_name ? save_name : "", sizeof(w->meta_save_name) - 1);
+
+    if (format == AGENTITE_SAVE_FORMAT_BINARY) {
+        return bin_begin(w);
+    }
+
+    fprintf(fp, "[metadata]\n");
+    fprintf(fp, "version = %d\n", w->meta_version);
+    fprintf(fp, "timestamp = \"%s\"\n", w->meta_timestamp);
+    fprintf(fp, "save_name = \"%s\"\n", w->meta_save_name);
+    fprintf(fp, "\n");
+    return true;
+}
+
+// Finish a save file and release writer buffers (does not close the file)
+static bool writer_end(Agentite_SaveWriter *w, bool finalize) {
+    bool ok = true;
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        ok = finalize ? bin_finish(w) : false;
+    }
+    if (fflush(w->fp) != 0 || ferror(w->fp)) ok = false;
+
+    free(w->buf);
+    free(w->scratch);
+    free(w->index);
+    w->buf = NULL;
+    w->scratch = NULL;
+    w->index = NULL;
+    return ok && !w->failed;
+}
+
+// Binary reader
+
+static void bin_close(Agentite_SaveBinary *bin) {
+    if (!bin) return;
+    for (uint32_t i = 0; i < bin->section_count; i++) {
+        free(bin->sections[i].data);
+        free(bin->sections[i].slots);
+    }
+    free(bin->sections);
+    if (bin->fp) fclose(bin->fp);
+    free(bin);
+}
+
+// Open a binary save and read its header and section index (no section data)
+static Agentite_SaveBinary *bin_open(const char *path, char *errbuf, size_t errbuf_size) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        snprintf(errbuf, errbuf_size, "cannot open file");
+        return NULL;
+    }
+
+    SaveBinHeader header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, SAVE_BIN_MAGIC, 4) != 0) {
+        snprintf(errbuf, errbuf_size, "not a binary save file");
+        fclose(fp);
+        return NULL;
+    }
+    if (header.format_version != SAVE_BIN_FORMAT_VERSION) {
+        snprintf(errbuf, errbuf_size, "unsupported binary format version %u",
+                 (unsigned)header.format_version);
+        fclose(fp);
+        return NULL;
+    }
+    if (header.section_count > SAVE_BIN_MAX_SECTIONS) {
+        snprintf(errbuf, errbuf_size, "corrupt section index");
+        fclose(fp);
+        return NULL;
+    }
+
+    Agentite_SaveBinary *bin = AGENTITE_ALLOC(Agentite_SaveBinary);
+    if (!bin) {
+        snprintf(errbuf, errbuf_size, "out of memory");
+        fclose(fp);
+        return NULL;
+    }
+    bin->fp = fp;
+    bin->game_version = header.game_version;
+
+    if (header.section_count > 0) {
+        bin->sections = AGENTITE_ALLOC_ARRAY(SaveBinSection, header.section_count);
+        if (!bin->sections) {
+            snprintf(errbuf, errbuf_size, "out of memory");
+            bin_close(bin);
+            return NULL;
+        }
+    }
+    bin->section_count = header.section_count;
+
+    if (fseek(fp, (long)header.index_offset, SEEK_SET) != 0) {
+        snprintf(errbuf, errbuf_size, "corrupt section index");
+        bin_close(bin);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < bin->section_count; i++) {
+        SaveBinIndexEntry *entry = &bin->sections[i].entry;
+        if (fread(entry, sizeof(*entry), 1, fp) != 1 ||
+            entry->raw_size > UINT32_MAX ||
+            entry->offset + entry->stored_size > header.index_offset) {
+            snprintf(errbuf, errbuf_size, "corrupt section index");
+            bin_close(bin);
+            return NULL;
+        }
+        entry->name[sizeof(entry->name) - 1] = '\0';
+    }
+
+    return bin;
+}
+
+// Decode the record at pos, validating every length against the section size
+static bool bin_record_at(const SaveBinSection *sec, size_t pos,
+                          SaveBinRecord *out, size_t *out_next) {
+    size_t size = (size_t)sec->entry.raw_size;
+    if (pos + sizeof(SaveBinRecordHeader) > size) return false;
+
+    SaveBinRecordHeader rh;
+    memcpy(&rh, sec->data + pos, sizeof(rh));
+
+    size_t header_size = align8(sizeof(rh) + rh.key_len + 1);
+    if (pos + header_size > size) return false;
+    if (align8(rh.payload_size) > size - pos - header_size) return false;
+
+    const char *key = (const char *)sec->data + pos + sizeof(rh);
+    if (key[rh.key_len] != '\0') return false;
+
+    const unsigned char *payload = sec->data + pos + header_size;
+    switch (rh.type) {
+        case SAVE_REC_INT:
+        case SAVE_REC_FLOAT:
+            if (rh.payload_size != 4) return false;
+            break;
+        case SAVE_REC_INT64:
+        case SAVE_REC_DOUBLE:
+            if (rh.payload_size != 8) return false;
+            break;
+        case SAVE_REC_BOOL:
+            if (rh.payload_size != 1) return false;
+            break;
+        case SAVE_REC_STRING:
+            if (rh.payload_size == 0 || payload[rh.payload_size - 1] != '\0') return false;
+            break;
+        case SAVE_REC_INT_ARRAY:
+        case SAVE_REC_FLOAT_ARRAY: {
+            if (rh.payload_size < SAVE_BIN_ARRAY_PREFIX) return false;
+            uint32_t count;
+            memcpy(&count, payload, sizeof(count));
+            if ((size_t)count * 4 != rh.payload_size - SAVE_BIN_ARRAY_PREFIX) return false;
+            break;
+        }
+        default:
+            return false;
+    }
+
+    out->type = rh.type;
+    out->key = key;
+    out->payload = payload;
+    out->payload_size = rh.payload_size;
+    *out_next = pos + header_size + align8(rh.payload_size);
+    return true;
+}
+
+// Read, decompress and index a section on first use
+static bool bin_load_section(Agentite_SaveBinary *bin, SaveBinSection *sec) {
+    if (sec->data) return true;
+
+    size_t raw_size = (size_t)sec->entry.raw_size;
+    size_t stored_size = (size_t)sec->entry.stored_size;
+    bool compressed = (sec->entry.flags & SAVE_BIN_FLAG_COMPRESSED) != 0;
+    if (!compressed && stored_size != raw_size) return false;
+
+    unsigned char *stored = (unsigned char *)malloc(stored_size ? stored_size : 1);
+    if (!stored) return false;
+    if (fseek(bin->fp, (long)sec->entry.offset, SEEK_SET) != 0 ||
+        fread(stored, 1, stored_size, bin->fp) != stored_size) {
+        free(stored);
+        return false;
+    }
+
+    unsigned char *data = stored;
+    if (compressed) {
+        data = (unsigned char *)malloc(raw_size ? raw_size : 1);
+        if (!data || !agentite_lz_decompress(stored, stored_size, data, raw_size)) {
+            free(data);
+            free(stored);
+            return false;
+        }
+        free(stored);
+    }
+    sec->data = data;
+
+    // Hash table sized for a load factor of at most 0.5
+    uint32_t capacity = 8;
+    while (capacity < sec->entry.record_count * 2u && capacity < 0x80000000u) capacity *= 2;
+    sec->slots = AGENTITE_ALLOC_ARRAY(uint32_t, capacity);
+    if (!sec->slots) goto fail;
+    sec->slot_mask = capacity - 1;
+
+    {
+        size_t pos = 0;
+        uint32_t count = 0;
+        while (pos < raw_size) {
+            SaveBinRecord rec;
+            size_t next;
+            if (!bin_record_at(sec, pos, &rec, &next) || count >= sec->entry.record_count) {
+                goto fail;
+            }
+
+            // First record with a given key wins
+            uint32_t slot = hash_key(rec.key) & sec->slot_mask;
+            while (sec->slots[slot]) {
+                SaveBinRecord other;
+                size_t unused;
+                bin_record_at(sec, sec->slots[slot] - 1, &other, &unused);
+                if (strcmp(other.key, rec.key) == 0) break;
+                slot = (slot + 1) & sec->slot_mask;
+            }
+            if (!sec->slots[slot]) sec->slots[slot] = (uint32_t)pos + 1;
+
+            pos = next;
+            count++;
+        }
+        if (count != sec->entry.record_count) goto fail;
+    }
+    return true;
+
+fail:
+    free(sec->data);
+    free(sec->slots);
+    sec->data = NULL;
+    sec->slots = NULL;
+    return false;
+}
+
+static SaveBinSection *bin_find_section(Agentite_SaveBinary *bin, const char *name) {
+    for (uint32_t i = 0; i < bin->section_count; i++) {
+        if (strcmp(bin->sections[i].entry.name, name) == 0) {
+            return &bin->sections[i];
+        }
+    }
+    return NULL;
+}
+
+static bool bin_enter_section(Agentite_SaveBinary *bin, const char *name) {
+    SaveBinSection *sec = bin_find_section(bin, name);
+    if (!sec || !bin_load_section(bin, sec)) return false;
+    bin->current = sec;
+    return true;
+}
+
+static bool bin_find(const Agentite_SaveBinary *bin, const char *key, SaveBinRecord *out) {
+    const SaveBinSection *sec = bin->current;
+    if (!sec || !sec->slots) return false;
+
+    uint32_t slot = hash_key(key) & sec->slot_mask;
+    while (sec->slots[slot]) {
+        size_t next;
+        if (bin_record_at(sec, sec->slots[slot] - 1, out, &next) &&
+            strcmp(out->key, key) == 0) {
+            return true;
+        }
+        slot = (slot + 1) & sec->slot_mask;
+    }
+    return false;
+}
+
+static bool bin_read_int64(const Agentite_SaveBinary *bin, const char *key, long long *out) {
+    SaveBinRecord rec;
+    if (!bin_find(bin, key, &rec)) return false;
+
+    if (rec.type == SAVE_REC_INT) {
+        int32_t v;
+        memcpy(&v, rec.payload, sizeof(v));
+        *out = v;
+        return true;
+    }
+    if (rec.type == SAVE_REC_INT64) {
+        int64_t v;
+        memcpy(&v, rec.payload, sizeof(v));
+        *out = v;
+        return true;
+    }
+    return false;
+}
+
+static bool bin_read_double(const Agentite_SaveBinary *bin, const char *key, double *out) {
+    SaveBinRecord rec;
+    if (!bin_find(bin, key, &rec)) return false;
+
+    if (rec.type == SAVE_REC_FLOAT) {
+        float v;
+        memcpy(&v, rec.payload, sizeof(v));
+        *out = v;
+        return true;
+    }
+    if (rec.type == SAVE_REC_DOUBLE) {
+        memcpy(out, rec.payload, sizeof(*out));
+        return true;
+    }
+    return false;
+}
+
+// Copy an array record out into a malloc'd buffer (caller frees)
+static bool bin_read_array(const Agentite_SaveBinary *bin, const char *key, uint8_t type,
+                           void **out_array, int *out_count) {
+    SaveBinRecord rec;
+    if (!bin_find(bin, key, &rec) || rec.type != type) return false;
+
+    uint32_t count;
+    memcpy(&count, rec.payload, sizeof(count));
+    if (count > INT32_MAX) return false;
+    if (count == 0) {
+        *out_array = NULL;
+        *out_count = 0;
+        return true;
+    }
+
+    void *result = malloc((size_t)count * 4);
+    if (!result) return false;
+    memcpy(result, rec.payload + SAVE_BIN_ARRAY_PREFIX, (size_t)count * 4);
+
+    *out_array = result;
+    *out_count = (int)count;
+    return true;
 }
 
 Agentite_SaveManager *agentite_save_create(const char *saves_dir) {
@@ -68,6 +775,8 @@ Agentite_SaveManager *agentite_save_create(const char *saves_dir) {
 
     sm->version = 1;
     sm->min_compatible = 1;
+    sm->format = AGENTITE_SAVE_FORMAT_TOML;
+    sm->compress = true;
 
     // Create saves directory
     ensure_directory(sm->saves_dir);
@@ -76,6 +785,27 @@ Agentite_SaveManager *agentite_save_create(const char *saves_dir) {
 }
 
 void agentite_save_destroy(Agentite_SaveManager *sm) {
+    if (!sm) return;
+
+    // Queued saves are still written; only their completion events are dropped
+    if (sm->worker) {
+        SDL_LockMutex(sm->mutex);
+        sm->shutdown = true;
+        SDL_SignalCondition(sm->work_cond);
+        SDL_UnlockMutex(sm->mutex);
+        SDL_WaitThread(sm->worker, NULL);
+    }
+
+    SaveJob *job = sm->done_head;
+    while (job) {
+        SaveJob *next = job->next;
+        free(job);
+        job = next;
+    }
+
+    if (sm->idle_cond) SDL_DestroyCondition(sm->idle_cond);
+    if (sm->work_cond) SDL_DestroyCondition(sm->work_cond);
+    if (sm->mutex) SDL_DestroyMutex(sm->mutex);
     free(sm);
 }
 
@@ -85,68 +815,283 @@ void agentite_save_set_version(Agentite_SaveManager *sm, int version, int min_co
     sm->min_compatible = min_compatible;
 }
 
-Agentite_SaveResult agentite_save_game(Agentite_SaveManager *sm,
-                                    const char *save_name,
-                                    Agentite_SerializeFunc serialize,
-                                    void *game_state) {
-    Agentite_SaveResult result = {0};
+void agentite_save_set_format(Agentite_SaveManager *sm, Agentite_SaveFormat format) {
+    if (!sm) return;
+    sm->format = format;
+}
+
+Agentite_SaveFormat agentite_save_get_format(const Agentite_SaveManager *sm) {
+    return sm ? sm->format : AGENTITE_SAVE_FORMAT_TOML;
+}
+
+void agentite_save_set_compression(Agentite_SaveManager *sm, bool enabled) {
+    if (!sm) return;
+    sm->compress = enabled;
+}
+
+// Serialize into a temporary file, flush it to disk, then rename it over the
+// target so a crash or failed serialize never leaves a truncated save behind
+static void write_save_job(SaveJob *job, void *game_state) {
+    Agentite_SaveResult *result = &job->result;
+
+    char temp_path[AGENTITE_SAVE_MAX_PATH + 16];
+    snprintf(temp_path, sizeof(temp_path), "%s.%u.tmp", result->filepath, job->serial);
+
+    FILE *fp = fopen(temp_path, job->format == AGENTITE_SAVE_FORMAT_BINARY ? "wb" : "w");
+    if (!fp) {
+        snprintf(result->error_message, sizeof(result->error_message),
+                 "Cannot create save file: %s", result->filepath);
+        return;
+    }
+
+    // Create writer for game state
+    Agentite_SaveWriter writer;
+    bool written = writer_begin(&writer, fp, job->format, job->compress,
+                                job->version, job->timestamp, job->save_name);
+
+    // Write game_state section header
+    agentite_save_write_section(&writer, "game_state");
+
+    // Let game serialize its state
+    bool success = job->serialize(game_state, &writer);
+
+    written = writer_end(&writer, success) && written;
+    if (written && success) {
+        written = fsync(fileno(fp)) == 0;
+    }
+    written = fclose(fp) == 0 && written;
+
+    if (success && written) {
+        written = replace_file(temp_path, result->filepath);
+    }
+    if (!success || !written) {
+        remove(temp_path);
+    }
+
+    if (success && written) {
+        result->success = true;
+        result->save_version = job->version;
+    } else if (!success) {
+        snprintf(result->error_message, sizeof(result->error_message),
+                 "Serialization failed");
+    } else {
+        snprintf(result->error_message, sizeof(result->error_message),
+                 "Write failed: %s", result->filepath);
+    }
+}
+
+// Validate parameters and capture the manager settings a save needs
+static bool prepare_save_job(Agentite_SaveManager *sm, const char *save_name,
+                             Agentite_SerializeFunc serialize, SaveJob *job) {
+    Agentite_SaveResult *result = &job->result;
 
     if (!sm || !save_name || !serialize) {
-        snprintf(result.error_message, sizeof(result.error_message),
+        snprintf(result->error_message, sizeof(result->error_message),
                  "Invalid parameters");
-        return result;
+        return false;
     }
 
     if (!is_valid_save_name(save_name)) {
-        snprintf(result.error_message, sizeof(result.error_message),
+        snprintf(result->error_message, sizeof(result->error_message),
                  "Invalid save name: must not contain path separators or '..'");
-        return result;
+        return false;
     }
 
-    build_save_path(sm, save_name, result.filepath, sizeof(result.filepath));
+    build_save_path(sm, save_name, sm->format, result->filepath, sizeof(result->filepath));
+    strncpy(job->save_name, save_name, sizeof(job->save_name) - 1);
+    get_timestamp(job->timestamp, sizeof(job->timestamp));
+    job->format = sm->format;
+    job->compress = sm->compress;
+    job->version = sm->version;
+    job->serial = ++sm->temp_serial;
+    job->serialize = serialize;
+    return true;
+}
 
-    FILE *fp = fopen(result.filepath, "w");
-    if (!fp) {
-        snprintf(result.error_message, sizeof(result.error_message),
-                 "Cannot create save file: %s", result.filepath);
-        return result;
+Agentite_SaveResult agentite_save_game(Agentite_SaveManager *sm,
+                                    const char *save_name,
+                                    Agentite_SerializeFunc serialize,
+                                    void *game_state) {
+    SaveJob job;
+    memset(&job, 0, sizeof(job));
+
+    if (prepare_save_job(sm, save_name, serialize, &job)) {
+        write_save_job(&job, game_state);
     }
+    return job.result;
+}
 
-    // Write metadata section
-    char timestamp[32];
-    get_timestamp(timestamp, sizeof(timestamp));
+// Async saves
 
-    fprintf(fp, "[metadata]\n");
-    fprintf(fp, "version = %d\n", sm->version);
-    fprintf(fp, "timestamp = \"%s\"\n", timestamp);
-    fprintf(fp, "save_name = \"%s\"\n", save_name);
-    fprintf(fp, "\n");
+static int save_worker_func(void *data) {
+    Agentite_SaveManager *sm = (Agentite_SaveManager *)data;
 
-    // Create writer for game state
-    Agentite_SaveWriter writer = {0};
-    writer.fp = fp;
-    writer.in_section = false;
+    SDL_LockMutex(sm->mutex);
+    for (;;) {
+        while (!sm->queue_head && !sm->shutdown) {
+            SDL_WaitCondition(sm->work_cond, sm->mutex);
+        }
+        SaveJob *job = sm->queue_head;
+        if (!job) break;  // Shutdown with an empty queue
+
+        sm->queue_head = job->next;
+        if (!sm->queue_head) sm->queue_tail = NULL;
+        job->next = NULL;
+        SDL_UnlockMutex(sm->mutex);
+
+        uint64_t start = SDL_GetTicks();
+        write_save_job(job, job->snapshot);
+        job->duration_ms = (uint32_t)(SDL_GetTicks() - start);
+
+        if (job->free_snapshot) job->free_snapshot(job->snapshot);
+        job->snapshot = NULL;
+
+        SDL_LockMutex(sm->mutex);
+        if (sm->done_tail) {
+            sm->done_tail->next = job;
+        } else {
+            sm->done_head = job;
+        }
+        sm->done_tail = job;
+        sm->in_flight--;
+        SDL_BroadcastCondition(sm->idle_cond);
+    }
+    SDL_UnlockMutex(sm->mutex);
+    return 0;
+}
 
-    // Write game_state section header
-    fprintf(fp, "[game_state]\n");
-    strncpy(writer.current_section, "game_state", sizeof(writer.current_section) - 1);
-    writer.current_section[sizeof(writer.current_section) - 1] = '\0';
-    writer.in_section = true;
+// Worker and its sync primitives are created on the first async save
+static bool ensure_save_worker(Agentite_SaveManager *sm) {
+    if (sm->worker) return true;
 
-    // Let game serialize its state
-    bool success = serialize(game_state, &writer);
+    if (!sm->mutex) sm->mutex = SDL_CreateMutex();
+    if (!sm->work_cond) sm->work_cond = SDL_CreateCondition();
+    if (!sm->idle_cond) sm->idle_cond = SDL_CreateCondition();
+    if (!sm->mutex || !sm->work_cond || !sm->idle_cond) {
+        agentite_set_error("save: failed to create async save primitives");
+        return false;
+    }
 
-    fclose(fp);
+    sm->shutdown = false;
+    sm->worker = SDL_CreateThread(save_worker_func, "AgentiteSave", sm);
+    if (!sm->worker) {
+        agentite_set_error("save: failed to create save worker: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
 
-    if (success) {
-        result.success = true;
-        result.save_version = sm->version;
+bool agentite_save_game_async(Agentite_SaveManager *sm,
+                              const char *save_name,
+                              Agentite_SnapshotFunc snapshot,
+                              Agentite_SerializeFunc serialize,
+                              Agentite_SnapshotFreeFunc free_snapshot,
+                              void *game_state) {
+    if (!snapshot) {
+        agentite_set_error("save: async save requires a snapshot callback");
+        return false;
+    }
+
+    SaveJob *job = AGENTITE_ALLOC(SaveJob);
+    if (!job) {
+        agentite_set_error("save: out of memory");
+        return false;
+    }
+    if (!prepare_save_job(sm, save_name, serialize, job)) {
+        agentite_set_error("save: %s", job->result.error_message);
+        free(job);
+        return false;
+    }
+    if (!ensure_save_worker(sm)) {
+        free(job);
+        return false;
+    }
+
+    // The only game work done on the calling thread
+    job->snapshot = snapshot(game_state);
+    if (!job->snapshot) {
+        agentite_set_error("save: snapshot failed for '%s'", save_name);
+        free(job);
+        return false;
+    }
+    job->free_snapshot = free_snapshot;
+
+    SDL_LockMutex(sm->mutex);
+    if (sm->queue_tail) {
+        sm->queue_tail->next = job;
     } else {
-        snprintf(result.error_message, sizeof(result.error_message),
-                 "Serialization failed");
+        sm->queue_head = job;
     }
+    sm->queue_tail = job;
+    sm->in_flight++;
+    SDL_SignalCondition(sm->work_cond);
+    SDL_UnlockMutex(sm->mutex);
+    return true;
+}
 
-    return result;
+bool agentite_save_auto_async(Agentite_SaveManager *sm,
+                              Agentite_SnapshotFunc snapshot,
+                              Agentite_SerializeFunc serialize,
+                              Agentite_SnapshotFreeFunc free_snapshot,
+                              void *game_state) {
+    return agentite_save_game_async(sm, "autosave", snapshot, serialize,
+                                    free_snapshot, game_state);
+}
+
+void agentite_save_set_event_dispatcher(Agentite_SaveManager *sm,
+                                        Agentite_EventDispatcher *events) {
+    if (!sm) return;
+    sm->events = events;
+}
+
+int agentite_save_update(Agentite_SaveManager *sm) {
+    if (!sm || !sm->mutex) return 0;
+
+    SDL_LockMutex(sm->mutex);
+    SaveJob *done = sm->done_head;
+    sm->done_head = NULL;
+    sm->done_tail = NULL;
+    SDL_UnlockMutex(sm->mutex);
+
+    int count = 0;
+    while (done) {
+        SaveJob *job = done;
+        done = job->next;
+
+        if (sm->events) {
+            Agentite_Event e = { .type = job->result.success
+                ? AGENTITE_EVENT_GAME_SAVED : AGENTITE_EVENT_GAME_SAVE_FAILED };
+            e.save.save_name = job->save_name;
+            e.save.filepath = job->result.filepath;
+            e.save.error = job->result.success ? NULL : job->result.error_message;
+            e.save.success = job->result.success;
+            e.save.duration_ms = job->duration_ms;
+            agentite_event_emit(sm->events, &e);
+        }
+
+        free(job);
+        count++;
+    }
+    return count;
+}
+
+bool agentite_save_is_busy(const Agentite_SaveManager *sm) {
+    if (!sm || !sm->mutex) return false;
+
+    SDL_LockMutex(sm->mutex);
+    bool busy = sm->in_flight > 0;
+    SDL_UnlockMutex(sm->mutex);
+    return busy;
+}
+
+void agentite_save_wait(Agentite_SaveManager *sm) {
+    if (!sm || !sm->mutex) return;
+
+    SDL_LockMutex(sm->mutex);
+    while (sm->in_flight > 0) {
+        SDL_WaitCondition(sm->idle_cond, sm->mutex);
+    }
+    SDL_UnlockMutex(sm->mutex);
 }
 
 Agentite_SaveResult agentite_load_game(Agentite_SaveManager *sm,
@@ -167,55 +1112,77 @@ Agentite_SaveResult agentite_load_game(Agentite_SaveManager *sm,
         return result;
     }
 
-    build_save_path(sm, save_name, result.filepath, sizeof(result.filepath));
-
-    FILE *fp = fopen(result.filepath, "r");
-    if (!fp) {
+    Agentite_SaveFormat format;
+    if (!find_save_path(sm, save_name, result.filepath, sizeof(result.filepath), &format)) {
         snprintf(result.error_message, sizeof(result.error_message),
                  "Save file not found: %s", result.filepath);
         return result;
     }
 
+    Agentite_SaveReader reader = {0};
+    bool has_version = false;
     char errbuf[256];
-    toml_table_t *root = toml_parse_file(fp, errbuf, sizeof(errbuf));
-    fclose(fp);
 
-    if (!root) {
-        snprintf(result.error_message, sizeof(result.error_message),
-                 "Parse error: %s", errbuf);
-        return result;
-    }
+    if (format == AGENTITE_SAVE_FORMAT_BINARY) {
+        reader.binary = bin_open(result.filepath, errbuf, sizeof(errbuf));
+        if (!reader.binary) {
+            snprintf(result.error_message, sizeof(result.error_message),
+                     "Load error: %s", errbuf);
+            return result;
+        }
+        result.save_version = reader.binary->game_version;
+        has_version = true;
+    } else {
+        FILE *fp = fopen(result.filepath, "r");
+        if (!fp) {
+            snprintf(result.error_message, sizeof(result.error_message),
+                     "Save file not found: %s", result.filepath);
+            return result;
+        }
 
-    // Check version in metadata
-    toml_table_t *metadata = toml_table_in(root, "metadata");
-    if (metadata) {
-        toml_datum_t d = toml_int_in(metadata, "version");
-        if (d.ok) {
-            result.save_version = (int)d.u.i;
-
-            if (result.save_version < sm->min_compatible) {
-                snprintf(result.error_message, sizeof(result.error_message),
-                         "Save version %d is too old (min: %d)",
-                         result.save_version, sm->min_compatible);
-                toml_free(root);
-                return result;
-            }
+        reader.root = toml_parse_file(fp, errbuf, sizeof(errbuf));
+        fclose(fp);
+
+        if (!reader.root) {
+            snprintf(result.error_message, sizeof(result.error_message),
+                     "Parse error: %s", errbuf);
+            return result;
+        }
 
-            if (result.save_version != sm->version) {
-                result.was_migrated = true;
+        // Check version in metadata
+        toml_table_t *metadata = toml_table_in(reader.root, "metadata");
+        if (metadata) {
+            toml_datum_t d = toml_int_in(metadata, "version");
+            if (d.ok) {
+                result.save_version = (int)d.u.i;
+                has_version = true;
             }
         }
     }
 
-    // Create reader
-    Agentite_SaveReader reader = {0};
-    reader.root = root;
-    reader.game_state = toml_table_in(root, "game_state");
+    if (has_version) {
+        if (result.save_version < sm->min_compatible) {
+            snprintf(result.error_message, sizeof(result.error_message),
+                     "Save version %d is too old (min: %d)",
+                     result.save_version, sm->min_compatible);
+            if (reader.root) toml_free(reader.root);
+            bin_close(reader.binary);
+            return result;
+        }
+
+        if (result.save_version != sm->version) {
+            result.was_migrated = true;
+        }
+    }
+
+    // Readers start in the game_state section
+    agentite_save_read_enter_section(&reader, "game_state");
 
     // Let game deserialize its state
     bool success = deserialize(game_state, &reader);
 
-    toml_free(root);
+    if (reader.root) toml_free(reader.root);
+    bin_close(reader.binary);
 
     if (success) {
         result.success = true;
@@ -245,6 +1212,69 @@ Agentite_SaveResult agentite_save_auto(Agentite_SaveManager *sm,
     return agentite_save_game(sm, "autosave", serialize, game_state);
 }
 
+// Length of the save extension (.toml or .sav) on a filename, or 0
+static size_t save_extension_length(const char *filename) {
+    size_t len = strlen(filename);
+    if (len > 5 && strcmp(filename + len - 5, ".toml") == 0) return 5;
+    if (len > 4 && strcmp(filename + len - 4, ".sav") == 0) return 4;
+    return 0;
+}
+
+static void read_toml_save_info(const Agentite_SaveManager *sm, const char *filepath,
+                                Agentite_SaveInfo *info) {
+    FILE *fp = fopen(filepath, "r");
+    if (!fp) return;
+
+    char errbuf[256];
+    toml_table_t *root = toml_parse_file(fp, errbuf, sizeof(errbuf));
+    fclose(fp);
+    if (!root) return;
+
+    toml_table_t *metadata = toml_table_in(root, "metadata");
+    if (metadata) {
+        toml_datum_t d = toml_int_in(metadata, "version");
+        if (d.ok) {
+            info->version = (int)d.u.i;
+            info->is_compatible = info->version >= sm->min_compatible;
+        }
+
+        d = toml_string_in(metadata, "timestamp");
+        if (d.ok) {
+            strncpy(info->timestamp, d.u.s, sizeof(info->timestamp) - 1);
+            free(d.u.s);
+        }
+    }
+
+    // Try to read preview data from game_state
+    toml_table_t *gs = toml_table_in(root, "game_state");
+    if (gs) {
+        toml_datum_t d = toml_int_in(gs, "turn");
+        if (d.ok) info->preview_turn = (int)d.u.i;
+    }
+
+    toml_free(root);
+}
+
+// Binary saves only touch the header, index and metadata section
+static void read_binary_save_info(const Agentite_SaveManager *sm, const char *filepath,
+                                  Agentite_SaveInfo *info) {
+    char errbuf[64];
+    Agentite_SaveReader reader = {0};
+    reader.binary = bin_open(filepath, errbuf, sizeof(errbuf));
+    if (!reader.binary) return;
+
+    info->version = reader.binary->game_version;
+    info->is_compatible = info->version >= sm->min_compatible;
+
+    if (agentite_save_read_enter_section(&reader, "metadata")) {
+        agentite_save_read_string(&reader, "timestamp", info->timestamp,
+                                  sizeof(info->timestamp));
+        agentite_save_read_int(&reader, "preview_turn", &info->preview_turn);
+    }
+
+    bin_close(reader.binary);
+}
+
 Agentite_SaveInfo *agentite_save_list(const Agentite_SaveManager *sm, int *out_count) {
     if (!sm || !out_count) return NULL;
 
@@ -253,12 +1283,11 @@ Agentite_SaveInfo *agentite_save_list(const Agentite_SaveManager *sm, int *out_c
     DIR *dir = opendir(sm->saves_dir);
     if (!dir) return NULL;
 
-    // First pass: count .toml files
+    // First pass: count save files
     int capacity = 0;
     struct dirent *entry;
     while ((entry = readdir(dir)) != NULL) {
-        size_t len = strlen(entry->d_name);
-        if (len > 5 && strcmp(entry->d_name + len - 5, ".toml") == 0) {
+        if (save_extension_length(entry->d_name) > 0) {
             capacity++;
         }
     }
@@ -279,56 +1308,29 @@ Agentite_SaveInfo *agentite_save_list(const Agentite_SaveManager *sm, int *out_c
     int count = 0;
 
     while ((entry = readdir(dir)) != NULL && count < capacity) {
-        size_t len = strlen(entry->d_name);
-        if (len <= 5 || strcmp(entry->d_name + len - 5, ".toml") != 0) {
+        size_t ext_len = save_extension_length(entry->d_name);
+        if (ext_len == 0) {
             continue;
         }
 
         Agentite_SaveInfo *info = &list[count];
         strncpy(info->filename, entry->d_name, sizeof(info->filename) - 1);
 
-        // Remove .toml extension for display name
+        // Remove extension for display name
         strncpy(info->display_name, entry->d_name, sizeof(info->display_name) - 1);
         size_t name_len = strlen(info->display_name);
-        if (name_len > 5) {
-            info->display_name[name_len - 5] = '\0';
+        if (name_len > ext_len) {
+            info->display_name[name_len - ext_len] = '\0';
         }
 
         // Try to read metadata from file
         char filepath[AGENTITE_SAVE_MAX_PATH];
         snprintf(filepath, sizeof(filepath), "%s/%s", sm->saves_dir, entry->d_name);
 
-        FILE *fp = fopen(filepath, "r");
-        if (fp) {
-            char errbuf[256];
-            toml_table_t *root = toml_parse_file(fp, errbuf, sizeof(errbuf));
-            fclose(fp);
-
-            if (root) {
-                toml_table_t *metadata = toml_table_in(root, "metadata");
-                if (metadata) {
-                    toml_datum_t d = toml_int_in(metadata, "version");
-                    if (d.ok) {
-                        info->version = (int)d.u.i;
-                        info->is_compatible = info->version >= sm->min_compatible;
-                    }
-
-                    d = toml_string_in(metadata, "timestamp");
-                    if (d.ok) {
-                        strncpy(info->timestamp, d.u.s, sizeof(info->timestamp) - 1);
-                        free(d.u.s);
-                    }
-                }
-
-                // Try to read preview data from game_state
-                toml_table_t *gs = toml_table_in(root, "game_state");
-                if (gs) {
-                    toml_datum_t d = toml_int_in(gs, "turn");
-                    if (d.ok) info->preview_turn = (int)d.u.i;
-                }
-
-                toml_free(root);
-            }
+        if (ext_len == 4) {
+            read_binary_save_info(sm, filepath, info);
+        } else {
+            read_toml_save_info(sm, filepath, info);
         }
 
         count++;
@@ -348,9 +1350,14 @@ bool agentite_save_delete(Agentite_SaveManager *sm, const char *save_name) {
     if (!is_valid_save_name(save_name)) return false;
 
     char filepath[AGENTITE_SAVE_MAX_PATH];
-    build_save_path(sm, save_name, filepath, sizeof(filepath));
+    bool removed = false;
+
+    build_save_path(sm, save_name, AGENTITE_SAVE_FORMAT_TOML, filepath, sizeof(filepath));
+    if (remove(filepath) == 0) removed = true;
+    build_save_path(sm, save_name, AGENTITE_SAVE_FORMAT_BINARY, filepath, sizeof(filepath));
+    if (remove(filepath) == 0) removed = true;
 
-    return remove(filepath) == 0;
+    return removed;
 }
 
 bool agentite_save_exists(const Agentite_SaveManager *sm, const char *save_name) {
@@ -358,10 +1365,278 @@ bool agentite_save_exists(const Agentite_SaveManager *sm, const char *save_name)
     if (!is_valid_save_name(save_name)) return false;
 
     char filepath[AGENTITE_SAVE_MAX_PATH];
-    build_save_path(sm, save_name, filepath, sizeof(filepath));
+    Agentite_SaveFormat format;
+    return find_save_path(sm, save_name, filepath, sizeof(filepath), &format);
+}
 
-    struct stat st;
-    return stat(filepath, &st) == 0;
+// Format conversion
+
+// Write every value of a TOML table, then recurse into child tables as dotted sections
+static void convert_toml_table(Agentite_SaveWriter *w, toml_table_t *tab, const char *name) {
+    if (toml_table_nkval(tab) + toml_table_narr(tab) > 0) {
+        agentite_save_write_section(w, name);
+    }
+
+    const char *key;
+    for (int i = 0; (key = toml_key_in(tab, i)) != NULL; i++) {
+        toml_datum_t d = toml_int_in(tab, key);
+        if (d.ok) {
+            if (d.u.i >= INT32_MIN && d.u.i <= INT32_MAX) {
+                agentite_save_write_int(w, key, (int)d.u.i);
+            } else {
+                agentite_save_write_int64(w, key, (long long)d.u.i);
+            }
+            continue;
+        }
+
+        d = toml_double_in(tab, key);
+        if (d.ok) {
+            agentite_save_write_double(w, key, d.u.d);
+            continue;
+        }
+
+        d = toml_bool_in(tab, key);
+        if (d.ok) {
+            agentite_save_write_bool(w, key, d.u.b != 0);
+            continue;
+        }
+
+        d = toml_string_in(tab, key);
+        if (d.ok) {
+            agentite_save_write_string(w, key, d.u.s);
+            free(d.u.s);
+            continue;
+        }
+
+        toml_array_t *arr = toml_array_in(tab, key);
+        int count = arr ? toml_array_nelem(arr) : 0;
+        if (count > 0 && toml_array_kind(arr) == 'v') {
+            char type = toml_array_type(arr);
+            if (type == 'i') {
+                int *values = AGENTITE_MALLOC_ARRAY(int, count);
+                if (!values) continue;
+                for (int j = 0; j < count; j++) {
+                    toml_datum_t v = toml_int_at(arr, j);
+                    values[j] = v.ok ? (int)v.u.i : 0;
+                }
+                agentite_save_write_int_array(w, key, values, count);
+                free(values);
+            } else if (type == 'd') {
+                float *values = AGENTITE_MALLOC_ARRAY(float, count);
+                if (!values) continue;
+                for (int j = 0; j < count; j++) {
+                    toml_datum_t v = toml_double_at(arr, j);
+                    values[j] = v.ok ? (float)v.u.d : 0.0f;
+                }
+                agentite_save_write_float_array(w, key, values, count);
+                free(values);
+            }
+        }
+    }
+
+    for (int i = 0; (key = toml_key_in(tab, i)) != NULL; i++) {
+        toml_table_t *child = toml_table_in(tab, key);
+        if (!child) continue;
+
+        char child_name[SAVE_BIN_SECTION_NAME_MAX];
+        snprintf(child_name, sizeof(child_name), "%s.%s", name, key);
+        convert_toml_table(w, child, child_name);
+    }
+}
+
+static bool convert_from_toml(const char *src_path, FILE *out, Agentite_SaveFormat format,
+                              bool compress, Agentite_SaveResult *result) {
+    FILE *fp = fopen(src_path, "r");
+    if (!fp) {
+        snprintf(result->error_message, sizeof(result->error_message),
+                 "Save file not found: %s", src_path);
+        return false;
+    }
+
+    char errbuf[256];
+    toml_table_t *root = toml_parse_file(fp, errbuf, sizeof(errbuf));
+    fclose(fp);
+    if (!root) {
+        snprintf(result->error_message, sizeof(result->error_message),
+                 "Parse error: %s", errbuf);
+        return false;
+    }
+
+    int version = 0;
+    char timestamp[32] = {0};
+    char save_name[AGENTITE_SAVE_MAX_NAME] = {0};
+
+    toml_table_t *metadata = toml_table_in(root, "metadata");
+    if (metadata) {
+        toml_datum_t d = toml_int_in(metadata, "version");
+        if (d.ok) version = (int)d.u.i;
+
+        d = toml_string_in(metadata, "timestamp");
+        if (d.ok) {
+            strncpy(timestamp, d.u.s, sizeof(timestamp) - 1);
+            free(d.u.s);
+        }
+
+        d = toml_string_in(metadata, "save_name");
+        if (d.ok) {
+            strncpy(save_name, d.u.s, sizeof(save_name) - 1);
+            free(d.u.s);
+        }
+    }
+    result->save_version = version;
+
+    Agentite_SaveWriter writer;
+    bool ok = writer_begin(&writer, out, format, compress, version, timestamp, save_name);
+
+    const char *key;
+    for (int i = 0; (key = toml_key_in(root, i)) != NULL; i++) {
+        toml_table_t *tab = toml_table_in(root, key);
+        if (!tab || strcmp(key, "metadata") == 0) continue;
+        convert_toml_table(&writer, tab, key);
+    }
+
+    ok = writer_end(&writer, true) && ok;
+    toml_free(root);
+    return ok;
+}
+
+static bool convert_from_binary(const char *src_path, FILE *out, Agentite_SaveFormat format,
+                                bool compress, Agentite_SaveResult *result) {
+    char errbuf[256];
+    Agentite_SaveReader reader = {0};
+    reader.binary = bin_open(src_path, errbuf, sizeof(errbuf));
+    if (!reader.binary) {
+        snprintf(result->error_message, sizeof(result->error_message),
+                 "Load error: %s", errbuf);
+        return false;
+    }
+    Agentite_SaveBinary *bin = reader.binary;
+
+    char timestamp[32] = {0};
+    char save_name[AGENTITE_SAVE_MAX_NAME] = {0};
+    if (agentite_save_read_enter_section(&reader, "metadata")) {
+        agentite_save_read_string(&reader, "timestamp", timestamp, sizeof(timestamp));
+        agentite_save_read_string(&reader, "save_name", save_name, sizeof(save_name));
+    }
+    result->save_version = bin->game_version;
+
+    Agentite_SaveWriter writer;
+    bool ok = writer_begin(&writer, out, format, compress, bin->game_version,
+                           timestamp, save_name);
+
+    for (uint32_t i = 0; i < bin->section_count && ok; i++) {
+        SaveBinSection *sec = &bin->sections[i];
+        if (strcmp(sec->entry.name, "metadata") == 0) continue;
+        if (!bin_load_section(bin, sec)) {
+            snprintf(result->error_message, sizeof(result->error_message),
+                     "Load error: corrupt section '%s'", sec->entry.name);
+            ok = false;
+            break;
+        }
+
+        agentite_save_write_section(&writer, sec->entry.name);
+
+        size_t pos = 0;
+        SaveBinRecord rec;
+        while (pos < sec->entry.raw_size && bin_record_at(sec, pos, &rec, &pos)) {
+            const void *values = rec.payload + SAVE_BIN_ARRAY_PREFIX;
+            int count = (int)((rec.payload_size - SAVE_BIN_ARRAY_PREFIX) / 4);
+            int32_t i32;
+            int64_t i64;
+            float f32;
+            double f64;
+
+            switch (rec.type) {
+                case SAVE_REC_INT:
+                    memcpy(&i32, rec.payload, sizeof(i32));
+                    agentite_save_write_int(&writer, rec.key, i32);
+                    break;
+                case SAVE_REC_INT64:
+                    memcpy(&i64, rec.payload, sizeof(i64));
+                    agentite_save_write_int64(&writer, rec.key, (long long)i64);
+                    break;
+                case SAVE_REC_FLOAT:
+                    memcpy(&f32, rec.payload, sizeof(f32));
+                    agentite_save_write_float(&writer, rec.key, f32);
+                    break;
+                case SAVE_REC_DOUBLE:
+                    memcpy(&f64, rec.payload, sizeof(f64));
+                    agentite_save_write_double(&writer, rec.key, f64);
+                    break;
+                case SAVE_REC_BOOL:
+                    agentite_save_write_bool(&writer, rec.key, rec.payload[0] != 0);
+                    break;
+                case SAVE_REC_STRING:
+                    agentite_save_write_string(&writer, rec.key, (const char *)rec.payload);
+                    break;
+                case SAVE_REC_INT_ARRAY: {
+                    int *arr = AGENTITE_MALLOC_ARRAY(int, count);
+                    if (arr) {
+                        memcpy(arr, values, (size_t)count * sizeof(int));
+                        agentite_save_write_int_array(&writer, rec.key, arr, count);
+                        free(arr);
+                    }
+                    break;
+                }
+                case SAVE_REC_FLOAT_ARRAY: {
+                    float *arr = AGENTITE_MALLOC_ARRAY(float, count);
+                    if (arr) {
+                        memcpy(arr, values, (size_t)count * sizeof(float));
+                        agentite_save_write_float_array(&writer, rec.key, arr, count);
+                        free(arr);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    ok = writer_end(&writer, ok) && ok;
+    bin_close(bin);
+    return ok;
+}
+
+Agentite_SaveResult agentite_save_convert(const char *src_path, const char *dst_path,
+                                          Agentite_SaveFormat format, bool compress) {
+    Agentite_SaveResult result = {0};
+
+    if (!src_path || !dst_path || strcmp(src_path, dst_path) == 0) {
+        snprintf(result.error_message, sizeof(result.error_message),
+                 "Invalid parameters");
+        return result;
+    }
+
+    strncpy(result.filepath, dst_path, sizeof(result.filepath) - 1);
+
+    Agentite_SaveFormat src_format;
+    if (!detect_save_format(src_path, &src_format)) {
+        snprintf(result.error_message, sizeof(result.error_message),
+                 "Save file not found: %s", src_path);
+        return result;
+    }
+
+    FILE *out = fopen(dst_path, format == AGENTITE_SAVE_FORMAT_BINARY ? "wb" : "w");
+    if (!out) {
+        snprintf(result.error_message, sizeof(result.error_message),
+                 "Cannot create save file: %s", dst_path);
+        return result;
+    }
+
+    bool ok = src_format == AGENTITE_SAVE_FORMAT_BINARY
+        ? convert_from_binary(src_path, out, format, compress, &result)
+        : convert_from_toml(src_path, out, format, compress, &result);
+    fclose(out);
+
+    if (ok) {
+        result.success = true;
+    } else {
+        if (!result.error_message[0]) {
+            snprintf(result.error_message, sizeof(result.error_message),
+                     "Write failed: %s", dst_path);
+        }
+        remove(dst_path);
+    }
+    return result;
 }
 
 // Writer API implementation
@@ -369,39 +1644,81 @@ bool agentite_save_exists(const Agentite_SaveManager *sm, const char *save_name)
 void agentite_save_write_section(Agentite_SaveWriter *w, const char *section_name) {
     if (!w || !w->fp || !section_name) return;
 
-    fprintf(w->fp, "\n[%s]\n", section_name);
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        bin_flush_section(w);
+        if (strlen(section_name) >= sizeof(w->current_section)) {
+            w->failed = true;
+            return;
+        }
+    } else {
+        fprintf(w->fp, "\n[%s]\n", section_name);
+    }
     strncpy(w->current_section, section_name, sizeof(w->current_section) - 1);
     w->in_section = true;
 }
 
 void agentite_save_write_int(Agentite_SaveWriter *w, const char *key, int value) {
     if (!w || !w->fp || !key) return;
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        // Remember the turn so the save list can preview it without loading game_state
+        if (strcmp(key, "turn") == 0 && strcmp(w->current_section, "game_state") == 0) {
+            w->preview_turn = value;
+            w->has_preview_turn = true;
+        }
+        int32_t v = value;
+        bin_write_record(w, SAVE_REC_INT, key, NULL, 0, &v, sizeof(v));
+        return;
+    }
     fprintf(w->fp, "%s = %d\n", key, value);
 }
 
 void agentite_save_write_int64(Agentite_SaveWriter *w, const char *key, long long value) {
     if (!w || !w->fp || !key) return;
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        int64_t v = value;
+        bin_write_record(w, SAVE_REC_INT64, key, NULL, 0, &v, sizeof(v));
+        return;
+    }
     fprintf(w->fp, "%s = %lld\n", key, value);
 }
 
 void agentite_save_write_float(Agentite_SaveWriter *w, const char *key, float value) {
     if (!w || !w->fp || !key) return;
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        bin_write_record(w, SAVE_REC_FLOAT, key, NULL, 0, &value, sizeof(value));
+        return;
+    }
     fprintf(w->fp, "%s = %f\n", key, value);
 }
 
 void agentite_save_write_double(Agentite_SaveWriter *w, const char *key, double value) {
     if (!w || !w->fp || !key) return;
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        bin_write_record(w, SAVE_REC_DOUBLE, key, NULL, 0, &value, sizeof(value));
+        return;
+    }
     fprintf(w->fp, "%s = %f\n", key, value);
 }
 
 void agentite_save_write_bool(Agentite_SaveWriter *w, const char *key, bool value) {
     if (!w || !w->fp || !key) return;
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        uint8_t v = value ? 1 : 0;
+        bin_write_record(w, SAVE_REC_BOOL, key, NULL, 0, &v, sizeof(v));
+        return;
+    }
     fprintf(w->fp, "%s = %s\n", key, value ? "true" : "false");
 }
 
 void agentite_save_write_string(Agentite_SaveWriter *w, const char *key, const char *value) {
     if (!w || !w->fp || !key) return;
 
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        if (!value) value = "";
+        bin_write_record(w, SAVE_REC_STRING, key, NULL, 0, value, strlen(value) + 1);
+        return;
+    }
+
     // Escape special characters in string
     fprintf(w->fp, "%s = \"", key);
     if (value) {
@@ -423,6 +1740,11 @@ void agentite_save_write_int_array(Agentite_SaveWriter *w, const char *key,
                                   const int *values, int count) {
     if (!w || !w->fp || !key || !values || count <= 0) return;
 
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        bin_write_array(w, SAVE_REC_INT_ARRAY, key, values, count, sizeof(int));
+        return;
+    }
+
     fprintf(w->fp, "%s = [", key);
     for (int i = 0; i < count; i++) {
         if (i > 0) fprintf(w->fp, ", ");
@@ -435,6 +1757,11 @@ void agentite_save_write_float_array(Agentite_SaveWriter *w, const char *key,
                                     const float *values, int count) {
     if (!w || !w->fp || !key || !values || count <= 0) return;
 
+    if (w->format == AGENTITE_SAVE_FORMAT_BINARY) {
+        bin_write_array(w, SAVE_REC_FLOAT_ARRAY, key, values, count, sizeof(float));
+        return;
+    }
+
     fprintf(w->fp, "%s = [", key);
     for (int i = 0; i < count; i++) {
         if (i > 0) fprintf(w->fp, ", ");
@@ -446,6 +1773,12 @@ void agentite_save_write_float_array(Agentite_SaveWriter *w, const char *key,
 // Reader API implementation
 
 bool agentite_save_read_int(Agentite_SaveReader *r, const char *key, int *out_value) {
+    if (r && r->binary) {
+        long long v;
+        if (!key || !out_value || !bin_read_int64(r->binary, key, &v)) return false;
+        *out_value = (int)v;
+        return true;
+    }
     if (!r || !r->game_state || !key || !out_value) return false;
 
     toml_datum_t d = toml_int_in(r->game_state, key);
@@ -456,6 +1789,9 @@ bool agentite_save_read_int(Agentite_SaveReader *r, const char *key, int *out_va
 }
 
 bool agentite_save_read_int64(Agentite_SaveReader *r, const char *key, long long *out_value) {
+    if (r && r->binary) {
+        return key && out_value && bin_read_int64(r->binary, key, out_value);
+    }
     if (!r || !r->game_state || !key || !out_value) return false;
 
     toml_datum_t d = toml_int_in(r->game_state, key);
@@ -466,6 +1802,12 @@ bool agentite_save_read_int64(Agentite_SaveReader *r, const char *key, long long
 }
 
 bool agentite_save_read_float(Agentite_SaveReader *r, const char *key, float *out_value) {
+    if (r && r->binary) {
+        double v;
+        if (!key || !out_value || !bin_read_double(r->binary, key, &v)) return false;
+        *out_value = (float)v;
+        return true;
+    }
     if (!r || !r->game_state || !key || !out_value) return false;
 
     toml_datum_t d = toml_double_in(r->game_state, key);
@@ -476,6 +1818,9 @@ bool agentite_save_read_float(Agentite_SaveReader *r, const char *key, float *ou
 }
 
 bool agentite_save_read_double(Agentite_SaveReader *r, const char *key, double *out_value) {
+    if (r && r->binary) {
+        return key && out_value && bin_read_double(r->binary, key, out_value);
+    }
     if (!r || !r->game_state || !key || !out_value) return false;
 
     toml_datum_t d = toml_double_in(r->game_state, key);
@@ -486,6 +1831,15 @@ bool agentite_save_read_double(Agentite_SaveReader *r, const char *key, double *
 }
 
 bool agentite_save_read_bool(Agentite_SaveReader *r, const char *key, bool *out_value) {
+    if (r && r->binary) {
+        SaveBinRecord rec;
+        if (!key || !out_value || !bin_find(r->binary, key, &rec) ||
+            rec.type != SAVE_REC_BOOL) {
+            return false;
+        }
+        *out_value = rec.payload[0] != 0;
+        return true;
+    }
     if (!r || !r->game_state || !key || !out_value) return false;
 
     toml_datum_t d = toml_bool_in(r->game_state, key);
@@ -497,6 +1851,16 @@ bool agentite_save_read_bool(Agentite_SaveReader *r, const char *key, bool *out_
 
 bool agentite_save_read_string(Agentite_SaveReader *r, const char *key,
                               char *out_buf, size_t buf_size) {
+    if (r && r->binary) {
+        SaveBinRecord rec;
+        if (!key || !out_buf || buf_size == 0 || !bin_find(r->binary, key, &rec) ||
+            rec.type != SAVE_REC_STRING) {
+            return false;
+        }
+        strncpy(out_buf, (const char *)rec.payload, buf_size - 1);
+        out_buf[buf_size - 1] = '\0';
+        return true;
+    }
     if (!r || !r->game_state || !key || !out_buf || buf_size == 0) return false;
 
     toml_datum_t d = toml_string_in(r->game_state, key);
@@ -510,6 +1874,11 @@ bool agentite_save_read_string(Agentite_SaveReader *r, const char *key,
 
 bool agentite_save_read_int_array(Agentite_SaveReader *r, const char *key,
                                  int **out_array, int *out_count) {
+    if (r && r->binary) {
+        return key && out_array && out_count &&
+               bin_read_array(r->binary, key, SAVE_REC_INT_ARRAY,
+                              (void **)out_array, out_count);
+    }
     if (!r || !r->game_state || !key || !out_array || !out_count) return false;
 
     toml_array_t *arr = toml_array_in(r->game_state, key);
@@ -537,6 +1906,11 @@ bool agentite_save_read_int_array(Agentite_SaveReader *r, const char *key,
 
 bool agentite_save_read_float_array(Agentite_SaveReader *r, const char *key,
                                    float **out_array, int *out_count) {
+    if (r && r->binary) {
+        return key && out_array && out_count &&
+               bin_read_array(r->binary, key, SAVE_REC_FLOAT_ARRAY,
+                              (void **)out_array, out_count);
+    }
     if (!r || !r->game_state || !key || !out_array || !out_count) return false;
 
     toml_array_t *arr = toml_array_in(r->game_state, key);
@@ -562,6 +1936,33 @@ bool agentite_save_read_float_array(Agentite_SaveReader *r, const char *key,
     return true;
 }
 
+bool agentite_save_read_enter_section(Agentite_SaveReader *r, const char *section_name) {
+    if (!r || !section_name) return false;
+
+    if (r->binary) {
+        return bin_enter_section(r->binary, section_name);
+    }
+    if (!r->root) return false;
+
+    // Dotted section names map to nested TOML tables
+    char path[SAVE_BIN_SECTION_NAME_MAX];
+    strncpy(path, section_name, sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+
+    toml_table_t *tab = r->root;
+    char *part = path;
+    while (tab && part) {
+        char *dot = strchr(part, '.');
+        if (dot) *dot = '\0';
+        tab = toml_table_in(tab, part);
+        part = dot ? dot + 1 : NULL;
+    }
+    if (!tab) return false;
+
+    r->game_state = tab;
+    return true;
+}
+
 toml_table_t *agentite_save_read_section(Agentite_SaveReader *r, const char *section_name) {
     if (!r || !r->root || !section_name) return NULL;
     return toml_table_in(r->root, section_name);
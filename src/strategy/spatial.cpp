@@ -3,7 +3,12 @@
  * @brief Spatial Hash Index implementation
  *
  * Uses open addressing with linear probing for the hash table.
- * Each bucket stores up to AGENTITE_SPATIAL_MAX_PER_CELL entities.
+ * Each bucket stores up to AGENTITE_SPATIAL_MAX_PER_CELL entities inline;
+ * further entities spill into chunks from a shared pool.
+ *
+ * A second, coarser table tracks 16x16 blocks of cells with an occupancy
+ * bitmask and entity count, so region queries probe one block per 256
+ * cells and only look up the cells whose bit is set.
  */
 
 #include "agentite/agentite.h"
@@ -11,9 +16,20 @@
 #include "agentite/error.h"
 #include "agentite/validate.h"
 
-#include <stdlib.h>
+#include <math.h>
+#include <stdint.h>
 #include <string.h>
 
+/* Block edge in cells; one uint16_t occupancy word per block row */
+#define SPATIAL_BLOCK_SHIFT 4
+#define SPATIAL_BLOCK_SIZE (1 << SPATIAL_BLOCK_SHIFT)
+
+/* Entities per overflow chunk */
+#define SPATIAL_SPILL_SIZE 16
+
+/* Block columns a region query keeps resolved per block row */
+#define SPATIAL_QUERY_BLOCK_CACHE 64
+
 /* ============================================================================
  * Internal Structures
  * ========================================================================= */
@@ -22,12 +38,33 @@
  * @brief Hash bucket for a single grid cell
  */
 typedef struct Agentite_SpatialBucket {
-    int32_t x;                                      /**< Grid X (-1 = empty) */
+    int32_t x;                                      /**< Grid X */
     int32_t y;                                      /**< Grid Y */
     uint32_t entities[AGENTITE_SPATIAL_MAX_PER_CELL]; /**< Entity IDs */
-    int count;                                      /**< Number of entities */
+    int count;                                      /**< Number of entities (inline + spilled) */
+    int32_t spill;                                  /**< First overflow chunk (-1 = none) */
+    bool used;                                      /**< Slot claimed by a cell (kept once emptied) */
 } Agentite_SpatialBucket;
 
+/**
+ * @brief Overflow chunk for cells holding more than MAX_PER_CELL entities
+ */
+typedef struct SpatialSpill {
+    uint32_t entities[SPATIAL_SPILL_SIZE];
+    int32_t next;                   /**< Next chunk of the cell, or next free chunk (-1 = end) */
+} SpatialSpill;
+
+/**
+ * @brief Coarse block of SPATIAL_BLOCK_SIZE x SPATIAL_BLOCK_SIZE cells
+ */
+typedef struct SpatialBlock {
+    int32_t bx;                                 /**< Block X (cell X >> SHIFT) */
+    int32_t by;                                 /**< Block Y */
+    uint16_t rows[SPATIAL_BLOCK_SIZE];          /**< Occupied-cell bit per column, per row */
+    int count;                                  /**< Entities in the block */
+    bool used;                                  /**< Slot holds a block */
+} SpatialBlock;
+
 /**
  * @brief Spatial index structure
  */
@@ -36,6 +73,19 @@ struct Agentite_SpatialIndex {
     int capacity;                   /**< Number of buckets */
     int occupied;                   /**< Number of occupied buckets */
     int total_entities;             /**< Total entities stored */
+
+    SpatialBlock *blocks;           /**< Block hash table */
+    int block_capacity;             /**< Number of block slots */
+    int block_count;                /**< Used block slots */
+    int32_t block_min_x;            /**< Bounds of all blocks (valid if block_count > 0) */
+    int32_t block_min_y;
+    int32_t block_max_x;
+    int32_t block_max_y;
+
+    SpatialSpill *spill;            /**< Overflow chunk pool */
+    int spill_capacity;             /**< Allocated chunks */
+    int spill_used;                 /**< Chunks ever handed out */
+    int32_t spill_free;             /**< Free chunk list (-1 = empty) */
 };
 
 /* ============================================================================
@@ -69,6 +119,17 @@ static inline uint32_t hash_coords(int x, int y) {
  * Internal Functions
  * ========================================================================= */
 
+/**
+ * @brief Mark an array of buckets as empty
+ */
+static void reset_buckets(Agentite_SpatialBucket *buckets, int capacity) {
+    for (int i = 0; i < capacity; i++) {
+        buckets[i].used = false;
+        buckets[i].count = 0;
+        buckets[i].spill = -1;
+    }
+}
+
 /**
  * @brief Find bucket for coordinates
  *
@@ -87,11 +148,13 @@ static Agentite_SpatialBucket *find_bucket(Agentite_SpatialIndex *index, int x,
         Agentite_SpatialBucket *bucket = &index->buckets[i];
 
         /* Empty bucket */
-        if (bucket->x == -1 && bucket->count == 0) {
+        if (!bucket->used) {
             if (create) {
+                bucket->used = true;
                 bucket->x = x;
                 bucket->y = y;
                 bucket->count = 0;
+                bucket->spill = -1;
                 index->occupied++;
                 return bucket;
             }
@@ -123,7 +186,7 @@ static const Agentite_SpatialBucket *find_bucket_const(const Agentite_SpatialInd
         const Agentite_SpatialBucket *bucket = &index->buckets[i];
 
         /* Empty bucket */
-        if (bucket->x == -1 && bucket->count == 0) {
+        if (!bucket->used) {
             return NULL;
         }
 
@@ -150,12 +213,7 @@ static bool grow_table(Agentite_SpatialIndex *index) {
         agentite_set_error("Spatial: Failed to allocate buckets");
         return false;
     }
-
-    /* Mark all new buckets as empty */
-    for (int i = 0; i < new_capacity; i++) {
-        new_buckets[i].x = -1;
-        new_buckets[i].count = 0;
-    }
+    reset_buckets(new_buckets, new_capacity);
 
     /* Rehash existing entries */
     Agentite_SpatialBucket *old_buckets = index->buckets;
@@ -167,19 +225,202 @@ static bool grow_table(Agentite_SpatialIndex *index) {
 
     for (int i = 0; i < old_capacity; i++) {
         Agentite_SpatialBucket *old = &old_buckets[i];
-        if (old->x != -1 && old->count > 0) {
+        if (old->used && old->count > 0) {
             Agentite_SpatialBucket *bucket = find_bucket(index, old->x, old->y, true);
             if (bucket) {
-                memcpy(bucket->entities, old->entities, old->count * sizeof(uint32_t));
-                bucket->count = old->count;
+                *bucket = *old;
+            }
+        }
+    }
+
+    AGENTITE_FREE(old_buckets);
+    return true;
+}
+
+/* ============================================================================
+ * Block Layer
+ * ========================================================================= */
+
+/* Arithmetic shift rounds toward negative infinity, so -1 lands in block -1 */
+static inline int block_coord(int c) {
+    return c >> SPATIAL_BLOCK_SHIFT;
+}
+
+static inline int block_origin(int b) {
+    return b * SPATIAL_BLOCK_SIZE;
+}
+
+/* Block probes dominate wide queries, so they use a single multiply
+ * instead of the per-byte FNV loop */
+static inline uint32_t hash_block(int bx, int by) {
+    return (uint32_t)((pack_coords(bx, by) * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static const SpatialBlock *find_block_const(const Agentite_SpatialIndex *index, int bx, int by) {
+    uint32_t mask = (uint32_t)index->block_capacity - 1;
+    uint32_t i = hash_block(bx, by) & mask;
+
+    for (;;) {
+        const SpatialBlock *block = &index->blocks[i];
+        if (!block->used) {
+            return NULL;
+        }
+        if (block->bx == bx && block->by == by) {
+            return block;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+/**
+ * @brief Insert a block into a table known to have a free slot
+ */
+static SpatialBlock *insert_block(SpatialBlock *blocks, int capacity, int bx, int by) {
+    uint32_t mask = (uint32_t)capacity - 1;
+    uint32_t i = hash_block(bx, by) & mask;
+
+    while (blocks[i].used) {
+        if (blocks[i].bx == bx && blocks[i].by == by) {
+            return &blocks[i];
+        }
+        i = (i + 1) & mask;
+    }
+
+    blocks[i].used = true;
+    blocks[i].bx = bx;
+    blocks[i].by = by;
+    return &blocks[i];
+}
+
+/**
+ * @brief Find or create the block containing a cell
+ *
+ * Blocks are never removed; an emptied block keeps its slot with count 0.
+ */
+static SpatialBlock *get_block(Agentite_SpatialIndex *index, int x, int y) {
+    int bx = block_coord(x);
+    int by = block_coord(y);
+
+    SpatialBlock *block = (SpatialBlock *)find_block_const(index, bx, by);
+    if (block) {
+        return block;
+    }
+
+    /* Keep the power-of-two table under 0.7 load */
+    if ((index->block_count + 1) * 10 > index->block_capacity * 7) {
+        int new_capacity = index->block_capacity * 2;
+        SpatialBlock *new_blocks = AGENTITE_ALLOC_ARRAY(SpatialBlock, new_capacity);
+        if (!new_blocks) {
+            agentite_set_error("Spatial: Failed to allocate blocks");
+            return NULL;
+        }
+        for (int i = 0; i < index->block_capacity; i++) {
+            const SpatialBlock *old = &index->blocks[i];
+            if (old->used) {
+                *insert_block(new_blocks, new_capacity, old->bx, old->by) = *old;
             }
         }
+        AGENTITE_FREE(index->blocks);
+        index->blocks = new_blocks;
+        index->block_capacity = new_capacity;
+    }
+
+    if (index->block_count == 0) {
+        index->block_min_x = index->block_max_x = bx;
+        index->block_min_y = index->block_max_y = by;
+    } else {
+        if (bx < index->block_min_x) index->block_min_x = bx;
+        if (bx > index->block_max_x) index->block_max_x = bx;
+        if (by < index->block_min_y) index->block_min_y = by;
+        if (by > index->block_max_y) index->block_max_y = by;
+    }
+    index->block_count++;
+    return insert_block(index->blocks, index->block_capacity, bx, by);
+}
+
+/* ============================================================================
+ * Overflow Pool
+ * ========================================================================= */
+
+static int32_t spill_alloc(Agentite_SpatialIndex *index) {
+    if (index->spill_free != -1) {
+        int32_t chunk = index->spill_free;
+        index->spill_free = index->spill[chunk].next;
+        index->spill[chunk].next = -1;
+        return chunk;
+    }
+
+    if (index->spill_used == index->spill_capacity) {
+        int new_capacity = index->spill_capacity ? index->spill_capacity * 2 : 16;
+        SpatialSpill *spill = AGENTITE_REALLOC(index->spill, SpatialSpill, new_capacity);
+        if (!spill) {
+            agentite_set_error("Spatial: Failed to allocate overflow pool");
+            return -1;
+        }
+        index->spill = spill;
+        index->spill_capacity = new_capacity;
     }
 
-    free(old_buckets);
+    int32_t chunk = index->spill_used++;
+    index->spill[chunk].next = -1;
+    return chunk;
+}
+
+/**
+ * @brief Storage for the i-th entity of a cell (i < count, or i == count
+ *        when the chunk holding it has already been linked)
+ */
+static uint32_t *bucket_slot(const Agentite_SpatialIndex *index,
+                             const Agentite_SpatialBucket *bucket, int i) {
+    if (i < AGENTITE_SPATIAL_MAX_PER_CELL) {
+        return (uint32_t *)&bucket->entities[i];
+    }
+
+    i -= AGENTITE_SPATIAL_MAX_PER_CELL;
+    int32_t chunk = bucket->spill;
+    while (i >= SPATIAL_SPILL_SIZE) {
+        chunk = index->spill[chunk].next;
+        i -= SPATIAL_SPILL_SIZE;
+    }
+    return &index->spill[chunk].entities[i];
+}
+
+/**
+ * @brief Link a fresh chunk after the cell's last one
+ */
+static bool spill_append(Agentite_SpatialIndex *index, Agentite_SpatialBucket *bucket) {
+    int32_t chunk = spill_alloc(index);
+    if (chunk == -1) {
+        return false;
+    }
+
+    if (bucket->spill == -1) {
+        bucket->spill = chunk;
+    } else {
+        int32_t tail = bucket->spill;
+        while (index->spill[tail].next != -1) {
+            tail = index->spill[tail].next;
+        }
+        index->spill[tail].next = chunk;
+    }
     return true;
 }
 
+/**
+ * @brief Return the cell's last chunk to the free list
+ */
+static void spill_release_tail(Agentite_SpatialIndex *index, Agentite_SpatialBucket *bucket) {
+    int32_t *link = &bucket->spill;
+    while (index->spill[*link].next != -1) {
+        link = &index->spill[*link].next;
+    }
+
+    int32_t chunk = *link;
+    *link = -1;
+    index->spill[chunk].next = index->spill_free;
+    index->spill_free = chunk;
+}
+
 /* ============================================================================
  * Creation and Destruction
  * ========================================================================= */
@@ -196,38 +437,54 @@ Agentite_SpatialIndex *agentite_spatial_create(int capacity) {
     index->buckets = AGENTITE_ALLOC_ARRAY(Agentite_SpatialBucket, capacity);
     if (!index->buckets) {
         agentite_set_error("Spatial: Failed to allocate buckets");
-        free(index);
+        AGENTITE_FREE(index);
         return NULL;
     }
 
     /* Mark all buckets as empty */
-    for (int i = 0; i < capacity; i++) {
-        index->buckets[i].x = -1;
-        index->buckets[i].count = 0;
-    }
+    reset_buckets(index->buckets, capacity);
 
     index->capacity = capacity;
     index->occupied = 0;
     index->total_entities = 0;
 
+    /* Sparse maps rarely put more than a few cells in one block */
+    index->block_capacity = 16;
+    while (index->block_capacity * 4 < capacity) {
+        index->block_capacity *= 2;
+    }
+    index->blocks = AGENTITE_ALLOC_ARRAY(SpatialBlock, index->block_capacity);
+    if (!index->blocks) {
+        agentite_set_error("Spatial: Failed to allocate blocks");
+        AGENTITE_FREE(index->buckets);
+        AGENTITE_FREE(index);
+        return NULL;
+    }
+
+    index->spill_free = -1;
     return index;
 }
 
 void agentite_spatial_destroy(Agentite_SpatialIndex *index) {
     if (!index) return;
-    free(index->buckets);
-    free(index);
+    AGENTITE_FREE(index->spill);
+    AGENTITE_FREE(index->blocks);
+    AGENTITE_FREE(index->buckets);
+    AGENTITE_FREE(index);
 }
 
 void agentite_spatial_clear(Agentite_SpatialIndex *index) {
     AGENTITE_VALIDATE_PTR(index);
 
-    for (int i = 0; i < index->capacity; i++) {
-        index->buckets[i].x = -1;
-        index->buckets[i].count = 0;
-    }
+    reset_buckets(index->buckets, index->capacity);
     index->occupied = 0;
     index->total_entities = 0;
+
+    memset(index->blocks, 0, (size_t)index->block_capacity * sizeof(SpatialBlock));
+    index->block_count = 0;
+
+    index->spill_used = 0;
+    index->spill_free = -1;
 }
 
 /* ============================================================================
@@ -246,18 +503,30 @@ bool agentite_spatial_add(Agentite_SpatialIndex *index, int x, int y, uint32_t e
         }
     }
 
+    SpatialBlock *block = get_block(index, x, y);
+    if (!block) {
+        return false;
+    }
+
     Agentite_SpatialBucket *bucket = find_bucket(index, x, y, true);
     if (!bucket) {
         agentite_set_error("Spatial: Hash table full");
         return false;
     }
 
-    if (bucket->count >= AGENTITE_SPATIAL_MAX_PER_CELL) {
-        agentite_set_error("Spatial: Cell full (max %d entities)", AGENTITE_SPATIAL_MAX_PER_CELL);
-        return false;
+    /* Full inline storage and full chunks: spill into a new chunk */
+    int spilled = bucket->count - AGENTITE_SPATIAL_MAX_PER_CELL;
+    if (spilled >= 0 && spilled % SPATIAL_SPILL_SIZE == 0) {
+        if (!spill_append(index, bucket)) {
+            return false;
+        }
     }
 
-    bucket->entities[bucket->count++] = entity_id;
+    *bucket_slot(index, bucket, bucket->count) = entity_id;
+    if (bucket->count++ == 0) {
+        block->rows[y & (SPATIAL_BLOCK_SIZE - 1)] |= (uint16_t)(1u << (x & (SPATIAL_BLOCK_SIZE - 1)));
+    }
+    block->count++;
     index->total_entities++;
     return true;
 }
@@ -273,12 +542,27 @@ bool agentite_spatial_remove(Agentite_SpatialIndex *index, int x, int y, uint32_
 
     /* Find and remove entity */
     for (int i = 0; i < bucket->count; i++) {
-        if (bucket->entities[i] == entity_id) {
+        uint32_t *slot = bucket_slot(index, bucket, i);
+        if (*slot == entity_id) {
             /* Swap with last and decrement count */
-            bucket->entities[i] = bucket->entities[bucket->count - 1];
+            *slot = *bucket_slot(index, bucket, bucket->count - 1);
             bucket->count--;
             index->total_entities--;
 
+            int spilled = bucket->count - AGENTITE_SPATIAL_MAX_PER_CELL;
+            if (spilled >= 0 && spilled % SPATIAL_SPILL_SIZE == 0) {
+                spill_release_tail(index, bucket);
+            }
+
+            SpatialBlock *block = (SpatialBlock *)find_block_const(index, block_coord(x), block_coord(y));
+            if (block) {
+                block->count--;
+                if (bucket->count == 0) {
+                    block->rows[y & (SPATIAL_BLOCK_SIZE - 1)] &=
+                        (uint16_t)~(1u << (x & (SPATIAL_BLOCK_SIZE - 1)));
+                }
+            }
+
             /* Note: We don't remove empty buckets to avoid rehashing issues
              * with linear probing. Empty buckets act as tombstones. */
             return true;
@@ -343,7 +627,11 @@ int agentite_spatial_query_all(const Agentite_SpatialIndex *index, int x, int y,
     int count = bucket->count;
     if (count > max_entities) count = max_entities;
 
-    memcpy(out_entities, bucket->entities, count * sizeof(uint32_t));
+    int inline_count = count < AGENTITE_SPATIAL_MAX_PER_CELL ? count : AGENTITE_SPATIAL_MAX_PER_CELL;
+    memcpy(out_entities, bucket->entities, inline_count * sizeof(uint32_t));
+    for (int i = inline_count; i < count; i++) {
+        out_entities[i] = *bucket_slot(index, bucket, i);
+    }
     return count;
 }
 
@@ -364,7 +652,7 @@ bool agentite_spatial_has_entity(const Agentite_SpatialIndex *index, int x, int
     }
 
     for (int i = 0; i < bucket->count; i++) {
-        if (bucket->entities[i] == entity_id) {
+        if (*bucket_slot(index, bucket, i) == entity_id) {
             return true;
         }
     }
@@ -376,6 +664,94 @@ bool agentite_spatial_has_entity(const Agentite_SpatialIndex *index, int x, int
  * Region Queries
  * ========================================================================= */
 
+/**
+ * @brief Append every entity of one occupied cell to the results
+ */
+static int emit_cell(const Agentite_SpatialIndex *index, int x, int y,
+                     Agentite_SpatialQueryResult *out_results, int count, int max_results) {
+    const Agentite_SpatialBucket *bucket = find_bucket_const(index, x, y);
+    if (bucket) {
+        for (int i = 0; i < bucket->count && count < max_results; i++) {
+            out_results[count].entity_id = *bucket_slot(index, bucket, i);
+            out_results[count].x = x;
+            out_results[count].y = y;
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Collect entities in [x1, x2] x [y1, y2], row by row
+ *
+ * With circle set, each row is narrowed to the cells within radius of
+ * (center_x, center_y). Blocks without entities are skipped without looking
+ * at their cells, and inside a block only cells with their occupancy bit
+ * set are probed. Results come out in row-major order.
+ */
+static int query_region(const Agentite_SpatialIndex *index,
+                        int x1, int y1, int x2, int y2,
+                        bool circle, int center_x, int center_y, int64_t radius_sq,
+                        Agentite_SpatialQueryResult *out_results, int max_results) {
+    int bx1 = block_coord(x1), bx2 = block_coord(x2);
+    int by1 = block_coord(y1), by2 = block_coord(y2);
+    int64_t span = (int64_t)bx2 - bx1 + 1;
+    int cached = span < SPATIAL_QUERY_BLOCK_CACHE ? (int)span : SPATIAL_QUERY_BLOCK_CACHE;
+    const SpatialBlock *row_blocks[SPATIAL_QUERY_BLOCK_CACHE];
+    int count = 0;
+
+    for (int by = by1; by <= by2 && count < max_results; by++) {
+        /* Resolve this block row once; skip it whole when it is empty */
+        bool any = span > cached;
+        for (int i = 0; i < cached; i++) {
+            const SpatialBlock *block = find_block_const(index, bx1 + i, by);
+            row_blocks[i] = (block && block->count > 0) ? block : NULL;
+            any = any || row_blocks[i];
+        }
+        if (!any) continue;
+
+        /* Row offsets keep the loop clear of INT_MAX */
+        int origin_y = block_origin(by);
+        int r0 = by == by1 ? y1 - origin_y : 0;
+        int r1 = by == by2 ? y2 - origin_y : SPATIAL_BLOCK_SIZE - 1;
+
+        for (int r = r0; r <= r1 && count < max_results; r++) {
+            int y = origin_y + r;
+            int xa = x1, xb = x2;
+            if (circle) {
+                int64_t dy = (int64_t)y - center_y;
+                int64_t rem = radius_sq - dy * dy;
+                if (rem < 0) continue;
+                int64_t w = (int64_t)sqrt((double)rem);
+                while (w * w > rem) w--;
+                while ((w + 1) * (w + 1) <= rem) w++;
+                if (center_x - w > xa) xa = (int)(center_x - w);
+                if (center_x + w < xb) xb = (int)(center_x + w);
+            }
+
+            for (int bx = block_coord(xa); bx <= block_coord(xb) && count < max_results; bx++) {
+                int i = bx - bx1;
+                const SpatialBlock *block = i < cached ? row_blocks[i]
+                                                      : find_block_const(index, bx, by);
+                if (!block || block->count == 0) continue;
+
+                uint32_t bits = block->rows[r];
+                int origin_x = block_origin(bx);
+                if (bx == block_coord(xa)) bits &= ~0u << (xa - origin_x);
+                if (bx == block_coord(xb)) bits &= ~0u >> (31 - (xb - origin_x));
+
+                for (int c = 0; bits && count < max_results; c++, bits >>= 1) {
+                    if (bits & 1) {
+                        count = emit_cell(index, origin_x + c, y, out_results, count, max_results);
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
 int agentite_spatial_query_rect(const Agentite_SpatialIndex *index,
                               int x1, int y1, int x2, int y2,
                               Agentite_SpatialQueryResult *out_results, int max_results) {
@@ -387,23 +763,7 @@ int agentite_spatial_query_rect(const Agentite_SpatialIndex *index,
     if (x1 > x2) { int t = x1; x1 = x2; x2 = t; }
     if (y1 > y2) { int t = y1; y1 = y2; y2 = t; }
 
-    int count = 0;
-
-    for (int y = y1; y <= y2 && count < max_results; y++) {
-        for (int x = x1; x <= x2 && count < max_results; x++) {
-            const Agentite_SpatialBucket *bucket = find_bucket_const(index, x, y);
-            if (bucket && bucket->count > 0) {
-                for (int i = 0; i < bucket->count && count < max_results; i++) {
-                    out_results[count].entity_id = bucket->entities[i];
-                    out_results[count].x = x;
-                    out_results[count].y = y;
-                    count++;
-                }
-            }
-        }
-    }
-
-    return count;
+    return query_region(index, x1, y1, x2, y2, false, 0, 0, 0, out_results, max_results);
 }
 
 int agentite_spatial_query_radius(const Agentite_SpatialIndex *index,
@@ -424,28 +784,233 @@ int agentite_spatial_query_circle(const Agentite_SpatialIndex *index,
     AGENTITE_VALIDATE_PTR_RET(out_results, 0);
     if (max_results <= 0 || radius < 0) return 0;
 
-    int radius_sq = radius * radius;
-    int count = 0;
+    return query_region(index,
+                        center_x - radius, center_y - radius,
+                        center_x + radius, center_y + radius,
+                        true, center_x, center_y, (int64_t)radius * radius,
+                        out_results, max_results);
+}
 
-    for (int y = center_y - radius; y <= center_y + radius && count < max_results; y++) {
-        for (int x = center_x - radius; x <= center_x + radius && count < max_results; x++) {
-            int dx = x - center_x;
-            int dy = y - center_y;
-            if (dx * dx + dy * dy > radius_sq) continue;
-
-            const Agentite_SpatialBucket *bucket = find_bucket_const(index, x, y);
-            if (bucket && bucket->count > 0) {
-                for (int i = 0; i < bucket->count && count < max_results; i++) {
-                    out_results[count].entity_id = bucket->entities[i];
-                    out_results[count].x = x;
-                    out_results[count].y = y;
-                    count++;
-                }
+/* ============================================================================
+ * Nearest-Neighbour Queries
+ * ========================================================================= */
+
+/**
+ * @brief Running top-k state for one nearest query
+ */
+typedef struct SpatialNearest {
+    const Agentite_SpatialIndex *index;
+    int64_t cx;
+    int64_t cy;
+    int k;
+    int64_t limit_sq;               /**< Squared max radius */
+    Agentite_SpatialFilterFn filter_fn;
+    void *userdata;
+    Agentite_SpatialQueryResult *out;   /**< Sorted closest first */
+    int count;
+} SpatialNearest;
+
+static inline int64_t nearest_dist_sq(const SpatialNearest *q, int64_t x, int64_t y) {
+    return (x - q->cx) * (x - q->cx) + (y - q->cy) * (y - q->cy);
+}
+
+/**
+ * @brief Squared distance a candidate must beat (INT64_MAX until k are found)
+ */
+static inline int64_t nearest_worst_sq(const SpatialNearest *q) {
+    if (q->count < q->k) return INT64_MAX;
+    const Agentite_SpatialQueryResult *w = &q->out[q->count - 1];
+    return nearest_dist_sq(q, w->x, w->y);
+}
+
+/**
+ * @brief Insert a candidate into the sorted results (by distance, then ID)
+ */
+static void nearest_offer(SpatialNearest *q, uint32_t entity_id, int x, int y, int64_t d2) {
+    int i = q->count;
+    if (i == q->k) {
+        const Agentite_SpatialQueryResult *w = &q->out[i - 1];
+        int64_t wd2 = nearest_dist_sq(q, w->x, w->y);
+        if (d2 > wd2 || (d2 == wd2 && entity_id >= w->entity_id)) {
+            return;
+        }
+        i--;
+    } else {
+        q->count++;
+    }
+
+    while (i > 0) {
+        const Agentite_SpatialQueryResult *p = &q->out[i - 1];
+        int64_t pd2 = nearest_dist_sq(q, p->x, p->y);
+        if (pd2 < d2 || (pd2 == d2 && p->entity_id <= entity_id)) {
+            break;
+        }
+        q->out[i] = *p;
+        i--;
+    }
+    q->out[i].entity_id = entity_id;
+    q->out[i].x = x;
+    q->out[i].y = y;
+}
+
+/**
+ * @brief Offer every entity of one block that could still make the cut
+ */
+static void nearest_visit_block(SpatialNearest *q, int bx, int by) {
+    const SpatialBlock *block = find_block_const(q->index, bx, by);
+    if (!block || block->count == 0) return;
+
+    /* Closest point of the block to the query */
+    int64_t ox = block_origin(bx), oy = block_origin(by);
+    int64_t dx = q->cx < ox ? ox - q->cx : (q->cx > ox + SPATIAL_BLOCK_SIZE - 1 ? q->cx - (ox + SPATIAL_BLOCK_SIZE - 1) : 0);
+    int64_t dy = q->cy < oy ? oy - q->cy : (q->cy > oy + SPATIAL_BLOCK_SIZE - 1 ? q->cy - (oy + SPATIAL_BLOCK_SIZE - 1) : 0);
+    int64_t block_d2 = dx * dx + dy * dy;
+    if (block_d2 > q->limit_sq || block_d2 > nearest_worst_sq(q)) return;
+
+    for (int r = 0; r < SPATIAL_BLOCK_SIZE; r++) {
+        uint32_t bits = block->rows[r];
+        for (int c = 0; bits; c++, bits >>= 1) {
+            if (!(bits & 1)) continue;
+
+            int x = (int)(ox + c), y = (int)(oy + r);
+            int64_t d2 = nearest_dist_sq(q, x, y);
+            if (d2 > q->limit_sq || d2 > nearest_worst_sq(q)) continue;
+
+            const Agentite_SpatialBucket *bucket = find_bucket_const(q->index, x, y);
+            if (!bucket) continue;
+            for (int i = 0; i < bucket->count; i++) {
+                uint32_t id = *bucket_slot(q->index, bucket, i);
+                if (q->filter_fn && !q->filter_fn(id, x, y, q->userdata)) continue;
+                nearest_offer(q, id, x, y, d2);
             }
         }
     }
+}
 
-    return count;
+static int nearest_search(const Agentite_SpatialIndex *index, int x, int y, int k, int max_radius,
+                          Agentite_SpatialFilterFn filter_fn, void *userdata,
+                          Agentite_SpatialQueryResult *out_results) {
+    if (k <= 0 || index->total_entities == 0) return 0;
+
+    SpatialNearest q = {0};
+    q.index = index;
+    q.cx = x;
+    q.cy = y;
+    q.k = k;
+    q.limit_sq = max_radius >= 0 ? (int64_t)max_radius * max_radius : INT64_MAX;
+    q.filter_fn = filter_fn;
+    q.userdata = userdata;
+    q.out = out_results;
+
+    int bx0 = block_coord(x), by0 = block_coord(y);
+    int64_t lx = x - block_origin(bx0), ly = y - block_origin(by0);
+
+    /* Rings past every block's ring hold nothing */
+    int64_t reach = 0;
+    int64_t edges[4] = {
+        (int64_t)bx0 - index->block_min_x, (int64_t)index->block_max_x - bx0,
+        (int64_t)by0 - index->block_min_y, (int64_t)index->block_max_y - by0,
+    };
+    for (int i = 0; i < 4; i++) {
+        if (edges[i] > reach) reach = edges[i];
+    }
+
+    for (int64_t ring = 0; ring <= reach; ring++) {
+        /* Walk the ring's sides, clipped to the bounds of all blocks */
+        int64_t left = bx0 - ring, right = bx0 + ring;
+        int64_t top = by0 - ring, bottom = by0 + ring;
+        int64_t x_lo = left > index->block_min_x ? left : index->block_min_x;
+        int64_t x_hi = right < index->block_max_x ? right : index->block_max_x;
+        int64_t y_lo = top + 1 > index->block_min_y ? top + 1 : index->block_min_y;
+        int64_t y_hi = bottom - 1 < index->block_max_y ? bottom - 1 : index->block_max_y;
+
+        for (int64_t bx = x_lo; bx <= x_hi; bx++) {
+            if (top >= index->block_min_y) {
+                nearest_visit_block(&q, (int)bx, (int)top);
+            }
+            if (ring > 0 && bottom <= index->block_max_y) {
+                nearest_visit_block(&q, (int)bx, (int)bottom);
+            }
+        }
+        for (int64_t by = y_lo; by <= y_hi; by++) {
+            if (left >= index->block_min_x) {
+                nearest_visit_block(&q, (int)left, (int)by);
+            }
+            if (right <= index->block_max_x) {
+                nearest_visit_block(&q, (int)right, (int)by);
+            }
+        }
+
+        /* Cells of the next ring are at least this far away on some axis */
+        int64_t next = (ring + 1) * SPATIAL_BLOCK_SIZE - lx;
+        if (ring * SPATIAL_BLOCK_SIZE + lx + 1 < next) next = ring * SPATIAL_BLOCK_SIZE + lx + 1;
+        if ((ring + 1) * SPATIAL_BLOCK_SIZE - ly < next) next = (ring + 1) * SPATIAL_BLOCK_SIZE - ly;
+        if (ring * SPATIAL_BLOCK_SIZE + ly + 1 < next) next = ring * SPATIAL_BLOCK_SIZE + ly + 1;
+
+        if (next * next > q.limit_sq || next * next > nearest_worst_sq(&q)) {
+            break;
+        }
+    }
+
+    return q.count;
+}
+
+int agentite_spatial_query_nearest(const Agentite_SpatialIndex *index,
+                                   int x, int y, int k, int max_radius,
+                                   Agentite_SpatialFilterFn filter_fn, void *userdata,
+                                   Agentite_SpatialQueryResult *out_results) {
+    AGENTITE_VALIDATE_PTR_RET(index, 0);
+    AGENTITE_VALIDATE_PTR_RET(out_results, 0);
+
+    return nearest_search(index, x, y, k, max_radius, filter_fn, userdata, out_results);
+}
+
+/**
+ * @brief Shared arguments for a batched nearest query
+ */
+typedef struct SpatialNearestBatch {
+    const Agentite_SpatialIndex *index;
+    const Agentite_SpatialPoint *points;
+    int k;
+    int max_radius;
+    Agentite_SpatialFilterFn filter_fn;
+    void *userdata;
+    Agentite_SpatialQueryResult *out_results;
+    int *out_counts;
+} SpatialNearestBatch;
+
+static void nearest_batch_range(void *userdata, int begin, int end) {
+    const SpatialNearestBatch *b = (const SpatialNearestBatch *)userdata;
+    for (int i = begin; i < end; i++) {
+        b->out_counts[i] = nearest_search(b->index, b->points[i].x, b->points[i].y,
+                                          b->k, b->max_radius, b->filter_fn, b->userdata,
+                                          b->out_results + (size_t)i * b->k);
+    }
+}
+
+int agentite_spatial_query_nearest_batch(const Agentite_SpatialIndex *index,
+                                         Agentite_JobPool *jobs,
+                                         const Agentite_SpatialPoint *points, int point_count,
+                                         int k, int max_radius,
+                                         Agentite_SpatialFilterFn filter_fn, void *userdata,
+                                         Agentite_SpatialQueryResult *out_results,
+                                         int *out_counts) {
+    AGENTITE_VALIDATE_PTR_RET(index, 0);
+    AGENTITE_VALIDATE_PTR_RET(points, 0);
+    AGENTITE_VALIDATE_PTR_RET(out_results, 0);
+    AGENTITE_VALIDATE_PTR_RET(out_counts, 0);
+    if (point_count <= 0) return 0;
+
+    SpatialNearestBatch batch = {
+        index, points, k, max_radius, filter_fn, userdata, out_results, out_counts
+    };
+    agentite_job_parallel_for(jobs, point_count, 0, nearest_batch_range, &batch);
+
+    int total = 0;
+    for (int i = 0; i < point_count; i++) {
+        total += out_counts[i];
+    }
+    return total;
 }
 
 /* ============================================================================
@@ -484,7 +1049,7 @@ uint32_t agentite_spatial_iter_get(const Agentite_SpatialIterator *iter) {
         return AGENTITE_SPATIAL_INVALID;
     }
 
-    return bucket->entities[iter->current];
+    return *bucket_slot(iter->index, bucket, iter->current);
 }
 
 void agentite_spatial_iter_next(Agentite_SpatialIterator *iter) {
@@ -1,3 +1,4 @@
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_UI
 #include "agentite/agentite.h"
 #include "agentite/notification.h"
 #include "agentite/text.h"
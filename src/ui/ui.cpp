@@ -2,6 +2,8 @@
  * Agentite UI - Core Context and Lifecycle
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_UI
+#include "agentite/agentite.h"
 #include "agentite/ui.h"
 #include "agentite/error.h"
 #include <stdlib.h>
@@ -205,7 +207,7 @@ static void aui_init_theme(AUI_Context *ctx)
 AUI_Context *aui_init(SDL_GPUDevice *gpu, SDL_Window *window, int width, int height,
                       const char *font_path, float font_size)
 {
-    AUI_Context *ctx = (AUI_Context *)calloc(1, sizeof(AUI_Context));
+    AUI_Context *ctx = AGENTITE_ALLOC(AUI_Context);
     if (!ctx) {
         agentite_set_error("CUI: Failed to allocate context");
         return NULL;
@@ -223,8 +225,8 @@ AUI_Context *aui_init(SDL_GPUDevice *gpu, SDL_Window *window, int width, int hei
     /* Allocate vertex/index buffers (CPU side) */
     ctx->vertex_capacity = 65536;
     ctx->index_capacity = 98304;  /* 1.5x vertices for quads */
-    ctx->vertices = (AUI_Vertex *)malloc(ctx->vertex_capacity * sizeof(AUI_Vertex));
-    ctx->indices = (uint16_t *)malloc(ctx->index_capacity * sizeof(uint16_t));
+    ctx->vertices = AGENTITE_MALLOC_ARRAY(AUI_Vertex, ctx->vertex_capacity);
+    ctx->indices = AGENTITE_MALLOC_ARRAY(uint16_t, ctx->index_capacity);
 
     if (!ctx->vertices || !ctx->indices) {
         agentite_set_error("CUI: Failed to allocate vertex/index arrays");
@@ -267,10 +269,10 @@ void aui_shutdown(AUI_Context *ctx)
     aui_free_font(ctx);
     aui_state_clear(ctx);
 
-    free(ctx->vertices);
-    free(ctx->indices);
-    free(ctx->path_points);
-    free(ctx);
+    AGENTITE_FREE(ctx->vertices);
+    AGENTITE_FREE(ctx->indices);
+    AGENTITE_FREE(ctx->path_points);
+    AGENTITE_FREE(ctx);
 
     SDL_Log("CUI: Shutdown complete");
 }
@@ -4,6 +4,8 @@
  * Implements a draw command queue with layer sorting and multi-texture batching.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_UI
+#include "agentite/agentite.h"
 #include "agentite/ui.h"
 #include "agentite/error.h"
 #include <stdlib.h>
@@ -535,7 +537,7 @@ bool aui_create_pipeline(AUI_Context *ctx)
 
     /* Allocate draw command queue */
     ctx->draw_cmd_capacity = AUI_MAX_DRAW_CMDS;
-    ctx->draw_cmds = (AUI_DrawCmd *)calloc(ctx->draw_cmd_capacity, sizeof(AUI_DrawCmd));
+    ctx->draw_cmds = AGENTITE_ALLOC_ARRAY(AUI_DrawCmd, ctx->draw_cmd_capacity);
     if (!ctx->draw_cmds) {
         agentite_set_error("CUI: Failed to allocate draw command queue");
         return false;
@@ -594,7 +596,7 @@ void aui_destroy_pipeline(AUI_Context *ctx)
         SDL_ReleaseGPUTexture(ctx->gpu, ctx->white_texture);
         ctx->white_texture = NULL;
     }
-    free(ctx->draw_cmds);
+    AGENTITE_FREE(ctx->draw_cmds);
     ctx->draw_cmds = NULL;
 }
 
@@ -1631,7 +1633,7 @@ static void aui_path_ensure_capacity(AUI_Context *ctx, uint32_t needed)
     uint32_t new_capacity = ctx->path_capacity ? ctx->path_capacity * 2 : AUI_PATH_INITIAL_CAPACITY;
     while (new_capacity < needed) new_capacity *= 2;
 
-    float *new_points = (float *)realloc(ctx->path_points, new_capacity * 2 * sizeof(float));
+    float *new_points = AGENTITE_REALLOC(ctx->path_points, float, new_capacity * 2);
     if (new_points) {
         ctx->path_points = new_points;
         ctx->path_capacity = new_capacity;
@@ -2,6 +2,8 @@
  * Agentite UI - ID Generation and State Management
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_UI
+#include "agentite/agentite.h"
 #include "agentite/ui.h"
 #include <stdlib.h>
 #include <string.h>
@@ -110,7 +112,7 @@ AUI_WidgetState *aui_get_state(AUI_Context *ctx, AUI_Id id)
     }
 
     /* Create new entry */
-    entry = (AUI_StateEntry *)calloc(1, sizeof(AUI_StateEntry));
+    entry = AGENTITE_ALLOC(AUI_StateEntry);
     if (!entry) {
         return NULL;
     }
@@ -130,7 +132,7 @@ void aui_state_clear(AUI_Context *ctx)
         AUI_StateEntry *entry = ctx->state_table[i];
         while (entry) {
             AUI_StateEntry *next = entry->next;
-            free(entry);
+            AGENTITE_FREE(entry);
             entry = next;
         }
         ctx->state_table[i] = NULL;
@@ -147,7 +149,7 @@ void aui_state_gc(AUI_Context *ctx, uint64_t max_age)
             if (ctx->frame_count - entry->state.last_frame > max_age) {
                 /* Remove stale entry */
                 *pp = entry->next;
-                free(entry);
+                AGENTITE_FREE(entry);
             } else {
                 pp = &entry->next;
             }
@@ -2,6 +2,8 @@
  * Agentite UI - Retained Mode Node System Implementation
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_UI
+#include "agentite/agentite.h"
 #include "agentite/ui_node.h"
 #include "agentite/ui.h"
 #include "agentite/ui_charts.h"
@@ -285,7 +287,7 @@ AUI_Node *aui_node_create(AUI_Context *ctx, AUI_NodeType type, const char *name)
 {
     (void)ctx;
 
-    AUI_Node *node = (AUI_Node *)calloc(1, sizeof(AUI_Node));
+    AUI_Node *node = AGENTITE_ALLOC(AUI_Node);
     if (!node) return NULL;
 
     node->id = s_next_node_id++;
@@ -454,14 +456,14 @@ void aui_node_destroy(AUI_Node *node)
         node->custom_data = NULL;
     }
 
-    free(node);
+    AGENTITE_FREE(node);
 }
 
 AUI_Node *aui_node_duplicate(AUI_Node *node)
 {
     if (!node) return NULL;
 
-    AUI_Node *copy = (AUI_Node *)malloc(sizeof(AUI_Node));
+    AUI_Node *copy = AGENTITE_MALLOC_ARRAY(AUI_Node, 1);
     if (!copy) return NULL;
 
     *copy = *node;
@@ -4062,7 +4064,7 @@ static void aui_tree_item_free_recursive(AUI_TreeItem *item)
         if (item->first_child) {
             aui_tree_item_free_recursive(item->first_child);
         }
-        free(item);
+        AGENTITE_FREE(item);
         item = next;
     }
 }
@@ -4071,7 +4073,7 @@ AUI_TreeItem *aui_tree_add_item(AUI_Node *tree, const char *text, void *user_dat
 {
     if (!tree || tree->type != AUI_NODE_TREE) return NULL;
 
-    AUI_TreeItem *item = (AUI_TreeItem*)calloc(1, sizeof(AUI_TreeItem));
+    AUI_TreeItem *item = AGENTITE_ALLOC(AUI_TreeItem);
     if (!item) return NULL;
 
     item->id = tree->tree.next_item_id++;
@@ -4101,7 +4103,7 @@ AUI_TreeItem *aui_tree_add_child(AUI_Node *tree, AUI_TreeItem *parent,
 {
     if (!tree || tree->type != AUI_NODE_TREE || !parent) return NULL;
 
-    AUI_TreeItem *item = (AUI_TreeItem*)calloc(1, sizeof(AUI_TreeItem));
+    AUI_TreeItem *item = AGENTITE_ALLOC(AUI_TreeItem);
     if (!item) return NULL;
 
     item->id = tree->tree.next_item_id++;
@@ -4162,7 +4164,7 @@ void aui_tree_remove_item(AUI_Node *tree, AUI_TreeItem *item)
     if (item->first_child) {
         aui_tree_item_free_recursive(item->first_child);
     }
-    free(item);
+    AGENTITE_FREE(item);
 }
 
 void aui_tree_clear(AUI_Node *tree)
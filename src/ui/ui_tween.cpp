@@ -2,6 +2,8 @@
  * Agentite UI - Tween/Animation System Implementation
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_UI
+#include "agentite/agentite.h"
 #include "agentite/ui_tween.h"
 #include "agentite/ui_node.h"
 #include <stdlib.h>
@@ -328,7 +330,7 @@ const char *aui_ease_name(AUI_EaseType type) {
  * ============================================================================ */
 
 AUI_TweenManager *aui_tween_manager_create(void) {
-    AUI_TweenManager *tm = (AUI_TweenManager *)calloc(1, sizeof(AUI_TweenManager));
+    AUI_TweenManager *tm = AGENTITE_ALLOC(AUI_TweenManager);
     if (!tm) return NULL;
 
     tm->next_id = 1;
@@ -341,12 +343,12 @@ void aui_tween_manager_destroy(AUI_TweenManager *tm) {
     /* Destroy sequences */
     for (int i = 0; i < tm->sequence_count; i++) {
         if (tm->sequences[i]) {
-            free(tm->sequences[i]->tween_ids);
-            free(tm->sequences[i]);
+            AGENTITE_FREE(tm->sequences[i]->tween_ids);
+            AGENTITE_FREE(tm->sequences[i]);
         }
     }
 
-    free(tm);
+    AGENTITE_FREE(tm);
 }
 
 /* ============================================================================
@@ -826,7 +828,7 @@ uint32_t aui_tween_shake(AUI_TweenManager *tm, AUI_Node *node,
     if (!tm || !node) return 0;
 
     /* Allocate shake data - will be freed when tween completes */
-    AUI_ShakeData *data = (AUI_ShakeData *)malloc(sizeof(AUI_ShakeData));
+    AUI_ShakeData *data = AGENTITE_MALLOC_ARRAY(AUI_ShakeData, 1);
     if (!data) return 0;
 
     data->node = node;
@@ -859,7 +861,7 @@ uint32_t aui_tween_shake(AUI_TweenManager *tm, AUI_Node *node,
                 d->node->offsets.right = d->base_right;
                 d->node->layout_dirty = true;
             }
-            free(d);
+            AGENTITE_FREE(d);
         };
         tween->config.callback_userdata = data;
     }
@@ -962,15 +964,15 @@ void aui_tween_on_complete(AUI_TweenManager *tm, uint32_t id,
 AUI_TweenSequence *aui_tween_sequence_create(AUI_TweenManager *tm) {
     if (!tm || tm->sequence_count >= AUI_MAX_SEQUENCES) return NULL;
 
-    AUI_TweenSequence *seq = (AUI_TweenSequence *)calloc(1, sizeof(AUI_TweenSequence));
+    AUI_TweenSequence *seq = AGENTITE_ALLOC(AUI_TweenSequence);
     if (!seq) return NULL;
 
     seq->id = tm->next_id++;
     seq->manager = tm;
     seq->tween_capacity = 16;
-    seq->tween_ids = (uint32_t *)calloc(seq->tween_capacity, sizeof(uint32_t));
+    seq->tween_ids = AGENTITE_ALLOC_ARRAY(uint32_t, seq->tween_capacity);
     if (!seq->tween_ids) {
-        free(seq);
+        AGENTITE_FREE(seq);
         return NULL;
     }
 
@@ -984,8 +986,7 @@ void aui_tween_sequence_add(AUI_TweenSequence *seq, uint32_t tween_id) {
     /* Grow if needed */
     if (seq->tween_count >= seq->tween_capacity) {
         int new_cap = seq->tween_capacity * 2;
-        uint32_t *new_ids = (uint32_t *)realloc(seq->tween_ids,
-                                                 new_cap * sizeof(uint32_t));
+        uint32_t *new_ids = AGENTITE_REALLOC(seq->tween_ids, uint32_t, new_cap);
         if (!new_ids) return;
         seq->tween_ids = new_ids;
         seq->tween_capacity = new_cap;
@@ -1061,8 +1062,8 @@ void aui_tween_sequence_destroy(AUI_TweenManager *tm, AUI_TweenSequence *seq) {
     /* Find and remove from manager */
     for (int i = 0; i < tm->sequence_count; i++) {
         if (tm->sequences[i] == seq) {
-            free(seq->tween_ids);
-            free(seq);
+            AGENTITE_FREE(seq->tween_ids);
+            AGENTITE_FREE(seq);
             /* Shift remaining */
             for (int j = i; j < tm->sequence_count - 1; j++) {
                 tm->sequences[j] = tm->sequences[j + 1];
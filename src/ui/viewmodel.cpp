@@ -5,6 +5,7 @@
  * change detection, and event-driven updates.
  */
 
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_UI
 #include "agentite/agentite.h"
 #include "agentite/viewmodel.h"
 #include "agentite/event.h"
@@ -8,6 +8,7 @@
 #include "catch_amalgamated.hpp"
 #include "agentite/pathfinding.h"
 #include <cmath>
+#include <cstring>
 
 /* ============================================================================
  * Lifecycle Tests
@@ -461,6 +462,44 @@ TEST_CASE("Path operations", "[pathfinding][path]") {
         agentite_path_destroy(simplified);
     }
 
+    SECTION("Frame variants allocate from the arena") {
+        Agentite_Arena *arena = agentite_arena_create(4096);
+        Agentite_PathOptions opts = AGENTITE_PATH_OPTIONS_DEFAULT;
+        opts.allow_diagonal = false;
+
+        Agentite_Path *path = agentite_pathfinder_find_frame(pf, 0, 0, 5, 3, &opts, arena);
+        REQUIRE(path != nullptr);
+        REQUIRE(path->points[path->length - 1].x == 5);
+        REQUIRE(path->points[path->length - 1].y == 3);
+
+        Agentite_Path *heap = agentite_pathfinder_find_ex(pf, 0, 0, 5, 3, &opts);
+        REQUIRE(heap->length == path->length);
+        REQUIRE(memcmp(heap->points, path->points,
+                       path->length * sizeof(Agentite_PathPoint)) == 0);
+
+        // Frame simplify copies; the input is left untouched
+        int original_len = path->length;
+        Agentite_Path *simplified = agentite_path_simplify_frame(path, arena);
+        REQUIRE(simplified != nullptr);
+        REQUIRE(simplified != path);
+        REQUIRE(path->length == original_len);
+
+        heap = agentite_path_simplify(heap);
+        REQUIRE(simplified->length == heap->length);
+        REQUIRE(memcmp(heap->points, simplified->points,
+                       heap->length * sizeof(Agentite_PathPoint)) == 0);
+        agentite_path_destroy(heap);
+
+        Agentite_Path *same = agentite_pathfinder_find_frame(pf, 2, 2, 2, 2, NULL, arena);
+        REQUIRE(same != nullptr);
+        REQUIRE(same->length == 1);
+
+        REQUIRE(agentite_pathfinder_find_frame(pf, 0, 0, 5, 0, NULL, NULL) == nullptr);
+        REQUIRE(agentite_path_simplify_frame(path, NULL) == nullptr);
+
+        agentite_arena_destroy(arena);
+    }
+
     agentite_pathfinder_destroy(pf);
 }
 
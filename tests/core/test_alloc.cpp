@@ -0,0 +1,206 @@
+/*
+ * Agentite Allocator Tests
+ *
+ * Tests for the pluggable allocator and per-tag allocation counters.
+ */
+
+#define AGENTITE_ALLOC_TAG AGENTITE_ALLOC_TAG_GAME
+#include "catch_amalgamated.hpp"
+#include "agentite/agentite.h"
+#include "agentite/alloc.h"
+#include "agentite/event.h"
+#include <cstdint>
+#include <cstring>
+
+/* ============================================================================
+ * Test Helpers
+ * ============================================================================ */
+
+static Agentite_AllocStats snapshot(void) {
+    Agentite_AllocStats stats;
+    agentite_alloc_get_stats(&stats);
+    return stats;
+}
+
+static Agentite_AllocStats since(const Agentite_AllocStats &begin) {
+    Agentite_AllocStats now = snapshot();
+    Agentite_AllocStats delta;
+    agentite_alloc_stats_delta(&begin, &now, &delta);
+    return delta;
+}
+
+/* Counting allocator that forwards to the C runtime */
+struct CountingAllocator {
+    int mallocs;
+    int callocs;
+    int reallocs;
+    int frees;
+};
+
+static void *counting_malloc(size_t size, void *userdata) {
+    ((CountingAllocator *)userdata)->mallocs++;
+    return malloc(size);
+}
+
+static void *counting_calloc(size_t count, size_t size, void *userdata) {
+    ((CountingAllocator *)userdata)->callocs++;
+    return calloc(count, size);
+}
+
+static void *counting_realloc(void *ptr, size_t size, void *userdata) {
+    ((CountingAllocator *)userdata)->reallocs++;
+    return realloc(ptr, size);
+}
+
+static void counting_free(void *ptr, void *userdata) {
+    ((CountingAllocator *)userdata)->frees++;
+    free(ptr);
+}
+
+/* ============================================================================
+ * Counter Tests
+ * ============================================================================ */
+
+TEST_CASE("Allocation macros count against the file tag", "[alloc]") {
+    Agentite_AllocStats begin = snapshot();
+
+    int *one = AGENTITE_ALLOC(int);
+    int *many = AGENTITE_ALLOC_ARRAY(int, 16);
+    many = AGENTITE_REALLOC(many, int, 32);
+    REQUIRE(one != nullptr);
+    REQUIRE(many != nullptr);
+    AGENTITE_FREE(one);
+    AGENTITE_FREE(many);
+    AGENTITE_FREE((int *)nullptr);
+
+    Agentite_AllocStats delta = since(begin);
+    const Agentite_AllocTagStats &game = delta.tags[AGENTITE_ALLOC_TAG_GAME];
+    REQUIRE(game.allocations == 3);
+    REQUIRE(game.frees == 2);
+    REQUIRE(game.bytes == sizeof(int) * (1 + 16 + 32));
+    REQUIRE(delta.total.allocations >= 3);
+}
+
+TEST_CASE("Engine subsystems charge their own tag", "[alloc]") {
+    Agentite_AllocStats begin = snapshot();
+
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    REQUIRE(d != nullptr);
+    agentite_event_dispatcher_destroy(d);
+
+    Agentite_AllocStats delta = since(begin);
+    REQUIRE(delta.tags[AGENTITE_ALLOC_TAG_EVENT].allocations >= 1);
+    REQUIRE(delta.tags[AGENTITE_ALLOC_TAG_EVENT].frees >= 1);
+    REQUIRE(delta.tags[AGENTITE_ALLOC_TAG_GAME].allocations == 0);
+}
+
+TEST_CASE("Overflowing allocations fail without counting", "[alloc]") {
+    Agentite_AllocStats begin = snapshot();
+
+    REQUIRE(agentite_mem_malloc(SIZE_MAX, 2, AGENTITE_ALLOC_TAG_GAME, __FILE__, __LINE__) == nullptr);
+    REQUIRE(agentite_mem_calloc(SIZE_MAX / 4, 8, AGENTITE_ALLOC_TAG_GAME, __FILE__, __LINE__) == nullptr);
+    REQUIRE(AGENTITE_MALLOC_ARRAY(uint64_t, SIZE_MAX / 4) == nullptr);
+
+    REQUIRE(since(begin).tags[AGENTITE_ALLOC_TAG_GAME].allocations == 0);
+}
+
+TEST_CASE("Allocation tag names", "[alloc]") {
+    REQUIRE(strcmp(agentite_alloc_tag_name(AGENTITE_ALLOC_TAG_COMMAND), "command") == 0);
+    REQUIRE(strcmp(agentite_alloc_tag_name(AGENTITE_ALLOC_TAG_UI), "ui") == 0);
+    REQUIRE(strcmp(agentite_alloc_tag_name(AGENTITE_ALLOC_TAG_COUNT), "unknown") == 0);
+}
+
+/* ============================================================================
+ * Allocator Tests
+ * ============================================================================ */
+
+TEST_CASE("Custom allocator receives macro allocations", "[alloc]") {
+    CountingAllocator counts = {};
+    Agentite_Allocator allocator = {
+        counting_malloc, counting_calloc, counting_realloc, counting_free, &counts
+    };
+    REQUIRE(agentite_set_allocator(&allocator));
+
+    Agentite_Allocator current;
+    agentite_get_allocator(&current);
+    REQUIRE(current.userdata == &counts);
+
+    char *buf = (char *)AGENTITE_MALLOC(64);
+    int *arr = AGENTITE_ALLOC_ARRAY(int, 4);
+    arr = AGENTITE_REALLOC(arr, int, 8);
+    AGENTITE_FREE(buf);
+    AGENTITE_FREE(arr);
+
+    REQUIRE(agentite_set_allocator(nullptr));
+
+    REQUIRE(counts.mallocs == 1);
+    REQUIRE(counts.callocs == 1);
+    REQUIRE(counts.reallocs == 1);
+    REQUIRE(counts.frees == 2);
+
+    /* Restored allocator no longer reaches the counting one */
+    int *after = AGENTITE_ALLOC(int);
+    AGENTITE_FREE(after);
+    REQUIRE(counts.callocs == 1);
+    REQUIRE(counts.frees == 2);
+}
+
+TEST_CASE("Incomplete allocator is rejected", "[alloc]") {
+    Agentite_Allocator allocator = {
+        counting_malloc, counting_calloc, nullptr, counting_free, nullptr
+    };
+    REQUIRE_FALSE(agentite_set_allocator(&allocator));
+
+    Agentite_Allocator current;
+    agentite_get_allocator(&current);
+    REQUIRE(current.realloc_fn != nullptr);
+}
+
+/* ============================================================================
+ * Call-Site Histogram Tests
+ * ============================================================================ */
+
+TEST_CASE("Call-site histogram ranks allocation sites", "[alloc][callsite]") {
+    agentite_alloc_reset_callsites();
+    agentite_alloc_set_callsite_tracking(true);
+    REQUIRE(agentite_alloc_is_tracking_callsites());
+
+    int hot_line = 0;
+    for (int i = 0; i < 5; i++) {
+        hot_line = __LINE__ + 1;
+        void *p = AGENTITE_MALLOC(32);
+        AGENTITE_FREE(p);
+    }
+    int cold_line = __LINE__ + 1;
+    void *cold = AGENTITE_MALLOC(8);
+    AGENTITE_FREE(cold);
+
+    agentite_alloc_set_callsite_tracking(false);
+
+    Agentite_AllocCallsite sites[8];
+    int n = agentite_alloc_get_callsites(sites, 8);
+    REQUIRE(n >= 2);
+
+    const Agentite_AllocCallsite *hot = nullptr;
+    const Agentite_AllocCallsite *cold_site = nullptr;
+    for (int i = 0; i < n; i++) {
+        if (strcmp(sites[i].file, __FILE__) != 0) continue;
+        if (sites[i].line == hot_line) hot = &sites[i];
+        if (sites[i].line == cold_line) cold_site = &sites[i];
+    }
+    REQUIRE(hot != nullptr);
+    REQUIRE(cold_site != nullptr);
+    REQUIRE(hot < cold_site);
+    REQUIRE(hot->allocations == 5);
+    REQUIRE(hot->bytes == 5 * 32);
+    REQUIRE(hot->tag == AGENTITE_ALLOC_TAG_GAME);
+    REQUIRE(cold_site->allocations == 1);
+
+    /* Disabled tracking records nothing new */
+    void *untracked = AGENTITE_MALLOC(8);
+    AGENTITE_FREE(untracked);
+    REQUIRE(agentite_alloc_get_callsites(sites, 8) == n);
+
+    agentite_alloc_reset_callsites();
+    REQUIRE(agentite_alloc_get_callsites(sites, 8) == 0);
+}
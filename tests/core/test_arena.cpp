@@ -0,0 +1,147 @@
+/*
+ * Agentite Arena Tests
+ *
+ * Tests for the linear arena and the double-buffered frame arena.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "agentite/arena.h"
+#include "agentite/alloc.h"
+#include <cstdint>
+#include <cstring>
+
+/* ============================================================================
+ * Arena Tests
+ * ============================================================================ */
+
+TEST_CASE("Arena allocation", "[arena]") {
+    Agentite_Arena *arena = agentite_arena_create(1024);
+    REQUIRE(arena != nullptr);
+
+    SECTION("Allocations honor alignment") {
+        agentite_arena_alloc(arena, 3, 1);
+        void *a16 = agentite_arena_alloc(arena, 8, 0);
+        agentite_arena_alloc(arena, 1, 1);
+        void *a64 = agentite_arena_alloc(arena, 8, 64);
+        REQUIRE(((uintptr_t)a16 % AGENTITE_ARENA_DEFAULT_ALIGN) == 0);
+        REQUIRE(((uintptr_t)a64 % 64) == 0);
+    }
+
+    SECTION("Non power-of-two alignment is rejected") {
+        REQUIRE(agentite_arena_alloc(arena, 8, 24) == nullptr);
+    }
+
+    SECTION("Typed helpers zero memory") {
+        int *values = AGENTITE_ARENA_ARRAY(arena, int, 32);
+        REQUIRE(values != nullptr);
+        for (int i = 0; i < 32; i++) {
+            REQUIRE(values[i] == 0);
+        }
+    }
+
+    SECTION("Reset reuses the same memory") {
+        void *first = agentite_arena_alloc(arena, 100, 0);
+        agentite_arena_reset(arena);
+        void *second = agentite_arena_alloc(arena, 100, 0);
+        REQUIRE(first == second);
+    }
+
+    SECTION("NULL arena is safe") {
+        REQUIRE(agentite_arena_alloc(nullptr, 8, 0) == nullptr);
+        agentite_arena_reset(nullptr);
+        agentite_arena_destroy(nullptr);
+    }
+
+    agentite_arena_destroy(arena);
+}
+
+TEST_CASE("Arena overflow grows on reset", "[arena]") {
+    Agentite_Arena *arena = agentite_arena_create(256);
+    REQUIRE(arena != nullptr);
+
+    /* Overflowing requests still succeed and keep earlier data intact */
+    unsigned char *first = (unsigned char *)agentite_arena_alloc(arena, 200, 0);
+    memset(first, 0xAB, 200);
+    unsigned char *big = (unsigned char *)agentite_arena_alloc(arena, 1000, 0);
+    REQUIRE(big != nullptr);
+    memset(big, 0xCD, 1000);
+    REQUIRE(first[199] == 0xAB);
+
+    Agentite_ArenaStats stats;
+    agentite_arena_get_stats(arena, &stats);
+    REQUIRE(stats.overflow_blocks == 1);
+    REQUIRE(stats.used >= 1200);
+
+    agentite_arena_reset(arena);
+    agentite_arena_get_stats(arena, &stats);
+    REQUIRE(stats.used == 0);
+    REQUIRE(stats.grow_count == 1);
+    REQUIRE(stats.capacity >= 1200);
+    REQUIRE(stats.high_water >= 1200);
+
+    /* The same workload now fits in the main block */
+    agentite_arena_alloc(arena, 200, 0);
+    agentite_arena_alloc(arena, 1000, 0);
+    agentite_arena_reset(arena);
+    agentite_arena_get_stats(arena, &stats);
+    REQUIRE(stats.overflow_blocks == 1);
+    REQUIRE(stats.grow_count == 1);
+
+    agentite_arena_destroy(arena);
+}
+
+/* ============================================================================
+ * Frame Arena Tests
+ * ============================================================================ */
+
+TEST_CASE("Frame arena double buffering", "[arena][frame]") {
+    Agentite_FrameArena *fa = agentite_frame_arena_create(1024);
+    REQUIRE(fa != nullptr);
+
+    Agentite_Arena *frame0 = agentite_frame_arena_current(fa);
+    int *value = AGENTITE_ARENA_ALLOC(frame0, int);
+    *value = 42;
+
+    /* Last frame's data survives one swap */
+    agentite_frame_arena_swap(fa);
+    REQUIRE(agentite_frame_arena_previous(fa) == frame0);
+    REQUIRE(agentite_frame_arena_current(fa) != frame0);
+    REQUIRE(*value == 42);
+
+    /* and is reclaimed by the next one */
+    agentite_frame_arena_swap(fa);
+    REQUIRE(agentite_frame_arena_current(fa) == frame0);
+    Agentite_ArenaStats stats;
+    agentite_arena_get_stats(frame0, &stats);
+    REQUIRE(stats.used == 0);
+
+    agentite_frame_arena_destroy(fa);
+    agentite_frame_arena_destroy(nullptr);
+}
+
+TEST_CASE("Frame arena steady state does not touch the heap", "[arena][frame]") {
+    Agentite_FrameArena *fa = agentite_frame_arena_create(512);
+    REQUIRE(fa != nullptr);
+
+    /* Warm up: the first frames may overflow and grow */
+    for (int frame = 0; frame < 4; frame++) {
+        agentite_arena_alloc(agentite_frame_arena_current(fa), 2048, 0);
+        agentite_frame_arena_swap(fa);
+    }
+
+    Agentite_AllocStats begin, end, delta;
+    agentite_alloc_get_stats(&begin);
+    for (int frame = 0; frame < 100; frame++) {
+        Agentite_Arena *arena = agentite_frame_arena_current(fa);
+        for (int i = 0; i < 16; i++) {
+            REQUIRE(agentite_arena_alloc(arena, 128, 0) != nullptr);
+        }
+        agentite_frame_arena_swap(fa);
+    }
+    agentite_alloc_get_stats(&end);
+    agentite_alloc_stats_delta(&begin, &end, &delta);
+    REQUIRE(delta.total.allocations == 0);
+    REQUIRE(delta.total.frees == 0);
+
+    agentite_frame_arena_destroy(fa);
+}
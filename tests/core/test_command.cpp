@@ -9,6 +9,8 @@
 #include "agentite/command.h"
 #include "agentite/error.h"
 #include <cstring>
+#include <string>
+#include <vector>
 
 /* ============================================================================
  * Test Command Types
@@ -418,6 +420,25 @@ TEST_CASE("Command queue operations", "[command][queue]") {
         REQUIRE(agentite_command_queue_count(sys) == 0);
     }
 
+    SECTION("Queue frame arena command") {
+        Agentite_Arena *arena = agentite_arena_create(sizeof(Agentite_Command) * 4);
+        Agentite_Command *cmd = agentite_command_new_frame_ex(CMD_MOVE, 2, arena);
+        REQUIRE(cmd != nullptr);
+        REQUIRE(cmd->type == CMD_MOVE);
+        REQUIRE(cmd->source_faction == 2);
+        REQUIRE(cmd->param_count == 0);
+        agentite_command_set_int(cmd, "x", 7);
+        REQUIRE(agentite_command_queue(sys, cmd));
+
+        // The queue keeps its own copy after the arena is reset
+        agentite_arena_reset(arena);
+        memset(cmd, 0, sizeof(*cmd));
+        REQUIRE(agentite_command_get_int(agentite_command_queue_get(sys, 0), "x") == 7);
+
+        REQUIRE(agentite_command_new_frame(CMD_MOVE, nullptr) == nullptr);
+        agentite_arena_destroy(arena);
+    }
+
     SECTION("Queue remove") {
         Agentite_Command *cmd1 = agentite_command_new(CMD_MOVE);
         Agentite_Command *cmd2 = agentite_command_new(CMD_MOVE);
@@ -981,3 +1002,358 @@ TEST_CASE("Command edge cases", "[command][edge]") {
 
     agentite_command_destroy(sys);
 }
+
+/* ============================================================================
+ * Interned Key Tests
+ * ============================================================================ */
+
+TEST_CASE("Interned parameter keys", "[command][keys]") {
+    Agentite_CommandKey x = agentite_command_key("x");
+    Agentite_CommandKey y = agentite_command_key("y");
+    REQUIRE(x != 0);
+    REQUIRE(y != 0);
+    REQUIRE(x != y);
+    REQUIRE(agentite_command_key("x") == x);
+    REQUIRE(strcmp(agentite_command_key_name(x), "x") == 0);
+    REQUIRE(agentite_command_key(nullptr) == 0);
+    REQUIRE(agentite_command_key("") == 0);
+    REQUIRE(agentite_command_key_name(0) == nullptr);
+
+    SECTION("String and key APIs see the same parameters") {
+        Agentite_Command cmd;
+        agentite_command_init(&cmd, CMD_MOVE, 1);
+        agentite_command_set_int_id(&cmd, x, 5);
+        agentite_command_set_int(&cmd, "y", 7);
+        agentite_command_set_float_id(&cmd, agentite_command_key("speed"), 2.5f);
+
+        REQUIRE(agentite_command_get_int(&cmd, "x") == 5);
+        REQUIRE(agentite_command_get_int_id(&cmd, y) == 7);
+        REQUIRE(agentite_command_get_float(&cmd, "speed") == 2.5f);
+        REQUIRE(agentite_command_has_param_id(&cmd, x));
+        REQUIRE(strcmp(cmd.params[0].key, "x") == 0);
+
+        // Overwrite keeps one slot
+        agentite_command_set_int_id(&cmd, x, 6);
+        REQUIRE(cmd.param_count == 3);
+        REQUIRE(agentite_command_get_int(&cmd, "x") == 6);
+
+        // Type mismatch and missing keys return defaults
+        REQUIRE(agentite_command_get_bool_id(&cmd, x) == false);
+        REQUIRE(agentite_command_get_string(&cmd, "never_interned_key") == nullptr);
+        REQUIRE_FALSE(agentite_command_has_param(&cmd, "never_interned_key"));
+    }
+
+    SECTION("Params with only a key string still match") {
+        Agentite_Command cmd;
+        agentite_command_init(&cmd, CMD_MOVE, -1);
+        Agentite_CommandParam *p = &cmd.params[cmd.param_count++];
+        memset(p, 0, sizeof(*p));
+        strcpy(p->key, "x");
+        p->type = AGENTITE_CMD_PARAM_INT;
+        p->i32 = 11;
+
+        REQUIRE(agentite_command_get_int_id(&cmd, x) == 11);
+        agentite_command_set_int(&cmd, "x", 12);
+        REQUIRE(cmd.param_count == 1);
+        REQUIRE(cmd.params[0].key_id == x);
+    }
+}
+
+/* ============================================================================
+ * Pool and Inline Submission Tests
+ * ============================================================================ */
+
+TEST_CASE("Command pool", "[command][pool]") {
+    Agentite_CommandPool *pool = agentite_command_pool_create(10);
+    REQUIRE(pool != nullptr);
+
+    Agentite_CommandPoolStats stats;
+    agentite_command_pool_get_stats(pool, &stats);
+    REQUIRE(stats.capacity >= 10);
+    REQUIRE(stats.live == 0);
+    int capacity = stats.capacity;
+
+    Agentite_Command *a = agentite_command_pool_acquire(pool, CMD_MOVE, 3);
+    REQUIRE(a != nullptr);
+    REQUIRE(a->type == CMD_MOVE);
+    REQUIRE(a->source_faction == 3);
+    REQUIRE(a->param_count == 0);
+
+    // Released slots are reused
+    agentite_command_pool_release(pool, a);
+    Agentite_Command *b = agentite_command_pool_acquire(pool, CMD_ATTACK, -1);
+    REQUIRE(b == a);
+    agentite_command_pool_release(pool, b);
+
+    // Grows past the initial chunk
+    std::vector<Agentite_Command *> cmds;
+    for (int i = 0; i < capacity + 1; i++) {
+        cmds.push_back(agentite_command_pool_acquire(pool, CMD_MOVE, -1));
+        REQUIRE(cmds.back() != nullptr);
+    }
+    agentite_command_pool_get_stats(pool, &stats);
+    REQUIRE(stats.live == capacity + 1);
+    REQUIRE(stats.chunk_count >= 2);
+    for (Agentite_Command *c : cmds) {
+        agentite_command_pool_release(pool, c);
+    }
+    agentite_command_pool_release(pool, nullptr);
+    agentite_command_pool_get_stats(pool, &stats);
+    REQUIRE(stats.live == 0);
+
+    agentite_command_pool_destroy(pool);
+    agentite_command_pool_destroy(nullptr);
+}
+
+TEST_CASE("Inline command submission", "[command][inline]") {
+    Agentite_CommandSystem *sys = agentite_command_create();
+    agentite_command_register(sys, CMD_MOVE, validate_move, execute_move);
+    agentite_command_enable_history(sys, 4);
+    Agentite_CommandKey kx = agentite_command_key("x");
+    Agentite_CommandKey ky = agentite_command_key("y");
+
+    SECTION("Executes in place with a sequence number") {
+        Agentite_Command cmd;
+        agentite_command_init(&cmd, CMD_MOVE, -1);
+        agentite_command_set_int_id(&cmd, kx, 3);
+        agentite_command_set_int_id(&cmd, ky, 4);
+
+        g_execute_count = 0;
+        Agentite_CommandResult r1 = agentite_command_submit_inline(sys, &cmd, nullptr);
+        Agentite_CommandResult r2 = agentite_command_submit_inline(sys, &cmd, nullptr);
+        REQUIRE(r1.success);
+        REQUIRE(r2.success);
+        REQUIRE(r2.sequence == r1.sequence + 1);
+        REQUIRE(g_execute_count == 2);
+        REQUIRE(g_last_x == 3);
+        REQUIRE(g_last_y == 4);
+    }
+
+    SECTION("Validation still applies") {
+        Agentite_Command cmd;
+        agentite_command_init(&cmd, CMD_MOVE, -1);
+        agentite_command_set_int_id(&cmd, kx, -1);
+        REQUIRE_FALSE(agentite_command_submit_inline(sys, &cmd, nullptr).success);
+    }
+
+    SECTION("History keeps copies of stack commands") {
+        for (int i = 0; i < 6; i++) {
+            Agentite_Command cmd;
+            agentite_command_init(&cmd, CMD_MOVE, -1);
+            agentite_command_set_int_id(&cmd, kx, i);
+            agentite_command_submit_inline(sys, &cmd, nullptr);
+        }
+        const Agentite_Command *history[4];
+        REQUIRE(agentite_command_get_history(sys, history, 4) == 4);
+        REQUIRE(agentite_command_get_int(history[0], "x") == 5);
+        REQUIRE(agentite_command_get_int(history[3], "x") == 2);
+    }
+
+    agentite_command_destroy(sys);
+}
+
+/* ============================================================================
+ * Batched Execution Tests
+ * ============================================================================ */
+
+enum BatchCommandType {
+    CMD_STEP = 10,      /* Move a unit from "from" to "to"; declares its access */
+    CMD_SHIFT = 11,     /* Same as CMD_STEP but without an access callback */
+};
+
+struct BatchGame {
+    int unit_x[8];
+    int executed;
+    int validated_at[64];   /* Indexed by sequence: executions seen by the validator */
+};
+
+struct BatchLogEntry {
+    int type;
+    uint32_t sequence;
+    bool success;
+    std::string error;
+};
+
+static bool validate_step(const Agentite_Command *cmd, void *game_state,
+                          char *error_buf, size_t error_size) {
+    BatchGame *game = (BatchGame *)game_state;
+    game->validated_at[cmd->sequence & 63] = game->executed;
+
+    int unit = agentite_command_get_int(cmd, "unit");
+    int from = agentite_command_get_int(cmd, "from");
+    if (game->unit_x[unit] != from) {
+        snprintf(error_buf, error_size, "Unit %d is at %d, not %d", unit, game->unit_x[unit], from);
+        return false;
+    }
+    return true;
+}
+
+static bool execute_step(const Agentite_Command *cmd, void *game_state) {
+    BatchGame *game = (BatchGame *)game_state;
+    game->unit_x[agentite_command_get_int(cmd, "unit")] = agentite_command_get_int(cmd, "to");
+    game->executed++;
+    return agentite_command_get_int(cmd, "to") >= 0;
+}
+
+static bool step_access(const Agentite_Command *cmd, const void *game_state,
+                        Agentite_CommandAccess *access) {
+    (void)game_state;
+    agentite_command_access_write(access,
+        AGENTITE_CMD_RESOURCE_ENTITY(agentite_command_get_int(cmd, "unit")));
+    return true;
+}
+
+static void batch_log_callback(Agentite_CommandSystem *sys, const Agentite_Command *cmd,
+                               const Agentite_CommandResult *result, void *userdata) {
+    (void)sys;
+    std::vector<BatchLogEntry> *log = (std::vector<BatchLogEntry> *)userdata;
+    log->push_back({ cmd->type, result->sequence, result->success, result->error });
+}
+
+static Agentite_CommandSystem *create_batch_system(std::vector<BatchLogEntry> *log) {
+    Agentite_CommandSystem *sys = agentite_command_create();
+    agentite_command_register(sys, CMD_STEP, validate_step, execute_step);
+    agentite_command_register(sys, CMD_SHIFT, validate_step, execute_step);
+    agentite_command_set_access(sys, CMD_STEP, step_access);
+    agentite_command_set_callback(sys, batch_log_callback, log);
+    agentite_command_enable_history(sys, 32);
+    return sys;
+}
+
+static void queue_step(Agentite_CommandSystem *sys, int type, int unit, int from, int to) {
+    Agentite_Command cmd;
+    agentite_command_init(&cmd, type, -1);
+    agentite_command_set_int(&cmd, "unit", unit);
+    agentite_command_set_int(&cmd, "from", from);
+    agentite_command_set_int(&cmd, "to", to);
+    agentite_command_queue(sys, &cmd);
+}
+
+/* A mix of independent moves, dependent chains, invalid moves, failing
+ * executions and a type that cannot declare its access */
+static void queue_batch_script(Agentite_CommandSystem *sys) {
+    queue_step(sys, CMD_STEP, 0, 0, 1);
+    queue_step(sys, CMD_STEP, 1, 0, 5);
+    queue_step(sys, CMD_STEP, 0, 1, 2);     /* Depends on the first move */
+    queue_step(sys, CMD_STEP, 2, 0, 3);
+    queue_step(sys, CMD_STEP, 1, 9, 1);     /* Invalid: unit 1 is at 5 */
+    queue_step(sys, CMD_SHIFT, 3, 0, 4);
+    queue_step(sys, CMD_STEP, 3, 4, -1);    /* Valid, execution fails */
+    queue_step(sys, CMD_STEP, 4, 0, 6);
+    queue_step(sys, 99, 5, 0, 1);           /* Unregistered type */
+    queue_step(sys, CMD_STEP, 5, 0, 7);
+}
+
+TEST_CASE("Batched execution matches sequential execution", "[command][batch]") {
+    std::vector<BatchLogEntry> seq_log, batch_log;
+    Agentite_CommandSystem *seq = create_batch_system(&seq_log);
+    Agentite_CommandSystem *batch = create_batch_system(&batch_log);
+    Agentite_JobPool *jobs = agentite_job_pool_create(3);
+    REQUIRE(jobs != nullptr);
+
+    BatchGame seq_game = {};
+    BatchGame batch_game = {};
+    queue_batch_script(seq);
+    queue_batch_script(batch);
+
+    Agentite_CommandResult seq_results[16];
+    Agentite_CommandResult batch_results[16];
+    int n_seq = agentite_command_execute_all(seq, &seq_game, seq_results, 16);
+    int n_batch = agentite_command_execute_batched(batch, &batch_game, jobs, batch_results, 16);
+
+    REQUIRE(n_seq == 10);
+    REQUIRE(n_batch == n_seq);
+    REQUIRE(agentite_command_queue_count(batch) == 0);
+    for (int i = 0; i < n_seq; i++) {
+        REQUIRE(batch_results[i].success == seq_results[i].success);
+        REQUIRE(batch_results[i].sequence == seq_results[i].sequence);
+        REQUIRE(strcmp(batch_results[i].error, seq_results[i].error) == 0);
+    }
+
+    /* Callback stream (what a replay recorder sees) is identical */
+    REQUIRE(batch_log.size() == seq_log.size());
+    for (size_t i = 0; i < seq_log.size(); i++) {
+        REQUIRE(batch_log[i].type == seq_log[i].type);
+        REQUIRE(batch_log[i].sequence == seq_log[i].sequence);
+        REQUIRE(batch_log[i].success == seq_log[i].success);
+        REQUIRE(batch_log[i].error == seq_log[i].error);
+    }
+
+    REQUIRE(memcmp(batch_game.unit_x, seq_game.unit_x, sizeof(seq_game.unit_x)) == 0);
+    REQUIRE(batch_game.unit_x[0] == 2);
+    REQUIRE(batch_game.unit_x[1] == 5);
+
+    Agentite_CommandStats seq_stats, batch_stats;
+    agentite_command_get_stats(seq, &seq_stats);
+    agentite_command_get_stats(batch, &batch_stats);
+    REQUIRE(memcmp(&batch_stats, &seq_stats, sizeof(seq_stats)) == 0);
+
+    const Agentite_Command *seq_hist[32];
+    const Agentite_Command *batch_hist[32];
+    int h = agentite_command_get_history(seq, seq_hist, 32);
+    REQUIRE(agentite_command_get_history(batch, batch_hist, 32) == h);
+    for (int i = 0; i < h; i++) {
+        REQUIRE(batch_hist[i]->sequence == seq_hist[i]->sequence);
+    }
+
+    agentite_job_pool_destroy(jobs);
+    agentite_command_destroy(seq);
+    agentite_command_destroy(batch);
+}
+
+TEST_CASE("Batched execution validates independent commands together", "[command][batch]") {
+    std::vector<BatchLogEntry> log;
+    Agentite_CommandSystem *sys = create_batch_system(&log);
+    Agentite_JobPool *jobs = agentite_job_pool_create(2);
+    BatchGame game = {};
+
+    SECTION("Independent commands share a run") {
+        queue_step(sys, CMD_STEP, 0, 0, 1);
+        queue_step(sys, CMD_STEP, 1, 0, 1);
+        queue_step(sys, CMD_STEP, 2, 0, 1);
+        REQUIRE(agentite_command_execute_batched(sys, &game, jobs, nullptr, 0) == 3);
+        REQUIRE(game.validated_at[1] == 0);
+        REQUIRE(game.validated_at[2] == 0);
+        REQUIRE(game.validated_at[3] == 0);
+        REQUIRE(game.executed == 3);
+    }
+
+    SECTION("A dependent command starts a new run") {
+        queue_step(sys, CMD_STEP, 0, 0, 1);
+        queue_step(sys, CMD_STEP, 1, 0, 1);
+        queue_step(sys, CMD_STEP, 0, 1, 2);
+        REQUIRE(agentite_command_execute_batched(sys, &game, jobs, nullptr, 0) == 3);
+        REQUIRE(game.validated_at[1] == 0);
+        REQUIRE(game.validated_at[2] == 0);
+        REQUIRE(game.validated_at[3] == 2);
+        REQUIRE(game.unit_x[0] == 2);
+    }
+
+    SECTION("Commands without access run alone") {
+        queue_step(sys, CMD_STEP, 0, 0, 1);
+        queue_step(sys, CMD_SHIFT, 1, 0, 1);
+        queue_step(sys, CMD_STEP, 2, 0, 1);
+        REQUIRE(agentite_command_execute_batched(sys, &game, jobs, nullptr, 0) == 3);
+        REQUIRE(game.validated_at[2] == 1);
+        REQUIRE(game.validated_at[3] == 2);
+    }
+
+    SECTION("Max limits the commands executed") {
+        for (int i = 0; i < 5; i++) {
+            queue_step(sys, CMD_STEP, i, 0, 1);
+        }
+        Agentite_CommandResult results[2];
+        REQUIRE(agentite_command_execute_batched(sys, &game, jobs, results, 2) == 2);
+        REQUIRE(results[0].sequence == 1);
+        REQUIRE(results[1].sequence == 2);
+        REQUIRE(agentite_command_queue_count(sys) == 3);
+        REQUIRE(agentite_command_execute_batched(sys, &game, nullptr, nullptr, 0) == 3);
+    }
+
+    SECTION("Access requires a registered type") {
+        REQUIRE_FALSE(agentite_command_set_access(sys, 42, step_access));
+    }
+
+    agentite_job_pool_destroy(jobs);
+    agentite_command_destroy(sys);
+}
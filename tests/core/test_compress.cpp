@@ -0,0 +1,113 @@
+/*
+ * Agentite Block Compression Tests
+ *
+ * Round-trip and corruption tests for the agentite_lz block codec.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "agentite/compress.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/* ============================================================================
+ * Test Helpers
+ * ============================================================================ */
+
+static std::vector<unsigned char> compress_block(const std::vector<unsigned char> &raw) {
+    std::vector<unsigned char> packed(agentite_lz_compress_bound(raw.size()));
+    size_t n = agentite_lz_compress(raw.data(), raw.size(), packed.data(), packed.size());
+    REQUIRE(n > 0);
+    packed.resize(n);
+    return packed;
+}
+
+static void require_round_trip(const std::vector<unsigned char> &raw) {
+    std::vector<unsigned char> packed = compress_block(raw);
+    std::vector<unsigned char> out(raw.size() + 1, 0xCD);
+    REQUIRE(agentite_lz_decompress(packed.data(), packed.size(), out.data(), raw.size()));
+    REQUIRE(std::equal(raw.begin(), raw.end(), out.begin()));
+    REQUIRE(out[raw.size()] == 0xCD);  /* No write past the end */
+}
+
+/* ============================================================================
+ * Round-Trip Tests
+ * ============================================================================ */
+
+TEST_CASE("Block compression round trip", "[compress][basic]") {
+    SECTION("Empty and tiny inputs") {
+        require_round_trip({});
+        require_round_trip({42});
+        require_round_trip({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13});
+    }
+
+    SECTION("Repetitive data shrinks") {
+        std::vector<unsigned char> raw(64 * 1024);
+        for (size_t i = 0; i < raw.size(); i++) {
+            raw[i] = (unsigned char)(i % 7);
+        }
+        std::vector<unsigned char> packed = compress_block(raw);
+        REQUIRE(packed.size() < raw.size() / 20);
+        require_round_trip(raw);
+    }
+
+    SECTION("Random data survives with bounded growth") {
+        std::vector<unsigned char> raw(100000);
+        srand(1234);
+        for (unsigned char &b : raw) {
+            b = (unsigned char)(rand() & 0xFF);
+        }
+        std::vector<unsigned char> packed = compress_block(raw);
+        REQUIRE(packed.size() <= agentite_lz_compress_bound(raw.size()));
+        require_round_trip(raw);
+    }
+
+    SECTION("Matches beyond the 64 KB window") {
+        std::vector<unsigned char> raw(300000);
+        srand(99);
+        for (size_t i = 0; i < 70000; i++) {
+            raw[i] = (unsigned char)(rand() & 0xFF);
+        }
+        for (size_t i = 70000; i < raw.size(); i++) {
+            raw[i] = raw[i - 70000];
+        }
+        require_round_trip(raw);
+    }
+}
+
+/* ============================================================================
+ * Error Handling Tests
+ * ============================================================================ */
+
+TEST_CASE("Block compression rejects bad input", "[compress][errors]") {
+    std::vector<unsigned char> raw(4096);
+    for (size_t i = 0; i < raw.size(); i++) {
+        raw[i] = (unsigned char)(i / 16);
+    }
+    std::vector<unsigned char> packed = compress_block(raw);
+    std::vector<unsigned char> out(raw.size());
+
+    SECTION("Destination smaller than the bound") {
+        REQUIRE(agentite_lz_compress(raw.data(), raw.size(), out.data(), 16) == 0);
+    }
+
+    SECTION("Wrong uncompressed size") {
+        REQUIRE_FALSE(agentite_lz_decompress(packed.data(), packed.size(),
+                                             out.data(), raw.size() - 1));
+    }
+
+    SECTION("Truncated block") {
+        REQUIRE_FALSE(agentite_lz_decompress(packed.data(), packed.size() / 2,
+                                             out.data(), raw.size()));
+    }
+
+    SECTION("Corrupted bytes never overrun") {
+        for (size_t i = 0; i < packed.size(); i += 3) {
+            std::vector<unsigned char> bad = packed;
+            bad[i] ^= 0xFF;
+            /* Result may be true or false, but must stay in bounds */
+            agentite_lz_decompress(bad.data(), bad.size(), out.data(), out.size());
+        }
+    }
+}
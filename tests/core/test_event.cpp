@@ -8,6 +8,8 @@
 #include "agentite/event.h"
 #include <cstring>
 #include <vector>
+#include <thread>
+#include <atomic>
 
 /* ============================================================================
  * Test Helpers
@@ -314,6 +316,257 @@ TEST_CASE("Deferred events", "[event][deferred]") {
     agentite_event_dispatcher_destroy(d);
 }
 
+TEST_CASE("Grouped flush dispatches by type", "[event][deferred]") {
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    EventRecorder rec;
+    agentite_event_subscribe_all(d, recorder_callback, &rec);
+
+    const Agentite_EventType types[] = {
+        AGENTITE_EVENT_TURN_ENDED, AGENTITE_EVENT_TURN_STARTED,
+        AGENTITE_EVENT_TURN_ENDED, AGENTITE_EVENT_TURN_STARTED,
+    };
+    for (int i = 0; i < 4; i++) {
+        Agentite_Event e = {};
+        e.type = types[i];
+        e.turn.turn = (uint32_t)i;
+        agentite_event_emit_deferred(d, &e);
+    }
+
+    SECTION("Plain flush keeps queue order") {
+        agentite_event_flush_deferred(d);
+        REQUIRE(rec.received_values == std::vector<uint32_t>{0, 1, 2, 3});
+    }
+
+    SECTION("Grouped flush keeps order within a type") {
+        agentite_event_flush_deferred_grouped(d);
+        REQUIRE(rec.call_count == 4);
+        REQUIRE(rec.received_types[0] == rec.received_types[1]);
+        REQUIRE(rec.received_types[2] == rec.received_types[3]);
+        REQUIRE(rec.received_values[0] < rec.received_values[1]);
+        REQUIRE(rec.received_values[2] < rec.received_values[3]);
+    }
+
+    agentite_event_dispatcher_destroy(d);
+}
+
+static void defer_turn_ended(const Agentite_Event *event, void *userdata) {
+    Agentite_EventDispatcher *d = static_cast<Agentite_EventDispatcher *>(userdata);
+    Agentite_Event e = {};
+    e.type = AGENTITE_EVENT_TURN_ENDED;
+    e.turn.turn = event->turn.turn;
+    agentite_event_emit_deferred(d, &e);
+}
+
+TEST_CASE("Events deferred during flush are delivered", "[event][deferred]") {
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    EventRecorder rec;
+    agentite_event_subscribe(d, AGENTITE_EVENT_TURN_STARTED, defer_turn_ended, d);
+    agentite_event_subscribe(d, AGENTITE_EVENT_TURN_ENDED, recorder_callback, &rec);
+
+    for (uint32_t i = 0; i < 100; i++) {
+        Agentite_Event e = {};
+        e.type = AGENTITE_EVENT_TURN_STARTED;
+        e.turn.turn = i;
+        agentite_event_emit_deferred(d, &e);
+    }
+    agentite_event_flush_deferred(d);
+
+    REQUIRE(rec.call_count == 100);
+    for (uint32_t i = 0; i < 100; i++) {
+        REQUIRE(rec.received_values[i] == i);
+    }
+
+    agentite_event_dispatcher_destroy(d);
+}
+
+/* ============================================================================
+ * Worker Thread Tests
+ * ============================================================================ */
+
+#define PRODUCER_THREADS 4
+#define EVENTS_PER_PRODUCER 5000
+
+struct ProducerLog {
+    std::vector<int32_t> next_expected;
+    int received = 0;
+    bool in_order = true;
+};
+
+static void producer_log_callback(const Agentite_Event *event, void *userdata) {
+    ProducerLog *log = static_cast<ProducerLog *>(userdata);
+    int32_t thread = event->custom.id;
+    int32_t seq = (int32_t)event->custom.size;
+    if (seq != log->next_expected[thread]) {
+        log->in_order = false;
+    }
+    log->next_expected[thread] = seq + 1;
+    log->received++;
+}
+
+TEST_CASE("Worker threads emit deferred events", "[event][deferred][thread]") {
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    ProducerLog log;
+    log.next_expected.assign(PRODUCER_THREADS, 0);
+    agentite_event_subscribe(d, AGENTITE_EVENT_CUSTOM, producer_log_callback, &log);
+    agentite_event_set_frame(d, 3);
+
+    std::atomic<int> running{PRODUCER_THREADS};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < PRODUCER_THREADS; t++) {
+        producers.emplace_back([d, t, &running]() {
+            for (int i = 0; i < EVENTS_PER_PRODUCER; i++) {
+                Agentite_Event e = {};
+                e.type = AGENTITE_EVENT_CUSTOM;
+                e.custom.id = t;
+                e.custom.size = (size_t)i;
+                agentite_event_emit_deferred(d, &e);
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    /* Flush while producers are still running */
+    while (running.load() > 0) {
+        agentite_event_flush_deferred(d);
+    }
+    for (std::thread &t : producers) {
+        t.join();
+    }
+    agentite_event_flush_deferred(d);
+
+    REQUIRE(log.received == PRODUCER_THREADS * EVENTS_PER_PRODUCER);
+    REQUIRE(log.in_order);
+
+    agentite_event_dispatcher_destroy(d);
+}
+
+TEST_CASE("Worker events follow owner events in a flush", "[event][deferred][thread]") {
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    EventRecorder rec;
+    agentite_event_subscribe_all(d, recorder_callback, &rec);
+
+    std::thread worker([d]() {
+        Agentite_Event e = {};
+        e.type = AGENTITE_EVENT_TURN_ENDED;
+        e.turn.turn = 2;
+        agentite_event_emit_deferred(d, &e);
+    });
+    worker.join();
+
+    Agentite_Event e = {};
+    e.type = AGENTITE_EVENT_TURN_STARTED;
+    e.turn.turn = 1;
+    agentite_event_emit_deferred(d, &e);
+
+    SECTION("Flush delivers both") {
+        agentite_event_flush_deferred(d);
+        REQUIRE(rec.received_values == std::vector<uint32_t>{1, 2});
+    }
+
+    SECTION("Clear discards staged events") {
+        agentite_event_clear_all(d);
+        agentite_event_subscribe_all(d, recorder_callback, &rec);
+        agentite_event_flush_deferred(d);
+        REQUIRE(rec.call_count == 0);
+    }
+
+    agentite_event_dispatcher_destroy(d);
+}
+
+/* ============================================================================
+ * Dispatch Order Tests
+ * ============================================================================ */
+
+struct OrderRecorder {
+    std::vector<int> *log;
+    int tag;
+};
+
+static void order_callback(const Agentite_Event *event, void *userdata) {
+    (void)event;
+    OrderRecorder *r = static_cast<OrderRecorder *>(userdata);
+    r->log->push_back(r->tag);
+}
+
+TEST_CASE("Typed and wildcard listeners run in subscription order", "[event][order]") {
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    std::vector<int> log;
+    OrderRecorder r[4] = { {&log, 0}, {&log, 1}, {&log, 2}, {&log, 3} };
+
+    agentite_event_subscribe(d, AGENTITE_EVENT_GAME_STARTED, order_callback, &r[0]);
+    agentite_event_subscribe_all(d, order_callback, &r[1]);
+    agentite_event_subscribe(d, AGENTITE_EVENT_GAME_PAUSED, order_callback, &r[2]);
+    agentite_event_subscribe(d, AGENTITE_EVENT_GAME_STARTED, order_callback, &r[3]);
+
+    agentite_event_emit_game_started(d);
+    REQUIRE(log == std::vector<int>{0, 1, 3});
+
+    log.clear();
+    agentite_event_emit_game_paused(d);
+    REQUIRE(log == std::vector<int>{1, 2});
+
+    agentite_event_dispatcher_destroy(d);
+}
+
+struct SelfRemover {
+    Agentite_EventDispatcher *d;
+    Agentite_ListenerID id;
+    int calls;
+};
+
+static void remove_self_callback(const Agentite_Event *event, void *userdata) {
+    (void)event;
+    SelfRemover *s = static_cast<SelfRemover *>(userdata);
+    s->calls++;
+    agentite_event_unsubscribe(s->d, s->id);
+}
+
+TEST_CASE("Unsubscribe during emission", "[event][unsubscribe]") {
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    int counter = 0;
+
+    SelfRemover remover = { d, 0, 0 };
+    remover.id = agentite_event_subscribe(d, AGENTITE_EVENT_GAME_STARTED,
+                                          remove_self_callback, &remover);
+    agentite_event_subscribe(d, AGENTITE_EVENT_GAME_STARTED, counter_callback, &counter);
+
+    agentite_event_emit_game_started(d);
+    agentite_event_emit_game_started(d);
+
+    REQUIRE(remover.calls == 1);
+    REQUIRE(counter == 2);
+    REQUIRE(agentite_event_listener_count(d, AGENTITE_EVENT_GAME_STARTED) == 1);
+
+    agentite_event_dispatcher_destroy(d);
+}
+
+TEST_CASE("Emit many", "[event][batch]") {
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    EventRecorder rec;
+    int started = 0;
+    agentite_event_subscribe(d, AGENTITE_EVENT_TURN_STARTED, recorder_callback, &rec);
+    agentite_event_subscribe(d, AGENTITE_EVENT_TURN_ENDED, recorder_callback, &rec);
+    agentite_event_subscribe(d, AGENTITE_EVENT_GAME_STARTED, counter_callback, &started);
+    agentite_event_set_frame(d, 7);
+
+    Agentite_Event events[5] = {};
+    for (int i = 0; i < 5; i++) {
+        events[i].type = (i % 2) ? AGENTITE_EVENT_TURN_ENDED : AGENTITE_EVENT_TURN_STARTED;
+        events[i].turn.turn = (uint32_t)i;
+    }
+    events[4].type = AGENTITE_EVENT_PHASE_STARTED;  /* No listeners */
+
+    agentite_event_emit_many(d, events, 5);
+
+    REQUIRE(rec.received_values == std::vector<uint32_t>{0, 1, 2, 3});
+    REQUIRE(started == 0);
+
+    agentite_event_emit_many(d, nullptr, 3);  /* Safe */
+    agentite_event_emit_many(nullptr, events, 3);
+
+    agentite_event_dispatcher_destroy(d);
+}
+
 /* ============================================================================
  * Listener Count Tests
  * ============================================================================ */
@@ -69,6 +69,10 @@ TEST_CASE("Game context NULL safety", "[game_context][null]") {
         // Should not crash
         agentite_game_context_quit(nullptr);
     }
+
+    SECTION("agentite_game_context_frame_arena with NULL") {
+        REQUIRE(agentite_game_context_frame_arena(nullptr) == nullptr);
+    }
 }
 
 /* ============================================================================
@@ -128,6 +132,49 @@ TEST_CASE("Default game context config", "[game_context][config]") {
         REQUIRE(config.mod_path_count == 0);
         REQUIRE(config.allow_mod_overrides);  // Default to allowing overrides
     }
+
+    SECTION("Frame arena uses the default size") {
+        REQUIRE(config.frame_arena_size == 0);
+    }
+
+    SECTION("ECS defaults to single-threaded") {
+        REQUIRE(config.ecs_worker_threads == 0);
+    }
+}
+
+/* ============================================================================
+ * ECS Thread Config Tests
+ * ============================================================================ */
+
+TEST_CASE("Game context ECS worker threads", "[game_context][config][ecs]") {
+    Agentite_World *world = agentite_ecs_init();
+    REQUIRE(world != nullptr);
+    Agentite_GameContextConfig config = AGENTITE_GAME_CONTEXT_DEFAULT;
+
+    SECTION("Zero workers keeps the main thread only") {
+        REQUIRE(agentite_game_context_apply_ecs_threads(world, &config));
+        REQUIRE(agentite_ecs_get_threads(world) == 1);
+
+        REQUIRE(agentite_game_context_apply_ecs_threads(world, nullptr));
+        REQUIRE(agentite_ecs_get_threads(world) == 1);
+    }
+
+    SECTION("N workers run alongside the main thread") {
+        config.ecs_worker_threads = 3;
+        REQUIRE(agentite_game_context_apply_ecs_threads(world, &config));
+        REQUIRE(agentite_ecs_get_threads(world) == 4);
+    }
+
+    SECTION("-1 uses one thread per core") {
+        config.ecs_worker_threads = -1;
+        REQUIRE(agentite_game_context_apply_ecs_threads(world, &config));
+        int per_core = agentite_ecs_get_threads(world);
+
+        REQUIRE(agentite_ecs_set_threads(world, 0));
+        REQUIRE(agentite_ecs_get_threads(world) == per_core);
+    }
+
+    agentite_ecs_shutdown(world);
 }
 
 /* ============================================================================
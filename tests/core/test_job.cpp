@@ -0,0 +1,121 @@
+/*
+ * Agentite Job Pool Tests
+ *
+ * Tests for the fork-join job pool: coverage of the index range, grain
+ * handling, inline fallbacks and nested calls.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "agentite/job.h"
+#include <atomic>
+#include <vector>
+
+/* ============================================================================
+ * Test Helpers
+ * ============================================================================ */
+
+struct CoverJob {
+    std::vector<std::atomic<int>> *hits;
+    std::atomic<int> calls;
+};
+
+static void cover_range(void *userdata, int begin, int end) {
+    CoverJob *job = (CoverJob *)userdata;
+    job->calls.fetch_add(1);
+    for (int i = begin; i < end; i++) {
+        (*job->hits)[i].fetch_add(1);
+    }
+}
+
+static bool all_hit_once(const std::vector<std::atomic<int>> &hits) {
+    for (const std::atomic<int> &h : hits) {
+        if (h.load() != 1) return false;
+    }
+    return true;
+}
+
+/* ============================================================================
+ * Tests
+ * ============================================================================ */
+
+TEST_CASE("Job pool covers every index once", "[job]") {
+    Agentite_JobPool *pool = agentite_job_pool_create(3);
+    REQUIRE(pool != nullptr);
+    REQUIRE(agentite_job_pool_thread_count(pool) == 3);
+
+    SECTION("Automatic grain") {
+        std::vector<std::atomic<int>> hits(10000);
+        CoverJob job = { &hits, {0} };
+        agentite_job_parallel_for(pool, 10000, 0, cover_range, &job);
+        REQUIRE(all_hit_once(hits));
+        REQUIRE(job.calls.load() > 1);
+    }
+
+    SECTION("Explicit grain") {
+        std::vector<std::atomic<int>> hits(103);
+        CoverJob job = { &hits, {0} };
+        agentite_job_parallel_for(pool, 103, 10, cover_range, &job);
+        REQUIRE(all_hit_once(hits));
+        REQUIRE(job.calls.load() == 11);
+    }
+
+    SECTION("Repeated jobs reuse the workers") {
+        for (int round = 0; round < 200; round++) {
+            std::vector<std::atomic<int>> hits(64);
+            CoverJob job = { &hits, {0} };
+            agentite_job_parallel_for(pool, 64, 1, cover_range, &job);
+            REQUIRE(all_hit_once(hits));
+        }
+    }
+
+    SECTION("Empty range does nothing") {
+        CoverJob job = { nullptr, {0} };
+        agentite_job_parallel_for(pool, 0, 0, cover_range, &job);
+        agentite_job_parallel_for(pool, 10, 0, nullptr, &job);
+        REQUIRE(job.calls.load() == 0);
+    }
+
+    agentite_job_pool_destroy(pool);
+}
+
+TEST_CASE("NULL job pool runs inline", "[job]") {
+    std::vector<std::atomic<int>> hits(50);
+    CoverJob job = { &hits, {0} };
+    agentite_job_parallel_for(nullptr, 50, 4, cover_range, &job);
+    REQUIRE(all_hit_once(hits));
+    REQUIRE(job.calls.load() == 1);
+
+    REQUIRE(agentite_job_pool_thread_count(nullptr) == 0);
+    agentite_job_pool_destroy(nullptr);
+}
+
+struct NestedJob {
+    Agentite_JobPool *pool;
+    std::vector<std::atomic<int>> *hits;
+};
+
+static void nested_inner(void *userdata, int begin, int end) {
+    std::atomic<int> *row = (std::atomic<int> *)userdata;
+    for (int i = begin; i < end; i++) {
+        row[i].fetch_add(1);
+    }
+}
+
+static void nested_outer(void *userdata, int begin, int end) {
+    NestedJob *job = (NestedJob *)userdata;
+    for (int i = begin; i < end; i++) {
+        agentite_job_parallel_for(job->pool, 16, 1, nested_inner, &(*job->hits)[i * 16]);
+    }
+}
+
+TEST_CASE("Nested parallel_for runs inline", "[job]") {
+    Agentite_JobPool *pool = agentite_job_pool_create(2);
+    REQUIRE(pool != nullptr);
+
+    std::vector<std::atomic<int>> hits(16 * 16);
+    NestedJob job = { pool, &hits };
+    agentite_job_parallel_for(pool, 16, 1, nested_outer, &job);
+    REQUIRE(all_hit_once(hits));
+
+    agentite_job_pool_destroy(pool);
+}
@@ -6,10 +6,31 @@
 
 #include "catch_amalgamated.hpp"
 #include "agentite/profiler.h"
+#include "agentite/event.h"
 #include <cstring>
+#include <cstdio>
+#include <string>
 #include <thread>
+#include <vector>
 #include <chrono>
 
+/* ============================================================================
+ * Test Helpers
+ * ============================================================================ */
+
+static std::string read_text_file(const char *path) {
+    std::string text;
+    FILE *f = fopen(path, "r");
+    if (!f) return text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        text.append(buf, n);
+    }
+    fclose(f);
+    return text;
+}
+
 /* ============================================================================
  * Lifecycle Tests
  * ============================================================================ */
@@ -437,6 +458,204 @@ TEST_CASE("Profiler frame history", "[profiler][history]") {
     agentite_profiler_destroy(profiler);
 }
 
+/* ============================================================================
+ * Scope Tree Tests
+ * ============================================================================ */
+
+static int find_tree_node(const Agentite_ScopeNode *nodes, uint32_t count,
+                          const char *name, int32_t parent) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (nodes[i].parent == parent && strcmp(nodes[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+TEST_CASE("Profiler scope tree keeps nesting", "[profiler][tree]") {
+    Agentite_Profiler *profiler = agentite_profiler_create(nullptr);
+
+    for (int frame = 0; frame < 2; frame++) {
+        agentite_profiler_begin_frame(profiler);
+        agentite_profiler_begin_scope(profiler, "update");
+        agentite_profiler_begin_scope(profiler, "physics");
+        agentite_profiler_end_scope(profiler);
+        agentite_profiler_begin_scope(profiler, "ai");
+        for (int i = 0; i <= frame; i++) {
+            agentite_profiler_begin_scope(profiler, "physics");
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            agentite_profiler_end_scope(profiler);
+        }
+        agentite_profiler_end_scope(profiler);
+        agentite_profiler_end_scope(profiler);
+        agentite_profiler_begin_scope(profiler, "render");
+        agentite_profiler_end_scope(profiler);
+        agentite_profiler_end_frame(profiler);
+    }
+
+    uint32_t count = 0;
+    const Agentite_ScopeNode *nodes = agentite_profiler_get_scope_tree(profiler, &count);
+    REQUIRE(count == 5);
+
+    int update = find_tree_node(nodes, count, "update", -1);
+    int ai = find_tree_node(nodes, count, "ai", update);
+    int physics = find_tree_node(nodes, count, "physics", update);
+    int ai_physics = find_tree_node(nodes, count, "physics", ai);
+    REQUIRE(update >= 0);
+    REQUIRE(ai >= 0);
+    REQUIRE(physics >= 0);
+    REQUIRE(ai_physics >= 0);
+    REQUIRE(find_tree_node(nodes, count, "render", -1) >= 0);
+
+    REQUIRE(nodes[ai_physics].depth == 2);
+    REQUIRE(nodes[ai_physics].call_count == 2);
+    REQUIRE(nodes[physics].call_count == 1);
+    REQUIRE(nodes[ai].time_ms >= nodes[ai_physics].time_ms);
+    REQUIRE(nodes[update].time_ms >= nodes[ai].time_ms);
+    REQUIRE(nodes[ai_physics].max_time_ms >= nodes[ai_physics].avg_time_ms);
+
+    agentite_profiler_reset(profiler);
+    agentite_profiler_get_scope_tree(profiler, &count);
+    REQUIRE(count == 0);
+
+    agentite_profiler_destroy(profiler);
+}
+
+TEST_CASE("Profiler records externally timed scopes", "[profiler][tree]") {
+    Agentite_Profiler *profiler = agentite_profiler_create(nullptr);
+
+    agentite_profiler_begin_frame(profiler);
+    agentite_profiler_begin_scope(profiler, "ecs_progress");
+    agentite_profiler_record_scope(profiler, "MovementSystem", 1.5);
+    agentite_profiler_record_scope(profiler, "MovementSystem", 0.5);
+    agentite_profiler_end_scope(profiler);
+    agentite_profiler_record_scope(profiler, "loose", 0.25);
+    agentite_profiler_record_scope(profiler, nullptr, 1.0);
+    agentite_profiler_end_frame(profiler);
+
+    uint32_t count = 0;
+    const Agentite_ScopeNode *nodes = agentite_profiler_get_scope_tree(profiler, &count);
+    REQUIRE(count == 3);
+    int progress = find_tree_node(nodes, count, "ecs_progress", -1);
+    int movement = find_tree_node(nodes, count, "MovementSystem", progress);
+    REQUIRE(movement >= 0);
+    REQUIRE(nodes[movement].call_count == 2);
+    REQUIRE(nodes[movement].time_ms == Catch::Approx(2.0));
+    REQUIRE(find_tree_node(nodes, count, "loose", -1) >= 0);
+
+    agentite_profiler_get_stats(profiler);
+    const Agentite_ScopeStats *scope = agentite_profiler_get_scope(profiler, "MovementSystem");
+    REQUIRE(scope != nullptr);
+    REQUIRE(scope->total_time_ms == Catch::Approx(2.0));
+    REQUIRE(scope->call_count == 2);
+
+    agentite_profiler_destroy(profiler);
+}
+
+TEST_CASE("Profiler captures spike frames", "[profiler][tree][spike]") {
+    const char *path = "/tmp/agentite_test_spike.json";
+    Agentite_ProfilerConfig config = AGENTITE_PROFILER_DEFAULT;
+    config.spike_threshold_ms = 5.0;
+    Agentite_Profiler *profiler = agentite_profiler_create(&config);
+
+    for (int frame = 0; frame < 3; frame++) {
+        agentite_profiler_begin_frame(profiler);
+        agentite_profiler_begin_scope(profiler, "ai");
+        agentite_profiler_begin_scope(profiler, "pathfinding");
+        if (frame == 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        agentite_profiler_end_scope(profiler);
+        agentite_profiler_end_scope(profiler);
+        if (frame == 0) {
+            agentite_profiler_begin_scope(profiler, "only_first_frame");
+            agentite_profiler_end_scope(profiler);
+        }
+        agentite_profiler_end_frame(profiler);
+    }
+
+    REQUIRE(agentite_profiler_get_spike_count(profiler) == 1);
+    const Agentite_ProfilerSpike *spike = agentite_profiler_get_spike(profiler, 0);
+    REQUIRE(spike != nullptr);
+    REQUIRE(agentite_profiler_get_spike(profiler, 1) == nullptr);
+    REQUIRE(spike->frame_number == 2);
+    REQUIRE(spike->frame_time_ms >= 10.0);
+
+    /* Only scopes that ran in the spike frame, with parents remapped */
+    REQUIRE(spike->node_count == 2);
+    int ai = find_tree_node(spike->nodes, spike->node_count, "ai", -1);
+    int pathfinding = find_tree_node(spike->nodes, spike->node_count, "pathfinding", ai);
+    REQUIRE(ai >= 0);
+    REQUIRE(pathfinding >= 0);
+    REQUIRE(spike->nodes[pathfinding].time_ms >= 9.0);
+
+    REQUIRE(agentite_profiler_export_json(profiler, path));
+    std::string json = read_text_file(path);
+    REQUIRE(json.find("\"scope_tree\"") != std::string::npos);
+    REQUIRE(json.find("\"spikes\"") != std::string::npos);
+    REQUIRE(json.find("{\"name\": \"pathfinding\"") != std::string::npos);
+
+    agentite_profiler_clear_spikes(profiler);
+    REQUIRE(agentite_profiler_get_spike_count(profiler) == 0);
+
+    agentite_profiler_destroy(profiler);
+    remove(path);
+}
+
+TEST_CASE("Profiler reports allocations per frame by tag", "[profiler][memory][alloc]") {
+    const char *path = "/tmp/agentite_test_frame_allocs.json";
+    Agentite_ProfilerConfig config = AGENTITE_PROFILER_DEFAULT;
+    config.track_memory = true;
+    config.history_size = 4;
+    Agentite_Profiler *profiler = agentite_profiler_create(&config);
+    Agentite_AllocStats allocs;
+
+    /* Frame 1 creates a dispatcher, frame 2 allocates nothing tagged */
+    agentite_profiler_begin_frame(profiler);
+    Agentite_EventDispatcher *d = agentite_event_dispatcher_create();
+    agentite_profiler_end_frame(profiler);
+
+    agentite_profiler_begin_frame(profiler);
+    agentite_profiler_end_frame(profiler);
+
+    REQUIRE(agentite_profiler_get_frame_allocs(profiler, 1, &allocs));
+    REQUIRE(allocs.tags[AGENTITE_ALLOC_TAG_EVENT].allocations >= 1);
+    REQUIRE(allocs.total.allocations >= allocs.tags[AGENTITE_ALLOC_TAG_EVENT].allocations);
+
+    REQUIRE(agentite_profiler_get_frame_allocs(profiler, 2, &allocs));
+    REQUIRE(allocs.tags[AGENTITE_ALLOC_TAG_EVENT].allocations == 0);
+
+    const Agentite_ProfilerStats *stats = agentite_profiler_get_stats(profiler);
+    REQUIRE(stats->frame_allocs.tags[AGENTITE_ALLOC_TAG_EVENT].allocations == 0);
+    REQUIRE(stats->memory.total_allocations >= 1);
+
+    /* Only the last history_size frames are kept */
+    REQUIRE_FALSE(agentite_profiler_get_frame_allocs(profiler, 0, &allocs));
+    REQUIRE_FALSE(agentite_profiler_get_frame_allocs(profiler, 3, &allocs));
+    for (int i = 0; i < 4; i++) {
+        agentite_profiler_begin_frame(profiler);
+        agentite_profiler_end_frame(profiler);
+    }
+    REQUIRE_FALSE(agentite_profiler_get_frame_allocs(profiler, 2, &allocs));
+    REQUIRE(agentite_profiler_get_frame_allocs(profiler, 3, &allocs));
+
+    REQUIRE(agentite_profiler_export_json(profiler, path));
+    std::string json = read_text_file(path);
+    REQUIRE(json.find("\"frame_allocs\"") != std::string::npos);
+    REQUIRE(json.find("\"event\": {\"allocations\"") != std::string::npos);
+
+    agentite_event_dispatcher_destroy(d);
+    agentite_profiler_destroy(profiler);
+    remove(path);
+
+    /* Without track_memory there is no per-frame history */
+    Agentite_Profiler *untracked = agentite_profiler_create(nullptr);
+    agentite_profiler_begin_frame(untracked);
+    agentite_profiler_end_frame(untracked);
+    REQUIRE_FALSE(agentite_profiler_get_frame_allocs(untracked, 1, &allocs));
+    agentite_profiler_destroy(untracked);
+}
+
 /* ============================================================================
  * Disabled Profiler Tests
  * ============================================================================ */
@@ -497,3 +716,138 @@ TEST_CASE("C++ scope helper", "[profiler][cpp]") {
 
     agentite_profiler_destroy(profiler);
 }
+
+/* ============================================================================
+ * Tracing Tests
+ * ============================================================================ */
+
+TEST_CASE("Profiler trace capture window", "[profiler][trace]") {
+    const char *path = "/tmp/agentite_test_trace.json";
+    Agentite_Profiler *profiler = agentite_profiler_create(nullptr);
+
+    REQUIRE(agentite_profiler_trace_start(profiler, 2));
+    REQUIRE(agentite_profiler_is_tracing(profiler));
+    REQUIRE_FALSE(agentite_profiler_trace_start(profiler, 2));
+
+    /* Scopes before the first frame are outside the window */
+    agentite_profiler_begin_scope(profiler, "before");
+    agentite_profiler_end_scope(profiler);
+
+    for (int frame = 0; frame < 3; frame++) {
+        agentite_profiler_begin_frame(profiler);
+        agentite_profiler_begin_update(profiler);
+        agentite_profiler_begin_scope(profiler, "work");
+        agentite_profiler_end_scope(profiler);
+        agentite_profiler_end_update(profiler);
+        if (frame == 0) {
+            REQUIRE_FALSE(agentite_profiler_export_trace(profiler, path));
+        }
+        agentite_profiler_end_frame(profiler);
+    }
+
+    /* frame, update and work for each of the two captured frames */
+    REQUIRE_FALSE(agentite_profiler_is_tracing(profiler));
+    REQUIRE(agentite_profiler_get_trace_event_count(profiler) == 6);
+
+    REQUIRE(agentite_profiler_export_trace(profiler, path));
+    std::string json = read_text_file(path);
+    REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(json.find("\"args\":{\"name\":\"main\"}") != std::string::npos);
+    REQUIRE(json.find("{\"name\":\"work\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"before\"") == std::string::npos);
+
+    agentite_profiler_destroy(profiler);
+    remove(path);
+}
+
+TEST_CASE("Profiler trace records worker threads", "[profiler][trace]") {
+    const char *path = "/tmp/agentite_test_trace_threads.json";
+    Agentite_Profiler *profiler = agentite_profiler_create(nullptr);
+    const int thread_count = 4;
+    const int scopes_per_thread = 1000;
+
+    REQUIRE(agentite_profiler_trace_start(profiler, 0));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; i++) {
+        threads.emplace_back([profiler]() {
+            agentite_profiler_trace_set_thread_name(profiler, "worker \"quoted\"");
+            for (int j = 0; j < scopes_per_thread; j++) {
+                AGENTITE_TRACE_SCOPE(profiler, "job");
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    agentite_profiler_trace_stop(profiler);
+    REQUIRE(agentite_profiler_get_trace_event_count(profiler) ==
+            (size_t)(thread_count * scopes_per_thread));
+
+    REQUIRE(agentite_profiler_export_trace(profiler, path));
+    std::string json = read_text_file(path);
+    REQUIRE(json.find("\"worker \\\"quoted\\\"\"") != std::string::npos);
+
+    /* A new capture excludes the previous one */
+    REQUIRE(agentite_profiler_trace_start(profiler, 0));
+    agentite_profiler_trace_begin(profiler, "again");
+    agentite_profiler_trace_end(profiler);
+    agentite_profiler_trace_stop(profiler);
+    REQUIRE(agentite_profiler_get_trace_event_count(profiler) == 1);
+
+    agentite_profiler_destroy(profiler);
+    remove(path);
+}
+
+TEST_CASE("Profiler trace ring keeps recent events", "[profiler][trace]") {
+    Agentite_ProfilerConfig config = AGENTITE_PROFILER_DEFAULT;
+    config.trace_buffer_events = 64;
+    Agentite_Profiler *profiler = agentite_profiler_create(&config);
+
+    REQUIRE(agentite_profiler_trace_start(profiler, 0));
+    for (int i = 0; i < 1000; i++) {
+        agentite_profiler_trace_begin(profiler, "spin");
+        agentite_profiler_trace_end(profiler);
+    }
+
+    /* Unbalanced and over-deep scopes are tolerated */
+    agentite_profiler_trace_end(profiler);
+    for (int i = 0; i < AGENTITE_PROFILER_MAX_SCOPE_DEPTH + 4; i++) {
+        agentite_profiler_trace_begin(profiler, "deep");
+    }
+    for (int i = 0; i < AGENTITE_PROFILER_MAX_SCOPE_DEPTH + 4; i++) {
+        agentite_profiler_trace_end(profiler);
+    }
+    agentite_profiler_trace_stop(profiler);
+
+    size_t count = agentite_profiler_get_trace_event_count(profiler);
+    REQUIRE(count > 0);
+    REQUIRE(count < 64);
+
+    agentite_profiler_destroy(profiler);
+}
+
+TEST_CASE("Profiler trace scope overhead", "[profiler][trace][perf]") {
+    Agentite_Profiler *profiler = agentite_profiler_create(nullptr);
+    REQUIRE(profiler != nullptr);
+    const int iterations = 200000;
+
+    CHECK(agentite_profiler_trace_start(profiler, 0));
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        agentite_profiler_trace_begin(profiler, "hot");
+        agentite_profiler_trace_end(profiler);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    agentite_profiler_trace_stop(profiler);
+
+    double ns_per_scope =
+        (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+        iterations;
+
+    /* Report timing only (target is ~50 ns); WARN so it always shows */
+    WARN("BENCHMARK: Trace scope: " << ns_per_scope << "ns per begin/end pair");
+
+    agentite_profiler_destroy(profiler);
+}
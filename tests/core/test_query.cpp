@@ -0,0 +1,344 @@
+/*
+ * Agentite Query Tests
+ *
+ * Tests for query execution, result caching, dependency-tracked staleness
+ * and in-place cached results.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "agentite/query.h"
+#include <cstring>
+
+/* ============================================================================
+ * Test World and Queries
+ * ============================================================================ */
+
+struct QueryWorld {
+    Agentite_QuerySystem *queries;
+    Agentite_QueryDep dep_gold;
+    Agentite_QueryDep dep_units;
+    Agentite_QueryDep dep_tiles;
+    int gold[4];
+    int units[4];
+    int tiles[4];
+    int runs;           /* Query function invocations */
+};
+
+struct WealthResult {
+    int faction;
+    int value;
+};
+
+/* Gold of a faction; declared statically */
+static Agentite_QueryStatus query_gold(void *game_state, const Agentite_QueryParams *params,
+                                       void *result, size_t result_size, void *userdata) {
+    (void)result_size; (void)userdata;
+    QueryWorld *w = (QueryWorld *)game_state;
+    int faction = agentite_query_params_get_int(params, 0);
+    if (faction < 0 || faction >= 4) {
+        return AGENTITE_QUERY_INVALID_PARAMS;
+    }
+    w->runs++;
+    WealthResult *r = (WealthResult *)result;
+    r->faction = faction;
+    r->value = w->gold[faction];
+    return AGENTITE_QUERY_OK;
+}
+
+/* Units, plus tiles only for odd factions: dependencies tracked at run time */
+static Agentite_QueryStatus query_strength(void *game_state, const Agentite_QueryParams *params,
+                                           void *result, size_t result_size, void *userdata) {
+    (void)result_size; (void)userdata;
+    QueryWorld *w = (QueryWorld *)game_state;
+    int faction = agentite_query_params_get_int(params, 0);
+    w->runs++;
+
+    agentite_query_track(w->queries, w->dep_units);
+    int value = w->units[faction];
+    if (faction & 1) {
+        agentite_query_track(w->queries, w->dep_tiles);
+        value += w->tiles[faction];
+    }
+
+    WealthResult *r = (WealthResult *)result;
+    r->faction = faction;
+    r->value = value;
+    return AGENTITE_QUERY_OK;
+}
+
+/* Gold + strength through nested queries; inherits both dependency sets */
+static Agentite_QueryStatus query_power(void *game_state, const Agentite_QueryParams *params,
+                                        void *result, size_t result_size, void *userdata) {
+    (void)result_size; (void)userdata;
+    QueryWorld *w = (QueryWorld *)game_state;
+    w->runs++;
+
+    WealthResult gold, strength;
+    if (!agentite_query_status_ok(agentite_query_exec(w->queries, "gold", w, params, &gold)) ||
+        !agentite_query_status_ok(agentite_query_exec(w->queries, "strength", w, params, &strength))) {
+        return AGENTITE_QUERY_FAILED;
+    }
+
+    WealthResult *r = (WealthResult *)result;
+    r->faction = gold.faction;
+    r->value = gold.value + strength.value;
+    return AGENTITE_QUERY_OK;
+}
+
+static void world_init(QueryWorld *w) {
+    memset(w, 0, sizeof(*w));
+    w->queries = agentite_query_create();
+    agentite_query_register(w->queries, "gold", query_gold, sizeof(WealthResult));
+    agentite_query_register(w->queries, "strength", query_strength, sizeof(WealthResult));
+    agentite_query_register(w->queries, "power", query_power, sizeof(WealthResult));
+    agentite_query_enable_cache(w->queries, "gold", 4);
+    agentite_query_enable_cache(w->queries, "strength", 4);
+    agentite_query_enable_cache(w->queries, "power", 4);
+
+    w->dep_gold = agentite_query_dep(w->queries, "gold");
+    w->dep_units = agentite_query_dep(w->queries, "units");
+    w->dep_tiles = agentite_query_dep(w->queries, "tiles");
+    agentite_query_add_dep(w->queries, "gold", w->dep_gold);
+
+    for (int i = 0; i < 4; i++) {
+        w->gold[i] = 100 * (i + 1);
+        w->units[i] = 10 * (i + 1);
+        w->tiles[i] = i + 1;
+    }
+}
+
+static int exec_value(QueryWorld *w, const char *name, int faction,
+                      Agentite_QueryStatus *out_status = nullptr) {
+    WealthResult r = {};
+    Agentite_QueryStatus status = agentite_query_exec_int(w->queries, name, w, faction, &r);
+    if (out_status) *out_status = status;
+    return r.value;
+}
+
+/* ============================================================================
+ * Dependency Tests
+ * ============================================================================ */
+
+TEST_CASE("Dependency sources", "[query][deps]") {
+    Agentite_QuerySystem *sys = agentite_query_create();
+
+    Agentite_QueryDep a = agentite_query_dep(sys, "a");
+    Agentite_QueryDep b = agentite_query_dep(sys, "b");
+    REQUIRE(a != 0);
+    REQUIRE(b != a);
+    REQUIRE(agentite_query_dep(sys, "a") == a);
+
+    uint32_t rev = agentite_query_dep_revision(sys, a);
+    agentite_query_dep_bump(sys, a);
+    REQUIRE(agentite_query_dep_revision(sys, a) == rev + 1);
+    REQUIRE(agentite_query_dep_revision(sys, 0) == 0);
+    agentite_query_dep_bump(sys, 999);   /* Ignored */
+
+    REQUIRE_FALSE(agentite_query_add_dep(sys, "missing", a));
+    agentite_query_track(sys, a);        /* No running query: ignored */
+
+    agentite_query_destroy(sys);
+}
+
+TEST_CASE("Cached results go stale when their dependencies change", "[query][deps]") {
+    QueryWorld w;
+    world_init(&w);
+    Agentite_QueryStatus status;
+
+    SECTION("Static dependency") {
+        REQUIRE(exec_value(&w, "gold", 1) == 200);
+        REQUIRE(exec_value(&w, "gold", 1, &status) == 200);
+        REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+        REQUIRE(w.runs == 1);
+
+        /* Unrelated change keeps the entry */
+        agentite_query_dep_bump(w.queries, w.dep_units);
+        exec_value(&w, "gold", 1, &status);
+        REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+
+        w.gold[1] = 250;
+        agentite_query_dep_bump(w.queries, w.dep_gold);
+        REQUIRE(exec_value(&w, "gold", 1, &status) == 250);
+        REQUIRE(status == AGENTITE_QUERY_OK);
+        REQUIRE(w.runs == 2);
+
+        Agentite_QueryStats stats;
+        agentite_query_get_stats(w.queries, &stats);
+        REQUIRE(stats.total_cache_stale == 1);
+    }
+
+    SECTION("Tracked dependency differs per parameter") {
+        REQUIRE(exec_value(&w, "strength", 0) == 10);
+        REQUIRE(exec_value(&w, "strength", 1) == 22);
+        REQUIRE(w.runs == 2);
+
+        /* Only faction 1 read tiles */
+        w.tiles[1] = 8;
+        agentite_query_dep_bump(w.queries, w.dep_tiles);
+        REQUIRE(exec_value(&w, "strength", 0, &status) == 10);
+        REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+        REQUIRE(exec_value(&w, "strength", 1, &status) == 28);
+        REQUIRE(status == AGENTITE_QUERY_OK);
+        REQUIRE(w.runs == 3);
+    }
+
+    SECTION("Nested queries pass their dependencies up") {
+        REQUIRE(exec_value(&w, "power", 2) == 330);
+        int runs = w.runs;
+
+        exec_value(&w, "power", 2, &status);
+        REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+        REQUIRE(w.runs == runs);
+
+        /* Power read gold through the nested query, even from its cache */
+        w.gold[2] = 0;
+        agentite_query_dep_bump(w.queries, w.dep_gold);
+        REQUIRE(exec_value(&w, "power", 2, &status) == 30);
+        REQUIRE(status == AGENTITE_QUERY_OK);
+
+        w.units[2] = 50;
+        agentite_query_dep_bump(w.queries, w.dep_units);
+        REQUIRE(exec_value(&w, "power", 2) == 50);
+    }
+
+    SECTION("Manual invalidation still works") {
+        exec_value(&w, "gold", 0);
+        w.gold[0] = 7;
+        agentite_query_invalidate(w.queries, "gold");
+        REQUIRE(exec_value(&w, "gold", 0) == 7);
+    }
+
+    agentite_query_destroy(w.queries);
+}
+
+/* ============================================================================
+ * In-Place Result Tests
+ * ============================================================================ */
+
+TEST_CASE("Cached results by reference", "[query][ref]") {
+    QueryWorld w;
+    world_init(&w);
+    Agentite_QueryParams params;
+    agentite_query_params_init(&params);
+    agentite_query_params_add_int(&params, 3);
+    Agentite_QueryStatus status;
+
+    SECTION("Miss computes into the cache, hit returns the same storage") {
+        const WealthResult *first = (const WealthResult *)
+            agentite_query_exec_ref(w.queries, "gold", &w, &params, &status);
+        REQUIRE(status == AGENTITE_QUERY_OK);
+        REQUIRE(first != nullptr);
+        REQUIRE(first->value == 400);
+
+        const WealthResult *second = (const WealthResult *)
+            agentite_query_exec_ref(w.queries, "gold", &w, &params, &status);
+        REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+        REQUIRE(second == first);
+        REQUIRE(w.runs == 1);
+
+        /* Stale entries are recomputed in place */
+        w.gold[3] = 1;
+        agentite_query_dep_bump(w.queries, w.dep_gold);
+        const WealthResult *third = (const WealthResult *)
+            agentite_query_exec_ref(w.queries, "gold", &w, &params, &status);
+        REQUIRE(status == AGENTITE_QUERY_OK);
+        REQUIRE(third == first);
+        REQUIRE(third->value == 1);
+    }
+
+    SECTION("Failures return NULL") {
+        Agentite_QueryParams bad;
+        agentite_query_params_init(&bad);
+        agentite_query_params_add_int(&bad, 9);
+        REQUIRE(agentite_query_exec_ref(w.queries, "gold", &w, &bad, &status) == nullptr);
+        REQUIRE(status == AGENTITE_QUERY_INVALID_PARAMS);
+
+        REQUIRE(agentite_query_exec_ref(w.queries, "missing", &w, &params, &status) == nullptr);
+        REQUIRE(status == AGENTITE_QUERY_NOT_FOUND);
+    }
+
+    SECTION("Uncached queries are rejected") {
+        agentite_query_disable_cache(w.queries, "gold");
+        REQUIRE(agentite_query_exec_ref(w.queries, "gold", &w, &params, &status) == nullptr);
+        REQUIRE(status == AGENTITE_QUERY_INVALID_PARAMS);
+
+        /* Copying execution keeps working */
+        REQUIRE(exec_value(&w, "gold", 3) == 400);
+    }
+
+    agentite_query_destroy(w.queries);
+}
+
+TEST_CASE("Cache slots are reused before evicting", "[query][cache]") {
+    QueryWorld w;
+    world_init(&w);
+
+    for (int f = 0; f < 4; f++) {
+        exec_value(&w, "gold", f);
+    }
+    agentite_query_dep_bump(w.queries, w.dep_gold);
+    for (int f = 0; f < 4; f++) {
+        exec_value(&w, "gold", f);
+    }
+
+    uint32_t hits = 0, misses = 0, evictions = 0;
+    agentite_query_get_cache_stats(w.queries, "gold", &hits, &misses, &evictions);
+    REQUIRE(hits == 0);
+    REQUIRE(misses == 8);
+    REQUIRE(evictions == 0);
+
+    agentite_query_destroy(w.queries);
+}
+
+TEST_CASE("Failed queries keep the entry they would have evicted", "[query][cache]") {
+    QueryWorld w;
+    world_init(&w);
+    agentite_query_enable_cache(w.queries, "gold", 2);
+    Agentite_QueryStatus status;
+    uint32_t hits = 0, misses = 0, evictions = 0;
+
+    exec_value(&w, "gold", 0);
+    exec_value(&w, "gold", 1);
+
+    SECTION("Failures leave the full cache intact") {
+        exec_value(&w, "gold", 9, &status);
+        REQUIRE(status == AGENTITE_QUERY_INVALID_PARAMS);
+
+        Agentite_QueryParams bad;
+        agentite_query_params_init(&bad);
+        agentite_query_params_add_int(&bad, -1);
+        REQUIRE(agentite_query_exec_ref(w.queries, "gold", &w, &bad, &status) == nullptr);
+        REQUIRE(status == AGENTITE_QUERY_INVALID_PARAMS);
+
+        for (int f = 0; f < 2; f++) {
+            REQUIRE(exec_value(&w, "gold", f, &status) == 100 * (f + 1));
+            REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+        }
+        agentite_query_get_cache_stats(w.queries, "gold", &hits, &misses, &evictions);
+        REQUIRE(evictions == 0);
+    }
+
+    SECTION("Successful misses still evict the oldest entry") {
+        REQUIRE(exec_value(&w, "gold", 2) == 300);
+
+        Agentite_QueryParams params;
+        agentite_query_params_init(&params);
+        agentite_query_params_add_int(&params, 3);
+        const WealthResult *r = (const WealthResult *)
+            agentite_query_exec_ref(w.queries, "gold", &w, &params, &status);
+        REQUIRE(status == AGENTITE_QUERY_OK);
+        REQUIRE(r != nullptr);
+        REQUIRE(r->value == 400);
+
+        agentite_query_get_cache_stats(w.queries, "gold", &hits, &misses, &evictions);
+        REQUIRE(evictions == 2);
+        exec_value(&w, "gold", 2, &status);
+        REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+        REQUIRE(agentite_query_exec_ref(w.queries, "gold", &w, &params, &status) == r);
+        REQUIRE(status == AGENTITE_QUERY_CACHE_HIT);
+        exec_value(&w, "gold", 0, &status);
+        REQUIRE(status == AGENTITE_QUERY_OK);
+    }
+
+    agentite_query_destroy(w.queries);
+}
@@ -0,0 +1,216 @@
+/*
+ * Agentite File Watcher Tests
+ *
+ * Tests for watcher lifecycle, event coalescing and (on Linux) the
+ * scalable inotify backend.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "agentite/watch.h"
+#include <SDL3/SDL.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* ============================================================================
+ * Test Helpers
+ * ============================================================================ */
+
+static const char *TEST_WATCH_DIR = "./test_watch";
+
+struct WatchRecorder {
+    std::vector<Agentite_WatchEventType> types;
+    std::vector<std::string> paths;
+    std::vector<std::string> old_paths;
+
+    size_t count_for(const char *path) const {
+        size_t n = 0;
+        for (const std::string &p : paths) {
+            if (p == path) n++;
+        }
+        return n;
+    }
+};
+
+static void record_event(const Agentite_WatchEvent *event, void *userdata) {
+    WatchRecorder *rec = static_cast<WatchRecorder *>(userdata);
+    rec->types.push_back(event->type);
+    rec->paths.push_back(event->path);
+    rec->old_paths.push_back(event->old_path);
+}
+
+static void write_file(const std::string &path, const char *contents) {
+    FILE *f = fopen(path.c_str(), "w");
+    REQUIRE(f != nullptr);
+    fputs(contents, f);
+    fclose(f);
+}
+
+static void remove_tree(const std::string &path) {
+    std::string cmd = "rm -rf '" + path + "'";
+    int rc = system(cmd.c_str());
+    (void)rc;
+}
+
+/* Pump the watcher until the debounce window has passed twice over */
+static void pump(Agentite_FileWatcher *watcher, uint32_t ms) {
+    uint64_t end = SDL_GetTicks() + ms;
+    while (SDL_GetTicks() < end) {
+        agentite_watch_update(watcher);
+        SDL_Delay(10);
+    }
+    agentite_watch_update(watcher);
+}
+
+/* ============================================================================
+ * Lifecycle Tests
+ * ============================================================================ */
+
+TEST_CASE("File watcher creation and destruction", "[watch][lifecycle]") {
+    SECTION("Create with defaults") {
+        Agentite_FileWatcher *watcher = agentite_watch_create(nullptr);
+        REQUIRE(watcher != nullptr);
+        REQUIRE(agentite_watch_is_enabled(watcher));
+        REQUIRE(agentite_watch_path_count(watcher) == 0);
+        REQUIRE(agentite_watch_pending_count(watcher) == 0);
+        agentite_watch_destroy(watcher);
+    }
+
+    SECTION("Destroy NULL is safe") {
+        agentite_watch_destroy(nullptr);
+    }
+
+    SECTION("Watching a missing directory fails") {
+        Agentite_FileWatcher *watcher = agentite_watch_create(nullptr);
+        REQUIRE(watcher != nullptr);
+        REQUIRE_FALSE(agentite_watch_add_path(watcher, "./does_not_exist_watch"));
+        agentite_watch_destroy(watcher);
+    }
+}
+
+TEST_CASE("Event type names", "[watch][utility]") {
+    REQUIRE(strcmp(agentite_watch_event_type_name(AGENTITE_WATCH_CREATED), "CREATED") == 0);
+    REQUIRE(strcmp(agentite_watch_event_type_name(AGENTITE_WATCH_RENAMED), "RENAMED") == 0);
+}
+
+#ifdef __linux__
+
+/* ============================================================================
+ * Coalescing Tests (inotify)
+ * ============================================================================ */
+
+TEST_CASE("Editor save sequences coalesce to one event", "[watch][coalesce]") {
+    remove_tree(TEST_WATCH_DIR);
+    mkdir(TEST_WATCH_DIR, 0755);
+    std::string root = TEST_WATCH_DIR;
+    write_file(root + "/unit.toml", "hp = 1\n");
+
+    Agentite_FileWatcherConfig config = AGENTITE_FILE_WATCHER_CONFIG_DEFAULT;
+    config.debounce_ms = 100;
+    Agentite_FileWatcher *watcher = agentite_watch_create(&config);
+    REQUIRE(watcher != nullptr);
+    WatchRecorder rec;
+    agentite_watch_set_callback(watcher, record_event, &rec);
+    REQUIRE(agentite_watch_add_path(watcher, TEST_WATCH_DIR));
+
+    SECTION("Write temp file then rename over target") {
+        write_file(root + "/.unit.toml.tmp", "hp = 2\n");
+        REQUIRE(rename((root + "/.unit.toml.tmp").c_str(), (root + "/unit.toml").c_str()) == 0);
+        pump(watcher, 400);
+
+        REQUIRE(rec.count_for("unit.toml") == 1);
+        REQUIRE(rec.count_for(".unit.toml.tmp") == 0);
+    }
+
+    SECTION("Backup rename, rewrite, delete backup") {
+        REQUIRE(rename((root + "/unit.toml").c_str(), (root + "/unit.toml~").c_str()) == 0);
+        write_file(root + "/unit.toml", "hp = 3\n");
+        REQUIRE(remove((root + "/unit.toml~").c_str()) == 0);
+        pump(watcher, 400);
+
+        REQUIRE(rec.types.size() == 1);
+        REQUIRE(rec.paths[0] == "unit.toml");
+        REQUIRE(rec.types[0] == AGENTITE_WATCH_MODIFIED);
+    }
+
+    SECTION("Transient file is never reported") {
+        write_file(root + "/scratch.txt", "x");
+        REQUIRE(remove((root + "/scratch.txt").c_str()) == 0);
+        pump(watcher, 400);
+
+        REQUIRE(rec.count_for("scratch.txt") == 0);
+    }
+
+    SECTION("Repeated writes produce one event") {
+        for (int i = 0; i < 20; i++) {
+            write_file(root + "/unit.toml", "hp = 4\n");
+        }
+        pump(watcher, 400);
+
+        REQUIRE(rec.count_for("unit.toml") == 1);
+        REQUIRE(rec.types[0] == AGENTITE_WATCH_MODIFIED);
+    }
+
+    agentite_watch_destroy(watcher);
+    remove_tree(TEST_WATCH_DIR);
+}
+
+/* ============================================================================
+ * Scalability Tests (inotify)
+ * ============================================================================ */
+
+TEST_CASE("Large trees and new directories are watched", "[watch][scale]") {
+    remove_tree(TEST_WATCH_DIR);
+    mkdir(TEST_WATCH_DIR, 0755);
+    std::string root = TEST_WATCH_DIR;
+
+    /* More directories than the old fixed 1024-watch table */
+    for (int i = 0; i < 1100; i++) {
+        char dir[64];
+        snprintf(dir, sizeof(dir), "%s/d%04d", TEST_WATCH_DIR, i);
+        mkdir(dir, 0755);
+    }
+
+    Agentite_FileWatcher *watcher = agentite_watch_create(nullptr);
+    REQUIRE(watcher != nullptr);
+    WatchRecorder rec;
+    agentite_watch_set_callback(watcher, record_event, &rec);
+    REQUIRE(agentite_watch_add_path(watcher, TEST_WATCH_DIR));
+
+    SECTION("Changes in the last directory are seen") {
+        write_file(root + "/d1099/last.txt", "x");
+        pump(watcher, 400);
+
+        REQUIRE(rec.count_for("d1099/last.txt") == 1);
+    }
+
+    SECTION("Files in a directory created after watching are seen") {
+        mkdir((root + "/late").c_str(), 0755);
+        pump(watcher, 300);
+        write_file(root + "/late/file.txt", "x");
+        pump(watcher, 400);
+
+        REQUIRE(rec.count_for("late/file.txt") == 1);
+    }
+
+    SECTION("File moved out of the tree is reported deleted") {
+        write_file(root + "/d0000/moving.txt", "x");
+        pump(watcher, 400);
+        rec = WatchRecorder();
+
+        REQUIRE(rename((root + "/d0000/moving.txt").c_str(), "./test_watch_moved.txt") == 0);
+        pump(watcher, 500);
+        remove("./test_watch_moved.txt");
+
+        REQUIRE(rec.count_for("d0000/moving.txt") == 1);
+        REQUIRE(rec.types[0] == AGENTITE_WATCH_DELETED);
+    }
+
+    agentite_watch_destroy(watcher);
+    remove_tree(TEST_WATCH_DIR);
+}
+
+#endif /* __linux__ */
@@ -7,6 +7,8 @@
 
 #include "catch_amalgamated.hpp"
 #include "agentite/ecs.h"
+#include "agentite/profiler.h"
+#include <string.h>
 
 /* ============================================================================
  * World Lifecycle Tests
@@ -410,6 +412,196 @@ TEST_CASE("ECS world progress", "[ecs][progress]") {
     agentite_ecs_shutdown(world);
 }
 
+/* ============================================================================
+ * Threading and System Timing Tests
+ * ============================================================================ */
+
+static int s_task_runs = 0;
+
+static void MoveSystem(ecs_iter_t *it) {
+    C_Position *pos = ecs_field(it, C_Position, 0);
+    const C_Velocity *vel = ecs_field(it, C_Velocity, 1);
+    for (int i = 0; i < it->count; i++) {
+        pos[i].x += vel[i].vx;
+        pos[i].y += vel[i].vy;
+    }
+}
+
+static void HealSystem(ecs_iter_t *it) {
+    C_Health *health = ecs_field(it, C_Health, 0);
+    for (int i = 0; i < it->count; i++) {
+        if (health[i].health < health[i].max_health) health[i].health++;
+    }
+}
+
+static void TaskSystem(ecs_iter_t *it) {
+    (void)it;
+    s_task_runs++;
+}
+
+static ecs_entity_t add_system(ecs_world_t *w, const char *name, ecs_iter_action_t fn,
+                               bool multi_threaded) {
+    ecs_id_t phases[] = { ecs_dependson(EcsOnUpdate), EcsOnUpdate, 0 };
+    ecs_entity_desc_t entity_desc = {};
+    entity_desc.name = name;
+    entity_desc.add = phases;
+
+    ecs_system_desc_t desc = {};
+    desc.entity = ecs_entity_init(w, &entity_desc);
+    desc.callback = fn;
+    desc.multi_threaded = multi_threaded;
+    if (fn == MoveSystem) {
+        desc.query.terms[0].id = ecs_id(C_Position);
+        desc.query.terms[0].inout = EcsInOut;
+        desc.query.terms[1].id = ecs_id(C_Velocity);
+        desc.query.terms[1].inout = EcsIn;
+    } else if (fn == HealSystem) {
+        desc.query.terms[0].id = ecs_id(C_Health);
+        desc.query.terms[0].inout = EcsInOut;
+    }
+    return ecs_system_init(w, &desc);
+}
+
+static void spawn_movers(ecs_world_t *w, int count) {
+    for (int i = 0; i < count; i++) {
+        ecs_entity_t e = ecs_new(w);
+        C_Position pos = { 0.0f, (float)i };
+        C_Velocity vel = { 1.0f, 0.5f };
+        ecs_set_id(w, e, ecs_id(C_Position), sizeof(pos), &pos);
+        ecs_set_id(w, e, ecs_id(C_Velocity), sizeof(vel), &vel);
+    }
+}
+
+static bool movers_moved(ecs_world_t *w, int frames) {
+    ecs_query_desc_t desc = {};
+    desc.terms[0].id = ecs_id(C_Position);
+    ecs_query_t *q = ecs_query_init(w, &desc);
+    bool ok = true;
+    ecs_iter_t it = ecs_query_iter(w, q);
+    while (ecs_query_next(&it)) {
+        const C_Position *pos = ecs_field(&it, C_Position, 0);
+        for (int i = 0; i < it.count; i++) {
+            if (pos[i].x != (float)frames) ok = false;
+        }
+    }
+    ecs_query_fini(q);
+    return ok;
+}
+
+TEST_CASE("ECS thread configuration", "[ecs][threads]") {
+    Agentite_World *world = agentite_ecs_init();
+    REQUIRE(world != nullptr);
+    REQUIRE(agentite_ecs_get_threads(world) == 1);
+
+    REQUIRE(agentite_ecs_set_threads(world, 4));
+    REQUIRE(agentite_ecs_get_threads(world) == 4);
+
+    REQUIRE(agentite_ecs_set_threads(world, AGENTITE_ECS_MAX_THREADS + 10));
+    REQUIRE(agentite_ecs_get_threads(world) == AGENTITE_ECS_MAX_THREADS);
+
+    REQUIRE(agentite_ecs_set_threads(world, 0));
+    REQUIRE(agentite_ecs_get_threads(world) >= 1);
+
+    REQUIRE(agentite_ecs_set_threads(world, 1));
+    REQUIRE(agentite_ecs_get_threads(world) == 1);
+
+    REQUIRE_FALSE(agentite_ecs_set_threads(nullptr, 2));
+    REQUIRE(agentite_ecs_get_threads(nullptr) == 0);
+
+    agentite_ecs_shutdown(world);
+}
+
+TEST_CASE("ECS multi-threaded systems", "[ecs][threads]") {
+    Agentite_World *world = agentite_ecs_init();
+    ecs_world_t *w = agentite_ecs_get_world(world);
+    add_system(w, "MoveSystem", MoveSystem, true);
+    spawn_movers(w, 1000);
+
+    SECTION("Every entity is updated once per frame") {
+        REQUIRE(agentite_ecs_set_threads(world, 4));
+        for (int frame = 0; frame < 3; frame++) {
+            agentite_ecs_progress(world, 0.016f);
+        }
+        REQUIRE(movers_moved(w, 3));
+    }
+
+    SECTION("Single-threaded worlds run the same systems") {
+        agentite_ecs_progress(world, 0.016f);
+        REQUIRE(movers_moved(w, 1));
+    }
+
+    agentite_ecs_shutdown(world);
+}
+
+TEST_CASE("ECS per-system timing", "[ecs][threads][profiler]") {
+    Agentite_World *world = agentite_ecs_init();
+    ecs_world_t *w = agentite_ecs_get_world(world);
+    Agentite_Profiler *profiler = agentite_profiler_create(nullptr);
+
+    ecs_entity_t move = add_system(w, "MoveSystem", MoveSystem, true);
+    ecs_entity_t heal = add_system(w, "HealSystem", HealSystem, false);
+    add_system(w, "TaskSystem", TaskSystem, false);
+    spawn_movers(w, 500);
+    ecs_entity_t patient = ecs_new(w);
+    C_Health hp = { 1, 10 };
+    ecs_set_id(w, patient, ecs_id(C_Health), sizeof(hp), &hp);
+
+    Agentite_EcsSystemTiming timings[8];
+    REQUIRE(agentite_ecs_get_system_timings(world, timings, 8) == 0);
+
+    int threads = GENERATE(1, 3);
+    REQUIRE(agentite_ecs_set_threads(world, threads));
+    agentite_ecs_set_profiler(world, profiler);
+    s_task_runs = 0;
+
+    for (int frame = 0; frame < 2; frame++) {
+        agentite_profiler_begin_frame(profiler);
+        agentite_ecs_progress(world, 0.016f);
+        agentite_profiler_end_frame(profiler);
+    }
+
+    /* Wrapped systems behave as before */
+    REQUIRE(movers_moved(w, 2));
+    REQUIRE(((const C_Health *)ecs_get_id(w, patient, ecs_id(C_Health)))->health == 3);
+    REQUIRE(s_task_runs == 2);
+
+    int count = agentite_ecs_get_system_timings(world, timings, 8);
+    REQUIRE(count == 3);
+    bool saw_move = false, saw_heal = false;
+    for (int i = 0; i < count; i++) {
+        REQUIRE(timings[i].cpu_time_ms >= timings[i].time_ms);
+        if (timings[i].system == move) {
+            saw_move = true;
+            REQUIRE(strcmp(timings[i].name, "MoveSystem") == 0);
+            REQUIRE(timings[i].multi_threaded);
+        } else if (timings[i].system == heal) {
+            saw_heal = true;
+            REQUIRE_FALSE(timings[i].multi_threaded);
+            REQUIRE(timings[i].cpu_time_ms == timings[i].time_ms);
+        }
+    }
+    REQUIRE(saw_move);
+    REQUIRE(saw_heal);
+    REQUIRE(agentite_ecs_get_system_timings(world, timings, 1) == 1);
+
+    /* Systems nest under the ecs_progress scope */
+    uint32_t node_count = 0;
+    const Agentite_ScopeNode *nodes = agentite_profiler_get_scope_tree(profiler, &node_count);
+    int progress = -1, move_node = -1;
+    for (uint32_t i = 0; i < node_count; i++) {
+        if (strcmp(nodes[i].name, "ecs_progress") == 0) progress = (int)i;
+    }
+    for (uint32_t i = 0; i < node_count; i++) {
+        if (strcmp(nodes[i].name, "MoveSystem") == 0) move_node = (int)i;
+    }
+    REQUIRE(progress >= 0);
+    REQUIRE(move_node >= 0);
+    REQUIRE(nodes[move_node].parent == progress);
+
+    agentite_ecs_shutdown(world);
+    agentite_profiler_destroy(profiler);
+}
+
 /* ============================================================================
  * Component Struct Tests
  * ============================================================================ */
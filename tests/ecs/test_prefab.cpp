@@ -403,3 +403,164 @@ TEST_CASE_METHOD(PrefabTestFixture, "Prefab spawning - multiple components", "[p
 
     agentite_prefab_destroy(prefab);
 }
+
+/* ============================================================================
+ * Compiled Prefab Tests
+ * ============================================================================ */
+
+TEST_CASE_METHOD(PrefabTestFixture, "Compiled prefab matches regular spawning", "[prefab][compiled]") {
+    const char *source = R"(
+        Entity @(10, 20) {
+            TestHealth: { current: 50, max: 100 }
+            TestStats: { strength: 15, defense: 8, speed: 1.5 }
+        }
+    )";
+
+    Agentite_Prefab *prefab = agentite_prefab_load_string(source, 0, "test", reflect);
+    REQUIRE(prefab != nullptr);
+
+    ecs_world_t *ecs = agentite_ecs_get_world(world);
+    Agentite_SpawnContext ctx = {};
+    ctx.world = ecs;
+    ctx.reflect = reflect;
+
+    Agentite_CompiledPrefab *compiled = agentite_prefab_compile(prefab, &ctx);
+    REQUIRE(compiled != nullptr);
+
+    ecs_entity_t slow = agentite_prefab_spawn_at(prefab, ecs, reflect, 100, 200);
+    ecs_entity_t fast = agentite_prefab_spawn_compiled(compiled, 100, 200);
+    REQUIRE(fast != 0);
+    REQUIRE(fast != slow);
+    REQUIRE(ecs_get_type(ecs, fast) == ecs_get_type(ecs, slow));
+
+    REQUIRE(memcmp(ecs_get_id(ecs, fast, c_health), ecs_get_id(ecs, slow, c_health),
+                   sizeof(TestHealth)) == 0);
+    REQUIRE(memcmp(ecs_get_id(ecs, fast, c_stats), ecs_get_id(ecs, slow, c_stats),
+                   sizeof(TestStats)) == 0);
+
+    const C_Position *pos = (const C_Position *)ecs_get_id(ecs, fast, ecs_id(C_Position));
+    REQUIRE(pos != nullptr);
+    REQUIRE(pos->x == Catch::Approx(110.0f));
+    REQUIRE(pos->y == Catch::Approx(220.0f));
+
+    agentite_prefab_compiled_destroy(compiled);
+    agentite_prefab_destroy(prefab);
+}
+
+TEST_CASE_METHOD(PrefabTestFixture, "Compiled prefab batch spawning", "[prefab][compiled]") {
+    const char *source = R"(
+        Entity Ship {
+            TestHealth: { current: 30, max: 30 }
+
+            Entity Turret @(4, -2) {
+                TestStats: { strength: 3 }
+            }
+        }
+    )";
+
+    Agentite_Prefab *prefab = agentite_prefab_load_string(source, 0, "test", reflect);
+    REQUIRE(prefab != nullptr);
+
+    ecs_world_t *ecs = agentite_ecs_get_world(world);
+    Agentite_SpawnContext ctx = {};
+    ctx.world = ecs;
+    ctx.reflect = reflect;
+    ctx.offset_x = 1000;
+
+    Agentite_CompiledPrefab *compiled = agentite_prefab_compile(prefab, &ctx);
+    REQUIRE(compiled != nullptr);
+
+    SECTION("Positions and children") {
+        const int count = 100;
+        float positions[count * 2];
+        for (int i = 0; i < count; i++) {
+            positions[i * 2] = (float)i;
+            positions[i * 2 + 1] = (float)(i * 2);
+        }
+
+        ecs_entity_t roots[count] = {};
+        REQUIRE(agentite_prefab_spawn_batch(compiled, count, positions, roots) == count);
+
+        for (int i = 0; i < count; i++) {
+            REQUIRE(ecs_is_alive(ecs, roots[i]));
+            REQUIRE(ecs_get_name(ecs, roots[i]) == nullptr);
+
+            const C_Position *pos = (const C_Position *)ecs_get_id(ecs, roots[i], ecs_id(C_Position));
+            REQUIRE(pos->x == Catch::Approx(1000.0f + i));
+            REQUIRE(pos->y == Catch::Approx(i * 2.0f));
+            REQUIRE(((const TestHealth *)ecs_get_id(ecs, roots[i], c_health))->current == 30);
+
+            /* Child at its local position, not doubled or offset */
+            ecs_iter_t it = ecs_children(ecs, roots[i]);
+            int children = 0;
+            while (ecs_children_next(&it)) {
+                for (int j = 0; j < it.count; j++) {
+                    const C_Position *cpos = (const C_Position *)
+                        ecs_get_id(ecs, it.entities[j], ecs_id(C_Position));
+                    REQUIRE(cpos->x == Catch::Approx(4.0f));
+                    REQUIRE(cpos->y == Catch::Approx(-2.0f));
+                    REQUIRE(((const TestStats *)ecs_get_id(ecs, it.entities[j], c_stats))->strength == 3);
+                    REQUIRE(ecs_get_name(ecs, it.entities[j]) != nullptr);
+                    REQUIRE(strcmp(ecs_get_name(ecs, it.entities[j]), "Turret") == 0);
+                    children++;
+                }
+            }
+            REQUIRE(children == 1);
+        }
+    }
+
+    SECTION("NULL positions spawn at the offset") {
+        REQUIRE(agentite_prefab_spawn_batch(compiled, 3, nullptr, nullptr) == 3);
+
+        ecs_entity_t e = 0;
+        REQUIRE(agentite_prefab_spawn_batch(compiled, 1, nullptr, &e) == 1);
+        const C_Position *pos = (const C_Position *)ecs_get_id(ecs, e, ecs_id(C_Position));
+        REQUIRE(pos->x == Catch::Approx(1000.0f));
+        REQUIRE(pos->y == Catch::Approx(0.0f));
+    }
+
+    SECTION("Deferred world spawns through commands") {
+        float positions[] = { 1, 2, 3, 4 };
+        ecs_entity_t out[2] = {};
+        ecs_defer_begin(ecs);
+        REQUIRE(agentite_prefab_spawn_batch(compiled, 2, positions, out) == 2);
+        ecs_defer_end(ecs);
+
+        const C_Position *pos = (const C_Position *)ecs_get_id(ecs, out[1], ecs_id(C_Position));
+        REQUIRE(pos != nullptr);
+        REQUIRE(pos->x == Catch::Approx(1003.0f));
+        REQUIRE(pos->y == Catch::Approx(4.0f));
+        REQUIRE(ecs_get_id(ecs, out[1], c_health) != nullptr);
+
+        /* Each root gets its own named child */
+        ecs_entity_t t0 = ecs_lookup_child(ecs, out[0], "Turret");
+        ecs_entity_t t1 = ecs_lookup_child(ecs, out[1], "Turret");
+        REQUIRE(t0 != 0);
+        REQUIRE(t1 != 0);
+        REQUIRE(t0 != t1);
+    }
+
+    SECTION("Single named spawn keeps the name") {
+        ecs_entity_t e = agentite_prefab_spawn_compiled(compiled, 0, 0);
+        REQUIRE(e != 0);
+        REQUIRE(strcmp(ecs_get_name(ecs, e), "Ship") == 0);
+    }
+
+    agentite_prefab_compiled_destroy(compiled);
+    agentite_prefab_destroy(prefab);
+}
+
+TEST_CASE_METHOD(PrefabTestFixture, "Compiled prefab - invalid parameters", "[prefab][compiled]") {
+    Agentite_SpawnContext ctx = {};
+    REQUIRE(agentite_prefab_compile(nullptr, &ctx) == nullptr);
+
+    Agentite_Prefab *prefab = agentite_prefab_load_string("Entity {}", 0, "test", reflect);
+    REQUIRE(prefab != nullptr);
+    REQUIRE(agentite_prefab_compile(prefab, &ctx) == nullptr);   /* No world */
+
+    REQUIRE(agentite_prefab_spawn_compiled(nullptr, 0, 0) == 0);
+    REQUIRE(agentite_prefab_spawn_batch(nullptr, 4, nullptr, nullptr) == 0);
+    agentite_prefab_compiled_destroy(nullptr);
+
+    agentite_prefab_destroy(prefab);
+}
@@ -9,6 +9,7 @@
 #include "agentite/ecs.h"
 #include "flecs.h"
 #include <cmath>
+#include <vector>
 
 /* ============================================================================
  * Test Fixtures
@@ -301,6 +302,141 @@ TEST_CASE_METHOD(TransformTestFixture, "Transform propagation - combined", "[tra
     REQUIRE(world_y == Catch::Approx(20.0f).margin(0.001f));
 }
 
+/* ============================================================================
+ * Change Detection Tests
+ * ============================================================================ */
+
+/* Overwrite a world transform without telling Flecs, so a pass that does
+ * not revisit the entity leaves the marker in place */
+static void poison_world_x(ecs_world_t *world, ecs_entity_t e) {
+    C_WorldTransform *wt = ecs_get_mut(world, e, C_WorldTransform);
+    wt->world_x = -9999.0f;
+}
+
+static float world_x_of(ecs_world_t *world, ecs_entity_t e) {
+    float x = 0.0f, y = 0.0f;
+    agentite_transform_get_world_position(world, e, &x, &y);
+    return x;
+}
+
+TEST_CASE_METHOD(TransformTestFixture, "Propagation skips unchanged subtrees", "[transform][propagation][dirty]") {
+    ecs_entity_t root_a = create_entity_with_transform(100, 0);
+    ecs_entity_t root_b = create_entity_with_transform(500, 0);
+    ecs_entity_t child_a = create_entity_with_transform(10, 0);
+    ecs_entity_t child_b = create_entity_with_transform(20, 0);
+    ecs_entity_t leaf_b = create_entity_with_transform(1, 0);
+    agentite_transform_set_parent(world, child_a, root_a);
+    agentite_transform_set_parent(world, child_b, root_b);
+    agentite_transform_set_parent(world, leaf_b, child_b);
+    progress();
+    REQUIRE(world_x_of(world, leaf_b) == Catch::Approx(521.0f));
+
+    SECTION("Nothing changed: nothing is rewritten") {
+        poison_world_x(world, child_a);
+        progress();
+        REQUIRE(world_x_of(world, child_a) == Catch::Approx(-9999.0f));
+    }
+
+    SECTION("A change below one parent leaves other subtrees alone") {
+        poison_world_x(world, leaf_b);
+        agentite_transform_set_local_position(world, child_a, 30, 0);
+        progress();
+        REQUIRE(world_x_of(world, child_a) == Catch::Approx(130.0f));
+        REQUIRE(world_x_of(world, leaf_b) == Catch::Approx(-9999.0f));
+    }
+
+    SECTION("A changed parent updates its whole subtree") {
+        agentite_transform_translate(world, child_b, 5, 0);
+        progress();
+        REQUIRE(world_x_of(world, child_b) == Catch::Approx(525.0f));
+        REQUIRE(world_x_of(world, leaf_b) == Catch::Approx(526.0f));
+
+        agentite_transform_translate(world, root_b, 100, 0);
+        progress();
+        REQUIRE(world_x_of(world, leaf_b) == Catch::Approx(626.0f));
+    }
+
+    SECTION("Reparenting follows the new parent") {
+        agentite_transform_set_parent(world, child_b, root_a);
+        progress();
+        REQUIRE(world_x_of(world, child_b) == Catch::Approx(120.0f));
+        REQUIRE(world_x_of(world, leaf_b) == Catch::Approx(121.0f));
+
+        agentite_transform_remove_parent(world, child_b);
+        progress();
+        REQUIRE(world_x_of(world, leaf_b) == Catch::Approx(21.0f));
+    }
+
+    SECTION("Manual full update rewrites everything") {
+        poison_world_x(world, child_a);
+        poison_world_x(world, leaf_b);
+        agentite_transform_update_all(world);
+        REQUIRE(world_x_of(world, child_a) == Catch::Approx(110.0f));
+        REQUIRE(world_x_of(world, leaf_b) == Catch::Approx(521.0f));
+    }
+}
+
+TEST_CASE_METHOD(TransformTestFixture, "Local transform alone gets a world transform", "[transform][propagation]") {
+    ecs_entity_t parent = ecs_new(world);
+    C_Transform tf = { 40, 0, 0, 1, 1 };
+    ecs_set_id(world, parent, ecs_id(C_Transform), sizeof(C_Transform), &tf);
+    REQUIRE(ecs_has(world, parent, C_WorldTransform));
+
+    ecs_entity_t child = ecs_new(world);
+    agentite_transform_set_parent(world, child, parent);
+    agentite_transform_set_local_position(world, child, 2, 0);
+    progress();
+
+    REQUIRE(world_x_of(world, parent) == Catch::Approx(40.0f));
+    REQUIRE(world_x_of(world, child) == Catch::Approx(42.0f));
+}
+
+TEST_CASE_METHOD(TransformTestFixture, "Propagation matches per-entity composition", "[transform][propagation]") {
+    /* Wide and deep: several children per parent, rotation and scale at every level */
+    std::vector<ecs_entity_t> entities;
+    std::vector<int> parent_of;
+    for (int i = 0; i < 120; i++) {
+        float r = 0.1f * (float)(i % 7);
+        float s = 0.8f + 0.05f * (float)(i % 5);
+        entities.push_back(create_entity_with_transform((float)(i % 11), (float)(i % 13), r, s, s));
+        int parent = i == 0 ? -1 : (i - 1) / 3;
+        parent_of.push_back(parent);
+        if (parent >= 0) {
+            agentite_transform_set_parent(world, entities[i], entities[parent]);
+        }
+    }
+    progress();
+
+    for (int step = 0; step < 2; step++) {
+        for (size_t i = 0; i < entities.size(); i++) {
+            /* Compose from the stored parent result, like the old recursive pass */
+            const C_Transform *t = ecs_get(world, entities[i], C_Transform);
+            float x = t->local_x, y = t->local_y, rot = t->rotation;
+            float sx = t->scale_x, sy = t->scale_y;
+            if (parent_of[i] >= 0) {
+                const C_WorldTransform *p = ecs_get(world, entities[parent_of[i]], C_WorldTransform);
+                float px = x * p->world_scale_x, py = y * p->world_scale_y;
+                x = px * cosf(p->world_rotation) - py * sinf(p->world_rotation) + p->world_x;
+                y = px * sinf(p->world_rotation) + py * cosf(p->world_rotation) + p->world_y;
+                rot += p->world_rotation;
+                sx *= p->world_scale_x;
+                sy *= p->world_scale_y;
+            }
+            const C_WorldTransform *w = ecs_get(world, entities[i], C_WorldTransform);
+            REQUIRE(w->world_x == Catch::Approx(x).margin(0.001f));
+            REQUIRE(w->world_y == Catch::Approx(y).margin(0.001f));
+            REQUIRE(w->world_rotation == Catch::Approx(rot).margin(0.001f));
+            REQUIRE(w->world_scale_x == Catch::Approx(sx));
+            REQUIRE(w->world_scale_y == Catch::Approx(sy));
+        }
+
+        /* Move an inner node and check again */
+        agentite_transform_rotate(world, entities[4], 0.5f);
+        agentite_transform_translate(world, entities[1], 3, -2);
+        progress();
+    }
+}
+
 /* ============================================================================
  * Coordinate Conversion Tests
  * ============================================================================ */
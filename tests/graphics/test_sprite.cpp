@@ -42,10 +42,10 @@ TEST_CASE("Sprite vertex struct layout", "[sprite][vertex]") {
         REQUIRE(vertex.pos[1] == 0.0f);
         REQUIRE(vertex.uv[0] == 0.0f);
         REQUIRE(vertex.uv[1] == 0.0f);
-        REQUIRE(vertex.color[0] == 0.0f);
-        REQUIRE(vertex.color[1] == 0.0f);
-        REQUIRE(vertex.color[2] == 0.0f);
-        REQUIRE(vertex.color[3] == 0.0f);
+        REQUIRE(vertex.color[0] == 0);
+        REQUIRE(vertex.color[1] == 0);
+        REQUIRE(vertex.color[2] == 0);
+        REQUIRE(vertex.color[3] == 0);
     }
 
     SECTION("Vertex field assignment") {
@@ -54,19 +54,19 @@ TEST_CASE("Sprite vertex struct layout", "[sprite][vertex]") {
         vertex.pos[1] = 200.0f;
         vertex.uv[0] = 0.5f;
         vertex.uv[1] = 0.75f;
-        vertex.color[0] = 1.0f;
-        vertex.color[1] = 0.5f;
-        vertex.color[2] = 0.25f;
-        vertex.color[3] = 1.0f;
+        vertex.color[0] = 255;
+        vertex.color[1] = 128;
+        vertex.color[2] = 64;
+        vertex.color[3] = 255;
 
         REQUIRE(vertex.pos[0] == 100.0f);
         REQUIRE(vertex.pos[1] == 200.0f);
         REQUIRE(vertex.uv[0] == 0.5f);
         REQUIRE(vertex.uv[1] == 0.75f);
-        REQUIRE(vertex.color[0] == 1.0f);
-        REQUIRE(vertex.color[1] == 0.5f);
-        REQUIRE(vertex.color[2] == 0.25f);
-        REQUIRE(vertex.color[3] == 1.0f);
+        REQUIRE(vertex.color[0] == 255);
+        REQUIRE(vertex.color[1] == 128);
+        REQUIRE(vertex.color[2] == 64);
+        REQUIRE(vertex.color[3] == 255);
     }
 
     SECTION("Vertex struct is POD-like") {
@@ -74,14 +74,82 @@ TEST_CASE("Sprite vertex struct layout", "[sprite][vertex]") {
         Agentite_SpriteVertex v1 = {};
         v1.pos[0] = 10.0f;
         v1.pos[1] = 20.0f;
-        v1.color[3] = 1.0f;
+        v1.color[3] = 255;
 
         Agentite_SpriteVertex v2;
         std::memcpy(&v2, &v1, sizeof(Agentite_SpriteVertex));
 
         REQUIRE(v2.pos[0] == 10.0f);
         REQUIRE(v2.pos[1] == 20.0f);
-        REQUIRE(v2.color[3] == 1.0f);
+        REQUIRE(v2.color[3] == 255);
+    }
+}
+
+/* ============================================================================
+ * Vertex Generation Tests
+ * ============================================================================ */
+
+TEST_CASE("Sprite color packing", "[sprite][vertex]") {
+    uint8_t c[4];
+
+    SECTION("Components round to the nearest byte") {
+        agentite_sprite_pack_color(c, 1.0f, 0.5f, 0.25f, 0.0f);
+        REQUIRE(c[0] == 255);
+        REQUIRE(c[1] == 128);
+        REQUIRE(c[2] == 64);
+        REQUIRE(c[3] == 0);
+    }
+
+    SECTION("Out-of-range components are clamped") {
+        agentite_sprite_pack_color(c, -1.0f, 2.0f, 1.0001f, -0.0001f);
+        REQUIRE(c[0] == 0);
+        REQUIRE(c[1] == 255);
+        REQUIRE(c[2] == 255);
+        REQUIRE(c[3] == 0);
+    }
+}
+
+TEST_CASE("Sprite quad building", "[sprite][vertex]") {
+    Agentite_SpriteVertex v[4];
+
+    SECTION("Unrotated quad around its origin") {
+        agentite_sprite_build_quad(v, 100.0f, 50.0f, 32.0f, 16.0f, 0.0f,
+                                   0.5f, 0.5f, 0.0f, 0.25f, 0.5f, 0.75f,
+                                   1.0f, 1.0f, 1.0f, 0.5f);
+
+        /* Top-left, top-right, bottom-right, bottom-left */
+        REQUIRE(v[0].pos[0] == 84.0f);
+        REQUIRE(v[0].pos[1] == 42.0f);
+        REQUIRE(v[1].pos[0] == 116.0f);
+        REQUIRE(v[1].pos[1] == 42.0f);
+        REQUIRE(v[2].pos[0] == 116.0f);
+        REQUIRE(v[2].pos[1] == 58.0f);
+        REQUIRE(v[3].pos[0] == 84.0f);
+        REQUIRE(v[3].pos[1] == 58.0f);
+
+        REQUIRE(v[0].uv[0] == 0.0f);
+        REQUIRE(v[0].uv[1] == 0.25f);
+        REQUIRE(v[2].uv[0] == 0.5f);
+        REQUIRE(v[2].uv[1] == 0.75f);
+
+        for (int i = 0; i < 4; i++) {
+            REQUIRE(v[i].color[0] == 255);
+            REQUIRE(v[i].color[3] == 128);
+        }
+    }
+
+    SECTION("Rotation turns corners about the origin") {
+        agentite_sprite_build_quad(v, 0.0f, 0.0f, 10.0f, 10.0f, 90.0f,
+                                   0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f,
+                                   1.0f, 1.0f, 1.0f, 1.0f);
+
+        /* Origin corner stays put; the top-right corner swings to +Y */
+        REQUIRE(v[0].pos[0] == Catch::Approx(0.0f).margin(1e-4));
+        REQUIRE(v[0].pos[1] == Catch::Approx(0.0f).margin(1e-4));
+        REQUIRE(v[1].pos[0] == Catch::Approx(0.0f).margin(1e-4));
+        REQUIRE(v[1].pos[1] == Catch::Approx(10.0f));
+        REQUIRE(v[2].pos[0] == Catch::Approx(-10.0f));
+        REQUIRE(v[2].pos[1] == Catch::Approx(10.0f));
     }
 }
 
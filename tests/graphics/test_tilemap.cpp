@@ -3,11 +3,13 @@
  *
  * Tests for tilemap functionality that can be tested without GPU.
  * Note: Most tilemap creation requires a tileset with a valid texture,
- * so these tests focus on NULL safety and constants.
+ * so these tests focus on NULL safety, constants and the CPU mesh builder.
  */
 
 #include "catch_amalgamated.hpp"
 #include "agentite/tilemap.h"
+#include "agentite/sprite.h"
+#include <cstring>
 
 /* ============================================================================
  * Tilemap Constants Tests
@@ -275,6 +277,99 @@ TEST_CASE("Tilemap rendering NULL safety", "[tilemap][render][null]") {
         // Should not crash
         agentite_tilemap_render_layer(nullptr, nullptr, nullptr, 0);
     }
+
+    SECTION("agentite_tilemap_release_meshes with NULL tilemap") {
+        // Should not crash
+        agentite_tilemap_release_meshes(nullptr);
+    }
+}
+
+/* ============================================================================
+ * Memory Stats Tests
+ * ============================================================================ */
+
+TEST_CASE("Tilemap memory stats NULL safety", "[tilemap][memory][null]") {
+    SECTION("NULL tilemap clears the output") {
+        Agentite_TilemapMemoryStats stats;
+        memset(&stats, 0xFF, sizeof(stats));
+        agentite_tilemap_get_memory_stats(nullptr, &stats);
+        REQUIRE(stats.chunk_count == 0);
+        REQUIRE(stats.uniform_chunks == 0);
+        REQUIRE(stats.tile_bytes == 0);
+        REQUIRE(stats.uncompressed_bytes == 0);
+        REQUIRE(stats.mesh_bytes == 0);
+    }
+
+    SECTION("NULL output") {
+        // Should not crash
+        agentite_tilemap_get_memory_stats(nullptr, nullptr);
+    }
+}
+
+/* ============================================================================
+ * Chunk Mesh Builder Tests
+ * ============================================================================ */
+
+TEST_CASE("Tilemap chunk mesh building", "[tilemap][mesh]") {
+    const Agentite_TileUV uvs[2] = {
+        { 0.0f, 0.0f, 0.5f, 1.0f },
+        { 0.5f, 0.0f, 1.0f, 1.0f },
+    };
+    Agentite_TileMeshDesc desc = {};
+    desc.uvs = uvs;
+    desc.uv_count = 2;
+    desc.tile_width = 16.0f;
+    desc.tile_height = 8.0f;
+    desc.origin_x = 100.0f;
+    desc.origin_y = 200.0f;
+    desc.opacity = 0.5f;
+
+    Agentite_SpriteVertex verts[4 * 6];
+
+    SECTION("Emits one quad per drawable tile") {
+        /* 3x2 region; empty and out-of-range IDs are skipped */
+        const Agentite_TileID tiles[6] = {
+            1, AGENTITE_TILE_EMPTY, 2,
+            7, 2, AGENTITE_TILE_EMPTY,
+        };
+        REQUIRE(agentite_tilemap_build_mesh(&desc, tiles, 3, 2, 3, verts) == 3);
+
+        /* Tile (0,0) with ID 1: TL, TR, BR, BL */
+        REQUIRE(verts[0].pos[0] == 100.0f);
+        REQUIRE(verts[0].pos[1] == 200.0f);
+        REQUIRE(verts[2].pos[0] == 116.0f);
+        REQUIRE(verts[2].pos[1] == 208.0f);
+        REQUIRE(verts[1].uv[0] == 0.5f);
+        REQUIRE(verts[3].uv[1] == 1.0f);
+        REQUIRE(verts[0].color[3] == 128);
+
+        /* Tile (2,0) with ID 2 */
+        REQUIRE(verts[4].pos[0] == 132.0f);
+        REQUIRE(verts[4].uv[0] == 0.5f);
+        REQUIRE(verts[5].uv[0] == 1.0f);
+
+        /* Tile (1,1) with ID 2 */
+        REQUIRE(verts[8].pos[0] == 116.0f);
+        REQUIRE(verts[8].pos[1] == 208.0f);
+    }
+
+    SECTION("Stride selects a sub-region of a wider grid") {
+        const Agentite_TileID tiles[8] = {
+            1, 1, 2, 2,
+            2, 2, 1, 1,
+        };
+        REQUIRE(agentite_tilemap_build_mesh(&desc, tiles, 2, 2, 4, verts) == 4);
+        REQUIRE(verts[8].pos[1] == 208.0f);
+        REQUIRE(verts[8].uv[0] == 0.5f);
+    }
+
+    SECTION("Empty grid and NULL inputs build nothing") {
+        const Agentite_TileID tiles[4] = {};
+        REQUIRE(agentite_tilemap_build_mesh(&desc, tiles, 2, 2, 2, verts) == 0);
+        REQUIRE(agentite_tilemap_build_mesh(nullptr, tiles, 2, 2, 2, verts) == 0);
+        REQUIRE(agentite_tilemap_build_mesh(&desc, nullptr, 2, 2, 2, verts) == 0);
+        REQUIRE(agentite_tilemap_build_mesh(&desc, tiles, 2, 2, 2, nullptr) == 0);
+    }
 }
 
 /* ============================================================================
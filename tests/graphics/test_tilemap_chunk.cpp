@@ -0,0 +1,406 @@
+/*
+ * Agentite Tilemap Chunk Storage Tests
+ *
+ * Tests for the palette-compressed chunk storage behind the tilemap. The
+ * storage needs no tileset or texture, so every edit is checked tile by
+ * tile against a plain reference array, along with the palette refcounts
+ * and the memory stats.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "graphics/tilemap_internal.h"
+#include <cstring>
+#include <random>
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+/* Chunk storage plus the tiles it should hold */
+struct ChunkFixture {
+    TileChunkStorage chunk;
+    Agentite_TileID ref[TILE_CHUNK_TILES];
+
+    ChunkFixture() {
+        memset(&chunk, 0, sizeof(chunk));
+        memset(ref, 0, sizeof(ref));
+    }
+    ~ChunkFixture() { tile_chunk_release(&chunk); }
+
+    bool set(int x, int y, Agentite_TileID tile) {
+        int idx = y * AGENTITE_TILEMAP_CHUNK_SIZE + x;
+        bool changed = false;
+        bool ok = tile_chunk_set(&chunk, idx, tile, &changed);
+        if (ok) {
+            if (changed != (ref[idx] != tile)) return false;
+            ref[idx] = tile;
+        }
+        return ok;
+    }
+
+    bool fill(int x0, int y0, int x1, int y1, Agentite_TileID tile) {
+        const int cs = AGENTITE_TILEMAP_CHUNK_SIZE;
+        bool expect_change = false;
+        for (int y = y0 < 0 ? 0 : y0; y < (y1 > cs ? cs : y1); y++) {
+            for (int x = x0 < 0 ? 0 : x0; x < (x1 > cs ? cs : x1); x++) {
+                if (ref[y * cs + x] != tile) expect_change = true;
+                ref[y * cs + x] = tile;
+            }
+        }
+        bool changed = false;
+        bool ok = tile_chunk_fill(&chunk, x0, y0, x1, y1, tile, &changed);
+        return ok && changed == expect_change;
+    }
+
+    int distinct() const {
+        bool seen[1u << 16] = {};
+        int count = 0;
+        for (int i = 0; i < TILE_CHUNK_TILES; i++) {
+            if (!seen[ref[i]]) { seen[ref[i]] = true; count++; }
+        }
+        return count;
+    }
+};
+
+static Agentite_TilemapMemoryStats chunk_stats(const TileChunkStorage *chunk)
+{
+    Agentite_TilemapMemoryStats stats;
+    memset(&stats, 0, sizeof(stats));
+    tile_chunk_add_stats(chunk, &stats);
+    return stats;
+}
+
+static int bits_slot(int bits)
+{
+    int slot = 0;
+    while ((1 << slot) < bits) slot++;
+    return slot;
+}
+
+/* Tiles, tile count, palette refcounts and memory stats all agree with
+ * the reference array */
+static void check_chunk(const ChunkFixture &f)
+{
+    const TileChunkStorage *c = &f.chunk;
+
+    int mismatches = 0;
+    uint32_t non_empty = 0;
+    Agentite_TileID decoded[TILE_CHUNK_TILES];
+    tile_chunk_decode(c, decoded);
+    for (int i = 0; i < TILE_CHUNK_TILES; i++) {
+        if (tile_chunk_get(c, i) != f.ref[i] || decoded[i] != f.ref[i]) mismatches++;
+        if (f.ref[i] != AGENTITE_TILE_EMPTY) non_empty++;
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(c->tile_count == non_empty);
+
+    Agentite_TilemapMemoryStats stats = chunk_stats(c);
+    REQUIRE(stats.chunk_count == 1);
+
+    if (c->bits == 0) {
+        REQUIRE(f.distinct() == 1);
+        REQUIRE(c->indices == nullptr);
+        REQUIRE(c->palette == nullptr);
+        REQUIRE(stats.uniform_chunks == 1);
+        REQUIRE(tile_chunk_storage_bytes(c) == 0);
+        REQUIRE(stats.tile_bytes == 0);
+        return;
+    }
+
+    /* Packed: at least two distinct tiles, and the width holds every slot */
+    REQUIRE(f.distinct() >= 2);
+    REQUIRE(c->palette_used == f.distinct());
+    REQUIRE(c->palette_count <= (1 << c->bits));
+    REQUIRE(c->palette_count <= c->palette_capacity);
+
+    int used = 0;
+    uint32_t refs_total = 0;
+    for (int s = 0; s < c->palette_count; s++) {
+        const TileChunkPaletteEntry *e = &c->palette[s];
+        if (e->refs == 0) continue;
+        used++;
+        refs_total += e->refs;
+
+        uint32_t uses = 0;
+        for (int i = 0; i < TILE_CHUNK_TILES; i++) {
+            if (f.ref[i] == e->tile) uses++;
+        }
+        REQUIRE(e->refs == uses);
+    }
+    REQUIRE(used == c->palette_used);
+    REQUIRE(refs_total == TILE_CHUNK_TILES);
+
+    size_t bytes = (size_t)c->palette_capacity * sizeof(TileChunkPaletteEntry) +
+                   (size_t)TILE_CHUNK_TILES * c->bits / 8;
+    REQUIRE(tile_chunk_storage_bytes(c) == bytes);
+    REQUIRE(stats.tile_bytes == bytes);
+    REQUIRE(stats.uniform_chunks == 0);
+    for (int s = 0; s < 5; s++) {
+        REQUIRE(stats.packed_chunks[s] == (s == bits_slot(c->bits) ? 1 : 0));
+    }
+}
+
+/* Put tiles 1..count at the first count positions (empty elsewhere) */
+static void place_distinct(ChunkFixture &f, int count)
+{
+    for (int i = 0; i < count; i++) {
+        REQUIRE(f.set(i % AGENTITE_TILEMAP_CHUNK_SIZE, i / AGENTITE_TILEMAP_CHUNK_SIZE,
+                      (Agentite_TileID)(i + 1)));
+    }
+}
+
+/* ============================================================================
+ * Uniform Chunk Tests
+ * ============================================================================ */
+
+TEST_CASE("Chunk storage starts uniform empty", "[tilemap][chunk]") {
+    ChunkFixture f;
+
+    REQUIRE(f.chunk.bits == 0);
+    REQUIRE(f.chunk.uniform == AGENTITE_TILE_EMPTY);
+    check_chunk(f);
+
+    SECTION("Setting the same tile changes nothing") {
+        REQUIRE(f.set(5, 5, AGENTITE_TILE_EMPTY));
+        REQUIRE(f.chunk.bits == 0);
+        check_chunk(f);
+    }
+
+    SECTION("Uniform non-empty chunk counts every tile") {
+        tile_chunk_set_uniform(&f.chunk, 7);
+        for (int i = 0; i < TILE_CHUNK_TILES; i++) f.ref[i] = 7;
+        REQUIRE(f.chunk.tile_count == TILE_CHUNK_TILES);
+        check_chunk(f);
+    }
+}
+
+TEST_CASE("Chunk storage expands from and collapses to uniform", "[tilemap][chunk]") {
+    ChunkFixture f;
+    tile_chunk_set_uniform(&f.chunk, 7);
+    for (int i = 0; i < TILE_CHUNK_TILES; i++) f.ref[i] = 7;
+
+    SECTION("One different tile expands to a 1-bit palette") {
+        REQUIRE(f.set(3, 4, 9));
+        REQUIRE(f.chunk.bits == 1);
+        REQUIRE(f.chunk.palette_used == 2);
+        check_chunk(f);
+
+        SECTION("Restoring it collapses back to uniform") {
+            REQUIRE(f.set(3, 4, 7));
+            REQUIRE(f.chunk.bits == 0);
+            REQUIRE(f.chunk.uniform == 7);
+            check_chunk(f);
+        }
+
+        SECTION("Overwriting every original tile collapses to the new one") {
+            for (int y = 0; y < AGENTITE_TILEMAP_CHUNK_SIZE; y++) {
+                for (int x = 0; x < AGENTITE_TILEMAP_CHUNK_SIZE; x++) {
+                    REQUIRE(f.set(x, y, 9));
+                }
+            }
+            REQUIRE(f.chunk.bits == 0);
+            REQUIRE(f.chunk.uniform == 9);
+            check_chunk(f);
+        }
+    }
+
+    SECTION("Emptying tiles updates the tile count") {
+        REQUIRE(f.set(0, 0, AGENTITE_TILE_EMPTY));
+        REQUIRE(f.set(31, 31, AGENTITE_TILE_EMPTY));
+        REQUIRE(f.chunk.tile_count == TILE_CHUNK_TILES - 2);
+        check_chunk(f);
+    }
+}
+
+/* ============================================================================
+ * Index Width Tests
+ * ============================================================================ */
+
+TEST_CASE("Chunk storage widens through every index width", "[tilemap][chunk]") {
+    ChunkFixture f;
+
+    /* Tiles 1..n plus the empty background give n + 1 distinct tiles */
+    struct { int tiles; uint8_t bits; } steps[] = {
+        { 1, 1 },     /* 2 distinct */
+        { 2, 2 },     /* 3 */
+        { 3, 2 },     /* 4 */
+        { 4, 4 },     /* 5 */
+        { 15, 4 },    /* 16 */
+        { 16, 8 },    /* 17 */
+        { 255, 8 },   /* 256 */
+        { 256, 16 },  /* 257 */
+        { 1023, 16 }, /* Every tile different */
+    };
+
+    for (const auto &step : steps) {
+        CAPTURE(step.tiles);
+        place_distinct(f, step.tiles);
+        REQUIRE(f.chunk.bits == step.bits);
+        REQUIRE(f.chunk.palette_used == step.tiles + 1);
+        check_chunk(f);
+    }
+
+    SECTION("Every tile distinct") {
+        REQUIRE(f.set(31, 31, 5000));
+        REQUIRE(f.chunk.palette_used == TILE_CHUNK_TILES);
+        REQUIRE(f.chunk.bits == 16);
+        check_chunk(f);
+    }
+}
+
+/* ============================================================================
+ * Narrowing Tests
+ * ============================================================================ */
+
+TEST_CASE("Chunk storage narrows with hysteresis", "[tilemap][chunk]") {
+    ChunkFixture f;
+    place_distinct(f, 300);
+    REQUIRE(f.chunk.bits == 16);
+
+    /* Remove tiles from the front so the survivors have to be remapped */
+    auto remove_until = [&](int tiles_left) {
+        for (int i = 0; i < 300; i++) {
+            if (f.distinct() - 1 <= tiles_left) break;
+            int x = i % AGENTITE_TILEMAP_CHUNK_SIZE, y = i / AGENTITE_TILEMAP_CHUNK_SIZE;
+            if (f.ref[y * AGENTITE_TILEMAP_CHUNK_SIZE + x] != AGENTITE_TILE_EMPTY) {
+                REQUIRE(f.set(x, y, AGENTITE_TILE_EMPTY));
+            }
+        }
+        REQUIRE(f.distinct() == tiles_left + 1);
+    };
+
+    SECTION("16 bits holds until 4 bits would do") {
+        remove_until(16);   /* 17 distinct: 8 bits would fit, not worth it */
+        REQUIRE(f.chunk.bits == 16);
+        check_chunk(f);
+
+        remove_until(15);   /* 16 distinct: straight down to 4 bits */
+        REQUIRE(f.chunk.bits == 4);
+        REQUIRE(f.chunk.palette_count == 16);
+        check_chunk(f);
+
+        SECTION("4 bits holds at 2-bit sizes") {
+            remove_until(3);
+            REQUIRE(f.chunk.bits == 4);
+            check_chunk(f);
+
+            remove_until(2);
+            REQUIRE(f.chunk.bits == 4);
+            check_chunk(f);
+
+            SECTION("Adding a tile back reuses a free slot") {
+                REQUIRE(f.set(10, 10, 4242));
+                REQUIRE(f.chunk.bits == 4);
+                check_chunk(f);
+            }
+
+            SECTION("Two distinct tiles narrow to 1 bit") {
+                remove_until(1);
+                REQUIRE(f.chunk.bits == 1);
+                REQUIRE(f.chunk.palette_count == 2);
+                check_chunk(f);
+
+                remove_until(0);
+                REQUIRE(f.chunk.bits == 0);
+                REQUIRE(f.chunk.uniform == AGENTITE_TILE_EMPTY);
+                check_chunk(f);
+            }
+        }
+    }
+
+    SECTION("Refilled tiles keep their values across remaps") {
+        remove_until(40);
+        for (int i = 0; i < 64; i++) {
+            REQUIRE(f.set(i % 8 + 16, i / 8 + 16, (Agentite_TileID)(1000 + i % 5)));
+        }
+        check_chunk(f);
+        remove_until(5);
+        check_chunk(f);
+    }
+}
+
+/* ============================================================================
+ * Fill Tests
+ * ============================================================================ */
+
+TEST_CASE("Chunk fill only makes fully covered chunks uniform", "[tilemap][chunk]") {
+    ChunkFixture f;
+    place_distinct(f, 100);
+    REQUIRE(f.chunk.bits == 8);
+
+    SECTION("Covering rectangle becomes uniform") {
+        REQUIRE(f.fill(0, 0, AGENTITE_TILEMAP_CHUNK_SIZE, AGENTITE_TILEMAP_CHUNK_SIZE, 3));
+        REQUIRE(f.chunk.bits == 0);
+        REQUIRE(f.chunk.uniform == 3);
+        check_chunk(f);
+
+        SECTION("Filling again changes nothing") {
+            REQUIRE(f.fill(0, 0, AGENTITE_TILEMAP_CHUNK_SIZE, AGENTITE_TILEMAP_CHUNK_SIZE, 3));
+            check_chunk(f);
+        }
+    }
+
+    SECTION("Rectangle reaching past the chunk becomes uniform") {
+        REQUIRE(f.fill(-10, -3, 50, 40, 4));
+        REQUIRE(f.chunk.bits == 0);
+        check_chunk(f);
+    }
+
+    SECTION("Rectangle one row short stays packed") {
+        REQUIRE(f.fill(0, 0, AGENTITE_TILEMAP_CHUNK_SIZE, AGENTITE_TILEMAP_CHUNK_SIZE - 1, 6));
+        REQUIRE(f.chunk.bits != 0);
+        check_chunk(f);
+
+        SECTION("Filling the last row collapses it") {
+            REQUIRE(f.fill(0, AGENTITE_TILEMAP_CHUNK_SIZE - 1,
+                           AGENTITE_TILEMAP_CHUNK_SIZE, AGENTITE_TILEMAP_CHUNK_SIZE, 6));
+            REQUIRE(f.chunk.bits == 0);
+            REQUIRE(f.chunk.uniform == 6);
+            check_chunk(f);
+        }
+    }
+
+    SECTION("Partial rectangle is clipped to the chunk") {
+        REQUIRE(f.fill(-3, 30, 2, 50, 8));
+        REQUIRE(f.chunk.bits == 8);
+        check_chunk(f);
+    }
+
+    SECTION("Empty rectangle changes nothing") {
+        REQUIRE(f.fill(5, 5, 5, 20, 8));
+        check_chunk(f);
+    }
+}
+
+/* ============================================================================
+ * Round Trip Tests
+ * ============================================================================ */
+
+TEST_CASE("Chunk storage random round trip", "[tilemap][chunk]") {
+    std::mt19937 rng(1234);
+
+    /* Tile pools of different sizes push the chunk through every width */
+    const int pools[] = { 1, 2, 3, 12, 40, 300, 2000 };
+    for (int pool : pools) {
+        CAPTURE(pool);
+        ChunkFixture f;
+        std::uniform_int_distribution<int> coord(0, AGENTITE_TILEMAP_CHUNK_SIZE - 1);
+        std::uniform_int_distribution<int> tile(0, pool);
+
+        for (int step = 0; step < 4000; step++) {
+            if (step % 500 == 250) {
+                int x0 = coord(rng) - 8, y0 = coord(rng) - 8;
+                REQUIRE(f.fill(x0, y0, x0 + coord(rng) + 8, y0 + coord(rng) + 8,
+                               (Agentite_TileID)tile(rng)));
+            } else {
+                REQUIRE(f.set(coord(rng), coord(rng), (Agentite_TileID)tile(rng)));
+            }
+            if (step % 400 == 0) check_chunk(f);
+        }
+        check_chunk(f);
+
+        tile_chunk_release(&f.chunk);
+        memset(f.ref, 0, sizeof(f.ref));
+        check_chunk(f);
+    }
+}
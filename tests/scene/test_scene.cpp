@@ -9,7 +9,13 @@
 #include "agentite/prefab.h"
 #include "agentite/ecs.h"
 #include "agentite/ecs_reflect.h"
+#include <cstdio>
 #include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /* ============================================================================
  * Test Component Types
@@ -455,6 +461,15 @@ TEST_CASE_METHOD(SceneTestFixture, "Scene instantiation - nested entities", "[sc
     size_t root_count = agentite_scene_get_root_entities(scene, roots, 16);
     REQUIRE(root_count == 1);
 
+    /* Roots sit at their position, children at their local position */
+    const C_Position *pos = (const C_Position *)ecs_get_id(ecs, roots[0], ecs_id(C_Position));
+    REQUIRE(pos != nullptr);
+    REQUIRE(pos->x == Catch::Approx(100.0f));
+    ecs_entity_t weapon = agentite_scene_find_entity(scene, "Weapon");
+    pos = (const C_Position *)ecs_get_id(ecs, weapon, ecs_id(C_Position));
+    REQUIRE(pos != nullptr);
+    REQUIRE(pos->x == Catch::Approx(20.0f));
+
     agentite_scene_destroy(scene);
 }
 
@@ -774,3 +789,329 @@ TEST_CASE_METHOD(SceneTestFixture, "Re-instantiation after uninstantiate", "[sce
 
     agentite_scene_destroy(scene);
 }
+
+/* ============================================================================
+ * Compiled Scene Cache Tests
+ * ============================================================================ */
+
+#define TEST_CACHE_ROOT "/tmp/agentite_test_scene_cache"
+
+static void write_text_file(const std::string &path, const char *text) {
+    FILE *file = fopen(path.c_str(), "w");
+    REQUIRE(file != nullptr);
+    fputs(text, file);
+    fclose(file);
+}
+
+static std::string find_cache_file(const char *dir) {
+    std::string path;
+    DIR *d = opendir(dir);
+    if (!d) return path;
+    while (struct dirent *entry = readdir(d)) {
+        if (strstr(entry->d_name, ".scenebin")) {
+            path = std::string(dir) + "/" + entry->d_name;
+        }
+    }
+    closedir(d);
+    return path;
+}
+
+static void remove_cache_dir() {
+    std::string cache_file;
+    while (!(cache_file = find_cache_file(TEST_CACHE_ROOT "/cache")).empty()) {
+        remove(cache_file.c_str());
+    }
+    rmdir(TEST_CACHE_ROOT "/cache");
+    remove(TEST_CACHE_ROOT "/level.scene");
+    remove(TEST_CACHE_ROOT "/stream.scene");
+    rmdir(TEST_CACHE_ROOT);
+}
+
+TEST_CASE_METHOD(SceneTestFixture, "Compiled scene cache", "[scene][cache]") {
+    const char *source = R"(
+        Player @(100, 50) {
+            TestHealth: { current: 80, max: 100 }
+            TestSprite: "player.png"
+
+            Weapon @(20, 0) {
+                TestHealth: 5
+            }
+        }
+
+        Entity @(1, 2) { TestHealth: 7 }
+        Entity @(3, 4) { TestHealth: 8 }
+        Entity @(5, 6) { TestHealth: 9 }
+    )";
+
+    remove_cache_dir();
+    mkdir(TEST_CACHE_ROOT, 0755);
+    mkdir(TEST_CACHE_ROOT "/cache", 0755);
+    std::string path = TEST_CACHE_ROOT "/level.scene";
+    write_text_file(path, source);
+
+    auto ctx = make_context();
+    ctx.cache_dir = TEST_CACHE_ROOT "/cache";
+    ecs_world_t *ecs = agentite_ecs_get_world(world);
+
+    /* First load parses and writes the cache */
+    Agentite_Scene *parsed = agentite_scene_load(scenes, path.c_str(), &ctx);
+    REQUIRE(parsed != nullptr);
+    REQUIRE_FALSE(agentite_scene_is_from_cache(parsed));
+    std::string cache_file = find_cache_file(ctx.cache_dir);
+    REQUIRE_FALSE(cache_file.empty());
+
+    Agentite_SceneManager *scenes2 = agentite_scene_manager_create();
+
+    SECTION("Unchanged source loads without parsing") {
+        Agentite_Scene *cached = agentite_scene_load(scenes2, path.c_str(), &ctx);
+        REQUIRE(cached != nullptr);
+        REQUIRE(agentite_scene_is_from_cache(cached));
+        REQUIRE(agentite_scene_get_root_count(cached) == 4);
+
+        Agentite_AssetRef refs[8];
+        REQUIRE(agentite_scene_get_asset_refs(cached, refs, 8) == 1);
+        REQUIRE(strcmp(refs[0].path, "player.png") == 0);
+
+        REQUIRE(agentite_scene_instantiate(cached, ecs, &ctx));
+        REQUIRE(agentite_scene_get_entity_count(cached) == 5);
+
+        ecs_entity_t player = agentite_scene_find_entity(cached, "Player");
+        REQUIRE(player != 0);
+        const TestHealth *health = (const TestHealth *)ecs_get_id(ecs, player, c_health);
+        REQUIRE(health->current == 80);
+        REQUIRE(health->max == 100);
+        const TestSprite *sprite = (const TestSprite *)ecs_get_id(ecs, player, c_sprite);
+        REQUIRE(strcmp(sprite->texture_path, "player.png") == 0);
+        const C_Position *pos = (const C_Position *)ecs_get_id(ecs, player, ecs_id(C_Position));
+        REQUIRE(pos->x == Catch::Approx(100.0f));
+        REQUIRE(pos->y == Catch::Approx(50.0f));
+
+        ecs_entity_t weapon = agentite_scene_find_entity(cached, "Weapon");
+        REQUIRE(ecs_has_pair(ecs, weapon, EcsChildOf, player));
+        pos = (const C_Position *)ecs_get_id(ecs, weapon, ecs_id(C_Position));
+        REQUIRE(pos->x == Catch::Approx(20.0f));
+
+        /* The unnamed rows keep their own values */
+        ecs_entity_t roots[8];
+        REQUIRE(agentite_scene_get_root_entities(cached, roots, 8) == 4);
+        for (int i = 1; i < 4; i++) {
+            health = (const TestHealth *)ecs_get_id(ecs, roots[i], c_health);
+            REQUIRE(health->current == 6 + i);
+            pos = (const C_Position *)ecs_get_id(ecs, roots[i], ecs_id(C_Position));
+            REQUIRE(pos->x == Catch::Approx(2.0f * i - 1.0f));
+            REQUIRE(pos->y == Catch::Approx(2.0f * i));
+        }
+
+        /* Writing falls back to the source text */
+        char *text = agentite_scene_write_string(cached);
+        REQUIRE(text != nullptr);
+        REQUIRE(strstr(text, "Weapon") != nullptr);
+        free(text);
+
+        agentite_scene_uninstantiate(cached, ecs);
+        REQUIRE(agentite_scene_get_entity_count(cached) == 0);
+    }
+
+    SECTION("Changed source is parsed again") {
+        write_text_file(path, "Player { TestHealth: 42 }");
+        Agentite_Scene *scene = agentite_scene_load(scenes2, path.c_str(), &ctx);
+        REQUIRE(scene != nullptr);
+        REQUIRE_FALSE(agentite_scene_is_from_cache(scene));
+        REQUIRE(agentite_scene_get_root_count(scene) == 1);
+
+        REQUIRE(agentite_scene_instantiate(scene, ecs, &ctx));
+        ecs_entity_t player = agentite_scene_find_entity(scene, "Player");
+        REQUIRE(((const TestHealth *)ecs_get_id(ecs, player, c_health))->current == 42);
+    }
+
+    SECTION("Changed component layout rebuilds the cache") {
+        ecs_entity_desc_t edesc = {}; edesc.name = "TestArmor";
+        ecs_component_desc_t desc = {};
+        desc.entity = ecs_entity_init(ecs, &edesc);
+        desc.type.size = sizeof(int);
+        desc.type.alignment = alignof(int);
+        ecs_entity_t c_armor = ecs_component_init(ecs, &desc);
+
+        Agentite_FieldDesc fields[] = {
+            { "value", AGENTITE_FIELD_INT, 0, sizeof(int) },
+        };
+        REQUIRE(agentite_reflect_register(reflect, c_armor, "TestArmor", sizeof(int), fields, 1));
+        Agentite_Scene *scene = agentite_scene_load(scenes2, path.c_str(), &ctx);
+        REQUIRE(scene != nullptr);
+        REQUIRE_FALSE(agentite_scene_is_from_cache(scene));
+    }
+
+    SECTION("Corrupt cache file is ignored") {
+        FILE *file = fopen(cache_file.c_str(), "r+b");
+        REQUIRE(file != nullptr);
+        fseek(file, 64, SEEK_SET);
+        unsigned char junk[16];
+        memset(junk, 0xFF, sizeof(junk));
+        fwrite(junk, 1, sizeof(junk), file);
+        fclose(file);
+
+        Agentite_Scene *scene = agentite_scene_load(scenes2, path.c_str(), &ctx);
+        REQUIRE(scene != nullptr);
+        REQUIRE_FALSE(agentite_scene_is_from_cache(scene));
+
+        /* And rewritten for the next load */
+        Agentite_SceneManager *scenes3 = agentite_scene_manager_create();
+        scene = agentite_scene_load(scenes3, path.c_str(), &ctx);
+        REQUIRE(agentite_scene_is_from_cache(scene));
+        agentite_scene_manager_destroy(scenes3);
+    }
+
+    agentite_scene_manager_destroy(scenes2);
+    remove_cache_dir();
+}
+
+/* ============================================================================
+ * Streaming Instantiation Tests
+ * ============================================================================ */
+
+static bool any_disabled(ecs_world_t *ecs, const ecs_entity_t *entities, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (ecs_has_id(ecs, entities[i], EcsDisabled)) return true;
+    }
+    return false;
+}
+
+TEST_CASE_METHOD(SceneTestFixture, "Streaming scene instantiation", "[scene][stream]") {
+    /* A named root with a child, then 300 unnamed roots */
+    std::string source = "Boss @(10, 20) {\n    TestHealth: 500\n    Minion @(5, 0) { TestHealth: 5 }\n}\n";
+    for (int i = 0; i < 300; i++) {
+        source += "Entity @(" + std::to_string(i) + ", 0) { TestHealth: " +
+                  std::to_string(i) + " }\n";
+    }
+
+    remove_cache_dir();
+    mkdir(TEST_CACHE_ROOT, 0755);
+    mkdir(TEST_CACHE_ROOT "/cache", 0755);
+    std::string path = TEST_CACHE_ROOT "/stream.scene";
+    write_text_file(path, source.c_str());
+
+    auto ctx = make_context();
+    ecs_world_t *ecs = agentite_ecs_get_world(world);
+
+    /* Current level, replaced when the stream completes */
+    Agentite_Scene *current = agentite_scene_load_string("Entity Old { TestHealth: 1 }", 0,
+                                                         "old", &ctx);
+    REQUIRE(current != nullptr);
+    REQUIRE(agentite_scene_instantiate(current, ecs, &ctx));
+    agentite_scene_manager_set_active(scenes, current);
+    ecs_entity_t old_entity = agentite_scene_find_entity(current, "Old");
+
+    Agentite_SceneStreamConfig config = AGENTITE_SCENE_STREAM_CONFIG_DEFAULT;
+    config.budget_us = 1;   /* One slice per update */
+
+    SECTION("Parsed and cached scenes stream over several updates") {
+        bool cached = GENERATE(false, true);
+        if (cached) {
+            ctx.cache_dir = TEST_CACHE_ROOT "/cache";
+            Agentite_SceneManager *warm = agentite_scene_manager_create();
+            REQUIRE(agentite_scene_load(warm, path.c_str(), &ctx) != nullptr);
+            agentite_scene_manager_destroy(warm);
+        }
+
+        REQUIRE(agentite_scene_stream_begin(scenes, path.c_str(), ecs, &ctx, &config));
+        Agentite_Scene *level = agentite_scene_lookup(scenes, path.c_str());
+        REQUIRE(agentite_scene_is_from_cache(level) == cached);
+        REQUIRE(agentite_scene_get_state(level) == AGENTITE_SCENE_STREAMING);
+        REQUIRE_FALSE(agentite_scene_instantiate(level, ecs, &ctx));
+
+        Agentite_SceneStreamProgress progress;
+        REQUIRE(agentite_scene_stream_get_progress(scenes, &progress) ==
+                AGENTITE_SCENE_STREAM_INSTANTIATING);
+        REQUIRE(progress.entities_total == 302);
+        REQUIRE(progress.entities_created == 0);
+
+        REQUIRE(agentite_scene_stream_update(scenes) == AGENTITE_SCENE_STREAM_INSTANTIATING);
+        REQUIRE(agentite_scene_stream_get_progress(scenes, &progress) ==
+                AGENTITE_SCENE_STREAM_INSTANTIATING);
+        REQUIRE(progress.entities_created > 0);
+        REQUIRE(progress.entities_created < 302);
+        REQUIRE(progress.fraction > 0.0f);
+        REQUIRE(progress.fraction < 1.0f);
+
+        /* Partial level stays disabled and the old level stays active */
+        std::vector<ecs_entity_t> partial(progress.entities_created);
+        agentite_scene_get_entities(level, partial.data(), partial.size());
+        for (ecs_entity_t entity : partial) {
+            REQUIRE(ecs_has_id(ecs, entity, EcsDisabled));
+        }
+        REQUIRE(agentite_scene_manager_get_active(scenes) == current);
+        REQUIRE(ecs_is_alive(ecs, old_entity));
+
+        int updates = 1;
+        Agentite_SceneStreamStatus status;
+        while ((status = agentite_scene_stream_update(scenes)) != AGENTITE_SCENE_STREAM_COMPLETE) {
+            REQUIRE(status == AGENTITE_SCENE_STREAM_INSTANTIATING);
+            REQUIRE(++updates < 1000);
+        }
+        REQUIRE(updates > 2);
+
+        /* Activated in one step */
+        REQUIRE(agentite_scene_manager_get_active(scenes) == level);
+        REQUIRE(agentite_scene_is_instantiated(level));
+        REQUIRE_FALSE(agentite_scene_is_instantiated(current));
+        REQUIRE_FALSE(ecs_is_alive(ecs, old_entity));
+        REQUIRE(agentite_scene_get_entity_count(level) == 302);
+
+        std::vector<ecs_entity_t> entities(302);
+        agentite_scene_get_entities(level, entities.data(), entities.size());
+        REQUIRE_FALSE(any_disabled(ecs, entities.data(), entities.size()));
+
+        ecs_entity_t boss = agentite_scene_find_entity(level, "Boss");
+        ecs_entity_t minion = agentite_scene_find_entity(level, "Minion");
+        REQUIRE(ecs_has_pair(ecs, minion, EcsChildOf, boss));
+        REQUIRE(((const TestHealth *)ecs_get_id(ecs, boss, c_health))->current == 500);
+
+        ecs_entity_t roots[301];
+        REQUIRE(agentite_scene_get_root_entities(level, roots, 301) == 301);
+        const C_Position *pos = (const C_Position *)ecs_get_id(ecs, roots[300], ecs_id(C_Position));
+        REQUIRE(pos->x == Catch::Approx(299.0f));
+        REQUIRE(((const TestHealth *)ecs_get_id(ecs, roots[300], c_health))->current == 299);
+
+        REQUIRE(agentite_scene_stream_update(scenes) == AGENTITE_SCENE_STREAM_IDLE);
+        REQUIRE(agentite_scene_stream_get_progress(scenes, nullptr) == AGENTITE_SCENE_STREAM_IDLE);
+    }
+
+    SECTION("Cancel removes the partial level") {
+        REQUIRE(agentite_scene_stream_begin(scenes, path.c_str(), ecs, &ctx, &config));
+        agentite_scene_stream_update(scenes);
+        agentite_scene_stream_update(scenes);
+
+        Agentite_Scene *level = agentite_scene_lookup(scenes, path.c_str());
+        ecs_entity_t boss = agentite_scene_find_entity(level, "Boss");
+        REQUIRE(boss != 0);
+
+        /* Only one stream at a time */
+        REQUIRE_FALSE(agentite_scene_stream_begin(scenes, path.c_str(), ecs, &ctx, &config));
+
+        agentite_scene_stream_cancel(scenes);
+        REQUIRE_FALSE(ecs_is_alive(ecs, boss));
+        REQUIRE(agentite_scene_get_state(level) == AGENTITE_SCENE_PARSED);
+        REQUIRE(agentite_scene_get_entity_count(level) == 0);
+        REQUIRE(agentite_scene_manager_get_active(scenes) == current);
+        REQUIRE(ecs_is_alive(ecs, old_entity));
+        REQUIRE(agentite_scene_stream_update(scenes) == AGENTITE_SCENE_STREAM_IDLE);
+
+        /* Streams again from scratch */
+        REQUIRE(agentite_scene_stream_begin(scenes, path.c_str(), ecs, &ctx, nullptr));
+        while (agentite_scene_stream_update(scenes) != AGENTITE_SCENE_STREAM_COMPLETE) {}
+        REQUIRE(agentite_scene_get_entity_count(level) == 302);
+    }
+
+    SECTION("Manager destroy during a stream cleans up") {
+        REQUIRE(agentite_scene_stream_begin(scenes, path.c_str(), ecs, &ctx, &config));
+        agentite_scene_stream_update(scenes);
+        ecs_entity_t boss = agentite_scene_find_entity(agentite_scene_lookup(scenes, path.c_str()),
+                                                       "Boss");
+        agentite_scene_manager_destroy(scenes);
+        scenes = nullptr;
+        REQUIRE_FALSE(ecs_is_alive(ecs, boss));
+    }
+
+    agentite_scene_destroy(current);
+    remove_cache_dir();
+}
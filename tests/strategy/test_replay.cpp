@@ -11,6 +11,8 @@
 #include "agentite/error.h"
 #include <cstring>
 #include <cstdio>
+#include <algorithm>
+#include <vector>
 
 /* ============================================================================
  * Test Command Types
@@ -390,6 +392,479 @@ TEST_CASE("Cannot save empty replay", "[replay][file]") {
     agentite_replay_destroy(replay);
 }
 
+/* ============================================================================
+ * Compact Format Tests
+ * ============================================================================ */
+
+struct BuildRecord {
+    int count;
+    int64_t cost;
+    double angle;
+    float scale;
+    bool rush;
+    uint32_t site;
+    char kind[32];
+};
+
+static BuildRecord g_last_build;
+
+static bool execute_build(const Agentite_Command *cmd, void *game_state) {
+    (void)game_state;
+    g_last_build.count++;
+    g_last_build.cost = agentite_command_get_int64(cmd, "cost");
+    g_last_build.angle = agentite_command_get_double(cmd, "angle");
+    g_last_build.scale = agentite_command_get_float(cmd, "scale");
+    g_last_build.rush = agentite_command_get_bool(cmd, "rush");
+    g_last_build.site = agentite_command_get_entity(cmd, "site");
+    const char *kind = agentite_command_get_string(cmd, "kind");
+    strncpy(g_last_build.kind, kind ? kind : "", sizeof(g_last_build.kind) - 1);
+    return true;
+}
+
+static long file_size(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return -1;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+/* Record 1000 frames: a move every 10 frames, snapshots every 100 */
+static void record_long_replay(Agentite_ReplaySystem *replay, Agentite_CommandSystem *cmd_sys,
+                               TestGameState *game_state) {
+    Agentite_ReplayMetadata meta = {};
+    strncpy(meta.map_name, "Compact", sizeof(meta.map_name) - 1);
+    REQUIRE(agentite_replay_start_recording(replay, cmd_sys, game_state, &meta));
+
+    for (int i = 0; i < 1000; i++) {
+        if (i % 10 == 0) {
+            Agentite_Command *cmd = agentite_command_new(CMD_MOVE);
+            agentite_command_set_int(cmd, "x", i);
+            agentite_command_set_int(cmd, "y", i / 10);
+            agentite_command_execute(cmd_sys, cmd, game_state);
+            agentite_command_free(cmd);
+        }
+        agentite_replay_record_frame(replay, 1.0f / 60.0f);
+
+        if ((i + 1) % 100 == 0) {
+            REQUIRE(agentite_replay_create_snapshot(replay, game_state));
+        }
+    }
+
+    agentite_replay_stop_recording(replay);
+}
+
+TEST_CASE("Compact replay format round trip", "[replay][file][v2]") {
+    const char *test_file = "/tmp/test_replay_v2.replay";
+
+    Agentite_ReplayConfig config = AGENTITE_REPLAY_CONFIG_DEFAULT;
+    config.serialize = test_serialize;
+    config.deserialize = test_deserialize;
+    config.reset = test_reset;
+
+    Agentite_CommandSystem *cmd_sys = agentite_command_create();
+    agentite_command_register(cmd_sys, CMD_MOVE, validate_move, execute_move);
+    agentite_command_register(cmd_sys, CMD_BUILD, nullptr, execute_build);
+
+    SECTION("Mostly empty frames stay small") {
+        Agentite_ReplaySystem *replay = agentite_replay_create(&config);
+        TestGameState game_state = {0, 0, 100, 0};
+        record_long_replay(replay, cmd_sys, &game_state);
+        REQUIRE(agentite_replay_save(replay, test_file));
+        agentite_replay_destroy(replay);
+
+        /* Version 1 needed 16 bytes per frame before any commands */
+        long size = file_size(test_file);
+        REQUIRE(size > 0);
+        REQUIRE(size < 4000);
+
+        Agentite_ReplayMetadata info;
+        REQUIRE(agentite_replay_get_file_info(test_file, &info));
+        REQUIRE(info.version == AGENTITE_REPLAY_VERSION);
+        REQUIRE(info.total_frames == 1000);
+
+        replay = agentite_replay_create(&config);
+        REQUIRE(agentite_replay_load(replay, test_file));
+        REQUIRE(agentite_replay_get_total_frames(replay) == 1000);
+        REQUIRE(agentite_replay_get_snapshot_count(replay) == 10);
+
+        game_state = {0, 0, 100, 0};
+        REQUIRE(agentite_replay_start_playback(replay, cmd_sys, &game_state));
+        int total_commands = 0;
+        while (agentite_replay_is_playing(replay)) {
+            int cmds = agentite_replay_playback_frame(replay, &game_state, 1.0f / 60.0f);
+            if (cmds > 0) total_commands += cmds;
+        }
+        REQUIRE(total_commands == 100);
+        REQUIRE(game_state.move_count == 100);
+        REQUIRE(game_state.player_x == 990);
+        REQUIRE(game_state.player_y == 99);
+        agentite_replay_destroy(replay);
+    }
+
+    SECTION("Every parameter type survives") {
+        for (int compress = 0; compress < 2; compress++) {
+            config.compress = compress != 0;
+            Agentite_ReplaySystem *replay = agentite_replay_create(&config);
+            TestGameState game_state = {0, 0, 100, 0};
+
+            Agentite_ReplayMetadata meta = {};
+            REQUIRE(agentite_replay_start_recording(replay, cmd_sys, &game_state, &meta));
+            agentite_replay_record_frame(replay, 0.016f);
+
+            Agentite_Command *cmd = agentite_command_new(CMD_BUILD);
+            agentite_command_set_int64(cmd, "cost", -5000000000LL);
+            agentite_command_set_double(cmd, "angle", 1.25);
+            agentite_command_set_float(cmd, "scale", -0.5f);
+            agentite_command_set_bool(cmd, "rush", true);
+            agentite_command_set_entity(cmd, "site", 0xDEADBEEF);
+            agentite_command_set_string(cmd, "kind", "barracks");
+            agentite_command_execute(cmd_sys, cmd, &game_state);
+            agentite_command_free(cmd);
+            agentite_replay_record_frame(replay, 0.033f);
+            agentite_replay_record_frame(replay, 0.033f);
+
+            agentite_replay_stop_recording(replay);
+            REQUIRE(agentite_replay_save(replay, test_file));
+            agentite_replay_destroy(replay);
+
+            replay = agentite_replay_create(&config);
+            REQUIRE(agentite_replay_load(replay, test_file));
+            REQUIRE(agentite_replay_get_total_frames(replay) == 3);
+
+            g_last_build = {};
+            REQUIRE(agentite_replay_start_playback(replay, cmd_sys, &game_state));
+            while (agentite_replay_is_playing(replay)) {
+                agentite_replay_playback_frame(replay, &game_state, 0.05f);
+            }
+            REQUIRE(g_last_build.count == 1);
+            REQUIRE(g_last_build.cost == -5000000000LL);
+            REQUIRE(g_last_build.angle == 1.25);
+            REQUIRE(g_last_build.scale == -0.5f);
+            REQUIRE(g_last_build.rush);
+            REQUIRE(g_last_build.site == 0xDEADBEEF);
+            REQUIRE(strcmp(g_last_build.kind, "barracks") == 0);
+            REQUIRE(agentite_replay_get_current_time(replay) == Catch::Approx(0.082f));
+            agentite_replay_destroy(replay);
+        }
+    }
+
+    SECTION("Truncated file fails to load") {
+        Agentite_ReplaySystem *replay = agentite_replay_create(&config);
+        TestGameState game_state = {0, 0, 100, 0};
+        record_long_replay(replay, cmd_sys, &game_state);
+        REQUIRE(agentite_replay_save(replay, test_file));
+        agentite_replay_destroy(replay);
+
+        long size = file_size(test_file);
+        std::vector<char> bytes((size_t)size);
+        FILE *fp = fopen(test_file, "rb");
+        REQUIRE(fread(bytes.data(), 1, bytes.size(), fp) == bytes.size());
+        fclose(fp);
+        fp = fopen(test_file, "wb");
+        fwrite(bytes.data(), 1, bytes.size() - 10, fp);
+        fclose(fp);
+
+        replay = agentite_replay_create(&config);
+        REQUIRE_FALSE(agentite_replay_load(replay, test_file));
+        REQUIRE_FALSE(agentite_replay_has_data(replay));
+        agentite_replay_destroy(replay);
+    }
+
+    agentite_command_destroy(cmd_sys);
+    remove(test_file);
+}
+
+static int g_deserialize_count;
+static int g_restored_x;
+
+static bool counting_deserialize(void *game_state, const void *data, size_t size) {
+    g_deserialize_count++;
+    if (!test_deserialize(game_state, data, size)) return false;
+    g_restored_x = static_cast<TestGameState *>(game_state)->player_x;
+    return true;
+}
+
+TEST_CASE("Seek restores nearest snapshot from file", "[replay][seek][v2]") {
+    const char *test_file = "/tmp/test_replay_seek.replay";
+
+    Agentite_ReplayConfig config = AGENTITE_REPLAY_CONFIG_DEFAULT;
+    config.serialize = test_serialize;
+    config.deserialize = counting_deserialize;
+    config.reset = test_reset;
+
+    Agentite_CommandSystem *cmd_sys = agentite_command_create();
+    agentite_command_register(cmd_sys, CMD_MOVE, validate_move, execute_move);
+
+    {
+        Agentite_ReplaySystem *replay = agentite_replay_create(&config);
+        TestGameState game_state = {0, 0, 100, 0};
+        record_long_replay(replay, cmd_sys, &game_state);
+        REQUIRE(agentite_replay_save(replay, test_file));
+        agentite_replay_destroy(replay);
+    }
+
+    Agentite_ReplaySystem *replay = agentite_replay_create(&config);
+    REQUIRE(agentite_replay_load(replay, test_file));
+
+    TestGameState game_state = {0, 0, 100, 0};
+    REQUIRE(agentite_replay_start_playback(replay, cmd_sys, &game_state));
+
+    /* Snapshot at frame 700 holds the move from frame 690 */
+    g_deserialize_count = 0;
+    REQUIRE(agentite_replay_seek(replay, &game_state, 705));
+    REQUIRE(g_deserialize_count == 1);
+    REQUIRE(g_restored_x == 690);
+    REQUIRE(game_state.player_x == 700);
+    REQUIRE(game_state.move_count == 71);
+    REQUIRE(agentite_replay_get_current_frame(replay) == 705);
+    REQUIRE(agentite_replay_get_current_time(replay) == Catch::Approx(705.0f / 60.0f));
+
+    /* Seeking backward restores the earlier snapshot */
+    REQUIRE(agentite_replay_seek(replay, &game_state, 250));
+    REQUIRE(g_deserialize_count == 2);
+    REQUIRE(g_restored_x == 190);
+    REQUIRE(game_state.move_count == 25);
+
+    /* Short forward seeks continue without a restore */
+    REQUIRE(agentite_replay_seek(replay, &game_state, 290));
+    REQUIRE(g_deserialize_count == 2);
+    REQUIRE(game_state.player_x == 280);
+
+    agentite_replay_stop_playback(replay);
+    agentite_replay_destroy(replay);
+    agentite_command_destroy(cmd_sys);
+    remove(test_file);
+}
+
+TEST_CASE("Load version 1 replay file", "[replay][file][v1]") {
+    const char *test_file = "/tmp/test_replay_v1.replay";
+
+    /* Hand-write a v1 file: header, initial state, frames, snapshots */
+    FILE *fp = fopen(test_file, "wb");
+    REQUIRE(fp != nullptr);
+    auto put = [fp](const void *data, size_t size) { fwrite(data, 1, size, fp); };
+    uint32_t magic = AGENTITE_REPLAY_MAGIC;
+    int32_t version = 1;
+    char timestamp[AGENTITE_REPLAY_MAX_TIMESTAMP] = "2024-01-01T00:00:00";
+    char game_version[AGENTITE_REPLAY_MAX_VERSION_STRING] = "1.0";
+    char map_name[AGENTITE_REPLAY_MAX_MAP_NAME] = "Legacy";
+    uint64_t total_frames = 2;
+    float duration = 0.032f;
+    uint32_t seed = 77;
+    int32_t players = 2;
+    put(&magic, 4); put(&version, 4); put(&version, 4);
+    put(timestamp, sizeof(timestamp));
+    put(game_version, sizeof(game_version));
+    put(map_name, sizeof(map_name));
+    put(&total_frames, 8); put(&duration, 4); put(&seed, 4); put(&players, 4);
+
+    uint64_t initial_size = 0;
+    put(&initial_size, 8);
+
+    put(&total_frames, 8);
+    for (uint64_t f = 0; f < 2; f++) {
+        float dt = 0.016f;
+        uint32_t cmd_count = (f == 1) ? 1 : 0;
+        put(&f, 8); put(&dt, 4); put(&cmd_count, 4);
+        if (cmd_count) {
+            uint16_t type = CMD_MOVE;
+            uint8_t param_count = 2;
+            uint32_t sequence = 9;
+            int32_t faction = -1;
+            put(&type, 2); put(&param_count, 1); put(&sequence, 4); put(&faction, 4);
+            const char *keys[2] = {"x", "y"};
+            int32_t values[2] = {42, 24};
+            for (int p = 0; p < 2; p++) {
+                uint8_t key_len = 1;
+                uint8_t ptype = AGENTITE_CMD_PARAM_INT;
+                put(&key_len, 1); put(keys[p], 1); put(&ptype, 1); put(&values[p], 4);
+            }
+        }
+    }
+    uint32_t snapshot_count = 0;
+    put(&snapshot_count, 4);
+    fclose(fp);
+
+    Agentite_ReplaySystem *replay = agentite_replay_create(nullptr);
+    Agentite_CommandSystem *cmd_sys = agentite_command_create();
+    agentite_command_register(cmd_sys, CMD_MOVE, validate_move, execute_move);
+
+    REQUIRE(agentite_replay_load(replay, test_file));
+    REQUIRE(agentite_replay_get_total_frames(replay) == 2);
+    REQUIRE(strcmp(agentite_replay_get_metadata(replay)->map_name, "Legacy") == 0);
+    REQUIRE(agentite_replay_get_metadata(replay)->random_seed == 77);
+
+    TestGameState game_state = {0, 0, 100, 0};
+    REQUIRE(agentite_replay_start_playback(replay, cmd_sys, &game_state));
+    while (agentite_replay_is_playing(replay)) {
+        agentite_replay_playback_frame(replay, &game_state, 0.016f);
+    }
+    REQUIRE(game_state.player_x == 42);
+    REQUIRE(game_state.player_y == 24);
+
+    /* Re-saving upgrades to the current version */
+    const char *upgraded = "/tmp/test_replay_v1_upgraded.replay";
+    REQUIRE(agentite_replay_save(replay, upgraded));
+    Agentite_ReplayMetadata info;
+    REQUIRE(agentite_replay_get_file_info(upgraded, &info));
+    REQUIRE(info.version == AGENTITE_REPLAY_VERSION);
+    REQUIRE(strcmp(info.map_name, "Legacy") == 0);
+
+    agentite_command_destroy(cmd_sys);
+    agentite_replay_destroy(replay);
+    remove(test_file);
+    remove(upgraded);
+}
+
+/* ============================================================================
+ * Streaming Tests
+ * ============================================================================ */
+
+static const size_t k_stream_test_memory_cap = 512 * 1024;
+
+/* Stream frame_count frames to path: a move every frame, snapshots as given */
+static void record_streamed_replay(Agentite_ReplaySystem *replay, Agentite_CommandSystem *cmd_sys,
+                                   TestGameState *game_state, const char *path,
+                                   int frame_count, int snapshot_every, size_t *max_resident) {
+    Agentite_ReplayMetadata meta = {};
+    strncpy(meta.map_name, "Streamed", sizeof(meta.map_name) - 1);
+    REQUIRE(agentite_replay_start_recording_stream(replay, cmd_sys, game_state, &meta, path));
+    REQUIRE(agentite_replay_is_streaming(replay));
+
+    for (int i = 0; i < frame_count; i++) {
+        Agentite_Command *cmd = agentite_command_new(CMD_MOVE);
+        agentite_command_set_int(cmd, "x", i);
+        agentite_command_set_int(cmd, "y", i % 100);
+        agentite_command_execute(cmd_sys, cmd, game_state);
+        agentite_command_free(cmd);
+        agentite_replay_record_frame(replay, 1.0f / 60.0f);
+
+        if ((i + 1) % snapshot_every == 0) {
+            REQUIRE(agentite_replay_create_snapshot(replay, game_state));
+        }
+        if (max_resident) {
+            *max_resident = std::max(*max_resident, agentite_replay_get_resident_memory(replay));
+        }
+    }
+
+    agentite_replay_stop_recording(replay);
+}
+
+TEST_CASE("Streamed recording and playback stay within memory cap", "[replay][stream]") {
+    const char *test_file = "/tmp/test_replay_stream.replay";
+    const int frame_count = 50000;
+
+    Agentite_ReplayConfig config = AGENTITE_REPLAY_CONFIG_DEFAULT;
+    config.serialize = test_serialize;
+    config.deserialize = test_deserialize;
+    config.reset = test_reset;
+    config.stream_memory_limit = 64 * 1024;
+
+    Agentite_CommandSystem *cmd_sys = agentite_command_create();
+    agentite_command_register(cmd_sys, CMD_MOVE, validate_move, execute_move);
+    Agentite_ReplaySystem *replay = agentite_replay_create(&config);
+
+    TestGameState game_state = {0, 0, 100, 0};
+    size_t max_resident = 0;
+    record_streamed_replay(replay, cmd_sys, &game_state, test_file, frame_count, 5000,
+                           &max_resident);
+    REQUIRE(max_resident < k_stream_test_memory_cap);
+
+    /* Stopping reopens the finished file for streamed playback */
+    REQUIRE(agentite_replay_is_streaming(replay));
+    REQUIRE(agentite_replay_get_total_frames(replay) == (uint64_t)frame_count);
+    REQUIRE(agentite_replay_get_snapshot_count(replay) == frame_count / 5000);
+    REQUIRE(agentite_replay_get_total_duration(replay) ==
+            Catch::Approx(frame_count / 60.0f).epsilon(0.001));
+
+    Agentite_ReplayMetadata info;
+    REQUIRE(agentite_replay_get_file_info(test_file, &info));
+    REQUIRE(info.total_frames == (uint64_t)frame_count);
+    REQUIRE(strcmp(info.map_name, "Streamed") == 0);
+
+    /* Playback reads blocks ahead without loading the whole replay */
+    game_state = {0, 0, 100, 0};
+    REQUIRE(agentite_replay_start_playback(replay, cmd_sys, &game_state));
+    max_resident = 0;
+    bool frames_ok = true;
+    while (agentite_replay_is_playing(replay)) {
+        frames_ok = agentite_replay_playback_frame(replay, &game_state, 1.0f / 60.0f) >= 0 &&
+                    frames_ok;
+        max_resident = std::max(max_resident, agentite_replay_get_resident_memory(replay));
+    }
+    REQUIRE(frames_ok);
+    REQUIRE(max_resident < k_stream_test_memory_cap);
+    REQUIRE(game_state.move_count == frame_count);
+    REQUIRE(game_state.player_x == frame_count - 1);
+
+    agentite_replay_destroy(replay);
+    agentite_command_destroy(cmd_sys);
+    remove(test_file);
+}
+
+TEST_CASE("Streamed playback matches a fully loaded replay", "[replay][stream][seek]") {
+    const char *test_file = "/tmp/test_replay_stream_seek.replay";
+    const char *copy_file = "/tmp/test_replay_stream_copy.replay";
+
+    Agentite_ReplayConfig config = AGENTITE_REPLAY_CONFIG_DEFAULT;
+    config.serialize = test_serialize;
+    config.deserialize = test_deserialize;
+    config.reset = test_reset;
+    config.stream_memory_limit = 64 * 1024;
+
+    Agentite_CommandSystem *cmd_sys = agentite_command_create();
+    agentite_command_register(cmd_sys, CMD_MOVE, validate_move, execute_move);
+
+    {
+        Agentite_ReplaySystem *replay = agentite_replay_create(&config);
+        TestGameState game_state = {0, 0, 100, 0};
+        record_streamed_replay(replay, cmd_sys, &game_state, test_file, 20000, 1000, nullptr);
+
+        /* Saving a streamed replay copies its file */
+        REQUIRE_FALSE(agentite_replay_save(replay, test_file));
+        REQUIRE(agentite_replay_save(replay, copy_file));
+        REQUIRE(file_size(copy_file) == file_size(test_file));
+        agentite_replay_destroy(replay);
+    }
+
+    Agentite_ReplaySystem *streamed = agentite_replay_create(&config);
+    Agentite_ReplaySystem *loaded = agentite_replay_create(&config);
+    REQUIRE(agentite_replay_open_stream(streamed, test_file));
+    REQUIRE(agentite_replay_load(loaded, copy_file));
+    REQUIRE_FALSE(agentite_replay_is_streaming(loaded));
+    REQUIRE(agentite_replay_get_total_frames(streamed) ==
+            agentite_replay_get_total_frames(loaded));
+
+    TestGameState a = {0, 0, 100, 0};
+    TestGameState b = {0, 0, 100, 0};
+    REQUIRE(agentite_replay_start_playback(streamed, cmd_sys, &a));
+    REQUIRE(agentite_replay_start_playback(loaded, cmd_sys, &b));
+
+    const uint64_t targets[] = { 12345, 3001, 3050, 19999, 0, 8191, 8192 };
+    for (uint64_t target : targets) {
+        REQUIRE(agentite_replay_seek(streamed, &a, target));
+        REQUIRE(agentite_replay_seek(loaded, &b, target));
+        REQUIRE(a.player_x == b.player_x);
+        REQUIRE(a.move_count == b.move_count);
+        REQUIRE(agentite_replay_get_current_time(streamed) ==
+                agentite_replay_get_current_time(loaded));
+    }
+
+    /* The last seek left frame 8192 as the next frame to play */
+    REQUIRE(agentite_replay_step_forward(streamed, &a) == -1);
+    agentite_replay_pause(streamed);
+    REQUIRE(agentite_replay_step_forward(streamed, &a) == 1);
+    REQUIRE(a.player_x == 8192);
+
+    agentite_replay_destroy(streamed);
+    agentite_replay_destroy(loaded);
+    agentite_command_destroy(cmd_sys);
+    remove(test_file);
+    remove(copy_file);
+}
+
 /* ============================================================================
  * Playback Tests
  * ============================================================================ */
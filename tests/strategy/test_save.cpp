@@ -7,6 +7,8 @@
 
 #include "catch_amalgamated.hpp"
 #include "agentite/save.h"
+#include "agentite/event.h"
+#include <SDL3/SDL.h>
 #include <cstring>
 #include <cstdio>
 #include <sys/stat.h>
@@ -602,3 +604,414 @@ TEST_CASE("Save edge cases", "[save][edge]") {
 
     agentite_save_destroy(sm);
 }
+
+/* ============================================================================
+ * Binary Format Tests
+ * ============================================================================ */
+
+// Large state spread over several sections
+struct BinaryTestState {
+    int turn;
+    long long seed;
+    int unit_ids[5000];
+    float unit_hp[5000];
+    char faction[32];
+    int loaded_sections;
+};
+
+static bool binary_serialize(void *game_state, Agentite_SaveWriter *writer) {
+    BinaryTestState *gs = (BinaryTestState *)game_state;
+
+    agentite_save_write_int(writer, "turn", gs->turn);
+    agentite_save_write_int64(writer, "seed", gs->seed);
+
+    agentite_save_write_section(writer, "units");
+    agentite_save_write_int_array(writer, "ids", gs->unit_ids, 5000);
+    agentite_save_write_float_array(writer, "hp", gs->unit_hp, 5000);
+
+    agentite_save_write_section(writer, "factions.player");
+    agentite_save_write_string(writer, "name", gs->faction);
+
+    return true;
+}
+
+static bool binary_deserialize(void *game_state, Agentite_SaveReader *reader) {
+    BinaryTestState *gs = (BinaryTestState *)game_state;
+
+    if (!agentite_save_read_int(reader, "turn", &gs->turn)) return false;
+    if (!agentite_save_read_int64(reader, "seed", &gs->seed)) return false;
+
+    if (agentite_save_read_enter_section(reader, "units")) {
+        int *ids = nullptr;
+        float *hp = nullptr;
+        int id_count = 0, hp_count = 0;
+        if (!agentite_save_read_int_array(reader, "ids", &ids, &id_count)) return false;
+        if (!agentite_save_read_float_array(reader, "hp", &hp, &hp_count)) return false;
+        for (int i = 0; i < id_count && i < 5000; i++) gs->unit_ids[i] = ids[i];
+        for (int i = 0; i < hp_count && i < 5000; i++) gs->unit_hp[i] = hp[i];
+        free(ids);
+        free(hp);
+        gs->loaded_sections++;
+    }
+
+    if (agentite_save_read_enter_section(reader, "factions.player")) {
+        agentite_save_read_string(reader, "name", gs->faction, sizeof(gs->faction));
+        gs->loaded_sections++;
+    }
+
+    return true;
+}
+
+static void fill_binary_state(BinaryTestState *gs) {
+    memset(gs, 0, sizeof(*gs));
+    gs->turn = 314;
+    gs->seed = 123456789012345LL;
+    for (int i = 0; i < 5000; i++) {
+        gs->unit_ids[i] = 1000 + i;
+        gs->unit_hp[i] = (float)(i % 100) * 0.5f;
+    }
+    strcpy(gs->faction, "Terran \"Union\"");
+}
+
+static long file_size(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+TEST_CASE("Binary save round trip", "[save][binary]") {
+    cleanup_test_saves();
+    Agentite_SaveManager *sm = agentite_save_create(TEST_SAVES_DIR);
+    agentite_save_set_format(sm, AGENTITE_SAVE_FORMAT_BINARY);
+    REQUIRE(agentite_save_get_format(sm) == AGENTITE_SAVE_FORMAT_BINARY);
+
+    static BinaryTestState gs, load;
+    fill_binary_state(&gs);
+
+    SECTION("Basic state uses the .sav extension") {
+        TestGameState basic = {0};
+        basic.turn = 42;
+        basic.gold = 1000;
+        basic.health = 75.5f;
+        basic.precision = 3.14159265358979;
+        basic.active = true;
+        strcpy(basic.player_name, "Line1\nLine2 \"quoted\"");
+        for (int i = 0; i < 5; i++) basic.scores[i] = i * 100;
+        for (int i = 0; i < 3; i++) basic.values[i] = i * 1.5f;
+
+        Agentite_SaveResult result = agentite_save_game(sm, "bin_basic", test_serialize, &basic);
+        REQUIRE(result.success);
+        REQUIRE(strstr(result.filepath, ".sav") != nullptr);
+
+        TestGameState loaded = {0};
+        result = agentite_load_game(sm, "bin_basic", test_deserialize, &loaded);
+        REQUIRE(result.success);
+        REQUIRE(loaded.turn == 42);
+        REQUIRE(loaded.gold == 1000);
+        REQUIRE(loaded.health == 75.5f);
+        REQUIRE(loaded.precision == 3.14159265358979);  // Exact, unlike %f in TOML
+        REQUIRE(loaded.active);
+        REQUIRE(strcmp(loaded.player_name, "Line1\nLine2 \"quoted\"") == 0);
+        REQUIRE(loaded.scores[4] == 400);
+        REQUIRE(loaded.values[2] == 3.0f);
+
+        agentite_save_delete(sm, "bin_basic");
+        REQUIRE_FALSE(agentite_save_exists(sm, "bin_basic"));
+    }
+
+    SECTION("Multiple sections, compressed and uncompressed") {
+        agentite_save_set_compression(sm, true);
+        REQUIRE(agentite_save_game(sm, "bin_packed", binary_serialize, &gs).success);
+        agentite_save_set_compression(sm, false);
+        REQUIRE(agentite_save_game(sm, "bin_raw", binary_serialize, &gs).success);
+
+        REQUIRE(file_size("test_saves/bin_packed.sav") < file_size("test_saves/bin_raw.sav"));
+
+        for (const char *name : {"bin_packed", "bin_raw"}) {
+            memset(&load, 0, sizeof(load));
+            REQUIRE(agentite_load_game(sm, name, binary_deserialize, &load).success);
+            REQUIRE(load.turn == 314);
+            REQUIRE(load.seed == 123456789012345LL);
+            REQUIRE(load.unit_ids[4999] == 5999);
+            REQUIRE(load.unit_hp[99] == 49.5f);
+            REQUIRE(strcmp(load.faction, "Terran \"Union\"") == 0);
+            REQUIRE(load.loaded_sections == 2);
+        }
+
+        agentite_save_delete(sm, "bin_packed");
+        agentite_save_delete(sm, "bin_raw");
+    }
+
+    SECTION("Missing keys and sections fail cleanly") {
+        TestGameState basic = {0};
+        REQUIRE(agentite_save_game(sm, "bin_missing", test_serialize, &basic).success);
+
+        auto probe = [](void *, Agentite_SaveReader *reader) -> bool {
+            int v;
+            bool b;
+            if (agentite_save_read_int(reader, "no_such_key", &v)) return false;
+            if (agentite_save_read_bool(reader, "turn", &b)) return false;  // Wrong type
+            if (agentite_save_read_enter_section(reader, "nope")) return false;
+            if (agentite_save_read_section(reader, "game_state") != nullptr) return false;
+            return agentite_save_read_int(reader, "turn", &v);  // Still in game_state
+        };
+        REQUIRE(agentite_load_game(sm, "bin_missing", probe, nullptr).success);
+
+        agentite_save_delete(sm, "bin_missing");
+    }
+
+    SECTION("Save list reads binary metadata") {
+        REQUIRE(agentite_save_game(sm, "list_test_1", binary_serialize, &gs).success);
+
+        int count = 0;
+        Agentite_SaveInfo *list = agentite_save_list(sm, &count);
+        REQUIRE(list != nullptr);
+
+        bool found = false;
+        for (int i = 0; i < count; i++) {
+            if (strcmp(list[i].filename, "list_test_1.sav") == 0) {
+                found = true;
+                REQUIRE(strcmp(list[i].display_name, "list_test_1") == 0);
+                REQUIRE(list[i].preview_turn == 314);
+                REQUIRE(list[i].is_compatible);
+                REQUIRE(list[i].timestamp[0] != '\0');
+            }
+        }
+        REQUIRE(found);
+
+        agentite_save_list_free(list);
+        agentite_save_delete(sm, "list_test_1");
+    }
+
+    SECTION("Load falls back to the other format") {
+        agentite_save_set_format(sm, AGENTITE_SAVE_FORMAT_TOML);
+        TestGameState basic = {0};
+        basic.turn = 314;
+        REQUIRE(agentite_save_game(sm, "bin_fallback", test_serialize, &basic).success);
+        agentite_save_set_format(sm, AGENTITE_SAVE_FORMAT_BINARY);
+
+        TestGameState loaded = {0};
+        Agentite_SaveResult result = agentite_load_game(sm, "bin_fallback", test_deserialize, &loaded);
+        REQUIRE(result.success);
+        REQUIRE(strstr(result.filepath, ".toml") != nullptr);
+        REQUIRE(loaded.turn == 314);
+
+        agentite_save_delete(sm, "bin_fallback");
+    }
+
+    SECTION("Corrupt file is rejected") {
+        REQUIRE(agentite_save_game(sm, "bin_corrupt", binary_serialize, &gs).success);
+
+        FILE *f = fopen("test_saves/bin_corrupt.sav", "r+b");
+        REQUIRE(f != nullptr);
+        fseek(f, 64, SEEK_SET);
+        unsigned char junk[256];
+        memset(junk, 0xEE, sizeof(junk));
+        fwrite(junk, 1, sizeof(junk), f);
+        fclose(f);
+
+        memset(&load, 0, sizeof(load));
+        agentite_load_game(sm, "bin_corrupt", binary_deserialize, &load);
+        REQUIRE(load.loaded_sections < 2);
+
+        agentite_save_delete(sm, "bin_corrupt");
+    }
+
+    SECTION("Version check uses the header") {
+        agentite_save_set_version(sm, 1, 1);
+        TestGameState basic = {0};
+        REQUIRE(agentite_save_game(sm, "bin_version", test_serialize, &basic).success);
+        agentite_save_set_version(sm, 3, 2);
+
+        TestGameState loaded = {0};
+        Agentite_SaveResult result = agentite_load_game(sm, "bin_version", test_deserialize, &loaded);
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.save_version == 1);
+
+        agentite_save_delete(sm, "bin_version");
+    }
+
+    agentite_save_destroy(sm);
+}
+
+TEST_CASE("Save format conversion", "[save][binary][convert]") {
+    cleanup_test_saves();
+    Agentite_SaveManager *sm = agentite_save_create(TEST_SAVES_DIR);
+    agentite_save_set_version(sm, 7, 1);
+
+    static BinaryTestState gs, load;
+    fill_binary_state(&gs);
+
+    SECTION("TOML to binary and back") {
+        REQUIRE(agentite_save_game(sm, "conv", binary_serialize, &gs).success);
+
+        Agentite_SaveResult result = agentite_save_convert(
+            "test_saves/conv.toml", "test_saves/conv_bin.sav", AGENTITE_SAVE_FORMAT_BINARY, true);
+        REQUIRE(result.success);
+        REQUIRE(result.save_version == 7);
+
+        agentite_save_set_format(sm, AGENTITE_SAVE_FORMAT_BINARY);
+        memset(&load, 0, sizeof(load));
+        result = agentite_load_game(sm, "conv_bin", binary_deserialize, &load);
+        REQUIRE(result.success);
+        REQUIRE(result.save_version == 7);
+        REQUIRE(load.turn == 314);
+        REQUIRE(load.seed == 123456789012345LL);
+        REQUIRE(load.unit_ids[1234] == 2234);
+        REQUIRE(load.unit_hp[99] == 49.5f);
+        REQUIRE(strcmp(load.faction, "Terran \"Union\"") == 0);
+        REQUIRE(load.loaded_sections == 2);
+
+        result = agentite_save_convert(
+            "test_saves/conv_bin.sav", "test_saves/conv_back.toml", AGENTITE_SAVE_FORMAT_TOML, false);
+        REQUIRE(result.success);
+
+        agentite_save_set_format(sm, AGENTITE_SAVE_FORMAT_TOML);
+        memset(&load, 0, sizeof(load));
+        REQUIRE(agentite_load_game(sm, "conv_back", binary_deserialize, &load).success);
+        REQUIRE(load.unit_ids[4999] == 5999);
+        REQUIRE(strcmp(load.faction, "Terran \"Union\"") == 0);
+        REQUIRE(load.loaded_sections == 2);
+
+        agentite_save_delete(sm, "conv");
+        agentite_save_delete(sm, "conv_bin");
+        agentite_save_delete(sm, "conv_back");
+    }
+
+    SECTION("Invalid conversions fail") {
+        REQUIRE_FALSE(agentite_save_convert(nullptr, "x.sav", AGENTITE_SAVE_FORMAT_BINARY, true).success);
+        REQUIRE_FALSE(agentite_save_convert("test_saves/missing.toml", "test_saves/missing.sav",
+                                            AGENTITE_SAVE_FORMAT_BINARY, true).success);
+    }
+
+    agentite_save_destroy(sm);
+}
+
+/* ============================================================================
+ * Async Save Tests
+ * ============================================================================ */
+
+static void *snapshot_copy(void *game_state) {
+    TestGameState *copy = (TestGameState *)malloc(sizeof(TestGameState));
+    if (copy) memcpy(copy, game_state, sizeof(TestGameState));
+    return copy;
+}
+
+static bool slow_serialize(void *snapshot, Agentite_SaveWriter *writer) {
+    SDL_Delay(150);  // Stand-in for a large late-game serialize
+    return test_serialize(snapshot, writer);
+}
+
+struct SaveEventLog {
+    int saved;
+    int failed;
+    char last_name[64];
+    bool last_error_set;
+};
+
+static void on_save_event(const Agentite_Event *event, void *userdata) {
+    SaveEventLog *log = (SaveEventLog *)userdata;
+    if (event->type == AGENTITE_EVENT_GAME_SAVED) log->saved++;
+    if (event->type == AGENTITE_EVENT_GAME_SAVE_FAILED) log->failed++;
+    strncpy(log->last_name, event->save.save_name, sizeof(log->last_name) - 1);
+    log->last_error_set = event->save.error != nullptr;
+}
+
+TEST_CASE("Async save", "[save][async]") {
+    cleanup_test_saves();
+    Agentite_SaveManager *sm = agentite_save_create(TEST_SAVES_DIR);
+    Agentite_EventDispatcher *events = agentite_event_dispatcher_create();
+    agentite_save_set_event_dispatcher(sm, events);
+
+    SaveEventLog log = {};
+    agentite_event_subscribe(events, AGENTITE_EVENT_GAME_SAVED, on_save_event, &log);
+    agentite_event_subscribe(events, AGENTITE_EVENT_GAME_SAVE_FAILED, on_save_event, &log);
+
+    TestGameState gs = {0};
+    gs.turn = 77;
+    gs.gold = 500;
+    strcpy(gs.player_name, "Async");
+
+    SECTION("Serialization runs off the calling thread") {
+        uint64_t start = SDL_GetTicks();
+        REQUIRE(agentite_save_auto_async(sm, snapshot_copy, slow_serialize, free, &gs));
+        REQUIRE(SDL_GetTicks() - start < 100);
+        REQUIRE(agentite_save_is_busy(sm));
+
+        // Game keeps mutating its live state; the snapshot is unaffected
+        gs.turn = 78;
+
+        agentite_save_wait(sm);
+        REQUIRE_FALSE(agentite_save_is_busy(sm));
+        REQUIRE(log.saved == 0);  // Events only fire from update()
+        REQUIRE(agentite_save_update(sm) == 1);
+        REQUIRE(log.saved == 1);
+        REQUIRE(strcmp(log.last_name, "autosave") == 0);
+        REQUIRE_FALSE(log.last_error_set);
+
+        TestGameState load = {0};
+        REQUIRE(agentite_load_game(sm, "autosave", test_deserialize, &load).success);
+        REQUIRE(load.turn == 77);
+        REQUIRE(strcmp(load.player_name, "Async") == 0);
+    }
+
+    SECTION("Queued saves complete in order, binary included") {
+        agentite_save_set_format(sm, AGENTITE_SAVE_FORMAT_BINARY);
+        for (int i = 0; i < 3; i++) {
+            gs.turn = 100 + i;
+            REQUIRE(agentite_save_game_async(sm, "async_queue", snapshot_copy,
+                                             test_serialize, free, &gs));
+        }
+        agentite_save_wait(sm);
+        REQUIRE(agentite_save_update(sm) == 3);
+        REQUIRE(log.saved == 3);
+
+        TestGameState load = {0};
+        REQUIRE(agentite_load_game(sm, "async_queue", test_deserialize, &load).success);
+        REQUIRE(load.turn == 102);
+
+        agentite_save_delete(sm, "async_queue");
+    }
+
+    SECTION("Failed save reports an event and keeps the previous file") {
+        gs.turn = 5;
+        REQUIRE(agentite_save_game(sm, "async_keep", test_serialize, &gs).success);
+
+        gs.turn = 6;
+        REQUIRE(agentite_save_game_async(sm, "async_keep", snapshot_copy,
+                                         test_serialize_fail, free, &gs));
+        agentite_save_wait(sm);
+        agentite_save_update(sm);
+        REQUIRE(log.failed == 1);
+        REQUIRE(log.last_error_set);
+
+        TestGameState load = {0};
+        REQUIRE(agentite_load_game(sm, "async_keep", test_deserialize, &load).success);
+        REQUIRE(load.turn == 5);
+
+        agentite_save_delete(sm, "async_keep");
+    }
+
+    SECTION("Invalid requests are rejected up front") {
+        REQUIRE_FALSE(agentite_save_game_async(sm, "../escape", snapshot_copy,
+                                               test_serialize, free, &gs));
+        REQUIRE_FALSE(agentite_save_game_async(sm, "ok", nullptr, test_serialize, free, &gs));
+        REQUIRE_FALSE(agentite_save_is_busy(sm));
+    }
+
+    SECTION("Destroy finishes pending saves") {
+        REQUIRE(agentite_save_game_async(sm, "async_destroy", snapshot_copy,
+                                         slow_serialize, free, &gs));
+        agentite_save_destroy(sm);
+        sm = agentite_save_create(TEST_SAVES_DIR);
+        REQUIRE(agentite_save_exists(sm, "async_destroy"));
+        agentite_save_delete(sm, "async_destroy");
+    }
+
+    agentite_save_delete(sm, "autosave");
+    agentite_save_destroy(sm);
+    agentite_event_dispatcher_destroy(events);
+}
@@ -7,6 +7,7 @@
 
 #include "catch_amalgamated.hpp"
 #include "agentite/spatial.h"
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 
@@ -101,15 +102,13 @@ TEST_CASE("Spatial index add operations", "[spatial][add]") {
         REQUIRE_FALSE(agentite_spatial_add(nullptr, 0, 0, 1));
     }
 
-    SECTION("Cell full rejection (MAX_PER_CELL)") {
-        // Fill cell to max capacity
-        for (uint32_t i = 1; i <= AGENTITE_SPATIAL_MAX_PER_CELL; i++) {
+    SECTION("Cell past MAX_PER_CELL spills instead of failing") {
+        // Fill inline storage, then keep going
+        for (uint32_t i = 1; i <= AGENTITE_SPATIAL_MAX_PER_CELL + 1; i++) {
             REQUIRE(agentite_spatial_add(index, 0, 0, i));
         }
-
-        // One more should fail
-        REQUIRE_FALSE(agentite_spatial_add(index, 0, 0, AGENTITE_SPATIAL_MAX_PER_CELL + 1));
-        REQUIRE(agentite_spatial_count_at(index, 0, 0) == AGENTITE_SPATIAL_MAX_PER_CELL);
+        REQUIRE(agentite_spatial_count_at(index, 0, 0) == AGENTITE_SPATIAL_MAX_PER_CELL + 1);
+        REQUIRE(agentite_spatial_has_entity(index, 0, 0, AGENTITE_SPATIAL_MAX_PER_CELL + 1));
     }
 
     agentite_spatial_destroy(index);
@@ -454,6 +453,362 @@ TEST_CASE("Spatial index circle queries", "[spatial][circle]") {
     agentite_spatial_destroy(index);
 }
 
+/* ============================================================================
+ * Cell Overflow Tests
+ * ============================================================================ */
+
+TEST_CASE("Spatial index cell overflow", "[spatial][overflow]") {
+    Agentite_SpatialIndex *index = agentite_spatial_create(16);
+    REQUIRE(index != nullptr);
+
+    // Enough for the inline slots plus several overflow chunks
+    const int crowd = AGENTITE_SPATIAL_MAX_PER_CELL * 4 + 3;
+    for (int i = 1; i <= crowd; i++) {
+        REQUIRE(agentite_spatial_add(index, 7, -3, (uint32_t)i));
+    }
+    REQUIRE(agentite_spatial_count_at(index, 7, -3) == crowd);
+    REQUIRE(agentite_spatial_total_count(index) == crowd);
+
+    SECTION("Every entity is reachable") {
+        std::vector<uint32_t> all(crowd);
+        REQUIRE(agentite_spatial_query_all(index, 7, -3, all.data(), crowd) == crowd);
+        std::sort(all.begin(), all.end());
+        for (int i = 0; i < crowd; i++) {
+            REQUIRE(all[i] == (uint32_t)(i + 1));
+        }
+
+        Agentite_SpatialQueryResult results[128];
+        REQUIRE(agentite_spatial_query_radius(index, 7, -3, 1, results, 128) == crowd);
+
+        int iterated = 0;
+        Agentite_SpatialIterator iter = agentite_spatial_iter_begin(index, 7, -3);
+        while (agentite_spatial_iter_valid(&iter)) {
+            REQUIRE(agentite_spatial_iter_get(&iter) != AGENTITE_SPATIAL_INVALID);
+            iterated++;
+            agentite_spatial_iter_next(&iter);
+        }
+        REQUIRE(iterated == crowd);
+    }
+
+    SECTION("Removing spilled and inline entities") {
+        // Remove from the front so spilled entities move inline
+        for (int i = 1; i <= crowd; i += 2) {
+            REQUIRE(agentite_spatial_remove(index, 7, -3, (uint32_t)i));
+        }
+        int left = crowd / 2;
+        REQUIRE(agentite_spatial_count_at(index, 7, -3) == left);
+        for (int i = 2; i <= crowd; i += 2) {
+            REQUIRE(agentite_spatial_has_entity(index, 7, -3, (uint32_t)i));
+        }
+        REQUIRE_FALSE(agentite_spatial_has_entity(index, 7, -3, 1));
+
+        for (int i = 2; i <= crowd; i += 2) {
+            REQUIRE(agentite_spatial_remove(index, 7, -3, (uint32_t)i));
+        }
+        REQUIRE_FALSE(agentite_spatial_has(index, 7, -3));
+    }
+
+    SECTION("Released chunks are reused by other cells") {
+        for (int i = 1; i <= crowd; i++) {
+            REQUIRE(agentite_spatial_remove(index, 7, -3, (uint32_t)i));
+        }
+        for (int i = 1; i <= crowd; i++) {
+            REQUIRE(agentite_spatial_add(index, 100, 100, (uint32_t)i));
+            REQUIRE(agentite_spatial_add(index, -100, 100, (uint32_t)(i + 1000)));
+        }
+        REQUIRE(agentite_spatial_count_at(index, 100, 100) == crowd);
+        REQUIRE(agentite_spatial_count_at(index, -100, 100) == crowd);
+        REQUIRE(agentite_spatial_has_entity(index, 100, 100, (uint32_t)crowd));
+        REQUIRE(agentite_spatial_has_entity(index, -100, 100, (uint32_t)(crowd + 1000)));
+    }
+
+    SECTION("Clear drops spilled entities") {
+        agentite_spatial_clear(index);
+        REQUIRE(agentite_spatial_count_at(index, 7, -3) == 0);
+        for (int i = 1; i <= crowd; i++) {
+            REQUIRE(agentite_spatial_add(index, 7, -3, (uint32_t)i));
+        }
+        REQUIRE(agentite_spatial_count_at(index, 7, -3) == crowd);
+    }
+
+    agentite_spatial_destroy(index);
+}
+
+/* ============================================================================
+ * Block Layer Tests
+ * ============================================================================ */
+
+struct SpatialRef {
+    int x, y;
+    uint32_t id;
+};
+
+static std::vector<uint32_t> sorted_ids(const Agentite_SpatialQueryResult *results, int count) {
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < count; i++) {
+        ids.push_back(results[i].entity_id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+TEST_CASE("Spatial region queries across blocks", "[spatial][blocks]") {
+    Agentite_SpatialIndex *index = agentite_spatial_create(64);
+    REQUIRE(index != nullptr);
+
+    // Scattered entities around block edges, including negative coordinates
+    std::vector<SpatialRef> refs;
+    srand(1234);
+    for (uint32_t id = 1; id <= 300; id++) {
+        SpatialRef r = { rand() % 97 - 48, rand() % 97 - 48, id };
+        refs.push_back(r);
+        REQUIRE(agentite_spatial_add(index, r.x, r.y, r.id));
+    }
+
+    static Agentite_SpatialQueryResult results[512];
+
+    SECTION("Rect and circle results match a brute-force scan") {
+        const int probes[][3] = {
+            { 0, 0, 0 }, { -1, -1, 1 }, { 15, 16, 5 }, { -16, 17, 9 },
+            { 30, -30, 20 }, { 0, 0, 40 }, { -48, 48, 3 }, { 200, 200, 10 },
+        };
+        for (const auto &p : probes) {
+            int cx = p[0], cy = p[1], rad = p[2];
+            std::vector<uint32_t> want_rect, want_circle;
+            for (const SpatialRef &r : refs) {
+                int dx = r.x - cx, dy = r.y - cy;
+                if (abs(dx) <= rad && abs(dy) <= rad) want_rect.push_back(r.id);
+                if (dx * dx + dy * dy <= rad * rad) want_circle.push_back(r.id);
+            }
+            std::sort(want_rect.begin(), want_rect.end());
+            std::sort(want_circle.begin(), want_circle.end());
+
+            int n = agentite_spatial_query_radius(index, cx, cy, rad, results, 512);
+            REQUIRE(sorted_ids(results, n) == want_rect);
+            n = agentite_spatial_query_circle(index, cx, cy, rad, results, 512);
+            REQUIRE(sorted_ids(results, n) == want_circle);
+        }
+    }
+
+    SECTION("Results stay in row-major order") {
+        int n = agentite_spatial_query_rect(index, -40, -40, 40, 40, results, 512);
+        REQUIRE(n > 0);
+        for (int i = 1; i < n; i++) {
+            bool ordered = results[i - 1].y < results[i].y ||
+                           (results[i - 1].y == results[i].y && results[i - 1].x <= results[i].x);
+            REQUIRE(ordered);
+        }
+    }
+
+    SECTION("Emptied blocks are skipped and reusable") {
+        for (const SpatialRef &r : refs) {
+            REQUIRE(agentite_spatial_remove(index, r.x, r.y, r.id));
+        }
+        REQUIRE(agentite_spatial_query_radius(index, 0, 0, 60, results, 512) == 0);
+
+        REQUIRE(agentite_spatial_add(index, -17, 31, 5));
+        int n = agentite_spatial_query_circle(index, 0, 0, 60, results, 512);
+        REQUIRE(n == 1);
+        REQUIRE(results[0].x == -17);
+        REQUIRE(results[0].y == 31);
+    }
+
+    SECTION("Rects wider than a block row cache") {
+        REQUIRE(agentite_spatial_add(index, 5000, 0, 9001));
+        REQUIRE(agentite_spatial_add(index, -5000, 0, 9002));
+        int n = agentite_spatial_query_rect(index, -5000, 0, 5000, 0, results, 512);
+        std::vector<uint32_t> ids = sorted_ids(results, n);
+        REQUIRE(std::count(ids.begin(), ids.end(), 9001u) == 1);
+        REQUIRE(std::count(ids.begin(), ids.end(), 9002u) == 1);
+    }
+
+    SECTION("Extreme coordinates") {
+        REQUIRE(agentite_spatial_add(index, INT32_MAX, INT32_MAX, 9003));
+        REQUIRE(agentite_spatial_add(index, INT32_MIN, INT32_MIN, 9004));
+        int n = agentite_spatial_query_rect(index, INT32_MAX - 3, INT32_MAX - 3,
+                                            INT32_MAX, INT32_MAX, results, 512);
+        REQUIRE(n == 1);
+        REQUIRE(results[0].entity_id == 9003);
+        n = agentite_spatial_query_rect(index, INT32_MIN, INT32_MIN,
+                                        INT32_MIN + 3, INT32_MIN + 3, results, 512);
+        REQUIRE(n == 1);
+        REQUIRE(results[0].entity_id == 9004);
+    }
+
+    agentite_spatial_destroy(index);
+}
+
+/* ============================================================================
+ * Nearest-Neighbour Tests
+ * ============================================================================ */
+
+struct NearestRef {
+    int64_t d2;
+    uint32_t id;
+    bool operator<(const NearestRef &o) const {
+        return d2 < o.d2 || (d2 == o.d2 && id < o.id);
+    }
+};
+
+static bool odd_ids_only(uint32_t entity_id, int x, int y, void *userdata) {
+    (void)x; (void)y;
+    int *calls = (int *)userdata;
+    if (calls) (*calls)++;
+    return (entity_id & 1) != 0;
+}
+
+/* First k of a brute-force scan, same ordering as the index */
+static std::vector<NearestRef> brute_nearest(const std::vector<SpatialRef> &refs, int x, int y,
+                                             int k, int max_radius, bool odd_only) {
+    std::vector<NearestRef> all;
+    for (const SpatialRef &r : refs) {
+        int64_t dx = r.x - x, dy = r.y - y;
+        int64_t d2 = dx * dx + dy * dy;
+        if (max_radius >= 0 && d2 > (int64_t)max_radius * max_radius) continue;
+        if (odd_only && !(r.id & 1)) continue;
+        all.push_back({ d2, r.id });
+    }
+    std::sort(all.begin(), all.end());
+    if ((int)all.size() > k) all.resize(k);
+    return all;
+}
+
+static bool nearest_matches(const std::vector<NearestRef> &want, int x, int y,
+                            const Agentite_SpatialQueryResult *got, int count) {
+    if ((int)want.size() != count) return false;
+    for (int i = 0; i < count; i++) {
+        int64_t dx = got[i].x - x, dy = got[i].y - y;
+        if (want[i].id != got[i].entity_id || want[i].d2 != dx * dx + dy * dy) return false;
+    }
+    return true;
+}
+
+TEST_CASE("Spatial nearest queries", "[spatial][nearest]") {
+    Agentite_SpatialIndex *index = agentite_spatial_create(64);
+    REQUIRE(index != nullptr);
+    Agentite_SpatialQueryResult results[64];
+
+    SECTION("Empty index and invalid arguments") {
+        REQUIRE(agentite_spatial_query_nearest(index, 0, 0, 4, -1, nullptr, nullptr, results) == 0);
+        REQUIRE(agentite_spatial_add(index, 3, 4, 1));
+        REQUIRE(agentite_spatial_query_nearest(index, 0, 0, 0, -1, nullptr, nullptr, results) == 0);
+        REQUIRE(agentite_spatial_query_nearest(index, 0, 0, 4, -1, nullptr, nullptr, nullptr) == 0);
+        REQUIRE(agentite_spatial_query_nearest(nullptr, 0, 0, 4, -1, nullptr, nullptr, results) == 0);
+    }
+
+    SECTION("Closest first, ties by entity ID, radius limit") {
+        REQUIRE(agentite_spatial_add(index, 3, 4, 7));     // distance 5
+        REQUIRE(agentite_spatial_add(index, -5, 0, 3));    // distance 5
+        REQUIRE(agentite_spatial_add(index, 1, 1, 9));     // distance ~1.4
+        REQUIRE(agentite_spatial_add(index, 0, 0, 8));     // distance 0
+        REQUIRE(agentite_spatial_add(index, 400, 0, 2));   // far away
+
+        int n = agentite_spatial_query_nearest(index, 0, 0, 4, -1, nullptr, nullptr, results);
+        REQUIRE(n == 4);
+        REQUIRE(results[0].entity_id == 8);
+        REQUIRE(results[1].entity_id == 9);
+        REQUIRE(results[2].entity_id == 3);
+        REQUIRE(results[3].entity_id == 7);
+
+        REQUIRE(agentite_spatial_query_nearest(index, 0, 0, 10, 5, nullptr, nullptr, results) == 4);
+        REQUIRE(agentite_spatial_query_nearest(index, 0, 0, 10, -1, nullptr, nullptr, results) == 5);
+        REQUIRE(results[4].entity_id == 2);
+
+        // Only the far entity passes the filter
+        int calls = 0;
+        agentite_spatial_remove(index, 1, 1, 9);
+        agentite_spatial_remove(index, -5, 0, 3);
+        agentite_spatial_remove(index, 3, 4, 7);
+        agentite_spatial_remove(index, 0, 0, 8);
+        agentite_spatial_add(index, 0, 0, 10);
+        n = agentite_spatial_query_nearest(index, 0, 0, 1, -1, odd_ids_only, &calls, results);
+        REQUIRE(n == 0);
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("Matches a brute-force scan") {
+        std::vector<SpatialRef> refs;
+        srand(99);
+        for (uint32_t id = 1; id <= 400; id++) {
+            SpatialRef r = { rand() % 301 - 150, rand() % 301 - 150, id };
+            if (id % 50 == 0) { r.x *= 40; r.y *= 40; }   // A few far-off outliers
+            refs.push_back(r);
+            REQUIRE(agentite_spatial_add(index, r.x, r.y, r.id));
+        }
+        // A crowded cell that spills past MAX_PER_CELL
+        for (uint32_t id = 1001; id <= 1040; id++) {
+            refs.push_back({ 17, -33, id });
+            REQUIRE(agentite_spatial_add(index, 17, -33, id));
+        }
+
+        const int probes[][2] = {
+            { 0, 0 }, { 17, -33 }, { -150, 150 }, { 151, 0 }, { 6000, -6000 }, { -1, -16 },
+        };
+        const int ks[] = { 1, 5, 64 };
+        for (const auto &p : probes) {
+            for (int k : ks) {
+                int n = agentite_spatial_query_nearest(index, p[0], p[1], k, -1,
+                                                       nullptr, nullptr, results);
+                REQUIRE(nearest_matches(brute_nearest(refs, p[0], p[1], k, -1, false),
+                                        p[0], p[1], results, n));
+
+                n = agentite_spatial_query_nearest(index, p[0], p[1], k, 30,
+                                                   odd_ids_only, nullptr, results);
+                REQUIRE(nearest_matches(brute_nearest(refs, p[0], p[1], k, 30, true),
+                                        p[0], p[1], results, n));
+            }
+        }
+    }
+
+    agentite_spatial_destroy(index);
+}
+
+TEST_CASE("Spatial batched nearest queries", "[spatial][nearest]") {
+    Agentite_SpatialIndex *index = agentite_spatial_create(256);
+    REQUIRE(index != nullptr);
+
+    std::vector<SpatialRef> refs;
+    srand(7);
+    for (uint32_t id = 1; id <= 500; id++) {
+        SpatialRef r = { rand() % 200, rand() % 200, id };
+        refs.push_back(r);
+        REQUIRE(agentite_spatial_add(index, r.x, r.y, r.id));
+    }
+
+    const int k = 3;
+    std::vector<Agentite_SpatialPoint> points;
+    for (int i = 0; i < 300; i++) {
+        points.push_back({ rand() % 240 - 20, rand() % 240 - 20 });
+    }
+    std::vector<Agentite_SpatialQueryResult> results(points.size() * k);
+    std::vector<int> counts(points.size(), -1);
+
+    Agentite_JobPool *pool = agentite_job_pool_create(3);
+    REQUIRE(pool != nullptr);
+
+    for (Agentite_JobPool *jobs : { pool, (Agentite_JobPool *)nullptr }) {
+        int total = agentite_spatial_query_nearest_batch(index, jobs, points.data(),
+                                                         (int)points.size(), k, -1,
+                                                         odd_ids_only, nullptr,
+                                                         results.data(), counts.data());
+        int sum = 0;
+        for (size_t i = 0; i < points.size(); i++) {
+            int x = points[i].x, y = points[i].y;
+            REQUIRE(nearest_matches(brute_nearest(refs, x, y, k, -1, true),
+                                    x, y, &results[i * k], counts[i]));
+            sum += counts[i];
+        }
+        REQUIRE(total == sum);
+    }
+
+    REQUIRE(agentite_spatial_query_nearest_batch(index, pool, points.data(), 0, k, -1,
+                                                 nullptr, nullptr, results.data(),
+                                                 counts.data()) == 0);
+
+    agentite_job_pool_destroy(pool);
+    agentite_spatial_destroy(index);
+}
+
 /* ============================================================================
  * Iterator Tests
  * ============================================================================ */